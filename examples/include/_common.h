@@ -265,6 +265,27 @@ typedef enum _PROC_STATUS{
 /** Maximum number of spherical harmonic components/signals supported */
 #define MAX_NUM_SH_SIGNALS ( (MAX_SH_ORDER + 1)*(MAX_SH_ORDER + 1) )
 
+/**
+ * Default frame size (which is also the hop size of the time-frequency
+ * transform), for the examples which may be created with a specific frame size
+ * (e.g. ambi_dec_createWithFrameSize())
+ */
+#define DEFAULT_TF_FRAME_SIZE ( 128 )
+
+/** Minimum frame size which may be specified at creation (a power of 2) */
+#define MIN_TF_FRAME_SIZE ( 64 )
+
+/** Maximum frame size which may be specified at creation (a power of 2) */
+#define MAX_TF_FRAME_SIZE ( 1024 )
+
+/**
+ * Returns 1 if the frame size may be specified at creation (i.e. it is a power
+ * of 2 between MIN_TF_FRAME_SIZE and MAX_TF_FRAME_SIZE), and 0 otherwise
+ */
+#define IS_VALID_TF_FRAME_SIZE(frameSize) \
+    ( (frameSize) >= MIN_TF_FRAME_SIZE && (frameSize) <= MAX_TF_FRAME_SIZE && \
+      ((frameSize) & ((frameSize) - 1)) == 0 )
+
 
 #ifdef __cplusplus
 } /* extern "C" { */
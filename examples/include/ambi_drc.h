@@ -58,8 +58,9 @@ extern "C" {
 # define AMBI_DRC_NUM_DISPLAY_TIME_SLOTS ( (int)(AMBI_DRC_NUM_DISPLAY_SECONDS*48000.0f/(float)128) )
 /** Number of samples to offset when reading TF data */
 # define AMBI_DRC_READ_OFFSET ( 200 )
-/**< Number of frequency bands used during processing */
-# define AMBI_DRC_NUM_BANDS ( 133 )
+/**< Number of frequency bands used during processing (with the default frame
+ *   size; see ambi_drc_getFreqVector() otherwise) */
+# define AMBI_DRC_NUM_BANDS ( DEFAULT_TF_FRAME_SIZE + 5 )
 #endif
 /**< -16dB, maximum gain reduction for a given frequency band */
 #define AMBI_DRC_SPECTRAL_FLOOR (0.1585)
@@ -91,6 +92,24 @@ extern "C" {
  */
 void ambi_drc_create(void** const phAmbi);
 
+/**
+ * Creates an instance of ambi_drc, which operates with a specific frame size
+ *
+ * The frame size is also the hop size of the time-frequency transform. Smaller
+ * frame sizes (e.g. 64) reduce the processing delay, whereas larger frame sizes
+ * (e.g. 512) reduce the processing cost per sample. The number of frequency
+ * bands is frameSize+5.
+ *
+ * The getters without a handle (e.g. ambi_drc_getFrameSize()) describe
+ * instances created with ambi_drc_create(); use ambi_drc_getFrameSizeEx() and
+ * ambi_drc_getProcessingDelayEx() instead.
+ *
+ * @param[in] phAmbi    (&) address of ambi_drc handle
+ * @param[in] frameSize Frame size; a power of 2 between #MIN_TF_FRAME_SIZE and
+ *                      #MAX_TF_FRAME_SIZE (otherwise #DEFAULT_TF_FRAME_SIZE is used)
+ */
+void ambi_drc_createWithFrameSize(void** const phAmbi, int frameSize);
+
 /**
  * Destroys an instance of the ambi_drc
  *
@@ -123,6 +142,26 @@ void ambi_drc_process(void* const hAmbi,
                       int nCH,
                       int nSamples);
 
+/**
+ * Same as ambi_drc_process(), but for interleaved input/output buffers (e.g.
+ * as provided by many audio APIs)
+ *
+ * The samples are de-interleaved directly into the internal frame buffers (and
+ * re-interleaved from them), see saf_blockAdaptor_applyStrided(). The inputs
+ * and outputs may point to the same buffer.
+ *
+ * @param[in] hAmbi    ambi_drc handle
+ * @param[in] inputs   Interleaved input buffer; FLAT: nSamples x nCH
+ * @param[in] outputs  Interleaved output buffer; FLAT: nSamples x nCH
+ * @param[in] nCH      Number of input/output channels
+ * @param[in] nSamples Number of samples (per channel) in 'inputs'/'outputs'
+ */
+void ambi_drc_processInterleaved(void* const hAmbi,
+                                 const float* inputs,
+                                 float* outputs,
+                                 int nCH,
+                                 int nSamples);
+
 
 /* ========================================================================== */
 /*                                Set Functions                               */
@@ -191,17 +230,38 @@ void ambi_drc_setNormType(void* const hAmbi, int newType);
  */
 void ambi_drc_setInputPreset(void* const hAmbi, SH_ORDERS newPreset);
 
+/**
+ * Sets whether to use the low-delay mode of the afSTFT filterbank (0: off,
+ * 1: on)
+ *
+ * The low-delay mode reduces the delay of the filterbank from 12 to 7 hops,
+ * at the cost of a somewhat larger reconstruction error (see
+ * afSTFTgetProcessingDelay()). The filterbank is re-initialised in order to
+ * apply the change, which also flushes its buffers.
+ */
+void ambi_drc_setLowDelayMode(void* const hAmbi, int newState);
+
     
 /* ========================================================================== */
 /*                                Get Functions                               */
 /* ========================================================================== */
 
 /**
- * Returns the processing framesize (i.e., number of samples processed with
- * every _process() call )
+ * Returns the processing framesize (i.e., number of samples processed at a
+ * time) of an instance created with ambi_drc_create()
+ *
+ * @see ambi_drc_getFrameSizeEx() for an instance created with
+ *      ambi_drc_createWithFrameSize()
  */
 int ambi_drc_getFrameSize(void);
 
+/**
+ * Returns the processing framesize (i.e., number of samples processed at a
+ * time). _process() accepts any number of samples, but host block sizes
+ * which are a multiple of the frame size add no additional delay
+ */
+int ambi_drc_getFrameSizeEx(void* const hAmbi);
+
 /**
  * Returns pointers to historic time-frequency data, which may be used for
  * plotting purposes
@@ -289,10 +349,27 @@ int ambi_drc_getNSHrequired(void* const hAmbi);
 int ambi_drc_getSamplerate(void* const hAmbi);
     
 /**
- * Returns the processing delay in samples; may be used for delay compensation
- * features
+ * Returns whether the low-delay mode of the afSTFT filterbank is enabled (0:
+ * off, 1: on)
+ */
+int ambi_drc_getLowDelayMode(void* const hAmbi);
+
+/**
+ * Returns the processing delay in samples of an instance created with
+ * ambi_drc_create(), with the low-delay mode disabled and a host block size
+ * which is a multiple of the frame size (may be used for delay compensation
+ * features)
+ *
+ * @see ambi_drc_getProcessingDelayEx() for the delay of a specific instance
  */
 int ambi_drc_getProcessingDelay(void);
+
+/**
+ * Returns the processing delay in samples of the given instance, which accounts
+ * for its frame size, low-delay mode and block size adaptation (may be used for
+ * delay compensation features)
+ */
+int ambi_drc_getProcessingDelayEx(void* const hAmbi);
     
     
 #ifdef __cplusplus
@@ -78,6 +78,28 @@ void ambi_enc_process(void* const hAmbi,
                       int nOutputs,
                       int nSamples);
 
+/**
+ * Same as ambi_enc_process(), but for interleaved input/output buffers (e.g. as
+ * provided by many audio APIs)
+ *
+ * The samples are de-interleaved directly into the internal frame buffers (and
+ * re-interleaved from them), see saf_blockAdaptor_applyStrided(). The inputs
+ * and outputs may point to the same buffer, if nInputs==nOutputs.
+ *
+ * @param[in] hAmbi    ambi_enc handle
+ * @param[in] inputs   Interleaved input buffer; FLAT: nSamples x nInputs
+ * @param[in] outputs  Interleaved output buffer; FLAT: nSamples x nOutputs
+ * @param[in] nInputs  Number of input channels
+ * @param[in] nOutputs Number of output channels
+ * @param[in] nSamples Number of samples (per channel) in 'inputs'/'outputs'
+ */
+void ambi_enc_processInterleaved(void* const hAmbi,
+                                 const float* inputs,
+                                 float* outputs,
+                                 int nInputs,
+                                 int nOutputs,
+                                 int nSamples);
+
     
 /* ========================================================================== */
 /*                                Set Functions                               */
@@ -146,8 +168,9 @@ void ambi_enc_setEnablePostScaling(void* const hAmbi, int newStatus);
 /* ========================================================================== */
 
 /**
- * Returns the processing framesize (i.e., number of samples processed with
- * every _process() call )
+ * Returns the processing framesize (i.e., number of samples processed at a
+ * time). _process() accepts any number of samples, but host block sizes
+ * which are a multiple of the frame size add no additional delay
  */
 int ambi_enc_getFrameSize(void);
 
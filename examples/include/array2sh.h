@@ -191,6 +191,24 @@ typedef enum _ARRAY2SH_EVAL_STATUS{
  */
 void array2sh_create(void** const phA2sh);
 
+/**
+ * Creates an instance of array2sh, which operates with a specific frame size
+ *
+ * The frame size is also the hop size of the time-frequency transform. Smaller
+ * frame sizes (e.g. 64) reduce the processing delay, whereas larger frame sizes
+ * (e.g. 512) reduce the processing cost per sample. The number of frequency
+ * bands is frameSize+5.
+ *
+ * The getters without a handle (e.g. array2sh_getFrameSize()) describe
+ * instances created with array2sh_create(); use array2sh_getFrameSizeEx() and
+ * array2sh_getProcessingDelayEx() instead.
+ *
+ * @param[in] phA2sh    (&) address of array2sh handle
+ * @param[in] frameSize Frame size; a power of 2 between #MIN_TF_FRAME_SIZE and
+ *                      #MAX_TF_FRAME_SIZE (otherwise #DEFAULT_TF_FRAME_SIZE is used)
+ */
+void array2sh_createWithFrameSize(void** const phA2sh, int frameSize);
+
 /**
  * Destroys an instance of array2sh
  *
@@ -232,6 +250,28 @@ void array2sh_process(void* const hA2sh,
                       int nOutputs,
                       int nSamples);
 
+/**
+ * Same as array2sh_process(), but for interleaved input/output buffers (e.g. as
+ * provided by many audio APIs)
+ *
+ * The samples are de-interleaved directly into the internal frame buffers (and
+ * re-interleaved from them), see saf_blockAdaptor_applyStrided(). The inputs
+ * and outputs may point to the same buffer, if nInputs==nOutputs.
+ *
+ * @param[in] hA2sh    array2sh handle
+ * @param[in] inputs   Interleaved input buffer; FLAT: nSamples x nInputs
+ * @param[in] outputs  Interleaved output buffer; FLAT: nSamples x nOutputs
+ * @param[in] nInputs  Number of input channels
+ * @param[in] nOutputs Number of output channels
+ * @param[in] nSamples Number of samples (per channel) in 'inputs'/'outputs'
+ */
+void array2sh_processInterleaved(void* const hA2sh,
+                                 const float* inputs,
+                                 float* outputs,
+                                 int nInputs,
+                                 int nOutputs,
+                                 int nSamples);
+
 
 /* ========================================================================== */
 /*                                Set Functions                               */
@@ -262,6 +302,10 @@ void array2sh_setRequestEncoderEvalFLAG(void* const hA2sh, int newState);
     
 /**
  * Sets current eval status (see #_ARRAY2SH_EVAL_STATUS enum)
+ *
+ * This never waits: if the encoder is being evaluated, then setting
+ * #EVAL_STATUS_NOT_EVALUATED causes array2sh_evalEncoder() to leave the status
+ * as such, so that the next call evaluates the encoder again.
  */
 void array2sh_setEvalStatus(void* const hA2sh, ARRAY2SH_EVAL_STATUS evalStatus);
 
@@ -383,17 +427,38 @@ void array2sh_setc(void* const hA2sh, float newc);
  */
 void array2sh_setGain(void* const hA2sh, float newGain);
 
+/**
+ * Sets whether to use the low-delay mode of the afSTFT filterbank (0: off,
+ * 1: on)
+ *
+ * The low-delay mode reduces the delay of the filterbank from 12 to 7 hops,
+ * at the cost of a somewhat larger reconstruction error (see
+ * afSTFTgetProcessingDelay()). The filterbank is re-initialised in order to
+ * apply the change, which also flushes its buffers.
+ */
+void array2sh_setLowDelayMode(void* const hA2sh, int newState);
+
 
 /* ========================================================================== */
 /*                                Get Functions                               */
 /* ========================================================================== */
 
 /**
- * Returns the processing framesize (i.e., number of samples processed with
- * every _process() call )
+ * Returns the processing framesize (i.e., number of samples processed at a
+ * time) of an instance created with array2sh_create()
+ *
+ * @see array2sh_getFrameSizeEx() for an instance created with
+ *      array2sh_createWithFrameSize()
  */
 int array2sh_getFrameSize(void);
 
+/**
+ * Returns the processing framesize (i.e., number of samples processed at a
+ * time). _process() accepts any number of samples, but host block sizes
+ * which are a multiple of the frame size add no additional delay
+ */
+int array2sh_getFrameSizeEx(void* const hA2sh);
+
 /**
  * Returns current eval status (see #_ARRAY2SH_EVAL_STATUS enum)
  */
@@ -633,10 +698,27 @@ float* array2sh_getLevelDifference_Handle(void* const hA2sh, int* nCurves, int*
 int array2sh_getSamplingRate(void* const hA2sh);
     
 /**
- * Returns the processing delay in samples (may be used for delay compensation
- * features) 
+ * Returns whether the low-delay mode of the afSTFT filterbank is enabled (0:
+ * off, 1: on)
+ */
+int array2sh_getLowDelayMode(void* const hA2sh);
+
+/**
+ * Returns the processing delay in samples of an instance created with
+ * array2sh_create(), with the low-delay mode disabled and a host block size
+ * which is a multiple of the frame size (may be used for delay compensation
+ * features)
+ *
+ * @see array2sh_getProcessingDelayEx() for the delay of a specific instance
  */
 int array2sh_getProcessingDelay(void);
+
+/**
+ * Returns the processing delay in samples of the given instance, which accounts
+ * for its frame size, low-delay mode and block size adaptation (may be used for
+ * delay compensation features)
+ */
+int array2sh_getProcessingDelayEx(void* const hA2sh);
    
     
 #ifdef __cplusplus
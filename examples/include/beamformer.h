@@ -43,6 +43,21 @@ extern "C" {
  */
 void beamformer_create(void** const phBeam);
 
+/**
+ * Creates an instance of beamformer, which operates with a specific frame size
+ *
+ * The frame size is also the length of the cross-fade applied when the beam
+ * weights change, and the processing delay. The getters without a handle (e.g.
+ * beamformer_getFrameSize()) describe instances created with
+ * beamformer_create(); use beamformer_getFrameSizeEx() and
+ * beamformer_getProcessingDelayEx() instead.
+ *
+ * @param[in] phBeam    (&) address of beamformer handle
+ * @param[in] frameSize Frame size; a power of 2 between #MIN_TF_FRAME_SIZE and
+ *                      #MAX_TF_FRAME_SIZE (otherwise #DEFAULT_TF_FRAME_SIZE is used)
+ */
+void beamformer_createWithFrameSize(void** const phBeam, int frameSize);
+
 /**
  * Destroys an instance of beamformer
  *
@@ -76,6 +91,28 @@ void beamformer_process(void* const hBeam,
                         int nOutputs,
                         int nSamples);
 
+/**
+ * Same as beamformer_process(), but for interleaved input/output buffers (e.g. as
+ * provided by many audio APIs)
+ *
+ * The samples are de-interleaved directly into the internal frame buffers (and
+ * re-interleaved from them), see saf_blockAdaptor_applyStrided(). The inputs
+ * and outputs may point to the same buffer, if nInputs==nOutputs.
+ *
+ * @param[in] hBeam    beamformer handle
+ * @param[in] inputs   Interleaved input buffer; FLAT: nSamples x nInputs
+ * @param[in] outputs  Interleaved output buffer; FLAT: nSamples x nOutputs
+ * @param[in] nInputs  Number of input channels
+ * @param[in] nOutputs Number of output channels
+ * @param[in] nSamples Number of samples (per channel) in 'inputs'/'outputs'
+ */
+void beamformer_processInterleaved(void* const hBeam,
+                                   const float* inputs,
+                                   float* outputs,
+                                   int nInputs,
+                                   int nOutputs,
+                                   int nSamples);
+
 
 /* ========================================================================== */
 /*                                Set Functions                               */
@@ -135,11 +172,21 @@ void beamformer_setBeamType(void* const hBeam, int newID);
 /* ========================================================================== */
 
 /**
- * Returns the processing framesize (i.e., number of samples processed with
- * every _process() call )
+ * Returns the processing framesize (i.e., number of samples processed at a
+ * time) of an instance created with beamformer_create()
+ *
+ * @see beamformer_getFrameSizeEx() for an instance created with
+ *      beamformer_createWithFrameSize()
  */
 int beamformer_getFrameSize(void);
 
+/**
+ * Returns the processing framesize (i.e., number of samples processed at a
+ * time). _process() accepts any number of samples, but host block sizes
+ * which are a multiple of the frame size add no additional delay
+ */
+int beamformer_getFrameSizeEx(void* const hBeam);
+
 /**
  * Returns tje beamforming order (see #_SH_ORDERS enum)
  */
@@ -197,11 +244,21 @@ int beamformer_getNormType(void* const hBeam);
 int beamformer_getBeamType(void* const hBeam);
 
 /**
- * Returns the processing delay in samples (may be used for delay compensation
- * features)
+ * Returns the processing delay in samples of an instance created with
+ * beamformer_create(), with a host block size which is a multiple of the frame
+ * size (may be used for delay compensation features)
+ *
+ * @see beamformer_getProcessingDelayEx() for the delay of a specific instance
  */
 int beamformer_getProcessingDelay(void);
 
+/**
+ * Returns the processing delay in samples of the given instance, which accounts
+ * for its frame size and block size adaptation (may be used for delay
+ * compensation features)
+ */
+int beamformer_getProcessingDelayEx(void* const hBeam);
+
     
     
 #ifdef __cplusplus
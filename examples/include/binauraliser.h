@@ -61,6 +61,25 @@ typedef enum _INTERP_MODES{
  */
 void binauraliser_create(void** const phBin);
 
+/**
+ * Creates an instance of binauraliser, which operates with a specific frame size
+ *
+ * The frame size is also the hop size of the time-frequency transform. Smaller
+ * frame sizes (e.g. 64) reduce the processing delay, whereas larger frame sizes
+ * (e.g. 512) reduce the processing cost per sample. The number of frequency
+ * bands is frameSize+5.
+ *
+ * The getters without a handle (e.g. binauraliser_getFrameSize()) describe
+ * instances created with binauraliser_create(); use
+ * binauraliser_getFrameSizeEx() and binauraliser_getProcessingDelayEx()
+ * instead.
+ *
+ * @param[in] phBin     (&) address of binauraliser handle
+ * @param[in] frameSize Frame size; a power of 2 between #MIN_TF_FRAME_SIZE and
+ *                      #MAX_TF_FRAME_SIZE (otherwise #DEFAULT_TF_FRAME_SIZE is used)
+ */
+void binauraliser_createWithFrameSize(void** const phBin, int frameSize);
+
 /**
  * Destroys an instance of the binauraliser
  *
@@ -84,12 +103,14 @@ void binauraliser_init(void* const hBin,
  *
  * @note This function is fully threadsafe. It can even be called periodically
  *       via a timer on one thread, while calling _process() on another thread.
- *       Since, if a set function is called (that warrants a re-init), then a
- *       flag is triggered internally and the next time this function is called,
- *       it will wait until the current process() function has completed before
- *       reinitialising the relevant parameters. If the _initCodec() takes
- *       longer than the time it takes for process() to be called again, then
- *       process() is simply bypassed until the codec is ready.
+ *       If a set function is called (that warrants a re-init), then the next
+ *       time this function is called, it builds a new codec state (afSTFT and
+ *       HRTF data), and hands it over to _process() with an atomic pointer
+ *       swap (see saf_stateSwap_create()). Neither function ever waits for the
+ *       other: _process() keeps using the previous codec state until the new
+ *       one is ready (and outputs silence only before the first one is ready),
+ *       and the previous state is freed by this function, once _process() has
+ *       moved on to the new one.
  * @note This function does nothing if no re-initialisations are required.
  *
  * @param[in] hBin binauraliser handle
@@ -113,6 +134,28 @@ void binauraliser_process(void* const hBin,
                           int nOutputs,
                           int nSamples);
 
+/**
+ * Same as binauraliser_process(), but for interleaved input/output buffers (e.g. as
+ * provided by many audio APIs)
+ *
+ * The samples are de-interleaved directly into the internal frame buffers (and
+ * re-interleaved from them), see saf_blockAdaptor_applyStrided(). The inputs
+ * and outputs may point to the same buffer, if nInputs==nOutputs.
+ *
+ * @param[in] hBin     binauraliser handle
+ * @param[in] inputs   Interleaved input buffer; FLAT: nSamples x nInputs
+ * @param[in] outputs  Interleaved output buffer; FLAT: nSamples x nOutputs
+ * @param[in] nInputs  Number of input channels
+ * @param[in] nOutputs Number of output channels
+ * @param[in] nSamples Number of samples (per channel) in 'inputs'/'outputs'
+ */
+void binauraliser_processInterleaved(void* const hBin,
+                                     const float* inputs,
+                                     float* outputs,
+                                     int nInputs,
+                                     int nOutputs,
+                                     int nSamples);
+
 
 /* ========================================================================== */
 /*                                Set Functions                               */
@@ -218,17 +261,38 @@ void binauraliser_setRPYflag(void* const hBin, int newState);
 /** NOT IMPLEMENTED YET */
 void binauraliser_setInterpMode(void* const hBin, int newMode);
 
+/**
+ * Sets whether to use the low-delay mode of the afSTFT filterbank (0: off,
+ * 1: on)
+ *
+ * The low-delay mode reduces the delay of the filterbank from 12 to 7 hops,
+ * at the cost of a somewhat larger reconstruction error (see
+ * afSTFTgetProcessingDelay()). The filterbank is re-initialised in order to
+ * apply the change, which also flushes its buffers.
+ */
+void binauraliser_setLowDelayMode(void* const hBin, int newState);
+
 
 /* ========================================================================== */
 /*                                Get Functions                               */
 /* ========================================================================== */
 
 /**
- * Returns the processing framesize (i.e., number of samples processed with
- * every _process() call )
+ * Returns the processing framesize (i.e., number of samples processed at a
+ * time) of an instance created with binauraliser_create()
+ *
+ * @see binauraliser_getFrameSizeEx() for an instance created with
+ *      binauraliser_createWithFrameSize()
  */
 int binauraliser_getFrameSize(void);
 
+/**
+ * Returns the processing framesize (i.e., number of samples processed at a
+ * time). _process() accepts any number of samples, but host block sizes
+ * which are a multiple of the frame size add no additional delay
+ */
+int binauraliser_getFrameSizeEx(void* const hBin);
+
 /**
  * Returns current codec status codec status (see #_CODEC_STATUS enum)
  */
@@ -381,11 +445,28 @@ int binauraliser_getRPYflag(void* const hBin);
 int binauraliser_getInterpMode(void* const hBin);
 
 /**
- * Returns the processing delay in samples (may be used for delay compensation
- * purposes)
+ * Returns whether the low-delay mode of the afSTFT filterbank is enabled (0:
+ * off, 1: on)
+ */
+int binauraliser_getLowDelayMode(void* const hBin);
+
+/**
+ * Returns the processing delay in samples of an instance created with
+ * binauraliser_create(), with the low-delay mode disabled and a host block size
+ * which is a multiple of the frame size (may be used for delay compensation
+ * features)
+ *
+ * @see binauraliser_getProcessingDelayEx() for the delay of a specific instance
  */
 int binauraliser_getProcessingDelay(void);
 
+/**
+ * Returns the processing delay in samples of the given instance, which accounts
+ * for its frame size, low-delay mode and block size adaptation (may be used for
+ * delay compensation features)
+ */
+int binauraliser_getProcessingDelayEx(void* const hBin);
+
 
 #ifdef __cplusplus
 } /* extern "C" { */
@@ -124,6 +124,25 @@ typedef enum _DIRASS_REASS_MODE {
  */
 void dirass_create(void** const phDir);
 
+/**
+ * Creates an instance of the dirass, which operates with a specific frame size
+ *
+ * The frame size is the number of samples over which the beamformer and
+ * re-assignment are applied. Smaller frame sizes (e.g. 256) reduce the
+ * processing delay and update the activity-map more often, whereas larger frame
+ * sizes reduce the processing cost per sample.
+ *
+ * The getters without a handle (e.g. dirass_getFrameSize()) describe instances
+ * created with dirass_create(); use dirass_getFrameSizeEx() and
+ * dirass_getProcessingDelayEx() instead.
+ *
+ * @param[in] phDir     (&) address of dirass handle
+ * @param[in] frameSize Frame size; a power of 2 between #MIN_TF_FRAME_SIZE and
+ *                      #MAX_TF_FRAME_SIZE (otherwise dirass_getFrameSize() is
+ *                      used)
+ */
+void dirass_createWithFrameSize(void** const phDir, int frameSize);
+
 /**
  * Destroys an instance of the dirass
  *
@@ -147,12 +166,15 @@ void dirass_init(void* const hDir,
  *
  * @note This function is fully threadsafe. It can even be called periodically
  *       via a timer on one thread, while calling _process() on another thread.
- *       Since, if a set function is called (that warrants a re-init), then a
- *       flag is triggered internally and the next time this function is called,
- *       it will wait until the current process() function has completed before
- *       reinitialising the relevant parameters. If the _initCodec() takes
- *       longer than the time it takes for process() to be called again, then
- *       process() is simply bypassed until the codec is ready.
+ *       If a set function is called (that warrants a re-init), then the next
+ *       time this function is called, it builds a new codec state (scanning
+ *       grid, sector beamforming weights and display interpolation table), and
+ *       hands it over to _analysis() with an atomic pointer swap (see
+ *       saf_stateSwap_create()). Neither function ever waits for the other:
+ *       _analysis() keeps using the previous codec state until the new one is
+ *       ready (and is bypassed only before the first one is ready), and the
+ *       previous state is freed by this function, once _analysis() has moved on
+ *       to the new one.
  * @note This function does nothing if no re-initialisations are required.
  *
  * @param[in] hDir dirass handle
@@ -285,11 +307,21 @@ void dirass_requestPmapUpdate(void* const hDir);
 /* ========================================================================== */
 
 /**
- * Returns the processing framesize (i.e., number of samples processed with
- * every _process() call )
+ * Returns the processing framesize (i.e., number of samples processed at a
+ * time) of an instance created with dirass_create()
+ *
+ * @see dirass_getFrameSizeEx() for an instance created with
+ *      dirass_createWithFrameSize()
  */
 int dirass_getFrameSize(void);
 
+/**
+ * Returns the processing framesize (i.e., number of samples processed at a
+ * time). _process() accepts any number of samples, but host block sizes
+ * which are a multiple of the frame size add no additional delay
+ */
+int dirass_getFrameSizeEx(void* const hDir);
+
 /**
  * Returns current codec status (see #_CODEC_STATUS enum)
  */
@@ -401,6 +433,11 @@ float dirass_getMapAvgCoeff(void* const hDir);
  * Returns the latest computed activity-map if it is ready; otherwise it returns
  * 0, and you'll just have to wait a bit  
  *
+ * @note The returned buffers belong to the codec state that _analysis() last
+ *       drew into, which is only freed by _initCodec() (or _destroy()); so
+ *       call this function from the same thread as _initCodec(), and do not
+ *       hold on to the buffers past the next _initCodec() call.
+ *
  * @param[in]  hDir        (&) dirass handle
  * @param[out] grid_dirs   (&) scanning grid directions, in DEGREES; nDirs x 1
  * @param[out] pmap        (&) activity-map values; nDirs x 1
@@ -420,11 +457,20 @@ int dirass_getPmap(void* const hDir,
                    float* aspectRatio);
 
 /**
- * Returns the processing delay in samples (may be used for delay compensation
- * features)
+ * Returns the processing delay in samples of an instance created with
+ * dirass_create() (may be used for delay compensation features)
+ *
+ * @see dirass_getProcessingDelayEx() for the delay of a specific instance
  */
 int dirass_getProcessingDelay(void);
 
+/**
+ * Returns the processing delay in samples of the given instance, which accounts
+ * for its frame size and block size adaptation (may be used for delay
+ * compensation features)
+ */
+int dirass_getProcessingDelayEx(void* const hDir);
+
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -102,6 +102,11 @@ void matrixconv_checkReInit(void* const hMCnv);
  * This is then divided by the number of inputs, which should be user specified
  * to be 32 in this case.
  *
+ * @note If the number of channels and samples are unchanged, then the new
+ *       filters are swapped into the running convolver with a crossfade,
+ *       rather than re-initialising it. This function should therefore be
+ *       called from a non-real-time thread.
+ *
  * @param[in] hMCnv       matrixconv handle
  * @param[in] H           Input channel buffers; 2-D array:
  *                        numChannels x nSamples
@@ -117,7 +122,9 @@ void matrixconv_setFilters(void* const hMCnv,
                            int sampleRate);
 
 /**
- * Enable (1), disable (0), partitioned convolution
+ * Enable (1), disable (0), partitioned convolution, or enable non-uniformly
+ * partitioned convolution (2), which is recommended for long filters. (3) is
+ * as (2), but with the tail of the filters computed on a worker thread
  */
 void matrixconv_setEnablePart(void* const hMCnv, int newState);
     
@@ -143,8 +150,9 @@ void matrixconv_setNumInputChannels(void* const hMCnv, int newValue);
 int matrixconv_getFrameSize(void);
 
 /**
- * Returns a flag indicating whether partitioned convolution is enabled (1) or
- * disabled (0)
+ * Returns a flag indicating whether partitioned convolution is enabled (1),
+ * disabled (0), or whether non-uniformly partitioned convolution is enabled (2)
+ * or enabled with a worker thread (3)
  */
 int matrixconv_getEnablePart(void* const hMCnv);
     
@@ -95,6 +95,11 @@ void multiconv_checkReInit(void* const hMCnv);
 /**
  * Loads the multichannel of filters
  *
+ * @note If the number of channels and samples are unchanged, then the new
+ *       filters are swapped into the running convolver with a crossfade,
+ *       rather than re-initialising it. This function should therefore be
+ *       called from a non-real-time thread.
+ *
  * @param[in] hMCnv       multiconv handle
  * @param[in] H           Input channel buffers; 2-D array:
  *                        numChannels x nSamples
@@ -110,7 +115,9 @@ void multiconv_setFilters(void* const hMCnv,
                           int sampleRate);
     
 /**
- * Enable (1), disable (0), partitioned convolution
+ * Enable (1), disable (0), partitioned convolution, or enable non-uniformly
+ * partitioned convolution (2), which is recommended for long filters. (3) is
+ * as (2), but with the tail of the filters computed on a worker thread
  */
 void multiconv_setEnablePart(void* const hMCnv, int newState);
     
@@ -131,8 +138,9 @@ void multiconv_setNumChannels(void* const hMCnv, int newValue);
 int multiconv_getFrameSize(void);
 
 /**
- * Returns a flag indicating whether partitioned convolution is enabled (1) or
- * disabled (0)
+ * Returns a flag indicating whether partitioned convolution is enabled (1),
+ * disabled (0), or whether non-uniformly partitioned convolution is enabled (2)
+ * or enabled with a worker thread (3)
  */
 int multiconv_getEnablePart(void* const hMCnv);
 
@@ -71,6 +71,24 @@ extern "C" {
  */
 void panner_create(void** const phPan);
 
+/**
+ * Creates an instance of panner, which operates with a specific frame size
+ *
+ * The frame size is also the hop size of the time-frequency transform. Smaller
+ * frame sizes (e.g. 64) reduce the processing delay, whereas larger frame sizes
+ * (e.g. 512) reduce the processing cost per sample. The number of frequency
+ * bands is frameSize+5.
+ *
+ * The getters without a handle (e.g. panner_getFrameSize()) describe instances
+ * created with panner_create(); use panner_getFrameSizeEx() and
+ * panner_getProcessingDelayEx() instead.
+ *
+ * @param[in] phPan     (&) address of panner handle
+ * @param[in] frameSize Frame size; a power of 2 between #MIN_TF_FRAME_SIZE and
+ *                      #MAX_TF_FRAME_SIZE (otherwise #DEFAULT_TF_FRAME_SIZE is used)
+ */
+void panner_createWithFrameSize(void** const phPan, int frameSize);
+
 /**
  * Destroys an instance of the panner
  *
@@ -94,12 +112,14 @@ void panner_init(void* const hPan,
  *
  * @note This function is fully threadsafe. It can even be called periodically
  *       via a timer on one thread, while calling _process() on another thread.
- *       Since, if a set function is called (that warrants a re-init), then a
- *       flag is triggered internally and the next time this function is called,
- *       it will wait until the current process() function has completed before
- *       reinitialising the relevant parameters. If the _initCodec() takes
- *       longer than the time it takes for process() to be called again, then
- *       process() is simply bypassed until the codec is ready.
+ *       If a set function is called (that warrants a re-init), then the next
+ *       time this function is called, it builds a new codec state (afSTFT and
+ *       VBAP gain table), and hands it over to _process() with an atomic
+ *       pointer swap (see saf_stateSwap_create()). Neither function ever waits
+ *       for the other: _process() keeps using the previous codec state until
+ *       the new one is ready (and outputs silence only before the first one is
+ *       ready), and the previous state is freed by this function, once
+ *       _process() has moved on to the new one.
  * @note This function does nothing if no re-initialisations are required.
  *
  * @param[in] hPan panner handle
@@ -136,6 +156,28 @@ void panner_process(void* const hPan,
                     int nInputs,
                     int nOutputs,
                     int nSamples);
+
+/**
+ * Same as panner_process(), but for interleaved input/output buffers (e.g. as
+ * provided by many audio APIs)
+ *
+ * The samples are de-interleaved directly into the internal frame buffers (and
+ * re-interleaved from them), see saf_blockAdaptor_applyStrided(). The inputs
+ * and outputs may point to the same buffer, if nInputs==nOutputs.
+ *
+ * @param[in] hPan     panner handle
+ * @param[in] inputs   Interleaved input buffer; FLAT: nSamples x nInputs
+ * @param[in] outputs  Interleaved output buffer; FLAT: nSamples x nOutputs
+ * @param[in] nInputs  Number of input channels
+ * @param[in] nOutputs Number of output channels
+ * @param[in] nSamples Number of samples (per channel) in 'inputs'/'outputs'
+ */
+void panner_processInterleaved(void* const hPan,
+                               const float* inputs,
+                               float* outputs,
+                               int nInputs,
+                               int nOutputs,
+                               int nSamples);
     
     
 /* ========================================================================== */
@@ -237,6 +279,17 @@ void panner_setFlipPitch(void* const hPan, int newState);
  * (0: do not flip sign, 1: flip the sign)
  */
 void panner_setFlipRoll(void* const hPan, int newState);
+
+/**
+ * Sets whether to use the low-delay mode of the afSTFT filterbank (0: off,
+ * 1: on)
+ *
+ * The low-delay mode reduces the delay of the filterbank from 12 to 7 hops,
+ * at the cost of a somewhat larger reconstruction error (see
+ * afSTFTgetProcessingDelay()). The filterbank is re-initialised in order to
+ * apply the change, which also flushes its buffers.
+ */
+void panner_setLowDelayMode(void* const hPan, int newState);
     
     
 /* ========================================================================== */
@@ -244,11 +297,21 @@ void panner_setFlipRoll(void* const hPan, int newState);
 /* ========================================================================== */
 
 /**
- * Returns the processing framesize (i.e., number of samples processed with
- * every _process() call )
+ * Returns the processing framesize (i.e., number of samples processed at a
+ * time) of an instance created with panner_create()
+ *
+ * @see panner_getFrameSizeEx() for an instance created with
+ *      panner_createWithFrameSize()
  */
 int panner_getFrameSize(void);
 
+/**
+ * Returns the processing framesize (i.e., number of samples processed at a
+ * time). _process() accepts any number of samples, but host block sizes
+ * which are a multiple of the frame size add no additional delay
+ */
+int panner_getFrameSizeEx(void* const hPan);
+
 /**
  * Returns current codec status (see #_CODEC_STATUS enum)
  */
@@ -358,11 +421,27 @@ int panner_getFlipPitch(void* const hPan);
 int panner_getFlipRoll(void* const hPan);
 
 /**
- * Returns the processing delay in samples (may be used for delay compensation
- * features) 
+ * Returns whether the low-delay mode of the afSTFT filterbank is enabled (0:
+ * off, 1: on)
+ */
+int panner_getLowDelayMode(void* const hPan);
+
+/**
+ * Returns the processing delay in samples of an instance created with
+ * panner_create(), with the low-delay mode disabled and a host block size which
+ * is a multiple of the frame size (may be used for delay compensation features)
+ *
+ * @see panner_getProcessingDelayEx() for the delay of a specific instance
  */
 int panner_getProcessingDelay(void);
 
+/**
+ * Returns the processing delay in samples of the given instance, which accounts
+ * for its frame size, low-delay mode and block size adaptation (may be used for
+ * delay compensation features)
+ */
+int panner_getProcessingDelayEx(void* const hPan);
+
 
 #ifdef __cplusplus
 } /* extern "C" */
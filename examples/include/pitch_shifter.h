@@ -111,12 +111,15 @@ void pitch_shifter_init(void* const hPS,
  *
  * @note This function is fully threadsafe. It can even be called periodically
  *       via a timer on one thread, while calling _process() on another thread.
- *       Since, if a set function is called (that warrants a re-init), then a
- *       flag is triggered internally and the next time this function is called,
- *       it will wait until the current process() function has completed before
- *       reinitialising the relevant parameters. If the _initCodec() takes
- *       longer than the time it takes for process() to be called again, then
- *       process() is simply bypassed until the codec is ready.
+ *       If a set function is called (that warrants a re-init), then the next
+ *       time this function is called, it builds a new codec state (pitch
+ *       shifter for the current number of channels, FFT size and oversampling
+ *       factor), and hands it over to _process() with an atomic pointer swap
+ *       (see saf_stateSwap_create()). Neither function ever waits for the
+ *       other: _process() keeps using the previous codec state until the new
+ *       one is ready (and outputs silence only before the first one is ready),
+ *       and the previous state is freed by this function, once _process() has
+ *       moved on to the new one.
  * @note This function does nothing if no re-initialisations are required.
  *
  * @param[in] hPS pitch_shifter handle
@@ -140,6 +143,28 @@ void pitch_shifter_process(void* const hPS,
                            int nOutputs,
                            int nSamples);
 
+/**
+ * Same as pitch_shifter_process(), but for interleaved input/output buffers (e.g. as
+ * provided by many audio APIs)
+ *
+ * The samples are de-interleaved directly into the internal frame buffers (and
+ * re-interleaved from them), see saf_blockAdaptor_applyStrided(). The inputs
+ * and outputs may point to the same buffer, if nInputs==nOutputs.
+ *
+ * @param[in] hPS      pitch_shifter handle
+ * @param[in] inputs   Interleaved input buffer; FLAT: nSamples x nInputs
+ * @param[in] outputs  Interleaved output buffer; FLAT: nSamples x nOutputs
+ * @param[in] nInputs  Number of input channels
+ * @param[in] nOutputs Number of output channels
+ * @param[in] nSamples Number of samples (per channel) in 'inputs'/'outputs'
+ */
+void pitch_shifter_processInterleaved(void* const hPS,
+                                      const float* inputs,
+                                      float* outputs,
+                                      int nInputs,
+                                      int nOutputs,
+                                      int nSamples);
+
 
 /* ========================================================================== */
 /*                                Set Functions                               */
@@ -184,8 +209,9 @@ void pitch_shifter_setOSampOption(void* const hPS,
 /* ========================================================================== */
 
 /**
- * Returns the processing framesize (i.e., number of samples processed with
- * every _process() call )
+ * Returns the processing framesize (i.e., number of samples processed at a
+ * time). _process() accepts any number of samples, but host block sizes
+ * which are a multiple of the frame size add no additional delay
  */
 int pitch_shifter_getFrameSize(void);
 
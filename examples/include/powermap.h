@@ -75,6 +75,26 @@ typedef enum _POWERMAP_MODES {
  */
 void powermap_create(void** const phPm);
 
+/**
+ * Creates an instance of the powermap, which analyses its input with a specific
+ * hop size
+ *
+ * The powermap is always generated from frames of powermap_getFrameSize()
+ * samples, whereas the hop size of the time-frequency transform determines the
+ * frequency resolution: the number of frequency bands is hopSize+5, and each
+ * band holds powermap_getFrameSize()/hopSize time slots.
+ *
+ * The getters without a handle (e.g. powermap_getNumberOfBands()) describe
+ * instances created with powermap_create(); use powermap_getNumberOfBandsEx()
+ * and powermap_getProcessingDelayEx() instead.
+ *
+ * @param[in] phPm    (&) address of powermap handle
+ * @param[in] hopSize Hop size; a power of 2 between #MIN_TF_FRAME_SIZE and
+ *                    powermap_getFrameSize() (otherwise #DEFAULT_TF_FRAME_SIZE
+ *                    is used)
+ */
+void powermap_createWithHopSize(void** const phPm, int hopSize);
+
 /**
  * Destroys an instance of the powermap
  *
@@ -98,12 +118,15 @@ void powermap_init(void* const hPm,
  *
  * @note This function is fully threadsafe. It can even be called periodically
  *       via a timer on one thread, while calling _process() on another thread.
- *       Since, if a set function is called (that warrants a re-init), then a
- *       flag is triggered internally and the next time this function is called,
- *       it will wait until the current process() function has completed before
- *       reinitialising the relevant parameters. If the _initCodec() takes
- *       longer than the time it takes for process() to be called again, then
- *       process() is simply bypassed until the codec is ready.
+ *       If a set function is called (that warrants a re-init), then the next
+ *       time this function is called, it builds a new codec state (afSTFT,
+ *       scanning grid, powermap engine and display interpolation table), and
+ *       hands it over to _process() with an atomic pointer swap (see
+ *       saf_stateSwap_create()). Neither function ever waits for the other:
+ *       _process() keeps using the previous codec state until the new one is
+ *       ready (and outputs silence only before the first one is ready), and the
+ *       previous state is freed by this function, once _process() has moved on
+ *       to the new one.
  * @note This function does nothing if no re-initialisations are required.
  *
  * @param[in] hPm powermap handle
@@ -225,8 +248,9 @@ void powermap_requestPmapUpdate(void* const hPm);
 /* ========================================================================== */
 
 /**
- * Returns the processing framesize (i.e., number of samples processed with
- * every _process() call )
+ * Returns the processing framesize (i.e., number of samples processed at a
+ * time). _process() accepts any number of samples, but host block sizes
+ * which are a multiple of the frame size add no additional delay
  */
 int powermap_getFrameSize(void);
 
@@ -271,9 +295,19 @@ int powermap_getSamplingRate(void* const hPm);
 float powermap_getCovAvgCoeff(void* const hPm);
 
 /**
- * Returns the number of frequency bands used for the analysis
+ * Returns the number of frequency bands used for the analysis by an instance
+ * created with powermap_create()
+ *
+ * @see powermap_getNumberOfBandsEx() for the number of bands of a specific
+ *      instance
  */
 int powermap_getNumberOfBands(void);
+
+/**
+ * Returns the number of frequency bands used for the analysis by the given
+ * instance (i.e. its hop size + 5)
+ */
+int powermap_getNumberOfBandsEx(void* const hPm);
     
 /**
  * Returns the number of spherical harmonic signals required by the current
@@ -368,6 +402,11 @@ float powermap_getPowermapAvgCoeff(void* const hPm);
  * Returns the latest computed activity-map if it is ready. Otherwise it returns
  * 0, and you'll just have to wait a bit
  *
+ * @note The returned buffers belong to the codec state that _analysis() last
+ *       drew into, which is only freed by _initCodec() (or _destroy()); so
+ *       call this function from the same thread as _initCodec(), and do not
+ *       hold on to the buffers past the next _initCodec() call.
+ *
  * @param[in]  hPm         powermap handle
  * @param[out] grid_dirs   (&) scanning grid directions, in DEGREES; nDirs x 1
  * @param[out] pmap        (&) activity-map values; nDirs x 1
@@ -386,11 +425,20 @@ int powermap_getPmap(void* const hPm,
                      int* aspectRatio);
 
 /**
- * Returns the processing delay in samples (may be used for delay compensation
- * features)
+ * Returns the processing delay in samples of an instance created with
+ * powermap_create() (may be used for delay compensation features)
+ *
+ * @see powermap_getProcessingDelayEx() for the delay of a specific instance
  */
 int powermap_getProcessingDelay(void);
 
+/**
+ * Returns the processing delay in samples of the given instance, which accounts
+ * for its hop size and block size adaptation (may be used for delay
+ * compensation features)
+ */
+int powermap_getProcessingDelayEx(void* const hPm);
+
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -83,14 +83,37 @@ void rotator_process(void* const hRot,
                      int nOutputs,
                      int nSamples);
 
+/**
+ * Same as rotator_process(), but for interleaved input/output buffers (e.g. as
+ * provided by many audio APIs)
+ *
+ * The samples are de-interleaved directly into the internal frame buffers (and
+ * re-interleaved from them), see saf_blockAdaptor_applyStrided(). The inputs
+ * and outputs may point to the same buffer, if nInputs==nOutputs.
+ *
+ * @param[in] hRot     rotator handle
+ * @param[in] inputs   Interleaved input buffer; FLAT: nSamples x nInputs
+ * @param[in] outputs  Interleaved output buffer; FLAT: nSamples x nOutputs
+ * @param[in] nInputs  Number of input channels
+ * @param[in] nOutputs Number of output channels
+ * @param[in] nSamples Number of samples (per channel) in 'inputs'/'outputs'
+ */
+void rotator_processInterleaved(void* const hRot,
+                                const float* inputs,
+                                float* outputs,
+                                int nInputs,
+                                int nOutputs,
+                                int nSamples);
+
 
 /* ========================================================================== */
 /*                                Set Functions                               */
 /* ========================================================================== */
 
 /**
- * Returns the processing framesize (i.e., number of samples processed with
- * every _process() call )
+ * Returns the processing framesize (i.e., number of samples processed at a
+ * time). _process() accepts any number of samples, but host block sizes
+ * which are a multiple of the frame size add no additional delay
  */
 int rotator_getFrameSize(void);
 
@@ -109,6 +132,17 @@ void rotator_setPitch(void* const hRot, float newPitch);
  */
 void rotator_setRoll(void* const hRot, float newRoll);
 
+/**
+ * Sets the orientation as a quaternion [w x y z] (e.g. as provided by a head
+ * tracker), which is used in place of the yaw, pitch and roll angles
+ *
+ * The rotation matrix is that given by quaternion2rotationMatrix(). The angles
+ * returned by rotator_getYaw() etc. are updated accordingly (for the current
+ * rotation order, see rotator_setRPYflag()). Changes in orientation are
+ * interpolated (slerp) over sub-blocks of the following frame.
+ */
+void rotator_setQuaternion(void* const hRot, float Q[4]);
+
 /**
  * Sets a flag as to whether to "flip" the sign of the current 'yaw' angle
  * (0: do not flip sign, 1: flip the sign)
@@ -170,6 +204,11 @@ float rotator_getPitch(void* const hRot);
  */
 float rotator_getRoll(void* const hRot);
 
+/**
+ * Returns the current orientation as a unit quaternion [w x y z]
+ */
+void rotator_getQuaternion(void* const hRot, float Q[4]);
+
 /**
  * Returns a flag as to whether to "flip" the sign of the current 'yaw' angle
  * (0: do not flip sign, 1: flip the sign)
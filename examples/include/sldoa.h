@@ -62,6 +62,26 @@ extern "C" {
  */
 void sldoa_create(void** const phSld);
 
+/**
+ * Creates an instance of the sldoa, which analyses its input with a specific
+ * hop size
+ *
+ * The DoAs are always estimated from frames of sldoa_getFrameSize() samples,
+ * whereas the hop size of the time-frequency transform determines the
+ * frequency resolution: the number of frequency bands is hopSize+5, and each
+ * band holds sldoa_getFrameSize()/hopSize time slots.
+ *
+ * The getters without a handle (e.g. sldoa_getNumberOfBands()) describe
+ * instances created with sldoa_create(); use sldoa_getNumberOfBandsEx() and
+ * sldoa_getProcessingDelayEx() instead.
+ *
+ * @param[in] phSld   (&) address of sldoa handle
+ * @param[in] hopSize Hop size; a power of 2 between #MIN_TF_FRAME_SIZE and
+ *                    sldoa_getFrameSize() (otherwise #DEFAULT_TF_FRAME_SIZE is
+ *                    used)
+ */
+void sldoa_createWithHopSize(void** const phSld, int hopSize);
+
 /**
  * Destroys an instance of the sldoa
  *
@@ -85,12 +105,14 @@ void sldoa_init(void* const hSld,
  *
  * @note This function is fully threadsafe. It can even be called periodically
  *       via a timer on one thread, while calling _process() on another thread.
- *       Since, if a set function is called (that warrants a re-init), then a
- *       flag is triggered internally and the next time this function is called,
- *       it will wait until the current process() function has completed before
- *       reinitialising the relevant parameters. If the _initCodec() takes
- *       longer than the time it takes for process() to be called again, then
- *       process() is simply bypassed until the codec is ready.
+ *       If a set function is called (that warrants a re-init), then the next
+ *       time this function is called, it builds a new codec state (afSTFT and
+ *       sector coefficients), and hands it over to _process() with an atomic
+ *       pointer swap (see saf_stateSwap_create()). Neither function ever waits
+ *       for the other: _process() keeps using the previous codec state until
+ *       the new one is ready (and outputs silence only before the first one is
+ *       ready), and the previous state is freed by this function, once
+ *       _process() has moved on to the new one.
  * @note This function does nothing if no re-initialisations are required.
  *
  * @param[in] hSld - sldoa handle
@@ -190,8 +212,9 @@ void sldoa_setSourcePreset(void* const hSld, int newPresetID);
 /* ========================================================================== */
 
 /**
- * Returns the processing framesize (i.e., number of samples processed with
- * every _process() call )
+ * Returns the processing framesize (i.e., number of samples processed at a
+ * time). _process() accepts any number of samples, but host block sizes
+ * which are a multiple of the frame size add no additional delay
  */
 int sldoa_getFrameSize(void);
 
@@ -241,10 +264,20 @@ float sldoa_getMinFreq(void* const hSld);
 float sldoa_getAvg(void* const hSld);
 
 /**
- * Returns the number frequency bands employed by sldoa
+ * Returns the number frequency bands employed by an instance of sldoa created
+ * with sldoa_create()
+ *
+ * @see sldoa_getNumberOfBandsEx() for the number of bands of a specific
+ *      instance
  */
 int sldoa_getNumberOfBands(void);
 
+/**
+ * Returns the number frequency bands employed by the given instance of sldoa
+ * (i.e. its hop size + 5)
+ */
+int sldoa_getNumberOfBandsEx(void* const hSld);
+
 /**
  * Returns the number of spherical harmonic signals required by the current
  * analysis order: (current_order + 1)^2
@@ -257,7 +290,7 @@ int sldoa_getNSHrequired(void* const hSld);
  * low frequencies), and alpha coefficients (more opaque: higher energy, more
  * transpararent: less energy).
  *
- * @note nBands can be found by using sldoa_getNumberOfBands()
+ * @note nBands can be found by using sldoa_getNumberOfBandsEx()
  *
  * @param[in]  hSld             sldoa handle
  * @param[out] pAzi_deg         (&) azimuth of estimated DoAs;
@@ -323,11 +356,20 @@ int sldoa_getChOrder(void* const hSld);
 int sldoa_getNormType(void* const hSld);
 
 /**
- * Returns the processing delay in samples (may be used for delay compensation
- * features)
+ * Returns the processing delay in samples of an instance created with
+ * sldoa_create() (may be used for delay compensation features)
+ *
+ * @see sldoa_getProcessingDelayEx() for the delay of a specific instance
  */
 int sldoa_getProcessingDelay(void);
 
+/**
+ * Returns the processing delay in samples of the given instance, which accounts
+ * for its hop size and block size adaptation (may be used for delay
+ * compensation features)
+ */
+int sldoa_getProcessingDelayEx(void* const hSld);
+
     
 #ifdef __cplusplus
 } /* extern "C" */
@@ -33,13 +33,31 @@ void ambi_bin_create
 (
     void ** const phAmbi
 )
+{
+    ambi_bin_createWithFrameSize(phAmbi, DEFAULT_TF_FRAME_SIZE);
+}
+
+void ambi_bin_createWithFrameSize
+(
+    void ** const phAmbi,
+    int frameSize
+)
 {
     ambi_bin_data* pData = (ambi_bin_data*)malloc1d(sizeof(ambi_bin_data));
     *phAmbi = (void*)pData;
-    int ch, band;
+    int band;
+
+    /* frame size (= afSTFT hop size), which is fixed for the lifetime of the instance */
+    pData->frameSize = IS_VALID_TF_FRAME_SIZE(frameSize) ? frameSize : DEFAULT_TF_FRAME_SIZE;
+    pData->hopSize = pData->frameSize;
+    pData->nBands = pData->hopSize + 5;
+    pData->timeSlots = pData->frameSize / pData->hopSize;
+    pData->LDmode = 0;
+    pData->new_LDmode = 0;
 
     /* default user parameters */
-    for (band = 0; band<HYBRID_BANDS; band++)
+    pData->EQ = malloc1d(pData->nBands*sizeof(float));
+    for (band = 0; band<pData->nBands; band++)
         pData->EQ[band] = 1.0f;
     pData->useDefaultHRIRsFLAG = 1; /* pars->sofa_filepath must be valid to set this to 0 */
     pData->chOrdering = CH_ACN;
@@ -60,36 +78,31 @@ void ambi_bin_create
     pData->nSH =  (pData->order+1)*(pData->order+1);
     
     /* afSTFT stuff */
-    pData->hSTFT = NULL;
-    pData->STFTOutputFrameTF = malloc1d(NUM_EARS * sizeof(complexVector));
-    for(ch=0; ch< NUM_EARS; ch++) {
-        pData->STFTOutputFrameTF[ch].re = (float*)calloc1d(HYBRID_BANDS, sizeof(float));
-        pData->STFTOutputFrameTF[ch].im = (float*)calloc1d(HYBRID_BANDS, sizeof(float));
-    }
-    pData->tempHopFrameTD = (float**)malloc2d( MAX(MAX_NUM_SH_SIGNALS, NUM_EARS), HOP_SIZE, sizeof(float));
-    pData->STFTInputFrameTF = malloc1d(MAX_NUM_SH_SIGNALS * sizeof(complexVector));
-    for(ch=0; ch< MAX_NUM_SH_SIGNALS; ch++) {
-        pData->STFTInputFrameTF[ch].re = (float*)calloc1d(HYBRID_BANDS, sizeof(float));
-        pData->STFTInputFrameTF[ch].im = (float*)calloc1d(HYBRID_BANDS, sizeof(float));
-    }
+    pData->SHFrameTD = (float**)malloc2d(MAX_NUM_SH_SIGNALS, pData->frameSize, sizeof(float));
+    pData->binFrameTD = (float**)malloc2d(NUM_EARS, pData->frameSize, sizeof(float));
+    pData->SHframeTF = (float_complex***)malloc3d(pData->nBands, MAX_NUM_SH_SIGNALS, pData->timeSlots, sizeof(float_complex));
+    pData->SHframeTF_rot = (float_complex***)malloc3d(pData->nBands, MAX_NUM_SH_SIGNALS, pData->timeSlots, sizeof(float_complex));
+    pData->binframeTF = (float_complex***)malloc3d(pData->nBands, NUM_EARS, pData->timeSlots, sizeof(float_complex));
+    pData->freqVector = calloc1d(pData->nBands, sizeof(float));
 
     /* codec data */
     pData->progressBar0_1 = 0.0f;
     pData->progressBarText = malloc1d(PROGRESSBARTEXT_CHAR_LENGTH*sizeof(char));
     strcpy(pData->progressBarText,"");
-    pData->pars = (ambi_bin_codecPars*)malloc1d(sizeof(ambi_bin_codecPars));
-    ambi_bin_codecPars* pars = pData->pars;
-    pars->sofa_filepath = NULL;
-    pars->hrirs = NULL;
-    pars->hrir_dirs_deg = NULL;
-    pars->itds_s = NULL;
-    pars->hrtf_fb = NULL;
+    pData->sofa_filepath = NULL;
+
+    /* codec states (afSTFT, HRIRs and decoder), which are built by _initCodec() */
+    saf_stateSwap_create(&(pData->hCodecState), ambi_bin_destroyCodecPars);
+    pData->pars = NULL;
+    pData->procPars = NULL;
     
     /* flags */
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
     pData->codecStatus = CODEC_STATUS_NOT_INITIALISED;
     pData->recalc_M_rotFLAG = 1;
     pData->reinit_hrtfsFLAG = 1;
+
+    /* block-size adaptor */
+    saf_blockAdaptor_create(&(pData->hBlockAdaptor), pData->frameSize, MAX_NUM_SH_SIGNALS, NUM_EARS);
 }
 
 void ambi_bin_destroy
@@ -98,39 +111,24 @@ void ambi_bin_destroy
 )
 {
     ambi_bin_data *pData = (ambi_bin_data*)(*phAmbi);
-    ambi_bin_codecPars *pars;
-    int ch;
     
     if (pData != NULL) {
-        /* not safe to free memory during intialisation/processing loop */
-        while (pData->codecStatus == CODEC_STATUS_INITIALISING ||
-               pData->procStatus == PROC_STATUS_ONGOING){
+        saf_blockAdaptor_destroy(&(pData->hBlockAdaptor));
+        /* not safe to free the codec states during intialisation (the
+         * processing loop must have already stopped) */
+        while (saf_atomic_loadInt(&(pData->codecStatus)) == CODEC_STATUS_INITIALISING)
             SAF_SLEEP(10);
-        }
+        saf_stateSwap_destroy(&(pData->hCodecState));
         
-        /* free afSTFT and buffers */ 
-        if(pData->hSTFT!=NULL)
-            afSTFTfree(pData->hSTFT);
-        if(pData->STFTInputFrameTF!=NULL){
-            for (ch = 0; ch< MAX_NUM_SH_SIGNALS; ch++) {
-                free(pData->STFTInputFrameTF[ch].re);
-                free(pData->STFTInputFrameTF[ch].im);
-            }
-        }
-        for (ch = 0; ch< NUM_EARS; ch++) {
-            free(pData->STFTOutputFrameTF[ch].re);
-            free(pData->STFTOutputFrameTF[ch].im);
-        }
-        free(pData->STFTInputFrameTF);
-        free(pData->STFTOutputFrameTF);
-        free(pData->tempHopFrameTD);
-
-        pars = pData->pars;
-        free(pars->hrtf_fb);
-        free(pars->itds_s);
-        free(pars->hrirs);
-        free(pars->hrir_dirs_deg);
-        free(pars);
+        /* free buffers */ 
+        free(pData->SHFrameTD);
+        free(pData->binFrameTD);
+        free(pData->SHframeTF);
+        free(pData->SHframeTF_rot);
+        free(pData->binframeTF);
+        free(pData->freqVector);
+        free(pData->EQ);
+        free(pData->sofa_filepath);
         free(pData->progressBarText);
         
         free(pData);
@@ -146,19 +144,14 @@ void ambi_bin_init
 )
 {
     ambi_bin_data *pData = (ambi_bin_data*)(hAmbi);
-    int band;
     
     /* define frequency vector */
     pData->fs = sampleRate;
-    for(band=0; band <HYBRID_BANDS; band++){
-        if(sampleRate == 44100)
-            pData->freqVector[band] =  (float)__afCenterFreq44100[band];
-        else /* Assume 48kHz */
-            pData->freqVector[band] =  (float)__afCenterFreq48e3[band];
-    }
+    afSTFTgetCenterFreqs(pData->hopSize, 1, (float)sampleRate, pData->freqVector);
 
     /* default starting values */
     pData->recalc_M_rotFLAG = 1;
+    saf_blockAdaptor_reset(pData->hBlockAdaptor);
 }
 
 void ambi_bin_initCodec
@@ -167,96 +160,64 @@ void ambi_bin_initCodec
 )
 {
     ambi_bin_data *pData = (ambi_bin_data*)(hAmbi);
-    ambi_bin_codecPars* pars = pData->pars;
+    ambi_bin_codecPars* pars;
     int i, j, nSH, order, band;
     
-    if (pData->codecStatus != CODEC_STATUS_NOT_INITIALISED)
+    /* The processing loop keeps running with the current codec state, while
+     * a new one is built here (so neither side ever waits for the other) */
+    if (!saf_atomic_compareExchangeInt(&(pData->codecStatus), CODEC_STATUS_NOT_INITIALISED, CODEC_STATUS_INITIALISING))
         return; /* re-init not required, or already happening */
-    while (pData->procStatus == PROC_STATUS_ONGOING){
-        /* re-init required, but we need to wait for the current processing loop to end */
-        pData->codecStatus = CODEC_STATUS_INITIALISING; /* indicate that we want to init */
-        SAF_SLEEP(10);
-    }
     
     /* for progress bar */
-    pData->codecStatus = CODEC_STATUS_INITIALISING;
     strcpy(pData->progressBarText,"Preparing HRIRs");
     pData->progressBar0_1 = 0.0f;
     
-    /* (Re)Initialise afSTFT */
-    order = pData->new_order;
-    nSH = (order+1)*(order+1);
-    if(pData->hSTFT==NULL)
-        afSTFTinit(&(pData->hSTFT), HOP_SIZE, nSH, NUM_EARS, 0, 1);
-    else if(pData->nSH != nSH) {/* Or change the number of channels */
-        afSTFTchannelChange(pData->hSTFT, nSH, NUM_EARS);
-        afSTFTclearBuffers(pData->hSTFT);
-    }
-    pData->nSH = nSH;
+    /* new afSTFT (the one of the current state may still be in use by the
+     * processing loop) */
+    pars = (ambi_bin_codecPars*)calloc1d(1, sizeof(ambi_bin_codecPars));
+    order = pars->order = pData->new_order;
+    nSH = pars->nSH = (order+1)*(order+1);
+    pars->LDmode = pData->new_LDmode;
+    afSTFTinit(&(pars->hSTFT), pData->hopSize, nSH, NUM_EARS, pars->LDmode, 1);
+    pars->M_dec = (float_complex***)calloc3d(pData->nBands, NUM_EARS, MAX_NUM_SH_SIGNALS, sizeof(float_complex));
     
-    if(pData->reinit_hrtfsFLAG){
-        /* load sofa file or default hrir data */
-        strcpy(pData->progressBarText,"Preparing HRIRs");
-        pData->progressBar0_1 = 0.15f;
-        if(!pData->useDefaultHRIRsFLAG && pars->sofa_filepath!=NULL){
-            loadSofaFile(pars->sofa_filepath,
-                         &(pars->hrirs),
-                         &(pars->hrir_dirs_deg),
-                         &(pars->N_hrir_dirs),
-                         &(pars->hrir_len),
-                         &(pars->hrir_fs));
-        }
-        else{
-            loadSofaFile(NULL, /* setting path to NULL loads default HRIR data */
-                         &(pars->hrirs),
-                         &(pars->hrir_dirs_deg),
-                         &(pars->N_hrir_dirs),
-                         &(pars->hrir_len),
-                         &(pars->hrir_fs));
-        }
-        
-        /* estimate the ITDs for each HRIR */
-        pData->progressBar0_1 = 0.3f;
-        pars->itds_s = realloc1d(pars->itds_s, pars->N_hrir_dirs*sizeof(float));
-        estimateITDs(pars->hrirs, pars->N_hrir_dirs, pars->hrir_len, pars->hrir_fs, pars->itds_s);
-        
-        /* convert hrirs to filterbank coefficients */
-        pData->progressBar0_1 = 0.9f;
-        pars->hrtf_fb = realloc1d(pars->hrtf_fb, HYBRID_BANDS * NUM_EARS * (pars->N_hrir_dirs)*sizeof(float_complex));
-        HRIRs2FilterbankHRTFs(pars->hrirs, pars->N_hrir_dirs, pars->hrir_len, HOP_SIZE, 1, pars->hrtf_fb);
-        diffuseFieldEqualiseHRTFs(pars->N_hrir_dirs, pars->itds_s, pData->freqVector, HYBRID_BANDS, pars->hrtf_fb);
+    /* reinit HRTFs, or take them from the previous state */
+    if(pData->reinit_hrtfsFLAG || pData->pars==NULL){
         pData->reinit_hrtfsFLAG = 0;
+        ambi_bin_initHRTFs(hAmbi, pars);
     }
+    else
+        ambi_bin_copyHRTFs(hAmbi, pData->pars, pars);
     
     /* get new decoder */
     strcpy(pData->progressBarText,"Computing Decoder");
     pData->progressBar0_1 = 0.95f;
     float_complex* decMtx;
-    decMtx = calloc1d(HYBRID_BANDS*NUM_EARS*nSH, sizeof(float_complex));
+    decMtx = calloc1d(pData->nBands*NUM_EARS*nSH, sizeof(float_complex));
     switch(pData->method){
         default:
         case DECODING_METHOD_LS:
-            getBinauralAmbiDecoderMtx(pars->hrtf_fb, pars->hrir_dirs_deg, pars->N_hrir_dirs, HYBRID_BANDS,
+            getBinauralAmbiDecoderMtx(pars->hrtf_fb, pars->hrir_dirs_deg, pars->N_hrir_dirs, pData->nBands,
                                       BINAURAL_DECODER_LS, order, pData->freqVector, pars->itds_s, NULL,
                                       pData->enableDiffuseMatching, pData->enableMaxRE, decMtx);
             break;
         case DECODING_METHOD_LSDIFFEQ:
-            getBinauralAmbiDecoderMtx(pars->hrtf_fb, pars->hrir_dirs_deg, pars->N_hrir_dirs, HYBRID_BANDS,
+            getBinauralAmbiDecoderMtx(pars->hrtf_fb, pars->hrir_dirs_deg, pars->N_hrir_dirs, pData->nBands,
                                       BINAURAL_DECODER_LSDIFFEQ, order, pData->freqVector, pars->itds_s, NULL,
                                       pData->enableDiffuseMatching, pData->enableMaxRE, decMtx);
             break;
         case DECODING_METHOD_SPR:
-            getBinauralAmbiDecoderMtx(pars->hrtf_fb, pars->hrir_dirs_deg, pars->N_hrir_dirs, HYBRID_BANDS,
+            getBinauralAmbiDecoderMtx(pars->hrtf_fb, pars->hrir_dirs_deg, pars->N_hrir_dirs, pData->nBands,
                                       BINAURAL_DECODER_SPR, order, pData->freqVector, pars->itds_s, NULL,
                                       pData->enableDiffuseMatching, pData->enableMaxRE, decMtx);
             break;
         case DECODING_METHOD_TA:
-            getBinauralAmbiDecoderMtx(pars->hrtf_fb, pars->hrir_dirs_deg, pars->N_hrir_dirs, HYBRID_BANDS,
+            getBinauralAmbiDecoderMtx(pars->hrtf_fb, pars->hrir_dirs_deg, pars->N_hrir_dirs, pData->nBands,
                                       BINAURAL_DECODER_TA, order, pData->freqVector, pars->itds_s, NULL,
                                       pData->enableDiffuseMatching, pData->enableMaxRE, decMtx);
             break;
         case DECODING_METHOD_MAGLS:
-            getBinauralAmbiDecoderMtx(pars->hrtf_fb, pars->hrir_dirs_deg, pars->N_hrir_dirs, HYBRID_BANDS,
+            getBinauralAmbiDecoderMtx(pars->hrtf_fb, pars->hrir_dirs_deg, pars->N_hrir_dirs, pData->nBands,
                                       BINAURAL_DECODER_MAGLS, order, pData->freqVector, pars->itds_s, NULL,
                                       pData->enableDiffuseMatching, pData->enableMaxRE, decMtx);
             break;
@@ -267,66 +228,86 @@ void ambi_bin_initCodec
         // COMING SOON
     }
     
-    /* replace current decoder */
-    memset(pars->M_dec, 0, HYBRID_BANDS*NUM_EARS*MAX_NUM_SH_SIGNALS*sizeof(float_complex));
-    for(band=0; band<HYBRID_BANDS; band++)
+    /* store the new decoder */
+    for(band=0; band<pData->nBands; band++)
         for(i=0; i<NUM_EARS; i++)
             for(j=0; j<nSH; j++)
                 pars->M_dec[band][i][j] = decMtx[band*NUM_EARS*nSH + i*nSH + j];
     free(decMtx);
     
+    /* hand the new state over to the processing loop */
+    saf_stateSwap_publish(pData->hCodecState, (void*)pars);
+    pData->pars = pars;
     pData->order = order;
+    pData->nSH = nSH;
+    pData->LDmode = pars->LDmode;
 
-    /* done! */
+    /* done! (unless a setting changed in the meantime, in which case the
+     * status remains CODEC_STATUS_NOT_INITIALISED) */
     strcpy(pData->progressBarText,"Done!");
     pData->progressBar0_1 = 1.0f;
-    pData->codecStatus = CODEC_STATUS_INITIALISED;
+    saf_atomic_compareExchangeInt(&(pData->codecStatus), CODEC_STATUS_INITIALISING, CODEC_STATUS_INITIALISED);
 }
 
-void ambi_bin_process
+/** Processes one frame of frameSize samples (see saf_blockAdaptor_apply()) */
+static void ambi_bin_processFrame
 (
     void  *  const hAmbi,
     float ** const inputs,
     float ** const outputs,
     int            nInputs,
-    int            nOutputs,
-    int            nSamples
+    int            nOutputs
 )
 {
     ambi_bin_data *pData = (ambi_bin_data*)(hAmbi);
-    ambi_bin_codecPars* pars = pData->pars;
-    int t, ch, i, j, band;
+    ambi_bin_codecPars* pars;
+    int ch, i, band, frameSize, nBands, timeSlots, convertInputs;
     const float_complex calpha = cmplxf(1.0f,0.0f), cbeta = cmplxf(0.0f, 0.0f);
     float Rxyz[3][3];
-    float* M_rot_tmp;
-    
-    /* local copies of user parameters */
+    float* inPtrs[MAX_NUM_SH_SIGNALS], *outPtrs[NUM_EARS];
     int order, nSH, enableRot;
     NORM_TYPES norm;
     CH_ORDER chOrdering;
+    
+    /* pick up the latest codec state (never blocks); the rotation matrix must
+     * be recomputed whenever it changes, as it depends on the order */
+    pars = (ambi_bin_codecPars*)saf_stateSwap_acquire(pData->hCodecState);
+    if(pars != pData->procPars){
+        pData->procPars = pars;
+        pData->recalc_M_rotFLAG = 1;
+    }
+
+    /* local copies of user parameters */
     norm = pData->norm;
     chOrdering = pData->chOrdering;
-    order = pData->order;
+    order = pars!=NULL ? pars->order : 0;
     nSH = (order+1)*(order+1);
     enableRot = pData->enableRotation;
+    frameSize = pData->frameSize;
+    nBands = pData->nBands;
+    timeSlots = pData->timeSlots;
 
     /* Process frame */
-    if (nSamples == FRAME_SIZE && (pData->codecStatus == CODEC_STATUS_INITIALISED) ) {
-        pData->procStatus = PROC_STATUS_ONGOING;
-
-        /* Load time-domain data */
-        for(i=0; i < MIN(nSH, nInputs); i++)
-            utility_svvcopy(inputs[i], FRAME_SIZE, pData->SHFrameTD[i]);
-        for(; i<nSH; i++)
-            memset(pData->SHFrameTD[i], 0, FRAME_SIZE * sizeof(float)); /* fill remaining channels with zeros */
+    if (pars!=NULL) {
+        /* Load time-domain data; the host frames are transformed directly,
+         * unless they must first be converted to ACN/N3D */
+        convertInputs = chOrdering!=CH_ACN || norm!=NORM_N3D;
+        for(i=0; i < MIN(nSH, nInputs); i++){
+            if(convertInputs)
+                utility_svvcopy(inputs[i], frameSize, pData->SHFrameTD[i]);
+            inPtrs[i] = convertInputs ? pData->SHFrameTD[i] : inputs[i];
+        }
+        for(; i<nSH; i++){
+            memset(pData->SHFrameTD[i], 0, frameSize * sizeof(float)); /* fill remaining channels with zeros */
+            inPtrs[i] = pData->SHFrameTD[i];
+        }
 
         /* account for channel order convention */
         switch(chOrdering){
-            case CH_ACN:
-                convertHOAChannelConvention((float*)pData->SHFrameTD, order, FRAME_SIZE, HOA_CH_ORDER_ACN, HOA_CH_ORDER_ACN);
+            case CH_ACN: /* already ACN */
                 break;
             case CH_FUMA:
-                convertHOAChannelConvention((float*)pData->SHFrameTD, order, FRAME_SIZE, HOA_CH_ORDER_FUMA, HOA_CH_ORDER_ACN);
+                convertHOAChannelConvention(FLATTEN2D(pData->SHFrameTD), order, frameSize, HOA_CH_ORDER_FUMA, HOA_CH_ORDER_ACN);
                 break;
         }
 
@@ -335,76 +316,85 @@ void ambi_bin_process
             case NORM_N3D:  /* already in N3D, do nothing */
                 break;
             case NORM_SN3D: /* convert to N3D */
-                convertHOANormConvention((float*)pData->SHFrameTD, order, FRAME_SIZE, HOA_NORM_SN3D, HOA_NORM_N3D);
+                convertHOANormConvention(FLATTEN2D(pData->SHFrameTD), order, frameSize, HOA_NORM_SN3D, HOA_NORM_N3D);
                 break;
             case NORM_FUMA: /* only for first-order, convert to N3D */
-                convertHOANormConvention((float*)pData->SHFrameTD, order, FRAME_SIZE, HOA_NORM_FUMA, HOA_NORM_N3D);
+                convertHOANormConvention(FLATTEN2D(pData->SHFrameTD), order, frameSize, HOA_NORM_FUMA, HOA_NORM_N3D);
                 break;
         }
 
         /* Apply time-frequency transform (TFT) */
-        for(t=0; t< TIME_SLOTS; t++) {
-            for(ch = 0; ch < nSH; ch++)
-                utility_svvcopy(&(pData->SHFrameTD[ch][t*HOP_SIZE]), HOP_SIZE, pData->tempHopFrameTD[ch]);
-            afSTFTforward(pData->hSTFT, pData->tempHopFrameTD, pData->STFTInputFrameTF);
-            for(band=0; band<HYBRID_BANDS; band++)
-                for(ch=0; ch < nSH; ch++)
-                    pData->SHframeTF[band][ch][t] = cmplxf(pData->STFTInputFrameTF[ch].re[band], pData->STFTInputFrameTF[ch].im[band]);
-        }
+        afSTFTforwardFrame(pars->hSTFT, inPtrs, frameSize, MAX_NUM_SH_SIGNALS,
+                           AFSTFT_BANDS_CH_TIME, FLATTEN3D(pData->SHframeTF));
 
         /* Main processing: */
         if(order > 0 && enableRot) {
             /* Apply rotation */
             if(pData->recalc_M_rotFLAG){
-                memset(pData->M_rot, 0, MAX_NUM_SH_SIGNALS*MAX_NUM_SH_SIGNALS*sizeof(float_complex));
-                M_rot_tmp = malloc1d(nSH*nSH * sizeof(float));
                 yawPitchRoll2Rzyx(pData->yaw, pData->pitch, pData->roll, pData->useRollPitchYawFlag, Rxyz);
-                getSHrotMtxReal(Rxyz, M_rot_tmp, order);
-                for (i = 0; i < nSH; i++)
-                    for (j = 0; j < nSH; j++)
-                        pData->M_rot[i][j] = cmplxf(M_rot_tmp[i*nSH + j], 0.0f);
-                free(M_rot_tmp);
+                getSHrotMtxRealBlocks(Rxyz, pData->M_rot, order);
                 pData->recalc_M_rotFLAG = 0;
             }
-            for(band = 0; band < HYBRID_BANDS; band++) {
-                cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nSH, TIME_SLOTS, nSH, &calpha,
-                            pData->M_rot, MAX_NUM_SH_SIGNALS,
-                            pData->SHframeTF[band], TIME_SLOTS, &cbeta,
-                            pData->SHframeTF_rot[band], TIME_SLOTS);
-            }
+            applySHblockMtxToCmplx(pData->M_rot, order, FLATTEN3D(pData->SHframeTF), timeSlots,
+                                   MAX_NUM_SH_SIGNALS*timeSlots, timeSlots, nBands,
+                                   FLATTEN3D(pData->SHframeTF_rot), timeSlots, MAX_NUM_SH_SIGNALS*timeSlots);
         }
         else
-            memcpy(pData->SHframeTF_rot, pData->SHframeTF, HYBRID_BANDS*MAX_NUM_SH_SIGNALS*TIME_SLOTS*sizeof(float_complex));
+            memcpy(FLATTEN3D(pData->SHframeTF_rot), FLATTEN3D(pData->SHframeTF), nBands*MAX_NUM_SH_SIGNALS*timeSlots*sizeof(float_complex));
 
         /* mix to headphones */
-        for(band = 0; band < HYBRID_BANDS; band++) {
-            cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, NUM_EARS, TIME_SLOTS, nSH, &calpha,
-                        pars->M_dec[band], MAX_NUM_SH_SIGNALS,
-                        pData->SHframeTF_rot[band], TIME_SLOTS, &cbeta,
-                        pData->binframeTF[band], TIME_SLOTS);
+        for(band = 0; band < nBands; band++) {
+            cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, NUM_EARS, timeSlots, nSH, &calpha,
+                        FLATTEN2D(pars->M_dec[band]), MAX_NUM_SH_SIGNALS,
+                        FLATTEN2D(pData->SHframeTF_rot[band]), timeSlots, &cbeta,
+                        FLATTEN2D(pData->binframeTF[band]), timeSlots);
         }
 
-        /* inverse-TFT */
+        /* inverse-TFT (directly into the host frames, as the inputs have
+         * already been read) */
         //postGain = powf(10.0f, POST_GAIN/20.0f);
-        for(t = 0; t < TIME_SLOTS; t++) {
-            for(band = 0; band < HYBRID_BANDS; band++) {
-                for(ch = 0; ch < NUM_EARS; ch++) {
-                    pData->STFTOutputFrameTF[ch].re[band] = crealf(pData->binframeTF[band][ch][t]);
-                    pData->STFTOutputFrameTF[ch].im[band] = cimagf(pData->binframeTF[band][ch][t]);
-                }
-            }
-            afSTFTinverse(pData->hSTFT, pData->STFTOutputFrameTF, pData->tempHopFrameTD);
-            for (ch = 0; ch < MIN(NUM_EARS, nOutputs); ch++)
-                utility_svvcopy(pData->tempHopFrameTD[ch], HOP_SIZE, &(outputs[ch][t* HOP_SIZE]));
-            for (; ch < nOutputs; ch++)
-                memset(&(outputs[ch][t* HOP_SIZE]), 0, HOP_SIZE*sizeof(float));
-        }
+        for (ch = 0; ch < NUM_EARS; ch++)
+            outPtrs[ch] = ch < nOutputs ? outputs[ch] : pData->binFrameTD[ch];
+        afSTFTinverseFrame(pars->hSTFT, FLATTEN3D(pData->binframeTF), frameSize, NUM_EARS,
+                           AFSTFT_BANDS_CH_TIME, outPtrs);
+        for (ch = NUM_EARS; ch < nOutputs; ch++)
+            memset(outputs[ch], 0, frameSize*sizeof(float));
     }
     else
         for (ch=0; ch < nOutputs; ch++)
-            memset(outputs[ch],0, FRAME_SIZE*sizeof(float));
+            memset(outputs[ch],0, frameSize*sizeof(float));
+}
+
+void ambi_bin_process
+(
+    void  *  const hAmbi,
+    float ** const inputs,
+    float ** const outputs,
+    int            nInputs,
+    int            nOutputs,
+    int            nSamples
+)
+{
+    ambi_bin_data *pData = (ambi_bin_data*)(hAmbi);
+
+    saf_blockAdaptor_apply(pData->hBlockAdaptor, inputs, outputs, nInputs, nOutputs,
+                           nSamples, ambi_bin_processFrame, hAmbi);
+}
+
+void ambi_bin_processInterleaved
+(
+    void  *  const hAmbi,
+    const float *  inputs,
+    float *        outputs,
+    int            nInputs,
+    int            nOutputs,
+    int            nSamples
+)
+{
+    ambi_bin_data *pData = (ambi_bin_data*)(hAmbi);
 
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
+    saf_blockAdaptor_applyStrided(pData->hBlockAdaptor, inputs, 1, nInputs, outputs, 1, nOutputs,
+                                  nInputs, nOutputs, nSamples, ambi_bin_processFrame, hAmbi);
 }
 
 
@@ -431,10 +421,9 @@ void ambi_bin_setUseDefaultHRIRsflag(void* const hAmbi, int newState)
 void ambi_bin_setSofaFilePath(void* const hAmbi, const char* path)
 {
     ambi_bin_data *pData = (ambi_bin_data*)(hAmbi);
-    ambi_bin_codecPars* pars = pData->pars;
     
-    pars->sofa_filepath = malloc1d(strlen(path) + 1);
-    strcpy(pars->sofa_filepath, path);
+    pData->sofa_filepath = realloc1d(pData->sofa_filepath, strlen(path) + 1);
+    strcpy(pData->sofa_filepath, path);
     pData->useDefaultHRIRsFLAG = 0;
     pData->reinit_hrtfsFLAG = 1;
     ambi_bin_setCodecStatus(hAmbi, CODEC_STATUS_NOT_INITIALISED);
@@ -562,18 +551,33 @@ void ambi_bin_setRPYflag(void* const hAmbi, int newState)
     pData->useRollPitchYawFlag = newState;
 }
 
+void ambi_bin_setLowDelayMode(void* const hAmbi, int newState)
+{
+    ambi_bin_data *pData = (ambi_bin_data*)(hAmbi);
+    if(pData->new_LDmode != (newState ? 1 : 0)){
+        pData->new_LDmode = newState ? 1 : 0;
+        ambi_bin_setCodecStatus(hAmbi, CODEC_STATUS_NOT_INITIALISED);
+    }
+}
+
 
 /* Get Functions */
 
 int ambi_bin_getFrameSize(void)
 {
-    return FRAME_SIZE;
+    return DEFAULT_TF_FRAME_SIZE;
+}
+
+int ambi_bin_getFrameSizeEx(void* const hAmbi)
+{
+    ambi_bin_data *pData = (ambi_bin_data*)(hAmbi);
+    return pData->frameSize;
 }
 
 CODEC_STATUS ambi_bin_getCodecStatus(void* const hAmbi)
 {
     ambi_bin_data *pData = (ambi_bin_data*)(hAmbi);
-    return pData->codecStatus;
+    return (CODEC_STATUS)saf_atomic_loadInt(&(pData->codecStatus));
 }
 
 float ambi_bin_getProgressBar0_1(void* const hAmbi)
@@ -609,9 +613,8 @@ int ambi_bin_getDecodingMethod(void* const hAmbi)
 char* ambi_bin_getSofaFilePath(void* const hAmbi)
 {
     ambi_bin_data *pData = (ambi_bin_data*)(hAmbi);
-    ambi_bin_codecPars* pars = pData->pars;
-    if(pars->sofa_filepath!=NULL)
-        return pars->sofa_filepath;
+    if(pData->sofa_filepath!=NULL)
+        return pData->sofa_filepath;
     else
         return "no_file";
 }
@@ -708,22 +711,19 @@ int ambi_bin_getRPYflag(void* const hAmbi)
 int ambi_bin_getNDirs(void* const hAmbi)
 {
     ambi_bin_data *pData = (ambi_bin_data*)(hAmbi);
-    ambi_bin_codecPars* pars = pData->pars;
-    return pars->N_hrir_dirs;
+    return pData->pars!=NULL ? pData->pars->N_hrir_dirs : 0;
 }
 
 int ambi_bin_getHRIRlength(void* const hAmbi)
 {
     ambi_bin_data *pData = (ambi_bin_data*)(hAmbi);
-    ambi_bin_codecPars* pars = pData->pars;
-    return pars->hrir_len;
+    return pData->pars!=NULL ? pData->pars->hrir_len : 0;
 }
 
 int ambi_bin_getHRIRsamplerate(void* const hAmbi)
 {
     ambi_bin_data *pData = (ambi_bin_data*)(hAmbi);
-    ambi_bin_codecPars* pars = pData->pars;
-    return pars->hrir_fs;
+    return pData->pars!=NULL ? pData->pars->hrir_fs : 0;
 }
 
 int ambi_bin_getDAWsamplerate(void* const hAmbi)
@@ -732,7 +732,19 @@ int ambi_bin_getDAWsamplerate(void* const hAmbi)
     return pData->fs;
 }
 
-int ambi_bin_getProcessingDelay()
+int ambi_bin_getLowDelayMode(void* const hAmbi)
+{
+    ambi_bin_data *pData = (ambi_bin_data*)(hAmbi);
+    return pData->new_LDmode;
+}
+
+int ambi_bin_getProcessingDelay(void)
 {
-    return 12*HOP_SIZE;
+    return afSTFTgetProcessingDelay(DEFAULT_TF_FRAME_SIZE, 0, 1);
+}
+
+int ambi_bin_getProcessingDelayEx(void* const hAmbi)
+{
+    ambi_bin_data *pData = (ambi_bin_data*)(hAmbi);
+    return afSTFTgetProcessingDelay(pData->hopSize, pData->LDmode, 1) + saf_blockAdaptor_getDelay(pData->hBlockAdaptor);
 }
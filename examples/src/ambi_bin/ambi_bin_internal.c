@@ -33,10 +33,80 @@
 void ambi_bin_setCodecStatus(void* const hAmbi, CODEC_STATUS newStatus)
 {
     ambi_bin_data *pData = (ambi_bin_data*)(hAmbi);
-    if(newStatus==CODEC_STATUS_NOT_INITIALISED){
-        /* Pause until current initialisation is complete */
-        while(pData->codecStatus == CODEC_STATUS_INITIALISING)
-            SAF_SLEEP(10);
+    saf_atomic_storeInt(&(pData->codecStatus), (int)newStatus);
+}
+
+void ambi_bin_destroyCodecPars(void** const phPars)
+{
+    ambi_bin_codecPars *pars = (ambi_bin_codecPars*)(*phPars);
+
+    if(pars!=NULL){
+        if(pars->hSTFT!=NULL)
+            afSTFTfree(pars->hSTFT);
+        free(pars->M_dec);
+        free(pars->hrirs);
+        free(pars->hrir_dirs_deg);
+        free(pars->itds_s);
+        free(pars->hrtf_fb);
+        free(pars);
+        *phPars = NULL;
+    }
+}
+
+void ambi_bin_initHRTFs(void* const hAmbi, ambi_bin_codecPars* pars)
+{
+    ambi_bin_data *pData = (ambi_bin_data*)(hAmbi);
+
+    /* load sofa file or default hrir data */
+    strcpy(pData->progressBarText,"Preparing HRIRs");
+    pData->progressBar0_1 = 0.15f;
+    if(!pData->useDefaultHRIRsFLAG && pData->sofa_filepath!=NULL){
+        loadSofaFile(pData->sofa_filepath,
+                     &(pars->hrirs),
+                     &(pars->hrir_dirs_deg),
+                     &(pars->N_hrir_dirs),
+                     &(pars->hrir_len),
+                     &(pars->hrir_fs));
+    }
+    else{
+        loadSofaFile(NULL, /* setting path to NULL loads default HRIR data */
+                     &(pars->hrirs),
+                     &(pars->hrir_dirs_deg),
+                     &(pars->N_hrir_dirs),
+                     &(pars->hrir_len),
+                     &(pars->hrir_fs));
     }
-    pData->codecStatus = newStatus;
+
+    /* estimate the ITDs for each HRIR */
+    pData->progressBar0_1 = 0.3f;
+    pars->itds_s = realloc1d(pars->itds_s, pars->N_hrir_dirs*sizeof(float));
+    estimateITDs(pars->hrirs, pars->N_hrir_dirs, pars->hrir_len, pars->hrir_fs, pars->itds_s);
+
+    /* convert hrirs to filterbank coefficients */
+    pData->progressBar0_1 = 0.9f;
+    pars->hrtf_fb = realloc1d(pars->hrtf_fb, pData->nBands * NUM_EARS * (pars->N_hrir_dirs)*sizeof(float_complex));
+    HRIRs2FilterbankHRTFs(pars->hrirs, pars->N_hrir_dirs, pars->hrir_len, pData->hopSize, 1, pars->hrtf_fb);
+    diffuseFieldEqualiseHRTFs(pars->N_hrir_dirs, pars->itds_s, pData->freqVector, pData->nBands, pars->hrtf_fb);
+}
+
+void ambi_bin_copyHRTFs
+(
+    void* const hAmbi,
+    ambi_bin_codecPars* src,
+    ambi_bin_codecPars* dst
+)
+{
+    ambi_bin_data *pData = (ambi_bin_data*)(hAmbi);
+
+    dst->N_hrir_dirs = src->N_hrir_dirs;
+    dst->hrir_len = src->hrir_len;
+    dst->hrir_fs = src->hrir_fs;
+    dst->hrirs = malloc1d(src->N_hrir_dirs*NUM_EARS*src->hrir_len*sizeof(float));
+    memcpy(dst->hrirs, src->hrirs, src->N_hrir_dirs*NUM_EARS*src->hrir_len*sizeof(float));
+    dst->hrir_dirs_deg = malloc1d(src->N_hrir_dirs*2*sizeof(float));
+    memcpy(dst->hrir_dirs_deg, src->hrir_dirs_deg, src->N_hrir_dirs*2*sizeof(float));
+    dst->itds_s = malloc1d(src->N_hrir_dirs*sizeof(float));
+    memcpy(dst->itds_s, src->itds_s, src->N_hrir_dirs*sizeof(float));
+    dst->hrtf_fb = malloc1d(pData->nBands*NUM_EARS*(src->N_hrir_dirs)*sizeof(float_complex));
+    memcpy(dst->hrtf_fb, src->hrtf_fb, pData->nBands*NUM_EARS*(src->N_hrir_dirs)*sizeof(float_complex));
 }
@@ -44,12 +44,6 @@ extern "C" {
 /*                            Internal Parameters                             */
 /* ========================================================================== */
 
-#ifndef FRAME_SIZE
-# define FRAME_SIZE ( 128 )
-#endif
-#define HOP_SIZE ( 128 ) /* STFT hop size */
-#define HYBRID_BANDS ( 133 )
-#define TIME_SLOTS ( FRAME_SIZE / HOP_SIZE )  
 #define POST_GAIN ( -9.0f )   /* dB */
 #ifndef DEG2RAD
 # define DEG2RAD(x) (x * M_PI / 180.0f)
@@ -64,15 +58,26 @@ extern "C" {
 /* ========================================================================== */
 
 /**
- * Contains variables for sofa file loading, HRIRs, and the binaural decoder.
+ * Codec state of ambi_bin: the afSTFT, HRIRs, and the binaural decoder for one
+ * configuration
+ *
+ * A new state is built by ambi_bin_initCodec() and handed over to the
+ * processing loop via a saf_stateSwap (see saf_stateSwap_create()). Once
+ * published, it is no longer modified; except for the afSTFT buffers, which
+ * only the processing loop uses.
  */
 typedef struct _ambi_bin_codecPars
 {
+    /* afSTFT */
+    int order;              /**< decoding order the state is built for */
+    int nSH;                /**< number of spherical harmonic signals; (order+1)^2 */
+    int LDmode;             /**< low-delay mode of the afSTFT */
+    void* hSTFT;            /**< afSTFT handle */
+
     /* Decoder */
-    float_complex M_dec[HYBRID_BANDS][NUM_EARS][MAX_NUM_SH_SIGNALS];
+    float_complex*** M_dec; /**< binaural decoding matrices; nBands x NUM_EARS x MAX_NUM_SH_SIGNALS */
     
     /* sofa file info */
-    char* sofa_filepath;    /**< absolute/relevative file path for a sofa file */
     float* hrirs;           /**< time domain HRIRs; FLAT: N_hrir_dirs x 2 x hrir_len */
     float* hrir_dirs_deg;   /**< directions of the HRIRs in degrees [azi elev]; FLAT: N_hrir_dirs x 2 */
     int N_hrir_dirs;        /**< number of HRIR directions in the current sofa file */
@@ -93,28 +98,34 @@ typedef struct _ambi_bin
 {
     /* audio buffers + afSTFT time-frequency transform handle */
     int fs;                         /**< host sampling rate */ 
-    float SHFrameTD[MAX_NUM_SH_SIGNALS][FRAME_SIZE];
-    float_complex SHframeTF[HYBRID_BANDS][MAX_NUM_SH_SIGNALS][TIME_SLOTS];
-    float_complex SHframeTF_rot[HYBRID_BANDS][MAX_NUM_SH_SIGNALS][TIME_SLOTS];
-    float_complex binframeTF[HYBRID_BANDS][NUM_EARS][TIME_SLOTS];
-    complexVector* STFTInputFrameTF;
-    complexVector* STFTOutputFrameTF;
-    void* hSTFT;                    /**< afSTFT handle */
+    int frameSize;                  /**< processing frame size, in samples (fixed at creation) */
+    int hopSize;                    /**< afSTFT hop size, in samples */
+    int nBands;                     /**< number of (hybrid) frequency bands; hopSize + 5 */
+    int timeSlots;                  /**< number of time slots per frame; frameSize / hopSize */
+    int LDmode;                     /**< low-delay mode of the latest codec state */
+    int new_LDmode;                 /**< new low-delay mode; applied when the afSTFT is re-initialised */
+    float** SHFrameTD;              /**< MAX_NUM_SH_SIGNALS x frameSize */
+    float** binFrameTD;             /**< NUM_EARS x frameSize */
+    float_complex*** SHframeTF;     /**< nBands x MAX_NUM_SH_SIGNALS x timeSlots */
+    float_complex*** SHframeTF_rot; /**< nBands x MAX_NUM_SH_SIGNALS x timeSlots */
+    float_complex*** binframeTF;    /**< nBands x NUM_EARS x timeSlots */
+    void* hBlockAdaptor;            /**< block-size adaptor handle */
     int afSTFTdelay;                /**< for host delay compensation */
-    float** tempHopFrameTD;         /**< temporary multi-channel time-domain buffer of size "HOP_SIZE". */
-    float freqVector[HYBRID_BANDS]; /**< frequency vector for time-frequency transform, in Hz */
+    float* freqVector;              /**< frequency vector for time-frequency transform, in Hz; nBands x 1 */
      
     /* our codec configuration */
-    CODEC_STATUS codecStatus;
+    volatile int codecStatus;       /**< see #_CODEC_STATUS enum */
     float progressBar0_1;
     char* progressBarText;
-    ambi_bin_codecPars* pars;
+    void* hCodecState;              /**< saf_stateSwap handing ambi_bin_codecPars to the processing loop */
+    ambi_bin_codecPars* pars;       /**< latest codec state built by ambi_bin_initCodec() (NULL if none) */
+    ambi_bin_codecPars* procPars;   /**< codec state last used by the processing loop (only accessed by it) */
+    char* sofa_filepath;            /**< absolute/relevative file path for a sofa file */
     
     /* internal variables */
-    PROC_STATUS procStatus;
-    float_complex M_rot[MAX_NUM_SH_SIGNALS][MAX_NUM_SH_SIGNALS]; 
+    float M_rot[ORDER2NSHROT(MAX_SH_ORDER)]; /**< diagonal blocks of the rotation matrix (see getSHrotMtxRealBlocks()) */
     int new_order;                  /**< new decoding order */
-    int nSH;                        /**< number of spherical harmonic signals */
+    int nSH;                        /**< number of spherical harmonic signals of the latest codec state */
     
     /* flags */ 
     int recalc_M_rotFLAG;           /**< 0: no init required, 1: init required */
@@ -126,7 +137,7 @@ typedef struct _ambi_bin
     int enableDiffuseMatching;      /**< 0: disabled, 1: enabled */
     int enablePhaseWarping;         /**< 0: disabled, 1: enabled */
     AMBI_BIN_DECODING_METHODS method; /* current decoding method */
-    float EQ[HYBRID_BANDS];         /**< EQ curve */
+    float* EQ;                      /**< EQ curve; nBands x 1 */
     int useDefaultHRIRsFLAG;        /**< 1: use default HRIRs in database, 0: use those from SOFA file */
     CH_ORDER chOrdering;
     NORM_TYPES norm;
@@ -143,11 +154,44 @@ typedef struct _ambi_bin
 /* ========================================================================== */
 
 /**
- * Sets codec status. 
+ * Sets codec status (see #_CODEC_STATUS enum)
+ *
+ * This never waits: if the codec is being initialised, then setting
+ * #CODEC_STATUS_NOT_INITIALISED causes ambi_bin_initCodec() to leave the
+ * status as such, so that the next call re-initialises the codec again.
  */
 void ambi_bin_setCodecStatus(void* const hAmbi,
                              CODEC_STATUS newStatus);
 
+/**
+ * Destroys a codec state (see saf_stateSwap_destroyFn)
+ *
+ * @param[in] phPars (&) address of the ambi_bin_codecPars
+ */
+void ambi_bin_destroyCodecPars(void** const phPars);
+
+/**
+ * Loads the HRIRs (either the default set or those of the SOFA file), and
+ * computes their ITDs and filterbank coefficients, for a new codec state
+ *
+ * @param[in] hAmbi ambi_bin handle
+ * @param[in] pars  The new codec state
+ */
+void ambi_bin_initHRTFs(void* const hAmbi,
+                        ambi_bin_codecPars* pars);
+
+/**
+ * Copies the HRIRs, ITDs and filterbank coefficients of one codec state into
+ * a new one (when they do not need to be recomputed)
+ *
+ * @param[in] hAmbi ambi_bin handle
+ * @param[in] src   Codec state to copy from
+ * @param[in] dst   The new codec state
+ */
+void ambi_bin_copyHRTFs(void* const hAmbi,
+                        ambi_bin_codecPars* src,
+                        ambi_bin_codecPars* dst);
+
 
 #ifdef __cplusplus
 } /* extern "C" { */
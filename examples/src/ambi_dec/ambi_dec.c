@@ -37,14 +37,32 @@ void ambi_dec_create
 (
     void ** const phAmbi
 )
+{
+    ambi_dec_createWithFrameSize(phAmbi, DEFAULT_TF_FRAME_SIZE);
+}
+
+void ambi_dec_createWithFrameSize
+(
+    void ** const phAmbi,
+    int frameSize
+)
 {
     ambi_dec_data* pData = (ambi_dec_data*)malloc1d(sizeof(ambi_dec_data));
     *phAmbi = (void*)pData;
-    int i, j, ch, band;
+    int ch, band;
+
+    /* frame size (= afSTFT hop size), which is fixed for the lifetime of the instance */
+    pData->frameSize = IS_VALID_TF_FRAME_SIZE(frameSize) ? frameSize : DEFAULT_TF_FRAME_SIZE;
+    pData->hopSize = pData->frameSize;
+    pData->nBands = pData->hopSize + 5;
+    pData->timeSlots = pData->frameSize / pData->hopSize;
+    pData->LDmode = 0;
+    pData->new_LDmode = 0;
 
     /* default user parameters */
     pData->masterOrder = pData->new_masterOrder = 1;
-    for (band = 0; band<HYBRID_BANDS; band++)
+    pData->orderPerBand = malloc1d(pData->nBands*sizeof(int));
+    for (band = 0; band<pData->nBands; band++)
         pData->orderPerBand[band] = 1;
     pData->useDefaultHRIRsFLAG = 1; /* pars->sofa_filepath must be valid to set this to 0 */
     loadLoudspeakerArrayPreset(LOUDSPEAKER_ARRAY_PRESET_T_DESIGN_24, pData->loudpkrs_dirs_deg, &(pData->new_nLoudpkrs), &(pData->loudpkrs_nDims));
@@ -60,51 +78,36 @@ void ambi_dec_create
     pData->transitionFreq = 800.0f;
     
     /* afSTFT stuff */
-    pData->hSTFT = NULL;
-    pData->STFTInputFrameTF = malloc1d(MAX_NUM_SH_SIGNALS * sizeof(complexVector));
-    for(ch=0; ch< MAX_NUM_SH_SIGNALS; ch++) {
-        pData->STFTInputFrameTF[ch].re = (float*)calloc1d(HYBRID_BANDS, sizeof(float));
-        pData->STFTInputFrameTF[ch].im = (float*)calloc1d(HYBRID_BANDS, sizeof(float));
-    }
-    pData->tempHopFrameTD = (float**)malloc2d( MAX(MAX_NUM_SH_SIGNALS, MAX_NUM_LOUDSPEAKERS), HOP_SIZE, sizeof(float));
-    pData->STFTOutputFrameTF = malloc1d(MAX_NUM_LOUDSPEAKERS * sizeof(complexVector));
-    for(ch=0; ch< MAX_NUM_LOUDSPEAKERS; ch++) {
-        pData->STFTOutputFrameTF[ch].re = (float*)calloc1d(HYBRID_BANDS, sizeof(float));
-        pData->STFTOutputFrameTF[ch].im = (float*)calloc1d(HYBRID_BANDS, sizeof(float));
-    }
+    pData->SHFrameTD = (float**)malloc2d(MAX_NUM_SH_SIGNALS, pData->frameSize, sizeof(float));
+    pData->outputFrameTD = (float**)malloc2d(MAX(MAX_NUM_LOUDSPEAKERS, NUM_EARS), pData->frameSize, sizeof(float));
+    pData->SHframeTF = (float_complex***)malloc3d(pData->nBands, MAX_NUM_SH_SIGNALS, pData->timeSlots, sizeof(float_complex));
+    pData->outputframeTF = (float_complex***)malloc3d(pData->nBands, MAX_NUM_LOUDSPEAKERS, pData->timeSlots, sizeof(float_complex));
+    pData->binframeTF = (float_complex***)malloc3d(pData->nBands, NUM_EARS, pData->timeSlots, sizeof(float_complex));
+    pData->freqVector = calloc1d(pData->nBands, sizeof(float));
     
     /* codec data */
     pData->progressBar0_1 = 0.0f;
     pData->progressBarText = malloc1d(PROGRESSBARTEXT_CHAR_LENGTH*sizeof(char));
     strcpy(pData->progressBarText,"");
     pData->codecStatus = CODEC_STATUS_NOT_INITIALISED;
-    pData->pars = (ambi_dec_codecPars*)malloc1d(sizeof(ambi_dec_codecPars));
-    ambi_dec_codecPars* pars = pData->pars;
-    for (i=0; i<NUM_DECODERS; i++){
-        for(j=0; j<MAX_SH_ORDER; j++){
-            pars->M_dec[i][j] = NULL;
-            pars->M_dec_cmplx[i][j] = NULL;
-            pars->M_dec_maxrE[i][j] = NULL;
-            pars->M_dec_cmplx_maxrE[i][j] = NULL;
-        }
-    }
-    pars->sofa_filepath = NULL;
-    pars->hrirs = NULL;
-    pars->hrir_dirs_deg = NULL;
-    pars->hrtf_vbap_gtableIdx = NULL;
-    pars->hrtf_vbap_gtableComp = NULL;
-    pars->itds_s = NULL;
-    pars->hrtf_fb = NULL;
-    pars->hrtf_fb_mag = NULL;
+    pData->sofa_filepath = NULL;
+    pData->hrtf_interp = (float_complex***)malloc3d(MAX_NUM_LOUDSPEAKERS, pData->nBands, NUM_EARS, sizeof(float_complex));
+
+    /* codec states (afSTFT, decoders and HRTF data), which are built by _initCodec() */
+    saf_stateSwap_create(&(pData->hCodecState), ambi_dec_destroyCodecPars);
+    pData->pars = NULL;
+    pData->procPars = NULL;
     
     /* internal parameters */ 
     pData->binauraliseLS = pData->new_binauraliseLS = 0;
     
     /* flags */
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
     pData->reinit_hrtfsFLAG = 1;
     for(ch=0; ch<MAX_NUM_LOUDSPEAKERS; ch++)
         pData->recalc_hrtf_interpFLAG[ch] = 1;
+
+    /* block-size adaptor */
+    saf_blockAdaptor_create(&(pData->hBlockAdaptor), pData->frameSize, MAX_NUM_SH_SIGNALS, MAX_NUM_LOUDSPEAKERS);
 }
 
 void ambi_dec_destroy
@@ -113,51 +116,25 @@ void ambi_dec_destroy
 )
 {
     ambi_dec_data *pData = (ambi_dec_data*)(*phAmbi);
-    ambi_dec_codecPars *pars;
-    int i, j, ch;
     
     if (pData != NULL) {
-        /* not safe to free memory during intialisation/processing loop */
-        while (pData->codecStatus == CODEC_STATUS_INITIALISING ||
-               pData->procStatus == PROC_STATUS_ONGOING){
+        saf_blockAdaptor_destroy(&(pData->hBlockAdaptor));
+        /* not safe to free the codec states during intialisation (the
+         * processing loop must have already stopped) */
+        while (saf_atomic_loadInt(&(pData->codecStatus)) == CODEC_STATUS_INITIALISING)
             SAF_SLEEP(10);
-        }
+        saf_stateSwap_destroy(&(pData->hCodecState));
         
-        /* free afSTFT and buffers */
-        if(pData->hSTFT!=NULL)
-            afSTFTfree(pData->hSTFT);
-        if(pData->STFTInputFrameTF!=NULL){
-            for (ch = 0; ch< MAX_NUM_SH_SIGNALS; ch++) {
-                free(pData->STFTInputFrameTF[ch].re);
-                free(pData->STFTInputFrameTF[ch].im);
-            }
-        }
-        if((pData->STFTOutputFrameTF!=NULL)){
-            for (ch = 0; ch < MAX_NUM_LOUDSPEAKERS; ch++) {
-                free(pData->STFTOutputFrameTF[ch].re);
-                free(pData->STFTOutputFrameTF[ch].im);
-            }
-        }
-        free(pData->STFTInputFrameTF);
-        free(pData->STFTOutputFrameTF);
-        free(pData->tempHopFrameTD);
-
-        pars = pData->pars;
-        free(pars->hrtf_vbap_gtableComp);
-        free(pars->hrtf_vbap_gtableIdx);
-        free(pars->hrtf_fb);
-        free(pars->hrtf_fb_mag);
-        free(pars->itds_s);
-        free(pars->hrirs);
-        free(pars->hrir_dirs_deg);
-        for (i=0; i<NUM_DECODERS; i++){
-            for(j=0; j<MAX_SH_ORDER; j++){
-                free(pars->M_dec[i][j]);
-                free(pars->M_dec_cmplx[i][j]);
-                free(pars->M_dec_maxrE[i][j]);
-                free(pars->M_dec_cmplx_maxrE[i][j]);
-            }
-        }
+        /* free buffers */
+        free(pData->SHFrameTD);
+        free(pData->outputFrameTD);
+        free(pData->SHframeTF);
+        free(pData->outputframeTF);
+        free(pData->binframeTF);
+        free(pData->freqVector);
+        free(pData->orderPerBand);
+        free(pData->hrtf_interp);
+        free(pData->sofa_filepath);
         free(pData->progressBarText);
         free(pData);
         pData = NULL;
@@ -171,16 +148,11 @@ void ambi_dec_init
 )
 {
     ambi_dec_data *pData = (ambi_dec_data*)(hAmbi);
-    int band;
     
     /* define frequency vector */
     pData->fs = sampleRate;
-    for(band=0; band <HYBRID_BANDS; band++){
-        if(sampleRate == 44100)
-            pData->freqVector[band] =  (float)__afCenterFreq44100[band];
-        else /* Assume 48kHz */
-            pData->freqVector[band] =  (float)__afCenterFreq48e3[band];
-    }
+    afSTFTgetCenterFreqs(pData->hopSize, 1, (float)sampleRate, pData->freqVector);
+    saf_blockAdaptor_reset(pData->hBlockAdaptor);
 }
 
 void ambi_dec_initCodec
@@ -189,44 +161,29 @@ void ambi_dec_initCodec
 )
 {
     ambi_dec_data *pData = (ambi_dec_data*)(hAmbi);
-    ambi_dec_codecPars* pars = pData->pars;
+    ambi_dec_codecPars* pars;
     int i, ch, d, j, n, ng, nGrid_dirs, masterOrder, nSH_order, max_nSH, nLoudspeakers;
-    float* grid_dirs_deg, *Y, *M_dec_tmp, *g, *a, *e, *a_n, *hrtf_vbap_gtable;;
+    float* grid_dirs_deg, *Y, *M_dec_tmp, *g, *a, *e, *a_n;
     float a_avg[MAX_SH_ORDER], e_avg[MAX_SH_ORDER], azi_incl[2], sum_elev;
     
-    if (pData->codecStatus != CODEC_STATUS_NOT_INITIALISED)
+    /* The processing loop keeps running with the current codec state, while
+     * a new one is built here (so neither side ever waits for the other) */
+    if (!saf_atomic_compareExchangeInt(&(pData->codecStatus), CODEC_STATUS_NOT_INITIALISED, CODEC_STATUS_INITIALISING))
         return; /* re-init not required, or already happening */
-    while (pData->procStatus == PROC_STATUS_ONGOING){
-        /* re-init required, but we need to wait for the current processing loop to end */
-        pData->codecStatus = CODEC_STATUS_INITIALISING; /* indicate that we want to init */
-        SAF_SLEEP(10);
-    }
     
     /* for progress bar */
-    pData->codecStatus = CODEC_STATUS_INITIALISING;
     strcpy(pData->progressBarText,"Initialising");
     pData->progressBar0_1 = 0.0f;
     
-    /* reinit afSTFT */
-    masterOrder = pData->new_masterOrder;
+    /* new afSTFT (the one of the current state may still be in use by the
+     * processing loop) */
+    pars = (ambi_dec_codecPars*)calloc1d(1, sizeof(ambi_dec_codecPars));
+    masterOrder = pars->masterOrder = pData->new_masterOrder;
     max_nSH = (masterOrder+1)*(masterOrder+1);
-    nLoudspeakers = pData->new_nLoudpkrs;
-    if(pData->hSTFT==NULL){
-        if(pData->new_binauraliseLS)
-            afSTFTinit(&(pData->hSTFT), HOP_SIZE, max_nSH, NUM_EARS, 0, 1);
-        else
-            afSTFTinit(&(pData->hSTFT), HOP_SIZE, max_nSH, nLoudspeakers, 0, 1);
-        afSTFTclearBuffers(pData->hSTFT);
-    }
-    else{
-        if(pData->new_binauraliseLS)
-            afSTFTchannelChange(pData->hSTFT, max_nSH, NUM_EARS);
-        else
-            afSTFTchannelChange(pData->hSTFT, max_nSH, nLoudspeakers);
-        afSTFTclearBuffers(pData->hSTFT);
-    }
-    pData->binauraliseLS = pData->new_binauraliseLS;
-    pData->nLoudpkrs = nLoudspeakers;
+    nLoudspeakers = pars->nLoudpkrs = pData->new_nLoudpkrs;
+    pars->binauraliseLS = pData->new_binauraliseLS;
+    pars->LDmode = pData->new_LDmode;
+    afSTFTinit(&(pars->hSTFT), pData->hopSize, max_nSH, pars->binauraliseLS ? NUM_EARS : nLoudspeakers, pars->LDmode, 1);
     
     /* Quick and dirty check to find loudspeaker dimensionality */
     strcpy(pData->progressBarText,"Computing decoder");
@@ -277,9 +234,7 @@ void ambi_dec_initCodec
         for( n=1; n<=masterOrder; n++){
             /* truncate M_dec for each order */
             nSH_order = (n+1)*(n+1);
-            free(pars->M_dec[d][n-1]);
             pars->M_dec[d][n-1] = malloc1d(nLoudspeakers* nSH_order * sizeof(float));
-            free(pars->M_dec_cmplx[d][n-1]);
             pars->M_dec_cmplx[d][n-1] = malloc1d(nLoudspeakers * nSH_order * sizeof(float_complex));
             for(i=0; i<nLoudspeakers; i++){
                 for(j=0; j<nSH_order; j++){
@@ -288,17 +243,14 @@ void ambi_dec_initCodec
                 }
             }
             
-            /* create dedicated maxrE weighted versions */
-            a_n = malloc1d(nSH_order*nSH_order*sizeof(float));
-            getMaxREweights(n, 1, a_n); /* weights returned as diagonal matrix */
-            free(pars->M_dec_maxrE[d][n-1]);
+            /* create dedicated maxrE weighted versions (the weights are
+             * order-wise, so they simply scale the columns of the decoder) */
+            a_n = malloc1d(nSH_order*sizeof(float));
+            getMaxREweights(n, 0, a_n); /* weights returned as a vector */
             pars->M_dec_maxrE[d][n-1] = malloc1d(nLoudspeakers * nSH_order * sizeof(float));
-            free(pars->M_dec_cmplx_maxrE[d][n-1]);
             pars->M_dec_cmplx_maxrE[d][n-1] = malloc1d(nLoudspeakers * nSH_order * sizeof(float_complex));
-            cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nLoudspeakers, nSH_order, nSH_order, 1.0f,
-                        pars->M_dec[d][n-1], nSH_order,
-                        a_n, nSH_order, 0.0f,
-                        pars->M_dec_maxrE[d][n-1], nSH_order); /* for applying in the time domain */
+            for(i=0; i<nLoudspeakers; i++) /* for applying in the time domain */
+                utility_svvmul(&(pars->M_dec[d][n-1][i*nSH_order]), a_n, nSH_order, &(pars->M_dec_maxrE[d][n-1][i*nSH_order]));
             for(i=0; i<nLoudspeakers * nSH_order; i++)
                 pars->M_dec_cmplx_maxrE[d][n-1][i] = cmplxf(pars->M_dec_maxrE[d][n-1][i], 0.0f); /* for the time-frequency domain */
             
@@ -335,138 +287,110 @@ void ambi_dec_initCodec
             
             /* remove virtual loudspeakers from the decoder */
             if (pData->loudpkrs_nDims == 2){
-                pars->M_dec[d][n-1] = realloc1d(pars->M_dec[d][n-1], pData->nLoudpkrs * nSH_order * sizeof(float));
-                pars->M_dec_cmplx[d][n-1] = realloc1d(pars->M_dec_cmplx[d][n-1], pData->nLoudpkrs * nSH_order * sizeof(float_complex));
-                pars->M_dec_maxrE[d][n-1] = realloc1d(pars->M_dec_maxrE[d][n-1], pData->nLoudpkrs * nSH_order * sizeof(float));
-                pars->M_dec_cmplx_maxrE[d][n-1] = realloc1d(pars->M_dec_cmplx_maxrE[d][n-1], pData->nLoudpkrs * nSH_order * sizeof(float_complex));
+                pars->M_dec[d][n-1] = realloc1d(pars->M_dec[d][n-1], pars->nLoudpkrs * nSH_order * sizeof(float));
+                pars->M_dec_cmplx[d][n-1] = realloc1d(pars->M_dec_cmplx[d][n-1], pars->nLoudpkrs * nSH_order * sizeof(float_complex));
+                pars->M_dec_maxrE[d][n-1] = realloc1d(pars->M_dec_maxrE[d][n-1], pars->nLoudpkrs * nSH_order * sizeof(float));
+                pars->M_dec_cmplx_maxrE[d][n-1] = realloc1d(pars->M_dec_cmplx_maxrE[d][n-1], pars->nLoudpkrs * nSH_order * sizeof(float_complex));
             }
         }
         free(M_dec_tmp);
     }
     
-    /* update order */
-    pData->masterOrder = pData->new_masterOrder;
-    
-    /* Binaural-related initialisations */
-    if(pData->reinit_hrtfsFLAG){
-        strcpy(pData->progressBarText,"Computing VBAP gain table");
-        pData->progressBar0_1 = 0.4f;
-        
-        /* load sofa file or load default hrir data */
-        if(!pData->useDefaultHRIRsFLAG && pars->sofa_filepath!=NULL){
-            loadSofaFile(pars->sofa_filepath,
-                         &(pars->hrirs),
-                         &(pars->hrir_dirs_deg),
-                         &(pars->N_hrir_dirs),
-                         &(pars->hrir_len),
-                         &(pars->hrir_fs));
-        }
-        else{
-            loadSofaFile(NULL, /* setting path to NULL loads default HRIR data */
-                         &(pars->hrirs),
-                         &(pars->hrir_dirs_deg),
-                         &(pars->N_hrir_dirs),
-                         &(pars->hrir_len),
-                         &(pars->hrir_fs));
-        }
-        
-        /* estimate the ITDs for each HRIR */
-        pars->itds_s = realloc1d(pars->itds_s, pars->N_hrir_dirs*sizeof(float));
-        estimateITDs(pars->hrirs, pars->N_hrir_dirs, pars->hrir_len, pars->hrir_fs, pars->itds_s);
-        
-        /* generate VBAP gain table for the hrir_dirs */
-        hrtf_vbap_gtable = NULL;
-        pars->hrtf_vbapTableRes[0] = 2; /* azimuth resolution in degrees */
-        pars->hrtf_vbapTableRes[1] = 5; /* elevation resolution in degrees */
-        generateVBAPgainTable3D(pars->hrir_dirs_deg, pars->N_hrir_dirs, pars->hrtf_vbapTableRes[0], pars->hrtf_vbapTableRes[1], 1, 0, 0.0f,
-                                &hrtf_vbap_gtable, &(pars->N_hrtf_vbap_gtable), &(pars->hrtf_nTriangles));
-        if(hrtf_vbap_gtable==NULL){
-            /* if generating vbap gain tabled failed, re-calculate with default HRIR set (which is known to triangulate correctly) */
-            pData->useDefaultHRIRsFLAG = 1;
-            ambi_dec_initCodec(hAmbi);
-        }
-        
-        /* compress VBAP table (i.e. remove the zero elements) */
-        pars->hrtf_vbap_gtableComp = realloc1d(pars->hrtf_vbap_gtableComp, pars->N_hrtf_vbap_gtable * 3 * sizeof(float));
-        pars->hrtf_vbap_gtableIdx  = realloc1d(pars->hrtf_vbap_gtableIdx,  pars->N_hrtf_vbap_gtable * 3 * sizeof(int));
-        compressVBAPgainTable3D(hrtf_vbap_gtable, pars->N_hrtf_vbap_gtable, pars->N_hrir_dirs, pars->hrtf_vbap_gtableComp, pars->hrtf_vbap_gtableIdx);
-        
-        /* convert hrirs to filterbank coefficients */
-        strcpy(pData->progressBarText,"Preparing HRIRs");
-        pData->progressBar0_1 = 0.85f;
-        pars->hrtf_fb = realloc1d(pars->hrtf_fb, HYBRID_BANDS * NUM_EARS * (pars->N_hrir_dirs)*sizeof(float_complex));
-        HRIRs2FilterbankHRTFs(pars->hrirs, pars->N_hrir_dirs, pars->hrir_len, HOP_SIZE, 1, pars->hrtf_fb);
-        diffuseFieldEqualiseHRTFs(pars->N_hrir_dirs, pars->itds_s, pData->freqVector, HYBRID_BANDS, pars->hrtf_fb);
-        
-        /* calculate magnitude responses */
-        pars->hrtf_fb_mag = realloc1d(pars->hrtf_fb_mag, HYBRID_BANDS*NUM_EARS*(pars->N_hrir_dirs)*sizeof(float));
-        for(i=0; i<HYBRID_BANDS*NUM_EARS* (pars->N_hrir_dirs); i++)
-            pars->hrtf_fb_mag[i] = cabsf(pars->hrtf_fb[i]);
-        
-        /* clean-up */
-        free(hrtf_vbap_gtable);
+    /* Binaural-related initialisations: reinit HRTFs, or take them from the
+     * previous state */
+    if(pData->reinit_hrtfsFLAG || pData->pars==NULL){
         pData->reinit_hrtfsFLAG = 0;
+        ambi_dec_initHRTFs(hAmbi, pars);
     }
+    else
+        ambi_dec_copyHRTFs(hAmbi, pData->pars, pars);
+    
+    /* hand the new state over to the processing loop */
+    saf_stateSwap_publish(pData->hCodecState, (void*)pars);
+    pData->pars = pars;
+    pData->masterOrder = pars->masterOrder;
+    pData->nLoudpkrs = pars->nLoudpkrs;
+    pData->binauraliseLS = pars->binauraliseLS;
+    pData->LDmode = pars->LDmode;
     
-    /* done! */
+    /* done! (unless a setting changed in the meantime, in which case the
+     * status remains CODEC_STATUS_NOT_INITIALISED) */
     strcpy(pData->progressBarText,"Done!");
     pData->progressBar0_1 = 1.0f;
-    pData->codecStatus = CODEC_STATUS_INITIALISED;
+    saf_atomic_compareExchangeInt(&(pData->codecStatus), CODEC_STATUS_INITIALISING, CODEC_STATUS_INITIALISED);
     
     free(g);
     free(a);
     free(e);
 }
 
-void ambi_dec_process
+/** Processes one frame of frameSize samples (see saf_blockAdaptor_apply()) */
+static void ambi_dec_processFrame
 (
     void  *  const hAmbi,
     float ** const inputs,
     float ** const outputs,
     int            nInputs,
-    int            nOutputs,
-    int            nSamples
+    int            nOutputs
 )
 {
     ambi_dec_data *pData = (ambi_dec_data*)(hAmbi);
-    ambi_dec_codecPars* pars = pData->pars;
-    int t, ch, ear, i, band, orderBand, nSH_band, decIdx, nSH;
+    ambi_dec_codecPars* pars;
+    int t, ch, ear, i, band, orderBand, nSH_band, decIdx, nSH, nOut, frameSize, nBands, timeSlots, convertInputs;
     const float_complex calpha = cmplxf(1.0f, 0.0f), cbeta = cmplxf(0.0f, 0.0f);
+    float* inPtrs[MAX_NUM_SH_SIGNALS], *outPtrs[MAX(MAX_NUM_LOUDSPEAKERS, NUM_EARS)];
 
     /* local copies of user parameters */
     int nLoudspeakers, binauraliseLS, masterOrder;
-    int orderPerBand[HYBRID_BANDS], rE_WEIGHT[NUM_DECODERS];
+    int rE_WEIGHT[NUM_DECODERS];
     float transitionFreq;
     AMBI_DEC_DIFFUSE_FIELD_EQ_APPROACH diffEQmode[NUM_DECODERS];
     NORM_TYPES norm;
     CH_ORDER chOrdering;
-    masterOrder = pData->masterOrder;
+
+    /* pick up the latest codec state (never blocks); the interpolated HRTFs
+     * must be recomputed whenever it changes */
+    pars = (ambi_dec_codecPars*)saf_stateSwap_acquire(pData->hCodecState);
+    if(pars != pData->procPars){
+        pData->procPars = pars;
+        for(ch=0; ch<MAX_NUM_LOUDSPEAKERS; ch++)
+            pData->recalc_hrtf_interpFLAG[ch] = 1;
+    }
+
+    masterOrder = pars!=NULL ? pars->masterOrder : 1;
     nSH = ORDER2NSH(masterOrder);
-    nLoudspeakers = pData->nLoudpkrs;
-    memcpy(orderPerBand, pData->orderPerBand, HYBRID_BANDS*sizeof(int));
+    nLoudspeakers = pars!=NULL ? pars->nLoudpkrs : 0;
     transitionFreq = pData->transitionFreq;
     memcpy(diffEQmode, pData->diffEQmode, NUM_DECODERS*sizeof(int));
-    binauraliseLS = pData->binauraliseLS;
+    binauraliseLS = pars!=NULL ? pars->binauraliseLS : 0;
     norm = pData->norm;
     chOrdering = pData->chOrdering;
     memcpy(rE_WEIGHT, pData->rE_WEIGHT, NUM_DECODERS*sizeof(int));
+    frameSize = pData->frameSize;
+    nBands = pData->nBands;
+    timeSlots = pData->timeSlots;
     
     /* Process frame */
-    if (nSamples == FRAME_SIZE && (pData->codecStatus == CODEC_STATUS_INITIALISED) ) {
-        pData->procStatus = PROC_STATUS_ONGOING;
-
-        /* Load time-domain data */
-        for(i=0; i < MIN(nSH, nInputs); i++)
-            utility_svvcopy(inputs[i], FRAME_SIZE, pData->SHFrameTD[i]);
-        for(; i<nSH; i++)
-            memset(pData->SHFrameTD[i], 0, FRAME_SIZE * sizeof(float)); /* fill remaining channels with zeros */
+    if (pars!=NULL) {
+        /* Load time-domain data; the host frames are transformed directly,
+         * unless they must first be converted to ACN/N3D */
+        convertInputs = chOrdering!=CH_ACN || norm!=NORM_N3D;
+        for(i=0; i < MIN(nSH, nInputs); i++){
+            if(convertInputs)
+                utility_svvcopy(inputs[i], frameSize, pData->SHFrameTD[i]);
+            inPtrs[i] = convertInputs ? pData->SHFrameTD[i] : inputs[i];
+        }
+        for(; i<nSH; i++){
+            memset(pData->SHFrameTD[i], 0, frameSize * sizeof(float)); /* fill remaining channels with zeros */
+            inPtrs[i] = pData->SHFrameTD[i];
+        }
 
         /* account for channel order convention */
         switch(chOrdering){
             case CH_ACN: /* already ACN */
                 break;
             case CH_FUMA:
-                convertHOAChannelConvention((float*)pData->SHFrameTD, masterOrder, FRAME_SIZE, HOA_CH_ORDER_FUMA, HOA_CH_ORDER_ACN);
+                convertHOAChannelConvention(FLATTEN2D(pData->SHFrameTD), masterOrder, frameSize, HOA_CH_ORDER_FUMA, HOA_CH_ORDER_ACN);
                 break;
         }
 
@@ -475,44 +399,38 @@ void ambi_dec_process
             case NORM_N3D:  /* already in N3D, do nothing */
                 break;
             case NORM_SN3D: /* convert to N3D */
-                convertHOANormConvention((float*)pData->SHFrameTD, masterOrder, FRAME_SIZE, HOA_NORM_SN3D, HOA_NORM_N3D);
+                convertHOANormConvention(FLATTEN2D(pData->SHFrameTD), masterOrder, frameSize, HOA_NORM_SN3D, HOA_NORM_N3D);
                 break;
             case NORM_FUMA: /* only for first-order, convert to N3D */
-                convertHOANormConvention((float*)pData->SHFrameTD, masterOrder, FRAME_SIZE, HOA_NORM_FUMA, HOA_NORM_N3D);
+                convertHOANormConvention(FLATTEN2D(pData->SHFrameTD), masterOrder, frameSize, HOA_NORM_FUMA, HOA_NORM_N3D);
                 break;
         }
 
         /* Apply time-frequency transform (TFT) */
-        for(t=0; t< TIME_SLOTS; t++) {
-            for(ch = 0; ch < nSH; ch++)
-                utility_svvcopy(&(pData->SHFrameTD[ch][t*HOP_SIZE]), HOP_SIZE, pData->tempHopFrameTD[ch]);
-            afSTFTforward(pData->hSTFT, (float**)pData->tempHopFrameTD, (complexVector*)pData->STFTInputFrameTF);
-            for(band=0; band<HYBRID_BANDS; band++)
-                for(ch=0; ch < nSH; ch++)
-                    pData->SHframeTF[band][ch][t] = cmplxf(pData->STFTInputFrameTF[ch].re[band], pData->STFTInputFrameTF[ch].im[band]);
-        }
+        afSTFTforwardFrame(pars->hSTFT, inPtrs, frameSize, MAX_NUM_SH_SIGNALS,
+                           AFSTFT_BANDS_CH_TIME, FLATTEN3D(pData->SHframeTF));
 
         /* Main processing: */
         /* Decode to loudspeaker set-up */
-        memset(pData->outputframeTF, 0, HYBRID_BANDS*MAX_NUM_LOUDSPEAKERS*TIME_SLOTS*sizeof(float_complex));
-        for(band=0; band<HYBRID_BANDS; band++){
-            orderBand = MAX(MIN(orderPerBand[band], masterOrder),1);
+        memset(FLATTEN3D(pData->outputframeTF), 0, nBands*MAX_NUM_LOUDSPEAKERS*timeSlots*sizeof(float_complex));
+        for(band=0; band<nBands; band++){
+            orderBand = MAX(MIN(pData->orderPerBand[band], masterOrder),1);
             nSH_band = (orderBand+1)*(orderBand+1);
             decIdx = pData->freqVector[band] < transitionFreq ? 0 : 1; /* different decoder for low (0) and high (1) frequencies */
             if(rE_WEIGHT[decIdx]){
-                cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nLoudspeakers, TIME_SLOTS, nSH_band, &calpha,
+                cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nLoudspeakers, timeSlots, nSH_band, &calpha,
                             pars->M_dec_cmplx_maxrE[decIdx][orderBand-1], nSH_band,
-                            pData->SHframeTF[band], TIME_SLOTS, &cbeta,
-                            pData->outputframeTF[band], TIME_SLOTS);
+                            FLATTEN2D(pData->SHframeTF[band]), timeSlots, &cbeta,
+                            FLATTEN2D(pData->outputframeTF[band]), timeSlots);
             }
             else{
-                cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nLoudspeakers, TIME_SLOTS, nSH_band, &calpha,
+                cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nLoudspeakers, timeSlots, nSH_band, &calpha,
                             pars->M_dec_cmplx[decIdx][orderBand-1], nSH_band,
-                            pData->SHframeTF[band], TIME_SLOTS, &cbeta,
-                            pData->outputframeTF[band], TIME_SLOTS);
+                            FLATTEN2D(pData->SHframeTF[band]), timeSlots, &cbeta,
+                            FLATTEN2D(pData->outputframeTF[band]), timeSlots);
             }
             for(i=0; i<nLoudspeakers; i++){
-                for(t=0; t<TIME_SLOTS; t++){
+                for(t=0; t<timeSlots; t++){
                     if(diffEQmode[decIdx]==AMPLITUDE_PRESERVING)
                         pData->outputframeTF[band][i][t] = crmulf(pData->outputframeTF[band][i][t], pars->M_norm[decIdx][orderBand-1][0]);
                     else
@@ -523,54 +441,74 @@ void ambi_dec_process
 
         /* binauralise the loudspeaker signals */
         if(binauraliseLS){
-            memset(pData->binframeTF, 0, HYBRID_BANDS*NUM_EARS*TIME_SLOTS * sizeof(float_complex));
+            memset(FLATTEN3D(pData->binframeTF), 0, nBands*NUM_EARS*timeSlots * sizeof(float_complex));
             /* interpolate hrtfs and apply to each source */
             for (ch = 0; ch < nLoudspeakers; ch++) {
                 if(pData->recalc_hrtf_interpFLAG[ch]){
-                    ambi_dec_interpHRTFs(hAmbi, pData->loudpkrs_dirs_deg[ch][0], pData->loudpkrs_dirs_deg[ch][1], pars->hrtf_interp[ch]);
+                    ambi_dec_interpHRTFs(hAmbi, pars, pData->loudpkrs_dirs_deg[ch][0], pData->loudpkrs_dirs_deg[ch][1], pData->hrtf_interp[ch]);
                     pData->recalc_hrtf_interpFLAG[ch] = 0;
                 }
-                for (band = 0; band < HYBRID_BANDS; band++)
+                for (band = 0; band < nBands; band++)
                     for (ear = 0; ear < NUM_EARS; ear++)
-                        for (t = 0; t < TIME_SLOTS; t++)
-                            pData->binframeTF[band][ear][t] = ccaddf(pData->binframeTF[band][ear][t], ccmulf(pData->outputframeTF[band][ch][t], pars->hrtf_interp[ch][band][ear]));
+                        cblas_caxpy(timeSlots, &(pData->hrtf_interp[ch][band][ear]), pData->outputframeTF[band][ch], 1, pData->binframeTF[band][ear], 1);
             }
 
             /* scale by sqrt(number of loudspeakers) */
-            for (band = 0; band < HYBRID_BANDS; band++)
+            for (band = 0; band < nBands; band++)
                 for (ear = 0; ear < NUM_EARS; ear++)
-                    for (t = 0; t < TIME_SLOTS; t++)
+                    for (t = 0; t < timeSlots; t++)
                         pData->binframeTF[band][ear][t] = crmulf(pData->binframeTF[band][ear][t], 1.0f/sqrtf((float)nLoudspeakers));
         }
 
-        /* inverse-TFT */
-        for(t = 0; t < TIME_SLOTS; t++) {
-            for(band = 0; band < HYBRID_BANDS; band++) {
-                if(binauraliseLS){
-                    for (ch = 0; ch < NUM_EARS; ch++) {
-                        pData->STFTOutputFrameTF[ch].re[band] = crealf(pData->binframeTF[band][ch][t]);
-                        pData->STFTOutputFrameTF[ch].im[band] = cimagf(pData->binframeTF[band][ch][t]);
-                    }
-                }
-                else {
-                    for(ch = 0; ch < nLoudspeakers; ch++) {
-                        pData->STFTOutputFrameTF[ch].re[band] = crealf(pData->outputframeTF[band][ch][t]);
-                        pData->STFTOutputFrameTF[ch].im[band] = cimagf(pData->outputframeTF[band][ch][t]);
-                    }
-                }
-            }
-            afSTFTinverse(pData->hSTFT, pData->STFTOutputFrameTF, pData->tempHopFrameTD);
-            for(ch = 0; ch < MIN(binauraliseLS==1 ? NUM_EARS : nLoudspeakers, nOutputs); ch++)
-                utility_svvcopy(pData->tempHopFrameTD[ch], HOP_SIZE, &(outputs[ch][t* HOP_SIZE]));
-            for (; ch < nOutputs; ch++)
-                memset(&(outputs[ch][t* HOP_SIZE]), 0, HOP_SIZE*sizeof(float));
-        }
+        /* inverse-TFT (directly into the host frames, as the inputs have
+         * already been read) */
+        nOut = binauraliseLS==1 ? NUM_EARS : nLoudspeakers;
+        for(ch = 0; ch < nOut; ch++)
+            outPtrs[ch] = ch < nOutputs ? outputs[ch] : pData->outputFrameTD[ch];
+        if(binauraliseLS)
+            afSTFTinverseFrame(pars->hSTFT, FLATTEN3D(pData->binframeTF), frameSize, NUM_EARS,
+                               AFSTFT_BANDS_CH_TIME, outPtrs);
+        else
+            afSTFTinverseFrame(pars->hSTFT, FLATTEN3D(pData->outputframeTF), frameSize, MAX_NUM_LOUDSPEAKERS,
+                               AFSTFT_BANDS_CH_TIME, outPtrs);
+        for (ch = nOut; ch < nOutputs; ch++)
+            memset(outputs[ch], 0, frameSize*sizeof(float));
     }
     else
         for (ch=0; ch < nOutputs; ch++)
-            memset(outputs[ch], 0, FRAME_SIZE*sizeof(float));
+            memset(outputs[ch], 0, frameSize*sizeof(float));
+}
+
+void ambi_dec_process
+(
+    void  *  const hAmbi,
+    float ** const inputs,
+    float ** const outputs,
+    int            nInputs,
+    int            nOutputs,
+    int            nSamples
+)
+{
+    ambi_dec_data *pData = (ambi_dec_data*)(hAmbi);
+
+    saf_blockAdaptor_apply(pData->hBlockAdaptor, inputs, outputs, nInputs, nOutputs,
+                           nSamples, ambi_dec_processFrame, hAmbi);
+}
+
+void ambi_dec_processInterleaved
+(
+    void  *  const hAmbi,
+    const float *  inputs,
+    float *        outputs,
+    int            nInputs,
+    int            nOutputs,
+    int            nSamples
+)
+{
+    ambi_dec_data *pData = (ambi_dec_data*)(hAmbi);
 
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
+    saf_blockAdaptor_applyStrided(pData->hBlockAdaptor, inputs, 1, nInputs, outputs, 1, nOutputs,
+                                  nInputs, nOutputs, nSamples, ambi_dec_processFrame, hAmbi);
 }
 
 
@@ -609,7 +547,7 @@ void ambi_dec_setDecOrderAllBands(void  * const hAmbi, int newValue)
     ambi_dec_data *pData = (ambi_dec_data*)(hAmbi);
     int band;
     
-    for(band=0; band<HYBRID_BANDS; band++)
+    for(band=0; band<pData->nBands; band++)
         pData->orderPerBand[band] = MIN(MAX(newValue,1), pData->new_masterOrder);
 }
 
@@ -675,10 +613,9 @@ void ambi_dec_setUseDefaultHRIRsflag(void* const hAmbi, int newState)
 void ambi_dec_setSofaFilePath(void* const hAmbi, const char* path)
 {
     ambi_dec_data *pData = (ambi_dec_data*)(hAmbi);
-    ambi_dec_codecPars* pars = pData->pars;
     
-    pars->sofa_filepath = malloc1d(strlen(path) + 1);
-    strcpy(pars->sofa_filepath, path);
+    pData->sofa_filepath = realloc1d(pData->sofa_filepath, strlen(path) + 1);
+    strcpy(pData->sofa_filepath, path);
     pData->useDefaultHRIRsFLAG = 0;
     pData->reinit_hrtfsFLAG = 1;
     ambi_dec_setCodecStatus(hAmbi, CODEC_STATUS_NOT_INITIALISED);
@@ -706,13 +643,13 @@ void ambi_dec_setSourcePreset(void* const hAmbi, int newPresetID)
     switch(newPresetID){
         /* Ideal spherical harmonics will have SH_ORDER at all frequencies */
         case MIC_PRESET_IDEAL:
-            for(band=0; band<HYBRID_BANDS; band++)
+            for(band=0; band<pData->nBands; band++)
                 pData->orderPerBand[band] = pData->masterOrder;
             break;
             
         /* For real microphone arrays, the maximum usable spherical harmonic order will depend on frequency  */
         case MIC_PRESET_ZYLIA:
-            for(band=0; band<HYBRID_BANDS; band++){
+            for(band=0; band<pData->nBands; band++){
                 if(rangeIdx<2*(__Zylia_maxOrder-1)){
                     if(pData->freqVector[band]>__Zylia_freqRange[rangeIdx]){
                         if(!reverse)
@@ -728,7 +665,7 @@ void ambi_dec_setSourcePreset(void* const hAmbi, int newPresetID)
             break;
 
         case MIC_PRESET_EIGENMIKE32:
-            for(band=0; band<HYBRID_BANDS; band++){
+            for(band=0; band<pData->nBands; band++){
                 if(rangeIdx<2*(__Eigenmike32_maxOrder-1)){
                     if(pData->freqVector[band]>__Eigenmike32_freqRange[rangeIdx]){
                         if(!reverse)
@@ -744,7 +681,7 @@ void ambi_dec_setSourcePreset(void* const hAmbi, int newPresetID)
             break;
 
         case MIC_PRESET_DTU_MIC:
-            for(band=0; band<HYBRID_BANDS; band++){
+            for(band=0; band<pData->nBands; band++){
                 if(rangeIdx<2*(__DTU_mic_maxOrder-1)){
                     if(pData->freqVector[band]>__DTU_mic_freqRange[rangeIdx]){
                         if(!reverse)
@@ -800,18 +737,33 @@ void ambi_dec_setTransitionFreq(void* const hAmbi, float newValue)
     pData->transitionFreq = CLAMP(newValue, AMBI_DEC_TRANSITION_MIN_VALUE, AMBI_DEC_TRANSITION_MAX_VALUE);
 }
 
+void ambi_dec_setLowDelayMode(void* const hAmbi, int newState)
+{
+    ambi_dec_data *pData = (ambi_dec_data*)(hAmbi);
+    if(pData->new_LDmode != (newState ? 1 : 0)){
+        pData->new_LDmode = newState ? 1 : 0;
+        ambi_dec_setCodecStatus(hAmbi, CODEC_STATUS_NOT_INITIALISED);
+    }
+}
+
 
 /* Get Functions */
 
 int ambi_dec_getFrameSize(void)
 {
-    return FRAME_SIZE;
+    return DEFAULT_TF_FRAME_SIZE;
+}
+
+int ambi_dec_getFrameSizeEx(void* const hAmbi)
+{
+    ambi_dec_data *pData = (ambi_dec_data*)(hAmbi);
+    return pData->frameSize;
 }
 
 CODEC_STATUS ambi_dec_getCodecStatus(void* const hAmbi)
 {
     ambi_dec_data *pData = (ambi_dec_data*)(hAmbi);
-    return pData->codecStatus;
+    return (CODEC_STATUS)saf_atomic_loadInt(&(pData->codecStatus));
 }
 
 float ambi_dec_getProgressBar0_1(void* const hAmbi)
@@ -855,12 +807,18 @@ void ambi_dec_getDecOrderHandle
     ambi_dec_data *pData = (ambi_dec_data*)(hAmbi);
     (*pX_vector) = &pData->freqVector[0];
     (*pY_values) = &pData->orderPerBand[0];
-    (*pNpoints) = HYBRID_BANDS;
+    (*pNpoints) = pData->nBands;
 }
 
 int ambi_dec_getNumberOfBands(void)
 {
-    return HYBRID_BANDS;
+    return DEFAULT_TF_FRAME_SIZE + 5;
+}
+
+int ambi_dec_getNumberOfBandsEx(void* const hAmbi)
+{
+    ambi_dec_data *pData = (ambi_dec_data*)(hAmbi);
+    return pData->nBands;
 }
 
 float ambi_dec_getLoudspeakerAzi_deg(void* const hAmbi, int index)
@@ -907,9 +865,8 @@ int ambi_dec_getUseDefaultHRIRsflag(void* const hAmbi)
 char* ambi_dec_getSofaFilePath(void* const hAmbi)
 {
     ambi_dec_data *pData = (ambi_dec_data*)(hAmbi);
-    ambi_dec_codecPars* pars = pData->pars;
-    if(pars->sofa_filepath!=NULL)
-        return pars->sofa_filepath;
+    if(pData->sofa_filepath!=NULL)
+        return pData->sofa_filepath;
     else
         return "no_file";
 }
@@ -953,8 +910,7 @@ float ambi_dec_getTransitionFreq(void* const hAmbi)
 int ambi_dec_getHRIRsamplerate(void* const hAmbi)
 {
     ambi_dec_data *pData = (ambi_dec_data*)(hAmbi);
-    ambi_dec_codecPars* pars = pData->pars;
-    return pars->hrir_fs;
+    return pData->pars!=NULL ? pData->pars->hrir_fs : 0;
 }
 
 int ambi_dec_getDAWsamplerate(void* const hAmbi)
@@ -963,9 +919,21 @@ int ambi_dec_getDAWsamplerate(void* const hAmbi)
     return pData->fs;
 }
 
-int ambi_dec_getProcessingDelay()
+int ambi_dec_getLowDelayMode(void* const hAmbi)
 {
-    return 12*HOP_SIZE;
+    ambi_dec_data *pData = (ambi_dec_data*)(hAmbi);
+    return pData->new_LDmode;
+}
+
+int ambi_dec_getProcessingDelay(void)
+{
+    return afSTFTgetProcessingDelay(DEFAULT_TF_FRAME_SIZE, 0, 1);
+}
+
+int ambi_dec_getProcessingDelayEx(void* const hAmbi)
+{
+    ambi_dec_data *pData = (ambi_dec_data*)(hAmbi);
+    return afSTFTgetProcessingDelay(pData->hopSize, pData->LDmode, 1) + saf_blockAdaptor_getDelay(pData->hBlockAdaptor);
 }
 
 
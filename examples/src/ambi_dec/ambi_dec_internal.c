@@ -36,29 +36,150 @@
 void ambi_dec_setCodecStatus(void* const hAmbi, CODEC_STATUS newStatus)
 {
     ambi_dec_data *pData = (ambi_dec_data*)(hAmbi);
-    if(newStatus==CODEC_STATUS_NOT_INITIALISED){
-        /* Pause until current initialisation is complete */
-        while(pData->codecStatus == CODEC_STATUS_INITIALISING)
-            SAF_SLEEP(10);
+    saf_atomic_storeInt(&(pData->codecStatus), (int)newStatus);
+}
+
+void ambi_dec_destroyCodecPars(void** const phPars)
+{
+    ambi_dec_codecPars *pars = (ambi_dec_codecPars*)(*phPars);
+    int i, j;
+
+    if(pars!=NULL){
+        if(pars->hSTFT!=NULL)
+            afSTFTfree(pars->hSTFT);
+        for (i=0; i<NUM_DECODERS; i++){
+            for(j=0; j<MAX_SH_ORDER; j++){
+                free(pars->M_dec[i][j]);
+                free(pars->M_dec_cmplx[i][j]);
+                free(pars->M_dec_maxrE[i][j]);
+                free(pars->M_dec_cmplx_maxrE[i][j]);
+            }
+        }
+        free(pars->hrirs);
+        free(pars->hrir_dirs_deg);
+        free(pars->hrtf_vbap_gtableIdx);
+        free(pars->hrtf_vbap_gtableComp);
+        free(pars->itds_s);
+        free(pars->hrtf_fb);
+        free(pars->hrtf_fb_mag);
+        free(pars);
+        *phPars = NULL;
     }
-    pData->codecStatus = newStatus;
+}
+
+void ambi_dec_initHRTFs(void* const hAmbi, ambi_dec_codecPars* pars)
+{
+    ambi_dec_data *pData = (ambi_dec_data*)(hAmbi);
+    int i;
+    float* hrtf_vbap_gtable;
+
+    strcpy(pData->progressBarText,"Computing VBAP gain table");
+    pData->progressBar0_1 = 0.4f;
+
+    /* load sofa file or load default hrir data */
+    if(!pData->useDefaultHRIRsFLAG && pData->sofa_filepath!=NULL){
+        loadSofaFile(pData->sofa_filepath,
+                     &(pars->hrirs),
+                     &(pars->hrir_dirs_deg),
+                     &(pars->N_hrir_dirs),
+                     &(pars->hrir_len),
+                     &(pars->hrir_fs));
+    }
+    else{
+        loadSofaFile(NULL, /* setting path to NULL loads default HRIR data */
+                     &(pars->hrirs),
+                     &(pars->hrir_dirs_deg),
+                     &(pars->N_hrir_dirs),
+                     &(pars->hrir_len),
+                     &(pars->hrir_fs));
+    }
+
+    /* estimate the ITDs for each HRIR */
+    pars->itds_s = realloc1d(pars->itds_s, pars->N_hrir_dirs*sizeof(float));
+    estimateITDs(pars->hrirs, pars->N_hrir_dirs, pars->hrir_len, pars->hrir_fs, pars->itds_s);
+
+    /* generate VBAP gain table for the hrir_dirs */
+    hrtf_vbap_gtable = NULL;
+    pars->hrtf_vbapTableRes[0] = 2; /* azimuth resolution in degrees */
+    pars->hrtf_vbapTableRes[1] = 5; /* elevation resolution in degrees */
+    generateVBAPgainTable3D(pars->hrir_dirs_deg, pars->N_hrir_dirs, pars->hrtf_vbapTableRes[0], pars->hrtf_vbapTableRes[1], 1, 0, 0.0f,
+                            &hrtf_vbap_gtable, &(pars->N_hrtf_vbap_gtable), &(pars->hrtf_nTriangles));
+    if(hrtf_vbap_gtable==NULL){
+        /* if generating vbap gain tabled failed, re-calculate with default HRIR set (which is known to triangulate correctly) */
+        pData->useDefaultHRIRsFLAG = 1;
+        ambi_dec_initHRTFs(hAmbi, pars);
+        return;
+    }
+
+    /* compress VBAP table (i.e. remove the zero elements) */
+    pars->hrtf_vbap_gtableComp = realloc1d(pars->hrtf_vbap_gtableComp, pars->N_hrtf_vbap_gtable * 3 * sizeof(float));
+    pars->hrtf_vbap_gtableIdx  = realloc1d(pars->hrtf_vbap_gtableIdx,  pars->N_hrtf_vbap_gtable * 3 * sizeof(int));
+    compressVBAPgainTable3D(hrtf_vbap_gtable, pars->N_hrtf_vbap_gtable, pars->N_hrir_dirs, pars->hrtf_vbap_gtableComp, pars->hrtf_vbap_gtableIdx);
+
+    /* convert hrirs to filterbank coefficients */
+    strcpy(pData->progressBarText,"Preparing HRIRs");
+    pData->progressBar0_1 = 0.85f;
+    pars->hrtf_fb = realloc1d(pars->hrtf_fb, pData->nBands * NUM_EARS * (pars->N_hrir_dirs)*sizeof(float_complex));
+    HRIRs2FilterbankHRTFs(pars->hrirs, pars->N_hrir_dirs, pars->hrir_len, pData->hopSize, 1, pars->hrtf_fb);
+    diffuseFieldEqualiseHRTFs(pars->N_hrir_dirs, pars->itds_s, pData->freqVector, pData->nBands, pars->hrtf_fb);
+
+    /* calculate magnitude responses */
+    pars->hrtf_fb_mag = realloc1d(pars->hrtf_fb_mag, pData->nBands*NUM_EARS*(pars->N_hrir_dirs)*sizeof(float));
+    for(i=0; i<pData->nBands*NUM_EARS* (pars->N_hrir_dirs); i++)
+        pars->hrtf_fb_mag[i] = cabsf(pars->hrtf_fb[i]);
+
+    /* clean-up */
+    free(hrtf_vbap_gtable);
+}
+
+void ambi_dec_copyHRTFs
+(
+    void* const hAmbi,
+    ambi_dec_codecPars* src,
+    ambi_dec_codecPars* dst
+)
+{
+    ambi_dec_data *pData = (ambi_dec_data*)(hAmbi);
+    int nBands;
+
+    nBands = pData->nBands;
+    dst->N_hrir_dirs = src->N_hrir_dirs;
+    dst->hrir_len = src->hrir_len;
+    dst->hrir_fs = src->hrir_fs;
+    dst->hrirs = malloc1d(src->N_hrir_dirs*NUM_EARS*src->hrir_len*sizeof(float));
+    memcpy(dst->hrirs, src->hrirs, src->N_hrir_dirs*NUM_EARS*src->hrir_len*sizeof(float));
+    dst->hrir_dirs_deg = malloc1d(src->N_hrir_dirs*2*sizeof(float));
+    memcpy(dst->hrir_dirs_deg, src->hrir_dirs_deg, src->N_hrir_dirs*2*sizeof(float));
+    memcpy(dst->hrtf_vbapTableRes, src->hrtf_vbapTableRes, 2*sizeof(int));
+    dst->N_hrtf_vbap_gtable = src->N_hrtf_vbap_gtable;
+    dst->hrtf_nTriangles = src->hrtf_nTriangles;
+    dst->hrtf_vbap_gtableIdx = malloc1d(src->N_hrtf_vbap_gtable*3*sizeof(int));
+    memcpy(dst->hrtf_vbap_gtableIdx, src->hrtf_vbap_gtableIdx, src->N_hrtf_vbap_gtable*3*sizeof(int));
+    dst->hrtf_vbap_gtableComp = malloc1d(src->N_hrtf_vbap_gtable*3*sizeof(float));
+    memcpy(dst->hrtf_vbap_gtableComp, src->hrtf_vbap_gtableComp, src->N_hrtf_vbap_gtable*3*sizeof(float));
+    dst->itds_s = malloc1d(src->N_hrir_dirs*sizeof(float));
+    memcpy(dst->itds_s, src->itds_s, src->N_hrir_dirs*sizeof(float));
+    dst->hrtf_fb = malloc1d(nBands*NUM_EARS*(src->N_hrir_dirs)*sizeof(float_complex));
+    memcpy(dst->hrtf_fb, src->hrtf_fb, nBands*NUM_EARS*(src->N_hrir_dirs)*sizeof(float_complex));
+    dst->hrtf_fb_mag = malloc1d(nBands*NUM_EARS*(src->N_hrir_dirs)*sizeof(float));
+    memcpy(dst->hrtf_fb_mag, src->hrtf_fb_mag, nBands*NUM_EARS*(src->N_hrir_dirs)*sizeof(float));
 }
 
 void ambi_dec_interpHRTFs
 (
     void* const hAmbi,
+    ambi_dec_codecPars* pars,
     float azimuth_deg,
     float elevation_deg,
-    float_complex h_intrp[HYBRID_BANDS][NUM_EARS]
+    float_complex** h_intrp
 )
 {
     ambi_dec_data *pData = (ambi_dec_data*)(hAmbi);
-    ambi_dec_codecPars* pars = pData->pars;
-    int i, band;
+    int i, band, hrirIdx3[3];
     int aziIndex, elevIndex, N_azi, idx3d;
     float_complex ipd;
     float aziRes, elevRes, weights[1][3], itds3[3],  itdInterp[1];
-    float magnitudes3[HYBRID_BANDS][3][NUM_EARS], magInterp[HYBRID_BANDS][NUM_EARS];
+    float magnitudes3[3][NUM_EARS], magInterp[NUM_EARS];
 
     /* find closest pre-computed VBAP direction */
     aziRes = (float)pars->hrtf_vbapTableRes[0];
@@ -70,13 +191,10 @@ void ambi_dec_interpHRTFs
     for (i = 0; i < 3; i++)
         weights[0][i] = pars->hrtf_vbap_gtableComp[idx3d*3 + i];
     
-    /* retrieve the 3 itds and hrtf magnitudes */
+    /* retrieve the 3 itds */
     for (i = 0; i < 3; i++) {
-        itds3[i] = pars->itds_s[pars->hrtf_vbap_gtableIdx[idx3d*3+i]];
-        for (band = 0; band < HYBRID_BANDS; band++) {
-            magnitudes3[band][i][0] = pars->hrtf_fb_mag[band*NUM_EARS*(pars->N_hrir_dirs) + 0*(pars->N_hrir_dirs) + pars->hrtf_vbap_gtableIdx[idx3d*3+i]];
-            magnitudes3[band][i][1] = pars->hrtf_fb_mag[band*NUM_EARS*(pars->N_hrir_dirs) + 1*(pars->N_hrir_dirs) + pars->hrtf_vbap_gtableIdx[idx3d*3+i]];
-        }
+        hrirIdx3[i] = pars->hrtf_vbap_gtableIdx[idx3d*3+i];
+        itds3[i] = pars->itds_s[hrirIdx3[i]];
     }
     
     /* interpolate hrtf magnitudes and itd seperately */
@@ -84,18 +202,21 @@ void ambi_dec_interpHRTFs
                 (float*)weights, 3,
                 (float*)itds3, 1, 0,
                 (float*)itdInterp, 1);
-    for (band = 0; band < HYBRID_BANDS; band++) {
+    for (band = 0; band < pData->nBands; band++) {
+        /* retrieve the 3 hrtf magnitudes for this band */
+        for (i = 0; i < 3; i++) {
+            magnitudes3[i][0] = pars->hrtf_fb_mag[band*NUM_EARS*(pars->N_hrir_dirs) + 0*(pars->N_hrir_dirs) + hrirIdx3[i]];
+            magnitudes3[i][1] = pars->hrtf_fb_mag[band*NUM_EARS*(pars->N_hrir_dirs) + 1*(pars->N_hrir_dirs) + hrirIdx3[i]];
+        }
         cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, 1, 2, 3, 1,
                     (float*)weights, 3,
-                    (float*)magnitudes3[band], 2, 0,
-                    (float*)magInterp[band], 2);
-    }
-    
-    /* reintroduce the interaural phase difference per band */
-    for (band = 0; band < HYBRID_BANDS; band++) {
+                    (float*)magnitudes3, 2, 0,
+                    (float*)magInterp, 2);
+
+        /* reintroduce the interaural phase difference */
         ipd = cmplxf(0.0f, (matlab_fmodf(2.0f*SAF_PI* (pData->freqVector[band]) * itdInterp[0] + SAF_PI, 2.0f*SAF_PI) - SAF_PI) / 2.0f); 
-        h_intrp[band][0] = ccmulf(cmplxf(magInterp[band][0], 0.0f), cexpf(ipd));
-        h_intrp[band][1] = ccmulf(cmplxf(magInterp[band][1], 0.0f), conjf(cexpf(ipd)));
+        h_intrp[band][0] = ccmulf(cmplxf(magInterp[0], 0.0f), cexpf(ipd));
+        h_intrp[band][1] = ccmulf(cmplxf(magInterp[1], 0.0f), conjf(cexpf(ipd)));
     }
 }
 
@@ -48,12 +48,6 @@ extern "C" {
 /*                            Internal Parameters                             */
 /* ========================================================================== */
 
-#ifndef FRAME_SIZE
-# define FRAME_SIZE ( 128 ) 
-#endif
-#define HOP_SIZE ( 128 )                      /* STFT hop size = nBands */
-#define HYBRID_BANDS ( HOP_SIZE + 5 )         /* hybrid mode incurs an additional 5 bands  */
-#define TIME_SLOTS ( FRAME_SIZE / HOP_SIZE )  /* 4/8/16 */ 
 #define MAX_NUM_LOUDSPEAKERS ( MAX_NUM_OUTPUTS ) /* Maximum permitted channels for the VST standard */
 #define MIN_NUM_LOUDSPEAKERS ( 4 )            /* To help avoid traingulation errors when using AllRAD */ 
 #define NUM_DECODERS ( 2 )                    /* one for low-frequencies and another for high-frequencies */
@@ -64,11 +58,23 @@ extern "C" {
 /* ========================================================================== */
 
 /**
- * Contains variables for sofa file loading, HRTF interpolation, and the
- * loudspeaker decoders.
+ * Codec state of ambi_dec: the afSTFT, loudspeaker decoders and HRTF data for
+ * one configuration
+ *
+ * A new state is built by ambi_dec_initCodec() and handed over to the
+ * processing loop via a saf_stateSwap (see saf_stateSwap_create()). Once
+ * published, it is no longer modified; except for the afSTFT buffers, which
+ * only the processing loop uses.
  */
 typedef struct _ambi_dec_codecPars
 {
+    /* afSTFT */
+    int masterOrder;                            /**< decoding order the state is built for */
+    int nLoudpkrs;                              /**< number of loudspeakers the state is built for */
+    int binauraliseLS;                          /**< 1: the afSTFT outputs NUM_EARS channels, 0: nLoudpkrs channels */
+    int LDmode;                                 /**< low-delay mode of the afSTFT */
+    void* hSTFT;                                /**< afSTFT handle */
+
     /* decoders */
     float* M_dec[NUM_DECODERS][MAX_SH_ORDER];   /**< ambisonic decoding matrices ([0] for low-freq, [1] for high-freq); FLAT: nLoudspeakers x nSH */
     float_complex* M_dec_cmplx[NUM_DECODERS][MAX_SH_ORDER]; /**< complex ambisonic decoding matrices ([0] for low-freq, [1] for high-freq); FLAT: nLoudspeakers x nSH */
@@ -77,7 +83,6 @@ typedef struct _ambi_dec_codecPars
     float M_norm[NUM_DECODERS][MAX_SH_ORDER][2]; /**< norm coefficients to preserve omni energy/amplitude between different orders and decoders */
     
     /* sofa file info */
-    char* sofa_filepath;                        /**< absolute/relevative file path for a sofa file */
     float* hrirs;                               /**< time domain HRIRs; N_hrir_dirs x 2 x hrir_len */
     float* hrir_dirs_deg;                       /**< directions of the HRIRs in degrees [azi elev]; N_hrir_dirs x 2 */
     int N_hrir_dirs;                            /**< number of HRIR directions in the current sofa file */
@@ -95,7 +100,6 @@ typedef struct _ambi_dec_codecPars
     float* itds_s;                              /**< interaural-time differences for each HRIR (in seconds); N_hrirs x 1 */
     float_complex* hrtf_fb;                     /**< HRTF filterbank coefficients; nBands x nCH x N_hrirs */
     float* hrtf_fb_mag;                         /**< magnitudes of the HRTF filterbank coefficients; nBands x nCH x N_hrirs */
-    float_complex hrtf_interp[MAX_NUM_LOUDSPEAKERS][HYBRID_BANDS][NUM_EARS]; /* interpolated HRTFs */
     
 }ambi_dec_codecPars;
 
@@ -106,23 +110,31 @@ typedef struct _ambi_dec_codecPars
 typedef struct _ambi_dec
 {
     /* audio buffers + afSTFT time-frequency transform handle */
-    float SHFrameTD[MAX_NUM_SH_SIGNALS][FRAME_SIZE];
-    float_complex SHframeTF[HYBRID_BANDS][MAX_NUM_SH_SIGNALS][TIME_SLOTS];
-    float_complex outputframeTF[HYBRID_BANDS][MAX_NUM_LOUDSPEAKERS][TIME_SLOTS];
-    float_complex binframeTF[HYBRID_BANDS][NUM_EARS][TIME_SLOTS];
-    complexVector* STFTInputFrameTF;
-    complexVector* STFTOutputFrameTF;
-    void* hSTFT;                         /**< afSTFT handle */
+    int frameSize;                       /**< processing frame size, in samples (fixed at creation) */
+    int hopSize;                         /**< afSTFT hop size, in samples */
+    int nBands;                          /**< number of (hybrid) frequency bands; hopSize + 5 */
+    int timeSlots;                       /**< number of time slots per frame; frameSize / hopSize */
+    int LDmode;                          /**< low-delay mode of the latest codec state */
+    int new_LDmode;                      /**< new low-delay mode; applied when the afSTFT is re-initialised */
+    float** SHFrameTD;                   /**< MAX_NUM_SH_SIGNALS x frameSize */
+    float** outputFrameTD;               /**< MAX(MAX_NUM_LOUDSPEAKERS, NUM_EARS) x frameSize */
+    float_complex*** SHframeTF;          /**< nBands x MAX_NUM_SH_SIGNALS x timeSlots */
+    float_complex*** outputframeTF;      /**< nBands x MAX_NUM_LOUDSPEAKERS x timeSlots */
+    float_complex*** binframeTF;         /**< nBands x NUM_EARS x timeSlots */
+    void* hBlockAdaptor;                 /**< block-size adaptor handle */
     int afSTFTdelay;                     /**< for host delay compensation */
-    float** tempHopFrameTD;              /**< temporary multi-channel time-domain buffer of size "HOP_SIZE". */
     int fs;                              /**< host sampling rate */
-    float freqVector[HYBRID_BANDS];      /**< frequency vector for time-frequency transform, in Hz */
+    float* freqVector;                   /**< frequency vector for time-frequency transform, in Hz; nBands x 1 */
     
     /* our codec configuration */
-    CODEC_STATUS codecStatus;
+    volatile int codecStatus;            /**< see #_CODEC_STATUS enum */
     float progressBar0_1;
     char* progressBarText;
-    ambi_dec_codecPars* pars;            /**< codec parameters */
+    void* hCodecState;                   /**< saf_stateSwap handing ambi_dec_codecPars to the processing loop */
+    ambi_dec_codecPars* pars;            /**< latest codec state built by ambi_dec_initCodec() (NULL if none) */
+    ambi_dec_codecPars* procPars;        /**< codec state last used by the processing loop (only accessed by it) */
+    char* sofa_filepath;                 /**< absolute/relevative file path for a sofa file */
+    float_complex*** hrtf_interp;        /**< interpolated HRTFs (only accessed by the processing loop); MAX_NUM_LOUDSPEAKERS x nBands x NUM_EARS */
     
     /* internal variables */
     int loudpkrs_nDims;                  /**< dimensionality of the current loudspeaker set-up */
@@ -131,13 +143,12 @@ typedef struct _ambi_dec
     int new_masterOrder;
     
     /* flags */
-    PROC_STATUS procStatus;
     int reinit_hrtfsFLAG; /**< 0: no init required, 1: init required */
     int recalc_hrtf_interpFLAG[MAX_NUM_LOUDSPEAKERS]; /**< 0: no init required, 1: init required */
     
     /* user parameters */
     int masterOrder;
-    int orderPerBand[HYBRID_BANDS];      /**< Ambisonic decoding order per frequency band 1..SH_ORDER */
+    int* orderPerBand;                   /**< Ambisonic decoding order per frequency band 1..SH_ORDER; nBands x 1 */
     AMBI_DEC_DECODING_METHODS dec_method[NUM_DECODERS]; /**< decoding methods for each decoder, see "DECODING_METHODS" enum */
     int rE_WEIGHT[NUM_DECODERS];         /**< 0:disabled, 1: enable max_rE weight */
     AMBI_DEC_DIFFUSE_FIELD_EQ_APPROACH diffEQmode[NUM_DECODERS]; /**< diffuse-field EQ approach; see "DIFFUSE_FIELD_EQ_APPROACH" enum */
@@ -158,23 +169,59 @@ typedef struct _ambi_dec
 
 /**
  * Sets codec status (see #_CODEC_STATUS enum)
+ *
+ * This never waits: if the codec is being initialised, then setting
+ * #CODEC_STATUS_NOT_INITIALISED causes ambi_dec_initCodec() to leave the
+ * status as such, so that the next call re-initialises the codec again.
  */
 void ambi_dec_setCodecStatus(void* const hCmp, CODEC_STATUS newStatus);
 
+/**
+ * Destroys a codec state (see saf_stateSwap_destroyFn)
+ *
+ * @param[in] phPars (&) address of the ambi_dec_codecPars
+ */
+void ambi_dec_destroyCodecPars(void** const phPars);
+
+/**
+ * Loads the HRIRs (either the default set or those of the SOFA file), and
+ * computes their VBAP interpolation table and filterbank coefficients, for a
+ * new codec state
+ *
+ * @param[in] hAmbi ambi_dec handle
+ * @param[in] pars  The new codec state
+ */
+void ambi_dec_initHRTFs(void* const hAmbi,
+                        ambi_dec_codecPars* pars);
+
+/**
+ * Copies the HRTF data of one codec state into a new one (when it does not
+ * need to be recomputed)
+ *
+ * @param[in] hAmbi ambi_dec handle
+ * @param[in] src   Codec state to copy from
+ * @param[in] dst   The new codec state
+ */
+void ambi_dec_copyHRTFs(void* const hAmbi,
+                        ambi_dec_codecPars* src,
+                        ambi_dec_codecPars* dst);
+
 /**
  * Interpolates between the 3 nearest HRTFs using amplitude-preserving VBAP
  * gains. The HRTF magnitude responses and HRIR ITDs are interpolated seperately
  * before being re-combined.
  *
  * @param[in]  hAmbi         ambi_dec handle
+ * @param[in]  pars          Codec state holding the HRTF data
  * @param[in]  azimuth_deg   Interpolation direction azimuth in DEGREES
  * @param[in]  elevation_deg Interpolation direction elevation in DEGREES
- * @param[out] h_intrp       Interpolated HRTF
+ * @param[out] h_intrp       Interpolated HRTF; nBands x NUM_EARS
  */
 void ambi_dec_interpHRTFs(void* const hAmbi,
+                          ambi_dec_codecPars* pars,
                           float azimuth_deg,
                           float elevation_deg,
-                          float_complex h_intrp[HYBRID_BANDS][NUM_EARS]);
+                          float_complex** h_intrp);
 
 /**
  * Returns the loudspeaker directions for a specified loudspeaker array preset.
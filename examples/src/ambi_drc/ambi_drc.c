@@ -43,31 +43,43 @@ void ambi_drc_create
 (
     void ** const phAmbi
 )
+{
+    ambi_drc_createWithFrameSize(phAmbi, DEFAULT_TF_FRAME_SIZE);
+}
+
+void ambi_drc_createWithFrameSize
+(
+    void ** const phAmbi,
+    int frameSize
+)
 {
     ambi_drc_data* pData = (ambi_drc_data*)malloc1d(sizeof(ambi_drc_data));
     *phAmbi = (void*)pData;
-    int ch;
- 
+
+    /* frame size (= afSTFT hop size), which is fixed for the lifetime of the instance */
+    pData->frameSize = IS_VALID_TF_FRAME_SIZE(frameSize) ? frameSize : DEFAULT_TF_FRAME_SIZE;
+    pData->hopSize = pData->frameSize;
+    pData->nBands = pData->hopSize + 5;
+    pData->timeSlots = pData->frameSize / pData->hopSize;
+    pData->LDmode = 0;
+    pData->new_LDmode = 0;
+
     /* afSTFT stuff */
     pData->hSTFT = NULL;
-    pData->STFTInputFrameTF = malloc1d(MAX_NUM_SH_SIGNALS*sizeof(complexVector));
-    for(ch=0; ch< MAX_NUM_SH_SIGNALS; ch++) {
-        pData->STFTInputFrameTF[ch].re = (float*)calloc1d(HYBRID_BANDS, sizeof(float));
-        pData->STFTInputFrameTF[ch].im = (float*)calloc1d(HYBRID_BANDS, sizeof(float));
-    }
-    pData->tempHopFrameTD = (float**)malloc2d( MAX(MAX_NUM_SH_SIGNALS, MAX_NUM_SH_SIGNALS), HOP_SIZE, sizeof(float));
-    pData->STFTOutputFrameTF = malloc1d(MAX_NUM_SH_SIGNALS*sizeof(complexVector));
-    for(ch=0; ch< MAX_NUM_SH_SIGNALS; ch++) {
-        pData->STFTOutputFrameTF[ch].re = (float*)calloc1d(HYBRID_BANDS, sizeof(float));
-        pData->STFTOutputFrameTF[ch].im = (float*)calloc1d(HYBRID_BANDS, sizeof(float));
-    } 
+    pData->inputFrameTD = (float**)malloc2d(MAX_NUM_SH_SIGNALS, pData->frameSize, sizeof(float));
+    pData->outputFrameTD = (float**)malloc2d(MAX_NUM_SH_SIGNALS, pData->frameSize, sizeof(float));
+    pData->inputFrameTF = (float_complex***)malloc3d(pData->nBands, MAX_NUM_SH_SIGNALS, pData->timeSlots, sizeof(float_complex));
+    pData->outputFrameTF = (float_complex***)malloc3d(pData->nBands, MAX_NUM_SH_SIGNALS, pData->timeSlots, sizeof(float_complex));
+    pData->freqVector = calloc1d(pData->nBands, sizeof(float));
+    saf_blockAdaptor_create(&(pData->hBlockAdaptor), pData->frameSize, MAX_NUM_SH_SIGNALS, MAX_NUM_SH_SIGNALS);
     
     /* internal */
     pData->fs = 48000;
+    pData->yL_z1 = calloc1d(pData->nBands, sizeof(float));
      
 #ifdef ENABLE_TF_DISPLAY
-    pData->gainsTF_bank0 = (float**)malloc2d(HYBRID_BANDS, AMBI_DRC_NUM_DISPLAY_TIME_SLOTS, sizeof(float));
-    pData->gainsTF_bank1 = (float**)malloc2d(HYBRID_BANDS, AMBI_DRC_NUM_DISPLAY_TIME_SLOTS, sizeof(float));
+    pData->gainsTF_bank0 = (float**)malloc2d(pData->nBands, AMBI_DRC_NUM_DISPLAY_TIME_SLOTS, sizeof(float));
+    pData->gainsTF_bank1 = (float**)malloc2d(pData->nBands, AMBI_DRC_NUM_DISPLAY_TIME_SLOTS, sizeof(float));
 #endif
   
     /* Default user parameters */
@@ -94,21 +106,17 @@ void ambi_drc_destroy
 )
 {
     ambi_drc_data *pData = (ambi_drc_data*)(*phAmbi);
-    int ch;
 
     if (pData != NULL) {
-        if (pData->hSTFT != NULL) {
+        if (pData->hSTFT != NULL)
             afSTFTfree(pData->hSTFT);
-            for (ch = 0; ch < MAX_NUM_SH_SIGNALS; ch++) {
-                free(pData->STFTInputFrameTF[ch].re);
-                free(pData->STFTInputFrameTF[ch].im);
-                free(pData->STFTOutputFrameTF[ch].re);
-                free(pData->STFTOutputFrameTF[ch].im);
-            }
-            free(pData->STFTInputFrameTF);
-            free(pData->STFTOutputFrameTF);
-            free(pData->tempHopFrameTD);
-        }
+        free(pData->inputFrameTD);
+        free(pData->outputFrameTD);
+        free(pData->inputFrameTF);
+        free(pData->outputFrameTF);
+        free(pData->freqVector);
+        free(pData->yL_z1);
+        saf_blockAdaptor_destroy(&(pData->hBlockAdaptor));
 #ifdef ENABLE_TF_DISPLAY
         free(pData->gainsTF_bank0);
         free(pData->gainsTF_bank1);
@@ -128,19 +136,15 @@ void ambi_drc_init
     int band;
 
     pData->fs = (float)sampleRate;
-    memset(pData->yL_z1, 0, HYBRID_BANDS * sizeof(float));
-    for(band=0; band <HYBRID_BANDS; band++){
-        if(sampleRate==44100)
-            pData->freqVector[band] =  (float)__afCenterFreq44100[band];
-        else /* assume 48e3 */
-            pData->freqVector[band] =  (float)__afCenterFreq48e3[band];
-    }
+    saf_blockAdaptor_reset(pData->hBlockAdaptor);
+    memset(pData->yL_z1, 0, pData->nBands * sizeof(float));
+    afSTFTgetCenterFreqs(pData->hopSize, 1, (float)sampleRate, pData->freqVector);
 
 #ifdef ENABLE_TF_DISPLAY
     pData->rIdx = 0;
     pData->wIdx = 1;
     pData->storeIdx = 0;
-    for (band = 0; band < HYBRID_BANDS; band++) {
+    for (band = 0; band < pData->nBands; band++) {
         memset(pData->gainsTF_bank0[band], 0, AMBI_DRC_NUM_DISPLAY_TIME_SLOTS * sizeof(float));
         memset(pData->gainsTF_bank1[band], 0, AMBI_DRC_NUM_DISPLAY_TIME_SLOTS * sizeof(float));
     }
@@ -154,30 +158,28 @@ void ambi_drc_init
     }
 }
 
-void ambi_drc_process
+/** Processes one frame of frameSize samples (see saf_blockAdaptor_apply()) */
+static void ambi_drc_processFrame
 (
     void*   const hAmbi,
     float** const inputs,
     float** const outputs,
-    int nCh,
-    int nSamples
-)                                         
+    int nInputs,
+    int nOutputs
+)
 {
     ambi_drc_data *pData = (ambi_drc_data*)(hAmbi);
-    int i, t, ch, band, nSH; 
+    int i, t, ch, band, nSH, frameSize, nBands, timeSlots; 
+    float* inPtrs[MAX_NUM_SH_SIGNALS], *outPtrs[MAX_NUM_SH_SIGNALS];
     float xG, yG, xL, yL, cdB, alpha_a, alpha_r;
     float makeup, boost, theshold, ratio, knee;
-    
-    /* reinitialise if needed */
-    if(pData->reInitTFT==1){
-        pData->reInitTFT = 2;
-        ambi_drc_initTFT(hAmbi);
-        pData->reInitTFT = 0;
-    }
 
     /* local copies of user parameters */
-    alpha_a = expf(-1.0f / ( (pData->attack_ms  / ((float)FRAME_SIZE / (float)TIME_SLOTS)) * pData->fs * 0.001f));
-    alpha_r = expf(-1.0f / ( (pData->release_ms / ((float)FRAME_SIZE / (float)TIME_SLOTS)) * pData->fs * 0.001f));
+    frameSize = pData->frameSize;
+    nBands = pData->nBands;
+    timeSlots = pData->timeSlots;
+    alpha_a = expf(-1.0f / ( (pData->attack_ms  / ((float)frameSize / (float)timeSlots)) * pData->fs * 0.001f));
+    alpha_r = expf(-1.0f / ( (pData->release_ms / ((float)frameSize / (float)timeSlots)) * pData->fs * 0.001f));
     boost = powf(10.0f, pData->inGain / 20.0f);
     makeup = powf(10.0f, pData->outGain / 20.0f);
     theshold = pData->theshold;
@@ -186,31 +188,29 @@ void ambi_drc_process
     nSH = pData->nSH;
 
     /* Main processing loop */
-    if (nSamples == FRAME_SIZE && pData->reInitTFT == 0) {
-
-        /* Load time-domain data */
-        for(i=0; i < MIN(pData->nSH, nCh); i++)
-            utility_svvcopy(inputs[i], FRAME_SIZE, pData->inputFrameTD[i]);
-        for(; i<pData->nSH; i++)
-            memset(pData->inputFrameTD[i], 0, FRAME_SIZE * sizeof(float));
-
+    if (pData->reInitTFT == 0) {
+
+        /* Transform the host frames directly (missing channels are zeroed
+         * internal buffers); outputs are written after all inputs are read */
+        for(i=0; i < MIN(nSH, nInputs); i++)
+            inPtrs[i] = inputs[i];
+        for(; i<nSH; i++){
+            memset(pData->inputFrameTD[i], 0, frameSize * sizeof(float));
+            inPtrs[i] = pData->inputFrameTD[i];
+        }
+        for(ch=0; ch < nSH; ch++)
+            outPtrs[ch] = ch < nOutputs ? outputs[ch] : pData->outputFrameTD[ch];
 
         /* Apply time-frequency transform */
-        for(t=0; t< TIME_SLOTS; t++) {
-            for(ch = 0; ch < pData->nSH; ch++)
-                utility_svvcopy(&(pData->inputFrameTD[ch][t*HOP_SIZE]), HOP_SIZE, pData->tempHopFrameTD[ch]);
-            afSTFTforward(pData->hSTFT, (float**)pData->tempHopFrameTD, (complexVector*)pData->STFTInputFrameTF);
-            for (band = 0; band < HYBRID_BANDS; band++)
-                for (ch = 0; ch < pData->nSH; ch++)
-                    pData->inputFrameTF[band][ch][t] = cmplxf(pData->STFTInputFrameTF[ch].re[band], pData->STFTInputFrameTF[ch].im[band]);
-        }
+        afSTFTforwardFrame(pData->hSTFT, inPtrs, frameSize, MAX_NUM_SH_SIGNALS,
+                           AFSTFT_BANDS_CH_TIME, FLATTEN3D(pData->inputFrameTF));
 
         /* Main processing: */
         /* Calculate the dynamic range compression gain factors per frequency band based on the omnidirectional component.
             *     McCormack, L., & Välimäki, V. (2017). "FFT-Based Dynamic Range Compression". in Proceedings of the 14th
             *     Sound and Music Computing Conference, July 5-8, Espoo, Finland.*/
-        for (t = 0; t < TIME_SLOTS; t++) {
-            for (band = 0; band < HYBRID_BANDS; band++) {
+        for (t = 0; t < timeSlots; t++) {
+            for (band = 0; band < nBands; band++) {
                 /* apply input boost */
                 for (ch = 0; ch < pData->nSH; ch++)
                     pData->inputFrameTF[band][ch][t] = crmulf(pData->inputFrameTF[band][ch][t], boost);
@@ -250,26 +250,61 @@ void ambi_drc_process
         }
 
         /* Inverse time-frequency transform */
-        for(t = 0; t < TIME_SLOTS; t++) {
-            for (ch = 0; ch < pData->nSH; ch++) {
-                for (band = 0; band < HYBRID_BANDS; band++) {
-                    pData->STFTOutputFrameTF[ch].re[band] = crealf(pData->outputFrameTF[band][ch][t]);
-                    pData->STFTOutputFrameTF[ch].im[band] = cimagf(pData->outputFrameTF[band][ch][t]);
-                }
-            }
-            afSTFTinverse(pData->hSTFT, pData->STFTOutputFrameTF, pData->tempHopFrameTD);
-            for(ch = 0; ch < MIN(pData->nSH, nCh); ch++)
-                utility_svvcopy(pData->tempHopFrameTD[ch], HOP_SIZE, &(outputs[ch][t* HOP_SIZE]));
-            for (; ch < nCh; ch++)
-                memset(&(outputs[ch][t* HOP_SIZE]), 0, HOP_SIZE*sizeof(float));
-        }
+        afSTFTinverseFrame(pData->hSTFT, FLATTEN3D(pData->outputFrameTF), frameSize, MAX_NUM_SH_SIGNALS,
+                           AFSTFT_BANDS_CH_TIME, outPtrs);
+        for (ch = nSH; ch < nOutputs; ch++)
+            memset(outputs[ch], 0, frameSize*sizeof(float));
     }
     else {
-        for (ch=0; ch < nCh; ch++)
-            memset(outputs[ch], 0, FRAME_SIZE*sizeof(float));
+        for (ch=0; ch < nOutputs; ch++)
+            memset(outputs[ch], 0, frameSize*sizeof(float));
     }
 }
 
+void ambi_drc_process
+(
+    void*   const hAmbi,
+    float** const inputs,
+    float** const outputs,
+    int nCh,
+    int nSamples
+)                                         
+{
+    ambi_drc_data *pData = (ambi_drc_data*)(hAmbi);
+    
+    /* reinitialise if needed */
+    if(pData->reInitTFT==1){
+        pData->reInitTFT = 2;
+        ambi_drc_initTFT(hAmbi);
+        pData->reInitTFT = 0;
+    }
+
+    saf_blockAdaptor_apply(pData->hBlockAdaptor, inputs, outputs, nCh, nCh,
+                           nSamples, ambi_drc_processFrame, hAmbi);
+}
+
+void ambi_drc_processInterleaved
+(
+    void*   const hAmbi,
+    const float* inputs,
+    float*  outputs,
+    int nCh,
+    int nSamples
+)
+{
+    ambi_drc_data *pData = (ambi_drc_data*)(hAmbi);
+
+    /* reinitialise if needed */
+    if(pData->reInitTFT==1){
+        pData->reInitTFT = 2;
+        ambi_drc_initTFT(hAmbi);
+        pData->reInitTFT = 0;
+    }
+
+    saf_blockAdaptor_applyStrided(pData->hBlockAdaptor, inputs, 1, nCh, outputs, 1, nCh,
+                                  nCh, nCh, nSamples, ambi_drc_processFrame, hAmbi);
+}
+
 /* SETS */
 
 void ambi_drc_refreshSettings(void* const hAmbi)
@@ -348,12 +383,27 @@ void ambi_drc_setInputPreset(void* const hAmbi, SH_ORDERS newPreset)
         pData->norm = NORM_SN3D;
 }
 
+void ambi_drc_setLowDelayMode(void* const hAmbi, int newState)
+{
+    ambi_drc_data *pData = (ambi_drc_data*)(hAmbi);
+    if(pData->new_LDmode != (newState ? 1 : 0)){
+        pData->new_LDmode = newState ? 1 : 0;
+        pData->reInitTFT = 1;
+    }
+}
+
 
 /* GETS */
 
 int ambi_drc_getFrameSize(void)
 {
-    return FRAME_SIZE;
+    return DEFAULT_TF_FRAME_SIZE;
+}
+
+int ambi_drc_getFrameSizeEx(void* const hAmbi)
+{
+    ambi_drc_data *pData = (ambi_drc_data*)(hAmbi);
+    return pData->frameSize;
 }
 
 #ifdef ENABLE_TF_DISPLAY
@@ -381,7 +431,7 @@ int ambi_drc_getGainTFrIdx(void* const hAmbi)
 float* ambi_drc_getFreqVector(void* const hAmbi, int* nFreqPoints)
 {
     ambi_drc_data *pData = (ambi_drc_data*)(hAmbi);
-    (*nFreqPoints) = HYBRID_BANDS;
+    (*nFreqPoints) = pData->nBands;
     return pData->freqVector;
 }
 #endif
@@ -458,8 +508,20 @@ int ambi_drc_getSamplerate(void* const hAmbi)
     return (int)(pData->fs+0.5f);
 }
 
-int ambi_drc_getProcessingDelay()
+int ambi_drc_getLowDelayMode(void* const hAmbi)
+{
+    ambi_drc_data *pData = (ambi_drc_data*)(hAmbi);
+    return pData->new_LDmode;
+}
+
+int ambi_drc_getProcessingDelay(void)
 {
-    return 12*HOP_SIZE;
+    return afSTFTgetProcessingDelay(DEFAULT_TF_FRAME_SIZE, 0, 1);
+}
+
+int ambi_drc_getProcessingDelayEx(void* const hAmbi)
+{
+    ambi_drc_data *pData = (ambi_drc_data*)(hAmbi);
+    return afSTFTgetProcessingDelay(pData->hopSize, pData->LDmode, 1) + saf_blockAdaptor_getDelay(pData->hBlockAdaptor);
 }
 
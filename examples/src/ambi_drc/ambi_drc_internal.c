@@ -91,8 +91,13 @@ void ambi_drc_initTFT
     ambi_drc_data *pData = (ambi_drc_data*)(hAmbi);
 
     /* Initialise afSTFT */
+    if(pData->hSTFT!=NULL && pData->LDmode!=pData->new_LDmode){
+        afSTFTfree(pData->hSTFT); /* the low-delay mode may only be set upon initialisation */
+        pData->hSTFT = NULL;
+    }
+    pData->LDmode = pData->new_LDmode;
     if (pData->hSTFT == NULL)
-        afSTFTinit(&(pData->hSTFT), HOP_SIZE, pData->new_nSH, pData->new_nSH, 0, 1);
+        afSTFTinit(&(pData->hSTFT), pData->hopSize, pData->new_nSH, pData->new_nSH, pData->LDmode, 1);
     else if(pData->nSH!=pData->new_nSH){/* Or change the number of channels */
         afSTFTchannelChange(pData->hSTFT, pData->new_nSH, pData->new_nSH);
         afSTFTclearBuffers(pData->hSTFT);
@@ -53,14 +53,6 @@ extern "C" {
 /*                            Internal Parameters                             */
 /* ========================================================================== */
 
-#ifndef FRAME_SIZE
-# define FRAME_SIZE ( 128 ) 
-#endif
-#define HOP_SIZE ( 128 )  /* STFT hop size, can be flexible, but only 'hybrid' mode afSTFT is supported (i.e. non uniform) */
-#define TIME_SLOTS ( FRAME_SIZE/HOP_SIZE ) /* time-frequency domain frame size */
-#define HYBRID_BANDS ( HOP_SIZE + 5 ) /* hybrid mode incurs an additional 5 bands  */
-
-
 /* ========================================================================== */
 /*                                 Structures                                 */
 /* ========================================================================== */
@@ -72,19 +64,24 @@ extern "C" {
 typedef struct _ambi_drc
 { 
     /* audio buffers and afSTFT handle */
-    float inputFrameTD[MAX_NUM_SH_SIGNALS][FRAME_SIZE]; 
-    float_complex inputFrameTF[HYBRID_BANDS][MAX_NUM_SH_SIGNALS][TIME_SLOTS];
-    float_complex outputFrameTF[HYBRID_BANDS][MAX_NUM_SH_SIGNALS][TIME_SLOTS];
+    int frameSize;          /**< processing frame size, in samples (fixed at creation) */
+    int hopSize;            /**< afSTFT hop size, in samples (only 'hybrid' mode afSTFT is supported) */
+    int nBands;             /**< number of (hybrid) frequency bands; hopSize + 5 */
+    int timeSlots;          /**< number of time slots per frame; frameSize / hopSize */
+    int LDmode;             /**< current low-delay mode of the afSTFT */
+    int new_LDmode;         /**< new low-delay mode; applied when the afSTFT is re-initialised */
+    float** inputFrameTD;   /**< MAX_NUM_SH_SIGNALS x frameSize */
+    float** outputFrameTD;  /**< MAX_NUM_SH_SIGNALS x frameSize */
+    float_complex*** inputFrameTF;  /**< nBands x MAX_NUM_SH_SIGNALS x timeSlots */
+    float_complex*** outputFrameTF; /**< nBands x MAX_NUM_SH_SIGNALS x timeSlots */
     void* hSTFT; 
-    complexVector* STFTInputFrameTF;
-    complexVector* STFTOutputFrameTF;    
-    float** tempHopFrameTD;
-    float freqVector[HYBRID_BANDS];
+    void* hBlockAdaptor;
+    float* freqVector;      /**< nBands x 1 */
 
     /* internal */
     int nSH, new_nSH;
     float fs;
-    float yL_z1[HYBRID_BANDS];
+    float* yL_z1;           /**< nBands x 1 */
     int reInitTFT; /**< 0: no init required, 1: init required, 2: init in progress */
 
 #ifdef ENABLE_TF_DISPLAY
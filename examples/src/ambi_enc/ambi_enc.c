@@ -44,6 +44,12 @@ void ambi_enc_create
     pData->norm = NORM_SN3D;
     pData->order = SH_ORDER_FIRST;
     pData->enablePostScaling = 1;
+
+    /* block-size adaptor */
+    saf_blockAdaptor_create(&(pData->hBlockAdaptor), FRAME_SIZE, MAX_NUM_INPUTS, MAX_NUM_SH_SIGNALS);
+
+    /* SH evaluator (exact evaluation, no look-up table) */
+    saf_shEvaluator_create(&(pData->hSHEval), MAX_SH_ORDER, 0.0f);
 }
 
 void ambi_enc_destroy
@@ -54,6 +60,8 @@ void ambi_enc_destroy
     ambi_enc_data *pData = (ambi_enc_data*)(*phAmbi);
     
     if (pData != NULL) {
+        saf_blockAdaptor_destroy(&(pData->hBlockAdaptor));
+        saf_shEvaluator_destroy(&(pData->hSHEval));
         free(pData);
         pData = NULL;
     }
@@ -75,22 +83,23 @@ void ambi_enc_init
     memset(pData->prev_inputFrameTD, 0, MAX_NUM_INPUTS*FRAME_SIZE*sizeof(float));
     for(i=0; i<MAX_NUM_INPUTS; i++)
         pData->recalc_SH_FLAG[i] = 1;
+    saf_blockAdaptor_reset(pData->hBlockAdaptor);
 }
 
-void ambi_enc_process
+/** Processes one frame of FRAME_SIZE samples (see saf_blockAdaptor_apply()) */
+static void ambi_enc_processFrame
 (
     void  *  const hAmbi,
     float ** const inputs,
     float ** const outputs,
     int            nInputs,
-    int            nOutputs,
-    int            nSamples
+    int            nOutputs
 )
 {
     ambi_enc_data *pData = (ambi_enc_data*)(hAmbi);
-    int i, j, ch, nSources, nSH; 
-    float src_dirs[MAX_NUM_INPUTS][2], azi_incl[2], scale;
-    float* Y_src;
+    int i, j, nSources, nSH, nMoved;
+    int moved_idx[MAX_NUM_INPUTS];
+    float src_dirs[MAX_NUM_INPUTS][2], azi_incl[MAX_NUM_INPUTS][2], scale;
 
     /* local copies of user parameters */
     CH_ORDER chOrdering;
@@ -104,93 +113,118 @@ void ambi_enc_process
     nSH = ORDER2NSH(order);
 
     /* Process frame */
-    if (nSamples == FRAME_SIZE) {
-
-        /* prep */
-        Y_src = malloc1d(nSH*sizeof(float));
-
-        /* Load time-domain data */
-        for(i=0; i < MIN(nSources,nInputs); i++)
-            utility_svvcopy(inputs[i], FRAME_SIZE, pData->inputFrameTD[i]);
-        for(; i<MAX_NUM_INPUTS; i++)
-            memset(pData->inputFrameTD[i], 0, FRAME_SIZE * sizeof(float));
-
-        /* recalulate SHs */
-        for(i=0; i<nSources; i++){
-            if(pData->recalc_SH_FLAG[i]){
-                azi_incl[0] = pData->src_dirs_deg[i][0]*M_PI/180.0f;
-                azi_incl[1] =  M_PI/2.0f - pData->src_dirs_deg[i][1]*M_PI/180.0f;
-                getSHreal_recur(order, azi_incl, 1, Y_src);
-                for(j=0; j<nSH; j++)
-                    pData->Y[j][i] = sqrtf(4.0f*M_PI)*Y_src[j];
-                for(; j<MAX_NUM_SH_SIGNALS; j++)
-                    pData->Y[j][i] = 0.0f;
-                pData->recalc_SH_FLAG[i] = 0;
-            }
-            else{
-                for(j=0; j<MAX_NUM_SH_SIGNALS; j++)
-                    pData->Y[j][i] = pData->prev_Y[j][i];
-            }
+    /* Load time-domain data */
+    for(i=0; i < MIN(nSources,nInputs); i++)
+        utility_svvcopy(inputs[i], FRAME_SIZE, pData->inputFrameTD[i]);
+    for(; i<MAX_NUM_INPUTS; i++)
+        memset(pData->inputFrameTD[i], 0, FRAME_SIZE * sizeof(float));
+
+    /* recalulate SHs (for all sources which moved, in one go) */
+    nMoved = 0;
+    for(i=0; i<nSources; i++){
+        if(pData->recalc_SH_FLAG[i]){
+            azi_incl[nMoved][0] = pData->src_dirs_deg[i][0]*M_PI/180.0f;
+            azi_incl[nMoved][1] =  M_PI/2.0f - pData->src_dirs_deg[i][1]*M_PI/180.0f;
+            moved_idx[nMoved++] = i;
+            pData->recalc_SH_FLAG[i] = 0;
         }
-
-        /* spatially encode the input signals into spherical harmonic signals */
-        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nSH, FRAME_SIZE, nSources, 1.0f,
-                    (float*)pData->prev_Y, MAX_NUM_INPUTS,
-                    (float*)pData->prev_inputFrameTD, FRAME_SIZE, 0.0f,
-                    (float*)pData->tempFrame, FRAME_SIZE);
-        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nSH, FRAME_SIZE, nSources, 1.0f,
-                    (float*)pData->Y, MAX_NUM_INPUTS,
-                    (float*)pData->prev_inputFrameTD, FRAME_SIZE, 0.0f,
-                    (float*)pData->outputFrameTD, FRAME_SIZE);
-
-        for (i=0; i < nSH; i++)
-            for(j=0; j<FRAME_SIZE; j++)
-                pData->outputFrameTD[i][j] = pData->interpolator[j] * pData->outputFrameTD[i][j] + (1.0f-pData->interpolator[j]) * pData->tempFrame[i][j];
-
-        /* for next frame */
-        utility_svvcopy((const float*)pData->inputFrameTD, nSources*FRAME_SIZE, (float*)pData->prev_inputFrameTD);
-        utility_svvcopy((const float*)pData->Y, MAX_NUM_INPUTS*MAX_NUM_SH_SIGNALS, (float*)pData->prev_Y);
-
-        /* scale by 1/sqrt(nSources) */
-        if(pData->enablePostScaling){
-            scale = 1.0f/sqrtf((float)nSources);
-            utility_svsmul((float*)pData->outputFrameTD, &scale, nSH*FRAME_SIZE, (float*)pData->outputFrameTD);
-        }
-
-        /* account for output channel order */
-        switch(chOrdering){
-            case CH_ACN: /* already ACN */
-                break;
-            case CH_FUMA:
-                convertHOAChannelConvention((float*)pData->outputFrameTD, order, FRAME_SIZE, HOA_CH_ORDER_ACN, HOA_CH_ORDER_FUMA);
-                break;
+        else{
+            for(j=0; j<MAX_NUM_SH_SIGNALS; j++)
+                pData->Y[j][i] = pData->prev_Y[j][i];
         }
-
-        /* account for normalisation scheme */
-        switch(norm){
-            case NORM_N3D: /* already N3D */
-                break;
-            case NORM_SN3D:
-                convertHOANormConvention((float*)pData->outputFrameTD, order, FRAME_SIZE, HOA_NORM_N3D, HOA_NORM_SN3D);
-                break;
-            case NORM_FUMA:
-                convertHOANormConvention((float*)pData->outputFrameTD, order, FRAME_SIZE, HOA_NORM_N3D, HOA_NORM_FUMA);
-                break;
+    }
+    if(nMoved>0){
+        saf_shEvaluator_getSHreal(pData->hSHEval, order, (float*)azi_incl, nMoved, pData->Y_src);
+        for(i=0; i<nMoved; i++){
+            for(j=0; j<nSH; j++)
+                pData->Y[j][moved_idx[i]] = sqrtf(4.0f*M_PI)*pData->Y_src[j*nMoved+i];
+            for(; j<MAX_NUM_SH_SIGNALS; j++)
+                pData->Y[j][moved_idx[i]] = 0.0f;
         }
+    }
 
-        /* Copy to output */
-        for(i = 0; i < MIN(nSH,nOutputs); i++)
-            utility_svvcopy(pData->outputFrameTD[i], FRAME_SIZE, outputs[i]);
-        for(; i < nOutputs; i++)
-            memset(outputs[i], 0, FRAME_SIZE * sizeof(float));
+    /* spatially encode the input signals into spherical harmonic signals */
+    cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nSH, FRAME_SIZE, nSources, 1.0f,
+                (float*)pData->prev_Y, MAX_NUM_INPUTS,
+                (float*)pData->prev_inputFrameTD, FRAME_SIZE, 0.0f,
+                (float*)pData->tempFrame, FRAME_SIZE);
+    cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nSH, FRAME_SIZE, nSources, 1.0f,
+                (float*)pData->Y, MAX_NUM_INPUTS,
+                (float*)pData->prev_inputFrameTD, FRAME_SIZE, 0.0f,
+                (float*)pData->outputFrameTD, FRAME_SIZE);
+
+    for (i=0; i < nSH; i++)
+        for(j=0; j<FRAME_SIZE; j++)
+            pData->outputFrameTD[i][j] = pData->interpolator[j] * pData->outputFrameTD[i][j] + (1.0f-pData->interpolator[j]) * pData->tempFrame[i][j];
+
+    /* for next frame */
+    utility_svvcopy((const float*)pData->inputFrameTD, nSources*FRAME_SIZE, (float*)pData->prev_inputFrameTD);
+    utility_svvcopy((const float*)pData->Y, MAX_NUM_INPUTS*MAX_NUM_SH_SIGNALS, (float*)pData->prev_Y);
+
+    /* scale by 1/sqrt(nSources) */
+    if(pData->enablePostScaling){
+        scale = 1.0f/sqrtf((float)nSources);
+        utility_svsmul((float*)pData->outputFrameTD, &scale, nSH*FRAME_SIZE, (float*)pData->outputFrameTD);
+    }
 
-        /* clean-up */
-        free(Y_src);
+    /* account for output channel order */
+    switch(chOrdering){
+        case CH_ACN: /* already ACN */
+            break;
+        case CH_FUMA:
+            convertHOAChannelConvention((float*)pData->outputFrameTD, order, FRAME_SIZE, HOA_CH_ORDER_ACN, HOA_CH_ORDER_FUMA);
+            break;
     }
-    else{
-        for (ch=0; ch < nOutputs; ch++)
-            memset(outputs[ch],0, FRAME_SIZE*sizeof(float));
+
+    /* account for normalisation scheme */
+    switch(norm){
+        case NORM_N3D: /* already N3D */
+            break;
+        case NORM_SN3D:
+            convertHOANormConvention((float*)pData->outputFrameTD, order, FRAME_SIZE, HOA_NORM_N3D, HOA_NORM_SN3D);
+            break;
+        case NORM_FUMA:
+            convertHOANormConvention((float*)pData->outputFrameTD, order, FRAME_SIZE, HOA_NORM_N3D, HOA_NORM_FUMA);
+            break;
     }
+
+    /* Copy to output */
+    for(i = 0; i < MIN(nSH,nOutputs); i++)
+        utility_svvcopy(pData->outputFrameTD[i], FRAME_SIZE, outputs[i]);
+    for(; i < nOutputs; i++)
+        memset(outputs[i], 0, FRAME_SIZE * sizeof(float));
+}
+
+void ambi_enc_process
+(
+    void  *  const hAmbi,
+    float ** const inputs,
+    float ** const outputs,
+    int            nInputs,
+    int            nOutputs,
+    int            nSamples
+)
+{
+    ambi_enc_data *pData = (ambi_enc_data*)(hAmbi);
+
+    saf_blockAdaptor_apply(pData->hBlockAdaptor, inputs, outputs, nInputs, nOutputs,
+                           nSamples, ambi_enc_processFrame, hAmbi);
+}
+
+void ambi_enc_processInterleaved
+(
+    void  *  const hAmbi,
+    const float *  inputs,
+    float *        outputs,
+    int            nInputs,
+    int            nOutputs,
+    int            nSamples
+)
+{
+    ambi_enc_data *pData = (ambi_enc_data*)(hAmbi);
+
+    saf_blockAdaptor_applyStrided(pData->hBlockAdaptor, inputs, 1, nInputs, outputs, 1, nOutputs,
+                                  nInputs, nOutputs, nSamples, ambi_enc_processFrame, hAmbi);
 }
 
 /* Set Functions */
@@ -65,6 +65,9 @@ typedef struct _ambi_enc
     float Y[MAX_NUM_SH_SIGNALS][MAX_NUM_INPUTS];
     float prev_Y[MAX_NUM_SH_SIGNALS][MAX_NUM_INPUTS];
     float interpolator[FRAME_SIZE];
+    void* hBlockAdaptor;
+    void* hSHEval;                                   /**< SH evaluator handle */
+    float Y_src[MAX_NUM_SH_SIGNALS*MAX_NUM_INPUTS];  /**< SHs of the sources which moved; FLAT: nSH x nMoved */
     
     /* user parameters */
     int nSources;
@@ -45,10 +45,26 @@ void array2sh_create
 (
     void ** const phA2sh
 )
+{
+    array2sh_createWithFrameSize(phA2sh, DEFAULT_TF_FRAME_SIZE);
+}
+
+void array2sh_createWithFrameSize
+(
+    void ** const phA2sh,
+    int frameSize
+)
 {
     array2sh_data* pData = (array2sh_data*)malloc1d(sizeof(array2sh_data));
     *phA2sh = (void*)pData;
-    int ch;
+
+    /* frame size (= afSTFT hop size), which is fixed for the lifetime of the instance */
+    pData->frameSize = IS_VALID_TF_FRAME_SIZE(frameSize) ? frameSize : DEFAULT_TF_FRAME_SIZE;
+    pData->hopSize = pData->frameSize;
+    pData->nBands = pData->hopSize + 5;
+    pData->timeSlots = pData->frameSize / pData->hopSize;
+    pData->LDmode = 0;
+    pData->new_LDmode = 0;
      
     /* defualt parameters */
     array2sh_createArray(&(pData->arraySpecs)); 
@@ -64,18 +80,11 @@ void array2sh_create
     
     /* time-frequency transform + buffers */
     pData->hSTFT = NULL;
-    pData->STFTInputFrameTF = (complexVector*)malloc1d(MAX_NUM_SENSORS * sizeof(complexVector));
-    for(ch=0; ch< MAX_NUM_SENSORS; ch++) {
-        pData->STFTInputFrameTF[ch].re = (float*)calloc1d(HYBRID_BANDS, sizeof(float));
-        pData->STFTInputFrameTF[ch].im = (float*)calloc1d(HYBRID_BANDS, sizeof(float));
-    }
-    pData->STFTOutputFrameTF = (complexVector*)malloc1d(MAX_NUM_SH_SIGNALS * sizeof(complexVector));
-    for(ch=0; ch< MAX_NUM_SH_SIGNALS; ch++) {
-        pData->STFTOutputFrameTF[ch].re = (float*)calloc1d(HYBRID_BANDS, sizeof(float));
-        pData->STFTOutputFrameTF[ch].im = (float*)calloc1d(HYBRID_BANDS, sizeof(float));
-    }
-    pData->tempHopFrameTD_in = (float**)malloc2d( MAX(MAX_NUM_SH_SIGNALS, MAX_NUM_SENSORS), HOP_SIZE, sizeof(float));
-    pData->tempHopFrameTD_out = (float**)malloc2d( MAX(MAX_NUM_SH_SIGNALS, MAX_NUM_SENSORS), HOP_SIZE, sizeof(float));
+    pData->inputFrameTD = (float**)malloc2d(MAX_NUM_SENSORS, pData->frameSize, sizeof(float));
+    pData->SHframeTD = (float**)malloc2d(MAX_NUM_SH_SIGNALS, pData->frameSize, sizeof(float));
+    pData->inputframeTF = (float_complex***)malloc3d(pData->nBands, MAX_NUM_SENSORS, pData->timeSlots, sizeof(float_complex));
+    pData->SHframeTF = (float_complex***)malloc3d(pData->nBands, MAX_NUM_SH_SIGNALS, pData->timeSlots, sizeof(float_complex));
+    pData->freqVector = calloc1d(pData->nBands, sizeof(float));
     
     /* internal */
     pData->progressBar0_1 = 0.0f;
@@ -86,12 +95,19 @@ void array2sh_create
     pData->reinitSHTmatrixFLAG = 1;
     pData->new_order = pData->order;
     pData->bN = NULL;
+    pData->bN_modal = (double_complex**)malloc2d(pData->nBands, MAX_SH_ORDER + 1, sizeof(double_complex));
+    pData->bN_inv = (double_complex**)malloc2d(pData->nBands, MAX_SH_ORDER + 1, sizeof(double_complex));
+    pData->bN_inv_R = (double_complex**)malloc2d(pData->nBands, MAX_NUM_SH_SIGNALS, sizeof(double_complex));
+    pData->W = (float_complex***)calloc3d(pData->nBands, MAX_NUM_SH_SIGNALS, MAX_NUM_SENSORS, sizeof(float_complex));
     
     /* display related stuff */
-    pData->bN_modal_dB = (float**)malloc2d(HYBRID_BANDS, MAX_SH_ORDER + 1, sizeof(float));
-    pData->bN_inv_dB = (float**)malloc2d(HYBRID_BANDS, MAX_SH_ORDER + 1, sizeof(float));
-    pData->cSH = (float*)calloc1d((HYBRID_BANDS)*(MAX_SH_ORDER + 1),sizeof(float));
-    pData->lSH = (float*)calloc1d((HYBRID_BANDS)*(MAX_SH_ORDER + 1),sizeof(float));
+    pData->bN_modal_dB = (float**)malloc2d(pData->nBands, MAX_SH_ORDER + 1, sizeof(float));
+    pData->bN_inv_dB = (float**)malloc2d(pData->nBands, MAX_SH_ORDER + 1, sizeof(float));
+    pData->cSH = (float*)calloc1d((pData->nBands)*(MAX_SH_ORDER + 1),sizeof(float));
+    pData->lSH = (float*)calloc1d((pData->nBands)*(MAX_SH_ORDER + 1),sizeof(float));
+
+    /* block-size adaptor */
+    saf_blockAdaptor_create(&(pData->hBlockAdaptor), pData->frameSize, MAX_NUM_SENSORS, MAX_NUM_SH_SIGNALS);
 }
 
 void array2sh_destroy
@@ -100,30 +116,30 @@ void array2sh_destroy
 )
 {
     array2sh_data *pData = (array2sh_data*)(*phM2sh);
-    int ch;
 
     if (pData != NULL) {
+        saf_blockAdaptor_destroy(&(pData->hBlockAdaptor));
         /* not safe to free memory during evaluation */
-        while (pData->evalStatus == EVAL_STATUS_EVALUATING)
+        while (saf_atomic_loadInt(&(pData->evalStatus)) == EVAL_STATUS_EVALUATING)
             SAF_SLEEP(10);
         
         /* free afSTFT and buffers */
         if (pData->hSTFT != NULL)
             afSTFTfree(pData->hSTFT);
-        for (ch = 0; ch< MAX_NUM_SENSORS; ch++) {
-            free(pData->STFTInputFrameTF[ch].re);
-            free(pData->STFTInputFrameTF[ch].im);
-        }
-        for(ch=0; ch< MAX_NUM_SH_SIGNALS; ch++) {
-            free(pData->STFTOutputFrameTF[ch].re);
-            free(pData->STFTOutputFrameTF[ch].im);
-        }
-        free(pData->STFTOutputFrameTF);
-        free(pData->STFTInputFrameTF);
-        free(pData->tempHopFrameTD_in);
-        free(pData->tempHopFrameTD_out);
+        free(pData->inputFrameTD);
+        free(pData->SHframeTD);
+        free(pData->inputframeTF);
+        free(pData->SHframeTF);
+        free(pData->freqVector);
         array2sh_destroyArray(&(pData->arraySpecs));
         
+        /* intermediates */
+        free(pData->bN);
+        free(pData->bN_modal);
+        free(pData->bN_inv);
+        free(pData->bN_inv_R);
+        free(pData->W);
+        
         /* Display stuff */
         free((void**)pData->bN_modal_dB);
         free((void**)pData->bN_inv_dB);
@@ -142,16 +158,11 @@ void array2sh_init
 )
 {
     array2sh_data *pData = (array2sh_data*)(hA2sh);
-    int band;
     
     pData->fs = sampleRate;
-    for(band=0; band <HYBRID_BANDS; band++){
-        if(sampleRate==44100)
-            pData->freqVector[band] =  (float)__afCenterFreq44100[band];
-        else /* assume 48e3 */
-            pData->freqVector[band] =  (float)__afCenterFreq48e3[band];
-    } 
+    afSTFTgetCenterFreqs(pData->hopSize, 1, (float)sampleRate, pData->freqVector);
     pData->freqVector[0] = pData->freqVector[1]/4.0f; /* avoids NaNs at DC */
+    saf_blockAdaptor_reset(pData->hBlockAdaptor);
 }
 
 void array2sh_evalEncoder
@@ -161,37 +172,39 @@ void array2sh_evalEncoder
 {
     array2sh_data *pData = (array2sh_data*)(hA2sh);
     
-    if (pData->evalStatus != EVAL_STATUS_NOT_EVALUATED)
-        return; /* eval not required */
+    if (!saf_atomic_compareExchangeInt(&(pData->evalStatus), EVAL_STATUS_NOT_EVALUATED, EVAL_STATUS_EVALUATING))
+        return; /* eval not required, or already happening */
     
     /* for progress bar */
-    pData->evalStatus = EVAL_STATUS_EVALUATING;
     strcpy(pData->progressBarText,"Initialising evaluation");
     pData->progressBar0_1 = 0.0f;
     
     /* Evaluate Encoder */
     array2sh_evaluateSHTfilters(hA2sh);
     
-    /* done! */
+    /* done! (unless the encoder changed in the meantime, in which case the
+     * status remains EVAL_STATUS_NOT_EVALUATED) */
     strcpy(pData->progressBarText,"Done!");
     pData->progressBar0_1 = 1.0f; 
-    pData->evalStatus = EVAL_STATUS_RECENTLY_EVALUATED;
+    saf_atomic_compareExchangeInt(&(pData->evalStatus), EVAL_STATUS_EVALUATING, EVAL_STATUS_RECENTLY_EVALUATED);
 }
 
-void array2sh_process
+/** Processes one frame of frameSize samples (see saf_blockAdaptor_apply()) */
+static void array2sh_processFrame
 (
     void  *  const hA2sh,
     float ** const inputs,
     float ** const outputs,
     int            nInputs,
-    int            nOutputs,
-    int            nSamples
+    int            nOutputs
 )
 {
     array2sh_data *pData = (array2sh_data*)(hA2sh);
     array2sh_arrayPars* arraySpecs = (array2sh_arrayPars*)(pData->arraySpecs);
-    int t, ch, i, band, Q, order, nSH; 
-    const float_complex calpha = cmplxf(1.0f,0.0f), cbeta = cmplxf(0.0f, 0.0f);
+    int ch, i, band, Q, order, nSH, frameSize, nBands, timeSlots, convertOutputs; 
+    const float_complex cbeta = cmplxf(0.0f, 0.0f);
+    float_complex cgain;
+    float* inPtrs[MAX_NUM_SENSORS], *outPtrs[MAX_NUM_SH_SIGNALS];
     CH_ORDER chOrdering;
     NORM_TYPES norm;
     float gain_lin;
@@ -213,54 +226,48 @@ void array2sh_process
     Q = arraySpecs->Q;
     order = pData->order;
     nSH = (order+1)*(order+1);
+    frameSize = pData->frameSize;
+    nBands = pData->nBands;
+    timeSlots = pData->timeSlots;
 
     /* processing loop */
-    if ((nSamples == FRAME_SIZE) && (pData->reinitSHTmatrixFLAG==0) ) {
-        pData->procStatus = PROC_STATUS_ONGOING;
-
-        /* Load time-domain data */
-        for(i=0; i < nInputs; i++)
-            utility_svvcopy(inputs[i], FRAME_SIZE, pData->inputFrameTD[i]);
-        for(; i<Q; i++)
-            memset(pData->inputFrameTD[i], 0, FRAME_SIZE * sizeof(float));
-
-        /* Apply time-frequency transform (TFT) */
-        for(t=0; t< TIME_SLOTS; t++) {
-            for(ch = 0; ch < Q; ch++)
-                utility_svvcopy(&(pData->inputFrameTD[ch][t*HOP_SIZE]), HOP_SIZE, pData->tempHopFrameTD_in[ch]);
-            afSTFTforward(pData->hSTFT, pData->tempHopFrameTD_in, pData->STFTInputFrameTF);
-            for(band=0; band<HYBRID_BANDS; band++)
-                for(ch=0; ch < Q; ch++)
-                    pData->inputframeTF[band][ch][t] = cmplxf(pData->STFTInputFrameTF[ch].re[band], pData->STFTInputFrameTF[ch].im[band]);
+    if (pData->reinitSHTmatrixFLAG==0) {
+
+        /* Load time-domain data (the host frames are transformed directly) */
+        for(i=0; i < MIN(Q, nInputs); i++)
+            inPtrs[i] = inputs[i];
+        for(; i<Q; i++){
+            memset(pData->inputFrameTD[i], 0, frameSize * sizeof(float));
+            inPtrs[i] = pData->inputFrameTD[i];
         }
 
-        /* Apply spherical harmonic transform (SHT) */
-        for(band=0; band<HYBRID_BANDS; band++){
-            cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nSH, TIME_SLOTS, Q, &calpha,
-                        pData->W[band], MAX_NUM_SENSORS,
-                        pData->inputframeTF[band], TIME_SLOTS, &cbeta,
-                        pData->SHframeTF[band], TIME_SLOTS);
+        /* Apply time-frequency transform (TFT) */
+        afSTFTforwardFrame(pData->hSTFT, inPtrs, frameSize, MAX_NUM_SENSORS,
+                           AFSTFT_BANDS_CH_TIME, FLATTEN3D(pData->inputframeTF));
+
+        /* Apply spherical harmonic transform (SHT), and the post-gain */
+        cgain = cmplxf(gain_lin, 0.0f);
+        for(band=0; band<nBands; band++){
+            cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nSH, timeSlots, Q, &cgain,
+                        FLATTEN2D(pData->W[band]), MAX_NUM_SENSORS,
+                        FLATTEN2D(pData->inputframeTF[band]), timeSlots, &cbeta,
+                        FLATTEN2D(pData->SHframeTF[band]), timeSlots);
         }
 
-        /* inverse-TFT */
-        for(t = 0; t < TIME_SLOTS; t++) {
-            for(band = 0; band < HYBRID_BANDS; band++) {
-                for (ch = 0; ch < nSH; ch++) {
-                    pData->STFTOutputFrameTF[ch].re[band] = gain_lin*crealf(pData->SHframeTF[band][ch][t]);
-                    pData->STFTOutputFrameTF[ch].im[band] = gain_lin*cimagf(pData->SHframeTF[band][ch][t]);
-                }
-            }
-            afSTFTinverse(pData->hSTFT, pData->STFTOutputFrameTF, pData->tempHopFrameTD_out);
-            for (ch = 0; ch < nSH; ch++)
-                utility_svvcopy(pData->tempHopFrameTD_out[ch], HOP_SIZE, &(pData->SHframeTD[ch][t* HOP_SIZE]));
-        }
+        /* inverse-TFT; directly into the host frames (as the inputs have
+         * already been read), unless they must be converted from ACN/N3D */
+        convertOutputs = chOrdering!=CH_ACN || norm!=NORM_N3D;
+        for(i = 0; i < nSH; i++)
+            outPtrs[i] = !convertOutputs && i < nOutputs ? outputs[i] : pData->SHframeTD[i];
+        afSTFTinverseFrame(pData->hSTFT, FLATTEN3D(pData->SHframeTF), frameSize, MAX_NUM_SH_SIGNALS,
+                           AFSTFT_BANDS_CH_TIME, outPtrs);
 
         /* account for output channel order */
         switch(chOrdering){
             case CH_ACN: /* already ACN */
                 break;
             case CH_FUMA:
-                convertHOAChannelConvention((float*)pData->SHframeTD, order, FRAME_SIZE, HOA_CH_ORDER_ACN, HOA_CH_ORDER_FUMA);
+                convertHOAChannelConvention(FLATTEN2D(pData->SHframeTD), order, frameSize, HOA_CH_ORDER_ACN, HOA_CH_ORDER_FUMA);
                 break;
         }
 
@@ -269,25 +276,55 @@ void array2sh_process
             case NORM_N3D: /* already N3D */
                 break;
             case NORM_SN3D:
-                convertHOANormConvention((float*)pData->SHframeTD, order, FRAME_SIZE, HOA_NORM_N3D, HOA_NORM_SN3D);
+                convertHOANormConvention(FLATTEN2D(pData->SHframeTD), order, frameSize, HOA_NORM_N3D, HOA_NORM_SN3D);
                 break;
             case NORM_FUMA:
-                convertHOANormConvention((float*)pData->SHframeTD, order, FRAME_SIZE, HOA_NORM_N3D, HOA_NORM_FUMA);
+                convertHOANormConvention(FLATTEN2D(pData->SHframeTD), order, frameSize, HOA_NORM_N3D, HOA_NORM_FUMA);
                 break;
         }
 
         /* Copy to output */
-        for(i = 0; i < MIN(nSH,nOutputs); i++)
-            utility_svvcopy(pData->SHframeTD[i], FRAME_SIZE, outputs[i]);
-        for(; i < nOutputs; i++)
-            memset(outputs[i], 0, FRAME_SIZE * sizeof(float));
+        for(i = 0; convertOutputs && i < MIN(nSH,nOutputs); i++)
+            utility_svvcopy(pData->SHframeTD[i], frameSize, outputs[i]);
+        for(i = nSH; i < nOutputs; i++)
+            memset(outputs[i], 0, frameSize * sizeof(float));
     }
     else{
         for (ch=0; ch < nOutputs; ch++)
-            memset(outputs[ch],0, FRAME_SIZE*sizeof(float));
+            memset(outputs[ch],0, frameSize*sizeof(float));
     }
+}
+
+void array2sh_process
+(
+    void  *  const hA2sh,
+    float ** const inputs,
+    float ** const outputs,
+    int            nInputs,
+    int            nOutputs,
+    int            nSamples
+)
+{
+    array2sh_data *pData = (array2sh_data*)(hA2sh);
+
+    saf_blockAdaptor_apply(pData->hBlockAdaptor, inputs, outputs, nInputs, nOutputs,
+                           nSamples, array2sh_processFrame, hA2sh);
+}
+
+void array2sh_processInterleaved
+(
+    void  *  const hA2sh,
+    const float *  inputs,
+    float *        outputs,
+    int            nInputs,
+    int            nOutputs,
+    int            nSamples
+)
+{
+    array2sh_data *pData = (array2sh_data*)(hA2sh);
 
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
+    saf_blockAdaptor_applyStrided(pData->hBlockAdaptor, inputs, 1, nInputs, outputs, 1, nOutputs,
+                                  nInputs, nOutputs, nSamples, array2sh_processFrame, hA2sh);
 }
 
 /* Set Functions */
@@ -324,12 +361,7 @@ void array2sh_setRequestEncoderEvalFLAG(void* const hA2sh, int newState)
 void array2sh_setEvalStatus(void* const hA2sh, ARRAY2SH_EVAL_STATUS new_evalStatus)
 {
     array2sh_data *pData = (array2sh_data*)(hA2sh);
-    if(new_evalStatus==EVAL_STATUS_NOT_EVALUATED){
-        /* Pause until current initialisation is complete */
-        while(pData->evalStatus == EVAL_STATUS_EVALUATING)
-            SAF_SLEEP(10);
-    }
-    pData->evalStatus = new_evalStatus;
+    saf_atomic_storeInt(&(pData->evalStatus), (int)new_evalStatus);
 }
 
 void array2sh_setDiffEQpastAliasing(void* const hA2sh, int newState)
@@ -528,18 +560,30 @@ void array2sh_setGain(void* const hA2sh, float newGain)
     pData->gain_dB = CLAMP(newGain, ARRAY2SH_POST_GAIN_MIN_VALUE, ARRAY2SH_POST_GAIN_MAX_VALUE);
 }
 
+void array2sh_setLowDelayMode(void* const hA2sh, int newState)
+{
+    array2sh_data *pData = (array2sh_data*)(hA2sh);
+    pData->new_LDmode = newState ? 1 : 0;
+}
+
 
 /* Get Functions */
 
 int array2sh_getFrameSize(void)
 {
-    return FRAME_SIZE;
+    return DEFAULT_TF_FRAME_SIZE;
+}
+
+int array2sh_getFrameSizeEx(void* const hA2sh)
+{
+    array2sh_data *pData = (array2sh_data*)(hA2sh);
+    return pData->frameSize;
 }
 
 ARRAY2SH_EVAL_STATUS array2sh_getEvalStatus(void* const hA2sh)
 {
     array2sh_data *pData = (array2sh_data*)(hA2sh);
-    return pData->evalStatus;
+    return (ARRAY2SH_EVAL_STATUS)saf_atomic_loadInt(&(pData->evalStatus));
 }
 
 float array2sh_getProgressBar0_1(void* const hA2sh)
@@ -692,7 +736,7 @@ float array2sh_getGain(void* const hA2sh)
 float* array2sh_getFreqVector(void* const hA2sh, int* nFreqPoints)
 {
     array2sh_data *pData = (array2sh_data*)(hA2sh);
-    (*nFreqPoints) = HYBRID_BANDS;
+    (*nFreqPoints) = pData->nBands;
     return &(pData->freqVector[0]);
 }
 
@@ -700,7 +744,7 @@ float** array2sh_getbN_inv(void* const hA2sh, int* nCurves, int* nFreqPoints)
 {
     array2sh_data *pData = (array2sh_data*)(hA2sh);
     (*nCurves) = pData->order+1;
-    (*nFreqPoints) = HYBRID_BANDS;
+    (*nFreqPoints) = pData->nBands;
     return pData->bN_inv_dB;
 }
 
@@ -708,7 +752,7 @@ float** array2sh_getbN_modal(void* const hA2sh, int* nCurves, int* nFreqPoints)
 {
     array2sh_data *pData = (array2sh_data*)(hA2sh);
     (*nCurves) = pData->order+1;
-    (*nFreqPoints) = HYBRID_BANDS;
+    (*nFreqPoints) = pData->nBands;
     return pData->bN_modal_dB;
 }
 
@@ -716,7 +760,7 @@ float* array2sh_getSpatialCorrelation_Handle(void* const hA2sh, int* nCurves, in
 {
     array2sh_data *pData = (array2sh_data*)(hA2sh);
     (*nCurves) = pData->order+1;
-    (*nFreqPoints) = HYBRID_BANDS;
+    (*nFreqPoints) = pData->nBands;
     return pData->cSH;
 }
 
@@ -724,7 +768,7 @@ float* array2sh_getLevelDifference_Handle(void* const hA2sh, int* nCurves, int*
 {
     array2sh_data *pData = (array2sh_data*)(hA2sh);
     (*nCurves) = pData->order+1;
-    (*nFreqPoints) = HYBRID_BANDS;
+    (*nFreqPoints) = pData->nBands;
     return pData->lSH;
 }
 
@@ -734,7 +778,19 @@ int array2sh_getSamplingRate(void* const hA2sh)
     return pData->fs;
 }
 
-int array2sh_getProcessingDelay()
+int array2sh_getLowDelayMode(void* const hA2sh)
 {
-    return 12*HOP_SIZE;
+    array2sh_data *pData = (array2sh_data*)(hA2sh);
+    return pData->new_LDmode;
+}
+
+int array2sh_getProcessingDelay(void)
+{
+    return afSTFTgetProcessingDelay(DEFAULT_TF_FRAME_SIZE, 0, 1);
+}
+
+int array2sh_getProcessingDelayEx(void* const hA2sh)
+{
+    array2sh_data *pData = (array2sh_data*)(hA2sh);
+    return afSTFTgetProcessingDelay(pData->hopSize, pData->LDmode, 1) + saf_blockAdaptor_getDelay(pData->hBlockAdaptor);
 }
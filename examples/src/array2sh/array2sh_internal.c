@@ -53,7 +53,7 @@ static void array2sh_replicate_order
     
     for(n=0; n<order+2; n++)
         o[n] = n*n;
-    for(band=0; band<HYBRID_BANDS; band++)
+    for(band=0; band<pData->nBands; band++)
         for(n=0; n < order+1; n++)
             for(i=o[n]; i < o[n+1]; i++)
                 pData->bN_inv_R[band][i] = pData->bN_inv[band][n];
@@ -70,8 +70,13 @@ void array2sh_initTFT
     
     new_nSH = (pData->new_order+1)*(pData->new_order+1);
     nSH = (pData->order+1)*(pData->order+1);
+    if(pData->hSTFT!=NULL && pData->LDmode!=pData->new_LDmode){
+        afSTFTfree(pData->hSTFT); /* the low-delay mode may only be set upon initialisation */
+        pData->hSTFT = NULL;
+    }
+    pData->LDmode = pData->new_LDmode;
     if(pData->hSTFT==NULL)
-        afSTFTinit(&(pData->hSTFT), HOP_SIZE, arraySpecs->newQ, new_nSH, 0, 1);
+        afSTFTinit(&(pData->hSTFT), pData->hopSize, arraySpecs->newQ, new_nSH, pData->LDmode, 1);
     else if(arraySpecs->newQ != arraySpecs->Q || nSH != new_nSH){
         afSTFTchannelChange(pData->hSTFT, arraySpecs->newQ, new_nSH);
         afSTFTclearBuffers(pData->hSTFT); 
@@ -87,9 +92,9 @@ void array2sh_calculate_sht_matrix
 {
     array2sh_data *pData = (array2sh_data*)(hA2sh);
     array2sh_arrayPars* arraySpecs = (array2sh_arrayPars*)(pData->arraySpecs);
-    int i, j, band, n, order, nSH;
+    int i, j, band, n, order, nSH, nBands;
     double alpha, beta, g_lim, regPar;
-    double kr[HYBRID_BANDS], kR[HYBRID_BANDS];
+    double* kr, *kR;
     float* Y_mic, *pinv_Y_mic;
     float_complex* pinv_Y_mic_cmplx, *diag_bN_inv_R;
     const float_complex calpha = cmplxf(1.0f, 0.0f); const float_complex cbeta  = cmplxf(0.0f, 0.0f);
@@ -97,8 +102,11 @@ void array2sh_calculate_sht_matrix
     /* prep */
     order = pData->new_order;
     nSH = (order+1)*(order+1);
+    nBands = pData->nBands;
+    kr = malloc1d(nBands*sizeof(double));
+    kR = malloc1d(nBands*sizeof(double));
     arraySpecs->R = MIN(arraySpecs->R, arraySpecs->r);
-    for(band=0; band<HYBRID_BANDS; band++){
+    for(band=0; band<nBands; band++){
         kr[band] = 2.0*M_PI*(pData->freqVector[band])*(arraySpecs->r)/pData->c;
         kR[band] = 2.0*M_PI*(pData->freqVector[band])*(arraySpecs->R)/pData->c;
     }
@@ -118,51 +126,51 @@ void array2sh_calculate_sht_matrix
     if ( (pData->filterType==FILTER_SOFT_LIM) || (pData->filterType==FILTER_TIKHONOV) ){
         /* Compute modal responses */
         free(pData->bN);
-        pData->bN = malloc1d((HYBRID_BANDS)*(order+1)*sizeof(double_complex));
+        pData->bN = malloc1d(nBands*(order+1)*sizeof(double_complex));
         switch(arraySpecs->arrayType){
             case ARRAY_CYLINDRICAL:
                 switch (arraySpecs->weightType){
-                    case WEIGHT_RIGID_OMNI:   cylModalCoeffs(order, kr, HYBRID_BANDS, ARRAY_CONSTRUCTION_RIGID, pData->bN); break;
+                    case WEIGHT_RIGID_OMNI:   cylModalCoeffs(order, kr, nBands, ARRAY_CONSTRUCTION_RIGID, pData->bN); break;
                     case WEIGHT_RIGID_CARD:   /* not supported */ break;
                     case WEIGHT_RIGID_DIPOLE: /* not supported */ break;
-                    case WEIGHT_OPEN_OMNI:    cylModalCoeffs(order, kr, HYBRID_BANDS, ARRAY_CONSTRUCTION_OPEN, pData->bN);  break;
+                    case WEIGHT_OPEN_OMNI:    cylModalCoeffs(order, kr, nBands, ARRAY_CONSTRUCTION_OPEN, pData->bN);  break;
                     case WEIGHT_OPEN_CARD:    /* not supported */ break;
                     case WEIGHT_OPEN_DIPOLE:  /* not supported */ break;
                 }
                 break;
             case ARRAY_SPHERICAL:
                 switch (arraySpecs->weightType){
-                    case WEIGHT_OPEN_OMNI:   sphModalCoeffs(order, kr, HYBRID_BANDS, ARRAY_CONSTRUCTION_OPEN, 1.0, pData->bN); break;
-                    case WEIGHT_OPEN_CARD:   sphModalCoeffs(order, kr, HYBRID_BANDS, ARRAY_CONSTRUCTION_OPEN_DIRECTIONAL, 0.5, pData->bN); break;
-                    case WEIGHT_OPEN_DIPOLE: sphModalCoeffs(order, kr, HYBRID_BANDS, ARRAY_CONSTRUCTION_OPEN_DIRECTIONAL, 0.0, pData->bN); break;
+                    case WEIGHT_OPEN_OMNI:   sphModalCoeffs(order, kr, nBands, ARRAY_CONSTRUCTION_OPEN, 1.0, pData->bN); break;
+                    case WEIGHT_OPEN_CARD:   sphModalCoeffs(order, kr, nBands, ARRAY_CONSTRUCTION_OPEN_DIRECTIONAL, 0.5, pData->bN); break;
+                    case WEIGHT_OPEN_DIPOLE: sphModalCoeffs(order, kr, nBands, ARRAY_CONSTRUCTION_OPEN_DIRECTIONAL, 0.0, pData->bN); break;
                     case WEIGHT_RIGID_OMNI:
                     case WEIGHT_RIGID_CARD:
                     case WEIGHT_RIGID_DIPOLE:
                         /* if sensors are flushed with the rigid baffle: */
                         if(arraySpecs->R == arraySpecs->r )
-                            sphModalCoeffs(order, kr, HYBRID_BANDS, ARRAY_CONSTRUCTION_RIGID, 1.0, pData->bN);
+                            sphModalCoeffs(order, kr, nBands, ARRAY_CONSTRUCTION_RIGID, 1.0, pData->bN);
 
                         /* if sensors protrude from the rigid baffle: */
                         else{
                             if (arraySpecs->weightType == WEIGHT_RIGID_OMNI)
-                                sphScattererModalCoeffs(order, kr, kR, HYBRID_BANDS, pData->bN);
+                                sphScattererModalCoeffs(order, kr, kR, nBands, pData->bN);
                             else if (arraySpecs->weightType == WEIGHT_RIGID_CARD)
-                                sphScattererDirModalCoeffs(order, kr, kR, HYBRID_BANDS, 0.5, pData->bN);
+                                sphScattererDirModalCoeffs(order, kr, kR, nBands, 0.5, pData->bN);
                             else if (arraySpecs->weightType == WEIGHT_RIGID_DIPOLE)
-                                sphScattererDirModalCoeffs(order, kr, kR, HYBRID_BANDS, 0.0, pData->bN);
+                                sphScattererDirModalCoeffs(order, kr, kR, nBands, 0.0, pData->bN);
                         }
                         break;
                 }
                 break;
         }
         
-        for(band=0; band<HYBRID_BANDS; band++)
+        for(band=0; band<nBands; band++)
             for(n=0; n < order+1; n++)
                 pData->bN[band*(order+1)+n] = ccdiv(pData->bN[band*(order+1)+n], cmplx(4.0*M_PI, 0.0f)); /* 4pi term */
 
         /* direct inverse */
         regPar = pData->regPar;
-        for(band=0; band<HYBRID_BANDS; band++)
+        for(band=0; band<nBands; band++)
             for(n=0; n < order+1; n++)
                 pData->bN_modal[band][n] = ccdiv(cmplx(1.0,0.0), (pData->bN[band*(order+1)+n]));
         
@@ -172,7 +180,7 @@ void array2sh_calculate_sht_matrix
              modalen amplitudenverst?rkung bei sph?rischen mikrofonarrays im plane wave decomposition verfahren.
              Proceedings of the 37. Deutsche Jahrestagung fur Akustik (DAGA 2011) */
             g_lim = sqrt(arraySpecs->Q)*pow(10.0,(regPar/20.0));
-            for(band=0; band<HYBRID_BANDS; band++)
+            for(band=0; band<nBands; band++)
                 for(n=0; n < order+1; n++)
                     pData->bN_inv[band][n] = crmul(pData->bN_modal[band][n], (2.0*g_lim*cabs(pData->bN[band*(order+1)+n]) / M_PI)
                                                      * atan(M_PI / (2.0*g_lim*cabs(pData->bN[band*(order+1)+n]))) );
@@ -181,7 +189,7 @@ void array2sh_calculate_sht_matrix
             /* Moreau, S., Daniel, J., Bertet, S., 2006, 3D sound field recording with higher order ambisonics-objective
              measurements and validation of spherical microphone. In Audio Engineering Society Convention 120. */
             alpha = sqrt(arraySpecs->Q)*pow(10.0,(regPar/20.0));
-            for(band=0; band<HYBRID_BANDS; band++){
+            for(band=0; band<nBands; band++){
                 for(n=0; n < order+1; n++){
                     beta = sqrt((1.0-sqrt(1.0-1.0/ pow(alpha,2.0)))/(1.0+sqrt(1.0-1.0/pow(alpha,2.0))));
                     pData->bN_inv[band][n] = ccdiv(conj(pData->bN[band*(order+1)+n]), cmplx((pow(cabs(pData->bN[band*(order+1)+n]), 2.0) + pow(beta, 2.0)),0.0));
@@ -193,13 +201,13 @@ void array2sh_calculate_sht_matrix
         array2sh_replicate_order(hA2sh, order); /* replicate orders */
         
         diag_bN_inv_R = calloc1d(nSH*nSH, sizeof(float_complex));
-        for(band=0; band<HYBRID_BANDS; band++){
+        for(band=0; band<nBands; band++){
             for(i=0; i<nSH; i++)
                 diag_bN_inv_R[i*nSH+i] = cmplxf((float)creal(pData->bN_inv_R[band][i]), (float)cimag(pData->bN_inv_R[band][i]));
             cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasTrans, nSH, (arraySpecs->Q), nSH, &calpha,
                         diag_bN_inv_R, nSH,
                         pinv_Y_mic_cmplx, nSH, &cbeta,
-                        pData->W[band], MAX_NUM_SENSORS);
+                        FLATTEN2D(pData->W[band]), MAX_NUM_SENSORS);
         }
         free(diag_bN_inv_R);
     }
@@ -211,8 +219,10 @@ void array2sh_calculate_sht_matrix
         /* Zotter, F. A Linear-Phase Filter-Bank Approach to Process Rigid Spherical Microphone Array Recordings. */
         double normH;
         float f_lim[MAX_SH_ORDER+1];
-        double H[HYBRID_BANDS][MAX_SH_ORDER+1];
-        double_complex Hs[HYBRID_BANDS][MAX_SH_ORDER+1];
+        double** H, **H_np;
+        double_complex** Hs;
+        H = (double**)malloc2d(nBands, MAX_SH_ORDER+1, sizeof(double));
+        Hs = (double_complex**)malloc2d(nBands, MAX_SH_ORDER+1, sizeof(double_complex));
         
         /* find suitable cut-off frequencies */
         switch (arraySpecs->weightType){
@@ -227,7 +237,7 @@ void array2sh_calculate_sht_matrix
         }
         
         /* design prototype filterbank */
-        for(band=0; band<HYBRID_BANDS; band++){
+        for(band=0; band<nBands; band++){
             normH = 0.0;
             for (n=0; n<order+1; n++){
                 if (n==0)
@@ -248,38 +258,38 @@ void array2sh_calculate_sht_matrix
                 
         /* compute inverse radial response */ 
         free(pData->bN);
-        pData->bN = malloc1d((HYBRID_BANDS)*(order+1)*sizeof(double_complex));
+        pData->bN = malloc1d(nBands*(order+1)*sizeof(double_complex));
         switch(arraySpecs->arrayType){
             case ARRAY_CYLINDRICAL:
                 switch (arraySpecs->weightType){
-                    case WEIGHT_RIGID_OMNI:   cylModalCoeffs(order, kr, HYBRID_BANDS, ARRAY_CONSTRUCTION_RIGID, pData->bN); break;
+                    case WEIGHT_RIGID_OMNI:   cylModalCoeffs(order, kr, nBands, ARRAY_CONSTRUCTION_RIGID, pData->bN); break;
                     case WEIGHT_RIGID_CARD:   /* not supported */ break;
                     case WEIGHT_RIGID_DIPOLE: /* not supported */ break;
-                    case WEIGHT_OPEN_OMNI:    cylModalCoeffs(order, kr, HYBRID_BANDS, ARRAY_CONSTRUCTION_OPEN, pData->bN);  break;
+                    case WEIGHT_OPEN_OMNI:    cylModalCoeffs(order, kr, nBands, ARRAY_CONSTRUCTION_OPEN, pData->bN);  break;
                     case WEIGHT_OPEN_CARD:    /* not supported */ break;
                     case WEIGHT_OPEN_DIPOLE:  /* not supported */ break;
                 }
                 break;
             case ARRAY_SPHERICAL:
                 switch (arraySpecs->weightType){
-                    case WEIGHT_OPEN_OMNI:   sphModalCoeffs(order, kr, HYBRID_BANDS, ARRAY_CONSTRUCTION_OPEN, 1.0, pData->bN); break;
-                    case WEIGHT_OPEN_CARD:   sphModalCoeffs(order, kr, HYBRID_BANDS, ARRAY_CONSTRUCTION_OPEN_DIRECTIONAL, 0.5, pData->bN); break;
-                    case WEIGHT_OPEN_DIPOLE: sphModalCoeffs(order, kr, HYBRID_BANDS, ARRAY_CONSTRUCTION_OPEN_DIRECTIONAL, 0.0, pData->bN); break;
+                    case WEIGHT_OPEN_OMNI:   sphModalCoeffs(order, kr, nBands, ARRAY_CONSTRUCTION_OPEN, 1.0, pData->bN); break;
+                    case WEIGHT_OPEN_CARD:   sphModalCoeffs(order, kr, nBands, ARRAY_CONSTRUCTION_OPEN_DIRECTIONAL, 0.5, pData->bN); break;
+                    case WEIGHT_OPEN_DIPOLE: sphModalCoeffs(order, kr, nBands, ARRAY_CONSTRUCTION_OPEN_DIRECTIONAL, 0.0, pData->bN); break;
                     case WEIGHT_RIGID_OMNI:
                     case WEIGHT_RIGID_CARD:
                     case WEIGHT_RIGID_DIPOLE:
                         /* if sensors are flushed with the rigid baffle: */
                         if(arraySpecs->R == arraySpecs->r )
-                            sphModalCoeffs(order, kr, HYBRID_BANDS, ARRAY_CONSTRUCTION_RIGID, 1.0, pData->bN);
+                            sphModalCoeffs(order, kr, nBands, ARRAY_CONSTRUCTION_RIGID, 1.0, pData->bN);
                         
                         /* if sensors protrude from the rigid baffle: */
                         else{
                             if (arraySpecs->weightType == WEIGHT_RIGID_OMNI)
-                                sphScattererModalCoeffs(order, kr, kR, HYBRID_BANDS, pData->bN);
+                                sphScattererModalCoeffs(order, kr, kR, nBands, pData->bN);
                             else if (arraySpecs->weightType == WEIGHT_RIGID_CARD)
-                                sphScattererDirModalCoeffs(order, kr, kR, HYBRID_BANDS, 0.5, pData->bN);
+                                sphScattererDirModalCoeffs(order, kr, kR, nBands, 0.5, pData->bN);
                             else if (arraySpecs->weightType == WEIGHT_RIGID_DIPOLE)
-                                sphScattererDirModalCoeffs(order, kr, kR, HYBRID_BANDS, 0.0, pData->bN);
+                                sphScattererDirModalCoeffs(order, kr, kR, nBands, 0.0, pData->bN);
                         }
                         break;
                 }
@@ -287,12 +297,12 @@ void array2sh_calculate_sht_matrix
         }
         
         /* direct inverse (only required for GUI) */
-        for(band=0; band<HYBRID_BANDS; band++)
+        for(band=0; band<nBands; band++)
             for(n=0; n < order+1; n++)
                 pData->bN_modal[band][n] = ccdiv(cmplx(4.0*M_PI, 0.0f), pData->bN[band*(order+1)+n]);
 
         /* phase shift */
-        for(band=0; band<HYBRID_BANDS; band++)
+        for(band=0; band<nBands; band++)
             for (n=0; n<order+1; n++)
                 Hs[band][n] = ccmul(cexp(cmplx(0.0, kr[band])), ccdiv(cmplx(4.0*M_PI, 0.0), pData->bN[band*(order+1)+n]));
         
@@ -323,36 +333,40 @@ void array2sh_calculate_sht_matrix
                 W[i][n] /= EN;
         
         /* apply bandpass filterbank to the inverse array response to regularise it */
-        double HW[HYBRID_BANDS];
-        double H_np[HYBRID_BANDS][MAX_SH_ORDER+1];
+        double* HW;
         double W_np[MAX_SH_ORDER+1];
+        HW = malloc1d(nBands*sizeof(double));
+        H_np = (double**)malloc2d(nBands, MAX_SH_ORDER+1, sizeof(double));
         for (n=0; n<order+1; n++){
-            for(band=0; band< HYBRID_BANDS; band++)
+            for(band=0; band< nBands; band++)
                 for (i=n, j=0; i<order+1; i++, j++)
                     H_np[band][j] = H[band][i];
             for (i=n, j=0; i<order+1; i++, j++)
                 W_np[j] = W[n][i];
-            cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasTrans, HYBRID_BANDS, 1, order+1-n, 1.0,
-                        (const double*)H_np, MAX_SH_ORDER+1,
+            cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasTrans, nBands, 1, order+1-n, 1.0,
+                        (const double*)FLATTEN2D(H_np), MAX_SH_ORDER+1,
                         (const double*)W_np, MAX_SH_ORDER+1, 0.0,
                         (double*)HW, 1);
-            for(band=0; band<HYBRID_BANDS; band++)
+            for(band=0; band<nBands; band++)
                 pData->bN_inv[band][n] = crmul(Hs[band][n], HW[band]);
         }
         
         /* diag(filters) * Y */
         array2sh_replicate_order(hA2sh, order); /* replicate orders */
         diag_bN_inv_R = calloc1d(nSH*nSH, sizeof(float_complex));
-        for(band=0; band<HYBRID_BANDS; band++){
+        for(band=0; band<nBands; band++){
             for(i=0; i<nSH; i++)
                 diag_bN_inv_R[i*nSH+i] = cmplxf((float)creal(pData->bN_inv_R[band][i]), (float)cimag(pData->bN_inv_R[band][i])); /* double->single */
             cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasTrans, nSH, (arraySpecs->Q), nSH, &calpha,
                         diag_bN_inv_R, nSH,
                         pinv_Y_mic_cmplx, nSH, &cbeta,
-                        pData->W[band], MAX_NUM_SENSORS);
+                        FLATTEN2D(pData->W[band]), MAX_NUM_SENSORS);
         }
         free(diag_bN_inv_R);
-        
+        free(H);
+        free(Hs);
+        free(HW);
+        free(H_np);
     }
      
     pData->order = order;
@@ -363,6 +377,8 @@ void array2sh_calculate_sht_matrix
     free(Y_mic);
     free(pinv_Y_mic);
     free(pinv_Y_mic_cmplx);
+    free(kr);
+    free(kR);
 }
 
 /* Based on a MatLab script by Archontis Politis, 2019 */
@@ -370,11 +386,11 @@ void array2sh_apply_diff_EQ(void* const hA2sh)
 {
     array2sh_data *pData = (array2sh_data*)(hA2sh);
     array2sh_arrayPars* arraySpecs = (array2sh_arrayPars*)(pData->arraySpecs);
-    int i, j, band, array_order, idxf_alias, nSH;
+    int i, j, band, array_order, idxf_alias, nSH, nBands;
     float f_max, kR_max, f_alias, f_f_alias;
     double_complex* dM_diffcoh_s;
     const double_complex calpha = cmplx(1.0, 0.0); const double_complex cbeta  = cmplx(0.0, 0.0);
-    double kr[HYBRID_BANDS], kR[HYBRID_BANDS];
+    double* kr, *kR;
     double_complex L_diff_fal[MAX_NUM_SH_SIGNALS][MAX_NUM_SH_SIGNALS];
     double_complex L_diff[MAX_NUM_SH_SIGNALS][MAX_NUM_SH_SIGNALS];
     double_complex E_diff[MAX_NUM_SH_SIGNALS][MAX_NUM_SENSORS];
@@ -387,12 +403,15 @@ void array2sh_apply_diff_EQ(void* const hA2sh)
     
     /* prep */
     nSH = (pData->order+1)*(pData->order+1);
-    dM_diffcoh = malloc1d((arraySpecs->Q)*(arraySpecs->Q)* (HYBRID_BANDS) * sizeof(double_complex));
+    nBands = pData->nBands;
+    kr = malloc1d(nBands*sizeof(double));
+    kR = malloc1d(nBands*sizeof(double));
+    dM_diffcoh = malloc1d((arraySpecs->Q)*(arraySpecs->Q)* nBands * sizeof(double_complex));
     dM_diffcoh_s = malloc1d((arraySpecs->Q)*(arraySpecs->Q) * sizeof(double_complex));
     f_max = 20e3f;
     kR_max = 2.0f*M_PI*f_max*(arraySpecs->r)/pData->c;
     array_order = MIN((int)(ceilf(2.0f*kR_max)+0.01f), 28); /* Cap at around 28, as Bessels at 30+ can be numerically unstable */
-    for(band=0; band<HYBRID_BANDS; band++){
+    for(band=0; band<nBands; band++){
         kr[band] = 2.0*M_PI*(pData->freqVector[band])*(arraySpecs->r)/pData->c;
         kR[band] = 2.0*M_PI*(pData->freqVector[band])*(arraySpecs->R)/pData->c;
     }
@@ -405,22 +424,22 @@ void array2sh_apply_diff_EQ(void* const hA2sh)
         case ARRAY_SPHERICAL:
             switch (arraySpecs->weightType){
                 case WEIGHT_RIGID_OMNI:
-                    sphDiffCohMtxTheory(array_order, (float*)arraySpecs->sensorCoords_rad, arraySpecs->Q, ARRAY_CONSTRUCTION_RIGID, 1.0, kr, kR, HYBRID_BANDS, dM_diffcoh);
+                    sphDiffCohMtxTheory(array_order, (float*)arraySpecs->sensorCoords_rad, arraySpecs->Q, ARRAY_CONSTRUCTION_RIGID, 1.0, kr, kR, nBands, dM_diffcoh);
                     break;
                 case WEIGHT_RIGID_CARD:
-                    sphDiffCohMtxTheory(array_order, (float*)arraySpecs->sensorCoords_rad, arraySpecs->Q, ARRAY_CONSTRUCTION_RIGID_DIRECTIONAL, 0.5, kr, kR, HYBRID_BANDS, dM_diffcoh);
+                    sphDiffCohMtxTheory(array_order, (float*)arraySpecs->sensorCoords_rad, arraySpecs->Q, ARRAY_CONSTRUCTION_RIGID_DIRECTIONAL, 0.5, kr, kR, nBands, dM_diffcoh);
                     break;
                 case WEIGHT_RIGID_DIPOLE:
-                    sphDiffCohMtxTheory(array_order, (float*)arraySpecs->sensorCoords_rad, arraySpecs->Q, ARRAY_CONSTRUCTION_RIGID_DIRECTIONAL, 0.0, kr, kR, HYBRID_BANDS, dM_diffcoh);
+                    sphDiffCohMtxTheory(array_order, (float*)arraySpecs->sensorCoords_rad, arraySpecs->Q, ARRAY_CONSTRUCTION_RIGID_DIRECTIONAL, 0.0, kr, kR, nBands, dM_diffcoh);
                     break;
                 case WEIGHT_OPEN_OMNI:
-                    sphDiffCohMtxTheory(array_order, (float*)arraySpecs->sensorCoords_rad, arraySpecs->Q, ARRAY_CONSTRUCTION_OPEN, 1.0, kr, NULL, HYBRID_BANDS, dM_diffcoh);
+                    sphDiffCohMtxTheory(array_order, (float*)arraySpecs->sensorCoords_rad, arraySpecs->Q, ARRAY_CONSTRUCTION_OPEN, 1.0, kr, NULL, nBands, dM_diffcoh);
                     break;
                 case WEIGHT_OPEN_CARD:
-                    sphDiffCohMtxTheory(array_order, (float*)arraySpecs->sensorCoords_rad, arraySpecs->Q, ARRAY_CONSTRUCTION_OPEN_DIRECTIONAL, 0.5, kr, NULL, HYBRID_BANDS, dM_diffcoh);
+                    sphDiffCohMtxTheory(array_order, (float*)arraySpecs->sensorCoords_rad, arraySpecs->Q, ARRAY_CONSTRUCTION_OPEN_DIRECTIONAL, 0.5, kr, NULL, nBands, dM_diffcoh);
                     break;
                 case WEIGHT_OPEN_DIPOLE:
-                    sphDiffCohMtxTheory(array_order, (float*)arraySpecs->sensorCoords_rad, arraySpecs->Q, ARRAY_CONSTRUCTION_OPEN_DIRECTIONAL, 0.0, kr, NULL, HYBRID_BANDS, dM_diffcoh);
+                    sphDiffCohMtxTheory(array_order, (float*)arraySpecs->sensorCoords_rad, arraySpecs->Q, ARRAY_CONSTRUCTION_OPEN_DIRECTIONAL, 0.0, kr, NULL, nBands, dM_diffcoh);
                     break;
             }
             break;
@@ -430,7 +449,7 @@ void array2sh_apply_diff_EQ(void* const hA2sh)
     f_alias = sphArrayAliasLim(arraySpecs->r, pData->c, pData->order);
     idxf_alias = 1;
     f_f_alias = 1e13f;
-    for(band=0; band<HYBRID_BANDS; band++){
+    for(band=0; band<nBands; band++){
         if( fabsf(pData->freqVector[band]-f_alias) < f_f_alias){
             f_f_alias = fabsf(pData->freqVector[band]-f_alias);
             idxf_alias = band;
@@ -440,7 +459,7 @@ void array2sh_apply_diff_EQ(void* const hA2sh)
     /* baseline */
     for(i=0; i<arraySpecs->Q; i++)
         for(j=0; j<arraySpecs->Q; j++)
-            dM_diffcoh_s[i*(arraySpecs->Q)+j] = cmplx(dM_diffcoh[i*(arraySpecs->Q)* (HYBRID_BANDS) + j*(HYBRID_BANDS) + (idxf_alias)], 0.0);
+            dM_diffcoh_s[i*(arraySpecs->Q)+j] = cmplx(dM_diffcoh[i*(arraySpecs->Q)* nBands + j*nBands + (idxf_alias)], 0.0);
     for(i=0; i<nSH; i++)
         for(j=0; j<arraySpecs->Q; j++)
             W_tmp[i][j]= cmplx((double)crealf(pData->W[idxf_alias][i][j]), (double)cimagf(pData->W[idxf_alias][i][j]));
@@ -456,10 +475,10 @@ void array2sh_apply_diff_EQ(void* const hA2sh)
         L_diff_fal[i][i] = crmul(L_diff_fal[i][i], 1.0/(4.0*M_PI)); /* only care about the diagonal entries */
     
     /* diffuse-field equalise bands above aliasing. */
-    for(band = MAX(idxf_alias,0)+1; band<HYBRID_BANDS; band++){
+    for(band = MAX(idxf_alias,0)+1; band<nBands; band++){
         for(i=0; i<arraySpecs->Q; i++)
             for(j=0; j<arraySpecs->Q; j++)
-                dM_diffcoh_s[i*(arraySpecs->Q)+j] = cmplx(dM_diffcoh[i*(arraySpecs->Q)* (HYBRID_BANDS) + j*(HYBRID_BANDS) + (band)], 0.0);
+                dM_diffcoh_s[i*(arraySpecs->Q)+j] = cmplx(dM_diffcoh[i*(arraySpecs->Q)* nBands + j*nBands + (band)], 0.0);
         for(i=0; i<nSH; i++)
             for(j=0; j<arraySpecs->Q; j++)
                 W_tmp[i][j]= cmplx((double)crealf(pData->W[band][i][j]), (double)cimagf(pData->W[band][i][j]));
@@ -483,10 +502,12 @@ void array2sh_apply_diff_EQ(void* const hA2sh)
                 pData->W[band][i][j] = cmplxf((float)creal(W_diffEQ[i][j]), (float)cimag(W_diffEQ[i][j]));
     }
     
-    pData->evalStatus = EVAL_STATUS_NOT_EVALUATED;
+    saf_atomic_storeInt(&(pData->evalStatus), EVAL_STATUS_NOT_EVALUATED);
     
     free(dM_diffcoh);
     free(dM_diffcoh_s);
+    free(kr);
+    free(kR);
 }
 
 void array2sh_calculate_mag_curves(void* const hA2sh)
@@ -494,7 +515,7 @@ void array2sh_calculate_mag_curves(void* const hA2sh)
     array2sh_data *pData = (array2sh_data*)(hA2sh);
     int band, n;
     
-    for(band = 0; band <HYBRID_BANDS; band++){
+    for(band = 0; band <pData->nBands; band++){
         for(n = 0; n <pData->order+1; n++){
             pData->bN_inv_dB[band][n] = 20.0f * (float)log10(cabs(pData->bN_inv[band][n]));
             pData->bN_modal_dB[band][n] = 20.0f * (float)log10(cabs(pData->bN_modal[band][n]));
@@ -506,9 +527,8 @@ void array2sh_evaluateSHTfilters(void* hA2sh)
 {
     array2sh_data *pData = (array2sh_data*)(hA2sh);
     array2sh_arrayPars* arraySpecs = (array2sh_arrayPars*)(pData->arraySpecs);
-    int band, i, j, simOrder, order, nSH;
-    double kr[HYBRID_BANDS];
-    double kR[HYBRID_BANDS];
+    int band, i, j, simOrder, order, nSH, nBands;
+    double* kr, *kR;
     float* Y_grid_real;
     float_complex* Y_grid, *H_array, *Wshort;
      
@@ -520,37 +540,40 @@ void array2sh_evaluateSHTfilters(void* hA2sh)
     /* simulate the current array by firing 812 plane-waves around the surface of a theoretical version of the array
      * and ascertaining the transfer function for each */
     simOrder = (int)(2.0f*M_PI*MAX_EVAL_FREQ_HZ*(arraySpecs->r)/pData->c)+1;
-    for(band=0; band<HYBRID_BANDS; band++){
+    nBands = pData->nBands;
+    kr = malloc1d(nBands*sizeof(double));
+    kR = malloc1d(nBands*sizeof(double));
+    for(band=0; band<nBands; band++){
         kr[band] = 2.0*M_PI*(pData->freqVector[band])*(arraySpecs->r)/pData->c;
         kR[band] = 2.0*M_PI*(pData->freqVector[band])*(arraySpecs->R)/pData->c;
     }
-    H_array = malloc1d((HYBRID_BANDS) * (arraySpecs->Q) * 812*sizeof(float_complex));
+    H_array = malloc1d(nBands * (arraySpecs->Q) * 812*sizeof(float_complex));
     switch(arraySpecs->arrayType){
         case ARRAY_SPHERICAL:
             switch(arraySpecs->weightType){
                 default:
                 case WEIGHT_RIGID_OMNI:
-                    simulateSphArray(simOrder, kr, kR, HYBRID_BANDS, (float*)arraySpecs->sensorCoords_rad, arraySpecs->Q,
+                    simulateSphArray(simOrder, kr, kR, nBands, (float*)arraySpecs->sensorCoords_rad, arraySpecs->Q,
                                      (float*)__geosphere_ico_9_0_dirs_deg, 812, ARRAY_CONSTRUCTION_RIGID, 1.0, H_array);
                     break;
                 case WEIGHT_RIGID_CARD:
-                    simulateSphArray(simOrder, kr, kR, HYBRID_BANDS, (float*)arraySpecs->sensorCoords_rad, arraySpecs->Q,
+                    simulateSphArray(simOrder, kr, kR, nBands, (float*)arraySpecs->sensorCoords_rad, arraySpecs->Q,
                                      (float*)__geosphere_ico_9_0_dirs_deg, 812, ARRAY_CONSTRUCTION_RIGID_DIRECTIONAL, 0.5, H_array);
                     break;
                 case WEIGHT_RIGID_DIPOLE:
-                    simulateSphArray(simOrder, kr, kR, HYBRID_BANDS, (float*)arraySpecs->sensorCoords_rad, arraySpecs->Q,
+                    simulateSphArray(simOrder, kr, kR, nBands, (float*)arraySpecs->sensorCoords_rad, arraySpecs->Q,
                                      (float*)__geosphere_ico_9_0_dirs_deg, 812, ARRAY_CONSTRUCTION_RIGID_DIRECTIONAL, 0.0, H_array);
                     break;
                 case WEIGHT_OPEN_OMNI:
-                    simulateSphArray(simOrder, kr, NULL, HYBRID_BANDS, (float*)arraySpecs->sensorCoords_rad, arraySpecs->Q,
+                    simulateSphArray(simOrder, kr, NULL, nBands, (float*)arraySpecs->sensorCoords_rad, arraySpecs->Q,
                                      (float*)__geosphere_ico_9_0_dirs_deg, 812, ARRAY_CONSTRUCTION_OPEN, 1.0, H_array);
                     break;
                 case WEIGHT_OPEN_CARD:
-                    simulateSphArray(simOrder, kr, NULL, HYBRID_BANDS, (float*)arraySpecs->sensorCoords_rad, arraySpecs->Q,
+                    simulateSphArray(simOrder, kr, NULL, nBands, (float*)arraySpecs->sensorCoords_rad, arraySpecs->Q,
                                      (float*)__geosphere_ico_9_0_dirs_deg, 812, ARRAY_CONSTRUCTION_OPEN_DIRECTIONAL, 0.5, H_array);
                     break;
                 case WEIGHT_OPEN_DIPOLE:
-                    simulateSphArray(simOrder, kr, NULL, HYBRID_BANDS, (float*)arraySpecs->sensorCoords_rad, arraySpecs->Q,
+                    simulateSphArray(simOrder, kr, NULL, nBands, (float*)arraySpecs->sensorCoords_rad, arraySpecs->Q,
                                      (float*)__geosphere_ico_9_0_dirs_deg, 812, ARRAY_CONSTRUCTION_OPEN_DIRECTIONAL, 0.0, H_array);
                     break;
             }
@@ -562,12 +585,12 @@ void array2sh_evaluateSHTfilters(void* hA2sh)
                 case WEIGHT_RIGID_OMNI:
                 case WEIGHT_RIGID_CARD:
                 case WEIGHT_RIGID_DIPOLE:
-                    simulateCylArray(simOrder, kr, HYBRID_BANDS, (float*)arraySpecs->sensorCoords_rad, arraySpecs->Q, (float*)__geosphere_ico_9_0_dirs_deg, 812, ARRAY_CONSTRUCTION_RIGID, H_array);
+                    simulateCylArray(simOrder, kr, nBands, (float*)arraySpecs->sensorCoords_rad, arraySpecs->Q, (float*)__geosphere_ico_9_0_dirs_deg, 812, ARRAY_CONSTRUCTION_RIGID, H_array);
                     break;
                 case WEIGHT_OPEN_DIPOLE:
                 case WEIGHT_OPEN_CARD:
                 case WEIGHT_OPEN_OMNI:
-                    simulateCylArray(simOrder, kr, HYBRID_BANDS, (float*)arraySpecs->sensorCoords_rad, arraySpecs->Q, (float*)__geosphere_ico_9_0_dirs_deg, 812, ARRAY_CONSTRUCTION_OPEN, H_array);
+                    simulateCylArray(simOrder, kr, nBands, (float*)arraySpecs->sensorCoords_rad, arraySpecs->Q, (float*)__geosphere_ico_9_0_dirs_deg, 812, ARRAY_CONSTRUCTION_OPEN, H_array);
                     break;
             }
             break;
@@ -586,17 +609,19 @@ void array2sh_evaluateSHTfilters(void* hA2sh)
         Y_grid[i] = cmplxf(Y_grid_real[i], 0.0f); /* "evaluateSHTfilters" function requires complex data type */
     
     /* compare the spherical harmonics obtained from encoding matrix 'W' with the ideal patterns */
-    Wshort = malloc1d(HYBRID_BANDS*nSH*(arraySpecs->Q)*sizeof(float_complex));
-    for(band=0; band<HYBRID_BANDS; band++)
+    Wshort = malloc1d(nBands*nSH*(arraySpecs->Q)*sizeof(float_complex));
+    for(band=0; band<nBands; band++)
         for(i=0; i<nSH; i++)
             for(j=0; j<(arraySpecs->Q); j++)
                 Wshort[band*nSH*(arraySpecs->Q) + i*(arraySpecs->Q) + j] = pData->W[band][i][j];
-    evaluateSHTfilters(order, Wshort, arraySpecs->Q, HYBRID_BANDS, H_array, 812, Y_grid, pData->cSH, pData->lSH);
+    evaluateSHTfilters(order, Wshort, arraySpecs->Q, nBands, H_array, 812, Y_grid, pData->cSH, pData->lSH);
 
     free(Y_grid_real);
     free(Y_grid);
     free(H_array);
     free(Wshort);
+    free(kr);
+    free(kR);
 }
 
 void array2sh_createArray(void ** const hPars)
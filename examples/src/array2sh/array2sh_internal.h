@@ -58,12 +58,6 @@ extern "C" {
 /*                            Internal Parameters                             */
 /* ========================================================================== */
 
-#ifndef FRAME_SIZE
-# define FRAME_SIZE ( 128 ) 
-#endif
-#define HOP_SIZE ( 128 )                       /* STFT hop size = nBands */
-#define HYBRID_BANDS ( HOP_SIZE + 5 )          /* hybrid mode incurs an additional 5 bands  */
-#define TIME_SLOTS ( FRAME_SIZE / HOP_SIZE )   /* 4/8/16 */
 #define MAX_NUM_SENSORS ( ARRAY2SH_MAX_NUM_SENSORS ) /* Maximum permitted number of channels for the VST standard */
 #define MAX_EVAL_FREQ_HZ ( 20e3f )             /* Up to which frequency should the evaluation be accurate */
 #define MAX_NUM_SENSORS_IN_PRESET ( MAX_NUM_SENSORS )
@@ -94,43 +88,44 @@ typedef struct _array2sh_arrayPars {
 typedef struct _array2sh
 {
     /* audio buffers */
-    float inputFrameTD[MAX_NUM_SENSORS][FRAME_SIZE];
-    float SHframeTD[MAX_NUM_SH_SIGNALS][FRAME_SIZE];
-    float_complex inputframeTF[HYBRID_BANDS][MAX_NUM_SENSORS][TIME_SLOTS];
-    float_complex SHframeTF[HYBRID_BANDS][MAX_NUM_SH_SIGNALS][TIME_SLOTS];
-    complexVector* STFTInputFrameTF;
-    complexVector* STFTOutputFrameTF;
-    float** tempHopFrameTD_in;
-    float** tempHopFrameTD_out;
+    float** inputFrameTD;   /**< MAX_NUM_SENSORS x frameSize */
+    float** SHframeTD;      /**< MAX_NUM_SH_SIGNALS x frameSize */
+    float_complex*** inputframeTF;  /**< nBands x MAX_NUM_SENSORS x timeSlots */
+    float_complex*** SHframeTF;     /**< nBands x MAX_NUM_SH_SIGNALS x timeSlots */
     
     /* intermediates */
-    double_complex bN_modal[HYBRID_BANDS][MAX_SH_ORDER + 1];
+    double_complex** bN_modal;      /* nBands x (MAX_SH_ORDER + 1) */
     double_complex* bN;
-    double_complex bN_inv[HYBRID_BANDS][MAX_SH_ORDER + 1];
-    double_complex bN_inv_R[HYBRID_BANDS][MAX_NUM_SH_SIGNALS]; 
-    float_complex W[HYBRID_BANDS][MAX_NUM_SH_SIGNALS][MAX_NUM_SENSORS];
-    float_complex W_diffEQ[HYBRID_BANDS][MAX_NUM_SH_SIGNALS][MAX_NUM_SENSORS];
+    double_complex** bN_inv;        /* nBands x (MAX_SH_ORDER + 1) */
+    double_complex** bN_inv_R;      /* nBands x MAX_NUM_SH_SIGNALS */
+    float_complex*** W;             /* encoding matrices; nBands x MAX_NUM_SH_SIGNALS x MAX_NUM_SENSORS */
     
     /* for displaying the bNs */
-    float** bN_modal_dB;            /* modal responses / no regulaisation; HYBRID_BANDS x (MAX_SH_ORDER +1)  */
-    float** bN_inv_dB;              /* modal responses / with regularisation; HYBRID_BANDS x (MAX_SH_ORDER +1)  */
-    float* cSH;                     /* spatial correlation; HYBRID_BANDS x 1 */
-    float* lSH;                     /* level difference; HYBRID_BANDS x 1 */ 
+    float** bN_modal_dB;            /* modal responses / no regulaisation; nBands x (MAX_SH_ORDER +1)  */
+    float** bN_inv_dB;              /* modal responses / with regularisation; nBands x (MAX_SH_ORDER +1)  */
+    float* cSH;                     /* spatial correlation; nBands x 1 */
+    float* lSH;                     /* level difference; nBands x 1 */ 
     
     /* time-frequency transform and array details */
-    float freqVector[HYBRID_BANDS]; /* frequency vector */
+    int frameSize;                  /* processing frame size, in samples (fixed at creation) */
+    int hopSize;                    /* afSTFT hop size, in samples */
+    int nBands;                     /* number of (hybrid) frequency bands; hopSize + 5 */
+    int timeSlots;                  /* number of time slots per frame; frameSize / hopSize */
+    int LDmode;                     /* current low-delay mode of the afSTFT */
+    int new_LDmode;                 /* new low-delay mode; applied when the afSTFT is re-initialised */
+    float* freqVector;              /* frequency vector; nBands x 1 */
     void* hSTFT;                    /* filterbank handle */
+    void* hBlockAdaptor;            /* block-size adaptor handle */
     void* arraySpecs;               /* array configuration */
     
     /* internal parameters */
-    ARRAY2SH_EVAL_STATUS evalStatus;
+    volatile int evalStatus;        /* see #_ARRAY2SH_EVAL_STATUS enum */
     float progressBar0_1;
     char* progressBarText;
     int fs;                         /* sampling rate, hz */
     int new_order;                  /* new encoding order */
     
     /* flags */
-    PROC_STATUS procStatus;
     int reinitSHTmatrixFLAG;        /* 0: do not reinit; 1: reinit; */
     int evalRequestedFLAG;          /* 0: do not reinit; 1: reinit; */
     
@@ -29,11 +29,24 @@ void beamformer_create
 (
     void ** const phBeam
 )
+{
+    beamformer_createWithFrameSize(phBeam, DEFAULT_TF_FRAME_SIZE);
+}
+
+void beamformer_createWithFrameSize
+(
+    void ** const phBeam,
+    int frameSize
+)
 {
     beamformer_data* pData = (beamformer_data*)malloc1d(sizeof(beamformer_data));
     *phBeam = (void*)pData;
     int i, ch;
 
+    /* frame size (= the length of the cross-fade between beam weights), which
+     * is fixed for the lifetime of the instance */
+    pData->frameSize = IS_VALID_TF_FRAME_SIZE(frameSize) ? frameSize : DEFAULT_TF_FRAME_SIZE;
+
     /* default user parameters */
     pData->beamOrder = 1;
     for(i=0; i<MAX_NUM_BEAMS; i++){
@@ -50,6 +63,16 @@ void beamformer_create
     /* flags */
     for(ch=0; ch<MAX_NUM_BEAMS; ch++)
         pData->recalc_beamWeights[ch] = 1;
+
+    /* audio buffers */
+    pData->SHFrameTD = (float**)malloc2d(MAX_NUM_SH_SIGNALS, pData->frameSize, sizeof(float));
+    pData->prev_SHFrameTD = (float**)calloc2d(MAX_NUM_SH_SIGNALS, pData->frameSize, sizeof(float));
+    pData->tempFrame = (float**)malloc2d(MAX_NUM_BEAMS, pData->frameSize, sizeof(float));
+    pData->outputFrameTD = (float**)malloc2d(MAX_NUM_BEAMS, pData->frameSize, sizeof(float));
+    pData->interpolator = malloc1d(pData->frameSize*sizeof(float));
+
+    /* block-size adaptor */
+    saf_blockAdaptor_create(&(pData->hBlockAdaptor), pData->frameSize, MAX_NUM_SH_SIGNALS, MAX_NUM_BEAMS);
 }
 
 void beamformer_destroy
@@ -60,7 +83,12 @@ void beamformer_destroy
     beamformer_data *pData = (beamformer_data*)(*phBeam);
     
     if (pData != NULL) {
-        
+        saf_blockAdaptor_destroy(&(pData->hBlockAdaptor));
+        free(pData->SHFrameTD);
+        free(pData->prev_SHFrameTD);
+        free(pData->tempFrame);
+        free(pData->outputFrameTD);
+        free(pData->interpolator);
         free(pData);
         pData = NULL;
     }
@@ -81,25 +109,26 @@ void beamformer_init
     /* defaults */
     memset(pData->beamWeights, 0, MAX_NUM_BEAMS*MAX_NUM_SH_SIGNALS*sizeof(float));
     memset(pData->prev_beamWeights, 0, MAX_NUM_BEAMS*MAX_NUM_SH_SIGNALS*sizeof(float));
-    memset(pData->prev_SHFrameTD, 0, MAX_NUM_SH_SIGNALS*FRAME_SIZE*sizeof(float));
+    memset(FLATTEN2D(pData->prev_SHFrameTD), 0, MAX_NUM_SH_SIGNALS*(pData->frameSize)*sizeof(float));
     for(ch=0; ch<MAX_NUM_BEAMS; ch++)
         pData->recalc_beamWeights[ch] = 1;
-    for(i=1; i<=FRAME_SIZE; i++)
-        pData->interpolator[i-1] = (float)i*1.0f/(float)FRAME_SIZE;
+    for(i=1; i<=pData->frameSize; i++)
+        pData->interpolator[i-1] = (float)i*1.0f/(float)pData->frameSize;
+    saf_blockAdaptor_reset(pData->hBlockAdaptor);
 }
 
-void beamformer_process
+/** Processes one frame of frameSize samples (see saf_blockAdaptor_apply()) */
+static void beamformer_processFrame
 (
     void  *  const hBeam,
     float ** const inputs,
     float ** const outputs,
     int            nInputs,
-    int            nOutputs,
-    int            nSamples
+    int            nOutputs
 )
 {
     beamformer_data *pData = (beamformer_data*)(hBeam);
-    int n, ch, i, j, bi, nSH;
+    int n, ch, i, j, bi, nSH, frameSize;
     int o[MAX_SH_ORDER+2];
 
     /* local copies of user parameters */
@@ -112,87 +141,114 @@ void beamformer_process
     nBeams = pData->nBeams;
     norm = pData->norm;
     chOrdering = pData->chOrdering;
+    frameSize = pData->frameSize;
      
     /* Apply beamformer */
-    if(nSamples == FRAME_SIZE) {
-
-        /* Load time-domain data */
-        for(i=0; i < MIN(nSH, nInputs); i++)
-            utility_svvcopy(inputs[i], FRAME_SIZE, pData->SHFrameTD[i]);
-        for(; i<nSH; i++)
-            memset(pData->SHFrameTD[i], 0, FRAME_SIZE * sizeof(float)); /* fill remaining channels with zeros */
-
-        /* account for input channel order convention */
-        switch(chOrdering){
-          case CH_ACN: /* already ACN */
-                break;
-          case CH_FUMA:
-              convertHOAChannelConvention((float*)pData->SHFrameTD, beamOrder, FRAME_SIZE, HOA_CH_ORDER_FUMA, HOA_CH_ORDER_ACN);
-              break;
-        }
+    /* Load time-domain data */
+    for(i=0; i < MIN(nSH, nInputs); i++)
+        utility_svvcopy(inputs[i], frameSize, pData->SHFrameTD[i]);
+    for(; i<nSH; i++)
+        memset(pData->SHFrameTD[i], 0, frameSize * sizeof(float)); /* fill remaining channels with zeros */
+
+    /* account for input channel order convention */
+    switch(chOrdering){
+      case CH_ACN: /* already ACN */
+            break;
+      case CH_FUMA:
+          convertHOAChannelConvention(FLATTEN2D(pData->SHFrameTD), beamOrder, frameSize, HOA_CH_ORDER_FUMA, HOA_CH_ORDER_ACN);
+          break;
+    }
 
-        /* account for input normalisation scheme */
-        switch(norm){
-          case NORM_N3D:  /* already in N3D */
-              break;
-          case NORM_SN3D: /* convert to N3D */
-              convertHOANormConvention((float*)pData->SHFrameTD, beamOrder, FRAME_SIZE, HOA_NORM_SN3D, HOA_NORM_N3D);
-              break;
-          case NORM_FUMA: /* only for first-order, convert to N3D */
-              convertHOANormConvention((float*)pData->SHFrameTD, beamOrder, FRAME_SIZE, HOA_NORM_FUMA, HOA_NORM_N3D);
-              break;
-        }
+    /* account for input normalisation scheme */
+    switch(norm){
+      case NORM_N3D:  /* already in N3D */
+          break;
+      case NORM_SN3D: /* convert to N3D */
+          convertHOANormConvention(FLATTEN2D(pData->SHFrameTD), beamOrder, frameSize, HOA_NORM_SN3D, HOA_NORM_N3D);
+          break;
+      case NORM_FUMA: /* only for first-order, convert to N3D */
+          convertHOANormConvention(FLATTEN2D(pData->SHFrameTD), beamOrder, frameSize, HOA_NORM_FUMA, HOA_NORM_N3D);
+          break;
+    }
 
-        /* Main processing: */
-        float* c_n;
-        c_n = malloc1d((beamOrder+1)*sizeof(float));
-
-        /* calculate beamforming coeffients */
-        for(bi=0; bi<nBeams; bi++){
-            if(pData->recalc_beamWeights[bi]){
-                memset(pData->beamWeights[bi], 0, MAX_NUM_SH_SIGNALS*sizeof(float));
-                switch(pData->beamType){
-                    case STATIC_BEAM_TYPE_CARDIOID: beamWeightsCardioid2Spherical(beamOrder, c_n); break;
-                    case STATIC_BEAM_TYPE_HYPERCARDIOID: beamWeightsHypercardioid2Spherical(beamOrder, c_n); break;
-                    case STATIC_BEAM_TYPE_MAX_EV: beamWeightsMaxEV(beamOrder, c_n); break;
-                }
-                rotateAxisCoeffsReal(beamOrder, c_n, M_PI/2.0f - pData->beam_dirs_deg[bi][1]*M_PI/180.0f,
-                                        pData->beam_dirs_deg[bi][0]*M_PI/180.0f, (float*)pData->beamWeights[bi]);
-
-                pData->recalc_beamWeights[bi] = 0;
+    /* Main processing: */
+    float* c_n;
+    c_n = malloc1d((beamOrder+1)*sizeof(float));
+
+    /* calculate beamforming coeffients */
+    for(bi=0; bi<nBeams; bi++){
+        if(pData->recalc_beamWeights[bi]){
+            memset(pData->beamWeights[bi], 0, MAX_NUM_SH_SIGNALS*sizeof(float));
+            switch(pData->beamType){
+                case STATIC_BEAM_TYPE_CARDIOID: beamWeightsCardioid2Spherical(beamOrder, c_n); break;
+                case STATIC_BEAM_TYPE_HYPERCARDIOID: beamWeightsHypercardioid2Spherical(beamOrder, c_n); break;
+                case STATIC_BEAM_TYPE_MAX_EV: beamWeightsMaxEV(beamOrder, c_n); break;
             }
-            else
-                memcpy(pData->beamWeights[bi], pData->prev_beamWeights[bi], nSH*sizeof(float));
+            rotateAxisCoeffsReal(beamOrder, c_n, M_PI/2.0f - pData->beam_dirs_deg[bi][1]*M_PI/180.0f,
+                                    pData->beam_dirs_deg[bi][0]*M_PI/180.0f, (float*)pData->beamWeights[bi]);
+
+            pData->recalc_beamWeights[bi] = 0;
         }
-        free(c_n);
-
-        /* apply beam weights */
-        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nBeams, FRAME_SIZE, nSH, 1.0f,
-                    (const float*)pData->prev_beamWeights, MAX_NUM_SH_SIGNALS,
-                    (const float*)pData->prev_SHFrameTD, FRAME_SIZE, 0.0f,
-                    (float*)pData->tempFrame, FRAME_SIZE);
-        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nBeams, FRAME_SIZE, nSH, 1.0f,
-                    (const float*)pData->beamWeights, MAX_NUM_SH_SIGNALS,
-                    (const float*)pData->prev_SHFrameTD, FRAME_SIZE, 0.0f,
-                    (float*)pData->outputFrameTD, FRAME_SIZE);
-
-        for (i=0; i <nBeams; i++)
-            for(j=0; j<FRAME_SIZE; j++)
-                pData->outputFrameTD[i][j] =  pData->interpolator[j] * pData->outputFrameTD[i][j] + (1.0f-pData->interpolator[j]) * pData->tempFrame[i][j];
-
-        /* for next frame */
-        utility_svvcopy((const float*)pData->SHFrameTD, nSH*FRAME_SIZE, (float*)pData->prev_SHFrameTD);
-        utility_svvcopy((const float*)pData->beamWeights, MAX_NUM_BEAMS*MAX_NUM_SH_SIGNALS, (float*)pData->prev_beamWeights);
-
-        /* copy to output buffer */
-            for(ch = 0; ch < MIN(nBeams, nOutputs); ch++)
-                utility_svvcopy(pData->outputFrameTD[ch], FRAME_SIZE, outputs[ch]);
-            for (; ch < nOutputs; ch++)
-                memset(outputs[ch], 0, FRAME_SIZE*sizeof(float));
+        else
+            memcpy(pData->beamWeights[bi], pData->prev_beamWeights[bi], nSH*sizeof(float));
     }
-    else
-        for (ch=0; ch < nOutputs; ch++)
-            memset(outputs[ch], 0, FRAME_SIZE*sizeof(float));
+    free(c_n);
+
+    /* apply beam weights */
+    cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nBeams, frameSize, nSH, 1.0f,
+                (const float*)pData->prev_beamWeights, MAX_NUM_SH_SIGNALS,
+                FLATTEN2D(pData->prev_SHFrameTD), frameSize, 0.0f,
+                FLATTEN2D(pData->tempFrame), frameSize);
+    cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nBeams, frameSize, nSH, 1.0f,
+                (const float*)pData->beamWeights, MAX_NUM_SH_SIGNALS,
+                FLATTEN2D(pData->prev_SHFrameTD), frameSize, 0.0f,
+                FLATTEN2D(pData->outputFrameTD), frameSize);
+
+    for (i=0; i <nBeams; i++)
+        for(j=0; j<frameSize; j++)
+            pData->outputFrameTD[i][j] =  pData->interpolator[j] * pData->outputFrameTD[i][j] + (1.0f-pData->interpolator[j]) * pData->tempFrame[i][j];
+
+    /* for next frame */
+    utility_svvcopy(FLATTEN2D(pData->SHFrameTD), nSH*frameSize, FLATTEN2D(pData->prev_SHFrameTD));
+    utility_svvcopy((const float*)pData->beamWeights, MAX_NUM_BEAMS*MAX_NUM_SH_SIGNALS, (float*)pData->prev_beamWeights);
+
+    /* copy to output buffer */
+        for(ch = 0; ch < MIN(nBeams, nOutputs); ch++)
+            utility_svvcopy(pData->outputFrameTD[ch], frameSize, outputs[ch]);
+        for (; ch < nOutputs; ch++)
+            memset(outputs[ch], 0, frameSize*sizeof(float));
+}
+
+void beamformer_process
+(
+    void  *  const hBeam,
+    float ** const inputs,
+    float ** const outputs,
+    int            nInputs,
+    int            nOutputs,
+    int            nSamples
+)
+{
+    beamformer_data *pData = (beamformer_data*)(hBeam);
+
+    saf_blockAdaptor_apply(pData->hBlockAdaptor, inputs, outputs, nInputs, nOutputs,
+                           nSamples, beamformer_processFrame, hBeam);
+}
+
+void beamformer_processInterleaved
+(
+    void  *  const hBeam,
+    const float *  inputs,
+    float *        outputs,
+    int            nInputs,
+    int            nOutputs,
+    int            nSamples
+)
+{
+    beamformer_data *pData = (beamformer_data*)(hBeam);
+
+    saf_blockAdaptor_applyStrided(pData->hBlockAdaptor, inputs, 1, nInputs, outputs, 1, nOutputs,
+                                  nInputs, nOutputs, nSamples, beamformer_processFrame, hBeam);
 }
 
 
@@ -274,7 +330,13 @@ void beamformer_setBeamType(void* const hBeam, int newID)
 
 int beamformer_getFrameSize(void)
 {
-    return FRAME_SIZE;
+    return DEFAULT_TF_FRAME_SIZE;
+}
+
+int beamformer_getFrameSizeEx(void* const hBeam)
+{
+    beamformer_data *pData = (beamformer_data*)(hBeam);
+    return pData->frameSize;
 }
 
 int beamformer_getBeamOrder(void  * const hBeam)
@@ -285,7 +347,7 @@ int beamformer_getBeamOrder(void  * const hBeam)
 
 int beamformer_getNumberOfBands(void)
 {
-    return HYBRID_BANDS;
+    return DEFAULT_TF_FRAME_SIZE + 5; /* (the static beamformers do not employ a filterbank) */
 }
 
 float beamformer_getBeamAzi_deg(void* const hBeam, int index)
@@ -335,9 +397,15 @@ int beamformer_getBeamType(void* const hBeam)
     return pData->beamType;
 }
 
-int beamformer_getProcessingDelay()
+int beamformer_getProcessingDelay(void)
+{
+    return DEFAULT_TF_FRAME_SIZE;
+}
+
+int beamformer_getProcessingDelayEx(void* const hBeam)
 {
-    return FRAME_SIZE;
+    beamformer_data *pData = (beamformer_data*)(hBeam);
+    return pData->frameSize + saf_blockAdaptor_getDelay(pData->hBlockAdaptor);
 }
 
 
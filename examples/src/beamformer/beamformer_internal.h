@@ -40,12 +40,6 @@ extern "C" {
 /*                            Internal Parameters                             */
 /* ========================================================================== */
 
-#ifndef FRAME_SIZE
-# define FRAME_SIZE ( 128 ) 
-#endif
-#define HOP_SIZE ( 128 )                         /* STFT hop size = nBands */
-#define HYBRID_BANDS ( HOP_SIZE + 5 )            /* hybrid mode incurs an additional 5 bands  */
-#define TIME_SLOTS ( FRAME_SIZE / HOP_SIZE )     /* 4/8/16 */
 #define MAX_NUM_BEAMS ( MAX_NUM_OUTPUTS ) /* Maximum permitted channels for the VST standard */
 
 
@@ -59,17 +53,19 @@ extern "C" {
  */
 typedef struct _beamformer
 {
-    /* audio buffers + afSTFT time-frequency transform handle */
-    float SHFrameTD[MAX_NUM_SH_SIGNALS][FRAME_SIZE];
-    float prev_SHFrameTD[MAX_NUM_SH_SIGNALS][FRAME_SIZE];
-    float tempFrame[MAX_NUM_BEAMS][FRAME_SIZE];
-    float outputFrameTD[MAX_NUM_BEAMS][FRAME_SIZE];
+    /* audio buffers */
+    int frameSize;                           /**< processing frame size, in samples (fixed at creation) */
+    float** SHFrameTD;                       /**< MAX_NUM_SH_SIGNALS x frameSize */
+    float** prev_SHFrameTD;                  /**< MAX_NUM_SH_SIGNALS x frameSize */
+    float** tempFrame;                       /**< MAX_NUM_BEAMS x frameSize */
+    float** outputFrameTD;                   /**< MAX_NUM_BEAMS x frameSize */
     int fs;
     
     /* internal variables */ 
     float beamWeights[MAX_NUM_BEAMS][MAX_NUM_SH_SIGNALS];
     float prev_beamWeights[MAX_NUM_BEAMS][MAX_NUM_SH_SIGNALS];
-    float interpolator[FRAME_SIZE];
+    float* interpolator;                     /**< linear cross-fade ramp; frameSize x 1 */
+    void* hBlockAdaptor;                     /**< block-size adaptor handle */
     
     /* flags */
     int recalc_beamWeights[MAX_NUM_BEAMS];   /**< 0: no init required, 1: init required */ 
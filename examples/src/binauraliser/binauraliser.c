@@ -35,11 +35,28 @@ void binauraliser_create
 (
     void ** const phBin
 )
+{
+    binauraliser_createWithFrameSize(phBin, DEFAULT_TF_FRAME_SIZE);
+}
+
+void binauraliser_createWithFrameSize
+(
+    void ** const phBin,
+    int frameSize
+)
 {
     binauraliser_data* pData = (binauraliser_data*)malloc1d(sizeof(binauraliser_data));
     *phBin = (void*)pData;
     int ch;
 
+    /* frame size (= afSTFT hop size), which is fixed for the lifetime of the instance */
+    pData->frameSize = IS_VALID_TF_FRAME_SIZE(frameSize) ? frameSize : DEFAULT_TF_FRAME_SIZE;
+    pData->hopSize = pData->frameSize;
+    pData->nBands = pData->hopSize + 5;
+    pData->timeSlots = pData->frameSize / pData->hopSize;
+    pData->LDmode = 0;
+    pData->new_LDmode = 0;
+
     /* user parameters */
     binauraliser_loadPreset(SOURCE_CONFIG_PRESET_DEFAULT, pData->src_dirs_deg, &(pData->new_nSources), &(pData->input_nDims)); /*check setStateInformation if you change default preset*/
     pData->nSources = pData->new_nSources;
@@ -53,45 +70,38 @@ void binauraliser_create
     pData->useRollPitchYawFlag = 0;
     pData->enableRotation = 0;
 
-    /* time-frequency transform + buffers */
-    pData->hSTFT = NULL;
-    pData->STFTInputFrameTF = malloc1d(MAX_NUM_INPUTS * sizeof(complexVector));
-    for(ch=0; ch< MAX_NUM_INPUTS; ch++) {
-        pData->STFTInputFrameTF[ch].re = (float*)calloc1d(HYBRID_BANDS, sizeof(float));
-        pData->STFTInputFrameTF[ch].im = (float*)calloc1d(HYBRID_BANDS, sizeof(float));
-    }
-    pData->tempHopFrameTD = (float**)malloc2d( MAX(MAX_NUM_INPUTS, NUM_EARS), HOP_SIZE, sizeof(float));
-    pData->STFTOutputFrameTF = malloc1d(NUM_EARS*sizeof(complexVector));
-    for(ch=0; ch< NUM_EARS; ch++) {
-        pData->STFTOutputFrameTF[ch].re = (float*)calloc1d(HYBRID_BANDS, sizeof(float));
-        pData->STFTOutputFrameTF[ch].im = (float*)calloc1d(HYBRID_BANDS, sizeof(float));
-    }
+    /* time-frequency transform buffers */
+    pData->fs = 0;
+    pData->inputFrameTD = (float**)malloc2d(MAX_NUM_INPUTS, pData->frameSize, sizeof(float));
+    pData->outframeTD = (float**)malloc2d(NUM_EARS, pData->frameSize, sizeof(float));
+    pData->inputframeTF = (float_complex***)malloc3d(pData->nBands, MAX_NUM_INPUTS, pData->timeSlots, sizeof(float_complex));
+    pData->outputframeTF = (float_complex***)malloc3d(pData->nBands, NUM_EARS, pData->timeSlots, sizeof(float_complex));
+    pData->freqVector = calloc1d(pData->nBands, sizeof(float));
     
+    /* codec states (afSTFT + HRTF data), which are built by _initCodec() */
+    saf_stateSwap_create(&(pData->hCodecState), binauraliser_destroyCodecPars);
+    pData->pars = NULL;
+    pData->procPars = NULL;
+
     /* hrir data */
     pData->useDefaultHRIRsFLAG=1;
-    pData->hrirs = NULL;
-    pData->hrir_dirs_deg = NULL;
     pData->sofa_filepath = NULL;
     
-    /* vbap (amplitude normalised) */
-    pData->hrtf_vbap_gtableIdx = NULL;
-    pData->hrtf_vbap_gtableComp = NULL;
-    
-    /* HRTF filterbank coefficients */
-    pData->itds_s = NULL;
-    pData->hrtf_fb = NULL;
-    pData->hrtf_fb_mag = NULL;
+    /* interpolated HRTFs */
+    pData->hrtf_interp = (float_complex***)malloc3d(MAX_NUM_INPUTS, pData->nBands, NUM_EARS, sizeof(float_complex));
     
     /* flags/status */
     pData->progressBar0_1 = 0.0f;
     pData->progressBarText = malloc1d(PROGRESSBARTEXT_CHAR_LENGTH*sizeof(char));
     strcpy(pData->progressBarText,"");
     pData->codecStatus = CODEC_STATUS_NOT_INITIALISED;
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
     pData->reInitHRTFsAndGainTables = 1;
     for(ch=0; ch<MAX_NUM_INPUTS; ch++)
         pData->recalc_hrtf_interpFLAG[ch] = 1;
     pData->recalc_M_rotFLAG = 1; 
+
+    /* block-size adaptor */
+    saf_blockAdaptor_create(&(pData->hBlockAdaptor), pData->frameSize, MAX_NUM_INPUTS, NUM_EARS);
 }
 
 
@@ -101,36 +111,22 @@ void binauraliser_destroy
 )
 {
     binauraliser_data *pData = (binauraliser_data*)(*phBin);
-    int ch;
 
     if (pData != NULL) {
-        /* not safe to free memory during intialisation/processing loop */
-        while (pData->codecStatus == CODEC_STATUS_INITIALISING ||
-               pData->procStatus == PROC_STATUS_ONGOING){
+        saf_blockAdaptor_destroy(&(pData->hBlockAdaptor));
+        /* not safe to free the codec states during intialisation (the
+         * processing loop must have already stopped) */
+        while (saf_atomic_loadInt(&(pData->codecStatus)) == CODEC_STATUS_INITIALISING)
             SAF_SLEEP(10);
-        }
+        saf_stateSwap_destroy(&(pData->hCodecState));
         
-        /* free afSTFT and buffers */
-        if(pData->hSTFT !=NULL)
-            afSTFTfree(pData->hSTFT);
-        for(ch=0; ch< MAX_NUM_INPUTS; ch++) {
-            free(pData->STFTInputFrameTF[ch].re);
-            free(pData->STFTInputFrameTF[ch].im);
-        }
-        for (ch = 0; ch< NUM_EARS; ch++) {
-            free(pData->STFTOutputFrameTF[ch].re);
-            free(pData->STFTOutputFrameTF[ch].im);
-        }
-        free(pData->STFTInputFrameTF);
-        free(pData->STFTOutputFrameTF);
-        free(pData->tempHopFrameTD);
-        free(pData->hrtf_vbap_gtableComp);
-        free(pData->hrtf_vbap_gtableIdx);
-        free(pData->hrtf_fb);
-        free(pData->hrtf_fb_mag);
-        free(pData->itds_s);
-        free(pData->hrirs);
-        free(pData->hrir_dirs_deg);
+        /* free buffers */
+        free(pData->inputFrameTD);
+        free(pData->outframeTD);
+        free(pData->inputframeTF);
+        free(pData->outputframeTF);
+        free(pData->freqVector);
+        free(pData->hrtf_interp);
         free(pData->progressBarText);
          
         free(pData);
@@ -145,18 +141,17 @@ void binauraliser_init
 )
 {
     binauraliser_data *pData = (binauraliser_data*)(hBin);
-    int band;
     
-    /* define frequency vector */
-    pData->fs = sampleRate;
-    for(band=0; band <HYBRID_BANDS; band++){
-        if(sampleRate == 44100)
-            pData->freqVector[band] =  (float)__afCenterFreq44100[band];
-        else
-            pData->freqVector[band] =  (float)__afCenterFreq48e3[band];
+    /* define frequency vector (the HRTF equalisation depends on it) */
+    if(pData->fs != sampleRate){
+        pData->fs = sampleRate;
+        afSTFTgetCenterFreqs(pData->hopSize, 1, (float)sampleRate, pData->freqVector);
+        pData->reInitHRTFsAndGainTables = 1;
+        binauraliser_setCodecStatus(hBin, CODEC_STATUS_NOT_INITIALISED);
     }
     /* defaults */
     pData->recalc_M_rotFLAG = 1;
+    saf_blockAdaptor_reset(pData->hBlockAdaptor);
 }
 
 void binauraliser_initCodec
@@ -165,76 +160,88 @@ void binauraliser_initCodec
 )
 {
     binauraliser_data *pData = (binauraliser_data*)(hBin);
+    binauraliser_codecPars* pars;
     
-    if (pData->codecStatus != CODEC_STATUS_NOT_INITIALISED)
+    /* The processing loop keeps running with the current codec state, while
+     * a new one is built here (so neither side ever waits for the other) */
+    if (!saf_atomic_compareExchangeInt(&(pData->codecStatus), CODEC_STATUS_NOT_INITIALISED, CODEC_STATUS_INITIALISING))
         return; /* re-init not required, or already happening */
-    while (pData->procStatus == PROC_STATUS_ONGOING){
-        /* re-init required, but we need to wait for the current processing loop to end */
-        pData->codecStatus = CODEC_STATUS_INITIALISING; /* indicate that we want to init */
-        SAF_SLEEP(10);
-    }
     
     /* for progress bar */
-    pData->codecStatus = CODEC_STATUS_INITIALISING;
     strcpy(pData->progressBarText,"Initialising");
     pData->progressBar0_1 = 0.0f;
     
-    /* check if TFT needs to be reinitialised */
-    binauraliser_initTFT(hBin);
+    /* new afSTFT */
+    pars = (binauraliser_codecPars*)calloc1d(1, sizeof(binauraliser_codecPars));
+    binauraliser_initTFT(hBin, pars);
     
-    /* reinit HRTFs and interpolation tables */
-    if(pData->reInitHRTFsAndGainTables){
-        binauraliser_initHRTFsAndGainTables(hBin);
+    /* reinit HRTFs and interpolation tables, or take them from the previous state */
+    if(pData->reInitHRTFsAndGainTables || pData->pars==NULL){
         pData->reInitHRTFsAndGainTables = 0;
+        binauraliser_initHRTFsAndGainTables(hBin, pars);
     }
+    else
+        binauraliser_copyHRTFsAndGainTables(hBin, pData->pars, pars);
     
-    /* done! */
+    /* hand the new state over to the processing loop */
+    saf_stateSwap_publish(pData->hCodecState, (void*)pars);
+    pData->pars = pars;
+    
+    /* done! (unless a setting changed in the meantime, in which case the
+     * status remains CODEC_STATUS_NOT_INITIALISED) */
     strcpy(pData->progressBarText,"Done!");
     pData->progressBar0_1 = 1.0f;
-    pData->codecStatus = CODEC_STATUS_INITIALISED;
-    
+    saf_atomic_compareExchangeInt(&(pData->codecStatus), CODEC_STATUS_INITIALISING, CODEC_STATUS_INITIALISED);
 }
 
-void binauraliser_process
+/** Processes one frame of frameSize samples (see saf_blockAdaptor_apply()) */
+static void binauraliser_processFrame
 (
     void  *  const hBin,
     float ** const inputs,
     float ** const outputs,
     int            nInputs,
-    int            nOutputs,
-    int            nSamples
+    int            nOutputs
 )
 {
     binauraliser_data *pData = (binauraliser_data*)(hBin);
-    int t, ch, ear, i, band, nSources;
+    binauraliser_codecPars* pars;
+    int t, ch, ear, i, band, nSources, frameSize, nBands, timeSlots;
     float src_dirs[MAX_NUM_INPUTS][2], Rxyz[3][3], hypotxy;
+    float* inPtrs[MAX_NUM_INPUTS], *outPtrs[NUM_EARS];
     int enableRotation;
 
+    /* pick up the latest codec state (never blocks); the interpolated HRTFs
+     * must be recomputed whenever it changes */
+    pars = (binauraliser_codecPars*)saf_stateSwap_acquire(pData->hCodecState);
+    if(pars != pData->procPars){
+        pData->procPars = pars;
+        for(ch=0; ch<MAX_NUM_INPUTS; ch++)
+            pData->recalc_hrtf_interpFLAG[ch] = 1;
+    }
+
     /* copy user parameters to local variables */
-    nSources = pData->nSources;
+    nSources = pars!=NULL ? pars->nSources : 0;
     enableRotation = pData->enableRotation;
     memcpy(src_dirs, pData->src_dirs_deg, MAX_NUM_INPUTS*2*sizeof(float));
+    frameSize = pData->frameSize;
+    nBands = pData->nBands;
+    timeSlots = pData->timeSlots;
 
     /* apply binaural panner */
-    if ((nSamples == FRAME_SIZE) && (pData->hrtf_fb!=NULL) && (pData->codecStatus==CODEC_STATUS_INITIALISED) ){
-        pData->procStatus = PROC_STATUS_ONGOING;
-
-        /* Load time-domain data */
+    if (pars!=NULL){
+        /* Load time-domain data (the host frames are transformed directly) */
         for(i=0; i < MIN(nSources,nInputs); i++)
-            utility_svvcopy(inputs[i], FRAME_SIZE, pData->inputFrameTD[i]);
-        for(; i<nSources; i++)
-            memset(pData->inputFrameTD[i], 0, FRAME_SIZE * sizeof(float));
+            inPtrs[i] = inputs[i];
+        for(; i<nSources; i++){
+            memset(pData->inputFrameTD[i], 0, frameSize * sizeof(float));
+            inPtrs[i] = pData->inputFrameTD[i];
+        }
 
 
         /* Apply time-frequency transform (TFT) */
-        for(t=0; t< TIME_SLOTS; t++) {
-            for(ch = 0; ch < nSources; ch++)
-                utility_svvcopy(&(pData->inputFrameTD[ch][t*HOP_SIZE]), HOP_SIZE, pData->tempHopFrameTD[ch]);
-            afSTFTforward(pData->hSTFT, (float**)pData->tempHopFrameTD, (complexVector*)pData->STFTInputFrameTF);
-            for(band=0; band<HYBRID_BANDS; band++)
-                for(ch=0; ch < nSources; ch++)
-                    pData->inputframeTF[band][ch][t] = cmplxf(pData->STFTInputFrameTF[ch].re[band], pData->STFTInputFrameTF[ch].im[band]);
-        }
+        afSTFTforwardFrame(pars->hSTFT, inPtrs, frameSize, MAX_NUM_INPUTS,
+                           AFSTFT_BANDS_CH_TIME, FLATTEN3D(pData->inputframeTF));
 
         /* Main processing: */
         /* Rotate source directions */
@@ -259,48 +266,71 @@ void binauraliser_process
         }
 
         /* interpolate hrtfs and apply to each source */
-        memset(pData->outputframeTF, 0, HYBRID_BANDS*NUM_EARS*TIME_SLOTS * sizeof(float_complex));
+        memset(FLATTEN3D(pData->outputframeTF), 0, nBands*NUM_EARS*timeSlots * sizeof(float_complex));
         for (ch = 0; ch < nSources; ch++) {
             if(pData->recalc_hrtf_interpFLAG[ch]){
                 if(enableRotation)
-                    binauraliser_interpHRTFs(hBin, pData->src_dirs_rot_deg[ch][0], pData->src_dirs_rot_deg[ch][1], pData->hrtf_interp[ch]);
+                    binauraliser_interpHRTFs(hBin, pars, pData->src_dirs_rot_deg[ch][0], pData->src_dirs_rot_deg[ch][1], pData->hrtf_interp[ch]);
                 else
-                    binauraliser_interpHRTFs(hBin, pData->src_dirs_deg[ch][0], pData->src_dirs_deg[ch][1], pData->hrtf_interp[ch]);
+                    binauraliser_interpHRTFs(hBin, pars, pData->src_dirs_deg[ch][0], pData->src_dirs_deg[ch][1], pData->hrtf_interp[ch]);
                 pData->recalc_hrtf_interpFLAG[ch] = 0;
             }
-            for (band = 0; band < HYBRID_BANDS; band++)
+            for (band = 0; band < nBands; band++)
                 for (ear = 0; ear < NUM_EARS; ear++)
-                    for (t = 0; t < TIME_SLOTS; t++)
-                        pData->outputframeTF[band][ear][t] = ccaddf(pData->outputframeTF[band][ear][t], ccmulf(pData->inputframeTF[band][ch][t], pData->hrtf_interp[ch][band][ear]));
+                    cblas_caxpy(timeSlots, &(pData->hrtf_interp[ch][band][ear]), pData->inputframeTF[band][ch], 1, pData->outputframeTF[band][ear], 1);
         }
 
         /* scale by number of sources */
-        for (band = 0; band < HYBRID_BANDS; band++)
+        for (band = 0; band < nBands; band++)
             for (ear = 0; ear < NUM_EARS; ear++)
-                for (t = 0; t < TIME_SLOTS; t++)
+                for (t = 0; t < timeSlots; t++)
                     pData->outputframeTF[band][ear][t] = crmulf(pData->outputframeTF[band][ear][t], 1.0f/sqrtf((float)nSources));
 
-        /* inverse-TFT */
-        for (t = 0; t < TIME_SLOTS; t++) {
-            for (band = 0; band < HYBRID_BANDS; band++) {
-                for (ch = 0; ch < NUM_EARS; ch++) {
-                    pData->STFTOutputFrameTF[ch].re[band] = crealf(pData->outputframeTF[band][ch][t]);
-                    pData->STFTOutputFrameTF[ch].im[band] = cimagf(pData->outputframeTF[band][ch][t]);
-                }
-            }
-            afSTFTinverse(pData->hSTFT, pData->STFTOutputFrameTF, pData->tempHopFrameTD);
-            for (ch = 0; ch < MIN(NUM_EARS, nOutputs); ch++)
-                utility_svvcopy(pData->tempHopFrameTD[ch], HOP_SIZE, &(outputs[ch][t* HOP_SIZE]));
-            for (; ch < nOutputs; ch++)
-                memset(&(outputs[ch][t* HOP_SIZE]), 0, HOP_SIZE*sizeof(float));
-        }
+        /* inverse-TFT (directly into the host frames, as the inputs have
+         * already been read) */
+        for (ch = 0; ch < NUM_EARS; ch++)
+            outPtrs[ch] = ch < nOutputs ? outputs[ch] : pData->outframeTD[ch];
+        afSTFTinverseFrame(pars->hSTFT, FLATTEN3D(pData->outputframeTF), frameSize, NUM_EARS,
+                           AFSTFT_BANDS_CH_TIME, outPtrs);
+        for (ch = NUM_EARS; ch < nOutputs; ch++)
+            memset(outputs[ch], 0, frameSize*sizeof(float));
     }
     else{
         for (ch=0; ch < nOutputs; ch++)
-            memset(outputs[ch],0, FRAME_SIZE*sizeof(float));
+            memset(outputs[ch],0, frameSize*sizeof(float));
     }
+}
+
+void binauraliser_process
+(
+    void  *  const hBin,
+    float ** const inputs,
+    float ** const outputs,
+    int            nInputs,
+    int            nOutputs,
+    int            nSamples
+)
+{
+    binauraliser_data *pData = (binauraliser_data*)(hBin);
+
+    saf_blockAdaptor_apply(pData->hBlockAdaptor, inputs, outputs, nInputs, nOutputs,
+                           nSamples, binauraliser_processFrame, hBin);
+}
+
+void binauraliser_processInterleaved
+(
+    void  *  const hBin,
+    const float *  inputs,
+    float *        outputs,
+    int            nInputs,
+    int            nOutputs,
+    int            nSamples
+)
+{
+    binauraliser_data *pData = (binauraliser_data*)(hBin);
 
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
+    saf_blockAdaptor_applyStrided(pData->hBlockAdaptor, inputs, 1, nInputs, outputs, 1, nOutputs,
+                                  nInputs, nOutputs, nSamples, binauraliser_processFrame, hBin);
 }
 
 /* Set Functions */
@@ -453,18 +483,33 @@ void binauraliser_setInterpMode(void* const hBin, int newMode)
     pData->interpMode = newMode;
 }
 
+void binauraliser_setLowDelayMode(void* const hBin, int newState)
+{
+    binauraliser_data *pData = (binauraliser_data*)(hBin);
+    if(pData->new_LDmode != (newState ? 1 : 0)){
+        pData->new_LDmode = newState ? 1 : 0;
+        binauraliser_setCodecStatus(hBin, CODEC_STATUS_NOT_INITIALISED);
+    }
+}
+
 
 /* Get Functions */
 
 int binauraliser_getFrameSize(void)
 {
-    return FRAME_SIZE;
+    return DEFAULT_TF_FRAME_SIZE;
+}
+
+int binauraliser_getFrameSizeEx(void* const hBin)
+{
+    binauraliser_data *pData = (binauraliser_data*)(hBin);
+    return pData->frameSize;
 }
 
 CODEC_STATUS binauraliser_getCodecStatus(void* const hBin)
 {
     binauraliser_data *pData = (binauraliser_data*)(hBin);
-    return pData->codecStatus;
+    return (CODEC_STATUS)saf_atomic_loadInt(&(pData->codecStatus));
 }
 
 float binauraliser_getProgressBar0_1(void* const hBin)
@@ -510,20 +555,20 @@ int binauraliser_getNumEars(void)
 int binauraliser_getNDirs(void* const hBin)
 {
     binauraliser_data *pData = (binauraliser_data*)(hBin);
-    return pData->N_hrir_dirs;
+    return pData->pars!=NULL ? pData->pars->N_hrir_dirs : 0;
 }
 
 int binauraliser_getNTriangles(void* const hBin)
 {
     binauraliser_data *pData = (binauraliser_data*)(hBin);
-    return pData->nTriangles;
+    return pData->pars!=NULL ? pData->pars->nTriangles : 0;
 }
 
 float binauraliser_getHRIRAzi_deg(void* const hBin, int index)
 {
     binauraliser_data *pData = (binauraliser_data*)(hBin);
-    if(pData->hrir_dirs_deg!=NULL)
-        return pData->hrir_dirs_deg[index*2+0];
+    if(pData->pars!=NULL)
+        return pData->pars->hrir_dirs_deg[index*2+0];
     else
         return 0.0f;
 }
@@ -531,8 +576,8 @@ float binauraliser_getHRIRAzi_deg(void* const hBin, int index)
 float binauraliser_getHRIRElev_deg(void* const hBin, int index)
 {
     binauraliser_data *pData = (binauraliser_data*)(hBin);
-    if(pData->hrir_dirs_deg!=NULL)
-        return pData->hrir_dirs_deg[index*2+1];
+    if(pData->pars!=NULL)
+        return pData->pars->hrir_dirs_deg[index*2+1];
     else
         return 0.0f;
 }
@@ -540,13 +585,13 @@ float binauraliser_getHRIRElev_deg(void* const hBin, int index)
 int binauraliser_getHRIRlength(void* const hBin)
 {
     binauraliser_data *pData = (binauraliser_data*)(hBin);
-    return pData->hrir_len;
+    return pData->pars!=NULL ? pData->pars->hrir_len : 0;
 }
 
 int binauraliser_getHRIRsamplerate(void* const hBin)
 {
     binauraliser_data *pData = (binauraliser_data*)(hBin);
-    return pData->hrir_fs;
+    return pData->pars!=NULL ? pData->pars->hrir_fs : 0;
 }
 
 int binauraliser_getUseDefaultHRIRsflag(void* const hBin)
@@ -624,9 +669,21 @@ int binauraliser_getInterpMode(void* const hBin)
     return (int)pData->interpMode;
 }
 
-int binauraliser_getProcessingDelay()
+int binauraliser_getLowDelayMode(void* const hBin)
+{
+    binauraliser_data *pData = (binauraliser_data*)(hBin);
+    return pData->new_LDmode;
+}
+
+int binauraliser_getProcessingDelay(void)
 {
-    return 12*HOP_SIZE;
+    return afSTFTgetProcessingDelay(DEFAULT_TF_FRAME_SIZE, 0, 1);
+}
+
+int binauraliser_getProcessingDelayEx(void* const hBin)
+{
+    binauraliser_data *pData = (binauraliser_data*)(hBin);
+    return afSTFTgetProcessingDelay(pData->hopSize, pData->LDmode, 1) + saf_blockAdaptor_getDelay(pData->hBlockAdaptor);
 }
  
     
@@ -34,46 +34,59 @@
 void binauraliser_setCodecStatus(void* const hBin, CODEC_STATUS newStatus)
 {
     binauraliser_data *pData = (binauraliser_data*)(hBin);
-    if(newStatus==CODEC_STATUS_NOT_INITIALISED){
-        /* Pause until current initialisation is complete */
-        while(pData->codecStatus == CODEC_STATUS_INITIALISING)
-            SAF_SLEEP(10);
+    saf_atomic_storeInt(&(pData->codecStatus), (int)newStatus);
+}
+
+void binauraliser_destroyCodecPars(void** const phPars)
+{
+    binauraliser_codecPars *pars = (binauraliser_codecPars*)(*phPars);
+
+    if(pars!=NULL){
+        if(pars->hSTFT!=NULL)
+            afSTFTfree(pars->hSTFT);
+        free(pars->freqVector);
+        free(pars->hrirs);
+        free(pars->hrir_dirs_deg);
+        free(pars->hrtf_vbap_gtableIdx);
+        free(pars->hrtf_vbap_gtableComp);
+        free(pars->itds_s);
+        free(pars->hrtf_fb);
+        free(pars->hrtf_fb_mag);
+        free(pars);
+        *phPars = NULL;
     }
-    pData->codecStatus = newStatus;
 }
 
 void binauraliser_interpHRTFs
 (
     void* const hBin,
+    binauraliser_codecPars* pars,
     float azimuth_deg,
     float elevation_deg,
-    float_complex h_intrp[HYBRID_BANDS][NUM_EARS]
+    float_complex** h_intrp
 )
 {
     binauraliser_data *pData = (binauraliser_data*)(hBin);
-    int i, band;
+    int i, band, hrirIdx3[3];
     int aziIndex, elevIndex, N_azi, idx3d;
     float_complex ipd;
     float aziRes, elevRes, weights[3], itds3[3],  itdInterp;
-    float magnitudes3[HYBRID_BANDS][3][NUM_EARS], magInterp[HYBRID_BANDS][NUM_EARS];
+    float magnitudes3[3][NUM_EARS], magInterp[NUM_EARS];
      
     /* find closest pre-computed VBAP direction */
-    aziRes = (float)pData->hrtf_vbapTableRes[0];
-    elevRes = (float)pData->hrtf_vbapTableRes[1];
+    aziRes = (float)pars->hrtf_vbapTableRes[0];
+    elevRes = (float)pars->hrtf_vbapTableRes[1];
     N_azi = (int)(360.0f / aziRes + 0.5f) + 1;
     aziIndex = (int)(matlab_fmodf(azimuth_deg + 180.0f, 360.0f) / aziRes + 0.5f);
     elevIndex = (int)((elevation_deg + 90.0f) / elevRes + 0.5f);
     idx3d = elevIndex * N_azi + aziIndex;
     for (i = 0; i < 3; i++)
-        weights[i] = pData->hrtf_vbap_gtableComp[idx3d*3 + i];
+        weights[i] = pars->hrtf_vbap_gtableComp[idx3d*3 + i];
     
-    /* retrieve the 3 itds and hrtf magnitudes */
+    /* retrieve the 3 itds */
     for (i = 0; i < 3; i++) {
-        itds3[i] = pData->itds_s[pData->hrtf_vbap_gtableIdx[idx3d*3+i]];
-        for (band = 0; band < HYBRID_BANDS; band++) {
-            magnitudes3[band][i][0] = pData->hrtf_fb_mag[band*NUM_EARS*(pData->N_hrir_dirs) + 0*(pData->N_hrir_dirs) + pData->hrtf_vbap_gtableIdx[idx3d*3+i]];
-            magnitudes3[band][i][1] = pData->hrtf_fb_mag[band*NUM_EARS*(pData->N_hrir_dirs) + 1*(pData->N_hrir_dirs) + pData->hrtf_vbap_gtableIdx[idx3d*3+i]];
-        }
+        hrirIdx3[i] = pars->hrtf_vbap_gtableIdx[idx3d*3+i];
+        itds3[i] = pars->itds_s[hrirIdx3[i]];
     }
     
     /* interpolate hrtf magnitudes and itd */
@@ -81,22 +94,25 @@ void binauraliser_interpHRTFs
                 (float*)weights, 3,
                 (float*)itds3, 1, 0.0f,
                 &itdInterp, 1);
-    for (band = 0; band < HYBRID_BANDS; band++) {
+    for (band = 0; band < pData->nBands; band++) {
+        /* retrieve the 3 hrtf magnitudes for this band */
+        for (i = 0; i < 3; i++) {
+            magnitudes3[i][0] = pars->hrtf_fb_mag[band*NUM_EARS*(pars->N_hrir_dirs) + 0*(pars->N_hrir_dirs) + hrirIdx3[i]];
+            magnitudes3[i][1] = pars->hrtf_fb_mag[band*NUM_EARS*(pars->N_hrir_dirs) + 1*(pars->N_hrir_dirs) + hrirIdx3[i]];
+        }
         cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, 1, 2, 3, 1.0f,
                     (float*)weights, 3,
-                    (float*)magnitudes3[band], 2, 0.0f,
-                    (float*)magInterp[band], 2);
-    }
-    
-    /* introduce interaural phase difference */
-    for (band = 0; band < HYBRID_BANDS; band++) {
-        ipd = cmplxf(0.0f, (matlab_fmodf(2.0f*M_PI*(pData->freqVector[band]) * itdInterp + M_PI, 2.0f*M_PI) - M_PI)/2.0f); 
-        h_intrp[band][0] = crmulf(cexpf(ipd), magInterp[band][0]);
-        h_intrp[band][1] = crmulf(conjf(cexpf(ipd)), magInterp[band][1]);
+                    (float*)magnitudes3, 2, 0.0f,
+                    (float*)magInterp, 2);
+
+        /* introduce interaural phase difference */
+        ipd = cmplxf(0.0f, (matlab_fmodf(2.0f*M_PI*(pars->freqVector[band]) * itdInterp + M_PI, 2.0f*M_PI) - M_PI)/2.0f); 
+        h_intrp[band][0] = crmulf(cexpf(ipd), magInterp[0]);
+        h_intrp[band][1] = crmulf(conjf(cexpf(ipd)), magInterp[1]);
     }
 }
 
-void binauraliser_initHRTFsAndGainTables(void* const hBin)
+void binauraliser_initHRTFsAndGainTables(void* const hBin, binauraliser_codecPars* pars)
 {
     binauraliser_data *pData = (binauraliser_data*)(hBin);
     int i;
@@ -108,74 +124,111 @@ void binauraliser_initHRTFsAndGainTables(void* const hBin)
     /* load sofa file or load default hrir data */
     if(!pData->useDefaultHRIRsFLAG && pData->sofa_filepath!=NULL){
         loadSofaFile(pData->sofa_filepath,
-                     &(pData->hrirs),
-                     &(pData->hrir_dirs_deg),
-                     &(pData->N_hrir_dirs),
-                     &(pData->hrir_len),
-                     &(pData->hrir_fs));
+                     &(pars->hrirs),
+                     &(pars->hrir_dirs_deg),
+                     &(pars->N_hrir_dirs),
+                     &(pars->hrir_len),
+                     &(pars->hrir_fs));
     }
     else{
         loadSofaFile(NULL, /* setting path to NULL loads default HRIR data */
-                     &(pData->hrirs),
-                     &(pData->hrir_dirs_deg),
-                     &(pData->N_hrir_dirs),
-                     &(pData->hrir_len),
-                     &(pData->hrir_fs));
+                     &(pars->hrirs),
+                     &(pars->hrir_dirs_deg),
+                     &(pars->N_hrir_dirs),
+                     &(pars->hrir_len),
+                     &(pars->hrir_fs));
     }
     
     /* estimate the ITDs for each HRIR */
-    pData->itds_s = realloc1d(pData->itds_s, pData->N_hrir_dirs*sizeof(float));
-    estimateITDs(pData->hrirs, pData->N_hrir_dirs, pData->hrir_len, pData->hrir_fs, pData->itds_s);
+    pars->itds_s = realloc1d(pars->itds_s, pars->N_hrir_dirs*sizeof(float));
+    estimateITDs(pars->hrirs, pars->N_hrir_dirs, pars->hrir_len, pars->hrir_fs, pars->itds_s);
     
     /* generate VBAP gain table */
     strcpy(pData->progressBarText,"Generating interpolation table");
     pData->progressBar0_1 = 0.6f;
     hrtf_vbap_gtable = NULL;
-    pData->hrtf_vbapTableRes[0] = 2;
-    pData->hrtf_vbapTableRes[1] = 5;
-    generateVBAPgainTable3D(pData->hrir_dirs_deg, pData->N_hrir_dirs, pData->hrtf_vbapTableRes[0], pData->hrtf_vbapTableRes[1], 1, 0, 0.0f,
-                            &hrtf_vbap_gtable, &(pData->N_hrtf_vbap_gtable), &(pData->nTriangles));
+    pars->hrtf_vbapTableRes[0] = 2;
+    pars->hrtf_vbapTableRes[1] = 5;
+    generateVBAPgainTable3D(pars->hrir_dirs_deg, pars->N_hrir_dirs, pars->hrtf_vbapTableRes[0], pars->hrtf_vbapTableRes[1], 1, 0, 0.0f,
+                            &hrtf_vbap_gtable, &(pars->N_hrtf_vbap_gtable), &(pars->nTriangles));
     if(hrtf_vbap_gtable==NULL){
         /* if generating vbap gain tabled failed, re-calculate with default HRIR set */
         pData->useDefaultHRIRsFLAG = 1;
-        binauraliser_initHRTFsAndGainTables(hBin);
+        binauraliser_initHRTFsAndGainTables(hBin, pars);
+        return;
     }
     
     /* compress VBAP table (i.e. remove the zero elements) */
-    pData->hrtf_vbap_gtableComp = realloc1d(pData->hrtf_vbap_gtableComp, pData->N_hrtf_vbap_gtable * 3 * sizeof(float));
-    pData->hrtf_vbap_gtableIdx  = realloc1d(pData->hrtf_vbap_gtableIdx,  pData->N_hrtf_vbap_gtable * 3 * sizeof(int));
-    compressVBAPgainTable3D(hrtf_vbap_gtable, pData->N_hrtf_vbap_gtable, pData->N_hrir_dirs, pData->hrtf_vbap_gtableComp, pData->hrtf_vbap_gtableIdx);
+    pars->hrtf_vbap_gtableComp = realloc1d(pars->hrtf_vbap_gtableComp, pars->N_hrtf_vbap_gtable * 3 * sizeof(float));
+    pars->hrtf_vbap_gtableIdx  = realloc1d(pars->hrtf_vbap_gtableIdx,  pars->N_hrtf_vbap_gtable * 3 * sizeof(int));
+    compressVBAPgainTable3D(hrtf_vbap_gtable, pars->N_hrtf_vbap_gtable, pars->N_hrir_dirs, pars->hrtf_vbap_gtableComp, pars->hrtf_vbap_gtableIdx);
     
     /* convert hrirs to filterbank coefficients */
     strcpy(pData->progressBarText,"Applying HRIR diffuse-field EQ");
     pData->progressBar0_1 = 0.8f;
-    pData->hrtf_fb = realloc1d(pData->hrtf_fb, HYBRID_BANDS * NUM_EARS * (pData->N_hrir_dirs)*sizeof(float_complex));
-    HRIRs2FilterbankHRTFs(pData->hrirs, pData->N_hrir_dirs, pData->hrir_len, HOP_SIZE, 1, pData->hrtf_fb);
-    diffuseFieldEqualiseHRTFs(pData->N_hrir_dirs, pData->itds_s, pData->freqVector, HYBRID_BANDS, pData->hrtf_fb);
+    pars->hrtf_fb = realloc1d(pars->hrtf_fb, pData->nBands * NUM_EARS * (pars->N_hrir_dirs)*sizeof(float_complex));
+    HRIRs2FilterbankHRTFs(pars->hrirs, pars->N_hrir_dirs, pars->hrir_len, pData->hopSize, 1, pars->hrtf_fb);
+    diffuseFieldEqualiseHRTFs(pars->N_hrir_dirs, pars->itds_s, pars->freqVector, pData->nBands, pars->hrtf_fb);
     
     /* calculate magnitude responses */
-    pData->hrtf_fb_mag = realloc1d(pData->hrtf_fb_mag, HYBRID_BANDS*NUM_EARS*(pData->N_hrir_dirs)*sizeof(float)); 
-    for(i=0; i<HYBRID_BANDS*NUM_EARS* (pData->N_hrir_dirs); i++)
-        pData->hrtf_fb_mag[i] = cabsf(pData->hrtf_fb[i]);
+    pars->hrtf_fb_mag = realloc1d(pars->hrtf_fb_mag, pData->nBands*NUM_EARS*(pars->N_hrir_dirs)*sizeof(float)); 
+    for(i=0; i<pData->nBands*NUM_EARS* (pars->N_hrir_dirs); i++)
+        pars->hrtf_fb_mag[i] = cabsf(pars->hrtf_fb[i]);
     
     /* clean-up */
     free(hrtf_vbap_gtable);
 }
 
+void binauraliser_copyHRTFsAndGainTables
+(
+    void* const hBin,
+    binauraliser_codecPars* src,
+    binauraliser_codecPars* dst
+)
+{
+    binauraliser_data *pData = (binauraliser_data*)(hBin);
+    int nBands;
+
+    nBands = pData->nBands;
+    dst->N_hrir_dirs = src->N_hrir_dirs;
+    dst->hrir_len = src->hrir_len;
+    dst->hrir_fs = src->hrir_fs;
+    dst->hrirs = malloc1d(src->N_hrir_dirs*NUM_EARS*src->hrir_len*sizeof(float));
+    memcpy(dst->hrirs, src->hrirs, src->N_hrir_dirs*NUM_EARS*src->hrir_len*sizeof(float));
+    dst->hrir_dirs_deg = malloc1d(src->N_hrir_dirs*2*sizeof(float));
+    memcpy(dst->hrir_dirs_deg, src->hrir_dirs_deg, src->N_hrir_dirs*2*sizeof(float));
+    memcpy(dst->hrtf_vbapTableRes, src->hrtf_vbapTableRes, 2*sizeof(int));
+    dst->N_hrtf_vbap_gtable = src->N_hrtf_vbap_gtable;
+    dst->nTriangles = src->nTriangles;
+    dst->hrtf_vbap_gtableIdx = malloc1d(src->N_hrtf_vbap_gtable*3*sizeof(int));
+    memcpy(dst->hrtf_vbap_gtableIdx, src->hrtf_vbap_gtableIdx, src->N_hrtf_vbap_gtable*3*sizeof(int));
+    dst->hrtf_vbap_gtableComp = malloc1d(src->N_hrtf_vbap_gtable*3*sizeof(float));
+    memcpy(dst->hrtf_vbap_gtableComp, src->hrtf_vbap_gtableComp, src->N_hrtf_vbap_gtable*3*sizeof(float));
+    dst->itds_s = malloc1d(src->N_hrir_dirs*sizeof(float));
+    memcpy(dst->itds_s, src->itds_s, src->N_hrir_dirs*sizeof(float));
+    dst->hrtf_fb = malloc1d(nBands*NUM_EARS*(src->N_hrir_dirs)*sizeof(float_complex));
+    memcpy(dst->hrtf_fb, src->hrtf_fb, nBands*NUM_EARS*(src->N_hrir_dirs)*sizeof(float_complex));
+    dst->hrtf_fb_mag = malloc1d(nBands*NUM_EARS*(src->N_hrir_dirs)*sizeof(float));
+    memcpy(dst->hrtf_fb_mag, src->hrtf_fb_mag, nBands*NUM_EARS*(src->N_hrir_dirs)*sizeof(float));
+}
+
 void binauraliser_initTFT
 (
-    void* const hBin
+    void* const hBin,
+    binauraliser_codecPars* pars
 )
 {
     binauraliser_data *pData = (binauraliser_data*)(hBin);
- 
-    if(pData->hSTFT==NULL)
-        afSTFTinit(&(pData->hSTFT), HOP_SIZE, pData->new_nSources, NUM_EARS, 0, 1);
-    else if(pData->new_nSources!=pData->nSources){
-        afSTFTchannelChange(pData->hSTFT, pData->new_nSources, NUM_EARS);
-        afSTFTclearBuffers(pData->hSTFT);
-    }
+
+    /* a new afSTFT is created for every codec state, as the one of the
+     * current state may still be in use by the processing loop */
+    pData->LDmode = pData->new_LDmode;
     pData->nSources = pData->new_nSources;
+    pars->LDmode = pData->LDmode;
+    pars->nSources = pData->nSources;
+    afSTFTinit(&(pars->hSTFT), pData->hopSize, pars->nSources, NUM_EARS, pars->LDmode, 1);
+    pars->freqVector = malloc1d(pData->nBands*sizeof(float));
+    memcpy(pars->freqVector, pData->freqVector, pData->nBands*sizeof(float));
 }
 
 void binauraliser_loadPreset
@@ -47,12 +47,6 @@ extern "C" {
 /*                            Internal Parameters                             */
 /* ========================================================================== */
 
-#ifndef FRAME_SIZE
-# define FRAME_SIZE ( 128 )
-#endif
-#define HOP_SIZE ( 128 )                                    /* STFT hop size = nBands */
-#define HYBRID_BANDS ( HOP_SIZE + 5 )                       /* hybrid mode incurs an additional 5 bands  */
-#define TIME_SLOTS ( FRAME_SIZE / HOP_SIZE )                /* 4/8/16 */
 #ifndef DEG2RAD
 # define DEG2RAD(x) (x * M_PI / 180.0f)
 #endif
@@ -66,49 +60,79 @@ extern "C" {
 /* ========================================================================== */
 
 /**
- * Main structure for binauraliser. Contains variables for audio buffers,
- * afSTFT, HRTFs, internal variables, flags, user parameters
+ * Codec state of binauraliser: the afSTFT and HRTF data for one configuration
+ *
+ * A new state is built by binauraliser_initCodec() and handed over to the
+ * processing loop via a saf_stateSwap (see saf_stateSwap_create()). Once
+ * published, it is no longer modified; except for the afSTFT buffers, which
+ * only the processing loop uses.
  */
-typedef struct _binauraliser
+typedef struct _binauraliser_codecPars
 {
-    /* audio buffers */
-    float inputFrameTD[MAX_NUM_INPUTS][FRAME_SIZE];
-    float outframeTD[NUM_EARS][FRAME_SIZE];
-    float_complex inputframeTF[HYBRID_BANDS][MAX_NUM_INPUTS][TIME_SLOTS];
-    float_complex outputframeTF[HYBRID_BANDS][NUM_EARS][TIME_SLOTS];
-    complexVector* STFTInputFrameTF;
-    complexVector* STFTOutputFrameTF;
-    float** tempHopFrameTD;
-    int fs;
-    float freqVector[HYBRID_BANDS]; 
-    void* hSTFT;
-    
+    /* afSTFT */
+    int nSources;                    /**< number of sources the afSTFT is initialised for */
+    int LDmode;                      /**< low-delay mode of the afSTFT */
+    void* hSTFT;                     /**< afSTFT handle */
+    float* freqVector;               /**< band centre frequencies; nBands x 1 */
+
     /* sofa file info */
-    char* sofa_filepath; 
-    float* hrirs;
-    float* hrir_dirs_deg;
+    float* hrirs;                    /**< HRIRs; N_hrir_dirs x NUM_EARS x hrir_len */
+    float* hrir_dirs_deg;            /**< HRIR directions; N_hrir_dirs x 2 */
     int N_hrir_dirs;
     int hrir_len;
     int hrir_fs;
-    
+
     /* vbap gain table */
     int hrtf_vbapTableRes[2];
     int N_hrtf_vbap_gtable;
     int* hrtf_vbap_gtableIdx;        /**< N_hrtf_vbap_gtable x 3 */
     float* hrtf_vbap_gtableComp;     /**< N_hrtf_vbap_gtable x 3 */
-    
+    int nTriangles;
+
     /* hrir filterbank coefficients */
-    int useDefaultHRIRsFLAG; 
-    float* itds_s;                   /**< interaural-time differences for each HRIR (in seconds); nBands x 1 */
+    float* itds_s;                   /**< interaural-time differences for each HRIR (in seconds); N_hrir_dirs x 1 */
     float_complex* hrtf_fb;          /**< hrtf filterbank coefficients; nBands x nCH x N_hrirs */
     float* hrtf_fb_mag;              /**< magnitudes of the hrtf filterbank coefficients; nBands x nCH x N_hrirs */
-    float_complex hrtf_interp[MAX_NUM_INPUTS][HYBRID_BANDS][NUM_EARS];
+
+}binauraliser_codecPars;
+
+/**
+ * Main structure for binauraliser. Contains variables for audio buffers,
+ * codec states, internal variables, flags, user parameters
+ */
+typedef struct _binauraliser
+{
+    /* audio buffers */
+    int frameSize;                  /**< processing frame size, in samples (fixed at creation) */
+    int hopSize;                    /**< afSTFT hop size, in samples */
+    int nBands;                     /**< number of (hybrid) frequency bands; hopSize + 5 */
+    int timeSlots;                  /**< number of time slots per frame; frameSize / hopSize */
+    int LDmode;                     /**< low-delay mode of the latest codec state */
+    int new_LDmode;                 /**< new low-delay mode; applied when the afSTFT is re-initialised */
+    float** inputFrameTD;           /**< MAX_NUM_INPUTS x frameSize */
+    float** outframeTD;             /**< NUM_EARS x frameSize */
+    float_complex*** inputframeTF;  /**< nBands x MAX_NUM_INPUTS x timeSlots */
+    float_complex*** outputframeTF; /**< nBands x NUM_EARS x timeSlots */
+    int fs;
+    float* freqVector;              /**< nBands x 1 */
+    void* hBlockAdaptor;
+
+    /* codec states */
+    void* hCodecState;                /**< saf_stateSwap handing binauraliser_codecPars to the processing loop */
+    binauraliser_codecPars* pars;     /**< latest codec state built by binauraliser_initCodec() (NULL if none) */
+    binauraliser_codecPars* procPars; /**< codec state last used by the processing loop (only accessed by it) */
+    
+    /* sofa file info */
+    char* sofa_filepath; 
+    int useDefaultHRIRsFLAG; 
+    
+    /* hrtf interpolation */
+    float_complex*** hrtf_interp;    /**< interpolated HRTFs; MAX_NUM_INPUTS x nBands x NUM_EARS */
     
     /* flags/status */
-    CODEC_STATUS codecStatus;
+    volatile int codecStatus;        /**< see #_CODEC_STATUS enum */
     float progressBar0_1;
     char* progressBarText;
-    PROC_STATUS procStatus;
     int recalc_hrtf_interpFLAG[MAX_NUM_INPUTS];
     int reInitHRTFsAndGainTables;
     int recalc_M_rotFLAG;
@@ -117,7 +141,6 @@ typedef struct _binauraliser
     float src_dirs_rot_deg[MAX_NUM_INPUTS][2];
     float src_dirs_rot_xyz[MAX_NUM_INPUTS][3];
     float src_dirs_xyz[MAX_NUM_INPUTS][3]; 
-    int nTriangles;
     int input_nDims;  
     int output_nDims;
     
@@ -140,10 +163,21 @@ typedef struct _binauraliser
 
 /**
  * Sets codec status (see #_CODEC_STATUS enum)
+ *
+ * This never waits: if the codec is being initialised, then setting
+ * #CODEC_STATUS_NOT_INITIALISED causes binauraliser_initCodec() to leave the
+ * status as such, so that the next call re-initialises the codec again.
  */
 void binauraliser_setCodecStatus(void* const hBin,
                                  CODEC_STATUS newStatus);
 
+/**
+ * Destroys a codec state (see saf_stateSwap_destroyFn)
+ *
+ * @param[in] phPars (&) address of the binauraliser_codecPars
+ */
+void binauraliser_destroyCodecPars(void** const phPars);
+
 /**
  * Interpolates between (up to) 3 HRTFs via amplitude-normalised VBAP gains.
  *
@@ -151,29 +185,43 @@ void binauraliser_setCodecStatus(void* const hBin,
  * re-introducing the phase.
  *
  * @param[in]  hBin          binauraliser handle
+ * @param[in]  pars          Codec state holding the HRTF data
  * @param[in]  azimuth_deg   Source azimuth in DEGREES
  * @param[in]  elevation_deg Source elevation in DEGREES
- * @param[out] h_intrp       Interpolated HRTF
+ * @param[out] h_intrp       Interpolated HRTF; nBands x NUM_EARS
  */
 void binauraliser_interpHRTFs(void* const hBin,
+                              binauraliser_codecPars* pars,
                               float azimuth_deg,
                               float elevation_deg,
-                              float_complex h_intrp[HYBRID_BANDS][NUM_EARS]);
+                              float_complex** h_intrp);
 
 /**
- * Initialise the HRTFs: either loading the default set or loading from a SOFA
- * file; and then generate a VBAP gain table for interpolation.
+ * Initialise the HRTFs of a new codec state: either loading the default set or
+ * loading from a SOFA file; and then generate a VBAP gain table for
+ * interpolation.
  *
- * @note Call binauraliser_initTFT() (if needed) before calling this function
+ * @note Call binauraliser_initTFT() before calling this function
+ */
+void binauraliser_initHRTFsAndGainTables(void* const hBin,
+                                         binauraliser_codecPars* pars);
+
+/**
+ * Copies the HRTFs and VBAP gain table of a previous codec state into a new
+ * one (for when only the afSTFT configuration has changed)
  */
-void binauraliser_initHRTFsAndGainTables(void* const hBin);
+void binauraliser_copyHRTFsAndGainTables(void* const hBin,
+                                         binauraliser_codecPars* src,
+                                         binauraliser_codecPars* dst);
 
 /**
- * Initialise the filterbank used by binauraliser.
+ * Initialise the filterbank of a new codec state, for the current number of
+ * sources and low-delay mode.
  *
  * @note Call this function before binauraliser_initHRTFsAndGainTables()
  */
-void binauraliser_initTFT(void* const hBin);
+void binauraliser_initTFT(void* const hBin,
+                          binauraliser_codecPars* pars);
 
 /**
  * Returns the source directions for a specified source config preset.
@@ -40,10 +40,23 @@ void dirass_create
 (
     void ** const phDir
 )
+{
+    dirass_createWithFrameSize(phDir, FRAME_SIZE);
+}
+
+void dirass_createWithFrameSize
+(
+    void ** const phDir,
+    int frameSize
+)
 {
     dirass_data* pData = (dirass_data*)malloc1d(sizeof(dirass_data));
     *phDir = (void*)pData;
-    int i;
+
+    /* Frame size (fixed for the lifetime of the instance) */
+    pData->frameSize = IS_VALID_TF_FRAME_SIZE(frameSize) ? frameSize : FRAME_SIZE;
+    pData->SHframeTD = (float**)malloc2d(MAX_NUM_INPUT_SH_SIGNALS, pData->frameSize, sizeof(float));
+    pData->SHframe_upTD = (float**)malloc2d(MAX_NUM_DISPLAY_SH_SIGNALS, pData->frameSize, sizeof(float));
 
     /* Default user parameters */
     pData->inputOrder = pData->new_inputOrder = SH_ORDER_FIRST;
@@ -60,41 +73,25 @@ void dirass_create
     pData->HFOVoption = HFOV_360;
     pData->aspectRatioOption = ASPECT_RATIO_2_1;
 
-    /* codec data */
-    pData->pars = (dirass_codecPars*)malloc1d(sizeof(dirass_codecPars));
-    dirass_codecPars* pars = pData->pars;
-    pars->interp_dirs_deg = NULL;
-    pars->interp_dirs_rad = NULL;
-    pars->Y_up = NULL;
-    pars->interp_table = NULL;
-    pars->w = NULL;
-    pars->Cw = NULL;
-    pars->Uw = NULL;
-    pars->Cxyz = NULL;
-    pars->ss = NULL;
-    pars->ssxyz = NULL;
-    pars->est_dirs = NULL;
-    pars->est_dirs_idx = NULL;
-    pars->prev_intensity = NULL;
-    pars->prev_energy = NULL;
+    /* codec states (scanning grid and beamforming weights), which are built
+     * by _initCodec() */
+    saf_stateSwap_create(&(pData->hCodecState), dirass_destroyCodecPars);
+    pData->procPars = NULL;
     
     /* internal */
     pData->progressBar0_1 = 0.0f;
     pData->progressBarText = malloc1d(PROGRESSBARTEXT_CHAR_LENGTH*sizeof(char));
     strcpy(pData->progressBarText,"");
     pData->codecStatus = CODEC_STATUS_NOT_INITIALISED;
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
 
     /* display */
-    pData->pmap = NULL;
-    for(i=0; i<NUM_DISP_SLOTS; i++)
-        pData->pmap_grid[i] = NULL;
-    pData->pmapReady = 0;
+    pData->dispSlotIdx = 0;
+    pData->dispPars = NULL;
     pData->recalcPmap = 1;
+    pData->resetPmapAvg = 0;
 
-    /* set FIFO buffers */
-    pData->FIFO_idx = 0;
-    memset(pData->inFIFO, 0, MAX_NUM_INPUT_SH_SIGNALS*FRAME_SIZE*sizeof(float));
+    /* block-size adaptor */
+    saf_blockAdaptor_create(&(pData->hBlockAdaptor), pData->frameSize, MAX_NUM_INPUT_SH_SIGNALS, 0);
 }
 
 void dirass_destroy
@@ -103,37 +100,18 @@ void dirass_destroy
 )
 {
     dirass_data *pData = (dirass_data*)(*phDir);
-    dirass_codecPars* pars;
-    int i;
     
     if (pData != NULL) {
-        /* not safe to free memory during intialisation/processing loop */
-        while (pData->codecStatus == CODEC_STATUS_INITIALISING ||
-               pData->procStatus == PROC_STATUS_ONGOING){
+        /* not safe to free the codec states during intialisation (the
+         * processing loop must have already stopped) */
+        while (saf_atomic_loadInt(&(pData->codecStatus)) == CODEC_STATUS_INITIALISING)
             SAF_SLEEP(10);
-        }
+        saf_stateSwap_destroy(&(pData->hCodecState));
         
-        if(pData->pmap!=NULL)
-            free(pData->pmap);
-        for(i=0; i<NUM_DISP_SLOTS; i++)
-            free(pData->pmap_grid[i]);
-
-        pars = pData->pars; 
-        free(pars->interp_dirs_deg);
-        free(pars->Y_up);
-        free(pars->interp_table);
-        free(pars->ss);
-        free(pars->ssxyz);
-        free(pars->Cxyz);
-        free(pars->w);
-        free(pars->Cw);
-        free(pars->Uw);
-        free(pars->est_dirs);
-        free(pars->prev_intensity);
-        free(pars->prev_energy);
-        
-        free(pData->pars);
+        free(pData->SHframeTD);
+        free(pData->SHframe_upTD);
         free(pData->progressBarText);
+        saf_blockAdaptor_destroy(&(pData->hBlockAdaptor));
         free(pData);
         pData = NULL;
     }
@@ -146,19 +124,16 @@ void dirass_init
 )
 {
     dirass_data *pData = (dirass_data*)(hDir);
-    dirass_codecPars* pars = pData->pars;
 
     pData->fs = sampleRate;
     
     /* intialise parameters */
-    if(pars->prev_intensity!=NULL)
-        memset(pars->prev_intensity, 0, pars->grid_nDirs*3*sizeof(float));
-    if(pars->prev_energy!=NULL)
-        memset(pars->prev_energy, 0, pars->grid_nDirs*sizeof(float));
+    pData->resetPmapAvg = 1;
     memset(pData->Wz12_hpf, 0, MAX_NUM_INPUT_SH_SIGNALS*2*sizeof(float));
     memset(pData->Wz12_lpf, 0, MAX_NUM_INPUT_SH_SIGNALS*2*sizeof(float));
-    pData->pmapReady = 0;
+    saf_atomic_storePtr(&(pData->dispPars), NULL);
     pData->dispSlotIdx = 0;
+    saf_blockAdaptor_reset(pData->hBlockAdaptor);
 }
 
 void dirass_initCodec
@@ -167,41 +142,46 @@ void dirass_initCodec
 )
 {
     dirass_data *pData = (dirass_data*)(hDir);
+    dirass_codecPars* pars;
     
-    if (pData->codecStatus != CODEC_STATUS_NOT_INITIALISED)
+    /* The processing loop keeps running with the current codec state, while
+     * a new one is built here (so neither side ever waits for the other) */
+    if (!saf_atomic_compareExchangeInt(&(pData->codecStatus), CODEC_STATUS_NOT_INITIALISED, CODEC_STATUS_INITIALISING))
         return; /* re-init not required, or already happening */
-    while (pData->procStatus == PROC_STATUS_ONGOING){
-        /* re-init required, but we need to wait for the current processing loop to end */
-        pData->codecStatus = CODEC_STATUS_INITIALISING; /* indicate that we want to init */
-        SAF_SLEEP(10);
-    }
     
     /* for progress bar */
-    pData->codecStatus = CODEC_STATUS_INITIALISING;
     strcpy(pData->progressBarText,"Initialising");
     pData->progressBar0_1 = 0.0f;
     
-    dirass_initAna(hDir);
+    pars = (dirass_codecPars*)calloc1d(1, sizeof(dirass_codecPars));
+    dirass_initAna(hDir, pars);
     
-    /* done! */
+    /* hand the new state over to the processing loop */
+    saf_stateSwap_publish(pData->hCodecState, (void*)pars);
+    pData->inputOrder = pars->inputOrder;
+    pData->upscaleOrder = pars->upscaleOrder;
+    
+    /* done! (unless a setting changed in the meantime, in which case the
+     * status remains CODEC_STATUS_NOT_INITIALISED) */
     strcpy(pData->progressBarText,"Done!");
     pData->progressBar0_1 = 1.0f;
-    pData->codecStatus = CODEC_STATUS_INITIALISED;
+    saf_atomic_compareExchangeInt(&(pData->codecStatus), CODEC_STATUS_INITIALISING, CODEC_STATUS_INITIALISED);
 }
 
 
-void dirass_analysis
+/** Analyses one frame of frameSize samples (see saf_blockAdaptor_apply()) */
+static void dirass_analysisFrame
 (
     void  *  const hDir,
     float ** const inputs,
+    float ** const outputs,
     int            nInputs,
-    int            nSamples,
-    int            isPlaying
+    int            nOutputs
 )
 {
     dirass_data *pData = (dirass_data*)(hDir);
-    dirass_codecPars* pars = pData->pars;
-    int s, i, j, k, ch, sec_nSH, secOrder, nSH, up_nSH;
+    dirass_codecPars* pars;
+    int i, j, k, ch, sec_nSH, secOrder, nSH, up_nSH, frameSize;
     float intensity[3];
     
     /* local copy of user parameters */
@@ -209,214 +189,235 @@ void dirass_analysis
     float pmapAvgCoeff, minFreq_hz, maxFreq_hz;
     NORM_TYPES norm;
     CH_ORDER chOrdering;
+
+    /* pick up the latest codec state (never blocks); the display slots start
+     * afresh whenever it changes */
+    pars = (dirass_codecPars*)saf_stateSwap_acquire(pData->hCodecState);
+    if(pars != pData->procPars){
+        saf_atomic_storePtr(&(pData->dispPars), NULL);
+        pData->procPars = pars;
+        pData->dispSlotIdx = 0;
+        pData->resetPmapAvg = 0;
+    }
+
+    frameSize = pData->frameSize;
     norm = pData->norm;
     chOrdering = pData->chOrdering;
     pmapAvgCoeff = pData->pmapAvgCoeff;
     DirAssMode = pData->DirAssMode;
-    upscaleOrder = pData->upscaleOrder;
+    upscaleOrder = pars!=NULL ? pars->upscaleOrder : 1;
     minFreq_hz = pData->minFreq_hz;
     maxFreq_hz = pData->maxFreq_hz;
-    inputOrder = pData->inputOrder;
+    inputOrder = pars!=NULL ? pars->inputOrder : 1;
     secOrder = inputOrder-1;
     nSH = (inputOrder+1)*(inputOrder+1);
     sec_nSH = (secOrder+1)*(secOrder+1);
     up_nSH = (upscaleOrder+1)*(upscaleOrder+1);
 
-    /* Loop over all samples */
-    for(s=0; s<nSamples; s++){
-        /* Load input signals into inFIFO buffer */
+    /* (analysis only, no outputs) */
+    (void)outputs;
+    (void)nOutputs;
+
+    /* Process frame if codec is ready for it */
+    if (pars != NULL) {
+        /* Load time-domain data */
         for(ch=0; ch<MIN(nInputs,nSH); ch++)
-            pData->inFIFO[ch][pData->FIFO_idx] = inputs[ch][s];
+            memcpy(pData->SHframeTD[ch], inputs[ch], frameSize*sizeof(float));
         for(; ch<nSH; ch++) /* Zero any channels that were not given */
-            pData->inFIFO[ch][pData->FIFO_idx] = 0.0f;
-
-        /* Increment buffer index */
-        pData->FIFO_idx++;
+            memset(pData->SHframeTD[ch], 0, frameSize*sizeof(float));
+
+        /* account for input channel order */
+        switch(chOrdering){
+            case CH_ACN: /* already ACN */
+                break;
+            case CH_FUMA:
+                convertHOAChannelConvention(FLATTEN2D(pData->SHframeTD), inputOrder, frameSize, HOA_CH_ORDER_FUMA, HOA_CH_ORDER_ACN);
+                break;
+        }
 
-        /* Process frame if inFIFO is full and codec is ready for it */
-        if (pData->FIFO_idx >= FRAME_SIZE && (pData->codecStatus == CODEC_STATUS_INITIALISED) && isPlaying ) {
-            pData->FIFO_idx = 0;
-            pData->procStatus = PROC_STATUS_ONGOING;
+        /* account for input normalisation scheme */
+        switch(norm){
+            case NORM_N3D:  /* already in N3D, do nothing */
+                break;
+            case NORM_SN3D: /* convert to N3D */
+                convertHOANormConvention(FLATTEN2D(pData->SHframeTD), inputOrder, frameSize, HOA_NORM_SN3D, HOA_NORM_N3D);
+                break;
+            case NORM_FUMA: /* only for first-order, convert to N3D */
+                convertHOANormConvention(FLATTEN2D(pData->SHframeTD), inputOrder, frameSize, HOA_NORM_FUMA, HOA_NORM_N3D);
+                break;
+        }
 
-            /* Load time-domain data */
-            for(ch=0; ch<nSH; ch++)
-                memcpy(pData->SHframeTD[ch],pData->inFIFO[ch], FRAME_SIZE*sizeof(float));
+        /* update the dirass powermap */
+        if(pData->recalcPmap==1){
+            pData->recalcPmap = 0;
+            saf_atomic_storePtr(&(pData->dispPars), NULL);
 
-            /* account for input channel order */
-            switch(chOrdering){
-                case CH_ACN: /* already ACN */
-                    break;
-                case CH_FUMA:
-                    convertHOAChannelConvention((float*)pData->SHframeTD, inputOrder, FRAME_SIZE, HOA_CH_ORDER_FUMA, HOA_CH_ORDER_ACN);
-                    break;
+            /* averaging starts afresh if requested */
+            if(pData->resetPmapAvg){
+                memset(pars->prev_intensity, 0, pars->grid_nDirs*3*sizeof(float));
+                memset(pars->prev_energy, 0, pars->grid_nDirs*sizeof(float));
+                pData->resetPmapAvg = 0;
             }
 
-            /* account for input normalisation scheme */
-            switch(norm){
-                case NORM_N3D:  /* already in N3D, do nothing */
-                    break;
-                case NORM_SN3D: /* convert to N3D */
-                    convertHOANormConvention((float*)pData->SHframeTD, inputOrder, FRAME_SIZE, HOA_NORM_SN3D, HOA_NORM_N3D);
-                    break;
-                case NORM_FUMA: /* only for first-order, convert to N3D */
-                    convertHOANormConvention((float*)pData->SHframeTD, inputOrder, FRAME_SIZE, HOA_NORM_FUMA, HOA_NORM_N3D);
-                    break;
+            /* filter input signals */
+            float b[3], a[3];
+            biQuadCoeffs(BIQUAD_FILTER_HPF, minFreq_hz, pData->fs, 0.7071f, 0.0f, b, a);
+            for(i=0; i<nSH; i++)
+                applyBiQuadFilter(b, a, pData->Wz12_hpf[i], pData->SHframeTD[i], frameSize);
+            biQuadCoeffs(BIQUAD_FILTER_LPF, maxFreq_hz, pData->fs, 0.7071f, 0.0f, b, a);
+            for(i=0; i<nSH; i++)
+                applyBiQuadFilter(b, a, pData->Wz12_lpf[i], pData->SHframeTD[i], frameSize);
+
+            /* DoA estimation for each spatially-localised sector */
+            if(DirAssMode==REASS_UPSCALE || DirAssMode==REASS_NEAREST){
+                /* Beamform using the sector patterns */
+                cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, pars->grid_nDirs, frameSize, sec_nSH, 1.0f,
+                            pars->Cw, sec_nSH,
+                            FLATTEN2D(pData->SHframeTD), frameSize, 0.0f,
+                            pars->ss, frameSize);
+
+                for(i=0; i<pars->grid_nDirs; i++){
+                    /* beamforming to get velocity patterns */
+                    cblas_sgemm(CblasRowMajor, CblasTrans, CblasNoTrans, 3, frameSize, nSH, 1.0f,
+                                &(pars->Cxyz[i*nSH*3]), 3,
+                                FLATTEN2D(pData->SHframeTD), frameSize, 0.0f,
+                                pars->ssxyz, frameSize);
+
+                    /* take the sum or mean ss.*ssxyz, to get intensity vector */
+                    memset(intensity, 0, 3*sizeof(float));
+                    for(k=0; k<3; k++){
+                        for(j=0; j<frameSize; j++)
+                            intensity[k] += pars->ssxyz[k*frameSize + j] * pars->ss[i*frameSize+j];
+                        intensity[k] /= (float)frameSize;
+
+                        /* average over time */
+                        intensity[k] = pmapAvgCoeff * (pars->prev_intensity[i*3+k]) + (1.0f-pmapAvgCoeff) * intensity[k];
+                        pars->prev_intensity[i*3+k] = intensity[k];
+                    }
+
+                    /* extract DoA [azi elev] convention */
+                    pars->est_dirs[i*2] = atan2f(intensity[1], intensity[0]);
+                    pars->est_dirs[i*2+1] = atan2f(intensity[2], sqrtf(powf(intensity[0], 2.0f) + powf(intensity[1], 2.0f)));
+                    if(DirAssMode==REASS_UPSCALE)
+                        pars->est_dirs[i*2+1] = M_PI/2.0f - pars->est_dirs[i*2+1]; /* convert to inclination */
+                }
             }
 
-            /* update the dirass powermap */
-            if(pData->recalcPmap==1){
-                pData->recalcPmap = 0;
-                pData->pmapReady = 0;
-
-                /* filter input signals */
-                float b[3], a[3];
-                biQuadCoeffs(BIQUAD_FILTER_HPF, minFreq_hz, pData->fs, 0.7071f, 0.0f, b, a);
-                for(i=0; i<nSH; i++)
-                    applyBiQuadFilter(b, a, pData->Wz12_hpf[i], pData->SHframeTD[i], FRAME_SIZE);
-                biQuadCoeffs(BIQUAD_FILTER_LPF, maxFreq_hz, pData->fs, 0.7071f, 0.0f, b, a);
-                for(i=0; i<nSH; i++)
-                    applyBiQuadFilter(b, a, pData->Wz12_lpf[i], pData->SHframeTD[i], FRAME_SIZE);
-
-                /* DoA estimation for each spatially-localised sector */
-                if(DirAssMode==REASS_UPSCALE || DirAssMode==REASS_NEAREST){
-                    /* Beamform using the sector patterns */
-                    cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, pars->grid_nDirs, FRAME_SIZE, sec_nSH, 1.0f,
-                                pars->Cw, sec_nSH,
-                                (const float*)pData->SHframeTD, FRAME_SIZE, 0.0f,
-                                pars->ss, FRAME_SIZE);
+            /* Obtain pmap/upscaled pmap in the case of REASS_MODE_OFF and REASS_UPSCALE modes, respectively.
+             * OR find the nearest display grid indices, corresponding to the DoA estimates, for the REASS_NEAREST mode */
+            switch(DirAssMode) {
+                default:
+                case REASS_MODE_OFF:
+                    /* Standard beamformer-based pmap */
+                    cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, pars->grid_nDirs, frameSize, nSH, 1.0f,
+                                pars->w, nSH,
+                                FLATTEN2D(pData->SHframeTD), frameSize, 0.0f,
+                                pars->ss, frameSize);
+
+                    /* sum energy over the length of the frame to obtain the pmap */
+                    memset(pars->pmap, 0, pars->grid_nDirs *sizeof(float));
+                    for(i=0; i<pars->grid_nDirs; i++)
+                        for(j=0; j<frameSize; j++)
+                            pars->pmap[i] += (pars->ss[i*frameSize+j])*(pars->ss[i*frameSize+j]);
+
+                    /* average energy over time */
+                    for(i=0; i<pars->grid_nDirs; i++){
+                        pars->pmap[i] = pmapAvgCoeff * (pars->prev_energy[i]) + (1.0f-pmapAvgCoeff) * (pars->pmap[i]);
+                        pars->prev_energy[i] = pars->pmap[i];
+                    }
 
+                    /* interpolate the pmap */
+                    cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, pars->interp_nDirs, 1, pars->grid_nDirs, 1.0f,
+                                pars->interp_table, pars->grid_nDirs,
+                                pars->pmap, 1, 0.0f,
+                                pars->pmap_grid[pData->dispSlotIdx], 1);
+                    break;
+
+                case REASS_UPSCALE:
+                    /* upscale */
+                    saf_shEvaluator_getSHreal(pars->hSHEval, upscaleOrder, pars->est_dirs, pars->grid_nDirs, pars->Y_up);
+                    cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, up_nSH, frameSize, pars->grid_nDirs, 1.0f,
+                                pars->Y_up, pars->grid_nDirs,
+                                pars->ss, frameSize, 0.0f,
+                                FLATTEN2D(pData->SHframe_upTD), frameSize);
+
+                    /* Beamform using the new spatially upscaled frame */
+                    cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, pars->grid_nDirs, frameSize, up_nSH, 1.0f,
+                                pars->Uw, up_nSH,
+                                FLATTEN2D(pData->SHframe_upTD), frameSize, 0.0f,
+                                pars->ss, frameSize);
+
+                    /* sum energy over the length of the frame to obtain the pmap */
+                    memset(pars->pmap, 0, pars->grid_nDirs *sizeof(float));
+                    for(i=0; i<pars->grid_nDirs; i++)
+                        for(j=0; j<frameSize; j++)
+                            pars->pmap[i] += (pars->ss[i*frameSize+j])*(pars->ss[i*frameSize+j]);
+
+                    /* average energy over time */
                     for(i=0; i<pars->grid_nDirs; i++){
-                        /* beamforming to get velocity patterns */
-                        cblas_sgemm(CblasRowMajor, CblasTrans, CblasNoTrans, 3, FRAME_SIZE, nSH, 1.0f,
-                                    &(pars->Cxyz[i*nSH*3]), 3,
-                                    (const float*)pData->SHframeTD, FRAME_SIZE, 0.0f,
-                                    pars->ssxyz, FRAME_SIZE);
-
-                        /* take the sum or mean ss.*ssxyz, to get intensity vector */
-                        memset(intensity, 0, 3*sizeof(float));
-                        for(k=0; k<3; k++){
-                            for(j=0; j<FRAME_SIZE; j++)
-                                intensity[k] += pars->ssxyz[k*FRAME_SIZE + j] * pars->ss[i*FRAME_SIZE+j];
-                            intensity[k] /= (float)FRAME_SIZE;
-
-                            /* average over time */
-                            intensity[k] = pmapAvgCoeff * (pars->prev_intensity[i*3+k]) + (1.0f-pmapAvgCoeff) * intensity[k];
-                            pars->prev_intensity[i*3+k] = intensity[k];
-                        }
-
-                        /* extract DoA [azi elev] convention */
-                        pars->est_dirs[i*2] = atan2f(intensity[1], intensity[0]);
-                        pars->est_dirs[i*2+1] = atan2f(intensity[2], sqrtf(powf(intensity[0], 2.0f) + powf(intensity[1], 2.0f)));
-                        if(DirAssMode==REASS_UPSCALE)
-                            pars->est_dirs[i*2+1] = M_PI/2.0f - pars->est_dirs[i*2+1]; /* convert to inclination */
+                        pars->pmap[i] = pmapAvgCoeff * (pars->prev_energy[i]) + (1.0f-pmapAvgCoeff) * (pars->pmap[i]);
+                        pars->prev_energy[i] = pars->pmap[i];
                     }
-                }
 
-                /* Obtain pmap/upscaled pmap in the case of REASS_MODE_OFF and REASS_UPSCALE modes, respectively.
-                 * OR find the nearest display grid indices, corresponding to the DoA estimates, for the REASS_NEAREST mode */
-                switch(DirAssMode) {
-                    default:
-                    case REASS_MODE_OFF:
-                        /* Standard beamformer-based pmap */
-                        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, pars->grid_nDirs, FRAME_SIZE, nSH, 1.0f,
-                                    pars->w, nSH,
-                                    (const float*)pData->SHframeTD, FRAME_SIZE, 0.0f,
-                                    pars->ss, FRAME_SIZE);
-
-                        /* sum energy over the length of the frame to obtain the pmap */
-                        memset(pData->pmap, 0, pars->grid_nDirs *sizeof(float));
-                        for(i=0; i<pars->grid_nDirs; i++)
-                            for(j=0; j<FRAME_SIZE; j++)
-                                pData->pmap[i] += (pars->ss[i*FRAME_SIZE+j])*(pars->ss[i*FRAME_SIZE+j]);
-
-                        /* average energy over time */
-                        for(i=0; i<pars->grid_nDirs; i++){
-                            pData->pmap[i] = pmapAvgCoeff * (pars->prev_energy[i]) + (1.0f-pmapAvgCoeff) * (pData->pmap[i]);
-                            pars->prev_energy[i] = pData->pmap[i];
-                        }
-
-                        /* interpolate the pmap */
-                        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, pars->interp_nDirs, 1, pars->grid_nDirs, 1.0f,
-                                    pars->interp_table, pars->grid_nDirs,
-                                    pData->pmap, 1, 0.0f,
-                                    pData->pmap_grid[pData->dispSlotIdx], 1);
-                        break;
-
-                    case REASS_UPSCALE:
-                        /* upscale */
-                        getSHreal_recur(upscaleOrder, pars->est_dirs, pars->grid_nDirs, pars->Y_up);
-                        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, up_nSH, FRAME_SIZE, pars->grid_nDirs, 1.0f,
-                                    pars->Y_up, pars->grid_nDirs,
-                                    pars->ss, FRAME_SIZE, 0.0f,
-                                    (float*)pData->SHframe_upTD, FRAME_SIZE);
-
-                        /* Beamform using the new spatially upscaled frame */
-                        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, pars->grid_nDirs, FRAME_SIZE, up_nSH, 1.0f,
-                                    pars->Uw, up_nSH,
-                                    (float*)pData->SHframe_upTD, FRAME_SIZE, 0.0f,
-                                    pars->ss, FRAME_SIZE);
-
-                        /* sum energy over the length of the frame to obtain the pmap */
-                        memset(pData->pmap, 0, pars->grid_nDirs *sizeof(float));
-                        for(i=0; i<pars->grid_nDirs; i++)
-                            for(j=0; j<FRAME_SIZE; j++)
-                                pData->pmap[i] += (pars->ss[i*FRAME_SIZE+j])*(pars->ss[i*FRAME_SIZE+j]);
-
-                        /* average energy over time */
-                        for(i=0; i<pars->grid_nDirs; i++){
-                            pData->pmap[i] = pmapAvgCoeff * (pars->prev_energy[i]) + (1.0f-pmapAvgCoeff) * (pData->pmap[i]);
-                            pars->prev_energy[i] = pData->pmap[i];
-                        }
-
-                        /* interpolate the pmap */
-                        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, pars->interp_nDirs, 1, pars->grid_nDirs, 1.0f,
-                                    pars->interp_table, pars->grid_nDirs,
-                                    pData->pmap, 1, 0.0f,
-                                    pData->pmap_grid[pData->dispSlotIdx], 1);
-                        break;
-
-                    case REASS_NEAREST:
-                        /* Assign the sector energies to the nearest display grid point */
-                        findClosestGridPoints(pars->interp_dirs_rad, pars->interp_nDirs, pars->est_dirs, pars->grid_nDirs, 0, pars->est_dirs_idx, NULL, NULL);
-                        memset(pData->pmap_grid[pData->dispSlotIdx], 0, pars->interp_nDirs * sizeof(float));
-                        for(i=0; i< pars->grid_nDirs; i++)
-                            for(j=0; j<FRAME_SIZE; j++)
-                                pData->pmap[i] = (pars->ss[i*FRAME_SIZE+j])*(pars->ss[i*FRAME_SIZE+j]);
-
-                        /* average energy over time, and assign to nearest grid direction */
-                        for(i=0; i<pars->grid_nDirs; i++){
-                            pData->pmap[i] = pmapAvgCoeff * (pars->prev_energy[i]) + (1.0f-pmapAvgCoeff) * (pData->pmap[i]);
-                            pars->prev_energy[i] = pData->pmap[i];
-                            pData->pmap_grid[pData->dispSlotIdx][pars->est_dirs_idx[i]] += pData->pmap[i];
-                        }
-                        break;
-                }
+                    /* interpolate the pmap */
+                    cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, pars->interp_nDirs, 1, pars->grid_nDirs, 1.0f,
+                                pars->interp_table, pars->grid_nDirs,
+                                pars->pmap, 1, 0.0f,
+                                pars->pmap_grid[pData->dispSlotIdx], 1);
+                    break;
 
-                /* ascertain the minimum and maximum values for pmap colour scaling */
-                int ind;
-                utility_siminv(pData->pmap_grid[pData->dispSlotIdx], pars->interp_nDirs, &ind);
-                pData->pmap_grid_minVal = pData->pmap_grid[pData->dispSlotIdx][ind];
-                utility_simaxv(pData->pmap_grid[pData->dispSlotIdx], pars->interp_nDirs, &ind);
-                pData->pmap_grid_maxVal = pData->pmap_grid[pData->dispSlotIdx][ind];
-
-                /* normalise the pmap to 0..1 */
-                for(i=0; i<pars->interp_nDirs; i++)
-                    pData->pmap_grid[pData->dispSlotIdx][i] = (pData->pmap_grid[pData->dispSlotIdx][i]-pData->pmap_grid_minVal)/(pData->pmap_grid_maxVal-pData->pmap_grid_minVal+1e-11f);
-
-                /* signify that the pmap in the current slot is ready for plotting */
-                pData->dispSlotIdx++;
-                if(pData->dispSlotIdx>=NUM_DISP_SLOTS)
-                    pData->dispSlotIdx = 0;
-                pData->pmapReady = 1;
-            }
-            else if(pData->FIFO_idx >= FRAME_SIZE){
-                /* reset FIFO_idx index if codec was not ready */
-                pData->FIFO_idx = 0;
+                case REASS_NEAREST:
+                    /* Assign the sector energies to the nearest display grid point */
+                    findClosestGridPoints(pars->interp_dirs_rad, pars->interp_nDirs, pars->est_dirs, pars->grid_nDirs, 0, pars->est_dirs_idx, NULL, NULL);
+                    memset(pars->pmap_grid[pData->dispSlotIdx], 0, pars->interp_nDirs * sizeof(float));
+                    for(i=0; i< pars->grid_nDirs; i++)
+                        for(j=0; j<frameSize; j++)
+                            pars->pmap[i] = (pars->ss[i*frameSize+j])*(pars->ss[i*frameSize+j]);
+
+                    /* average energy over time, and assign to nearest grid direction */
+                    for(i=0; i<pars->grid_nDirs; i++){
+                        pars->pmap[i] = pmapAvgCoeff * (pars->prev_energy[i]) + (1.0f-pmapAvgCoeff) * (pars->pmap[i]);
+                        pars->prev_energy[i] = pars->pmap[i];
+                        pars->pmap_grid[pData->dispSlotIdx][pars->est_dirs_idx[i]] += pars->pmap[i];
+                    }
+                    break;
             }
+
+            /* ascertain the minimum and maximum values for pmap colour scaling */
+            int ind;
+            utility_siminv(pars->pmap_grid[pData->dispSlotIdx], pars->interp_nDirs, &ind);
+            pData->pmap_grid_minVal = pars->pmap_grid[pData->dispSlotIdx][ind];
+            utility_simaxv(pars->pmap_grid[pData->dispSlotIdx], pars->interp_nDirs, &ind);
+            pData->pmap_grid_maxVal = pars->pmap_grid[pData->dispSlotIdx][ind];
+
+            /* normalise the pmap to 0..1 */
+            for(i=0; i<pars->interp_nDirs; i++)
+                pars->pmap_grid[pData->dispSlotIdx][i] = (pars->pmap_grid[pData->dispSlotIdx][i]-pData->pmap_grid_minVal)/(pData->pmap_grid_maxVal-pData->pmap_grid_minVal+1e-11f);
+
+            /* signify that the pmap in the current slot is ready for plotting */
+            pData->dispSlotIdx++;
+            if(pData->dispSlotIdx>=NUM_DISP_SLOTS)
+                pData->dispSlotIdx = 0;
+            saf_atomic_storePtr(&(pData->dispPars), (void*)pars); /* ready for plotting */
         }
     }
-    
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
+}
+
+void dirass_analysis
+(
+    void  *  const hDir,
+    float ** const inputs,
+    int            nInputs,
+    int            nSamples,
+    int            isPlaying
+)
+{
+    dirass_data *pData = (dirass_data*)(hDir);
+
+    /* Frames are only analysed while the host is playing */
+    if(isPlaying)
+        saf_blockAdaptor_apply(pData->hBlockAdaptor, inputs, NULL, nInputs, 0,
+                               nSamples, dirass_analysisFrame, hDir);
 }
 
 /* SETS */
@@ -479,12 +480,9 @@ void dirass_setUpscaleOrder(void* const hDir,  int newValue)
 void dirass_setDiRAssMode(void* const hDir,  int newMode)
 {
     dirass_data *pData = (dirass_data*)(hDir);
-    dirass_codecPars* pars = pData->pars;
     if(pData->DirAssMode!=newMode){
         pData->DirAssMode = newMode;
-        if(pars->prev_intensity!=NULL)
-            memset(pars->prev_intensity, 0, pars->grid_nDirs*3*sizeof(float));
-        memset(pars->prev_energy, 0, pars->grid_nDirs*sizeof(float));
+        pData->resetPmapAvg = 1;
     }
 }
 
@@ -552,10 +550,16 @@ int dirass_getFrameSize(void)
     return FRAME_SIZE;
 }
 
+int dirass_getFrameSizeEx(void* const hDir)
+{
+    dirass_data *pData = (dirass_data*)(hDir);
+    return pData->frameSize;
+}
+
 CODEC_STATUS dirass_getCodecStatus(void* const hDir)
 {
     dirass_data *pData = (dirass_data*)(hDir);
-    return pData->codecStatus;
+    return (CODEC_STATUS)saf_atomic_loadInt(&(pData->codecStatus));
 }
 
 float dirass_getProgressBar0_1(void* const hDir)
@@ -663,10 +667,13 @@ float dirass_getMapAvgCoeff(void* const hDir)
 int dirass_getPmap(void* const hDir, float** grid_dirs, float** pmap, int* nDirs,int* pmapWidth, int* hfov, float* aspectRatio) 
 {
     dirass_data *pData = (dirass_data*)(hDir);
-    dirass_codecPars* pars = pData->pars;
-    if((pData->codecStatus == CODEC_STATUS_INITIALISED) && pData->pmapReady){
+    dirass_codecPars* pars;
+
+    /* only the state the processing loop last drew into is ever displayed */
+    pars = (dirass_codecPars*)saf_atomic_loadPtr(&(pData->dispPars));
+    if(pars != NULL){
         (*grid_dirs) = pars->interp_dirs_deg;
-        (*pmap) = pData->pmap_grid[pData->dispSlotIdx-1 < 0 ? NUM_DISP_SLOTS-1 : pData->dispSlotIdx-1];
+        (*pmap) = pars->pmap_grid[pData->dispSlotIdx-1 < 0 ? NUM_DISP_SLOTS-1 : pData->dispSlotIdx-1];
         (*nDirs) = pars->interp_nDirs;
         (*pmapWidth) = pData->dispWidth;
         switch(pData->HFOVoption){
@@ -683,10 +690,16 @@ int dirass_getPmap(void* const hDir, float** grid_dirs, float** pmap, int* nDirs
             case ASPECT_RATIO_4_3:  (*aspectRatio) = 4.0f/3.0f; break;
         }
     }
-    return pData->pmapReady;
+    return pars != NULL;
 }
 
 int dirass_getProcessingDelay()
 {
     return 2*FRAME_SIZE;
 }
+
+int dirass_getProcessingDelayEx(void* const hDir)
+{
+    dirass_data *pData = (dirass_data*)(hDir);
+    return 2*pData->frameSize + saf_blockAdaptor_getDelay(pData->hBlockAdaptor);
+}
@@ -39,25 +39,48 @@
 void dirass_setCodecStatus(void* const hDir, CODEC_STATUS newStatus)
 {
     dirass_data *pData = (dirass_data*)(hDir);
-    if(newStatus==CODEC_STATUS_NOT_INITIALISED){
-        /* Pause until current initialisation is complete */
-        while(pData->codecStatus == CODEC_STATUS_INITIALISING)
-            SAF_SLEEP(10);
+    saf_atomic_storeInt(&(pData->codecStatus), (int)newStatus);
+}
+
+void dirass_destroyCodecPars(void** const phPars)
+{
+    dirass_codecPars *pars = (dirass_codecPars*)(*phPars);
+    int i;
+
+    if(pars!=NULL){
+        free(pars->interp_dirs_deg);
+        free(pars->interp_dirs_rad);
+        free(pars->interp_table);
+        free(pars->ss);
+        free(pars->ssxyz);
+        free(pars->est_dirs_idx);
+        free(pars->prev_intensity);
+        free(pars->prev_energy);
+        free(pars->Cxyz);
+        free(pars->Cw);
+        free(pars->Uw);
+        free(pars->Y_up);
+        saf_shEvaluator_destroy(&(pars->hSHEval));
+        free(pars->est_dirs);
+        free(pars->w);
+        free(pars->pmap);
+        for(i=0; i<NUM_DISP_SLOTS; i++)
+            free(pars->pmap_grid[i]);
+        free(pars);
+        *phPars = NULL;
     }
-    pData->codecStatus = newStatus;
 }
 
-void dirass_initAna(void* const hDir)
+void dirass_initAna(void* const hDir, dirass_codecPars* pars)
 {
     dirass_data *pData = (dirass_data*)(hDir);
-    dirass_codecPars* pars = pData->pars;
     int i, j, N_azi, N_ele, nSH_order, order, nSH_sec, order_sec, order_up, nSH_up, geosphere_ico_freq, td_degree;
     float hfov, vfov, fi, aspectRatio;
     float *grid_x_axis, *grid_y_axis, *c_n;
     float_complex* A_xyz;
     
-    order = pData->new_inputOrder;
-    order_up = pData->new_upscaleOrder;
+    order = pars->inputOrder = pData->new_inputOrder;
+    order_up = pars->upscaleOrder = pData->new_upscaleOrder;
     nSH_order = (order+1)*(order+1);
     nSH_up = (order_up+1)*(order_up+1);
     
@@ -150,8 +173,8 @@ void dirass_initAna(void* const hDir)
         grid_x_axis[i] = fi;
     for(fi = -vfov/2.0f,  i = 0; i<N_ele; fi+=vfov/N_ele, i++)
         grid_y_axis[i] = fi;
-    pars->interp_dirs_deg = realloc(pars->interp_dirs_deg, N_azi*N_ele*2*sizeof(float));
-    pars->interp_dirs_rad = realloc(pars->interp_dirs_rad, N_azi*N_ele*2*sizeof(float));
+    pars->interp_dirs_deg = malloc1d(N_azi*N_ele*2*sizeof(float));
+    pars->interp_dirs_rad = malloc1d(N_azi*N_ele*2*sizeof(float));
     for(i = 0; i<N_ele; i++){
         for(j=0; j<N_azi; j++){
             pars->interp_dirs_deg[(i*N_azi + j)*2]   = grid_x_axis[j];
@@ -160,7 +183,6 @@ void dirass_initAna(void* const hDir)
             pars->interp_dirs_rad[(i*N_azi + j)*2+1] = grid_y_axis[i] * M_PI/180.0f;
         }
     }
-    free(pars->interp_table);
     generateVBAPgainTable3D_srcs(pars->interp_dirs_deg, N_azi*N_ele, pars->grid_dirs_deg, pars->grid_nDirs, 0, 0, 0.0f, &(pars->interp_table), &(pars->interp_nDirs), &(pars->interp_nTri));
     VBAPgainTable2InterpTable(pars->interp_table, pars->interp_nDirs, pars->grid_nDirs);
     
@@ -178,8 +200,8 @@ void dirass_initAna(void* const hDir)
         case STATIC_BEAM_TYPE_HYPERCARDIOID: beamWeightsHypercardioid2Spherical(order_sec, c_n); break;
         case STATIC_BEAM_TYPE_MAX_EV: beamWeightsMaxEV(order_sec, c_n); break;
     }
-    pars->Cxyz = realloc1d(pars->Cxyz, pars->grid_nDirs * nSH_order * 3 * sizeof(float));
-    pars->Cw = realloc1d(pars->Cw, pars->grid_nDirs * nSH_sec * sizeof(float));
+    pars->Cxyz = malloc1d(pars->grid_nDirs * nSH_order * 3 * sizeof(float));
+    pars->Cw = malloc1d(pars->grid_nDirs * nSH_sec * sizeof(float));
     for(i=0; i<pars->grid_nDirs; i++){
         beamWeightsVelocityPatternsReal(order_sec, c_n, pars->grid_dirs_deg[i*2]*M_PI/180.0f,
                                         pars->grid_dirs_deg[i*2+1]*M_PI/180.0f, A_xyz, &(pars->Cxyz[i*nSH_order*3]));
@@ -196,7 +218,7 @@ void dirass_initAna(void* const hDir)
         case STATIC_BEAM_TYPE_HYPERCARDIOID: beamWeightsHypercardioid2Spherical(order, c_n); break;
         case STATIC_BEAM_TYPE_MAX_EV: beamWeightsMaxEV(order, c_n); break;
     }
-    pars->w = realloc1d(pars->w, pars->grid_nDirs * nSH_order * sizeof(float));
+    pars->w = malloc1d(pars->grid_nDirs * nSH_order * sizeof(float));
     for(i=0; i<pars->grid_nDirs; i++){
         rotateAxisCoeffsReal(order, c_n, M_PI/2.0f - pars->grid_dirs_deg[i*2+1]*M_PI/180.0f,
                              pars->grid_dirs_deg[i*2]*M_PI/180.0f, &(pars->w[i*nSH_order]));
@@ -210,31 +232,25 @@ void dirass_initAna(void* const hDir)
         case STATIC_BEAM_TYPE_HYPERCARDIOID: beamWeightsHypercardioid2Spherical(order_up, c_n); break;
         case STATIC_BEAM_TYPE_MAX_EV: beamWeightsMaxEV(order_up, c_n); break;
     } 
-    pars->Uw = realloc1d(pars->Uw, pars->grid_nDirs * nSH_up * sizeof(float));
+    pars->Uw = malloc1d(pars->grid_nDirs * nSH_up * sizeof(float));
     for(i=0; i<pars->grid_nDirs; i++){
         rotateAxisCoeffsReal(order_up, c_n, M_PI/2.0f - pars->grid_dirs_deg[i*2+1]*M_PI/180.0f,
                              pars->grid_dirs_deg[i*2]*M_PI/180.0f, &(pars->Uw[i*nSH_up]));
     }
     free(c_n);
  
-    /* reallocate memory */
-    pars->Y_up = realloc1d(pars->Y_up, nSH_up* (pars->grid_nDirs)*sizeof(float));
-    pars->est_dirs = realloc1d(pars->est_dirs, pars->grid_nDirs * 2 * sizeof(float));
-    pars->ss = realloc1d(pars->ss, pars->grid_nDirs * FRAME_SIZE * sizeof(float));
-    pars->ssxyz = realloc1d(pars->ssxyz, 3 * FRAME_SIZE * sizeof(float));
-    pData->pmap = realloc1d(pData->pmap, pars->grid_nDirs*sizeof(float));
-    pars->est_dirs_idx = realloc1d(pars->est_dirs_idx, pars->grid_nDirs*sizeof(int));
-    pars->prev_intensity = realloc1d(pars->prev_intensity, pars->grid_nDirs*3*sizeof(float));
-    pars->prev_energy = realloc1d(pars->prev_energy, pars->grid_nDirs*sizeof(float));
-    memset(pars->prev_intensity, 0, pars->grid_nDirs*3*sizeof(float));
-    memset(pars->prev_energy, 0, pars->grid_nDirs*sizeof(float)); 
-    for(i=0; i<NUM_DISP_SLOTS; i++){
-        pData->pmap_grid[i] = realloc1d(pData->pmap_grid[i], pars->interp_nDirs*sizeof(float));
-        memset(pData->pmap_grid[i], 0, pars->interp_nDirs*sizeof(float));
-    }
-    
-    pData->inputOrder = order;
-    pData->upscaleOrder = order_up;
+    /* allocate memory */
+    saf_shEvaluator_create(&(pars->hSHEval), MAX_DISPLAY_SH_ORDER, 0.0f);
+    pars->Y_up = malloc1d(nSH_up* (pars->grid_nDirs)*sizeof(float));
+    pars->est_dirs = malloc1d(pars->grid_nDirs * 2 * sizeof(float));
+    pars->ss = malloc1d(pars->grid_nDirs * pData->frameSize * sizeof(float));
+    pars->ssxyz = malloc1d(3 * pData->frameSize * sizeof(float));
+    pars->pmap = malloc1d(pars->grid_nDirs*sizeof(float));
+    pars->est_dirs_idx = malloc1d(pars->grid_nDirs*sizeof(int));
+    pars->prev_intensity = calloc1d(pars->grid_nDirs*3, sizeof(float));
+    pars->prev_energy = calloc1d(pars->grid_nDirs, sizeof(float));
+    for(i=0; i<NUM_DISP_SLOTS; i++)
+        pars->pmap_grid[i] = calloc1d(pars->interp_nDirs, sizeof(float));
     
     free(grid_x_axis);
     free(grid_y_axis);
@@ -52,7 +52,7 @@ extern "C" {
 /* ========================================================================== */
 
 #ifndef FRAME_SIZE
-# define FRAME_SIZE ( 1024 ) 
+# define FRAME_SIZE ( 1024 )                /* default frame size (see dirass_createWithFrameSize()) */
 #endif
 #define MAX_INPUT_SH_ORDER ( MAX_SH_ORDER )
 #define MAX_DISPLAY_SH_ORDER ( 20 )
@@ -69,10 +69,20 @@ extern "C" {
 /* ========================================================================== */
 
 /**
- * Contains variables for scanning grids, and sector beamforming
+ * Codec state of dirass: the scanning grid, interpolation table, and sector
+ * beamforming weights for one configuration
+ *
+ * A new state is built by dirass_initCodec() and handed over to the processing
+ * loop via a saf_stateSwap (see saf_stateSwap_create()). Once published, its
+ * configuration is no longer modified; only the processing loop uses its
+ * beamformer and averaging buffers (the display slots are also read by
+ * dirass_getPmap()).
  */
 typedef struct _dirass_codecPars
 {
+    int inputOrder;           /**< input/analysis order the state is built for */
+    int upscaleOrder;         /**< upscale order the state is built for */
+
     /* scanning grid and intepolation table */
     float* grid_dirs_deg;     /**< scanning grid directions; FLAT: grid_nDirs x 2 */
     int grid_nDirs;           /**< number of grid directions */
@@ -81,8 +91,8 @@ typedef struct _dirass_codecPars
     float* interp_table;      /**< interpolation table (spherical->rectangular grid); FLAT: interp_nDirs x grid_nDirs */
     int interp_nDirs;         /**< number of interpolation directions */
     int interp_nTri;          /**< number of triangles in the spherical scanning grid mesh */
-    float* ss;                /**< beamformer sector signals; FLAT: grid_nDirs x FRAME_SIZE */
-    float* ssxyz;             /**< beamformer velocity signals; FLAT: 3 x FRAME_SIZE */
+    float* ss;                /**< beamformer sector signals; FLAT: grid_nDirs x frameSize */
+    float* ssxyz;             /**< beamformer velocity signals; FLAT: 3 x frameSize */
     int* est_dirs_idx;        /**< DoA indices, into the interpolation directions; grid_nDirs x 1 */
     float* prev_intensity;    /**< previous intensity vectors (for averaging); FLAT: grid_nDirs x 3 */
     float* prev_energy;       /**< previous energy (for averaging); FLAT: grid_nDirs x 1 */
@@ -92,10 +102,15 @@ typedef struct _dirass_codecPars
     float* Cw;                /**< beamforming weights; FLAT: nDirs x (order)^2 */
     float* Uw;                /**< beamforming weights; FLAT: nDirs x (upscaleOrder+1)^2 */
     float* Y_up;              /**< real SH weights for upscaling; FLAT: (upscaleOrder+1)^2 x grid_nDirs */
+    void* hSHEval;            /**< SH evaluator for upscaling (up to MAX_DISPLAY_SH_ORDER) */
     float* est_dirs;          /**< estimated DoA per grid direction; grid_nDirs x 2 */
     
     /* regular beamforming */
     float* w;                 /**< beamforming weights; FLAT: nDirs x (order+1)^2 */
+
+    /* display */
+    float* pmap;                            /**< grid_nDirs x 1 */
+    float* pmap_grid[NUM_DISP_SLOTS];       /**< dirass interpolated to grid; interp_nDirs x 1 */
      
 }dirass_codecPars;
     
@@ -105,13 +120,13 @@ typedef struct _dirass_codecPars
  */
 typedef struct _dirass
 {
-    /* FIFO buffers */
-    int FIFO_idx;
-    float inFIFO[MAX_NUM_INPUT_SH_SIGNALS][FRAME_SIZE]; 
+    /* block-size adaptor */
+    void* hBlockAdaptor;
     
     /* Buffers */
-    float SHframeTD[MAX_NUM_INPUT_SH_SIGNALS][FRAME_SIZE];
-    float SHframe_upTD[MAX_NUM_DISPLAY_SH_SIGNALS][FRAME_SIZE];
+    int frameSize;                          /**< analysis frame size (specified at creation) */
+    float** SHframeTD;                      /**< MAX_NUM_INPUT_SH_SIGNALS x frameSize */
+    float** SHframe_upTD;                   /**< MAX_NUM_DISPLAY_SH_SIGNALS x frameSize */
     float fs;                               /**< host sampling rate */
     
     /* internal */ 
@@ -120,20 +135,19 @@ typedef struct _dirass
     float Wz12_lpf[MAX_NUM_INPUT_SH_SIGNALS][2]; /**< delayed elements used in the LPF */
     
     /* ana configuration */
-    CODEC_STATUS codecStatus;
-    PROC_STATUS procStatus;
+    volatile int codecStatus;               /**< see #_CODEC_STATUS enum */
     float progressBar0_1;
     char* progressBarText;
-    dirass_codecPars* pars;                 /**< codec parameters */
+    void* hCodecState;                      /**< saf_stateSwap handing dirass_codecPars to the processing loop */
+    dirass_codecPars* procPars;             /**< codec state last used by the processing loop (only accessed by it) */
     
     /* display */
-    float* pmap;                            /**< grid_nDirs x 1 */
-    float* pmap_grid[NUM_DISP_SLOTS];       /**< dirass interpolated to grid; interp_nDirs x 1 */
     int dispSlotIdx;                        /**< current display slot index */
     float pmap_grid_minVal;                 /**< minimum value in pmap */
     float pmap_grid_maxVal;                 /**< maximum value in pmap */
     int recalcPmap;                         /**< set this to 1 to generate a new image */
-    int pmapReady;                          /**< 0: image generation not started yet, 1: image is ready for plotting*/
+    void* volatile dispPars;                /**< codec state holding the latest image, NULL until one is ready for plotting (set by the processing loop) */
+    int resetPmapAvg;                       /**< set this to 1 to reset the averaging of the intensity vectors and energies */
     
     /* User parameters */
     int new_inputOrder, inputOrder;         /**< input/analysis order */
@@ -158,13 +172,26 @@ typedef struct _dirass
 
 /**
  * Sets codec status (see #_CODEC_STATUS enum)
+ *
+ * This never waits: if the codec is being initialised, then setting
+ * #CODEC_STATUS_NOT_INITIALISED causes dirass_initCodec() to leave the status
+ * as such, so that the next call re-initialises the codec again.
  */
 void dirass_setCodecStatus(void* const hDir, CODEC_STATUS newStatus);
 
 /**
- * Intialises the codec variables, based on current global/user parameters
+ * Destroys a codec state (see saf_stateSwap_destroyFn)
+ *
+ * @param[in] phPars (&) address of the dirass_codecPars
+ */
+void dirass_destroyCodecPars(void** const phPars);
+
+/**
+ * Intialises the codec variables of a new codec state, based on current
+ * global/user parameters
  */
-void dirass_initAna(void* const hDir);
+void dirass_initAna(void* const hDir,
+                    dirass_codecPars* pars);
 
 
 #ifdef __cplusplus
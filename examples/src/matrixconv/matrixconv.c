@@ -49,10 +49,7 @@ void matrixconv_create
     pData->input_wav_length = 0;
     pData->nOutputChannels = 0;
 
-    /* set FIFO buffers */
-    pData->FIFO_idx = 0;
-    memset(pData->inFIFO, 0, MAX_NUM_CHANNELS*MAX_FRAME_SIZE*sizeof(float));
-    memset(pData->outFIFO, 0, MAX_NUM_CHANNELS*MAX_FRAME_SIZE*sizeof(float));
+    pData->hBlockAdaptor = NULL;
 }
 
 void matrixconv_destroy
@@ -67,6 +64,7 @@ void matrixconv_destroy
         free(pData->outputFrameTD);
         free(pData->filters);
         saf_matrixConv_destroy(&(pData->hMatrixConv));
+        saf_blockAdaptor_destroy(&(pData->hBlockAdaptor));
         free(pData);
         pData = NULL;
     }
@@ -87,71 +85,73 @@ void matrixconv_init
         pData->hostBlockSize = hostBlockSize;
         pData->reInitFilters = 1;
     }
+    if(pData->hBlockAdaptor != NULL)
+        saf_blockAdaptor_reset(pData->hBlockAdaptor);
     
     matrixconv_checkReInit(hMCnv);
 } 
 
-void matrixconv_process
+/** Processes one frame of hostBlockSize_clamped samples (see saf_blockAdaptor_apply()) */
+static void matrixconv_processFrame
 (
     void  *  const hMCnv,
     float ** const inputs,
     float ** const outputs,
     int            nInputs,
-    int            nOutputs,
-    int            nSamples
+    int            nOutputs
 )
 {
     matrixconv_data *pData = (matrixconv_data*)(hMCnv);
-    int s, ch, i;
+    int i, frameSize;
     int numInputChannels, numOutputChannels;
- 
-    matrixconv_checkReInit(hMCnv);
 
     /* prep */
+    frameSize = pData->hostBlockSize_clamped;
     numInputChannels = pData->nInputChannels;
     numOutputChannels = pData->nOutputChannels;
 
-    for(s=0; s<nSamples; s++){
-        /* Load input signals into inFIFO buffer */
-        for(ch=0; ch<MIN(MIN(nInputs,numInputChannels),MAX_NUM_CHANNELS); ch++)
-            pData->inFIFO[ch][pData->FIFO_idx] = inputs[ch][s];
-        for(; ch<numInputChannels; ch++) /* Zero any channels that were not given */
-            pData->inFIFO[ch][pData->FIFO_idx] = 0.0f;
-
-        /* Pull output signals from outFIFO buffer */
-        for(ch=0; ch<MIN(MIN(nOutputs, numOutputChannels),MAX_NUM_CHANNELS); ch++)
-            outputs[ch][s] = pData->outFIFO[ch][pData->FIFO_idx];
-        for(; ch<nOutputs; ch++) /* Zero any extra channels */
-            outputs[ch][s] = 0.0f;
-
-        /* Increment buffer index */
-        pData->FIFO_idx++;
-
-        /* Process frame if inFIFO is full and filters are loaded and saf_matrixConv_apply is ready for it */
-        if (pData->FIFO_idx >= pData->hostBlockSize_clamped && pData->reInitFilters == 0 ) {
-            pData->FIFO_idx = 0;
-
-            /* Load time-domain data */
-            for(i=0; i < numInputChannels; i++)
-                utility_svvcopy(pData->inFIFO[i], pData->hostBlockSize_clamped, pData->inputFrameTD[i]);
-
-            /* Apply matrix convolution */
-            if(pData->hMatrixConv != NULL && pData->filter_length>0)
-                saf_matrixConv_apply(pData->hMatrixConv, FLATTEN2D(pData->inputFrameTD), FLATTEN2D(pData->outputFrameTD));
-            /* if the matrix convolver handle has not been initialised yet (i.e. no filters have been loaded) then zero the output */
-            else
-                memset(FLATTEN2D(pData->outputFrameTD), 0, MAX_NUM_CHANNELS * (pData->hostBlockSize_clamped)*sizeof(float));
-
-            /* copy signals to output buffer */
-            for (i = 0; i < MIN(numOutputChannels, MAX_NUM_CHANNELS); i++)
-                utility_svvcopy(pData->outputFrameTD[i], pData->hostBlockSize_clamped, pData->outFIFO[i]);
-        }
-        else if(pData->FIFO_idx >= pData->hostBlockSize_clamped){
-            /* clear outFIFO if codec was not ready */
-            pData->FIFO_idx = 0;
-            memset(pData->outFIFO, 0, MAX_NUM_CHANNELS*MAX_FRAME_SIZE*sizeof(float));
-        }
-    }
+    /* Load time-domain data */
+    for(i=0; i < MIN(nInputs, numInputChannels); i++)
+        utility_svvcopy(inputs[i], frameSize, pData->inputFrameTD[i]);
+    for(; i < numInputChannels; i++) /* Zero any channels that were not given */
+        memset(pData->inputFrameTD[i], 0, frameSize*sizeof(float));
+
+    /* Apply matrix convolution */
+    if(pData->hMatrixConv != NULL && pData->filter_length>0)
+        saf_matrixConv_apply(pData->hMatrixConv, FLATTEN2D(pData->inputFrameTD), FLATTEN2D(pData->outputFrameTD));
+    /* if the matrix convolver handle has not been initialised yet (i.e. no filters have been loaded) then zero the output */
+    else
+        memset(FLATTEN2D(pData->outputFrameTD), 0, MAX_NUM_CHANNELS * frameSize*sizeof(float));
+
+    /* copy signals to output buffer */
+    for (i = 0; i < MIN(nOutputs, numOutputChannels); i++)
+        utility_svvcopy(pData->outputFrameTD[i], frameSize, outputs[i]);
+    for(; i < nOutputs; i++) /* Zero any extra channels */
+        memset(outputs[i], 0, frameSize*sizeof(float));
+}
+
+void matrixconv_process
+(
+    void  *  const hMCnv,
+    float ** const inputs,
+    float ** const outputs,
+    int            nInputs,
+    int            nOutputs,
+    int            nSamples
+)
+{
+    matrixconv_data *pData = (matrixconv_data*)(hMCnv);
+    int ch;
+ 
+    matrixconv_checkReInit(hMCnv);
+
+    /* Process frames if filters are loaded and saf_matrixConv_apply is ready for it */
+    if (pData->reInitFilters == 0 && pData->hBlockAdaptor != NULL)
+        saf_blockAdaptor_apply(pData->hBlockAdaptor, inputs, outputs, nInputs, nOutputs,
+                               nSamples, matrixconv_processFrame, hMCnv);
+    else
+        for (ch=0; ch < nOutputs; ch++)
+            memset(outputs[ch], 0, nSamples*sizeof(float));
 }
 
 
@@ -191,10 +191,9 @@ void matrixconv_checkReInit(void* const hMCnv)
         pData->outputFrameTD = (float**)realloc2d((void**)pData->outputFrameTD, MAX_NUM_CHANNELS, pData->hostBlockSize_clamped, sizeof(float));
         memset(FLATTEN2D(pData->inputFrameTD), 0, MAX_NUM_CHANNELS*(pData->hostBlockSize_clamped)*sizeof(float));
 
-        /* reset FIFO buffers */
-        pData->FIFO_idx = 0;
-        memset(pData->inFIFO, 0, MAX_NUM_CHANNELS*MAX_FRAME_SIZE*sizeof(float));
-        memset(pData->outFIFO, 0, MAX_NUM_CHANNELS*MAX_FRAME_SIZE*sizeof(float));
+        /* (Re)create the block-size adaptor for the new frame size */
+        saf_blockAdaptor_destroy(&(pData->hBlockAdaptor));
+        saf_blockAdaptor_create(&(pData->hBlockAdaptor), pData->hostBlockSize_clamped, MAX_NUM_CHANNELS, MAX_NUM_CHANNELS);
 
         pData->reInitFilters = 0;
     }
@@ -210,9 +209,12 @@ void matrixconv_setFilters
 )
 {
     matrixconv_data *pData = (matrixconv_data*)(hMCnv);
-    int i;
+    int i, prev_nOutputChannels, prev_filter_length;
+    void* hFilters;
     assert(numChannels<=MAX_NUM_CHANNELS_FOR_WAV && numChannels > 0 && numSamples > 0);
     
+    prev_nOutputChannels = pData->nOutputChannels;
+    prev_filter_length = pData->filter_length;
     pData->nOutputChannels = MIN(numChannels, MAX_NUM_CHANNELS);
     pData->input_wav_length = numSamples;
     pData->nfilters = (pData->nOutputChannels) * (pData->nInputChannels);
@@ -230,6 +232,16 @@ void matrixconv_setFilters
     else
         pData->filter_length = 0;
 
+    /* If the dimensions are unchanged, then the new filters are transformed here
+     * and swapped into the existing convolver (with a crossfade), rather than
+     * re-creating it */
+    if(pData->reInitFilters == 0 && pData->hMatrixConv != NULL && pData->filter_length > 0 &&
+       pData->nOutputChannels == prev_nOutputChannels && pData->filter_length == prev_filter_length){
+        saf_matrixConv_createFilters(pData->hMatrixConv, pData->filters, &hFilters);
+        if(saf_matrixConv_swapFilters(pData->hMatrixConv, hFilters, FILTER_CROSSFADE_LENGTH))
+            return;
+        saf_matrixConv_destroyFilters(&hFilters); /* previous swap still in progress */
+    }
     pData->reInitFilters = 1;
 }
 
@@ -308,6 +320,14 @@ int matrixconv_getHostFs(void* const hMCnv)
 int matrixconv_getProcessingDelay(void* const hMCnv)
 {
     matrixconv_data *pData = (matrixconv_data*)(hMCnv);
-    return pData->hostBlockSize_clamped;
+    int frameSize;
+
+    /* The block-size adaptor only adds a frame of delay if the host block size
+     * is not a multiple of the frame size */
+    frameSize = CLAMP(pData->hostBlockSize, MIN_FRAME_SIZE, MAX_FRAME_SIZE);
+    if (pData->hostBlockSize % frameSize == 0 &&
+        (pData->hBlockAdaptor == NULL || saf_blockAdaptor_getDelay(pData->hBlockAdaptor) == 0))
+        return 0;
+    return frameSize;
 }
 
@@ -42,6 +42,7 @@ extern "C" {
 #define MIN_FRAME_SIZE ( 512 )
 #define MAX_FRAME_SIZE ( 8192 ) 
 #define MAX_NUM_CHANNELS_FOR_WAV ( 1024 )
+#define FILTER_CROSSFADE_LENGTH ( 4096 ) /**< Crossfade length, in samples, when new filters are hot-swapped */
     
     
 /* ========================================================================== */
@@ -53,11 +54,6 @@ extern "C" {
  */
 typedef struct _matrixconv
 {
-    /* FIFO buffers */
-    int FIFO_idx;
-    float inFIFO[MAX_NUM_CHANNELS][MAX_FRAME_SIZE];
-    float outFIFO[MAX_NUM_CHANNELS][MAX_FRAME_SIZE];
-
     /* input/output buffers */
     float** inputFrameTD;
     float** outputFrameTD;
@@ -66,6 +62,7 @@ typedef struct _matrixconv
     void* hMatrixConv;     /**< saf_matrixConv handle */
     int hostBlockSize;     /**< current host block size */
     int hostBlockSize_clamped; /**< Clamped between MIN and #MAX_FRAME_SIZE */
+    void* hBlockAdaptor;   /**< block-size adaptor handle */
     float* filters;        /**< the matrix of filters; FLAT: nOutputChannels x nInputChannels x filter_length */
     int nfilters;          /**< the number of filters (nOutputChannels x nInputChannels) */
     int input_wav_length;  /**< length of the wav files loaded in samples (inputs are concatenated) */
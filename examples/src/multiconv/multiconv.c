@@ -47,10 +47,7 @@ void multiconv_create
     pData->filter_length = 0;
     pData->filter_fs = 0;
 
-    /* set FIFO buffers */
-    pData->FIFO_idx = 0;
-    memset(pData->inFIFO, 0, MAX_NUM_CHANNELS*MAX_FRAME_SIZE*sizeof(float));
-    memset(pData->outFIFO, 0, MAX_NUM_CHANNELS*MAX_FRAME_SIZE*sizeof(float));
+    pData->hBlockAdaptor = NULL;
 }
 
 void multiconv_destroy
@@ -65,6 +62,7 @@ void multiconv_destroy
         free(pData->outputFrameTD);
         free(pData->filters);
         saf_multiConv_destroy(&(pData->hMultiConv));
+        saf_blockAdaptor_destroy(&(pData->hBlockAdaptor));
         free(pData);
         pData = NULL;
     }
@@ -84,11 +82,50 @@ void multiconv_init
         pData->hostBlockSize = hostBlockSize;
         pData->reInitFilters = 1;
     }
+    if(pData->hBlockAdaptor != NULL)
+        saf_blockAdaptor_reset(pData->hBlockAdaptor);
     
     multiconv_checkReInit(hMCnv);
 } 
 
 
+/** Processes one frame of hostBlockSize_clamped samples (see saf_blockAdaptor_apply()) */
+static void multiconv_processFrame
+(
+    void  *  const hMCnv,
+    float ** const inputs,
+    float ** const outputs,
+    int            nInputs,
+    int            nOutputs
+)
+{
+    multiconv_data *pData = (multiconv_data*)(hMCnv);
+    int i, frameSize;
+    int numChannels;
+
+    /* prep */
+    frameSize = pData->hostBlockSize_clamped;
+    numChannels = pData->nChannels;
+
+    /* Load time-domain data */
+    for(i=0; i < MIN(nInputs, numChannels); i++)
+        utility_svvcopy(inputs[i], frameSize, pData->inputFrameTD[i]);
+    for(; i < numChannels; i++) /* Zero any channels that were not given */
+        memset(pData->inputFrameTD[i], 0, frameSize*sizeof(float));
+
+    /* Apply convolution */
+    if(pData->hMultiConv != NULL)
+        saf_multiConv_apply(pData->hMultiConv, FLATTEN2D(pData->inputFrameTD), FLATTEN2D(pData->outputFrameTD));
+    else
+        memset(FLATTEN2D(pData->outputFrameTD), 0, MAX_NUM_CHANNELS * frameSize*sizeof(float));
+
+    /* copy signals to output buffer */
+    for (i = 0; i < MIN(nOutputs, numChannels); i++)
+        utility_svvcopy(pData->outputFrameTD[i], frameSize, outputs[i]);
+    for(; i < nOutputs; i++) /* Zero any extra channels */
+        memset(outputs[i], 0, frameSize*sizeof(float));
+}
+
 void multiconv_process
 (
     void  *  const hMCnv,
@@ -100,54 +137,17 @@ void multiconv_process
 )
 {
     multiconv_data *pData = (multiconv_data*)(hMCnv);
-    int s, ch, i;
-    int numChannels;
+    int ch;
  
     multiconv_checkReInit(hMCnv);
 
-    /* prep */
-    numChannels = pData->nChannels;
-
-    for(s=0; s<nSamples; s++){
-        /* Load input signals into inFIFO buffer */
-        for(ch=0; ch<MIN(MIN(nInputs,numChannels),MAX_NUM_CHANNELS); ch++)
-            pData->inFIFO[ch][pData->FIFO_idx] = inputs[ch][s];
-        for(; ch<numChannels; ch++) /* Zero any channels that were not given */
-            pData->inFIFO[ch][pData->FIFO_idx] = 0.0f;
-
-        /* Pull output signals from outFIFO buffer */
-        for(ch=0; ch<MIN(MIN(nOutputs, numChannels),MAX_NUM_CHANNELS); ch++)
-            outputs[ch][s] = pData->outFIFO[ch][pData->FIFO_idx];
-        for(; ch<nOutputs; ch++) /* Zero any extra channels */
-            outputs[ch][s] = 0.0f;
-
-        /* Increment buffer index */
-        pData->FIFO_idx++;
-
-        /* Process frame if inFIFO is full and filters are loaded and saf_matrixConv_apply is ready for it */
-        if (pData->FIFO_idx >= pData->hostBlockSize_clamped && pData->reInitFilters == 0 ) {
-            pData->FIFO_idx = 0;
-
-            /* Load time-domain data */
-            for(i=0; i < numChannels; i++)
-                utility_svvcopy(pData->inFIFO[i], pData->hostBlockSize_clamped, pData->inputFrameTD[i]);
-
-            /* Apply convolution */
-            if(pData->hMultiConv != NULL)
-                saf_multiConv_apply(pData->hMultiConv, FLATTEN2D(pData->inputFrameTD), FLATTEN2D(pData->outputFrameTD));
-            else
-                memset(FLATTEN2D(pData->outputFrameTD), 0, MAX_NUM_CHANNELS * (pData->hostBlockSize_clamped)*sizeof(float));
-
-            /* copy signals to output buffer */
-            for (i = 0; i < MIN(numChannels, MAX_NUM_CHANNELS); i++)
-                utility_svvcopy(pData->outputFrameTD[i], pData->hostBlockSize_clamped, pData->outFIFO[i]);
-        }
-        else if(pData->FIFO_idx >= pData->hostBlockSize_clamped){
-            /* clear outFIFO if codec was not ready */
-            pData->FIFO_idx = 0;
-            memset(pData->outFIFO, 0, MAX_NUM_CHANNELS*MAX_FRAME_SIZE*sizeof(float));
-        }
-    }
+    /* Process frames if filters are loaded and saf_multiConv_apply is ready for it */
+    if (pData->reInitFilters == 0 && pData->hBlockAdaptor != NULL)
+        saf_blockAdaptor_apply(pData->hBlockAdaptor, inputs, outputs, nInputs, nOutputs,
+                               nSamples, multiconv_processFrame, hMCnv);
+    else
+        for (ch=0; ch < nOutputs; ch++)
+            memset(outputs[ch], 0, nSamples*sizeof(float));
 }
 
 
@@ -180,10 +180,9 @@ void multiconv_checkReInit(void* const hMCnv)
         pData->outputFrameTD = (float**)realloc2d((void**)pData->outputFrameTD, MAX_NUM_CHANNELS, pData->hostBlockSize_clamped, sizeof(float));
         memset(FLATTEN2D(pData->inputFrameTD), 0, MAX_NUM_CHANNELS*(pData->hostBlockSize_clamped)*sizeof(float));
 
-        /* reset FIFO buffers */
-        pData->FIFO_idx = 0;
-        memset(pData->inFIFO, 0, MAX_NUM_CHANNELS*MAX_FRAME_SIZE*sizeof(float));
-        memset(pData->outFIFO, 0, MAX_NUM_CHANNELS*MAX_FRAME_SIZE*sizeof(float));
+        /* (Re)create the block-size adaptor for the new frame size */
+        saf_blockAdaptor_destroy(&(pData->hBlockAdaptor));
+        saf_blockAdaptor_create(&(pData->hBlockAdaptor), pData->hostBlockSize_clamped, MAX_NUM_CHANNELS, MAX_NUM_CHANNELS);
 
         pData->reInitFilters = 0;
     }
@@ -199,14 +198,28 @@ void multiconv_setFilters
 )
 {
     multiconv_data *pData = (multiconv_data*)(hMCnv);
-    int i;
+    int i, prev_nfilters, prev_filter_length;
+    void* hFilters;
     
+    prev_nfilters = pData->nfilters;
+    prev_filter_length = pData->filter_length;
     pData->filters = realloc1d(pData->filters, numChannels*numSamples*sizeof(float));
     pData->nfilters = numChannels;
     pData->filter_length = numSamples;
     for(i=0; i<numChannels; i++)
         memcpy(&(pData->filters[i*numSamples]), H[i], numSamples*sizeof(float));
     pData->filter_fs = sampleRate;
+
+    /* If the dimensions are unchanged, then the new filters are transformed here
+     * and swapped into the existing convolver (with a crossfade), rather than
+     * re-creating it */
+    if(pData->reInitFilters == 0 && pData->hMultiConv != NULL &&
+       pData->nfilters == prev_nfilters && pData->filter_length == prev_filter_length){
+        saf_multiConv_createFilters(pData->hMultiConv, pData->filters, &hFilters);
+        if(saf_multiConv_swapFilters(pData->hMultiConv, hFilters, FILTER_CROSSFADE_LENGTH))
+            return;
+        saf_multiConv_destroyFilters(&hFilters); /* previous swap still in progress */
+    }
     pData->reInitFilters = 1;
 }
 
@@ -272,5 +285,13 @@ int multiconv_getHostFs(void* const hMCnv)
 int multiconv_getProcessingDelay(void* const hMCnv)
 {
     multiconv_data *pData = (multiconv_data*)(hMCnv);
-    return pData->hostBlockSize_clamped;
+    int frameSize;
+
+    /* The block-size adaptor only adds a frame of delay if the host block size
+     * is not a multiple of the frame size */
+    frameSize = CLAMP(pData->hostBlockSize, MIN_FRAME_SIZE, MAX_FRAME_SIZE);
+    if (pData->hostBlockSize % frameSize == 0 &&
+        (pData->hBlockAdaptor == NULL || saf_blockAdaptor_getDelay(pData->hBlockAdaptor) == 0))
+        return 0;
+    return frameSize;
 }
@@ -41,6 +41,7 @@ extern "C" {
 
 #define MIN_FRAME_SIZE ( 512 )
 #define MAX_FRAME_SIZE ( 8192 ) 
+#define FILTER_CROSSFADE_LENGTH ( 4096 ) /**< Crossfade length, in samples, when new filters are hot-swapped */
 #ifndef DEG2RAD
 # define DEG2RAD(x) (x * PI / 180.0f)
 #endif
@@ -58,11 +59,6 @@ extern "C" {
  */
 typedef struct _multiconv
 {
-    /* FIFO buffers */
-    int FIFO_idx;
-    float inFIFO[MAX_NUM_CHANNELS][MAX_FRAME_SIZE];
-    float outFIFO[MAX_NUM_CHANNELS][MAX_FRAME_SIZE];
-
     /* Internal buffers */
     float** inputFrameTD;
     float** outputFrameTD;
@@ -71,6 +67,7 @@ typedef struct _multiconv
     void* hMultiConv;
     int hostBlockSize;
     int hostBlockSize_clamped; /**< Clamped between MIN and #MAX_FRAME_SIZE */
+    void* hBlockAdaptor;   /**< block-size adaptor handle */
     float* filters;   /**< FLAT: nfilters x filter_length */
     int nfilters;
     int filter_length;
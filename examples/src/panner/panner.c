@@ -46,17 +46,34 @@ void panner_create
 (
     void ** const phPan
 )
+{
+    panner_createWithFrameSize(phPan, DEFAULT_TF_FRAME_SIZE);
+}
+
+void panner_createWithFrameSize
+(
+    void ** const phPan,
+    int frameSize
+)
 {
     panner_data* pData = (panner_data*)malloc1d(sizeof(panner_data));
     *phPan = (void*)pData;
     int ch, dummy;
 
+    /* frame size (= afSTFT hop size), which is fixed for the lifetime of the instance */
+    pData->frameSize = IS_VALID_TF_FRAME_SIZE(frameSize) ? frameSize : DEFAULT_TF_FRAME_SIZE;
+    pData->hopSize = pData->frameSize;
+    pData->nBands = pData->hopSize + 5;
+    pData->timeSlots = pData->frameSize / pData->hopSize;
+    pData->LDmode = 0;
+    pData->new_LDmode = 0;
+
     /* default user parameters */
     panner_loadPreset(SOURCE_CONFIG_PRESET_DEFAULT, pData->src_dirs_deg, &(pData->new_nSources), &(dummy)); /*check setStateInformation if you change default preset*/
     pData->nSources = pData->new_nSources;
     pData->DTT = 0.5f;
     pData->spread_deg = 0.0f;
-    panner_loadPreset(SOURCE_CONFIG_PRESET_5PX, pData->loudpkrs_dirs_deg, &(pData->new_nLoudpkrs), &(pData->output_nDims)); /*check setStateInformation if you change default preset*/
+    panner_loadPreset(SOURCE_CONFIG_PRESET_5PX, pData->loudpkrs_dirs_deg, &(pData->new_nLoudpkrs), &dummy); /*check setStateInformation if you change default preset*/
     pData->nLoudpkrs = pData->new_nLoudpkrs;
     pData->yaw = 0.0f;
     pData->pitch = 0.0f;
@@ -66,30 +83,32 @@ void panner_create
     pData->bFlipRoll = 0;
     
     /* time-frequency transform + buffers */
-    pData->hSTFT = NULL;
-    pData->STFTInputFrameTF = malloc1d(MAX_NUM_INPUTS*sizeof(complexVector));
-    pData->STFTOutputFrameTF = malloc1d(MAX_NUM_OUTPUTS*sizeof(complexVector));
-    for(ch=0; ch< MAX_NUM_INPUTS; ch++) {
-        pData->STFTInputFrameTF[ch].re = (float*)calloc1d(HYBRID_BANDS, sizeof(float));
-        pData->STFTInputFrameTF[ch].im = (float*)calloc1d(HYBRID_BANDS, sizeof(float));
-    }
-    for(ch=0; ch< MAX_NUM_OUTPUTS; ch++) {
-        pData->STFTOutputFrameTF[ch].re = (float*)calloc1d(HYBRID_BANDS, sizeof(float));
-        pData->STFTOutputFrameTF[ch].im = (float*)calloc1d(HYBRID_BANDS, sizeof(float));
-    }
-    pData->tempHopFrameTD = (float**)malloc2d( MAX(MAX_NUM_INPUTS, MAX_NUM_OUTPUTS), HOP_SIZE, sizeof(float));
+    pData->inputFrameTD = (float**)malloc2d(MAX_NUM_INPUTS, pData->frameSize, sizeof(float));
+    pData->outputFrameTD = (float**)malloc2d(MAX_NUM_OUTPUTS, pData->frameSize, sizeof(float));
+    pData->inputframeTF = (float_complex***)malloc3d(pData->nBands, MAX_NUM_INPUTS, pData->timeSlots, sizeof(float_complex));
+    pData->outputframeTF = (float_complex***)malloc3d(pData->nBands, MAX_NUM_OUTPUTS, pData->timeSlots, sizeof(float_complex));
+    pData->outputTemp = (float_complex**)malloc2d(MAX_NUM_OUTPUTS, pData->timeSlots, sizeof(float_complex));
+    pData->freqVector = calloc1d(pData->nBands, sizeof(float));
+    pData->pValue = calloc1d(pData->nBands, sizeof(float));
+
+    /* codec states (afSTFT and gain table), which are built by _initCodec() */
+    saf_stateSwap_create(&(pData->hCodecState), panner_destroyCodecPars);
+    pData->pars = NULL;
+    pData->procPars = NULL;
     
-    /* flags and gain table */
+    /* flags and panning gains */
     pData->progressBar0_1 = 0.0f;
     pData->progressBarText = malloc1d(PROGRESSBARTEXT_CHAR_LENGTH*sizeof(char));
     strcpy(pData->progressBarText,"");
     pData->codecStatus = CODEC_STATUS_NOT_INITIALISED;
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
     for(ch=0; ch<MAX_NUM_INPUTS; ch++)
         pData->recalc_gainsFLAG[ch] = 1;
-    pData->vbap_gtable = NULL;
+    pData->G_src = (float_complex***)calloc3d(pData->nBands, MAX_NUM_INPUTS, MAX_NUM_OUTPUTS, sizeof(float_complex));
     pData->recalc_M_rotFLAG = 1;
     pData->reInitGainTables = 1;
+
+    /* block-size adaptor */
+    saf_blockAdaptor_create(&(pData->hBlockAdaptor), pData->frameSize, MAX_NUM_INPUTS, MAX_NUM_OUTPUTS);
 }
 
 void panner_destroy
@@ -98,31 +117,24 @@ void panner_destroy
 )
 {
     panner_data *pData = (panner_data*)(*phPan);
-    int ch;
 
     if (pData != NULL) {
-        /* not safe to free memory during intialisation/processing loop */
-        while (pData->codecStatus == CODEC_STATUS_INITIALISING ||
-               pData->procStatus == PROC_STATUS_ONGOING){
+        saf_blockAdaptor_destroy(&(pData->hBlockAdaptor));
+        /* not safe to free the codec states during intialisation (the
+         * processing loop must have already stopped) */
+        while (saf_atomic_loadInt(&(pData->codecStatus)) == CODEC_STATUS_INITIALISING)
             SAF_SLEEP(10);
-        }
+        saf_stateSwap_destroy(&(pData->hCodecState));
         
-        /* free afSTFT and buffers */
-        if(pData->hSTFT !=NULL)
-            afSTFTfree(pData->hSTFT);
-        for(ch=0; ch< MAX_NUM_INPUTS; ch++) {
-            free(pData->STFTInputFrameTF[ch].re);
-            free(pData->STFTInputFrameTF[ch].im);
-        }
-    
-        for (ch = 0; ch< MAX_NUM_OUTPUTS; ch++) {
-            free(pData->STFTOutputFrameTF[ch].re);
-            free(pData->STFTOutputFrameTF[ch].im);
-        }
-        free(pData->STFTInputFrameTF);
-        free(pData->STFTOutputFrameTF);
-        free(pData->tempHopFrameTD);
-        free(pData->vbap_gtable);
+        /* free buffers */
+        free(pData->inputFrameTD);
+        free(pData->outputFrameTD);
+        free(pData->inputframeTF);
+        free(pData->outputframeTF);
+        free(pData->outputTemp);
+        free(pData->freqVector);
+        free(pData->pValue);
+        free(pData->G_src);
         free(pData->progressBarText);
         
         free(pData);
@@ -137,22 +149,17 @@ void panner_init
 )
 {
     panner_data *pData = (panner_data*)(hPan);
-    int band;
     
     /* define frequency vector */
     pData->fs = sampleRate;
-    for(band=0; band <HYBRID_BANDS; band++){
-        if(sampleRate == 44100)
-            pData->freqVector[band] =  (float)__afCenterFreq44100[band];
-        else
-            pData->freqVector[band] =  (float)__afCenterFreq48e3[band];
-    }
+    afSTFTgetCenterFreqs(pData->hopSize, 1, (float)sampleRate, pData->freqVector);
     
     /* calculate pValue per frequency */
-    getPvalues(pData->DTT, pData->freqVector, HYBRID_BANDS, pData->pValue);
+    getPvalues(pData->DTT, pData->freqVector, pData->nBands, pData->pValue);
 
     /* reinitialise if needed */
     pData->recalc_M_rotFLAG = 1;
+    saf_blockAdaptor_reset(pData->hBlockAdaptor);
 }
 
 void panner_initCodec
@@ -161,80 +168,93 @@ void panner_initCodec
 )
 {
     panner_data *pData = (panner_data*)(hPan);
+    panner_codecPars* pars;
     
-    if (pData->codecStatus != CODEC_STATUS_NOT_INITIALISED)
+    /* The processing loop keeps running with the current codec state, while
+     * a new one is built here (so neither side ever waits for the other) */
+    if (!saf_atomic_compareExchangeInt(&(pData->codecStatus), CODEC_STATUS_NOT_INITIALISED, CODEC_STATUS_INITIALISING))
         return; /* re-init not required, or already happening */
-    while (pData->procStatus == PROC_STATUS_ONGOING){
-        /* re-init required, but we need to wait for the current processing loop to end */
-        pData->codecStatus = CODEC_STATUS_INITIALISING; /* indicate that we want to init */
-        SAF_SLEEP(10);
-    }
     
     /* for progress bar */
-    pData->codecStatus = CODEC_STATUS_INITIALISING;
     strcpy(pData->progressBarText,"Initialising");
     pData->progressBar0_1 = 0.0f;
     
-    /* reinit TFT if needed */
-    panner_initTFT(hPan);
+    /* new afSTFT */
+    pars = (panner_codecPars*)calloc1d(1, sizeof(panner_codecPars));
+    panner_initTFT(hPan, pars);
     
-    /* reinit gain tables */
-    if(pData->reInitGainTables){
-        panner_initGainTables(hPan);
+    /* reinit gain tables, or take them from the previous state */
+    if(pData->reInitGainTables || pData->pars==NULL || pData->pars->nLoudpkrs!=pars->nLoudpkrs){
         pData->reInitGainTables = 0;
+        panner_initGainTables(hPan, pars);
     }
+    else
+        panner_copyGainTables(pData->pars, pars);
     
-    /* done! */
+    /* hand the new state over to the processing loop */
+    saf_stateSwap_publish(pData->hCodecState, (void*)pars);
+    pData->pars = pars;
+    
+    /* done! (unless a setting changed in the meantime, in which case the
+     * status remains CODEC_STATUS_NOT_INITIALISED) */
     strcpy(pData->progressBarText,"Done!");
     pData->progressBar0_1 = 1.0f;
-    pData->codecStatus = CODEC_STATUS_INITIALISED;
-    
+    saf_atomic_compareExchangeInt(&(pData->codecStatus), CODEC_STATUS_INITIALISING, CODEC_STATUS_INITIALISED);
 }
 
-void panner_process
+/** Processes one frame of frameSize samples (see saf_blockAdaptor_apply()) */
+static void panner_processFrame
 (
     void  *  const hPan,
     float ** const inputs,
     float ** const outputs,
     int            nInputs,
-    int            nOutputs,
-    int            nSamples
+    int            nOutputs
 )
 {
     panner_data *pData = (panner_data*)(hPan);
+    panner_codecPars* pars;
     int t, ch, ls, i, band, nSources, nLoudspeakers, N_azi, aziIndex, elevIndex, idx3d, idx2D;
+    int frameSize, nBands, timeSlots;
     float aziRes, elevRes, pv_f, gains3D_sum_pvf, gains2D_sum_pvf, Rxyz[3][3], hypotxy;
-    float src_dirs[MAX_NUM_INPUTS][2], pValue[HYBRID_BANDS], gains3D[MAX_NUM_OUTPUTS], gains2D[MAX_NUM_OUTPUTS];
+    float src_dirs[MAX_NUM_INPUTS][2], gains3D[MAX_NUM_OUTPUTS], gains2D[MAX_NUM_OUTPUTS];
+    float* inPtrs[MAX_NUM_INPUTS], *outPtrs[MAX_NUM_OUTPUTS];
 	const float_complex calpha = cmplxf(1.0f, 0.0f), cbeta = cmplxf(0.0f, 0.0f);
-	float_complex outputTemp[MAX_NUM_OUTPUTS][TIME_SLOTS];
+
+    /* pick up the latest codec state (never blocks); the panning gains must
+     * be recomputed whenever it changes */
+    pars = (panner_codecPars*)saf_stateSwap_acquire(pData->hCodecState);
+    if(pars != pData->procPars){
+        pData->procPars = pars;
+        for(ch=0; ch<MAX_NUM_INPUTS; ch++)
+            pData->recalc_gainsFLAG[ch] = 1;
+        pData->recalc_M_rotFLAG = 1;
+    }
 
     /* copy user parameters to local variables */
     memcpy(src_dirs, pData->src_dirs_deg, MAX_NUM_INPUTS*2*sizeof(float));
-    memcpy(pValue, pData->pValue, HYBRID_BANDS*sizeof(float));
-    nSources = pData->nSources;
-    nLoudspeakers = pData->nLoudpkrs;
+    nSources = pars!=NULL ? pars->nSources : 0;
+    nLoudspeakers = pars!=NULL ? pars->nLoudpkrs : 0;
+    frameSize = pData->frameSize;
+    nBands = pData->nBands;
+    timeSlots = pData->timeSlots;
 
     /* apply panner */
-    if ((nSamples == FRAME_SIZE) && (pData->vbap_gtable != NULL) && (pData->codecStatus == CODEC_STATUS_INITIALISED) ) {
-        pData->procStatus = PROC_STATUS_ONGOING;
+    if ((pars != NULL) && (pars->vbap_gtable != NULL)) {
 
-        /* Load time-domain data */
+        /* Load time-domain data (the host frames are transformed directly) */
         for(i=0; i < MIN(nSources,nInputs); i++)
-            utility_svvcopy(inputs[i], FRAME_SIZE, pData->inputFrameTD[i]);
-        for(; i<MAX_NUM_INPUTS; i++)
-            memset(pData->inputFrameTD[i], 0, FRAME_SIZE * sizeof(float));
+            inPtrs[i] = inputs[i];
+        for(; i<nSources; i++){
+            memset(pData->inputFrameTD[i], 0, frameSize * sizeof(float));
+            inPtrs[i] = pData->inputFrameTD[i];
+        }
 
         /* Apply time-frequency transform (TFT) */
-        for(t=0; t< TIME_SLOTS; t++) {
-            for(ch = 0; ch < nSources; ch++)
-                utility_svvcopy(&(pData->inputFrameTD[ch][t*HOP_SIZE]), HOP_SIZE, pData->tempHopFrameTD[ch]);
-            afSTFTforward(pData->hSTFT, (float**)pData->tempHopFrameTD, (complexVector*)pData->STFTInputFrameTF);
-            for(band=0; band<HYBRID_BANDS; band++)
-                for(ch=0; ch < nSources; ch++)
-                    pData->inputframeTF[band][ch][t] = cmplxf(pData->STFTInputFrameTF[ch].re[band], pData->STFTInputFrameTF[ch].im[band]);
-        }
-        memset(pData->outputframeTF, 0, HYBRID_BANDS*MAX_NUM_OUTPUTS*TIME_SLOTS * sizeof(float_complex));
-        memset(outputTemp, 0, MAX_NUM_OUTPUTS*TIME_SLOTS * sizeof(float_complex));
+        afSTFTforwardFrame(pars->hSTFT, inPtrs, frameSize, MAX_NUM_INPUTS,
+                           AFSTFT_BANDS_CH_TIME, FLATTEN3D(pData->inputframeTF));
+        memset(FLATTEN3D(pData->outputframeTF), 0, nBands*MAX_NUM_OUTPUTS*timeSlots * sizeof(float_complex));
+        memset(FLATTEN2D(pData->outputTemp), 0, MAX_NUM_OUTPUTS*timeSlots * sizeof(float_complex));
 
         /* Main processing: */
         /* Rotate source directions */
@@ -259,9 +279,9 @@ void panner_process
         }
 
         /* Apply VBAP Panning */
-        if(pData->output_nDims == 3){/* 3-D case */
-            aziRes = (float)pData->vbapTableRes[0];
-            elevRes = (float)pData->vbapTableRes[1];
+        if(pars->output_nDims == 3){/* 3-D case */
+            aziRes = (float)pars->vbapTableRes[0];
+            elevRes = (float)pars->vbapTableRes[1];
             N_azi = (int)(360.0f / aziRes + 0.5f) + 1;
             for (ch = 0; ch < nSources; ch++) {
                 /* recalculate frequency dependent panning gains */
@@ -272,8 +292,8 @@ void panner_process
                     elevIndex = (int)((pData->src_dirs_rot_deg[ch][1] + 90.0f) / elevRes + 0.5f);
                     idx3d = elevIndex * N_azi + aziIndex;
                     for (ls = 0; ls < nLoudspeakers; ls++)
-                        gains3D[ls] =  pData->vbap_gtable[idx3d*nLoudspeakers+ls];
-                    for (band = 0; band < HYBRID_BANDS; band++){
+                        gains3D[ls] =  pars->vbap_gtable[idx3d*nLoudspeakers+ls];
+                    for (band = 0; band < nBands; band++){
                         /* apply pValue per frequency */
                         pv_f = pData->pValue[band];
                         if(pv_f != 2.0f){
@@ -292,26 +312,26 @@ void panner_process
                 }
             }
             /* apply panning gains */
-            for (band = 0; band < HYBRID_BANDS; band++) {
-                cblas_cgemm(CblasRowMajor, CblasTrans, CblasNoTrans, nLoudspeakers, TIME_SLOTS, nSources, &calpha,
-                    pData->G_src[band], MAX_NUM_OUTPUTS,
-                    pData->inputframeTF[band], TIME_SLOTS, &cbeta,
-                    outputTemp, TIME_SLOTS);
+            for (band = 0; band < nBands; band++) {
+                cblas_cgemm(CblasRowMajor, CblasTrans, CblasNoTrans, nLoudspeakers, timeSlots, nSources, &calpha,
+                    FLATTEN2D(pData->G_src[band]), MAX_NUM_OUTPUTS,
+                    FLATTEN2D(pData->inputframeTF[band]), timeSlots, &cbeta,
+                    FLATTEN2D(pData->outputTemp), timeSlots);
                 for (i = 0; i < nLoudspeakers; i++)
-                    for (t = 0; t < TIME_SLOTS; t++)
-                        pData->outputframeTF[band][i][t] = ccaddf(pData->outputframeTF[band][i][t], outputTemp[i][t]);
+                    for (t = 0; t < timeSlots; t++)
+                        pData->outputframeTF[band][i][t] = ccaddf(pData->outputframeTF[band][i][t], pData->outputTemp[i][t]);
             }
         }
         else{/* 2-D case */
-            aziRes = (float)pData->vbapTableRes[0];
+            aziRes = (float)pars->vbapTableRes[0];
             for (ch = 0; ch < nSources; ch++) {
                 /* recalculate frequency dependent panning gains */
                 if(pData->recalc_gainsFLAG[ch]){
                     //idx2D = (int)((matlab_fmodf(pData->src_dirs_deg[ch][0]+180.0f,360.0f)/aziRes)+0.5f);
                     idx2D = (int)((matlab_fmodf(pData->src_dirs_rot_deg[ch][0]+180.0f,360.0f)/aziRes)+0.5f);
                     for (ls = 0; ls < nLoudspeakers; ls++)
-                        gains2D[ls] = pData->vbap_gtable[idx2D*nLoudspeakers+ls];
-                    for (band = 0; band < HYBRID_BANDS; band++){
+                        gains2D[ls] = pars->vbap_gtable[idx2D*nLoudspeakers+ls];
+                    for (band = 0; band < nBands; band++){
                         /* apply pValue per frequency */
                         pv_f = pData->pValue[band];
                         if(pv_f != 2.0f){
@@ -329,40 +349,62 @@ void panner_process
                     pData->recalc_gainsFLAG[ch] = 0;
                 }
                 /* apply panning gains */
-                for (band = 0; band < HYBRID_BANDS; band++){
+                for (band = 0; band < nBands; band++){
                     for (ls = 0; ls < nLoudspeakers; ls++)
-                        for (t = 0; t < TIME_SLOTS; t++)
-                            pData->outputframeTF[band][ls][t] = ccaddf(pData->outputframeTF[band][ls][t], ccmulf(pData->inputframeTF[band][ch][t], pData->G_src[band][ch][ls]));
+                        cblas_caxpy(timeSlots, &(pData->G_src[band][ch][ls]), pData->inputframeTF[band][ch], 1, pData->outputframeTF[band][ls], 1);
                 }
             }
         }
         /* scale by sqrt(number of sources) */
-        for (band = 0; band < HYBRID_BANDS; band++)
+        for (band = 0; band < nBands; band++)
             for (ls = 0; ls < nLoudspeakers; ls++)
-                for (t = 0; t < TIME_SLOTS; t++)
+                for (t = 0; t < timeSlots; t++)
                     pData->outputframeTF[band][ls][t] = crmulf(pData->outputframeTF[band][ls][t], 1.0f/sqrtf((float)nSources));
 
-        /* inverse-TFT and copy to output */
-        for(t = 0; t < TIME_SLOTS; t++) {
-            for(band = 0; band < HYBRID_BANDS; band++) {
-                for(ch = 0; ch < nLoudspeakers; ch++) {
-                    pData->STFTOutputFrameTF[ch].re[band] = crealf(pData->outputframeTF[band][ch][t]);
-                    pData->STFTOutputFrameTF[ch].im[band] = cimagf(pData->outputframeTF[band][ch][t]);
-                }
-            }
-            afSTFTinverse(pData->hSTFT, pData->STFTOutputFrameTF, pData->tempHopFrameTD);
-            for (ch = 0; ch < MIN(nLoudspeakers, nOutputs); ch++)
-                utility_svvcopy(pData->tempHopFrameTD[ch], HOP_SIZE, &(outputs[ch][t* HOP_SIZE]));
-            for (; ch < nOutputs; ch++)
-                memset(&(outputs[ch][t* HOP_SIZE]), 0, HOP_SIZE*sizeof(float));
-        }
+        /* inverse-TFT (directly into the host frames, as the inputs have
+         * already been read) */
+        for (ch = 0; ch < nLoudspeakers; ch++)
+            outPtrs[ch] = ch < nOutputs ? outputs[ch] : pData->outputFrameTD[ch];
+        afSTFTinverseFrame(pars->hSTFT, FLATTEN3D(pData->outputframeTF), frameSize, MAX_NUM_OUTPUTS,
+                           AFSTFT_BANDS_CH_TIME, outPtrs);
+        for (ch = nLoudspeakers; ch < nOutputs; ch++)
+            memset(outputs[ch], 0, frameSize*sizeof(float));
     }
     else
         for (ch=0; ch < nOutputs; ch++)
-            memset(outputs[ch],0, FRAME_SIZE*sizeof(float));
+            memset(outputs[ch],0, frameSize*sizeof(float));
+}
 
+void panner_process
+(
+    void  *  const hPan,
+    float ** const inputs,
+    float ** const outputs,
+    int            nInputs,
+    int            nOutputs,
+    int            nSamples
+)
+{
+    panner_data *pData = (panner_data*)(hPan);
+
+    saf_blockAdaptor_apply(pData->hBlockAdaptor, inputs, outputs, nInputs, nOutputs,
+                           nSamples, panner_processFrame, hPan);
+}
+
+void panner_processInterleaved
+(
+    void  *  const hPan,
+    const float *  inputs,
+    float *        outputs,
+    int            nInputs,
+    int            nOutputs,
+    int            nSamples
+)
+{
+    panner_data *pData = (panner_data*)(hPan);
 
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
+    saf_blockAdaptor_applyStrided(pData->hBlockAdaptor, inputs, 1, nInputs, outputs, 1, nOutputs,
+                                  nInputs, nOutputs, nSamples, panner_processFrame, hPan);
 }
 
 
@@ -498,7 +540,7 @@ void panner_setDTT(void* const hPan, float newValue)
     int ch;
     if(pData->DTT != newValue){
         pData->DTT = newValue;
-        getPvalues(pData->DTT, pData->freqVector, HYBRID_BANDS, pData->pValue);
+        getPvalues(pData->DTT, pData->freqVector, pData->nBands, pData->pValue);
         for(ch=0; ch<pData->new_nSources; ch++)
             pData->recalc_gainsFLAG[ch] = 1;
         pData->recalc_M_rotFLAG = 1;
@@ -568,18 +610,33 @@ void panner_setFlipRoll(void* const hBin, int newState)
     }
 }
 
+void panner_setLowDelayMode(void* const hPan, int newState)
+{
+    panner_data *pData = (panner_data*)(hPan);
+    if(pData->new_LDmode != (newState ? 1 : 0)){
+        pData->new_LDmode = newState ? 1 : 0;
+        panner_setCodecStatus(hPan, CODEC_STATUS_NOT_INITIALISED);
+    }
+}
+
 
 /* Get Functions */
 
 int panner_getFrameSize(void)
 {
-    return FRAME_SIZE;
+    return DEFAULT_TF_FRAME_SIZE;
+}
+
+int panner_getFrameSizeEx(void* const hPan)
+{
+    panner_data *pData = (panner_data*)(hPan);
+    return pData->frameSize;
 }
 
 CODEC_STATUS panner_getCodecStatus(void* const hPan)
 {
     panner_data *pData = (panner_data*)(hPan);
-    return pData->codecStatus;
+    return (CODEC_STATUS)saf_atomic_loadInt(&(pData->codecStatus));
 }
 
 float panner_getProgressBar0_1(void* const hPan)
@@ -694,7 +751,19 @@ int panner_getFlipRoll(void* const hBin)
     return pData->bFlipRoll;
 }
 
-int panner_getProcessingDelay()
+int panner_getLowDelayMode(void* const hPan)
+{
+    panner_data *pData = (panner_data*)(hPan);
+    return pData->new_LDmode;
+}
+
+int panner_getProcessingDelay(void)
 {
-    return 12*HOP_SIZE;
+    return afSTFTgetProcessingDelay(DEFAULT_TF_FRAME_SIZE, 0, 1);
+}
+
+int panner_getProcessingDelayEx(void* const hPan)
+{
+    panner_data *pData = (panner_data*)(hPan);
+    return afSTFTgetProcessingDelay(pData->hopSize, pData->LDmode, 1) + saf_blockAdaptor_getDelay(pData->hBlockAdaptor);
 }
@@ -46,15 +46,27 @@
 void panner_setCodecStatus(void* const hPan, CODEC_STATUS newStatus)
 {
     panner_data *pData = (panner_data*)(hPan);
-    if(newStatus==CODEC_STATUS_NOT_INITIALISED){
-        /* Pause until current initialisation is complete */
-        while(pData->codecStatus == CODEC_STATUS_INITIALISING)
-            SAF_SLEEP(10);
+    saf_atomic_storeInt(&(pData->codecStatus), (int)newStatus);
+}
+
+void panner_destroyCodecPars(void** const phPars)
+{
+    panner_codecPars *pars = (panner_codecPars*)(*phPars);
+
+    if(pars!=NULL){
+        if(pars->hSTFT!=NULL)
+            afSTFTfree(pars->hSTFT);
+        free(pars->vbap_gtable);
+        free(pars);
+        *phPars = NULL;
     }
-    pData->codecStatus = newStatus;
 }
 
-void panner_initGainTables(void* const hPan)
+void panner_initGainTables
+(
+    void* const hPan,
+    panner_codecPars* pars
+)
 {
     panner_data *pData = (panner_data*)(hPan);
 #ifndef FORCE_3D_LAYOUT
@@ -63,53 +75,67 @@ void panner_initGainTables(void* const hPan)
     
     /* determine dimensionality */
     sum_elev = 0.0f;
-    for(i=0; i<pData->nLoudpkrs; i++)
+    for(i=0; i<pars->nLoudpkrs; i++)
         sum_elev += fabsf(pData->loudpkrs_dirs_deg[i][1]); 
     if(sum_elev < 0.01f)
-        pData->output_nDims = 2;
+        pars->output_nDims = 2;
     else
-        pData->output_nDims = 3;
+        pars->output_nDims = 3;
 #endif
     
     /* generate VBAP gain table */
-    free(pData->vbap_gtable);
-    pData->vbapTableRes[0] = 1;
-    pData->vbapTableRes[1] = 1;
+    pars->vbapTableRes[0] = 1;
+    pars->vbapTableRes[1] = 1;
 #ifdef FORCE_3D_LAYOUT
-    pData->output_nDims = 3;
-    generateVBAPgainTable3D((float*)pData->loudpkrs_dirs_deg, pData->nLoudpkrs, pData->vbapTableRes[0], pData->vbapTableRes[1], 1, 1, pData->spread_deg,
-                            &(pData->vbap_gtable), &(pData->N_vbap_gtable), &(pData->nTriangles));
+    pars->output_nDims = 3;
+    generateVBAPgainTable3D((float*)pData->loudpkrs_dirs_deg, pars->nLoudpkrs, pars->vbapTableRes[0], pars->vbapTableRes[1], 1, 1, pData->spread_deg,
+                            &(pars->vbap_gtable), &(pars->N_vbap_gtable), &(pars->nTriangles));
 #else
-    if(pData->output_nDims==2)
-        generateVBAPgainTable2D((float*)pData->loudpkrs_dirs_deg, pData->nLoudpkrs, pData->vbapTableRes[0],
-                                &(pData->vbap_gtable), &(pData->N_vbap_gtable), &(pData->nTriangles));
-    else{
-        generateVBAPgainTable3D((float*)pData->loudpkrs_dirs_deg, pData->nLoudpkrs, pData->vbapTableRes[0], pData->vbapTableRes[1], 1, 1, pData->spread_deg,
-                                &(pData->vbap_gtable), &(pData->N_vbap_gtable), &(pData->nTriangles));
-        if(pData->vbap_gtable==NULL){
-            /* if generating vbap gain tabled failed, re-calculate with 2D VBAP */
-            pData->output_nDims = 2;
-            panner_initGainTables(hPan);
-        }
+    if(pars->output_nDims==3){
+        generateVBAPgainTable3D((float*)pData->loudpkrs_dirs_deg, pars->nLoudpkrs, pars->vbapTableRes[0], pars->vbapTableRes[1], 1, 1, pData->spread_deg,
+                                &(pars->vbap_gtable), &(pars->N_vbap_gtable), &(pars->nTriangles));
+        if(pars->vbap_gtable==NULL)
+            pars->output_nDims = 2; /* if generating vbap gain tabled failed, re-calculate with 2D VBAP */
     }
+    if(pars->output_nDims==2)
+        generateVBAPgainTable2D((float*)pData->loudpkrs_dirs_deg, pars->nLoudpkrs, pars->vbapTableRes[0],
+                                &(pars->vbap_gtable), &(pars->N_vbap_gtable), &(pars->nTriangles));
 #endif
 }
 
+void panner_copyGainTables
+(
+    panner_codecPars* src,
+    panner_codecPars* dst
+)
+{
+    memcpy(dst->vbapTableRes, src->vbapTableRes, 2*sizeof(int));
+    dst->N_vbap_gtable = src->N_vbap_gtable;
+    dst->nTriangles = src->nTriangles;
+    dst->output_nDims = src->output_nDims;
+    if(src->vbap_gtable!=NULL){
+        dst->vbap_gtable = malloc1d(src->N_vbap_gtable*(src->nLoudpkrs)*sizeof(float));
+        memcpy(dst->vbap_gtable, src->vbap_gtable, src->N_vbap_gtable*(src->nLoudpkrs)*sizeof(float));
+    }
+}
+
 void panner_initTFT
 (
-    void* const hPan
+    void* const hPan,
+    panner_codecPars* pars
 )
 {
     panner_data *pData = (panner_data*)(hPan);
     
-    if(pData->hSTFT==NULL)
-        afSTFTinit(&(pData->hSTFT), HOP_SIZE, pData->new_nSources, pData->new_nLoudpkrs, 0, 1);
-    else if (pData->new_nSources!=pData->nSources || pData->new_nLoudpkrs!=pData->nLoudpkrs){
-        afSTFTchannelChange(pData->hSTFT, pData->new_nSources, pData->new_nLoudpkrs);
-        afSTFTclearBuffers(pData->hSTFT); 
-    }
+    /* a new afSTFT is created for every codec state, as the one of the
+     * current state may still be in use by the processing loop */
+    pData->LDmode = pData->new_LDmode;
     pData->nSources = pData->new_nSources;
     pData->nLoudpkrs = pData->new_nLoudpkrs;
+    pars->LDmode = pData->LDmode;
+    pars->nSources = pData->nSources;
+    pars->nLoudpkrs = pData->nLoudpkrs;
+    afSTFTinit(&(pars->hSTFT), pData->hopSize, pars->nSources, pars->nLoudpkrs, pars->LDmode, 1);
 }
 
 void panner_loadPreset
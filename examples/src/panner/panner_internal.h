@@ -60,12 +60,6 @@ extern "C" {
 
 #define FORCE_3D_LAYOUT /* Even 2D loudspeaker setups will use 3D VBAP, with 2 virtual loudspeakers on the top/bottom */
 
-#ifndef FRAME_SIZE
-# define FRAME_SIZE ( 128 ) 
-#endif
-#define HOP_SIZE ( 128 )                            /* STFT hop size = nBands */
-#define HYBRID_BANDS ( HOP_SIZE + 5 )               /* hybrid mode incurs an additional 5 bands  */
-#define TIME_SLOTS ( FRAME_SIZE / HOP_SIZE )        /* 4/8/16 */
 #ifndef DEG2RAD
 # define DEG2RAD(x) (x * SAF_PI / 180.0f)
 #endif
@@ -79,33 +73,64 @@ extern "C" {
 /* ========================================================================== */
 
 /**
- * Main structure for panner. Contains variables for audio buffers, afSTFT,
- * internal variables, flags, user parameters
+ * Codec state of panner: the afSTFT and VBAP gain table for one configuration
+ *
+ * A new state is built by panner_initCodec() and handed over to the processing
+ * loop via a saf_stateSwap (see saf_stateSwap_create()). Once published, it is
+ * no longer modified; except for the afSTFT buffers, which only the processing
+ * loop uses.
+ */
+typedef struct _panner_codecPars
+{
+    /* afSTFT */
+    int nSources;           /**< number of sources the afSTFT is initialised for */
+    int nLoudpkrs;          /**< number of loudspeakers the afSTFT is initialised for */
+    int LDmode;             /**< low-delay mode of the afSTFT */
+    void* hSTFT;            /**< afSTFT handle */
+
+    /* vbap gain table */
+    int vbapTableRes[2];
+    float* vbap_gtable;     /**< N_vbap_gtable x nLoudpkrs */
+    int N_vbap_gtable;
+    int nTriangles;
+    int output_nDims;       /**< 2: 2-D, 3: 3-D */
+
+} panner_codecPars;
+
+/**
+ * Main structure for panner. Contains variables for audio buffers, codec
+ * states, internal variables, flags, user parameters
  */
 typedef struct _panner
 {
     /* audio buffers */
-    float inputFrameTD[MAX_NUM_INPUTS][FRAME_SIZE];
-    float_complex inputframeTF[HYBRID_BANDS][MAX_NUM_INPUTS][TIME_SLOTS];
-    float_complex outputframeTF[HYBRID_BANDS][MAX_NUM_OUTPUTS][TIME_SLOTS];
-    complexVector* STFTInputFrameTF;
-    complexVector* STFTOutputFrameTF;
-    float** tempHopFrameTD;
+    float** inputFrameTD;   /**< MAX_NUM_INPUTS x frameSize */
+    float** outputFrameTD;  /**< MAX_NUM_OUTPUTS x frameSize */
+    float_complex*** inputframeTF;  /**< nBands x MAX_NUM_INPUTS x timeSlots */
+    float_complex*** outputframeTF; /**< nBands x MAX_NUM_OUTPUTS x timeSlots */
+    float_complex** outputTemp;     /**< MAX_NUM_OUTPUTS x timeSlots */
     int fs;
     
     /* time-frequency transform */
-    float freqVector[HYBRID_BANDS];
-    void* hSTFT;
+    int frameSize;          /**< processing frame size, in samples (fixed at creation) */
+    int hopSize;            /**< afSTFT hop size, in samples */
+    int nBands;             /**< number of (hybrid) frequency bands; hopSize + 5 */
+    int timeSlots;          /**< number of time slots per frame; frameSize / hopSize */
+    int LDmode;             /**< low-delay mode of the latest codec state */
+    int new_LDmode;         /**< new low-delay mode; applied when the afSTFT is re-initialised */
+    float* freqVector;      /**< nBands x 1 */
+    void* hBlockAdaptor;
+    
+    /* codec states */
+    void* hCodecState;          /**< saf_stateSwap handing panner_codecPars to the processing loop */
+    panner_codecPars* pars;     /**< latest codec state built by panner_initCodec() (NULL if none) */
+    panner_codecPars* procPars; /**< codec state last used by the processing loop (only accessed by it) */
     
     /* Internal */
-    int vbapTableRes[2];
-    float* vbap_gtable; /**< N_hrtf_vbap_gtable x nLoudpkrs */
-    int N_vbap_gtable;
-    float_complex G_src[HYBRID_BANDS][MAX_NUM_INPUTS][MAX_NUM_OUTPUTS];
+    float_complex*** G_src; /**< panning gains; nBands x MAX_NUM_INPUTS x MAX_NUM_OUTPUTS */
     
     /* flags */
-    CODEC_STATUS codecStatus;
-    PROC_STATUS procStatus;
+    volatile int codecStatus; /**< see #_CODEC_STATUS enum */
     float progressBar0_1;
     char* progressBarText;
     int recalc_gainsFLAG[MAX_NUM_INPUTS];
@@ -116,11 +141,9 @@ typedef struct _panner
     float src_dirs_rot_deg[MAX_NUM_INPUTS][2];
     float src_dirs_rot_xyz[MAX_NUM_INPUTS][3];
     float src_dirs_xyz[MAX_NUM_INPUTS][3]; 
-    int nTriangles;
-    int output_nDims; /**< 2: 2-D, 3: 3-D */
     
     /* pValue */
-    float pValue[HYBRID_BANDS];
+    float* pValue;          /**< nBands x 1 */
     
     /* user parameters */
     int nSources, new_nSources;
@@ -140,22 +163,43 @@ typedef struct _panner
 
 /**
  * Sets codec status (see #_CODEC_STATUS enum)
+ *
+ * This never waits: if the codec is being initialised, then setting
+ * #CODEC_STATUS_NOT_INITIALISED causes panner_initCodec() to leave the status
+ * as such, so that the next call re-initialises the codec again.
  */
 void panner_setCodecStatus(void* const hPan, CODEC_STATUS newStatus);
+
+/**
+ * Destroys a codec state (see saf_stateSwap_destroyFn)
+ *
+ * @param[in] phPars (&) address of the panner_codecPars
+ */
+void panner_destroyCodecPars(void** const phPars);
     
 /**
- * Intialises the VBAP gain table used for panning.
+ * Intialises the VBAP gain table used for panning, for a new codec state.
  *
- * @note Call ambi_dec_initTFT() (if needed) before calling this function
+ * @note Call panner_initTFT() before calling this function
+ */
+void panner_initGainTables(void* const hPan,
+                           panner_codecPars* pars);
+
+/**
+ * Copies the VBAP gain table of a previous codec state into a new one (for when
+ * only the afSTFT configuration has changed)
  */
-void panner_initGainTables(void* const hPan);
+void panner_copyGainTables(panner_codecPars* src,
+                           panner_codecPars* dst);
     
 /**
- * Initialise the filterbank used by panner.
+ * Initialise the filterbank of a new codec state, for the current number of
+ * sources/loudspeakers and low-delay mode.
  *
  * @note Call this function before panner_initGainTables()
  */
-void panner_initTFT(void* const hPan);
+void panner_initTFT(void* const hPan,
+                    panner_codecPars* pars);
     
 /**
  * Loads source/loudspeaker directions from preset
@@ -40,7 +40,7 @@ void pitch_shifter_create
     pData->fftsize_option = PITCH_SHIFTER_FFTSIZE_4096;
 
     /* internals */
-    pData->hSmb = NULL;
+    saf_stateSwap_create(&(pData->hCodecState), pitch_shifter_destroyCodecPars);
     pData->progressBar0_1 = 0.0f;
     pData->progressBarText = malloc1d(PROGRESSBARTEXT_CHAR_LENGTH*sizeof(char));
     strcpy(pData->progressBarText,"");
@@ -49,13 +49,10 @@ void pitch_shifter_create
     pData->stepsize = 1024; /* same here */
 
     /* flags */
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
     pData->codecStatus = CODEC_STATUS_NOT_INITIALISED;
 
-    /* set FIFO buffers */
-    pData->FIFO_idx = 0;
-    memset(pData->inFIFO, 0, MAX_NUM_CHANNELS*FRAME_SIZE*sizeof(float));
-    memset(pData->outFIFO, 0, MAX_NUM_CHANNELS*FRAME_SIZE*sizeof(float));
+    /* block-size adaptor */
+    saf_blockAdaptor_create(&(pData->hBlockAdaptor), FRAME_SIZE, MAX_NUM_CHANNELS, MAX_NUM_CHANNELS);
 }
 
 void pitch_shifter_destroy
@@ -66,14 +63,14 @@ void pitch_shifter_destroy
     pitch_shifter_data *pData = (pitch_shifter_data*)(*phPS);
 
     if (pData != NULL) {
-        /* not safe to free memory during intialisation/processing loop */
-        while (pData->codecStatus == CODEC_STATUS_INITIALISING ||
-               pData->procStatus == PROC_STATUS_ONGOING){
+        /* not safe to free the codec states during intialisation (the
+         * processing loop must have already stopped) */
+        while (saf_atomic_loadInt(&(pData->codecStatus)) == CODEC_STATUS_INITIALISING)
             SAF_SLEEP(10);
-        }
+        saf_stateSwap_destroy(&(pData->hCodecState));
 
-        if (pData->hSmb != NULL)
-            smb_pitchShift_destroy(&(pData->hSmb));
+        saf_blockAdaptor_destroy(&(pData->hBlockAdaptor));
+        free(pData->progressBarText);
         free(pData);
         pData = NULL;
     }
@@ -87,6 +84,7 @@ void pitch_shifter_init
 {
     pitch_shifter_data *pData = (pitch_shifter_data*)(hPS);
 
+    saf_blockAdaptor_reset(pData->hBlockAdaptor);
     if(pData->sampleRate != sampleRate){
         pData->sampleRate = sampleRate;
         pitch_shifter_setCodecStatus(hPS, CODEC_STATUS_NOT_INITIALISED);
@@ -99,27 +97,20 @@ void pitch_shifter_initCodec
 )
 {
     pitch_shifter_data *pData = (pitch_shifter_data*)(hPS);
+    pitch_shifter_codecPars* pars;
     int nChannels, fftSize, osamp;
 
-    if (pData->codecStatus != CODEC_STATUS_NOT_INITIALISED)
+    /* The processing loop keeps running with the current codec state, while
+     * a new one is built here (so neither side ever waits for the other) */
+    if (!saf_atomic_compareExchangeInt(&(pData->codecStatus), CODEC_STATUS_NOT_INITIALISED, CODEC_STATUS_INITIALISING))
         return; /* re-init not required, or already happening */
-    while (pData->procStatus == PROC_STATUS_ONGOING){
-        /* re-init required, but we need to wait for the current processing loop to end */
-        pData->codecStatus = CODEC_STATUS_INITIALISING; /* indicate that we want to init */
-        SAF_SLEEP(10);
-    }
 
     /* for progress bar */
-    pData->codecStatus = CODEC_STATUS_INITIALISING;
     strcpy(pData->progressBarText,"Initialising pitch shifter");
     pData->progressBar0_1 = 0.0f;
 
     nChannels = pData->new_nChannels;
 
-    /* destroy current handle*/
-    if (pData->hSmb != NULL)
-        smb_pitchShift_destroy(&(pData->hSmb));
-
     /* Config */
     switch(pData->osamp_option){
         case PITCH_SHIFTER_OSAMP_2:  osamp = 2; break;
@@ -136,74 +127,99 @@ void pitch_shifter_initCodec
         case PITCH_SHIFTER_FFTSIZE_8192:  fftSize = 8192; break;
         case PITCH_SHIFTER_FFTSIZE_16384: fftSize = 16384; break;
     }
-    pData->fftFrameSize = fftSize;
-    pData->stepsize = fftSize/osamp;
+    pars = (pitch_shifter_codecPars*)calloc1d(1, sizeof(pitch_shifter_codecPars));
+    pars->nChannels = nChannels;
+    pars->fftFrameSize = fftSize;
+    pars->stepsize = fftSize/osamp;
 
     /* Create new handle */
-    smb_pitchShift_create(&(pData->hSmb), nChannels, fftSize, osamp, pData->sampleRate);
-    pData->nChannels = nChannels;
+    smb_pitchShift_create(&(pars->hSmb), nChannels, fftSize, osamp, pData->sampleRate);
+
+    /* hand the new state over to the processing loop */
+    saf_stateSwap_publish(pData->hCodecState, (void*)pars);
+    pData->nChannels = pars->nChannels;
+    pData->fftFrameSize = pars->fftFrameSize;
+    pData->stepsize = pars->stepsize;
 
-    /* done! */
+    /* done! (unless a setting changed in the meantime, in which case the
+     * status remains CODEC_STATUS_NOT_INITIALISED) */
     strcpy(pData->progressBarText,"Done!");
     pData->progressBar0_1 = 1.0f;
-    pData->codecStatus = CODEC_STATUS_INITIALISED;
+    saf_atomic_compareExchangeInt(&(pData->codecStatus), CODEC_STATUS_INITIALISING, CODEC_STATUS_INITIALISED);
 }
 
-void pitch_shifter_process
+/** Processes one frame of FRAME_SIZE samples (see saf_blockAdaptor_apply()) */
+static void pitch_shifter_processFrame
 (
     void  *  const hPS,
     float ** const inputs,
     float ** const outputs,
     int            nInputs,
-    int            nOutputs,
-    int            nSamples
+    int            nOutputs
 )
 {
     pitch_shifter_data *pData = (pitch_shifter_data*)(hPS);
-    int s, ch, nChannels;
-    nChannels = pData->nChannels;
+    pitch_shifter_codecPars* pars;
+    int ch, nChannels;
+
+    /* pick up the latest codec state (never blocks) */
+    pars = (pitch_shifter_codecPars*)saf_stateSwap_acquire(pData->hCodecState);
 
-    /* Loop over all samples */
-    for(s=0; s<nSamples; s++){
-        /* Load input signals into inFIFO buffer */
+    /* Process frame if codec is ready for it */
+    if (pars != NULL) {
+        nChannels = pars->nChannels;
+
+        /* load input */
         for(ch=0; ch<MIN(nInputs,nChannels); ch++)
-            pData->inFIFO[ch][pData->FIFO_idx] = inputs[ch][s];
+            memcpy(pData->inputFrame[ch], inputs[ch], FRAME_SIZE*sizeof(float));
         for(; ch<nChannels; ch++) /* Zero any channels that were not given */
-            pData->inFIFO[ch][pData->FIFO_idx] = 0.0f;
+            memset(pData->inputFrame[ch], 0, FRAME_SIZE*sizeof(float));
+
+        /* Apply pitch shifting */
+        smb_pitchShift_apply(pars->hSmb, pData->pitchShift_factor, FRAME_SIZE, (float*)pData->inputFrame, (float*)pData->outputFrame);
 
-        /* Pull output signals from outFIFO buffer */
+        /* Copy to output */
         for(ch=0; ch<MIN(nOutputs, nChannels); ch++)
-            outputs[ch][s] = pData->outFIFO[ch][pData->FIFO_idx];
+            memcpy(outputs[ch], pData->outputFrame[ch], FRAME_SIZE*sizeof(float));
         for(; ch<nOutputs; ch++) /* Zero any extra channels */
-            outputs[ch][s] = 0.0f;
-
-        /* Increment buffer index */
-        pData->FIFO_idx++;
-
-        /* Process frame if inFIFO is full and codec is ready for it */
-        if (pData->FIFO_idx >= FRAME_SIZE && (pData->codecStatus == CODEC_STATUS_INITIALISED) ) {
-            pData->FIFO_idx = 0;
-            pData->procStatus = PROC_STATUS_ONGOING;
-
-            /* load input */
-            for(ch=0; ch<nChannels; ch++)
-                memcpy(pData->inputFrame[ch], pData->inFIFO[ch], FRAME_SIZE*sizeof(float));
-
-            /* Apply pitch shifting */
-            smb_pitchShift_apply(pData->hSmb, pData->pitchShift_factor, FRAME_SIZE, (float*)pData->inputFrame, (float*)pData->outputFrame);
-
-            /* Copy to output */
-            for(ch=0; ch<nChannels; ch++)
-                memcpy(pData->outFIFO[ch], pData->outputFrame[ch], FRAME_SIZE*sizeof(float));
-        }
-        else if(pData->FIFO_idx >= FRAME_SIZE){
-            /* clear outFIFO if codec was not ready */
-            pData->FIFO_idx = 0;
-            memset(pData->outFIFO, 0, MAX_NUM_CHANNELS*FRAME_SIZE*sizeof(float));
-        }
+            memset(outputs[ch], 0, FRAME_SIZE*sizeof(float));
     }
+    else{
+        for(ch=0; ch<nOutputs; ch++)
+            memset(outputs[ch], 0, FRAME_SIZE*sizeof(float));
+    }
+}
+
+void pitch_shifter_process
+(
+    void  *  const hPS,
+    float ** const inputs,
+    float ** const outputs,
+    int            nInputs,
+    int            nOutputs,
+    int            nSamples
+)
+{
+    pitch_shifter_data *pData = (pitch_shifter_data*)(hPS);
+
+    saf_blockAdaptor_apply(pData->hBlockAdaptor, inputs, outputs, nInputs, nOutputs,
+                           nSamples, pitch_shifter_processFrame, hPS);
+}
+
+void pitch_shifter_processInterleaved
+(
+    void  *  const hPS,
+    const float *  inputs,
+    float *        outputs,
+    int            nInputs,
+    int            nOutputs,
+    int            nSamples
+)
+{
+    pitch_shifter_data *pData = (pitch_shifter_data*)(hPS);
 
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
+    saf_blockAdaptor_applyStrided(pData->hBlockAdaptor, inputs, 1, nInputs, outputs, 1, nOutputs,
+                                  nInputs, nOutputs, nSamples, pitch_shifter_processFrame, hPS);
 }
 
 /* sets */
@@ -259,7 +275,7 @@ int pitch_shifter_getFrameSize(void)
 CODEC_STATUS pitch_shifter_getCodecStatus(void* const hBin)
 {
     pitch_shifter_data *pData = (pitch_shifter_data*)(hBin);
-    return pData->codecStatus;
+    return (CODEC_STATUS)saf_atomic_loadInt(&(pData->codecStatus));
 }
 
 float pitch_shifter_getProgressBar0_1(void* const hBin)
@@ -301,6 +317,6 @@ int pitch_shifter_getNCHrequired(void* const hPS)
 int pitch_shifter_getProcessingDelay(void* const hPS)
 {
     pitch_shifter_data *pData = (pitch_shifter_data*)(hPS);
-    return FRAME_SIZE + pData->fftFrameSize - (pData->stepsize);
+    return saf_blockAdaptor_getDelay(pData->hBlockAdaptor) + pData->fftFrameSize - (pData->stepsize);
 }
 
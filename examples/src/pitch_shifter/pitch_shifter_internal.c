@@ -28,11 +28,18 @@
 void pitch_shifter_setCodecStatus(void* const hPS, CODEC_STATUS newStatus)
 {
     pitch_shifter_data *pData = (pitch_shifter_data*)(hPS);
-    if(newStatus==CODEC_STATUS_NOT_INITIALISED){
-        /* Pause until current initialisation is complete */
-        while(pData->codecStatus == CODEC_STATUS_INITIALISING)
-            SAF_SLEEP(10);
+    saf_atomic_storeInt(&(pData->codecStatus), (int)newStatus);
+}
+
+void pitch_shifter_destroyCodecPars(void** const phPars)
+{
+    pitch_shifter_codecPars *pars = (pitch_shifter_codecPars*)(*phPars);
+
+    if(pars!=NULL){
+        if (pars->hSmb != NULL)
+            smb_pitchShift_destroy(&(pars->hSmb));
+        free(pars);
+        *phPars = NULL;
     }
-    pData->codecStatus = newStatus;
 }
 
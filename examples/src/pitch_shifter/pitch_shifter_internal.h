@@ -48,22 +48,37 @@ extern "C" {
 /*                                 Structures                                 */
 /* ========================================================================== */
 
+/**
+ * Codec state of the pitch_shifter: the smb_pitchShift instance for one
+ * configuration
+ *
+ * A new state is built by pitch_shifter_initCodec() and handed over to the
+ * processing loop via a saf_stateSwap (see saf_stateSwap_create()). Once
+ * published, its configuration is no longer modified; only the processing loop
+ * uses its pitch shifter.
+ */
+typedef struct _pitch_shifter_codecPars
+{
+    void* hSmb;                /**< smb_pitchShift handle */
+    int nChannels;             /**< number of channels the state is built for */
+    int fftFrameSize;          /**< FFT size */
+    int stepsize;              /**< hop size; fftFrameSize/oversampling factor */
+
+} pitch_shifter_codecPars;
+
 /**
  * Main struct for the pitch_shifter
  */
 typedef struct _pitch_shifter
 {
-    /* FIFO buffers */
-    int FIFO_idx;
-    float inFIFO[MAX_NUM_CHANNELS][FRAME_SIZE];
-    float outFIFO[MAX_NUM_CHANNELS][FRAME_SIZE];
+    /* block-size adaptor */
+    void* hBlockAdaptor;
 
     /* internal */
-    void* hSmb;
-    CODEC_STATUS codecStatus;
+    void* hCodecState;         /**< saf_stateSwap handing pitch_shifter_codecPars to the processing loop */
+    volatile int codecStatus;  /**< see #_CODEC_STATUS enum */
     float progressBar0_1;
     char* progressBarText;
-    PROC_STATUS procStatus;
     float sampleRate;
     float inputFrame[MAX_NUM_CHANNELS][FRAME_SIZE];
     float outputFrame[MAX_NUM_CHANNELS][FRAME_SIZE];
@@ -85,9 +100,20 @@ typedef struct _pitch_shifter
 
 /**
  * Sets codec status (see #_CODEC_STATUS enum)
+ *
+ * This never waits: if the codec is being initialised, then setting
+ * #CODEC_STATUS_NOT_INITIALISED causes pitch_shifter_initCodec() to leave the
+ * status as such, so that the next call re-initialises the codec again.
  */
 void pitch_shifter_setCodecStatus(void* const hPS,
                                   CODEC_STATUS newStatus);
+
+/**
+ * Destroys a codec state (see saf_stateSwap_destroyFn)
+ *
+ * @param[in] phPars (&) address of the pitch_shifter_codecPars
+ */
+void pitch_shifter_destroyCodecPars(void** const phPars);
     
     
 #ifdef __cplusplus
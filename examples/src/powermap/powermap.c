@@ -35,14 +35,30 @@ void powermap_create
 (
     void ** const phPm
 )
+{
+    powermap_createWithHopSize(phPm, DEFAULT_TF_FRAME_SIZE);
+}
+
+void powermap_createWithHopSize
+(
+    void ** const phPm,
+    int hopSize
+)
 {
     powermap_data* pData = (powermap_data*)malloc1d(sizeof(powermap_data));
     *phPm = (void*)pData;
-    int n, i, ch, band;
+    int band;
+
+    /* TFT dimensions (fixed for the lifetime of the instance) */
+    pData->hopSize = IS_VALID_TF_FRAME_SIZE(hopSize) && hopSize<=FRAME_SIZE ? hopSize : DEFAULT_TF_FRAME_SIZE;
+    pData->nBands = pData->hopSize + 5;
+    pData->timeSlots = FRAME_SIZE / pData->hopSize;
 
     /* Default user parameters */
     pData->masterOrder = pData->new_masterOrder = SH_ORDER_FIRST;
-    for(band=0; band<HYBRID_BANDS; band++){
+    pData->analysisOrderPerBand = malloc1d(pData->nBands*sizeof(int));
+    pData->pmapEQ = malloc1d(pData->nBands*sizeof(float));
+    for(band=0; band<pData->nBands; band++){
         pData->analysisOrderPerBand[band] = pData->masterOrder;
         pData->pmapEQ[band] = 1.0f;
     }
@@ -55,43 +71,31 @@ void powermap_create
     pData->chOrdering = CH_ACN;
     pData->norm = NORM_SN3D;
     
-    afSTFTinit(&(pData->hSTFT), HOP_SIZE, MAX_NUM_SH_SIGNALS, 0, 0, 1);
-    pData->STFTInputFrameTF = malloc1d(MAX_NUM_SH_SIGNALS*sizeof(complexVector));
-    for(ch=0; ch< MAX_NUM_SH_SIGNALS; ch++) {
-        pData->STFTInputFrameTF[ch].re = (float*)calloc1d(HYBRID_BANDS, sizeof(float));
-        pData->STFTInputFrameTF[ch].im = (float*)calloc1d(HYBRID_BANDS, sizeof(float));
-    }
-    pData->tempHopFrameTD = (float**)malloc2d(MAX_NUM_SH_SIGNALS, HOP_SIZE, sizeof(float));
+    pData->SHframeTD = (float**)malloc2d(MAX_NUM_SH_SIGNALS, FRAME_SIZE, sizeof(float));
+    pData->SHframeTF = (float_complex***)malloc3d(pData->nBands, MAX_NUM_SH_SIGNALS, pData->timeSlots, sizeof(float_complex));
+    pData->freqVector = calloc1d(pData->nBands, sizeof(float));
+    pData->Cx = (float_complex***)calloc3d(pData->nBands, MAX_NUM_SH_SIGNALS, MAX_NUM_SH_SIGNALS, sizeof(float_complex));
     
-    /* codec data */
-    pData->pars = (powermap_codecPars*)malloc1d(sizeof(powermap_codecPars));
-    powermap_codecPars* pars = pData->pars;
-    pars->interp_dirs_deg = NULL;
-    for(n=0; n<MAX_SH_ORDER; n++){
-        pars->Y_grid[n] = NULL;
-        pars->Y_grid_cmplx[n] = NULL;
-    }
-    pars->interp_table = NULL;
+    /* codec states (afSTFT, scanning grid and powermap engine), which are
+     * built by _initCodec() */
+    saf_stateSwap_create(&(pData->hCodecState), powermap_destroyCodecPars);
+    pData->procPars = NULL;
     
     /* internal */
     pData->progressBar0_1 = 0.0f;
     pData->progressBarText = malloc1d(PROGRESSBARTEXT_CHAR_LENGTH*sizeof(char));
     strcpy(pData->progressBarText,"");
     pData->codecStatus = CODEC_STATUS_NOT_INITIALISED;
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
     pData->dispWidth = 140;
 
     /* display */
-    pData->pmap = NULL;
-    pData->prev_pmap = NULL;
-    for(i=0; i<NUM_DISP_SLOTS; i++)
-        pData->pmap_grid[i] = NULL;
-    pData->pmapReady = 0;
+    pData->dispSlotIdx = 0;
+    pData->dispPars = NULL;
     pData->recalcPmap = 1;
+    pData->resetPmapAvg = 0;
 
-    /* set FIFO buffer */
-    pData->FIFO_idx = 0;
-    memset(pData->inFIFO, 0, MAX_NUM_SH_SIGNALS*FRAME_SIZE*sizeof(float));
+    /* block-size adaptor */
+    saf_blockAdaptor_create(&(pData->hBlockAdaptor), FRAME_SIZE, MAX_NUM_SH_SIGNALS, 0);
 }
 
 void powermap_destroy
@@ -100,38 +104,23 @@ void powermap_destroy
 )
 {
     powermap_data *pData = (powermap_data*)(*phPm);
-    powermap_codecPars* pars;
-    int i, ch;
     
     if (pData != NULL) {
-        /* not safe to free memory during intialisation/processing loop */
-        while (pData->codecStatus == CODEC_STATUS_INITIALISING ||
-               pData->procStatus == PROC_STATUS_ONGOING){
+        /* not safe to free the codec states during intialisation (the
+         * processing loop must have already stopped) */
+        while (saf_atomic_loadInt(&(pData->codecStatus)) == CODEC_STATUS_INITIALISING)
             SAF_SLEEP(10);
-        }
-
-        pars = pData->pars;
-        /* free afSTFT and buffers */
-        afSTFTfree(pData->hSTFT);
-        for (ch = 0; ch< MAX_NUM_SH_SIGNALS; ch++) {
-            free(pData->STFTInputFrameTF[ch].re);
-            free(pData->STFTInputFrameTF[ch].im);
-        }
-        free(pData->STFTInputFrameTF);
-        free(pData->tempHopFrameTD);
-        
-        free(pData->pmap);
-        free(pData->prev_pmap);
-        for(i=0; i<NUM_DISP_SLOTS; i++)
-            free(pData->pmap_grid[i]);
-        free(pars->interp_dirs_deg);
-        for(i=0; i<MAX_SH_ORDER; i++){
-            free(pars->Y_grid[i]);
-            free(pars->Y_grid_cmplx[i]);
-        }
-        free(pars->interp_table);
-        free(pData->pars);
+        saf_stateSwap_destroy(&(pData->hCodecState));
+
+        /* free buffers */
+        free(pData->SHframeTD);
+        free(pData->SHframeTF);
+        free(pData->freqVector);
+        free(pData->Cx);
+        free(pData->analysisOrderPerBand);
+        free(pData->pmapEQ);
         free(pData->progressBarText);
+        saf_blockAdaptor_destroy(&(pData->hBlockAdaptor));
         free(pData);
         pData = NULL;
     }
@@ -144,30 +133,18 @@ void powermap_init
 )
 {
     powermap_data *pData = (powermap_data*)(hPm);
-    powermap_codecPars* pars = pData->pars;
-    int band;
     
     pData->fs = sampleRate;
     
-    /* specify frequency vector and determine the number of bands */
-    switch ((int)(sampleRate+0.5f)){
-        case 44100:
-            for(band=0; band<HYBRID_BANDS; band++)
-                pData->freqVector[band] = (float)__afCenterFreq44100[band];
-            break;
-        default:
-        case 48000:
-            for(band=0; band<HYBRID_BANDS; band++)
-                pData->freqVector[band] = (float)__afCenterFreq48e3[band];
-            break;
-    }
+    /* specify frequency vector */
+    afSTFTgetCenterFreqs(pData->hopSize, 1, sampleRate, pData->freqVector);
     
     /* intialise parameters */
-    memset(pData->Cx, 0 , MAX_NUM_SH_SIGNALS*MAX_NUM_SH_SIGNALS*HYBRID_BANDS*sizeof(float_complex));
-    if(pData->prev_pmap!=NULL)
-        memset(pData->prev_pmap, 0, pars->grid_nDirs*sizeof(float));
-    pData->pmapReady = 0;
+    memset(FLATTEN3D(pData->Cx), 0, pData->nBands*MAX_NUM_SH_SIGNALS*MAX_NUM_SH_SIGNALS*sizeof(float_complex));
+    pData->resetPmapAvg = 1;
+    saf_atomic_storePtr(&(pData->dispPars), NULL);
     pData->dispSlotIdx = 0;
+    saf_blockAdaptor_reset(pData->hBlockAdaptor);
 }
 
 void powermap_initCodec
@@ -176,247 +153,264 @@ void powermap_initCodec
 )
 {
     powermap_data *pData = (powermap_data*)(hPm);
+    powermap_codecPars* pars;
     
-    if (pData->codecStatus != CODEC_STATUS_NOT_INITIALISED)
+    /* The processing loop keeps running with the current codec state, while
+     * a new one is built here (so neither side ever waits for the other) */
+    if (!saf_atomic_compareExchangeInt(&(pData->codecStatus), CODEC_STATUS_NOT_INITIALISED, CODEC_STATUS_INITIALISING))
         return; /* re-init not required, or already happening */
-    while (pData->procStatus == PROC_STATUS_ONGOING){
-        /* re-init required, but we need to wait for the current processing loop to end */
-        pData->codecStatus = CODEC_STATUS_INITIALISING; /* indicate that we want to init */
-        SAF_SLEEP(10);
-    }
     
     /* for progress bar */
-    pData->codecStatus = CODEC_STATUS_INITIALISING;
     strcpy(pData->progressBarText,"Initialising");
     pData->progressBar0_1 = 0.0f;
     
-    powermap_initTFT(hPm);
-    powermap_initAna(hPm);
+    pars = (powermap_codecPars*)calloc1d(1, sizeof(powermap_codecPars));
+    powermap_initTFT(hPm, pars);
+    powermap_initAna(hPm, pars);
+    
+    /* hand the new state over to the processing loop */
+    saf_stateSwap_publish(pData->hCodecState, (void*)pars);
+    pData->masterOrder = pars->masterOrder;
     
-    /* done! */
+    /* done! (unless a setting changed in the meantime, in which case the
+     * status remains CODEC_STATUS_NOT_INITIALISED) */
     strcpy(pData->progressBarText,"Done!");
     pData->progressBar0_1 = 1.0f;
-    pData->codecStatus = CODEC_STATUS_INITIALISED;
+    saf_atomic_compareExchangeInt(&(pData->codecStatus), CODEC_STATUS_INITIALISING, CODEC_STATUS_INITIALISED);
 }
 
-void powermap_analysis
+/** Analyses one frame of FRAME_SIZE samples (see saf_blockAdaptor_apply()) */
+static void powermap_analysisFrame
 (
     void  *  const hPm,
     float ** const inputs,
+    float ** const outputs,
     int            nInputs,
-    int            nSamples,
-    int            isPlaying
+    int            nOutputs
 )
 {
     powermap_data *pData = (powermap_data*)(hPm);
-    powermap_codecPars* pars = pData->pars;
-    int s, i, j, t, ch, band, nSH_order, order_band, nSH_maxOrder, maxOrder;
+    powermap_codecPars* pars;
+    int i, j, ch, band, nSH_order, order_band, nSH_maxOrder, maxOrder, nBands, timeSlots;
     float C_grp_trace, covScale, pmapEQ_band;
     const float_complex calpha = cmplxf(1.0f, 0.0f), cbeta = cmplxf(0.0f, 0.0f);
     float_complex new_Cx[MAX_NUM_SH_SIGNALS][MAX_NUM_SH_SIGNALS];
-    float_complex* C_grp;
+    float_complex* C_grp, *Y_grid;
+    void* hPM;
     
     /* local parameters */
-    int analysisOrderPerBand[HYBRID_BANDS];
     int nSources, masterOrder, nSH;
     float covAvgCoeff, pmapAvgCoeff;
-    float pmapEQ[HYBRID_BANDS];
     NORM_TYPES norm;
     CH_ORDER chOrdering;
     POWERMAP_MODES pmap_mode;
-    memcpy(analysisOrderPerBand, pData->analysisOrderPerBand, HYBRID_BANDS*sizeof(int));
-    memcpy(pmapEQ, pData->pmapEQ, HYBRID_BANDS*sizeof(float));
+
+    /* pick up the latest codec state (never blocks); the covariance matrices
+     * and powermap averaging start afresh whenever it changes */
+    pars = (powermap_codecPars*)saf_stateSwap_acquire(pData->hCodecState);
+    if(pars != pData->procPars){
+        saf_atomic_storePtr(&(pData->dispPars), NULL);
+        pData->procPars = pars;
+        memset(FLATTEN3D(pData->Cx), 0, pData->nBands*MAX_NUM_SH_SIGNALS*MAX_NUM_SH_SIGNALS*sizeof(float_complex));
+        pData->dispSlotIdx = 0;
+        pData->resetPmapAvg = 0;
+    }
+
+    nBands = pData->nBands;
+    timeSlots = pData->timeSlots;
     norm = pData->norm;
     chOrdering = pData->chOrdering;
     nSources = pData->nSources;
     covAvgCoeff = MIN(pData->covAvgCoeff, MAX_COV_AVG_COEFF);
     pmapAvgCoeff = pData->pmapAvgCoeff;
     pmap_mode = pData->pmap_mode;
-    masterOrder = pData->masterOrder;
+    masterOrder = pars!=NULL ? pars->masterOrder : 0;
     nSH = (masterOrder+1)*(masterOrder+1);
 
-    /* Loop over all samples */
-    for(s=0; s<nSamples; s++){
-        /* Load input signals into inFIFO buffer */
+    /* (analysis only, no outputs) */
+    (void)outputs;
+    (void)nOutputs;
+
+    /* Process frame if codec is ready for it */
+    if (pars != NULL) {
+        /* Load time-domain data */
         for(ch=0; ch<MIN(nInputs,nSH); ch++)
-            pData->inFIFO[ch][pData->FIFO_idx] = inputs[ch][s];
+            memcpy(pData->SHframeTD[ch], inputs[ch], FRAME_SIZE*sizeof(float));
         for(; ch<nSH; ch++) /* Zero any channels that were not given */
-            pData->inFIFO[ch][pData->FIFO_idx] = 0.0f;
+            memset(pData->SHframeTD[ch], 0, FRAME_SIZE*sizeof(float));
 
-        /* Increment buffer index */
-        pData->FIFO_idx++;
+        /* account for input channel order */
+        switch(chOrdering){
+            case CH_ACN: /* already ACN */
+                break;
+            case CH_FUMA:
+                convertHOAChannelConvention(FLATTEN2D(pData->SHframeTD), masterOrder, FRAME_SIZE, HOA_CH_ORDER_FUMA, HOA_CH_ORDER_ACN);
+                break;
+        }
 
-        /* Process frame if inFIFO is full and codec is ready for it */
-        if (pData->FIFO_idx >= FRAME_SIZE && (pData->codecStatus == CODEC_STATUS_INITIALISED) && isPlaying ) {
-            pData->FIFO_idx = 0;
-            pData->procStatus = PROC_STATUS_ONGOING;
+        /* account for input normalisation scheme */
+        switch(norm){
+            case NORM_N3D:  /* already in N3D, do nothing */
+                break;
+            case NORM_SN3D: /* convert to N3D */
+                convertHOANormConvention(FLATTEN2D(pData->SHframeTD), masterOrder, FRAME_SIZE, HOA_NORM_SN3D, HOA_NORM_N3D);
+                break;
+            case NORM_FUMA: /* only for first-order, convert to N3D */
+                convertHOANormConvention(FLATTEN2D(pData->SHframeTD), masterOrder, FRAME_SIZE, HOA_NORM_FUMA, HOA_NORM_N3D);
+                break;
+        }
 
-            /* Load time-domain data */
-            for(ch=0; ch<nSH; ch++)
-                memcpy(pData->SHframeTD[ch],pData->inFIFO[ch], FRAME_SIZE*sizeof(float));
+        /* apply the time-frequency transform */
+        afSTFTforwardFrame(pars->hSTFT, pData->SHframeTD, FRAME_SIZE, MAX_NUM_SH_SIGNALS,
+                           AFSTFT_BANDS_CH_TIME, FLATTEN3D(pData->SHframeTF));
+
+        /* Update covarience matrix per band */
+        covScale = 1.0f/(float)(nSH);
+        for(band=0; band<nBands; band++){
+            cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasConjTrans, nSH, nSH, timeSlots, &calpha,
+                        FLATTEN2D(pData->SHframeTF[band]), timeSlots,
+                        FLATTEN2D(pData->SHframeTF[band]), timeSlots, &cbeta,
+                        new_Cx, MAX_NUM_SH_SIGNALS);
+
+            /* scale with nSH */
+            for(i=0; i<nSH; i++)
+                for(j=0; j<nSH; j++)
+                    new_Cx[i][j] = crmulf(new_Cx[i][j], covScale);
+
+            /* average over time */
+            for(i=0; i<nSH; i++)
+                for(j=0; j<nSH; j++)
+                    pData->Cx[band][i][j] = ccaddf( crmulf(new_Cx[i][j], 1.0f-covAvgCoeff), crmulf(pData->Cx[band][i][j], covAvgCoeff));
+        }
 
-            /* account for input channel order */
-            switch(chOrdering){
-                case CH_ACN: /* already ACN */
-                    break;
-                case CH_FUMA:
-                    convertHOAChannelConvention((float*)pData->SHframeTD, masterOrder, FRAME_SIZE, HOA_CH_ORDER_FUMA, HOA_CH_ORDER_ACN);
-                    break;
+        /* update the powermap */
+        if(pData->recalcPmap==1){
+            pData->recalcPmap = 0;
+            saf_atomic_storePtr(&(pData->dispPars), NULL);
+
+            /* determine maximum analysis order */
+            maxOrder = 1;
+            for(i=0; i<nBands; i++)
+                maxOrder = MAX(maxOrder, MIN(pData->analysisOrderPerBand[i], masterOrder));
+            nSH_maxOrder = (maxOrder+1)*(maxOrder+1);
+
+            /* group covarience matrices */
+            C_grp = pData->C_grp;
+            memset(C_grp, 0, nSH_maxOrder*nSH_maxOrder*sizeof(float_complex));
+            for (band=0; band<nBands; band++){
+                order_band = MAX(MIN(pData->analysisOrderPerBand[band], masterOrder),1);
+                nSH_order = (order_band+1)*(order_band+1);
+                pmapEQ_band = MIN(MAX(pData->pmapEQ[band], 0.0f), 2.0f);
+                for(i=0; i<nSH_order; i++)
+                    for(j=0; j<nSH_order; j++)
+                        C_grp[i*nSH_maxOrder+j] = ccaddf(C_grp[i*nSH_maxOrder+j], crmulf(pData->Cx[band][i][j], 1e3f*pmapEQ_band));
             }
 
-            /* account for input normalisation scheme */
-            switch(norm){
-                case NORM_N3D:  /* already in N3D, do nothing */
-                    break;
-                case NORM_SN3D: /* convert to N3D */
-                    convertHOANormConvention((float*)pData->SHframeTD, masterOrder, FRAME_SIZE, HOA_NORM_SN3D, HOA_NORM_N3D);
+            /* generate powermap */
+            C_grp_trace = 0.0f;
+            for(i=0; i<nSH_maxOrder; i++)
+                C_grp_trace+=crealf(C_grp[i*nSH_maxOrder+ i]);
+            hPM = pars->hPmapEngine;
+            Y_grid = pars->Y_grid_cmplx[maxOrder-1];
+            switch(pmap_mode){
+                default:
+                case PM_MODE_PWD:
+                    saf_pmapEngine_generatePWDmap(hPM, maxOrder, C_grp, Y_grid, pars->grid_nDirs, pars->pmap);
                     break;
-                case NORM_FUMA: /* only for first-order, convert to N3D */
-                    convertHOANormConvention((float*)pData->SHframeTD, masterOrder, FRAME_SIZE, HOA_NORM_FUMA, HOA_NORM_N3D);
-                    break;
-            }
 
-            /* apply the time-frequency transform */
-            for(t = 0; t < TIME_SLOTS; t++) {
-                for(ch = 0; ch < nSH; ch++)
-                    utility_svvcopy(&(pData->SHframeTD[ch][t*HOP_SIZE]), HOP_SIZE, pData->tempHopFrameTD[ch]);
-                afSTFTforward(pData->hSTFT, (float**)pData->tempHopFrameTD, (complexVector*)pData->STFTInputFrameTF);
-                for (band = 0; band < HYBRID_BANDS; band++)
-                    for (ch = 0; ch < nSH; ch++)
-                        pData->SHframeTF[band][ch][t] = cmplxf(pData->STFTInputFrameTF[ch].re[band], pData->STFTInputFrameTF[ch].im[band]);
-            }
-
-            /* Update covarience matrix per band */
-            covScale = 1.0f/(float)(nSH);
-            for(band=0; band<HYBRID_BANDS; band++){
-                cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasConjTrans, nSH, nSH, TIME_SLOTS, &calpha,
-                            pData->SHframeTF[band], TIME_SLOTS,
-                            pData->SHframeTF[band], TIME_SLOTS, &cbeta,
-                            new_Cx, MAX_NUM_SH_SIGNALS);
-
-                /* scale with nSH */
-                for(i=0; i<nSH; i++)
-                    for(j=0; j<nSH; j++)
-                        new_Cx[i][j] = crmulf(new_Cx[i][j], covScale);
-
-                /* average over time */
-                for(i=0; i<nSH; i++)
-                    for(j=0; j<nSH; j++)
-                        pData->Cx[band][i][j] = ccaddf( crmulf(new_Cx[i][j], 1.0f-covAvgCoeff), crmulf(pData->Cx[band][i][j], covAvgCoeff));
-            }
-
-            /* update the powermap */
-            if(pData->recalcPmap==1){
-                pData->recalcPmap = 0;
-                pData->pmapReady = 0;
-
-                /* determine maximum analysis order */
-                maxOrder = 1;
-                for(i=0; i<HYBRID_BANDS; i++)
-                    maxOrder = MAX(maxOrder, MIN(analysisOrderPerBand[i], masterOrder));
-                nSH_maxOrder = (maxOrder+1)*(maxOrder+1);
-
-                /* group covarience matrices */
-                C_grp = calloc1d(nSH_maxOrder*nSH_maxOrder, sizeof(float_complex));
-                for (band=0; band<HYBRID_BANDS; band++){
-                    order_band = MAX(MIN(pData->analysisOrderPerBand[band], masterOrder),1);
-                    nSH_order = (order_band+1)*(order_band+1);
-                    pmapEQ_band = MIN(MAX(pmapEQ[band], 0.0f), 2.0f);
-                    for(i=0; i<nSH_order; i++)
-                        for(j=0; j<nSH_order; j++)
-                            C_grp[i*nSH_maxOrder+j] = ccaddf(C_grp[i*nSH_maxOrder+j], crmulf(pData->Cx[band][i][j], 1e3f*pmapEQ_band));
-                }
+                case PM_MODE_MVDR:
+                    if(C_grp_trace>1e-8f)
+                        saf_pmapEngine_generateMVDRmap(hPM, maxOrder, C_grp, Y_grid, pars->grid_nDirs, 8.0f, pars->pmap, NULL);
+                    else
+                        memset(pars->pmap, 0, pars->grid_nDirs*sizeof(float));
+                    break;
 
-                /* generate powermap */
-                C_grp_trace = 0.0f;
-                for(i=0; i<nSH_maxOrder; i++)
-                    C_grp_trace+=crealf(C_grp[i*nSH_maxOrder+ i]);
-                switch(pmap_mode){
-                    default:
-                    case PM_MODE_PWD:
-                        generatePWDmap(maxOrder, C_grp, pars->Y_grid_cmplx[maxOrder-1], pars->grid_nDirs, pData->pmap);
-                        break;
-
-                    case PM_MODE_MVDR:
-                        if(C_grp_trace>1e-8f)
-                            generateMVDRmap(maxOrder, C_grp, pars->Y_grid_cmplx[maxOrder-1], pars->grid_nDirs, 8.0f, pData->pmap, NULL);
-                        else
-                            memset(pData->pmap, 0, pars->grid_nDirs*sizeof(float));
-                        break;
+                case PM_MODE_CROPAC_LCMV:
+                    if(C_grp_trace>1e-8f)
+                        saf_pmapEngine_generateCroPaCLCMVmap(hPM, maxOrder, C_grp, Y_grid, pars->grid_nDirs, 8.0f, 0.0f, pars->pmap);
+                    else
+                        memset(pars->pmap, 0, pars->grid_nDirs*sizeof(float));
+                    break;
 
-                    case PM_MODE_CROPAC_LCMV:
-                        if(C_grp_trace>1e-8f)
-                            generateCroPaCLCMVmap(maxOrder, C_grp, pars->Y_grid_cmplx[maxOrder-1], pars->grid_nDirs, 8.0f, 0.0f, pData->pmap);
-                        else
-                            memset(pData->pmap, 0, pars->grid_nDirs*sizeof(float));
-                        break;
+                case PM_MODE_MUSIC:
+                    if(C_grp_trace>1e-8f)
+                        saf_pmapEngine_generateMUSICmap(hPM, maxOrder, C_grp, Y_grid, nSources, pars->grid_nDirs, 0, pars->pmap);
+                    else
+                        memset(pars->pmap, 0, pars->grid_nDirs*sizeof(float));
+                    break;
 
-                    case PM_MODE_MUSIC:
-                        if(C_grp_trace>1e-8f)
-                            generateMUSICmap(maxOrder, C_grp, pars->Y_grid_cmplx[maxOrder-1], nSources, pars->grid_nDirs, 0, pData->pmap);
-                        else
-                            memset(pData->pmap, 0, pars->grid_nDirs*sizeof(float));
-                        break;
+                case PM_MODE_MUSIC_LOG:
+                    if(C_grp_trace>1e-8f)
+                        saf_pmapEngine_generateMUSICmap(hPM, maxOrder, C_grp, Y_grid, nSources, pars->grid_nDirs, 1, pars->pmap);
+                    else
+                        memset(pars->pmap, 0, pars->grid_nDirs*sizeof(float));
+                    break;
 
-                    case PM_MODE_MUSIC_LOG:
-                        if(C_grp_trace>1e-8f)
-                            generateMUSICmap(maxOrder, C_grp, pars->Y_grid_cmplx[maxOrder-1], nSources, pars->grid_nDirs, 1, pData->pmap);
-                        else
-                            memset(pData->pmap, 0, pars->grid_nDirs*sizeof(float));
-                        break;
+                case PM_MODE_MINNORM:
+                    if(C_grp_trace>1e-8f)
+                        saf_pmapEngine_generateMinNormMap(hPM, maxOrder, C_grp, Y_grid, nSources, pars->grid_nDirs, 0, pars->pmap);
+                    else
+                        memset(pars->pmap, 0, pars->grid_nDirs*sizeof(float));
+                    break;
 
-                    case PM_MODE_MINNORM:
-                        if(C_grp_trace>1e-8f)
-                            generateMinNormMap(maxOrder, C_grp, pars->Y_grid_cmplx[maxOrder-1], nSources, pars->grid_nDirs, 0, pData->pmap);
-                        else
-                            memset(pData->pmap, 0, pars->grid_nDirs*sizeof(float));
-                        break;
+                case PM_MODE_MINNORM_LOG:
+                    if(C_grp_trace>1e-8f)
+                        saf_pmapEngine_generateMinNormMap(hPM, maxOrder, C_grp, Y_grid, nSources, pars->grid_nDirs, 1, pars->pmap);
+                    else
+                        memset(pars->pmap, 0, pars->grid_nDirs*sizeof(float));
+                    break;
+            }
 
-                    case PM_MODE_MINNORM_LOG:
-                        if(C_grp_trace>1e-8f)
-                            generateMinNormMap(maxOrder, C_grp, pars->Y_grid_cmplx[maxOrder-1], nSources, pars->grid_nDirs, 1, pData->pmap);
-                        else
-                            memset(pData->pmap, 0, pars->grid_nDirs*sizeof(float));
-                        break;
-                }
-                free(C_grp);
-
-                /* average powermap over time */
-                for(i=0; i<pars->grid_nDirs; i++)
-                    pData->pmap[i] =  (1.0f-pmapAvgCoeff) * (pData->pmap[i] )+ pmapAvgCoeff * (pData->prev_pmap[i]);
-                utility_svvcopy(pData->pmap, pars->grid_nDirs, pData->prev_pmap);
-
-                /* interpolate powermap */
-                cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, pars->interp_nDirs, 1, pars->grid_nDirs, 1.0f,
-                            pars->interp_table, pars->grid_nDirs,
-                            pData->pmap, 1, 0.0f,
-                            pData->pmap_grid[pData->dispSlotIdx], 1);
-
-                /* ascertain minimum and maximum values for powermap colour scaling */
-                int ind;
-                utility_siminv(pData->pmap_grid[pData->dispSlotIdx], pars->interp_nDirs, &ind);
-                pData->pmap_grid_minVal = pData->pmap_grid[pData->dispSlotIdx][ind];
-                utility_simaxv(pData->pmap_grid[pData->dispSlotIdx], pars->interp_nDirs, &ind);
-                pData->pmap_grid_maxVal = pData->pmap_grid[pData->dispSlotIdx][ind];
-
-                /* normalise the powermap to 0..1 */
-                for(i=0; i<pars->interp_nDirs; i++)
-                    pData->pmap_grid[pData->dispSlotIdx][i] = (pData->pmap_grid[pData->dispSlotIdx][i]-pData->pmap_grid_minVal)/(pData->pmap_grid_maxVal-pData->pmap_grid_minVal+1e-11f);
-
-                /* signify that the powermap in current slot is ready for plotting */
-                pData->dispSlotIdx++;
-                if(pData->dispSlotIdx>=NUM_DISP_SLOTS)
-                    pData->dispSlotIdx = 0;
-                pData->pmapReady = 1;
+            /* average powermap over time */
+            if(pData->resetPmapAvg){
+                memset(pars->prev_pmap, 0, pars->grid_nDirs*sizeof(float));
+                pData->resetPmapAvg = 0;
             }
-        }
-        else if(pData->FIFO_idx >= FRAME_SIZE){
-            /* reset FIFO_idx if codec was not ready */
-            pData->FIFO_idx = 0;
+            for(i=0; i<pars->grid_nDirs; i++)
+                pars->pmap[i] =  (1.0f-pmapAvgCoeff) * (pars->pmap[i] )+ pmapAvgCoeff * (pars->prev_pmap[i]);
+            utility_svvcopy(pars->pmap, pars->grid_nDirs, pars->prev_pmap);
+
+            /* interpolate powermap */
+            cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, pars->interp_nDirs, 1, pars->grid_nDirs, 1.0f,
+                        pars->interp_table, pars->grid_nDirs,
+                        pars->pmap, 1, 0.0f,
+                        pars->pmap_grid[pData->dispSlotIdx], 1);
+
+            /* ascertain minimum and maximum values for powermap colour scaling */
+            int ind;
+            utility_siminv(pars->pmap_grid[pData->dispSlotIdx], pars->interp_nDirs, &ind);
+            pData->pmap_grid_minVal = pars->pmap_grid[pData->dispSlotIdx][ind];
+            utility_simaxv(pars->pmap_grid[pData->dispSlotIdx], pars->interp_nDirs, &ind);
+            pData->pmap_grid_maxVal = pars->pmap_grid[pData->dispSlotIdx][ind];
+
+            /* normalise the powermap to 0..1 */
+            for(i=0; i<pars->interp_nDirs; i++)
+                pars->pmap_grid[pData->dispSlotIdx][i] = (pars->pmap_grid[pData->dispSlotIdx][i]-pData->pmap_grid_minVal)/(pData->pmap_grid_maxVal-pData->pmap_grid_minVal+1e-11f);
+
+            /* signify that the powermap in current slot is ready for plotting */
+            pData->dispSlotIdx++;
+            if(pData->dispSlotIdx>=NUM_DISP_SLOTS)
+                pData->dispSlotIdx = 0;
+            saf_atomic_storePtr(&(pData->dispPars), (void*)pars); /* ready for plotting */
         }
     }
+}
 
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
+void powermap_analysis
+(
+    void  *  const hPm,
+    float ** const inputs,
+    int            nInputs,
+    int            nSamples,
+    int            isPlaying
+)
+{
+    powermap_data *pData = (powermap_data*)(hPm);
+
+    /* Frames are only analysed while the host is playing */
+    if(isPlaying)
+        saf_blockAdaptor_apply(pData->hBlockAdaptor, inputs, NULL, nInputs, 0,
+                               nSamples, powermap_analysisFrame, hPm);
 }
 
 /* SETS */
@@ -429,10 +423,8 @@ void powermap_refreshSettings(void* const hPm)
 void powermap_setPowermapMode(void* const hPm, int newMode)
 {
     powermap_data *pData = (powermap_data*)(hPm);
-    powermap_codecPars* pars = pData->pars;
     pData->pmap_mode = (POWERMAP_MODES)newMode;
-    if(pData->prev_pmap!=NULL)
-        memset(pData->prev_pmap, 0, pars->grid_nDirs*sizeof(float));
+    pData->resetPmapAvg = 1;
 }
 
 void powermap_setMasterOrder(void* const hPm,  int newValue)
@@ -472,14 +464,14 @@ void powermap_setSourcePreset(void* const hPm, int newPresetID)
     switch(newPresetID){
         case MIC_PRESET_IDEAL:
             /* Ideal SH should have maximum order per frequency */
-            for(band=0; band<HYBRID_BANDS; band++)
+            for(band=0; band<pData->nBands; band++)
                 pData->analysisOrderPerBand[band] = pData->new_masterOrder;
             break;
             
             /* In the case of real microphone arrays, the analysis order should be frequency dependent
             *  and the frequencies above the spatial-aliasing limit should be EQ's out. */
         case MIC_PRESET_ZYLIA:
-            for(band=0; band<HYBRID_BANDS; band++){
+            for(band=0; band<pData->nBands; band++){
                 if(rangeIdx<2*(__Zylia_maxOrder-1)){
                     if(pData->freqVector[band]>__Zylia_freqRange[rangeIdx]){
                         if(!reverse)
@@ -497,7 +489,7 @@ void powermap_setSourcePreset(void* const hPm, int newPresetID)
             break;
 
         case MIC_PRESET_EIGENMIKE32:
-            for(band=0; band<HYBRID_BANDS; band++){
+            for(band=0; band<pData->nBands; band++){
                 if(rangeIdx<2*(__Eigenmike32_maxOrder-1)){
                     if(pData->freqVector[band]>__Eigenmike32_freqRange[rangeIdx]){
                         if(!reverse)
@@ -515,7 +507,7 @@ void powermap_setSourcePreset(void* const hPm, int newPresetID)
             break;
 
         case MIC_PRESET_DTU_MIC:
-            for(band=0; band<HYBRID_BANDS; band++){
+            for(band=0; band<pData->nBands; band++){
                 if(rangeIdx<2*(__DTU_mic_maxOrder-1)){
                     if(pData->freqVector[band]>__DTU_mic_freqRange[rangeIdx]){
                         if(!reverse)
@@ -545,7 +537,7 @@ void powermap_setAnaOrderAllBands(void  * const hPm, int newValue)
     powermap_data *pData = (powermap_data*)(hPm);
     int band;
 
-    for(band=0; band<HYBRID_BANDS; band++)
+    for(band=0; band<pData->nBands; band++)
         pData->analysisOrderPerBand[band] = MIN(MAX(newValue,1), pData->new_masterOrder);
 }
 
@@ -560,7 +552,7 @@ void powermap_setPowermapEQAllBands(void  * const hPm, float newValue)
     powermap_data *pData = (powermap_data*)(hPm);
     int band;
     
-    for(band=0; band<HYBRID_BANDS; band++)
+    for(band=0; band<pData->nBands; band++)
         pData->pmapEQ[band] = newValue;
 }
 
@@ -618,7 +610,7 @@ int powermap_getFrameSize(void)
 CODEC_STATUS powermap_getCodecStatus(void* const hPm)
 {
     powermap_data *pData = (powermap_data*)(hPm);
-    return pData->codecStatus;
+    return (CODEC_STATUS)saf_atomic_loadInt(&(pData->codecStatus));
 }
 
 float powermap_getProgressBar0_1(void* const hPm)
@@ -680,7 +672,7 @@ void powermap_getPowermapEQHandle
     powermap_data *pData = (powermap_data*)(hPm);
     (*pX_vector) = &(pData->freqVector[0]);
     (*pY_values) = &(pData->pmapEQ[0]);
-    (*pNpoints) = HYBRID_BANDS;
+    (*pNpoints) = pData->nBands;
 }
 
 int powermap_getAnaOrder(void  * const hPm, int bandIdx)
@@ -706,12 +698,18 @@ void powermap_getAnaOrderHandle
     powermap_data *pData = (powermap_data*)(hPm);
     (*pX_vector) = &(pData->freqVector[0]);
     (*pY_values) = &(pData->analysisOrderPerBand[0]);
-    (*pNpoints) = HYBRID_BANDS;
+    (*pNpoints) = pData->nBands;
 }
 
 int powermap_getNumberOfBands(void)
 {
-    return HYBRID_BANDS;
+    return DEFAULT_TF_FRAME_SIZE + 5;
+}
+
+int powermap_getNumberOfBandsEx(void* const hPm)
+{
+    powermap_data *pData = (powermap_data*)(hPm);
+    return pData->nBands;
 }
 
 int powermap_getNSHrequired(void* const hPm)
@@ -759,10 +757,13 @@ float powermap_getPowermapAvgCoeff(void* const hPm)
 int powermap_getPmap(void* const hPm, float** grid_dirs, float** pmap, int* nDirs,int* pmapWidth, int* hfov, int* aspectRatio) //TODO: hfov and aspectRatio should be float, if 16:9 etc options are added
 {
     powermap_data *pData = (powermap_data*)(hPm);
-    powermap_codecPars* pars = pData->pars;
-    if((pData->codecStatus == CODEC_STATUS_INITIALISED) && pData->pmapReady){
+    powermap_codecPars* pars;
+
+    /* only the state the processing loop last drew into is ever displayed */
+    pars = (powermap_codecPars*)saf_atomic_loadPtr(&(pData->dispPars));
+    if(pars != NULL){
         (*grid_dirs) = pars->interp_dirs_deg;
-        (*pmap) = pData->pmap_grid[pData->dispSlotIdx-1 < 0 ? NUM_DISP_SLOTS-1 : pData->dispSlotIdx-1];
+        (*pmap) = pars->pmap_grid[pData->dispSlotIdx-1 < 0 ? NUM_DISP_SLOTS-1 : pData->dispSlotIdx-1];
         (*nDirs) = pars->interp_nDirs;
         (*pmapWidth) = pData->dispWidth;
         switch(pData->HFOVoption){
@@ -778,11 +779,17 @@ int powermap_getPmap(void* const hPm, float** grid_dirs, float** pmap, int* nDir
                 break;
         }
     }
-    return pData->pmapReady;
+    return pars != NULL;
 }
 
 int powermap_getProcessingDelay()
 {
-    return FRAME_SIZE + 12*HOP_SIZE;
+    return FRAME_SIZE + afSTFTgetProcessingDelay(DEFAULT_TF_FRAME_SIZE, 0, 1);
+}
+
+int powermap_getProcessingDelayEx(void* const hPm)
+{
+    powermap_data *pData = (powermap_data*)(hPm);
+    return FRAME_SIZE + afSTFTgetProcessingDelay(pData->hopSize, 0, 1) + saf_blockAdaptor_getDelay(pData->hBlockAdaptor);
 }
 
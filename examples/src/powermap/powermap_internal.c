@@ -34,44 +34,54 @@
 void powermap_setCodecStatus(void* const hPm, CODEC_STATUS newStatus)
 {
     powermap_data *pData = (powermap_data*)(hPm);
-    if(newStatus==CODEC_STATUS_NOT_INITIALISED){
-        /* Pause until current initialisation is complete */
-        while(pData->codecStatus == CODEC_STATUS_INITIALISING)
-            SAF_SLEEP(10);
-    }
-    pData->codecStatus = newStatus;
+    saf_atomic_storeInt(&(pData->codecStatus), (int)newStatus);
 }
 
+void powermap_destroyCodecPars(void** const phPars)
+{
+    powermap_codecPars *pars = (powermap_codecPars*)(*phPars);
+    int i;
+
+    if(pars!=NULL){
+        if(pars->hSTFT!=NULL)
+            afSTFTfree(pars->hSTFT);
+        /* (the engine is destroyed first, as its workers may still read the
+         * grid steering vectors) */
+        saf_pmapEngine_destroy(&(pars->hPmapEngine));
+        for(i=0; i<MAX_SH_ORDER; i++)
+            saf_shGridCache_release(pars->Y_grid_cmplx[i]);
+        free(pars->interp_dirs_deg);
+        free(pars->interp_table);
+        free(pars->pmap);
+        free(pars->prev_pmap);
+        for(i=0; i<NUM_DISP_SLOTS; i++)
+            free(pars->pmap_grid[i]);
+        free(pars);
+        *phPars = NULL;
+    }
+}
 
-void powermap_initAna(void* const hPm)
+void powermap_initAna(void* const hPm, powermap_codecPars* pars)
 {
     powermap_data *pData = (powermap_data*)(hPm);
-    powermap_codecPars* pars = pData->pars;
-    int i, j, n, N_azi, N_ele, nSH_order, order;
-    float scaleY, hfov, vfov, fi, aspectRatio;
-    float* Y_grid_N, *grid_x_axis, *grid_y_axis;
+    int i, j, n, N_azi, N_ele, order;
+    float hfov, vfov, fi, aspectRatio;
+    float *grid_x_axis, *grid_y_axis;
     
-    order = pData->new_masterOrder;
+    order = pars->masterOrder;
     
     /* Store Y_grid per order */
     int geosphere_ico_freq = 9;
     pars->grid_dirs_deg = (float*)__HANDLES_geosphere_ico_dirs_deg[geosphere_ico_freq];
     pars->grid_nDirs = __geosphere_ico_nPoints[geosphere_ico_freq];
-    Y_grid_N = malloc1d(((order+1)*(order+1))*(pars->grid_nDirs)*sizeof(float));
-    getRSH(order, pars->grid_dirs_deg, pars->grid_nDirs, Y_grid_N);
-    for(n=1; n<=order; n++){
-        nSH_order = (n+1)*(n+1);
-        scaleY = 1.0f/(float)nSH_order;
-        free(pars->Y_grid[n-1]);
-        free(pars->Y_grid_cmplx[n-1]);
-        pars->Y_grid[n-1] = malloc1d(nSH_order * (pars->grid_nDirs)*sizeof(float));
-        pars->Y_grid_cmplx[n-1] = malloc1d(nSH_order * (pars->grid_nDirs)*sizeof(float_complex));
-        memcpy(pars->Y_grid[n-1], Y_grid_N, nSH_order * (pars->grid_nDirs)*sizeof(float));
-        utility_svsmul(pars->Y_grid[n-1], &scaleY, nSH_order * (pars->grid_nDirs), NULL);
-        for(i=0; i<nSH_order; i++)
-            for(j=0; j<pars->grid_nDirs; j++)
-                pars->Y_grid_cmplx[n-1][i*(pars->grid_nDirs)+j] = cmplxf(pars->Y_grid[n-1][i*(pars->grid_nDirs)+j], 0.0f);
-    }
+    /* (these are shared with any other instances using the same grid; the
+     * entries of the previous state are only released once it is destroyed,
+     * such that unchanged entries are not freed and recomputed) */
+    for(n=1; n<=MAX_SH_ORDER; n++)
+        pars->Y_grid_cmplx[n-1] = n<=order ? (float_complex*)saf_shGridCache_acquireCmplx(n, pars->grid_dirs_deg, pars->grid_nDirs, 1.0f/(float)ORDER2NSH(n)) : NULL;
+
+    /* powermap engine, for up to the new order and this grid */
+    saf_pmapEngine_create(&(pars->hPmapEngine), order, pars->grid_nDirs, NUM_PMAP_THREADS);
 
     /* generate interpolation table for current display settings */
     switch(pData->HFOVoption){
@@ -91,7 +101,6 @@ void powermap_initAna(void* const hPm)
         grid_x_axis[i] = fi;
     for(fi = -vfov/2.0f,  i = 0; i<N_ele; fi+=vfov/N_ele, i++)
         grid_y_axis[i] = fi;
-    free(pars->interp_dirs_deg);
     pars->interp_dirs_deg = malloc1d(N_azi*N_ele*2*sizeof(float));
     for(i = 0; i<N_ele; i++){
         for(j=0; j<N_azi; j++){
@@ -99,42 +108,31 @@ void powermap_initAna(void* const hPm)
             pars->interp_dirs_deg[(i*N_azi + j)*2+1] = grid_y_axis[i];
         }
     }
-    free(pars->interp_table);
     generateVBAPgainTable3D_srcs(pars->interp_dirs_deg, N_azi*N_ele, pars->grid_dirs_deg, pars->grid_nDirs, 0, 0, 0.0f, &(pars->interp_table), &(pars->interp_nDirs), &(pars->interp_nTri));
     VBAPgainTable2InterpTable(pars->interp_table, pars->interp_nDirs, pars->grid_nDirs);
     
-    /* reallocate memory for storing the powermaps */
-    free(pData->pmap);
-    pData->pmap = malloc1d(pars->grid_nDirs*sizeof(float));
-    free(pData->prev_pmap);
-    pData->prev_pmap = calloc1d(pars->grid_nDirs, sizeof(float));
-    for(i=0; i<NUM_DISP_SLOTS; i++){
-        free(pData->pmap_grid[i]);
-        pData->pmap_grid[i] = calloc1d(pars->interp_nDirs,sizeof(float));
-    }
+    /* allocate memory for storing the powermaps */
+    pars->pmap = malloc1d(pars->grid_nDirs*sizeof(float));
+    pars->prev_pmap = calloc1d(pars->grid_nDirs, sizeof(float));
+    for(i=0; i<NUM_DISP_SLOTS; i++)
+        pars->pmap_grid[i] = calloc1d(pars->interp_nDirs,sizeof(float));
     
-    pData->masterOrder = order;
-    
-    free(Y_grid_N);
     free(grid_x_axis);
     free(grid_y_axis);
 }
 
 void powermap_initTFT
 (
-    void* const hPm
+    void* const hPm,
+    powermap_codecPars* pars
 )
 {
     powermap_data *pData = (powermap_data*)(hPm);
-    int nSH, new_nSH;
+    int nSH;
     
-    nSH = (pData->masterOrder+1)*(pData->masterOrder+1);
-    new_nSH = (pData->new_masterOrder+1)*(pData->new_masterOrder+1);
-    if(pData->hSTFT==NULL)
-        afSTFTinit(&(pData->hSTFT), HOP_SIZE, new_nSH, 0, 0, 1);
-    else if(nSH!=new_nSH){
-        afSTFTchannelChange(pData->hSTFT, new_nSH, 0);
-        afSTFTclearBuffers(pData->hSTFT);
-        memset(pData->Cx, 0 , MAX_NUM_SH_SIGNALS*MAX_NUM_SH_SIGNALS*HYBRID_BANDS*sizeof(float_complex));
-    }
+    /* a new afSTFT is created for every codec state, as the one of the
+     * current state may still be in use by the processing loop */
+    pars->masterOrder = pData->new_masterOrder;
+    nSH = (pars->masterOrder+1)*(pars->masterOrder+1);
+    afSTFTinit(&(pars->hSTFT), pData->hopSize, nSH, 0, 0, 1);
 }
@@ -51,11 +51,9 @@ extern "C" {
 # define FRAME_SIZE ( 1024 ) 
 #endif
 #define MAX_SH_ORDER ( 7 )
-#define HOP_SIZE ( 128 )                   /* STFT hop size = nBands */
-#define HYBRID_BANDS ( HOP_SIZE + 5 )      /* hybrid mode incurs an additional 5 bands  */
-#define TIME_SLOTS ( FRAME_SIZE / HOP_SIZE ) /* Processing relies on fdHop = 16 */
 #define NUM_DISP_SLOTS ( 2 )
 #define MAX_COV_AVG_COEFF ( 0.45f )    /*  */
+#define NUM_PMAP_THREADS ( 2 )          /* number of threads used to generate the powermaps */
 #ifndef M_PI
 # define M_PI ( 3.14159265359f )
 #endif
@@ -66,10 +64,22 @@ extern "C" {
 /* ========================================================================== */
 
 /**
- * Contains variables for scanning grids, and beamforming
+ * Codec state of powermap: the afSTFT, scanning grid, powermap engine, and
+ * display interpolation table for one configuration
+ *
+ * A new state is built by powermap_initCodec() and handed over to the
+ * processing loop via a saf_stateSwap (see saf_stateSwap_create()). Once
+ * published, it is no longer modified; except for the afSTFT, powermap engine
+ * and powermap buffers, which only the processing loop uses (the display slots
+ * are also read by powermap_getPmap()).
  */
 typedef struct _powermap_codecPars
 {
+    /* afSTFT */
+    int masterOrder;      /* analysis order the state is built for */
+    void* hSTFT;          /* afSTFT handle */
+
+    /* scanning grid and display interpolation table */
     float* grid_dirs_deg; /* grid_nDirs x 2 */
     int grid_nDirs;
     float* interp_dirs_deg;
@@ -77,8 +87,13 @@ typedef struct _powermap_codecPars
     int interp_nDirs;
     int interp_nTri;
     
-    float* Y_grid[MAX_SH_ORDER];                 /* MAX_NUM_SH_SIGNALS x grid_nDirs */
-    float_complex* Y_grid_cmplx[MAX_SH_ORDER];   /* MAX_NUM_SH_SIGNALS x grid_nDirs */
+    float_complex* Y_grid_cmplx[MAX_SH_ORDER];   /* (shared, read-only; see saf_shGridCache_acquireCmplx()) (n+1)^2 x grid_nDirs */
+
+    /* powermap engine and buffers */
+    void* hPmapEngine;                     /* powermap engine, for up to masterOrder and this grid (see saf_pmapEngine_create()) */
+    float* pmap;                           /* grid_nDirs x 1 */
+    float* prev_pmap;                      /* grid_nDirs x 1 */
+    float* pmap_grid[NUM_DISP_SLOTS];      /* powermap interpolated to grid; interp_nDirs x 1 */
     
 }powermap_codecPars;
     
@@ -88,45 +103,43 @@ typedef struct _powermap_codecPars
  */
 typedef struct _powermap
 {
-    /* FIFO buffers */
-    int FIFO_idx;
-    float inFIFO[MAX_NUM_SH_SIGNALS][FRAME_SIZE]; 
+    /* block-size adaptor */
+    void* hBlockAdaptor;
 
     /* TFT */
-    float SHframeTD[MAX_NUM_SH_SIGNALS][FRAME_SIZE];
-    float_complex SHframeTF[HYBRID_BANDS][MAX_NUM_SH_SIGNALS][TIME_SLOTS];        
-    void* hSTFT;
-    complexVector* STFTInputFrameTF;
-    float** tempHopFrameTD;
-    float freqVector[HYBRID_BANDS];
+    int hopSize;                    /**< STFT hop size (specified at creation) */
+    int nBands;                     /**< Number of bands; hopSize+5 (hybrid mode) */
+    int timeSlots;                  /**< Number of time slots; FRAME_SIZE/hopSize */
+    float** SHframeTD;              /**< MAX_NUM_SH_SIGNALS x FRAME_SIZE */
+    float_complex*** SHframeTF;     /**< nBands x MAX_NUM_SH_SIGNALS x timeSlots */
+    float* freqVector;              /**< nBands x 1 */
     float fs;
     
     /* internal */
-    float_complex Cx[HYBRID_BANDS][MAX_NUM_SH_SIGNALS][MAX_NUM_SH_SIGNALS];     /* cov matrices */
+    float_complex*** Cx;            /* cov matrices; nBands x MAX_NUM_SH_SIGNALS x MAX_NUM_SH_SIGNALS */
+    float_complex C_grp[MAX_NUM_SH_SIGNALS*MAX_NUM_SH_SIGNALS];                 /* grouped cov matrix */
     int new_masterOrder;
     int dispWidth;
     
     /* ana configuration */
-    CODEC_STATUS codecStatus;
-    PROC_STATUS procStatus;
+    volatile int codecStatus;              /* see #_CODEC_STATUS enum */
     float progressBar0_1;
     char* progressBarText;
-    powermap_codecPars* pars;                                          /* codec parameters */
+    void* hCodecState;                     /* saf_stateSwap handing powermap_codecPars to the processing loop */
+    powermap_codecPars* procPars;          /* codec state last used by the processing loop (only accessed by it) */
     
     /* display */
-    float* pmap;                           /* grid_nDirs x 1 */
-    float* prev_pmap;                      /* grid_nDirs x 1 */
-    float* pmap_grid[NUM_DISP_SLOTS];      /* powermap interpolated to grid; interp_nDirs x 1 */
     int dispSlotIdx;
     float pmap_grid_minVal;
     float pmap_grid_maxVal;
     int recalcPmap;   /* set this to 1 to generate a new powermap */
-    int pmapReady;    /* 0: powermap not started yet, 1: powermap is ready for plotting*/
+    void* volatile dispPars; /* codec state holding the latest powermap, NULL until one is ready for plotting (set by the processing loop) */
+    int resetPmapAvg; /* set this to 1 to reset the averaging of the powermap over time */
     
     /* User parameters */
     int masterOrder;
-    int analysisOrderPerBand[HYBRID_BANDS];
-    float pmapEQ[HYBRID_BANDS]; 
+    int* analysisOrderPerBand;      /* nBands x 1 */
+    float* pmapEQ;                  /* nBands x 1 */
     HFOV_OPTIONS HFOVoption;
     ASPECT_RATIO_OPTIONS aspectRatioOption;
     float covAvgCoeff;
@@ -145,20 +158,34 @@ typedef struct _powermap
 
 /**
  * Sets codec status (see #_CODEC_STATUS enum)
+ *
+ * This never waits: if the codec is being initialised, then setting
+ * #CODEC_STATUS_NOT_INITIALISED causes powermap_initCodec() to leave the status
+ * as such, so that the next call re-initialises the codec again.
  */
 void powermap_setCodecStatus(void* const hPm, CODEC_STATUS newStatus);
 
 /**
- * Intialises the codec variables, based on current global/user parameters
+ * Destroys a codec state (see saf_stateSwap_destroyFn)
+ *
+ * @param[in] phPars (&) address of the powermap_codecPars
+ */
+void powermap_destroyCodecPars(void** const phPars);
+
+/**
+ * Intialises the codec variables of a new codec state, based on current
+ * global/user parameters
  */
-void powermap_initAna(void* const hPm);
+void powermap_initAna(void* const hPm,
+                      powermap_codecPars* pars);
 
 /**
- * Initialise the filterbank used by powermap.
+ * Initialise the filterbank of a new codec state, for the current order.
  *
  * @note Call this function before powermap_initAna()
  */
-void powermap_initTFT(void* const hPm);
+void powermap_initTFT(void* const hPm,
+                      powermap_codecPars* pars);
 
 
 #ifdef __cplusplus
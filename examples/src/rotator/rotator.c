@@ -51,7 +51,11 @@ void rotator_create
     pData->chOrdering = CH_ACN;
     pData->norm = NORM_SN3D;
     pData->useRollPitchYawFlag = 0;
+    rotator_updateTargetFromEuler(*phRot);
     rotator_setOrder(*phRot, SH_ORDER_FIRST);
+
+    /* block-size adaptor */
+    saf_blockAdaptor_create(&(pData->hBlockAdaptor), FRAME_SIZE, MAX_NUM_SH_SIGNALS, MAX_NUM_SH_SIGNALS);
 }
 
 void rotator_destroy
@@ -62,6 +66,7 @@ void rotator_destroy
     rotator_data *pData = (rotator_data*)(*phRot);
 
     if (pData != NULL) {
+        saf_blockAdaptor_destroy(&(pData->hBlockAdaptor));
         free(pData);
         pData = NULL;
     }
@@ -75,30 +80,33 @@ void rotator_init
 {
     rotator_data *pData = (rotator_data*)(hRot);
     int i;
+    float R_identity[3][3] = { {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f} };
     
-    /* starting values */
-    for(i=1; i<=FRAME_SIZE; i++)
-        pData->interpolator[i-1] = (float)i*1.0f/(float)FRAME_SIZE;
-    memset(pData->M_rot, 0, MAX_NUM_SH_SIGNALS*MAX_NUM_SH_SIGNALS*sizeof(float));
-    memset(pData->prev_M_rot, 0, MAX_NUM_SH_SIGNALS*MAX_NUM_SH_SIGNALS*sizeof(float));
+    /* starting values (rotating from the identity to the target orientation) */
+    for(i=1; i<=ROTATOR_SUBBLOCK_SIZE; i++)
+        pData->interpolator[i-1] = (float)i*1.0f/(float)ROTATOR_SUBBLOCK_SIZE;
+    pData->prev_Q[0] = 1.0f;
+    pData->prev_Q[1] = pData->prev_Q[2] = pData->prev_Q[3] = 0.0f;
+    pData->prev_order = MAX_SH_ORDER;
+    getSHrotMtxRealBlocks(R_identity, pData->prev_M_rot, MAX_SH_ORDER);
     memset(pData->prev_inputFrameTD, 0, MAX_NUM_SH_SIGNALS*FRAME_SIZE*sizeof(float));
     pData->recalc_M_rotFLAG = 1;
+    saf_blockAdaptor_reset(pData->hBlockAdaptor);
 }
 
-void rotator_process
+/** Processes one frame of FRAME_SIZE samples (see saf_blockAdaptor_apply()) */
+static void rotator_processFrame
 (
     void  *  const hRot,
     float ** const inputs,
     float ** const outputs,
     int            nInputs,
-    int            nOutputs,
-    int            nSamples
+    int            nOutputs
 )
 {
     rotator_data *pData = (rotator_data*)(hRot);
-    int i, j, order, nSH; 
-    float Rxyz[3][3];
-    float* M_rot_tmp;
+    int i, j, order, nSH, sb, nSubBlocks, offset;
+    float Q_target[4], Q_sb[4], R_target[3][3], R_sb[3][3];
     CH_ORDER chOrdering;
     NORM_TYPES norm;
 
@@ -108,130 +116,188 @@ void rotator_process
     order = (int)pData->inputOrder;
     nSH = ORDER2NSH(order);
 
-    if (nSamples == FRAME_SIZE) {
-
-        /* Load time-domain data */
-        for(i=0; i < MIN(nSH, nInputs); i++)
-            utility_svvcopy(inputs[i], FRAME_SIZE, pData->inputFrameTD[i]);
-        for(; i<nSH; i++)
-            memset(pData->inputFrameTD[i], 0, FRAME_SIZE * sizeof(float)); /* fill remaining channels with zeros */
-
-        /* account for channel order */
-        switch(chOrdering){
-            case CH_ACN: /* already ACN */
-                break;
-            case CH_FUMA:
-                convertHOAChannelConvention((float*)pData->inputFrameTD, order, FRAME_SIZE, HOA_CH_ORDER_FUMA, HOA_CH_ORDER_ACN);
-                break;
-        }
+    /* Load time-domain data */
+    for(i=0; i < MIN(nSH, nInputs); i++)
+        utility_svvcopy(inputs[i], FRAME_SIZE, pData->inputFrameTD[i]);
+    for(; i<nSH; i++)
+        memset(pData->inputFrameTD[i], 0, FRAME_SIZE * sizeof(float)); /* fill remaining channels with zeros */
+
+    /* account for channel order */
+    switch(chOrdering){
+        case CH_ACN: /* already ACN */
+            break;
+        case CH_FUMA:
+            convertHOAChannelConvention((float*)pData->inputFrameTD, order, FRAME_SIZE, HOA_CH_ORDER_FUMA, HOA_CH_ORDER_ACN);
+            break;
+    }
 
 #if 0
-        /* account for input normalisation scheme */
-
-        /* actually doesn't matter, since only components of the same order are
-        * used to rotate a given order of component; i.e, dipoles are used to
-        * rotate dipoles, quadrapoles-qaudrapoles etc.. so this scaling doesn't
-        * affect anything here */
-        switch(norm){
-            case NORM_N3D:  /* already in N3D, do nothing */
-                break;
-            case NORM_SN3D: /* convert to N3D */
-                convertHOANormConvention((float*)pData->inputFrameTD, order, FRAME_SIZE, HOA_NORM_SN3D, HOA_NORM_N3D);
-                break;
-            case NORM_FUMA: /* only for first-order, convert to N3D */
-                convertHOANormConvention((float*)pData->inputFrameTD, order, FRAME_SIZE, HOA_NORM_FUMA, HOA_NORM_N3D);
-                break;
-        }
+    /* account for input normalisation scheme */
+
+    /* actually doesn't matter, since only components of the same order are
+    * used to rotate a given order of component; i.e, dipoles are used to
+    * rotate dipoles, quadrapoles-qaudrapoles etc.. so this scaling doesn't
+    * affect anything here */
+    switch(norm){
+        case NORM_N3D:  /* already in N3D, do nothing */
+            break;
+        case NORM_SN3D: /* convert to N3D */
+            convertHOANormConvention((float*)pData->inputFrameTD, order, FRAME_SIZE, HOA_NORM_SN3D, HOA_NORM_N3D);
+            break;
+        case NORM_FUMA: /* only for first-order, convert to N3D */
+            convertHOANormConvention((float*)pData->inputFrameTD, order, FRAME_SIZE, HOA_NORM_FUMA, HOA_NORM_N3D);
+            break;
+    }
 #endif
 
-        if (order>0){
-            /* calculate rotation matrix */
-            if(pData->recalc_M_rotFLAG){
-                memset(pData->M_rot, 0, MAX_NUM_SH_SIGNALS*MAX_NUM_SH_SIGNALS*sizeof(float));
-                M_rot_tmp = malloc1d(nSH*nSH*sizeof(float));
-                yawPitchRoll2Rzyx (pData->yaw, pData->pitch, pData->roll, pData->useRollPitchYawFlag, Rxyz);
-                getSHrotMtxReal(Rxyz, M_rot_tmp, order);
-                for(i=0; i<nSH; i++)
-                    for(j=0; j<nSH; j++)
-                        pData->M_rot[i][j] = M_rot_tmp[i*nSH+j];
-                free(M_rot_tmp);
-                pData->recalc_M_rotFLAG = 0;
-            }
-            else
-                utility_svvcopy((const float*)pData->prev_M_rot, MAX_NUM_SH_SIGNALS*MAX_NUM_SH_SIGNALS, (float*)pData->M_rot);
-
-            /* apply rotation */
-            cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nSH, FRAME_SIZE, nSH, 1.0f,
-                        (float*)(pData->prev_M_rot), MAX_NUM_SH_SIGNALS,
-                        (float*)pData->prev_inputFrameTD, FRAME_SIZE, 0.0f,
-                        (float*)pData->tempFrame, FRAME_SIZE);
-            cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nSH, FRAME_SIZE, nSH, 1.0f,
-                        (float*)(pData->M_rot), MAX_NUM_SH_SIGNALS,
-                        (float*)pData->prev_inputFrameTD, FRAME_SIZE, 0.0f,
-                        (float*)pData->outputFrameTD, FRAME_SIZE);
-            for (i=0; i < nSH; i++)
-                for(j=0; j<FRAME_SIZE; j++)
-                    pData->outputFrameTD[i][j] = pData->interpolator[j] * pData->outputFrameTD[i][j] + (1.0f-pData->interpolator[j]) * pData->tempFrame[i][j];
-
-            /* for next frame */
-            utility_svvcopy((const float*)pData->inputFrameTD, nSH*FRAME_SIZE, (float*)pData->prev_inputFrameTD);
-            utility_svvcopy((const float*)pData->M_rot, MAX_NUM_SH_SIGNALS*MAX_NUM_SH_SIGNALS, (float*)pData->prev_M_rot);
-        }
-        else
-            utility_svvcopy((const float*)pData->inputFrameTD[0], FRAME_SIZE, (float*)pData->outputFrameTD[0]);
-
-        /* account for norm scheme */
-        switch(norm){
-            case NORM_N3D:
-                /* again, actually doesn't matter */
-                break;
-            case NORM_SN3D:
-                /* again, actually doesn't matter */
-                break;
-            case NORM_FUMA:
-                /* again, actually doesn't matter */
-                break;
+    if (order>0){
+        /* The blocks of the lower bands do not depend on the order, but those of
+         * any additional bands must be computed for the current orientation */
+        if(order > pData->prev_order){
+            quaternion2rotationMatrix(pData->prev_Q, R_sb);
+            getSHrotMtxRealBlocks(R_sb, pData->prev_M_rot, order);
+            pData->prev_order = order;
         }
 
-        /* account for channel order */
-        switch(chOrdering){
-            case CH_ACN: /* already ACN */
-                break;
-            case CH_FUMA:
-                convertHOAChannelConvention((float*)pData->outputFrameTD, order, FRAME_SIZE, HOA_CH_ORDER_ACN, HOA_CH_ORDER_FUMA);
-                break;
+        if(pData->recalc_M_rotFLAG){
+            pData->recalc_M_rotFLAG = 0;
+            memcpy(Q_target, pData->Q, 4*sizeof(float));
+            memcpy(R_target, pData->R, 9*sizeof(float));
+
+            /* Move to the new orientation sub-block by sub-block (slerp), with
+             * a per-sample crossfade between the rotations of consecutive
+             * sub-blocks. Only the diagonal blocks are computed and applied. */
+            nSubBlocks = FRAME_SIZE/ROTATOR_SUBBLOCK_SIZE;
+            for(sb=0; sb<nSubBlocks; sb++){
+                offset = sb*ROTATOR_SUBBLOCK_SIZE;
+                if(sb<nSubBlocks-1){
+                    quaternionSlerp(pData->prev_Q, Q_target, (float)(sb+1)/(float)nSubBlocks, Q_sb);
+                    quaternion2rotationMatrix(Q_sb, R_sb);
+                    getSHrotMtxRealBlocks(R_sb, pData->M_rot, order);
+                }
+                else
+                    getSHrotMtxRealBlocks(R_target, pData->M_rot, order); /* land exactly on the target */
+                applySHblockMtx(pData->prev_M_rot, order, &pData->prev_inputFrameTD[0][offset], FRAME_SIZE,
+                                ROTATOR_SUBBLOCK_SIZE, &pData->tempFrame[0][offset], FRAME_SIZE);
+                applySHblockMtx(pData->M_rot, order, &pData->prev_inputFrameTD[0][offset], FRAME_SIZE,
+                                ROTATOR_SUBBLOCK_SIZE, &pData->outputFrameTD[0][offset], FRAME_SIZE);
+                for (i=0; i < nSH; i++)
+                    for(j=0; j<ROTATOR_SUBBLOCK_SIZE; j++)
+                        pData->outputFrameTD[i][offset+j] = pData->interpolator[j] * pData->outputFrameTD[i][offset+j] +
+                                                            (1.0f-pData->interpolator[j]) * pData->tempFrame[i][offset+j];
+                memcpy(pData->prev_M_rot, pData->M_rot, ORDER2NSHROT(order)*sizeof(float));
+            }
+            memcpy(pData->prev_Q, Q_target, 4*sizeof(float));
+            pData->prev_order = order;
         }
+        else /* apply rotation */
+            applySHblockMtx(pData->prev_M_rot, order, (float*)pData->prev_inputFrameTD, FRAME_SIZE,
+                            FRAME_SIZE, (float*)pData->outputFrameTD, FRAME_SIZE);
 
-        /* Copy to output */
-        for (i = 0; i < MIN(nSH, nOutputs); i++)
-            utility_svvcopy(pData->outputFrameTD[i], FRAME_SIZE, outputs[i]);
-        for (; i < nOutputs; i++)
-            memset(outputs[i], 0, FRAME_SIZE*sizeof(float)); 
+        /* for next frame */
+        utility_svvcopy((const float*)pData->inputFrameTD, nSH*FRAME_SIZE, (float*)pData->prev_inputFrameTD);
+    }
+    else
+        utility_svvcopy((const float*)pData->inputFrameTD[0], FRAME_SIZE, (float*)pData->outputFrameTD[0]);
+
+    /* account for norm scheme */
+    switch(norm){
+        case NORM_N3D:
+            /* again, actually doesn't matter */
+            break;
+        case NORM_SN3D:
+            /* again, actually doesn't matter */
+            break;
+        case NORM_FUMA:
+            /* again, actually doesn't matter */
+            break;
     }
-    else{
-        for (i = 0; i < nOutputs; i++)
-            memset(outputs[i], 0, FRAME_SIZE*sizeof(float));
+
+    /* account for channel order */
+    switch(chOrdering){
+        case CH_ACN: /* already ACN */
+            break;
+        case CH_FUMA:
+            convertHOAChannelConvention((float*)pData->outputFrameTD, order, FRAME_SIZE, HOA_CH_ORDER_ACN, HOA_CH_ORDER_FUMA);
+            break;
     }
+
+    /* Copy to output */
+    for (i = 0; i < MIN(nSH, nOutputs); i++)
+        utility_svvcopy(pData->outputFrameTD[i], FRAME_SIZE, outputs[i]);
+    for (; i < nOutputs; i++)
+        memset(outputs[i], 0, FRAME_SIZE*sizeof(float)); 
+}
+
+void rotator_process
+(
+    void  *  const hRot,
+    float ** const inputs,
+    float ** const outputs,
+    int            nInputs,
+    int            nOutputs,
+    int            nSamples
+)
+{
+    rotator_data *pData = (rotator_data*)(hRot);
+
+    saf_blockAdaptor_apply(pData->hBlockAdaptor, inputs, outputs, nInputs, nOutputs,
+                           nSamples, rotator_processFrame, hRot);
+}
+
+void rotator_processInterleaved
+(
+    void  *  const hRot,
+    const float *  inputs,
+    float *        outputs,
+    int            nInputs,
+    int            nOutputs,
+    int            nSamples
+)
+{
+    rotator_data *pData = (rotator_data*)(hRot);
+
+    saf_blockAdaptor_applyStrided(pData->hBlockAdaptor, inputs, 1, nInputs, outputs, 1, nOutputs,
+                                  nInputs, nOutputs, nSamples, rotator_processFrame, hRot);
 }
 
 void rotator_setYaw(void  * const hRot, float newYaw)
 {
     rotator_data *pData = (rotator_data*)(hRot);
     pData->yaw = pData->bFlipYaw == 1 ? -DEG2RAD(newYaw) : DEG2RAD(newYaw);
-    pData->recalc_M_rotFLAG = 1;
+    rotator_updateTargetFromEuler(hRot);
 }
 
 void rotator_setPitch(void* const hRot, float newPitch)
 {
     rotator_data *pData = (rotator_data*)(hRot);
     pData->pitch = pData->bFlipPitch == 1 ? -DEG2RAD(newPitch) : DEG2RAD(newPitch);
-    pData->recalc_M_rotFLAG = 1;
+    rotator_updateTargetFromEuler(hRot);
 }
 
 void rotator_setRoll(void* const hRot, float newRoll)
 {
     rotator_data *pData = (rotator_data*)(hRot);
     pData->roll = pData->bFlipRoll == 1 ? -DEG2RAD(newRoll) : DEG2RAD(newRoll);
+    rotator_updateTargetFromEuler(hRot);
+}
+
+void rotator_setQuaternion(void* const hRot, float Q[4])
+{
+    rotator_data *pData = (rotator_data*)(hRot);
+    float R[3][3];
+    int i;
+    float norm;
+
+    norm = sqrtf(Q[0]*Q[0] + Q[1]*Q[1] + Q[2]*Q[2] + Q[3]*Q[3]);
+    if(norm<1e-6f)
+        return; /* not a rotation */
+    quaternion2rotationMatrix(Q, R);
+    memcpy(pData->R, R, 9*sizeof(float));
+    for(i=0; i<4; i++)
+        pData->Q[i] = Q[i]/norm;
+    /* keep the angles (as returned by the get functions) in sync */
+    rotationMatrix2yawPitchRoll(R, pData->useRollPitchYawFlag, &(pData->yaw), &(pData->pitch), &(pData->roll));
     pData->recalc_M_rotFLAG = 1;
 }
 
@@ -266,6 +332,7 @@ void rotator_setRPYflag(void* const hRot, int newState)
 {
     rotator_data *pData = (rotator_data*)(hRot);
     pData->useRollPitchYawFlag = newState;
+    rotator_updateTargetFromEuler(hRot);
 }
 
 void rotator_setChOrder(void* const hRot, int newOrder)
@@ -320,6 +387,12 @@ float rotator_getRoll(void* const hRot)
     return pData->bFlipRoll == 1 ? -RAD2DEG(pData->roll) : RAD2DEG(pData->roll);
 }
 
+void rotator_getQuaternion(void* const hRot, float Q[4])
+{
+    rotator_data *pData = (rotator_data*)(hRot);
+    memcpy(Q, pData->Q, 4*sizeof(float));
+}
+
 int rotator_getFlipYaw(void* const hRot)
 {
     rotator_data *pData = (rotator_data*)(hRot);
@@ -31,4 +31,14 @@
 #include "rotator.h"
 #include "rotator_internal.h"
 
+void rotator_updateTargetFromEuler
+(
+    void* const hRot
+)
+{
+    rotator_data *pData = (rotator_data*)(hRot);
 
+    yawPitchRoll2Rzyx(pData->yaw, pData->pitch, pData->roll, pData->useRollPitchYawFlag, pData->R);
+    rotationMatrix2quaternion(pData->R, pData->Q);
+    pData->recalc_M_rotFLAG = 1;
+}
@@ -48,6 +48,14 @@ extern "C" {
 #ifndef FRAME_SIZE
 # define FRAME_SIZE ( 64 ) 
 #endif
+#ifndef ROTATOR_SUBBLOCK_SIZE
+# define ROTATOR_SUBBLOCK_SIZE ( 16 ) /* orientation changes are interpolated in sub-blocks of this size */
+#endif
+#if (FRAME_SIZE % ROTATOR_SUBBLOCK_SIZE != 0)
+# error "FRAME_SIZE must be a multiple of ROTATOR_SUBBLOCK_SIZE"
+#endif
+/** Number of elements in the block-diagonal rotation matrix, for MAX_SH_ORDER */
+#define MAX_NUM_SHROT_ELEMENTS ( ORDER2NSHROT(MAX_SH_ORDER) )
 #ifndef DEG2RAD
 # define DEG2RAD(x) (x * SAF_PI / 180.0f)
 #endif
@@ -70,13 +78,18 @@ typedef struct _rotator
     float prev_inputFrameTD[MAX_NUM_SH_SIGNALS][FRAME_SIZE];
     float tempFrame[MAX_NUM_SH_SIGNALS][FRAME_SIZE];
     float outputFrameTD[MAX_NUM_SH_SIGNALS][FRAME_SIZE];
-    float interpolator[FRAME_SIZE];
-    float M_rot[MAX_NUM_SH_SIGNALS][MAX_NUM_SH_SIGNALS];
-    float prev_M_rot[MAX_NUM_SH_SIGNALS][MAX_NUM_SH_SIGNALS];
+    float interpolator[ROTATOR_SUBBLOCK_SIZE];
+    float M_rot[MAX_NUM_SHROT_ELEMENTS];      /**< diagonal blocks of the rotation matrix for the current sub-block */
+    float prev_M_rot[MAX_NUM_SHROT_ELEMENTS]; /**< diagonal blocks of the rotation matrix currently in effect */
+    float prev_Q[4];                          /**< orientation currently in effect, as a quaternion [w x y z] */
+    int prev_order;                           /**< order of 'prev_M_rot' */
     int recalc_M_rotFLAG;
+    void* hBlockAdaptor;
 
     /* user parameters */
-    float yaw, roll, pitch;              /**< rotation angles in degrees */
+    float yaw, roll, pitch;              /**< rotation angles in radians */
+    float Q[4];                          /**< target orientation as a quaternion [w x y z] */
+    float R[3][3];                       /**< target orientation as a rotation matrix */
     int bFlipYaw, bFlipPitch, bFlipRoll; /**< flag to flip the sign of the individual rotation angles */
     CH_ORDER chOrdering;                 /**< only ACN is supported */
     NORM_TYPES norm;                     /**< N3D or SN3D */
@@ -84,6 +97,17 @@ typedef struct _rotator
     int useRollPitchYawFlag;             /**< rotation order flag, 1: r-p-y, 0: y-p-r */
     
 } rotator_data;
+
+
+/* ========================================================================== */
+/*                             Internal Functions                             */
+/* ========================================================================== */
+
+/**
+ * Updates the target orientation (quaternion and rotation matrix) from the
+ * current yaw, pitch and roll angles
+ */
+void rotator_updateTargetFromEuler(void* const hRot);
     
     
 #ifdef __cplusplus
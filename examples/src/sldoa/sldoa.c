@@ -50,14 +50,30 @@ void sldoa_create
 (
     void ** const phSld
 )
+{
+    sldoa_createWithHopSize(phSld, DEFAULT_TF_FRAME_SIZE);
+}
+
+void sldoa_createWithHopSize
+(
+    void ** const phSld,
+    int hopSize
+)
 {
     sldoa_data* pData = (sldoa_data*)malloc1d(sizeof(sldoa_data));
     *phSld = (void*)pData;
-    int i, j, ch, band;
+    int i, j, band;
+
+    /* TFT dimensions (fixed for the lifetime of the instance) */
+    pData->hopSize = IS_VALID_TF_FRAME_SIZE(hopSize) && hopSize<=FRAME_SIZE ? hopSize : DEFAULT_TF_FRAME_SIZE;
+    pData->nBands = pData->hopSize + 5;
+    pData->timeSlots = FRAME_SIZE / pData->hopSize;
 
     /* Default user parameters */
     pData->new_masterOrder = pData->masterOrder = 1;
-    for(band=0; band<HYBRID_BANDS; band++){
+    pData->analysisOrderPerBand = malloc1d(pData->nBands*sizeof(int));
+    pData->nSectorsPerBand = malloc1d(pData->nBands*sizeof(int));
+    for(band=0; band<pData->nBands; band++){
         pData->analysisOrderPerBand[band] = pData->masterOrder;
         pData->nSectorsPerBand[band] = ORDER2NUMSECTORS(pData->analysisOrderPerBand[band]);
     }
@@ -68,43 +84,35 @@ void sldoa_create
     pData->norm = NORM_SN3D;
 
     /* TFT */
-    afSTFTinit(&(pData->hSTFT), HOP_SIZE, MAX_NUM_SH_SIGNALS, 0, 0, 1);
-    pData->STFTInputFrameTF = malloc1d(MAX_NUM_SH_SIGNALS*sizeof(complexVector));
-    for(ch=0; ch< MAX_NUM_SH_SIGNALS; ch++) {
-        pData->STFTInputFrameTF[ch].re = (float*)calloc1d(HYBRID_BANDS, sizeof(float));
-        pData->STFTInputFrameTF[ch].im = (float*)calloc1d(HYBRID_BANDS, sizeof(float));
-    }
-    pData->tempHopFrameTD = (float**)malloc2d(MAX_NUM_SH_SIGNALS, HOP_SIZE, sizeof(float));
+    pData->SHframeTD = (float**)malloc2d(MAX_NUM_SH_SIGNALS, FRAME_SIZE, sizeof(float));
+    pData->SHframeTF = (float_complex***)malloc3d(pData->nBands, MAX_NUM_SH_SIGNALS, pData->timeSlots, sizeof(float_complex));
+    pData->freqVector = calloc1d(pData->nBands, sizeof(float));
     
     /* internal */
     pData->progressBar0_1 = 0.0f;
     pData->progressBarText = malloc1d(PROGRESSBARTEXT_CHAR_LENGTH*sizeof(char));
     strcpy(pData->progressBarText,"");
     pData->codecStatus = CODEC_STATUS_NOT_INITIALISED;
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
-    for(i=0; i<MAX_SH_ORDER-1; i++)
-        pData->secCoeffs[i] = NULL;
-    for(i=0; i<64; i++)
-        for(j=0; j<NUM_GRID_DIRS; j++)
-            pData->grid_Y[i][j] = (float)__grid_Y[i][j] * sqrtf(4.0*M_PI);
-    for(i=0; i<3; i++)
-        for(j=0; j<NUM_GRID_DIRS; j++)
-            pData->grid_Y_dipoles_norm[i][j] = pData->grid_Y[i+1][j]/sqrtf(3); /* scale to [0..1] */
+
+    /* codec states (afSTFT, grid spherical harmonics and sector coefficients),
+     * which are built by _initCodec() */
+    saf_stateSwap_create(&(pData->hCodecState), sldoa_destroyCodecPars);
     for(i=0; i<NUM_GRID_DIRS; i++)
         for(j=0; j<2; j++)
             pData->grid_dirs_deg[i][j] = (float)__grid_dirs_deg[i][j];
+    pData->doa_rad = (float***)calloc3d(pData->nBands, MAX_NUM_SECTORS, 2, sizeof(float));
+    pData->energy = (float**)calloc2d(pData->nBands, MAX_NUM_SECTORS, sizeof(float));
     
     /* display */
     for(i=0; i<NUM_DISP_SLOTS; i++){
-        pData->azi_deg[i] = malloc1d(HYBRID_BANDS*MAX_NUM_SECTORS * sizeof(float));
-        pData->elev_deg[i] = malloc1d(HYBRID_BANDS*MAX_NUM_SECTORS * sizeof(float));
-        pData->colourScale[i] = malloc1d(HYBRID_BANDS*MAX_NUM_SECTORS * sizeof(float));
-        pData->alphaScale[i] = malloc1d(HYBRID_BANDS*MAX_NUM_SECTORS * sizeof(float));
+        pData->azi_deg[i] = calloc1d(pData->nBands*MAX_NUM_SECTORS, sizeof(float));
+        pData->elev_deg[i] = calloc1d(pData->nBands*MAX_NUM_SECTORS, sizeof(float));
+        pData->colourScale[i] = calloc1d(pData->nBands*MAX_NUM_SECTORS, sizeof(float));
+        pData->alphaScale[i] = calloc1d(pData->nBands*MAX_NUM_SECTORS, sizeof(float));
     }
 
-    /* set FIFO buffer */
-    pData->FIFO_idx = 0;
-    memset(pData->inFIFO, 0, MAX_NUM_SH_SIGNALS*FRAME_SIZE*sizeof(float));
+    /* block-size adaptor */
+    saf_blockAdaptor_create(&(pData->hBlockAdaptor), FRAME_SIZE, MAX_NUM_SH_SIGNALS, 0);
 }
 
 void sldoa_destroy
@@ -113,23 +121,23 @@ void sldoa_destroy
 )
 {
     sldoa_data *pData = (sldoa_data*)(*phSld);
-    int i, ch;
+    int i;
 
     if (pData != NULL) {
-        /* not safe to free memory during intialisation/processing loop */
-        while (pData->codecStatus == CODEC_STATUS_INITIALISING ||
-               pData->procStatus == PROC_STATUS_ONGOING){
+        /* not safe to free the codec states during intialisation (the
+         * processing loop must have already stopped) */
+        while (saf_atomic_loadInt(&(pData->codecStatus)) == CODEC_STATUS_INITIALISING)
             SAF_SLEEP(10);
-        }
+        saf_stateSwap_destroy(&(pData->hCodecState));
         
-        /* free afSTFT and buffers */
-        afSTFTfree(pData->hSTFT);
-        for (ch = 0; ch< MAX_NUM_SH_SIGNALS; ch++) {
-            free(pData->STFTInputFrameTF[ch].re);
-            free(pData->STFTInputFrameTF[ch].im);
-        }
-        free(pData->STFTInputFrameTF);
-        free(pData->tempHopFrameTD);
+        /* free buffers */
+        free(pData->SHframeTD);
+        free(pData->SHframeTF);
+        free(pData->freqVector);
+        free(pData->doa_rad);
+        free(pData->energy);
+        free(pData->nSectorsPerBand);
+        free(pData->analysisOrderPerBand);
         for(i=0; i<NUM_DISP_SLOTS; i++){
             free(pData->azi_deg[i]);
             free(pData->elev_deg[i]);
@@ -137,6 +145,7 @@ void sldoa_destroy
             free(pData->alphaScale[i]);
         }
         free(pData->progressBarText);
+        saf_blockAdaptor_destroy(&(pData->hBlockAdaptor));
         free(pData);
         pData = NULL;
     }
@@ -149,33 +158,24 @@ void sldoa_init
 )
 {
     sldoa_data *pData = (sldoa_data*)(hSld);
-    int i, band;
+    int i;
     
     pData->fs = sampleRate;
     
-    /* specify frequency vector and determine the number of bands */
-    switch ((int)(sampleRate+0.5f)){
-        case 44100:
-            for(band=0; band<HYBRID_BANDS; band++)
-                pData->freqVector[band] = (float)__afCenterFreq44100[band];
-            break;
-        default:
-        case 48000:
-            for(band=0; band<HYBRID_BANDS; band++)
-                pData->freqVector[band] = (float)__afCenterFreq48e3[band];
-            break;
-    }
+    /* specify frequency vector */
+    afSTFTgetCenterFreqs(pData->hopSize, 1, sampleRate, pData->freqVector);
     
     /* intialise display parameters */
     pData->current_disp_idx = 0;
-    memset(pData->doa_rad, 0, HYBRID_BANDS*MAX_NUM_SECTORS*2* sizeof(float));
-    memset(pData->energy, 0, HYBRID_BANDS*MAX_NUM_SECTORS* sizeof(float));
+    memset(FLATTEN3D(pData->doa_rad), 0, pData->nBands*MAX_NUM_SECTORS*2* sizeof(float));
+    memset(FLATTEN2D(pData->energy), 0, pData->nBands*MAX_NUM_SECTORS* sizeof(float));
     for(i=0; i<NUM_DISP_SLOTS; i++){
-        memset(pData->azi_deg[i], 0, HYBRID_BANDS*MAX_NUM_SECTORS* sizeof(float));
-        memset(pData->elev_deg[i], 0, HYBRID_BANDS*MAX_NUM_SECTORS * sizeof(float));
-        memset(pData->colourScale[i], 0, HYBRID_BANDS*MAX_NUM_SECTORS * sizeof(float));
-        memset(pData->alphaScale[i], 0, HYBRID_BANDS*MAX_NUM_SECTORS * sizeof(float));
+        memset(pData->azi_deg[i], 0, pData->nBands*MAX_NUM_SECTORS* sizeof(float));
+        memset(pData->elev_deg[i], 0, pData->nBands*MAX_NUM_SECTORS * sizeof(float));
+        memset(pData->colourScale[i], 0, pData->nBands*MAX_NUM_SECTORS * sizeof(float));
+        memset(pData->alphaScale[i], 0, pData->nBands*MAX_NUM_SECTORS * sizeof(float));
     }
+    saf_blockAdaptor_reset(pData->hBlockAdaptor);
 }
 
 void sldoa_initCodec
@@ -184,195 +184,199 @@ void sldoa_initCodec
 )
 {
     sldoa_data *pData = (sldoa_data*)(hSld);
+    sldoa_codecPars* pars;
     
-    if (pData->codecStatus != CODEC_STATUS_NOT_INITIALISED)
+    /* The processing loop keeps running with the current codec state, while
+     * a new one is built here (so neither side ever waits for the other) */
+    if (!saf_atomic_compareExchangeInt(&(pData->codecStatus), CODEC_STATUS_NOT_INITIALISED, CODEC_STATUS_INITIALISING))
         return; /* re-init not required, or already happening */
-    while (pData->procStatus == PROC_STATUS_ONGOING){
-        /* re-init required, but we need to wait for the current processing loop to end */
-        pData->codecStatus = CODEC_STATUS_INITIALISING; /* indicate that we want to init */
-        SAF_SLEEP(10);
-    }
     
     /* for progress bar */
-    pData->codecStatus = CODEC_STATUS_INITIALISING;
     strcpy(pData->progressBarText,"Initialising");
     pData->progressBar0_1 = 0.0f;
     
-    sldoa_initTFT(hSld);
-    sldoa_initAna(hSld);
+    pars = (sldoa_codecPars*)calloc1d(1, sizeof(sldoa_codecPars));
+    sldoa_initTFT(hSld, pars);
+    sldoa_initAna(hSld, pars);
     
-    /* done! */
+    /* hand the new state over to the processing loop */
+    saf_stateSwap_publish(pData->hCodecState, (void*)pars);
+    pData->masterOrder = pars->masterOrder;
+    
+    /* done! (unless a setting changed in the meantime, in which case the
+     * status remains CODEC_STATUS_NOT_INITIALISED) */
     strcpy(pData->progressBarText,"Done!");
     pData->progressBar0_1 = 1.0f;
-    pData->codecStatus = CODEC_STATUS_INITIALISED;
+    saf_atomic_compareExchangeInt(&(pData->codecStatus), CODEC_STATUS_INITIALISING, CODEC_STATUS_INITIALISED);
 }
 
-void sldoa_analysis
+/** Analyses one frame of FRAME_SIZE samples (see saf_blockAdaptor_apply()) */
+static void sldoa_analysisFrame
 (
     void  *  const hSld,
     float ** const inputs,
+    float ** const outputs,
     int            nInputs,
-    int            nSamples,
-    int            isPlaying 
+    int            nOutputs
 )
 {
     sldoa_data *pData = (sldoa_data*)(hSld);
-    int s, i, j, t, ch, band, nSectors, min_band, numAnalysisBands, current_disp_idx;
-    float avgCoeff, max_en[HYBRID_BANDS], min_en[HYBRID_BANDS];
-    float new_doa[MAX_NUM_SECTORS][TIME_SLOTS][2], new_doa_xyz[3], doa_xyz[3], avg_xyz[3];
-    float new_energy[MAX_NUM_SECTORS][TIME_SLOTS];
+    sldoa_codecPars* pars;
+    int i, j, t, ch, band, nSectors, min_band, numAnalysisBands, current_disp_idx, nBands, timeSlots;
+    float avgCoeff, max_en, min_en;
+    float new_doa[MAX_NUM_SECTORS][MAX_TIME_SLOTS][2], new_doa_xyz[3], doa_xyz[3], avg_xyz[3];
+    float new_energy[MAX_NUM_SECTORS][MAX_TIME_SLOTS];
     
     /* local parameters */
     int nSH, masterOrder;
-    int analysisOrderPerBand[HYBRID_BANDS];
-    int nSectorsPerBand[HYBRID_BANDS];
+    int* analysisOrderPerBand, *nSectorsPerBand;
     float minFreq, maxFreq, avg_ms;
     CH_ORDER chOrdering;
     NORM_TYPES norm;
-    memcpy(analysisOrderPerBand, pData->analysisOrderPerBand, HYBRID_BANDS*sizeof(int));
-    memcpy(nSectorsPerBand, pData->nSectorsPerBand, HYBRID_BANDS*sizeof(int));
+
+    /* pick up the latest codec state (never blocks) */
+    pars = (sldoa_codecPars*)saf_stateSwap_acquire(pData->hCodecState);
+
+    nBands = pData->nBands;
+    timeSlots = pData->timeSlots;
+    analysisOrderPerBand = pData->analysisOrderPerBand;
+    nSectorsPerBand = pData->nSectorsPerBand;
     minFreq = pData->minFreq;
     maxFreq = pData->maxFreq;
     avg_ms = pData->avg_ms;
     chOrdering = pData->chOrdering;
     norm = pData->norm;
-    masterOrder = pData->masterOrder;
+    masterOrder = pars!=NULL ? pars->masterOrder : 1;
     nSH = ORDER2NSH(masterOrder);
 
-    /* Loop over all samples */
-    for(s=0; s<nSamples; s++){
-        /* Load input signals into inFIFO buffer */
+    /* (analysis only, no outputs) */
+    (void)outputs;
+    (void)nOutputs;
+
+    /* Process frame if codec is ready for it */
+    if (pars != NULL) {
+        current_disp_idx = pData->current_disp_idx;
+
+        /* Load time-domain data */
         for(ch=0; ch<MIN(nInputs,nSH); ch++)
-            pData->inFIFO[ch][pData->FIFO_idx] = inputs[ch][s];
+            memcpy(pData->SHframeTD[ch], inputs[ch], FRAME_SIZE*sizeof(float));
         for(; ch<nSH; ch++) /* Zero any channels that were not given */
-            pData->inFIFO[ch][pData->FIFO_idx] = 0.0f;
-
-        /* Increment buffer index */
-        pData->FIFO_idx++;
-
-        /* Process frame if inFIFO is full and codec is ready for it */
-        if (pData->FIFO_idx >= FRAME_SIZE && (pData->codecStatus == CODEC_STATUS_INITIALISED) && isPlaying) {
-            pData->FIFO_idx = 0;
-            pData->procStatus = PROC_STATUS_ONGOING;
-            current_disp_idx = pData->current_disp_idx;
-
-            /* Load time-domain data */
-            for(ch=0; ch<nSH; ch++)
-                memcpy(pData->SHframeTD[ch],pData->inFIFO[ch], FRAME_SIZE*sizeof(float));
-
-            /* account for input channel order */
-            switch(chOrdering){
-                case CH_ACN: /* already ACN */
-                    break;
-                case CH_FUMA:
-                    convertHOAChannelConvention((float*)pData->SHframeTD, masterOrder, FRAME_SIZE, HOA_CH_ORDER_FUMA, HOA_CH_ORDER_ACN);
-                    break;
-            }
-
-            /* account for input normalisation scheme */
-            switch(norm){
-                case NORM_N3D:  /* already in N3D, do nothing */
-                    break;
-                case NORM_SN3D: /* convert to N3D */
-                    convertHOANormConvention((float*)pData->SHframeTD, masterOrder, FRAME_SIZE, HOA_NORM_SN3D, HOA_NORM_N3D);
-                    break;
-                case NORM_FUMA: /* only for first-order, convert to N3D */
-                    convertHOANormConvention((float*)pData->SHframeTD, masterOrder, FRAME_SIZE, HOA_NORM_FUMA, HOA_NORM_N3D);
-                    break;
-            }
-        
-            /* apply the time-frequency transform */
-            for(t = 0; t < TIME_SLOTS; t++) {
-                for(ch = 0; ch < nSH; ch++)
-                    utility_svvcopy(&(pData->SHframeTD[ch][t*HOP_SIZE]), HOP_SIZE, pData->tempHopFrameTD[ch]);
-                afSTFTforward(pData->hSTFT, (float**)pData->tempHopFrameTD, (complexVector*)pData->STFTInputFrameTF);
-                for(band = 0; band < HYBRID_BANDS; band++)
-                    for(ch = 0; ch < nSH; ch++)
-                        pData->SHframeTF[band][ch][t] = cmplxf(pData->STFTInputFrameTF[ch].re[band], pData->STFTInputFrameTF[ch].im[band]);
-            }
+            memset(pData->SHframeTD[ch], 0, FRAME_SIZE*sizeof(float));
+
+        /* account for input channel order */
+        switch(chOrdering){
+            case CH_ACN: /* already ACN */
+                break;
+            case CH_FUMA:
+                convertHOAChannelConvention(FLATTEN2D(pData->SHframeTD), masterOrder, FRAME_SIZE, HOA_CH_ORDER_FUMA, HOA_CH_ORDER_ACN);
+                break;
+        }
 
-            /* apply sector-based, frequency-dependent DOA analysis */
-            numAnalysisBands = 0;
-            min_band = 0;
-            for(band=1/* ignore DC */; band<HYBRID_BANDS; band++){
-                if(pData->freqVector[band] <= minFreq)
-                    min_band = band;
-                if(pData->freqVector[band] >= minFreq && pData->freqVector[band]<=maxFreq){
-                    nSectors = nSectorsPerBand[band];
-                    avgCoeff = avg_ms < 10.0f ? 1.0f : 1.0f / ((avg_ms/1e3f) / (1.0f/(float)HOP_SIZE) + 2.23e-9f);
-                    avgCoeff = MAX(MIN(avgCoeff, 0.99999f), 0.0f); /* ensures stability */
-                    sldoa_estimateDoA(pData->SHframeTF[band],
-                                      analysisOrderPerBand[band],
-                                      pData->secCoeffs[analysisOrderPerBand[band]-2], /* -2, as first order is skipped */
-                                      new_doa,
-                                      new_energy);
-
-                    /* average the raw data over time */
-                    for(i=0; i<nSectors; i++){
-                        for( t = 0; t<TIME_SLOTS; t++){
-                            /* avg doa estimate */
-                            unitSph2Cart(new_doa[i][t][0], new_doa[i][t][1], new_doa_xyz);
-                            unitSph2Cart(pData->doa_rad[band][i][0],
-                                         pData->doa_rad[band][i][1],
-                                         doa_xyz);
-                            for(j=0; j<3; j++)
-                                avg_xyz[j] = new_doa_xyz[j]*avgCoeff + doa_xyz[j] * (1.0f-avgCoeff);
-                            unitCart2Sph_aziElev(avg_xyz, &(pData->doa_rad[band][i][0]), &(pData->doa_rad[band][i][1]));
-
-                            /* avg energy */
-                            pData->energy[band][i] = new_energy[i][t]*avgCoeff + pData->energy[band][i] * (1.0f-avgCoeff);
-                        }
+        /* account for input normalisation scheme */
+        switch(norm){
+            case NORM_N3D:  /* already in N3D, do nothing */
+                break;
+            case NORM_SN3D: /* convert to N3D */
+                convertHOANormConvention(FLATTEN2D(pData->SHframeTD), masterOrder, FRAME_SIZE, HOA_NORM_SN3D, HOA_NORM_N3D);
+                break;
+            case NORM_FUMA: /* only for first-order, convert to N3D */
+                convertHOANormConvention(FLATTEN2D(pData->SHframeTD), masterOrder, FRAME_SIZE, HOA_NORM_FUMA, HOA_NORM_N3D);
+                break;
+        }
+    
+        /* apply the time-frequency transform */
+        afSTFTforwardFrame(pars->hSTFT, pData->SHframeTD, FRAME_SIZE, MAX_NUM_SH_SIGNALS,
+                           AFSTFT_BANDS_CH_TIME, FLATTEN3D(pData->SHframeTF));
+
+        /* apply sector-based, frequency-dependent DOA analysis */
+        numAnalysisBands = 0;
+        min_band = 0;
+        for(band=1/* ignore DC */; band<nBands; band++){
+            if(pData->freqVector[band] <= minFreq)
+                min_band = band;
+            if(pData->freqVector[band] >= minFreq && pData->freqVector[band]<=maxFreq){
+                nSectors = nSectorsPerBand[band];
+                avgCoeff = avg_ms < 10.0f ? 1.0f : 1.0f / ((avg_ms/1e3f) / (1.0f/(float)pData->hopSize) + 2.23e-9f);
+                avgCoeff = MAX(MIN(avgCoeff, 0.99999f), 0.0f); /* ensures stability */
+                sldoa_estimateDoA(FLATTEN2D(pData->SHframeTF[band]),
+                                  timeSlots,
+                                  analysisOrderPerBand[band],
+                                  pars->secCoeffs[analysisOrderPerBand[band]-2], /* -2, as first order is skipped */
+                                  new_doa,
+                                  new_energy);
+
+                /* average the raw data over time */
+                for(i=0; i<nSectors; i++){
+                    for( t = 0; t<timeSlots; t++){
+                        /* avg doa estimate */
+                        unitSph2Cart(new_doa[i][t][0], new_doa[i][t][1], new_doa_xyz);
+                        unitSph2Cart(pData->doa_rad[band][i][0],
+                                     pData->doa_rad[band][i][1],
+                                     doa_xyz);
+                        for(j=0; j<3; j++)
+                            avg_xyz[j] = new_doa_xyz[j]*avgCoeff + doa_xyz[j] * (1.0f-avgCoeff);
+                        unitCart2Sph_aziElev(avg_xyz, &(pData->doa_rad[band][i][0]), &(pData->doa_rad[band][i][1]));
+
+                        /* avg energy */
+                        pData->energy[band][i] = new_energy[i][t]*avgCoeff + pData->energy[band][i] * (1.0f-avgCoeff);
                     }
-                    numAnalysisBands++;
                 }
+                numAnalysisBands++;
             }
+        }
 
-            /* determine the minimum and maximum sector energies per frequency (to scale them 0..1) */
-            for(band=1/* ignore DC */; band<HYBRID_BANDS; band++){
-                if(pData->freqVector[band] >= minFreq && pData->freqVector[band]<=maxFreq){
-                    nSectors = nSectorsPerBand[band];
-                    max_en[band] = 2.3e-13f; min_en[band] = 2.3e13f; /* starting values */
-                    for(i=0; i<nSectors; i++){
-                        max_en[band] = pData->energy[band][i] > max_en[band] ? pData->energy[band][i] : max_en[band];
-                        min_en[band] = pData->energy[band][i] < min_en[band] ? pData->energy[band][i] : min_en[band];
-                    }
-                }
-            }
+        /* prep data for plotting */
+        for(band=1/* ignore DC */; band<nBands; band++){
+            if(pData->freqVector[band] >= minFreq && pData->freqVector[band]<=maxFreq){
+                nSectors = nSectorsPerBand[band];
 
-            /* prep data for plotting */
-            for(band=1/* ignore DC */; band<HYBRID_BANDS; band++){
-                if(pData->freqVector[band] >= minFreq && pData->freqVector[band]<=maxFreq){
-                    nSectors = nSectorsPerBand[band];
-                    /* store averaged values */
-                    for(i=0; i<nSectors; i++){
-                        pData->azi_deg [current_disp_idx][band*MAX_NUM_SECTORS + i] = pData->doa_rad[band][i][0]*180.0f/M_PI;
-                        pData->elev_deg[current_disp_idx][band*MAX_NUM_SECTORS + i] = pData->doa_rad[band][i][1]*180.0f/M_PI;
-
-                        /* colour should indicate the different frequencies */
-                        pData->colourScale[current_disp_idx][band*MAX_NUM_SECTORS + i] = (float)(band-min_band)/(float)(numAnalysisBands+1);
-
-                        /* transparancy should indicate the energy of the sector for each DoA estimate, for each frequency */
-                        if( analysisOrderPerBand[band]==1  )
-                            pData->alphaScale[current_disp_idx][band*MAX_NUM_SECTORS + i] = 1.0f;
-                        else
-                            pData->alphaScale[current_disp_idx][band*MAX_NUM_SECTORS + i] = MIN(MAX((pData->energy[band][i]-min_en[band])/(max_en[band]-min_en[band]+2.3e-10f), 0.05f),1.0f);
-                    }
+                /* determine the minimum and maximum sector energies (to scale them 0..1) */
+                max_en = 2.3e-13f; min_en = 2.3e13f; /* starting values */
+                for(i=0; i<nSectors; i++){
+                    max_en = pData->energy[band][i] > max_en ? pData->energy[band][i] : max_en;
+                    min_en = pData->energy[band][i] < min_en ? pData->energy[band][i] : min_en;
                 }
-                else{
-                    memset(&(pData->azi_deg [current_disp_idx][band*MAX_NUM_SECTORS]), 0, MAX_NUM_SECTORS*sizeof(float));
-                    memset(&(pData->elev_deg [current_disp_idx][band*MAX_NUM_SECTORS]), 0, MAX_NUM_SECTORS*sizeof(float));
-                    memset(&(pData->colourScale [current_disp_idx][band*MAX_NUM_SECTORS]), 0, MAX_NUM_SECTORS*sizeof(float));
-                    memset(&(pData->alphaScale [current_disp_idx][band*MAX_NUM_SECTORS]), 0, MAX_NUM_SECTORS*sizeof(float));
+
+                /* store averaged values */
+                for(i=0; i<nSectors; i++){
+                    pData->azi_deg [current_disp_idx][band*MAX_NUM_SECTORS + i] = pData->doa_rad[band][i][0]*180.0f/M_PI;
+                    pData->elev_deg[current_disp_idx][band*MAX_NUM_SECTORS + i] = pData->doa_rad[band][i][1]*180.0f/M_PI;
+
+                    /* colour should indicate the different frequencies */
+                    pData->colourScale[current_disp_idx][band*MAX_NUM_SECTORS + i] = (float)(band-min_band)/(float)(numAnalysisBands+1);
+
+                    /* transparancy should indicate the energy of the sector for each DoA estimate, for each frequency */
+                    if( analysisOrderPerBand[band]==1  )
+                        pData->alphaScale[current_disp_idx][band*MAX_NUM_SECTORS + i] = 1.0f;
+                    else
+                        pData->alphaScale[current_disp_idx][band*MAX_NUM_SECTORS + i] = MIN(MAX((pData->energy[band][i]-min_en)/(max_en-min_en+2.3e-10f), 0.05f),1.0f);
                 }
             }
-        }
-        else if(pData->FIFO_idx >= FRAME_SIZE){
-            /* reset FIFO_idx if codec was not ready */
-            pData->FIFO_idx = 0;
+            else{
+                memset(&(pData->azi_deg [current_disp_idx][band*MAX_NUM_SECTORS]), 0, MAX_NUM_SECTORS*sizeof(float));
+                memset(&(pData->elev_deg [current_disp_idx][band*MAX_NUM_SECTORS]), 0, MAX_NUM_SECTORS*sizeof(float));
+                memset(&(pData->colourScale [current_disp_idx][band*MAX_NUM_SECTORS]), 0, MAX_NUM_SECTORS*sizeof(float));
+                memset(&(pData->alphaScale [current_disp_idx][band*MAX_NUM_SECTORS]), 0, MAX_NUM_SECTORS*sizeof(float));
+            }
         }
     }
+}
 
-    pData->procStatus = PROC_STATUS_NOT_ONGOING;
+void sldoa_analysis
+(
+    void  *  const hSld,
+    float ** const inputs,
+    int            nInputs,
+    int            nSamples,
+    int            isPlaying 
+)
+{
+    sldoa_data *pData = (sldoa_data*)(hSld);
+
+    /* Frames are only analysed while the host is playing */
+    if(isPlaying)
+        saf_blockAdaptor_apply(pData->hBlockAdaptor, inputs, NULL, nInputs, 0,
+                               nSamples, sldoa_analysisFrame, hSld);
 }
 
 /* SETS */
@@ -430,12 +434,12 @@ void sldoa_setSourcePreset(void* const hSld, int newPresetID)
     reverse = 0;
     switch(newPresetID){
         case MIC_PRESET_IDEAL:
-            for(band=0; band<HYBRID_BANDS; band++)
+            for(band=0; band<pData->nBands; band++)
                 pData->analysisOrderPerBand[band] = pData->new_masterOrder;
             break;
 
         case MIC_PRESET_ZYLIA:
-            for(band=0; band<HYBRID_BANDS; band++){
+            for(band=0; band<pData->nBands; band++){
                 if(rangeIdx<2*(__Zylia_maxOrder-1)){
                     if(pData->freqVector[band]>__Zylia_freqRange[rangeIdx]){
                         if(!reverse)
@@ -452,7 +456,7 @@ void sldoa_setSourcePreset(void* const hSld, int newPresetID)
             break;
 
         case MIC_PRESET_EIGENMIKE32:
-            for(band=0; band<HYBRID_BANDS; band++){
+            for(band=0; band<pData->nBands; band++){
                 if(rangeIdx<2*(__Eigenmike32_maxOrder-1)){
                     if(pData->freqVector[band]>__Eigenmike32_freqRange[rangeIdx]){
                         if(!reverse)
@@ -469,7 +473,7 @@ void sldoa_setSourcePreset(void* const hSld, int newPresetID)
             break;
 
         case MIC_PRESET_DTU_MIC:
-            for(band=0; band<HYBRID_BANDS; band++){
+            for(band=0; band<pData->nBands; band++){
                 if(rangeIdx<2*(__DTU_mic_maxOrder-1)){
                     if(pData->freqVector[band]>__DTU_mic_freqRange[rangeIdx]){
                         if(!reverse)
@@ -485,7 +489,7 @@ void sldoa_setSourcePreset(void* const hSld, int newPresetID)
             pData->maxFreq = __DTU_mic_freqRange[(__DTU_mic_maxOrder-1)*2-1];
             break;
     }
-    for(band=0; band<HYBRID_BANDS; band++)
+    for(band=0; band<pData->nBands; band++)
         pData->nSectorsPerBand[band] = ORDER2NUMSECTORS(pData->analysisOrderPerBand[band]);
 }
 
@@ -501,7 +505,7 @@ void sldoa_setAnaOrderAllBands(void * const hSld, int newValue)
     sldoa_data *pData = (sldoa_data*)(hSld);
     int band;
     
-    for(band=0; band<HYBRID_BANDS; band++){
+    for(band=0; band<pData->nBands; band++){
         pData->analysisOrderPerBand[band] = MIN(MAX(newValue,1), pData->new_masterOrder);
         pData->nSectorsPerBand[band] = ORDER2NUMSECTORS(pData->analysisOrderPerBand[band]);
     }
@@ -532,7 +536,7 @@ int sldoa_getFrameSize(void)
 CODEC_STATUS sldoa_getCodecStatus(void* const hSld)
 {
     sldoa_data *pData = (sldoa_data*)(hSld);
-    return pData->codecStatus;
+    return (CODEC_STATUS)saf_atomic_loadInt(&(pData->codecStatus));
 }
 
 float sldoa_getProgressBar0_1(void* const hSld)
@@ -602,7 +606,7 @@ void sldoa_getDisplayData
     (*maxNumSectors) = MAX_NUM_SECTORS;
     (*startBand) =1;
     (*endBand) =1;
-    for(i=1/*ignore DC*/; i<HYBRID_BANDS; i++){
+    for(i=1/*ignore DC*/; i<pData->nBands; i++){
         if(pData->freqVector[i]<pData->minFreq)
             (*startBand) = i+1;
         if(pData->freqVector[i]<pData->maxFreq)
@@ -637,12 +641,18 @@ void sldoa_getAnaOrderHandle
     sldoa_data *pData = (sldoa_data*)(hSld);
     (*pX_vector) = &(pData->freqVector[0]);
     (*pY_values) = &(pData->analysisOrderPerBand[0]);
-    (*pNpoints) = HYBRID_BANDS;
+    (*pNpoints) = pData->nBands;
 }
 
 int sldoa_getNumberOfBands(void)
 {
-    return HYBRID_BANDS;
+    return DEFAULT_TF_FRAME_SIZE + 5;
+}
+
+int sldoa_getNumberOfBandsEx(void* const hSld)
+{
+    sldoa_data *pData = (sldoa_data*)(hSld);
+    return pData->nBands;
 }
 
 int sldoa_getNSHrequired(void* const hSld)
@@ -665,5 +675,11 @@ int sldoa_getNormType(void* const hSld)
 
 int sldoa_getProcessingDelay()
 {
-    return FRAME_SIZE + 12*HOP_SIZE;
+    return FRAME_SIZE + afSTFTgetProcessingDelay(DEFAULT_TF_FRAME_SIZE, 0, 1);
+}
+
+int sldoa_getProcessingDelayEx(void* const hSld)
+{
+    sldoa_data *pData = (sldoa_data*)(hSld);
+    return FRAME_SIZE + afSTFTgetProcessingDelay(pData->hopSize, 0, 1) + saf_blockAdaptor_getDelay(pData->hBlockAdaptor);
 }
@@ -49,22 +49,42 @@
 void sldoa_setCodecStatus(void* const hSld, CODEC_STATUS newStatus)
 {
     sldoa_data *pData = (sldoa_data*)(hSld);
-    if(newStatus==CODEC_STATUS_NOT_INITIALISED){
-        /* Pause until current initialisation is complete */
-        while(pData->codecStatus == CODEC_STATUS_INITIALISING)
-            SAF_SLEEP(10);
+    saf_atomic_storeInt(&(pData->codecStatus), (int)newStatus);
+}
+
+void sldoa_destroyCodecPars(void** const phPars)
+{
+    sldoa_codecPars *pars = (sldoa_codecPars*)(*phPars);
+    int i;
+
+    if(pars!=NULL){
+        if(pars->hSTFT!=NULL)
+            afSTFTfree(pars->hSTFT);
+        for(i=0; i<MAX_SH_ORDER-1; i++)
+            free(pars->secCoeffs[i]);
+        saf_shGridCache_release(pars->grid_Y);
+        free(pars->grid_Y_dipoles_norm);
+        free(pars);
+        *phPars = NULL;
     }
-    pData->codecStatus = newStatus;
 }
 
-void sldoa_initAna(void* const hSld)
+void sldoa_initAna(void* const hSld, sldoa_codecPars* pars)
 {
     sldoa_data *pData = (sldoa_data*)(hSld);
     int i, n, j, k, order, nSectors, nSH, grid_N_vbap_gtable, grid_nGroups, maxOrder;
     float* sec_dirs_deg, *grid_vbap_gtable, *w_SG, *pinv_Y, *grid_vbap_gtable_T;
     float secPatterns[4][NUM_GRID_DIRS];
 
-    maxOrder = pData->new_masterOrder;
+    maxOrder = pars->masterOrder;
+
+    /* spherical harmonics of the grid (shared between instances), and their
+     * dipoles scaled to [0..1] */
+    pars->grid_Y = saf_shGridCache_acquireReal(MAX_SH_ORDER, (float*)pData->grid_dirs_deg, NUM_GRID_DIRS, 1.0f);
+    pars->grid_Y_dipoles_norm = malloc1d(3*NUM_GRID_DIRS*sizeof(float));
+    for(i=0; i<3; i++)
+        for(j=0; j<NUM_GRID_DIRS; j++)
+            pars->grid_Y_dipoles_norm[i*NUM_GRID_DIRS+j] = pars->grid_Y[(i+1)*NUM_GRID_DIRS+j]/sqrtf(3.0f);
     
     grid_vbap_gtable_T = malloc1d(ORDER2NUMSECTORS(maxOrder) * NUM_GRID_DIRS * sizeof(float));
     
@@ -89,16 +109,14 @@ void sldoa_initAna(void* const hSld)
                 grid_vbap_gtable_T[n*NUM_GRID_DIRS+j] = grid_vbap_gtable[j*nSectors+n];
         
         /* generate sector coefficients */
-        if(pData->secCoeffs[i]!=NULL)
-            free(pData->secCoeffs[i]);
-        pData->secCoeffs[i] = malloc1d(4 * (nSH*nSectors) * sizeof(float_complex));
+        pars->secCoeffs[i] = malloc1d(4 * (nSH*nSectors) * sizeof(float_complex));
         w_SG = malloc1d(4 * (nSH) * sizeof(float));
         pinv_Y = malloc1d(NUM_GRID_DIRS*nSH*sizeof(float));
         for(n=0; n<nSectors; n++){ 
-            utility_svvmul(&(grid_vbap_gtable_T[n*NUM_GRID_DIRS]), pData->grid_Y[0], NUM_GRID_DIRS, secPatterns[0]);
+            utility_svvmul(&(grid_vbap_gtable_T[n*NUM_GRID_DIRS]), pars->grid_Y, NUM_GRID_DIRS, secPatterns[0]);
             for(j=0; j<3; j++)
-                utility_svvmul(&(grid_vbap_gtable_T[n*NUM_GRID_DIRS]), pData->grid_Y_dipoles_norm[j], NUM_GRID_DIRS, secPatterns[j+1]);
-            utility_spinv(&(pData->grid_Y[0][0]), nSH, NUM_GRID_DIRS, pinv_Y);
+                utility_svvmul(&(grid_vbap_gtable_T[n*NUM_GRID_DIRS]), &(pars->grid_Y_dipoles_norm[j*NUM_GRID_DIRS]), NUM_GRID_DIRS, secPatterns[j+1]);
+            utility_spinv(pars->grid_Y, nSH, NUM_GRID_DIRS, pinv_Y);
             cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, 4, nSH, NUM_GRID_DIRS, 1.0f,
                         &(secPatterns[0][0]), NUM_GRID_DIRS,
                         pinv_Y, nSH, 0.0f,
@@ -107,7 +125,7 @@ void sldoa_initAna(void* const hSld)
             /* stack the sector coefficients */
             for(j=0; j<4; j++)
                 for(k=0; k<nSH; k++)
-                    pData->secCoeffs[i][j*(nSectors*nSH)+n*nSH+k] = cmplxf(w_SG[j*nSH+k], 0.0f);
+                    pars->secCoeffs[i][j*(nSectors*nSH)+n*nSH+k] = cmplxf(w_SG[j*nSH+k], 0.0f);
         }
         free(w_SG);
         free(pinv_Y);
@@ -116,49 +134,46 @@ void sldoa_initAna(void* const hSld)
     }
     
     free(grid_vbap_gtable_T);
-    
-    pData->masterOrder = maxOrder;
 }
 
 void sldoa_initTFT
 (
-    void* const hSld
+    void* const hSld,
+    sldoa_codecPars* pars
 )
 {
     sldoa_data *pData = (sldoa_data*)(hSld);
-    int nSH, new_nSH;
+    int nSH;
     
-    nSH = (pData->masterOrder+1)*(pData->masterOrder+1);
-    new_nSH = (pData->new_masterOrder+1)*(pData->new_masterOrder+1);
-    if(pData->hSTFT==NULL)
-        afSTFTinit(&(pData->hSTFT), HOP_SIZE, new_nSH, 0, 0, 1);
-    else if(nSH!=new_nSH){
-        afSTFTchannelChange(pData->hSTFT, new_nSH, 0);
-        afSTFTclearBuffers(pData->hSTFT);
-    }
+    /* a new afSTFT is created for every codec state, as the one of the
+     * current state may still be in use by the processing loop */
+    pars->masterOrder = pData->new_masterOrder;
+    nSH = (pars->masterOrder+1)*(pars->masterOrder+1);
+    afSTFTinit(&(pars->hSTFT), pData->hopSize, nSH, 0, 0, 1);
 }
 
 
 void sldoa_estimateDoA
 (
-    float_complex SHframeTF[MAX_NUM_SH_SIGNALS][TIME_SLOTS],
+    float_complex* SHframeTF,
+    int timeSlots,
     int anaOrder,
     float_complex* secCoeffs,
-    float doa[MAX_NUM_SECTORS][TIME_SLOTS][2],
-    float energy[MAX_NUM_SECTORS][TIME_SLOTS]
+    float doa[MAX_NUM_SECTORS][MAX_TIME_SLOTS][2],
+    float energy[MAX_NUM_SECTORS][MAX_TIME_SLOTS]
 )
 {
     int n, ch, i, j, nSectors, analysisOrder, nSH;
-    float_complex secSig[4][TIME_SLOTS];
+    float_complex secSig[4][MAX_TIME_SLOTS];
     float_complex* sec_c;
-    float secEnergy[TIME_SLOTS], secIntensity[3][TIME_SLOTS], secAzi[TIME_SLOTS], secElev[TIME_SLOTS];
+    float secEnergy[MAX_TIME_SLOTS], secIntensity[3][MAX_TIME_SLOTS], secAzi[MAX_TIME_SLOTS], secElev[MAX_TIME_SLOTS];
     const float_complex calpha = cmplxf(1.0f, 0.0f); const float_complex cbeta = cmplxf(0.0f, 0.0f);
     int o[MAX_SH_ORDER+2];
     for(n=0; n<MAX_SH_ORDER+2; n++){  o[n] = n*n;  }
     
     /* prep */
-    memset(doa,0,MAX_NUM_SECTORS*TIME_SLOTS*2*sizeof(float));
-    memset(energy,0,MAX_NUM_SECTORS*TIME_SLOTS*sizeof(float));
+    memset(doa,0,MAX_NUM_SECTORS*MAX_TIME_SLOTS*2*sizeof(float));
+    memset(energy,0,MAX_NUM_SECTORS*MAX_TIME_SLOTS*sizeof(float));
     analysisOrder = MAX(MIN(MAX_SH_ORDER, anaOrder),1);
     nSectors = ORDER2NUMSECTORS(analysisOrder);
     nSH = (analysisOrder+1)*(analysisOrder+1);
@@ -168,39 +183,39 @@ void sldoa_estimateDoA
     for( n=0; n<nSectors; n++){
         if(anaOrder==1 || secCoeffs == NULL) /* standard first order active-intensity based DoA estimation */
             for (i=0; i<4; i++)
-                memcpy(secSig[i], SHframeTF[i], TIME_SLOTS * sizeof(float_complex));
+                memcpy(secSig[i], &(SHframeTF[i*timeSlots]), timeSlots * sizeof(float_complex));
         else{ /* spatially localised active-intensity based DoA estimation */
             for (i=0; i<4; i++)
                 for (j=0; j<nSH; j++)
                     sec_c[i*nSH+j] = secCoeffs[i*(nSectors*nSH)+n*nSH+j];
-            cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, 4, TIME_SLOTS, nSH, &calpha,
+            cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, 4, timeSlots, nSH, &calpha,
                         sec_c, nSH,
-                        SHframeTF, TIME_SLOTS, &cbeta,
-                        secSig, TIME_SLOTS);
+                        SHframeTF, timeSlots, &cbeta,
+                        secSig, MAX_TIME_SLOTS);
         }
         
         /* convert N3D to SN3D */
         for (ch = 1; ch<4; ch++)
-            for(i = 0; i<TIME_SLOTS; i++)
+            for(i = 0; i<timeSlots; i++)
                 secSig[ch][i] = crmulf(secSig[ch][i], 1.0f/sqrtf(3.0f));
         
         /* calculate sector energy and intensity vector */
-        memset(secEnergy, 0, TIME_SLOTS*sizeof(float));
+        memset(secEnergy, 0, timeSlots*sizeof(float));
         for (i=0; i<4; i++)
-            for (j=0; j<TIME_SLOTS; j++)
+            for (j=0; j<timeSlots; j++)
                 secEnergy[j] += 0.5f*powf(cabsf(secSig[i][j]), 2.0f);
         for (i=0; i<3; i++)
-            for (j=0; j<TIME_SLOTS; j++)
+            for (j=0; j<timeSlots; j++)
                 secIntensity[i][j] = crealf(ccmulf(conjf(secSig[0][j]), secSig[1+i][j]));
         
         /* extract DoA */
-        for (j=0; j<TIME_SLOTS; j++){
+        for (j=0; j<timeSlots; j++){
             secAzi[j]  = atan2f( secIntensity[0][j], secIntensity[2][j] );
             secElev[j] = atan2f( secIntensity[1][j], sqrtf( powf(secIntensity[2][j], 2.0f) + powf(secIntensity[0][j], 2.0f)) );
         }
         
         /* store energy and DoA estimate */
-        for (j=0; j<TIME_SLOTS; j++){
+        for (j=0; j<timeSlots; j++){
             doa[n][j][0] = secAzi[j];
             doa[n][j][1] = secElev[j];
             energy[n][j] = secEnergy[j]*1e6f;
@@ -67,9 +67,7 @@ extern "C" {
 //#define ORDER2NUMSECTORS(L) ( 2*L )
 #define ORDER2NUMSECTORS(L) ( L*L )
 
-#define HOP_SIZE ( 128 )                                    /* STFT hop size = nBands */
-#define HYBRID_BANDS ( HOP_SIZE + 5 )                       /* hybrid mode incurs an additional 5 bands  */
-#define TIME_SLOTS ( FRAME_SIZE / HOP_SIZE )                /* Processing relies on fdHop = 16 */
+#define MAX_TIME_SLOTS ( FRAME_SIZE / MIN_TF_FRAME_SIZE )   /* maximum number of time slots (for the minimum hop size) */
 #define MAX_NUM_SECTORS ( ORDER2NUMSECTORS(MAX_SH_ORDER) )      /* maximum number of sectors */
 #define NUM_DISP_SLOTS ( 2 )                                /* needs to be at least 2. On slower systems that skip frames, consider more slots.  */
 #ifndef M_PI
@@ -81,38 +79,53 @@ extern "C" {
 /*                                 Structures                                 */
 /* ========================================================================== */
    
+/**
+ * Codec state of sldoa: the afSTFT, grid spherical harmonics, and sector
+ * coefficients for one configuration
+ *
+ * A new state is built by sldoa_initCodec() and handed over to the processing
+ * loop via a saf_stateSwap (see saf_stateSwap_create()). Once published, it is
+ * no longer modified; except for the afSTFT buffers, which only the processing
+ * loop uses.
+ */
+typedef struct _sldoa_codecPars
+{
+    int masterOrder;                         /**< analysis order the state is built for */
+    void* hSTFT;                             /**< afSTFT handle */
+    float_complex* secCoeffs[MAX_SH_ORDER-1]; /**< sector coefficients per order (2..masterOrder, NULL otherwise) */
+    const float* grid_Y;                     /**< (shared, read-only; see saf_shGridCache_acquireReal()) real SH of the grid, N3D; FLAT: ORDER2NSH(MAX_SH_ORDER) x NUM_GRID_DIRS */
+    float* grid_Y_dipoles_norm;              /**< dipoles of grid_Y scaled to [0..1]; FLAT: 3 x NUM_GRID_DIRS */
+
+} sldoa_codecPars;
+
 /**
  * Main struct for sldoa
  */
 typedef struct _sldoa
 {
-    /* FIFO buffers */
-    int FIFO_idx;
-    float inFIFO[MAX_NUM_SH_SIGNALS][FRAME_SIZE]; 
+    /* block-size adaptor */
+    void* hBlockAdaptor;
 
     /* TFT */
-    float SHframeTD[MAX_NUM_SH_SIGNALS][FRAME_SIZE];
-    float_complex SHframeTF[HYBRID_BANDS][MAX_NUM_SH_SIGNALS][TIME_SLOTS];
-    void* hSTFT;
-    complexVector* STFTInputFrameTF;
-    float** tempHopFrameTD;
-    float freqVector[HYBRID_BANDS];
+    int hopSize;                    /**< STFT hop size (specified at creation) */
+    int nBands;                     /**< Number of bands; hopSize+5 (hybrid mode) */
+    int timeSlots;                  /**< Number of time slots; FRAME_SIZE/hopSize */
+    float** SHframeTD;              /**< MAX_NUM_SH_SIGNALS x FRAME_SIZE */
+    float_complex*** SHframeTF;     /**< nBands x MAX_NUM_SH_SIGNALS x timeSlots */
+    float* freqVector;              /**< nBands x 1 */
     float fs;
       
     /* ana configuration */
-    CODEC_STATUS codecStatus;
-    PROC_STATUS procStatus;
+    volatile int codecStatus;       /**< see #_CODEC_STATUS enum */
     float progressBar0_1;
     char* progressBarText;
+    void* hCodecState;              /**< saf_stateSwap handing sldoa_codecPars to the processing loop */
     
     /* internal */
-    float grid_Y[64][NUM_GRID_DIRS];
-    float grid_Y_dipoles_norm[3][NUM_GRID_DIRS];
     float grid_dirs_deg[NUM_GRID_DIRS][2];
-    float_complex* secCoeffs[MAX_SH_ORDER-1];
-    float doa_rad[HYBRID_BANDS][MAX_NUM_SECTORS][2];
-    float energy [HYBRID_BANDS][MAX_NUM_SECTORS];
-    int nSectorsPerBand[HYBRID_BANDS];
+    float*** doa_rad;               /**< nBands x MAX_NUM_SECTORS x 2 */
+    float** energy;                 /**< nBands x MAX_NUM_SECTORS */
+    int* nSectorsPerBand;           /**< nBands x 1 */
     int new_masterOrder;
     
     /* display */
@@ -124,7 +137,7 @@ typedef struct _sldoa
     
     /* User parameters */
     int masterOrder;
-    int analysisOrderPerBand[HYBRID_BANDS];
+    int* analysisOrderPerBand;      /**< nBands x 1 */
     float maxFreq;
     float minFreq;
     float avg_ms;
@@ -140,11 +153,23 @@ typedef struct _sldoa
 
 /**
  * Sets codec status (see #_CODEC_STATUS enum)
+ *
+ * This never waits: if the codec is being initialised, then setting
+ * #CODEC_STATUS_NOT_INITIALISED causes sldoa_initCodec() to leave the status as
+ * such, so that the next call re-initialises the codec again.
  */
 void sldoa_setCodecStatus(void* const hSld, CODEC_STATUS newStatus);
 
 /**
- * Intialises the codec variables, based on current global/user parameters.
+ * Destroys a codec state (see saf_stateSwap_destroyFn)
+ *
+ * @param[in] phPars (&) address of the sldoa_codecPars
+ */
+void sldoa_destroyCodecPars(void** const phPars);
+
+/**
+ * Intialises the codec variables of a new codec state, based on current
+ * global/user parameters.
  *
  * The formulae for calculating the sector coefficients can be found in [1,2].
  *
@@ -159,17 +184,20 @@ void sldoa_setCodecStatus(void* const hSld, CODEC_STATUS newStatus);
  *          Visualization. Journal of the Audio Engineering Society, 67(11),
  *          pp.840-854.
  */
-void sldoa_initAna(void* const hSld);
+void sldoa_initAna(void* const hSld,
+                   sldoa_codecPars* pars);
     
 /**
- * Initialise the filterbank used by sldoa.
+ * Initialise the filterbank of a new codec state, for the current order.
  *
  * @note Call this function before sldoa_initAna()
  *
  * Input Arguments:
  *     hSld - sldoa handle
+ *     pars - the new codec state
  */
-void sldoa_initTFT(void* const hSld);
+void sldoa_initTFT(void* const hSld,
+                   sldoa_codecPars* pars);
   
 /**
  * Estimates the DoA using the active intensity vectors derived from spatially
@@ -178,7 +206,8 @@ void sldoa_initTFT(void* const hSld);
  * @note If anaOrder is 1, then the algorithm reverts to the standard active-
  *       intensity based DoA estimation.
  *
- * @param[in]  SHframeTF Input SH frame
+ * @param[in]  SHframeTF Input SH frame; FLAT: MAX_NUM_SH_SIGNALS x timeSlots
+ * @param[in]  timeSlots Number of time slots (at most #MAX_TIME_SLOTS)
  * @param[in]  anaOrder  Analysis order (1:AI, 2+: SLAI)
  * @param[in]  secCoeffs Sector coefficients for this order
  * @param[out] doa       Resulting DoA estimates per timeslot and sector
@@ -195,11 +224,12 @@ void sldoa_initTFT(void* const hSld);
  *          Visualization. Journal of the Audio Engineering Society, 67(11),
  *          pp.840-854.
  */
-void sldoa_estimateDoA(float_complex SHframeTF[MAX_NUM_SH_SIGNALS][TIME_SLOTS],
+void sldoa_estimateDoA(float_complex* SHframeTF,
+                       int timeSlots,
                        int anaOrder,
                        float_complex* secCoeffs,
-                       float doa[MAX_NUM_SECTORS][TIME_SLOTS][2],
-                       float energy[MAX_NUM_SECTORS][TIME_SLOTS]);
+                       float doa[MAX_NUM_SECTORS][MAX_TIME_SLOTS][2],
+                       float energy[MAX_NUM_SECTORS][MAX_TIME_SLOTS]);
     
 
 #ifdef __cplusplus
@@ -54,6 +54,9 @@ typedef struct _cdf4sap_data {
     float* P_Kxreginverse;
     float* Cx_MH, *Cy_tilde;
     float* G_M;
+
+    /* workspace for the SVDs (sized for the largest of Cx, Cy and Kx^H Q^H Ghat^H Ky) */
+    void* hSVD;
     
 }cdf4sap_data;
 
@@ -74,6 +77,9 @@ typedef struct _cdf4sap_cmplx_data {
     float_complex *P_Kxreginverse;
     float_complex *Cx_MH, *Cy_tilde;
     float_complex* G_M;
+
+    /* workspace for the SVDs (sized for the largest of Cx, Cy and Kx^H Q^H Ghat^H Ky) */
+    void* hSVD;
     
 }cdf4sap_cmplx_data;
 
@@ -127,6 +133,9 @@ void cdf4sap_create
     
     /* For using energy compensation instead of residuals */
     h->G_M = malloc1d(nYcols*nXcols*sizeof(float));
+
+    /* SVD workspace */
+    utility_ssvd_create(&(h->hSVD), MAX(nXcols, nYcols), MAX(nXcols, nYcols));
 }
 
 void cdf4sap_cmplx_create
@@ -180,6 +189,9 @@ void cdf4sap_cmplx_create
     
     /* For using energy compensation instead of residuals */
     h->G_M = malloc1d(nYcols*nXcols*sizeof(float_complex));
+
+    /* SVD workspace */
+    utility_csvd_create(&(h->hSVD), MAX(nXcols, nYcols), MAX(nXcols, nYcols));
 }
 
 void cdf4sap_destroy
@@ -212,6 +224,7 @@ void cdf4sap_destroy
         free(h->Cx_MH);
         free(h->Cy_tilde);
         free(h->G_M);
+        utility_ssvd_destroy(&(h->hSVD));
         free(h);
         h = NULL;
     }
@@ -248,6 +261,7 @@ void cdf4sap_cmplx_destroy
         free(h->Cx_MH);
         free(h->Cy_tilde);
         free(h->G_M);
+        utility_csvd_destroy(&(h->hSVD));
         free(h);
         h = NULL;
     }
@@ -276,7 +290,7 @@ void formulate_M_and_Cr
         h->lambda[i*nXcols + i] = 1.0f;
 
     /* Decomposition of Cy */
-    utility_ssvd(Cy, nYcols, nYcols, h->U_Cy, h->S_Cy, NULL, NULL);
+    utility_ssvd_ws(h->hSVD, Cy, nYcols, nYcols, h->U_Cy, h->S_Cy, NULL, NULL);
     for(i=0; i< nYcols; i++)
         h->S_Cy[i*nYcols+i] = sqrtf(MAX(h->S_Cy[i*nYcols+i], 2.23e-20f));
     cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nYcols, nYcols, nYcols, 1.0f,
@@ -285,7 +299,7 @@ void formulate_M_and_Cr
                 h->Ky, nYcols);
 
     /* Decomposition of Cx */
-    utility_ssvd(Cx, nXcols, nXcols, h->U_Cx, h->S_Cx, NULL, h->s_Cx);
+    utility_ssvd_ws(h->hSVD, Cx, nXcols, nXcols, h->U_Cx, h->S_Cx, NULL, h->s_Cx);
     for(i=0; i< nXcols; i++){
         h->S_Cx[i*nXcols+i] = sqrtf(MAX(h->S_Cx[i*nXcols+i], 2.23e-20f));
         h->s_Cx[i] = sqrtf(MAX(h->s_Cx[i], 2.23e-20f));
@@ -339,7 +353,7 @@ void formulate_M_and_Cr
                 h->Kx, nXcols,
                 h->QH_GhatH_Ky, nYcols, 0.0f,
                 h->KxH_QH_GhatH_Ky, nYcols);
-    utility_ssvd(h->KxH_QH_GhatH_Ky, nXcols, nYcols, h->U, NULL, h->V, NULL);
+    utility_ssvd_ws(h->hSVD, h->KxH_QH_GhatH_Ky, nXcols, nYcols, h->U, NULL, h->V, NULL);
     cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasTrans, nYcols, nXcols, nXcols, 1.0f,
                 h->lambda, nXcols,
                 h->U, nXcols, 0.0f,
@@ -411,7 +425,7 @@ void formulate_M_and_Cr_cmplx
         h->lambda[i*nXcols + i] = cmplxf(1.0f, 0.0f);
     
     /* Decomposition of Cy */
-    utility_csvd(Cy, nYcols, nYcols, h->U_Cy, h->S_Cy, NULL, NULL);
+    utility_csvd_ws(h->hSVD, Cy, nYcols, nYcols, h->U_Cy, h->S_Cy, NULL, NULL);
     for(i=0; i< nYcols; i++)
         h->S_Cy[i*nYcols+i] = cmplxf(sqrtf(MAX(crealf(h->S_Cy[i*nYcols+i]), 2.23e-20f)), 0.0f);
     cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nYcols, nYcols, nYcols, &calpha,
@@ -420,7 +434,7 @@ void formulate_M_and_Cr_cmplx
                 h->Ky, nYcols);
     
     /* Decomposition of Cx */
-    utility_csvd(Cx, nXcols, nXcols, h->U_Cx, h->S_Cx, NULL, h->s_Cx);
+    utility_csvd_ws(h->hSVD, Cx, nXcols, nXcols, h->U_Cx, h->S_Cx, NULL, h->s_Cx);
     for(i=0; i< nXcols; i++){
         h->s_Cx[i] = sqrtf(MAX(h->s_Cx[i], 2.23e-13f));
         h->S_Cx[i*nXcols+i] = cmplxf(h->s_Cx[i], 0.0f);
@@ -477,7 +491,7 @@ void formulate_M_and_Cr_cmplx
                 h->Kx, nXcols,
                 h->QH_GhatH_Ky, nYcols, &cbeta,
                 h->KxH_QH_GhatH_Ky, nYcols);
-    utility_csvd(h->KxH_QH_GhatH_Ky, nXcols, nYcols, h->U, NULL, h->V, NULL);
+    utility_csvd_ws(h->hSVD, h->KxH_QH_GhatH_Ky, nXcols, nYcols, h->U, NULL, h->V, NULL);
     cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasConjTrans, nYcols, nXcols, nXcols, &calpha,
                 h->lambda, nXcols,
                 h->U, nXcols, &cbeta,
@@ -304,7 +304,7 @@ void getLoudspeakerDecoderMtx
 {
     int i, j, nSH;
     float scale;
-    float* Y_ls, *a_n, *decMtx_maxrE;
+    float* Y_ls, *a_n;
 
     nSH = ORDER2NSH(order);
     scale = 1.0f/SQRT4PI;
@@ -344,19 +344,14 @@ void getLoudspeakerDecoderMtx
             break;
     }
     
-    /* Apply maxRE weighting */
+    /* Apply maxRE weighting (order-wise, i.e. a diagonal matrix, which is
+     * applied by scaling the columns of the decoder) */
     if(enableMaxReWeighting){
-        a_n = malloc1d(nSH*nSH*sizeof(float));
-        getMaxREweights(order, 1, a_n); /* 1: weights returned as diagonal matrix */
-        decMtx_maxrE = malloc1d(nLS * nSH * sizeof(float));
-        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nLS, nSH, nSH, 1.0f,
-                    decMtx, nSH,
-                    a_n, nSH, 0.0f,
-                    decMtx_maxrE, nSH);
-        memcpy(decMtx, decMtx_maxrE, nLS*nSH*sizeof(float));
-        
+        a_n = malloc1d(nSH*sizeof(float));
+        getMaxREweights(order, 0, a_n); /* 0: weights returned as a vector */
+        for(i=0; i<nLS; i++)
+            utility_svvmul(&decMtx[i*nSH], a_n, nSH, &decMtx[i*nSH]);
         free(a_n);
-        free(decMtx_maxrE);
     }
 }
 
@@ -376,10 +371,8 @@ void getBinauralAmbiDecoderMtx
     float_complex* decMtx
 )
 {
-    int i, k, nSH;
-    float *tmp;
-    float_complex* a_n, *decMtx_rE;
-    const float_complex calpha = cmplxf(1.0f, 0.0f), cbeta = cmplxf(0.0f, 0.0f);
+    int i, j, k, nSH;
+    float* a_n;
     
     nSH = ORDER2NSH(order);
     
@@ -407,24 +400,16 @@ void getBinauralAmbiDecoderMtx
             break;
     }
     
-    /* apply Max RE weighting per bin */
+    /* apply Max RE weighting per bin (order-wise, i.e. by scaling the columns
+     * of the decoders) */
     if(enableMaxReWeighting){
-        tmp = malloc1d(nSH*nSH*sizeof(float));
-        a_n = malloc1d(nSH*nSH*sizeof(float_complex));
-        decMtx_rE = malloc1d(NUM_EARS*nSH*sizeof(float_complex));
-        getMaxREweights(order, 1, tmp);
-        for(i=0; i<nSH*nSH; i++)
-            a_n[i] = cmplxf(tmp[i], 0.0f);
-        for(k=0; k<N_bands; k++){
-            cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, NUM_EARS, nSH, nSH, &calpha,
-                        &decMtx[k*NUM_EARS*nSH], nSH,
-                        a_n, nSH, &cbeta,
-                        decMtx_rE, nSH);
-            memcpy(&decMtx[k*NUM_EARS*nSH], decMtx_rE, NUM_EARS*nSH*sizeof(float_complex));
-        }
-        free(tmp);
+        a_n = malloc1d(nSH*sizeof(float));
+        getMaxREweights(order, 0, a_n); /* 0: weights returned as a vector */
+        for(k=0; k<N_bands; k++)
+            for(i=0; i<NUM_EARS; i++)
+                for(j=0; j<nSH; j++)
+                    decMtx[k*NUM_EARS*nSH + i*nSH + j] = crmulf(decMtx[k*NUM_EARS*nSH + i*nSH + j], a_n[j]);
         free(a_n);
-        free(decMtx_rE);
     }
     
     /* apply diffuse-field coherence matching per bin */
@@ -493,17 +478,19 @@ void applyDiffCovMatching
     float_complex* decMtx
 )
 {
-    int i, nSH, band;
+    int i, nSH, band, nMatch;
     float* Y_tmp;
+    void* hChol, *hSVD;
     float_complex* W, *Y_na, *H_W, *H_ambi, *decMtx_diffMatched;
-    float_complex C_ref[NUM_EARS][NUM_EARS], C_ambi[NUM_EARS][NUM_EARS];
-    float_complex X[NUM_EARS][NUM_EARS], X_ambi[NUM_EARS][NUM_EARS];
-    float_complex XH_Xambi[NUM_EARS][NUM_EARS], U[NUM_EARS][NUM_EARS];
-    float_complex V[NUM_EARS][NUM_EARS], UX[NUM_EARS][NUM_EARS];
-    float_complex VUX[NUM_EARS][NUM_EARS], M[NUM_EARS][NUM_EARS];
+    float_complex* C, *X, *XH_Xambi, *U, *V;
+    float_complex* C_ref, *C_ambi, *X_ref, *X_ambi;
+    float_complex UX[NUM_EARS][NUM_EARS], VUX[NUM_EARS][NUM_EARS], M[NUM_EARS][NUM_EARS];
     const float_complex calpha = cmplxf(1.0f, 0.0f), cbeta = cmplxf(0.0f, 0.0f);
     
     nSH = ORDER2NSH(order);
+    nMatch = N_bands-1; /* skip Nyquist */
+    if(nMatch<1)
+        return;
     
     /* integration weights */
     W = calloc1d(N_dirs*N_dirs, sizeof(float_complex));
@@ -522,11 +509,21 @@ void applyDiffCovMatching
         Y_na[i] = cmplxf(Y_tmp[i], 0.0f);
     free(Y_tmp);
     
-    /* apply diffuse-field coherence matching per band */
+    /* Per band reference and ambisonic diffuse-field covariance matrices,
+     * stacked as FLAT: nMatch x 2 (ref, ambi) x NUM_EARS x NUM_EARS, so that
+     * all of them may be factorised with a single batched call */
     H_W = malloc1d(NUM_EARS*N_dirs*sizeof(float_complex));
     H_ambi = malloc1d(NUM_EARS*N_dirs*sizeof(float_complex));
     decMtx_diffMatched = malloc1d(NUM_EARS*nSH*sizeof(float_complex));
-    for(band=0; band<N_bands-1 /* skip Nyquist */; band++){
+    C = malloc1d(nMatch*2*NUM_EARS*NUM_EARS*sizeof(float_complex));
+    X = malloc1d(nMatch*2*NUM_EARS*NUM_EARS*sizeof(float_complex));
+    XH_Xambi = malloc1d(nMatch*NUM_EARS*NUM_EARS*sizeof(float_complex));
+    U = malloc1d(nMatch*NUM_EARS*NUM_EARS*sizeof(float_complex));
+    V = malloc1d(nMatch*NUM_EARS*NUM_EARS*sizeof(float_complex));
+    for(band=0; band<nMatch; band++){
+        C_ref = &C[(2*band)*NUM_EARS*NUM_EARS];
+        C_ambi = &C[(2*band+1)*NUM_EARS*NUM_EARS];
+
         /* Diffuse-field responses */
         cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, NUM_EARS, N_dirs, N_dirs, &calpha,
                     &hrtfs[band*NUM_EARS*N_dirs], N_dirs,
@@ -535,10 +532,9 @@ void applyDiffCovMatching
         cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasConjTrans, NUM_EARS, NUM_EARS, N_dirs, &calpha,
                     H_W, N_dirs,
                     &hrtfs[band*NUM_EARS*N_dirs], N_dirs, &cbeta,
-                    (float_complex*)C_ref, NUM_EARS);
+                    C_ref, NUM_EARS);
         for(i=0; i<NUM_EARS; i++)
-            C_ref[i][i] = cmplxf(crealf(C_ref[i][i]), 0.0f); /* force diagonal to be real */
-        utility_cchol((float_complex*)C_ref, NUM_EARS, (float_complex*)X);
+            C_ref[i*NUM_EARS+i] = cmplxf(crealf(C_ref[i*NUM_EARS+i]), 0.0f); /* force diagonal to be real */
         cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, NUM_EARS, N_dirs, nSH, &calpha,
                     &decMtx[band*NUM_EARS*nSH], nSH,
                     Y_na, N_dirs, &cbeta,
@@ -550,28 +546,42 @@ void applyDiffCovMatching
         cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasConjTrans, NUM_EARS, NUM_EARS, N_dirs, &calpha,
                     H_W, N_dirs,
                     H_ambi, N_dirs, &cbeta,
-                    (float_complex*)C_ambi, NUM_EARS);
+                    C_ambi, NUM_EARS);
         for(i=0; i<NUM_EARS; i++)
-            C_ambi[i][i] = cmplxf(crealf(C_ambi[i][i]), 0.0f); /* force diagonal to be real */
-        utility_cchol((float_complex*)C_ambi, NUM_EARS, (float_complex*)X_ambi);
-        
-        /* SVD */
+            C_ambi[i*NUM_EARS+i] = cmplxf(crealf(C_ambi[i*NUM_EARS+i]), 0.0f); /* force diagonal to be real */
+    }
+
+    /* Cholesky factorisation of all of the covariance matrices */
+    utility_cchol_batch_create(&hChol, NUM_EARS, 2*nMatch);
+    utility_cchol_batch(hChol, C, NUM_EARS, 2*nMatch, X);
+    utility_cchol_batch_destroy(&hChol);
+
+    /* SVD */
+    for(band=0; band<nMatch; band++){
+        X_ref = &X[(2*band)*NUM_EARS*NUM_EARS];
+        X_ambi = &X[(2*band+1)*NUM_EARS*NUM_EARS];
         cblas_cgemm(CblasRowMajor, CblasConjTrans, CblasNoTrans, NUM_EARS, NUM_EARS, NUM_EARS, &calpha,
-                    (float_complex*)X_ambi, NUM_EARS,
-                    (float_complex*)X, NUM_EARS, &cbeta,
-                    (float_complex*)XH_Xambi, NUM_EARS);
-        utility_csvd((float_complex*)XH_Xambi, NUM_EARS, NUM_EARS, (float_complex*)U, NULL, (float_complex*)V, NULL);
-        
-        /* apply matching */
+                    X_ambi, NUM_EARS,
+                    X_ref, NUM_EARS, &cbeta,
+                    &XH_Xambi[band*NUM_EARS*NUM_EARS], NUM_EARS);
+    }
+    utility_csvd_create(&hSVD, NUM_EARS, NUM_EARS);
+    utility_csvd_batch(hSVD, XH_Xambi, NUM_EARS, NUM_EARS, nMatch, U, NULL, V, NULL);
+    utility_csvd_destroy(&hSVD);
+
+    /* apply matching */
+    for(band=0; band<nMatch; band++){
+        X_ref = &X[(2*band)*NUM_EARS*NUM_EARS];
+        X_ambi = &X[(2*band+1)*NUM_EARS*NUM_EARS];
         cblas_cgemm(CblasRowMajor, CblasConjTrans, CblasNoTrans, NUM_EARS, NUM_EARS, NUM_EARS, &calpha,
-                    (float_complex*)U, NUM_EARS,
-                    (float_complex*)X, NUM_EARS, &cbeta,
+                    &U[band*NUM_EARS*NUM_EARS], NUM_EARS,
+                    X_ref, NUM_EARS, &cbeta,
                     (float_complex*)UX, NUM_EARS);
         cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, NUM_EARS, NUM_EARS, NUM_EARS, &calpha,
-                    (float_complex*)V, NUM_EARS,
+                    &V[band*NUM_EARS*NUM_EARS], NUM_EARS,
                     (float_complex*)UX, NUM_EARS, &cbeta,
                     (float_complex*)VUX, NUM_EARS);
-        utility_cglslv((float_complex*)X_ambi, NUM_EARS, (float_complex*)VUX, NUM_EARS, (float_complex*)M);
+        utility_cglslv(X_ambi, NUM_EARS, (float_complex*)VUX, NUM_EARS, (float_complex*)M);
         cblas_cgemm(CblasRowMajor, CblasConjTrans, CblasNoTrans, NUM_EARS, nSH, NUM_EARS, &calpha,
                     (float_complex*)M, NUM_EARS,
                     &decMtx[band*NUM_EARS*nSH], nSH, &cbeta,
@@ -584,4 +594,9 @@ void applyDiffCovMatching
     free(H_W);
     free(H_ambi);
     free(decMtx_diffMatched);
+    free(C);
+    free(X);
+    free(XH_Xambi);
+    free(U);
+    free(V);
 } 
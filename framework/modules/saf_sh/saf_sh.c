@@ -104,6 +104,124 @@ void yawPitchRoll2Rzyx
     }
 }
 
+void rotationMatrix2yawPitchRoll
+(
+    float R[3][3],
+    int rollPitchYawFLAG,
+    float* yaw,
+    float* pitch,
+    float* roll
+)
+{
+    if(rollPitchYawFLAG){
+        /* R = Rz * Ry * Rx */
+        *yaw = atan2f(-R[1][0], R[0][0]);
+        *pitch = asinf(MAX(MIN(R[2][0], 1.0f), -1.0f));
+        *roll = atan2f(-R[2][1], R[2][2]);
+    }
+    else{
+        /* R = Rx * Ry * Rz */
+        *yaw = atan2f(R[0][1], R[0][0]);
+        *pitch = -asinf(MAX(MIN(R[0][2], 1.0f), -1.0f));
+        *roll = atan2f(R[1][2], R[2][2]);
+    }
+}
+
+void quaternion2rotationMatrix
+(
+    float Q[4],
+    float R[3][3]
+)
+{
+    float s, w, x, y, z;
+
+    w = Q[0]; x = Q[1]; y = Q[2]; z = Q[3];
+    s = 2.0f/(w*w + x*x + y*y + z*z);
+    R[0][0] = 1.0f - s*(y*y + z*z);
+    R[0][1] = s*(x*y - w*z);
+    R[0][2] = s*(x*z + w*y);
+    R[1][0] = s*(x*y + w*z);
+    R[1][1] = 1.0f - s*(x*x + z*z);
+    R[1][2] = s*(y*z - w*x);
+    R[2][0] = s*(x*z - w*y);
+    R[2][1] = s*(y*z + w*x);
+    R[2][2] = 1.0f - s*(x*x + y*y);
+}
+
+void rotationMatrix2quaternion
+(
+    float R[3][3],
+    float Q[4]
+)
+{
+    float tr, S;
+
+    /* Branch on the largest diagonal term, for numerical robustness */
+    tr = R[0][0] + R[1][1] + R[2][2];
+    if(tr>0.0f){
+        S = sqrtf(tr + 1.0f) * 2.0f;
+        Q[0] = 0.25f * S;
+        Q[1] = (R[2][1] - R[1][2]) / S;
+        Q[2] = (R[0][2] - R[2][0]) / S;
+        Q[3] = (R[1][0] - R[0][1]) / S;
+    }
+    else if(R[0][0]>R[1][1] && R[0][0]>R[2][2]){
+        S = sqrtf(1.0f + R[0][0] - R[1][1] - R[2][2]) * 2.0f;
+        Q[0] = (R[2][1] - R[1][2]) / S;
+        Q[1] = 0.25f * S;
+        Q[2] = (R[0][1] + R[1][0]) / S;
+        Q[3] = (R[0][2] + R[2][0]) / S;
+    }
+    else if(R[1][1]>R[2][2]){
+        S = sqrtf(1.0f + R[1][1] - R[0][0] - R[2][2]) * 2.0f;
+        Q[0] = (R[0][2] - R[2][0]) / S;
+        Q[1] = (R[0][1] + R[1][0]) / S;
+        Q[2] = 0.25f * S;
+        Q[3] = (R[1][2] + R[2][1]) / S;
+    }
+    else{
+        S = sqrtf(1.0f + R[2][2] - R[0][0] - R[1][1]) * 2.0f;
+        Q[0] = (R[1][0] - R[0][1]) / S;
+        Q[1] = (R[0][2] + R[2][0]) / S;
+        Q[2] = (R[1][2] + R[2][1]) / S;
+        Q[3] = 0.25f * S;
+    }
+}
+
+void quaternionSlerp
+(
+    float Q0[4],
+    float Q1[4],
+    float t,
+    float Q[4]
+)
+{
+    int i;
+    float cosTheta, theta, sinTheta, s0, s1, norm;
+
+    /* Take the shortest path (Q1 and -Q1 describe the same rotation) */
+    cosTheta = Q0[0]*Q1[0] + Q0[1]*Q1[1] + Q0[2]*Q1[2] + Q0[3]*Q1[3];
+    s1 = cosTheta < 0.0f ? -1.0f : 1.0f;
+    cosTheta = fabsf(cosTheta);
+
+    if(cosTheta > 0.9995f){
+        /* Nearly parallel: linear interpolation is accurate (and stable) */
+        s0 = 1.0f - t;
+        s1 *= t;
+    }
+    else{
+        theta = acosf(cosTheta);
+        sinTheta = sinf(theta);
+        s0 = sinf((1.0f-t)*theta)/sinTheta;
+        s1 *= sinf(t*theta)/sinTheta;
+    }
+    for(i=0; i<4; i++)
+        Q[i] = s0*Q0[i] + s1*Q1[i];
+    norm = sqrtf(Q[0]*Q[0] + Q[1]*Q[1] + Q[2]*Q[2] + Q[3]*Q[3]);
+    for(i=0; i<4; i++)
+        Q[i] /= norm;
+}
+
 void unitSph2Cart
 (
     float azi_rad,
@@ -413,6 +531,370 @@ void getSHreal_recur
     }
 }
 
+void saf_shEvaluator_create
+(
+    void ** const phSHE,
+    int maxOrder,
+    float tableRes_deg
+)
+{
+    *phSHE = malloc1d(sizeof(shEvaluator_data));
+    shEvaluator_data *h = (shEvaluator_data*)(*phSHE);
+    int n, m, i, j, k, nGrid;
+    double num, den;
+    float* grid_dirs, *Y_grid;
+
+    h->maxOrder = maxOrder;
+    h->nSH = ORDER2NSH(maxOrder);
+    h->a_nm = calloc1d((maxOrder+1)*(maxOrder+1), sizeof(float));
+    h->b_nm = calloc1d((maxOrder+1)*(maxOrder+1), sizeof(float));
+    h->c_m = calloc1d(maxOrder+1, sizeof(float));
+    h->K_m = malloc1d((maxOrder+1)*sizeof(float));
+
+    /* Fully normalised associated Legendre functions (without the
+     * Condon-Shortley phase), obtained via the recursions:
+     *   P_m^m = c_m sin(incl) P_{m-1}^{m-1}, with P_0^0 = 1
+     *   P_n^m = a_nm cos(incl) P_{n-1}^m - b_nm P_{n-2}^m, for n>m */
+    for(m=0; m<=maxOrder; m++){
+        h->K_m[m] = (float)((m==0 ? 1.0 : sqrt(2.0))/sqrt(4.0*SAF_PId));
+        if(m>0)
+            h->c_m[m] = (float)sqrt((2.0*(double)m+1.0)/(2.0*(double)m));
+        for(n=m+1; n<=maxOrder; n++){
+            den = (double)(n*n-m*m);
+            h->a_nm[n*(maxOrder+1)+m] = (float)sqrt((4.0*(double)(n*n)-1.0)/den);
+            num = (double)((n-1)*(n-1)-m*m) * (2.0*(double)n+1.0);
+            h->b_nm[n*(maxOrder+1)+m] = num > 0.0 ? (float)sqrt(num/((2.0*(double)n-3.0)*den)) : 0.0f;
+        }
+    }
+
+    /* Optional look-up table, evaluated on a regular grid */
+    h->table = NULL;
+    h->tableAziRes_rad = h->tableInclRes_rad = 0.0f;
+    h->nTableAzi = h->nTableIncl = 0;
+    if(tableRes_deg>0.0f){
+        h->nTableAzi = MAX((int)(360.0f/tableRes_deg+0.5f), 1);
+        h->nTableIncl = MAX((int)(180.0f/tableRes_deg+0.5f), 1) + 1;
+        /* (the actual spacings, such that the grid spans exactly 0..2pi and
+         * 0..pi, also when tableRes_deg does not divide 360 and 180) */
+        h->tableAziRes_rad = 2.0f*SAF_PI/(float)h->nTableAzi;
+        h->tableInclRes_rad = SAF_PI/(float)(h->nTableIncl-1);
+        nGrid = h->nTableIncl * h->nTableAzi;
+        grid_dirs = malloc1d(nGrid*2*sizeof(float));
+        Y_grid = malloc1d(h->nSH*nGrid*sizeof(float));
+        for(i=0; i<h->nTableIncl; i++){
+            for(j=0; j<h->nTableAzi; j++){
+                grid_dirs[(i*h->nTableAzi+j)*2]   = (float)j*h->tableAziRes_rad;
+                grid_dirs[(i*h->nTableAzi+j)*2+1] = MIN((float)i*h->tableInclRes_rad, SAF_PI);
+            }
+        }
+        saf_shEvaluator_getSHreal(*phSHE, maxOrder, grid_dirs, nGrid, Y_grid);
+
+        /* Store direction-major, such that each look-up is contiguous */
+        h->table = malloc1d(nGrid*h->nSH*sizeof(float));
+        for(k=0; k<h->nSH; k++)
+            for(i=0; i<nGrid; i++)
+                h->table[i*h->nSH+k] = Y_grid[k*nGrid+i];
+        free(grid_dirs);
+        free(Y_grid);
+    }
+}
+
+void saf_shEvaluator_destroy
+(
+    void ** const phSHE
+)
+{
+    shEvaluator_data *h = (shEvaluator_data*)(*phSHE);
+
+    if (h != NULL) {
+        free(h->a_nm);
+        free(h->b_nm);
+        free(h->c_m);
+        free(h->K_m);
+        free(h->table);
+        free(h);
+        h = NULL;
+        *phSHE = NULL;
+    }
+}
+
+void saf_shEvaluator_getSHreal
+(
+    void * const hSHE,
+    int order,
+    float* dirs_rad,
+    int nDirs,
+    float* Y
+)
+{
+    shEvaluator_data *h = (shEvaluator_data*)(hSHE);
+    int n, m, d, d0, len, ldA;
+    float a, b, K, tmp;
+    float* y_s, *y_c;
+
+    assert(order<=h->maxOrder);
+    ldA = h->maxOrder+1;
+
+    for(d0=0; d0<nDirs; d0+=SH_EVALUATOR_BLOCK_SIZE){
+        len = MIN(SH_EVALUATOR_BLOCK_SIZE, nDirs-d0);
+
+        /* Only 4 trigonometric functions per direction */
+        for(d=0; d<len; d++){
+            h->cosAzi[d]  = cosf(dirs_rad[(d0+d)*2]);
+            h->sinAzi[d]  = sinf(dirs_rad[(d0+d)*2]);
+            h->cosIncl[d] = cosf(dirs_rad[(d0+d)*2+1]);
+            h->sinIncl[d] = sinf(dirs_rad[(d0+d)*2+1]);
+            h->cosmAzi[d] = 1.0f;
+            h->sinmAzi[d] = 0.0f;
+            h->P_mm[d] = 1.0f;
+        }
+
+        for(m=0; m<=order; m++){
+            if(m>0){
+                /* cos(m*azi) and sin(m*azi) via angle-addition, and P_m^m */
+                for(d=0; d<len; d++){
+                    tmp = h->cosmAzi[d]*h->cosAzi[d] - h->sinmAzi[d]*h->sinAzi[d];
+                    h->sinmAzi[d] = h->sinmAzi[d]*h->cosAzi[d] + h->cosmAzi[d]*h->sinAzi[d];
+                    h->cosmAzi[d] = tmp;
+                    h->P_mm[d] *= h->c_m[m] * h->sinIncl[d];
+                }
+            }
+            memcpy(h->P_n1, h->P_mm, len*sizeof(float));
+            memset(h->P_n2, 0, len*sizeof(float));
+
+            /* Step up in degree for this order, writing each as it is found */
+            K = h->K_m[m];
+            for(n=m; n<=order; n++){
+                if(n>m){
+                    a = h->a_nm[n*ldA+m];
+                    b = h->b_nm[n*ldA+m];
+                    for(d=0; d<len; d++){
+                        tmp = a * h->cosIncl[d] * h->P_n1[d] - b * h->P_n2[d];
+                        h->P_n2[d] = h->P_n1[d];
+                        h->P_n1[d] = tmp;
+                    }
+                }
+                if(m==0){
+                    y_c = &Y[(n*n+n)*nDirs + d0];
+                    for(d=0; d<len; d++)
+                        y_c[d] = K * h->P_n1[d];
+                }
+                else{
+                    y_s = &Y[(n*n+n-m)*nDirs + d0];
+                    y_c = &Y[(n*n+n+m)*nDirs + d0];
+                    for(d=0; d<len; d++){
+                        y_s[d] = K * h->P_n1[d] * h->sinmAzi[d];
+                        y_c[d] = K * h->P_n1[d] * h->cosmAzi[d];
+                    }
+                }
+            }
+        }
+    }
+}
+
+void saf_shEvaluator_getSHrealInterp
+(
+    void * const hSHE,
+    int order,
+    float* dirs_rad,
+    int nDirs,
+    float* Y
+)
+{
+    shEvaluator_data *h = (shEvaluator_data*)(hSHE);
+    int d, k, nSH, ia, ia1, ii;
+    float azi, incl, fa, fi, wa, wi, w00, w01, w10, w11;
+    float* T00, *T01, *T10, *T11;
+
+    if(h->table==NULL){
+        saf_shEvaluator_getSHreal(hSHE, order, dirs_rad, nDirs, Y);
+        return;
+    }
+    assert(order<=h->maxOrder);
+    nSH = ORDER2NSH(order);
+
+    for(d=0; d<nDirs; d++){
+        /* Wrap azimuth to [0 2pi), and clamp inclination to [0 pi] */
+        azi = fmodf(dirs_rad[d*2], 2.0f*SAF_PI);
+        azi = azi < 0.0f ? azi + 2.0f*SAF_PI : azi;
+        incl = MIN(MAX(dirs_rad[d*2+1], 0.0f), SAF_PI);
+
+        /* Bilinear interpolation weights */
+        fa = azi/h->tableAziRes_rad;
+        ia = (int)fa;
+        wa = fa - (float)ia;
+        ia = ia % h->nTableAzi;
+        ia1 = (ia+1) % h->nTableAzi;
+        fi = incl/h->tableInclRes_rad;
+        ii = MIN((int)fi, h->nTableIncl-2);
+        wi = MIN(fi - (float)ii, 1.0f);
+        w00 = (1.0f-wi)*(1.0f-wa);
+        w01 = (1.0f-wi)*wa;
+        w10 = wi*(1.0f-wa);
+        w11 = wi*wa;
+        T00 = &h->table[(ii*h->nTableAzi + ia)*h->nSH];
+        T01 = &h->table[(ii*h->nTableAzi + ia1)*h->nSH];
+        T10 = &h->table[((ii+1)*h->nTableAzi + ia)*h->nSH];
+        T11 = &h->table[((ii+1)*h->nTableAzi + ia1)*h->nSH];
+        for(k=0; k<nSH; k++)
+            Y[k*nDirs+d] = w00*T00[k] + w01*T01[k] + w10*T10[k] + w11*T11[k];
+    }
+}
+
+/** Process-wide registry of grid SH matrices, guarded by a spin-lock */
+static shGridCache_entry* shGridCache = NULL;
+static volatile int shGridCacheLock = 0;
+
+/** Returns the registered entry matching the key (or NULL); lock must be held */
+static shGridCache_entry* saf_shGridCache_find
+(
+    int order,
+    const float* grid_dirs_deg,
+    int nDirs,
+    float scale,
+    int isComplex
+)
+{
+    shGridCache_entry* e;
+
+    for(e=shGridCache; e!=NULL; e=e->next)
+        if(e->order==order && e->nDirs==nDirs && e->isComplex==isComplex && e->scale==scale &&
+           !memcmp(e->grid_dirs_deg, grid_dirs_deg, nDirs*2*sizeof(float)))
+            break;
+    return e;
+}
+
+/**
+ * Returns the registered matrix for the requested grid, order, type and
+ * scaling, computing it if it does not yet exist, and increments its reference
+ * count
+ *
+ * The matrix is computed without holding the lock, so other threads are not
+ * blocked for its duration.
+ */
+static void* saf_shGridCache_acquire
+(
+    int order,
+    const float* grid_dirs_deg,
+    int nDirs,
+    float scale,
+    int isComplex
+)
+{
+    shGridCache_entry* e, *e_new;
+    int i, nSH;
+    float* dirs_rad, *Y;
+    float_complex* Yc;
+
+    /* Return the existing entry, if there is one */
+    saf_spinlock_lock(&shGridCacheLock);
+    e = saf_shGridCache_find(order, grid_dirs_deg, nDirs, scale, isComplex);
+    if(e!=NULL){
+        e->refCount++;
+        saf_spinlock_unlock(&shGridCacheLock);
+        return e->Y;
+    }
+    saf_spinlock_unlock(&shGridCacheLock);
+
+    /* Otherwise, compute a new entry without holding the lock */
+    e_new = malloc1d(sizeof(shGridCache_entry));
+    e_new->order = order;
+    e_new->nDirs = nDirs;
+    e_new->isComplex = isComplex;
+    e_new->scale = scale;
+    e_new->refCount = 1;
+    e_new->grid_dirs_deg = malloc1d(nDirs*2*sizeof(float));
+    memcpy(e_new->grid_dirs_deg, grid_dirs_deg, nDirs*2*sizeof(float));
+
+    /* As getRSH(), i.e. [azi elev] degrees, and without 1/sqrt(4*pi) */
+    nSH = ORDER2NSH(order);
+    dirs_rad = malloc1d(nDirs*2*sizeof(float));
+    for(i=0; i<nDirs; i++){
+        dirs_rad[i*2+0] = grid_dirs_deg[i*2+0] * SAF_PI/180.0f;
+        dirs_rad[i*2+1] = SAF_PI/2.0f - (grid_dirs_deg[i*2+1] * SAF_PI/180.0f);
+    }
+    Y = malloc1d(nSH*nDirs*sizeof(float));
+    getSHreal(order, dirs_rad, nDirs, Y);
+    scale *= sqrtf(4.0f*SAF_PI);
+    utility_svsmul(Y, &scale, nSH*nDirs, NULL);
+    if(isComplex){
+        Yc = malloc1d(nSH*nDirs*sizeof(float_complex));
+        for(i=0; i<nSH*nDirs; i++)
+            Yc[i] = cmplxf(Y[i], 0.0f);
+        free(Y);
+        e_new->Y = (void*)Yc;
+    }
+    else
+        e_new->Y = (void*)Y;
+    free(dirs_rad);
+
+    /* Insert it, unless another thread has inserted the same entry meanwhile */
+    saf_spinlock_lock(&shGridCacheLock);
+    e = saf_shGridCache_find(order, grid_dirs_deg, nDirs, e_new->scale, isComplex);
+    if(e==NULL){
+        e = e_new;
+        e->next = shGridCache;
+        shGridCache = e;
+        e_new = NULL;
+    }
+    else
+        e->refCount++;
+    saf_spinlock_unlock(&shGridCacheLock);
+    if(e_new!=NULL){
+        free(e_new->grid_dirs_deg);
+        free(e_new->Y);
+        free(e_new);
+    }
+    return e->Y;
+}
+
+const float* saf_shGridCache_acquireReal
+(
+    int order,
+    const float* grid_dirs_deg,
+    int nDirs,
+    float scale
+)
+{
+    return (const float*)saf_shGridCache_acquire(order, grid_dirs_deg, nDirs, scale, 0);
+}
+
+const float_complex* saf_shGridCache_acquireCmplx
+(
+    int order,
+    const float* grid_dirs_deg,
+    int nDirs,
+    float scale
+)
+{
+    return (const float_complex*)saf_shGridCache_acquire(order, grid_dirs_deg, nDirs, scale, 1);
+}
+
+void saf_shGridCache_release
+(
+    const void* Y
+)
+{
+    shGridCache_entry** pe, *e;
+
+    if(Y==NULL)
+        return;
+    saf_spinlock_lock(&shGridCacheLock);
+    for(pe=&shGridCache; *pe!=NULL && (*pe)->Y!=Y; pe=&((*pe)->next));
+    e = *pe;
+    assert(e!=NULL); /* not acquired from the registry */
+    if(e!=NULL){
+        e->refCount--;
+        if(e->refCount==0){
+            *pe = e->next;
+            free(e->grid_dirs_deg);
+            free(e->Y);
+            free(e);
+        }
+    }
+    saf_spinlock_unlock(&shGridCacheLock);
+}
+
 void getSHcomplex
 (
     int order,
@@ -566,19 +1048,45 @@ void getSHrotMtxReal
     int L
 )
 {
-    int i, j, M, l, m, n, d, bandIdx, denom;
-    float u, v, w;
-    float** R_1,  **R_lm1, **R_l;
-    
+    int i, j, M, l, bandIdx, blockIdx;
+    float* RotBlocks;
+
     M = (L+1) * (L+1);
-    R_1 = (float**)calloc2d(3, 3, sizeof(float));
-    R_lm1 = (float**)calloc2d(M, M, sizeof(float));
-    R_l = (float**)calloc2d(M, M, sizeof(float));
+    RotBlocks = malloc1d(ORDER2NSHROT(L)*sizeof(float));
+    getSHrotMtxRealBlocks(Rxyz, RotBlocks, L);
+
+    /* place the blocks along the diagonal */
     memset(RotMtx, 0, M*M*sizeof(float));
-    
+    bandIdx = blockIdx = 0;
+    for(l=0; l<=L; l++){
+        for(i=0; i<2*l+1; i++)
+            for(j=0; j<2*l+1; j++)
+                RotMtx[(bandIdx + i)*M + (bandIdx + j)] = RotBlocks[blockIdx + i*(2*l+1) + j];
+        bandIdx += 2*l+1;
+        blockIdx += (2*l+1)*(2*l+1);
+    }
+
+    free(RotBlocks);
+}
+
+/* Ivanic, J., Ruedenberg, K. (1998). Rotation Matrices for Real Spherical Harmonics. Direct Determination
+ * by Recursion Page: Additions and Corrections. Journal of Physical Chemistry A, 102(45), 9099?9100. */
+void getSHrotMtxRealBlocks
+(
+    float Rxyz[3][3],
+    float* RotBlocks/* ORDER2NSHROT(L) x 1 */,
+    int L
+)
+{
+    int l, m, n, d, blockIdx, prevBlockIdx, denom;
+    float u, v, w;
+    float R_1[3][3];
+
     /* zeroth-band (l=0) is invariant to rotation */
-    RotMtx[0] = 1;
-    
+    RotBlocks[0] = 1.0f;
+    if(L<1)
+        return;
+
     /* the first band (l=1) is directly related to the rotation matrix */
     R_1[-1+1][-1+1] = Rxyz[1][1];
     R_1[-1+1][0+1] = Rxyz[1][2];
@@ -589,17 +1097,13 @@ void getSHrotMtxReal
     R_1[ 1+1][-1+1] = Rxyz[0][1];
     R_1[ 1+1][0+1] = Rxyz[0][2];
     R_1[ 1+1][1+1] = Rxyz[0][0];
-    for (i=1; i<4; i++){
-        memcpy(R_lm1[i-1], R_1[i-1], 3*sizeof(float));
-        for (j=1; j<4; j++)
-            RotMtx[i*M+j] = R_1[i-1][j-1];
-    }
-    
-    /* compute rotation matrix of each subsequent band recursively */
-    bandIdx = 4;
+    memcpy(&RotBlocks[1], R_1, 9*sizeof(float));
+
+    /* compute the block of each subsequent band recursively, directly from the
+     * block of the previous band */
+    prevBlockIdx = 1;
+    blockIdx = 10;
     for(l = 2; l<=L; l++){
-        for(i=0; i<2*l+1; i++)
-            memset(R_l[i], 0, (2*l+1) * sizeof(float));
         for(m=-l; m<=l; m++){
             for(n=-l; n<=l; n++){
                 /* compute u,v,w terms of Eq.8.1 (Table I) */
@@ -611,28 +1115,103 @@ void getSHrotMtxReal
                 
                 /* computes Eq.8.1 */
                 if (u!=0)
-                    u = u* getU(l,m,n,R_1,R_lm1);
+                    u = u* getU(l,m,n,R_1,&RotBlocks[prevBlockIdx]);
                 if (v!=0)
-                    v = v* getV(l,m,n,R_1,R_lm1);
+                    v = v* getV(l,m,n,R_1,&RotBlocks[prevBlockIdx]);
                 if (w!=0)
-                    w = w* getW(l,m,n,R_1,R_lm1);
+                    w = w* getW(l,m,n,R_1,&RotBlocks[prevBlockIdx]);
                 
-                R_l[m+l][n+l] = u+v+w;
+                RotBlocks[blockIdx + (m+l)*(2*l+1) + (n+l)] = u+v+w;
             }
         }
-        
-        for(i=0; i<2*l+1; i++)
-            for(j=0; j<2*l+1; j++)
-                RotMtx[(bandIdx + i)*M + (bandIdx + j)] = R_l[i][j];
-                //RotMtx[(bandIdx+i)*(2*l+1) +(bandIdx+j)] = R_l[i][j];
-        for(i=0; i<2*l+1; i++)
-            memcpy(R_lm1[i], R_l[i], (2*l+1) * sizeof(float));
+        prevBlockIdx = blockIdx;
+        blockIdx += (2*l+1)*(2*l+1);
+    }
+}
+
+void applySHblockMtx
+(
+    const float* A,
+    int order,
+    const float* X,
+    int ldX,
+    int nCols,
+    float* Y,
+    int ldY
+)
+{
+    int l, bandIdx, blockIdx;
+
+    bandIdx = blockIdx = 0;
+    for(l=0; l<=order; l++){
+        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, 2*l+1, nCols, 2*l+1, 1.0f,
+                    &A[blockIdx], 2*l+1,
+                    &X[bandIdx*ldX], ldX, 0.0f,
+                    &Y[bandIdx*ldY], ldY);
         bandIdx += 2*l+1;
+        blockIdx += (2*l+1)*(2*l+1);
+    }
+}
+
+void applySHblockMtxToCmplx
+(
+    const float* A,
+    int order,
+    const float_complex* X,
+    int ldX,
+    int batchStrideX,
+    int nCols,
+    int nBatch,
+    float_complex* Y,
+    int ldY,
+    int batchStrideY
+)
+{
+    int b, l, bandIdx, blockIdx;
+
+    /* A real matrix applies to the interleaved real and imaginary parts alike,
+     * so each row of complex values is treated as 2*nCols real values */
+    for(b=0; b<nBatch; b++){
+        bandIdx = blockIdx = 0;
+        for(l=0; l<=order; l++){
+            cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, 2*l+1, 2*nCols, 2*l+1, 1.0f,
+                        &A[blockIdx], 2*l+1,
+                        (const float*)&X[b*batchStrideX + bandIdx*ldX], 2*ldX, 0.0f,
+                        (float*)&Y[b*batchStrideY + bandIdx*ldY], 2*ldY);
+            bandIdx += 2*l+1;
+            blockIdx += (2*l+1)*(2*l+1);
+        }
+    }
+}
+
+void applySHblockMtxCmplx
+(
+    const float_complex* A,
+    int order,
+    const float_complex* X,
+    int ldX,
+    int batchStrideX,
+    int nCols,
+    int nBatch,
+    float_complex* Y,
+    int ldY,
+    int batchStrideY
+)
+{
+    int b, l, bandIdx, blockIdx;
+    const float_complex calpha = cmplxf(1.0f, 0.0f), cbeta = cmplxf(0.0f, 0.0f);
+
+    for(b=0; b<nBatch; b++){
+        bandIdx = blockIdx = 0;
+        for(l=0; l<=order; l++){
+            cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, 2*l+1, nCols, 2*l+1, &calpha,
+                        &A[blockIdx], 2*l+1,
+                        &X[b*batchStrideX + bandIdx*ldX], ldX, &cbeta,
+                        &Y[b*batchStrideY + bandIdx*ldY], ldY);
+            bandIdx += 2*l+1;
+            blockIdx += (2*l+1)*(2*l+1);
+        }
     }
-    
-    free(R_1);
-    free(R_lm1);
-    free(R_l);
 }
 
 void computeVelCoeffsMtx
@@ -1256,40 +1835,40 @@ void generateMUSICmap
     float* pmap
 )
 {
-    int i, j, nSH;
-    float_complex* V, *Vn, *Vn_Y;
+    int i, j, nSH, nNoise;
+    void* hEig;
+    float_complex* V, *Vn_Y;
     const float_complex calpha = cmplxf(1.0f, 0.0f), cbeta = cmplxf(0.0f, 0.0f);
-    float_complex tmp;
+    float tmp;
     
     nSH = ORDER2NSH(order);
     nSources = MIN(nSources, nSH/2);
+    nNoise = nSH-nSources;
     V = malloc1d(nSH*nSH*sizeof(float_complex));
-    Vn = malloc1d(nSH*(nSH-nSources)*sizeof(float_complex));
-    Vn_Y = malloc1d((nSH-nSources)*nGrid_dirs*sizeof(float_complex));
-    
-    /* obtain eigenvectors */
-    //utility_ceig(Cx, nSH, 1, NULL, V, NULL, NULL);
-	utility_cseig(Cx, nSH, 1, V, NULL, NULL);
-    
-    /* truncate, to obtain noise sub-space */
-	for (i = 0; i < nSH; i++)
-		for (j = 0; j < nSH - nSources; j++)
-			Vn[i*(nSH - nSources) + j] = V[i*nSH + j + nSources];
-    
-    /* derive the pseudo-spectrum value for each grid direction */
-    cblas_cgemm(CblasRowMajor, CblasTrans, CblasNoTrans, nSH-nSources, nGrid_dirs, nSH, &calpha,
-                Vn, nSH-nSources,
+    Vn_Y = malloc1d(nNoise*nGrid_dirs*sizeof(float_complex));
+    
+    /* obtain eigenvectors as contiguous columns, in ascending order; the first
+     * nNoise columns therefore span the noise sub-space. Cx is Hermitian, and
+     * so passing it in row-major order returns conj(V) */
+    utility_cseig_create(&hEig, nSH);
+    utility_cseig_cm_ws(hEig, Cx, nSH, 0, V, NULL);
+    utility_cseig_destroy(&hEig);
+    
+    /* derive the pseudo-spectrum value for each grid direction: Vn^T * Y, which
+     * (as conj(Vn) was obtained) is computed as conj(Vn)^H * Y. The output is
+     * column-major, i.e. contiguous for each grid direction */
+    cblas_cgemm(CblasColMajor, CblasConjTrans, CblasTrans, nNoise, nGrid_dirs, nSH, &calpha,
+                V, nSH,
                 Y_grid, nGrid_dirs, &cbeta,
-                Vn_Y, nGrid_dirs);
+                Vn_Y, nNoise);
     for(i=0; i<nGrid_dirs; i++){
-        tmp = cmplxf(0.0f,0.0f);
-        for(j=0; j<nSH-nSources; j++)
-            tmp = ccaddf(tmp, ccmulf(conjf(Vn_Y[j*nGrid_dirs+i]),Vn_Y[j*nGrid_dirs+i]));
-        pmap[i] = logScaleFlag ? logf(1.0f/(crealf(tmp)+2.23e-10f)) : 1.0f/(crealf(tmp)+2.23e-10f);
+        tmp = 0.0f;
+        for(j=0; j<nNoise; j++)
+            tmp += crealf(ccmulf(conjf(Vn_Y[i*nNoise+j]), Vn_Y[i*nNoise+j]));
+        pmap[i] = logScaleFlag ? logf(1.0f/(tmp+2.23e-10f)) : 1.0f/(tmp+2.23e-10f);
     }
     
     free(V);
-    free(Vn);
     free(Vn_Y);
 }
 
@@ -1349,6 +1928,529 @@ void generateMinNormMap
     free(Un_Y);
 }
 
+/** Returns real(diag(A^T * B)), where A and B are nSH x len (lda, ldb) */
+static void saf_pmapEngine_realDiag
+(
+    const float_complex* A,
+    int lda,
+    const float_complex* B,
+    int ldb,
+    int nSH,
+    int len,
+    float* diag
+)
+{
+    int i, j;
+
+    /* accumulated row-by-row, such that the inner loop is contiguous */
+    memset(diag, 0, len*sizeof(float));
+    for(j=0; j<nSH; j++)
+        for(i=0; i<len; i++)
+            diag[i] += crealf(A[j*lda+i])*crealf(B[j*ldb+i]) - cimagf(A[j*lda+i])*cimagf(B[j*ldb+i]);
+}
+
+/**
+ * Processes the grid directions of one slice of a job, using the scratch of
+ * the given thread, and writes them into 'pmap_out' (and 'w_out' if not NULL)
+ */
+static void saf_pmapEngine_runSlice
+(
+    pmapEngine_data* h,
+    pmapEngine_slice* s,
+    const pmapEngine_job* job,
+    int sliceIdx,
+    float* pmap_out,
+    float_complex* w_out
+)
+{
+    int i, j, d0, len, nSH, nGrid_dirs;
+    float S, G, tmp;
+    float_complex M[2][2], det, xspec;
+    const float_complex* Y;
+    float* pmap;
+    const float_complex calpha = cmplxf(1.0f, 0.0f), cbeta = cmplxf(0.0f, 0.0f);
+
+    nGrid_dirs = job->nGrid_dirs;
+    d0 = sliceIdx * job->sliceLen;
+    len = MIN(job->sliceLen, nGrid_dirs - d0);
+    if(len<=0)
+        return;
+    nSH = job->nSH;
+    Y = &(job->Y_grid[d0]); /* (leading dimension of nGrid_dirs) */
+    pmap = &(pmap_out[d0]);
+
+    switch(job->type){
+        case PMAP_ENGINE_PWD:
+            /* real(diag(Y^T * Cx * Y)) */
+            cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nSH, len, nSH, &calpha,
+                        h->Cx, nSH,
+                        Y, nGrid_dirs, &cbeta,
+                        s->T, len);
+            saf_pmapEngine_realDiag(Y, nGrid_dirs, s->T, len, nSH, len, pmap);
+            break;
+
+        case PMAP_ENGINE_MVDR:
+        case PMAP_ENGINE_CROPAC:
+            /* numerators: Cx^-1 * Y */
+            for(j=0; j<nSH; j++)
+                memcpy(&(s->Ys[j*len]), &Y[j*(nGrid_dirs)], len*sizeof(float_complex));
+            utility_cslslv_ws(s->hSlv, h->Cx_d, nSH, s->Ys, len, s->X);
+
+            /* denominators: diag(Y^T * conj(Cx^-1 * Y)) */
+            for(i=0; i<len; i++)
+                s->d[i] = cmplxf(0.0f, 0.0f);
+            for(j=0; j<nSH; j++)
+                for(i=0; i<len; i++)
+                    s->d[i] = ccaddf(s->d[i], ccmulf(s->Ys[j*len+i], conjf(s->X[j*len+i])));
+            for(i=0; i<len; i++)
+                s->d[i] = ccdivf(cmplxf(1.0f, 0.0f), s->d[i]);
+
+            /* MVDR weights, and the PWD map using these weights */
+            for(j=0; j<nSH; j++)
+                for(i=0; i<len; i++)
+                    s->X[j*len+i] = ccmulf(s->X[j*len+i], s->d[i]);
+            cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nSH, len, nSH, &calpha,
+                        h->Cx, nSH,
+                        s->X, len, &cbeta,
+                        s->T, len);
+            if(job->type==PMAP_ENGINE_MVDR){
+                saf_pmapEngine_realDiag(s->X, len, s->T, len, nSH, len, pmap);
+                if(w_out!=NULL)
+                    for(j=0; j<nSH; j++)
+                        memcpy(&(w_out[j*(nGrid_dirs)+d0]), &(s->X[j*len]), len*sizeof(float_complex));
+                break;
+            }
+            saf_pmapEngine_realDiag(s->X, len, s->T, len, nSH, len, s->mvdr);
+
+            /* first half of the cross-spectrum: Cx * Y */
+            cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nSH, len, nSH, &calpha,
+                        h->Cx, nSH,
+                        s->Ys, len, &cbeta,
+                        s->T, len);
+            for(i=0; i<len; i++){
+                /* LCMV weights: (Cx^-1 * A) * (A^H * Cx^-1 * A)^-1 * [1 0]^T */
+                for(j=0; j<nSH; j++){
+                    s->A[j*2] = s->Ys[j*len+i];
+                    s->A[j*2+1] = ccmulf(s->A[j*2], h->Cx[j*nSH+j]);
+                }
+                utility_cslslv_ws(s->hSlv, h->Cx_d, nSH, s->A, 2, s->invCxd_A);
+                M[0][0] = M[0][1] = M[1][0] = M[1][1] = cmplxf(0.0f, 0.0f);
+                for(j=0; j<nSH; j++){
+                    M[0][0] = ccaddf(M[0][0], conjf(ccmulf(s->A[j*2],   s->invCxd_A[j*2])));
+                    M[0][1] = ccaddf(M[0][1], conjf(ccmulf(s->A[j*2],   s->invCxd_A[j*2+1])));
+                    M[1][0] = ccaddf(M[1][0], conjf(ccmulf(s->A[j*2+1], s->invCxd_A[j*2])));
+                    M[1][1] = ccaddf(M[1][1], conjf(ccmulf(s->A[j*2+1], s->invCxd_A[j*2+1])));
+                }
+                /* (the first row of the 2x2 inverse is all that is needed) */
+                det = ccsubf(ccmulf(M[0][0], M[1][1]), ccmulf(M[0][1], M[1][0]));
+                xspec = cmplxf(0.0f, 0.0f);
+                for(j=0; j<nSH; j++)
+                    xspec = ccaddf(xspec, ccmulf(ccdivf(ccsubf(ccmulf(M[1][1], s->invCxd_A[j*2]),
+                                                                ccmulf(M[0][1], s->invCxd_A[j*2+1])), det),
+                                                        s->T[j*len+i]));
+
+                /* CroPaC gain; the PWD map of the (gain scaled) MVDR weights
+                 * is therefore G^2 times the MVDR map */
+                S = MIN(cabsf(xspec), s->mvdr[i]);
+                G = sqrtf(S/(s->mvdr[i]+2.23e-10f));
+                G = MAX(job->lambda, G);
+                pmap[i] = G*G*s->mvdr[i];
+            }
+            break;
+
+        case PMAP_ENGINE_MUSIC:
+            /* conj(Vn)^H * Y (column-major, i.e. contiguous per direction) */
+            cblas_cgemm(CblasColMajor, CblasConjTrans, CblasTrans, job->nNoise, len, nSH, &calpha,
+                        h->V, nSH,
+                        Y, nGrid_dirs, &cbeta,
+                        s->T, job->nNoise);
+            for(i=0; i<len; i++){
+                tmp = 0.0f;
+                for(j=0; j<job->nNoise; j++)
+                    tmp += crealf(s->T[i*(job->nNoise)+j])*crealf(s->T[i*(job->nNoise)+j]) +
+                           cimagf(s->T[i*(job->nNoise)+j])*cimagf(s->T[i*(job->nNoise)+j]);
+                pmap[i] = job->logScaleFlag ? logf(1.0f/(tmp+2.23e-10f)) : 1.0f/(tmp+2.23e-10f);
+            }
+            break;
+
+        case PMAP_ENGINE_MINNORM:
+            /* Un^H * Y */
+            for(i=0; i<len; i++)
+                s->d[i] = cmplxf(0.0f, 0.0f);
+            for(j=0; j<nSH; j++)
+                for(i=0; i<len; i++)
+                    s->d[i] = ccaddf(s->d[i], ccmulf(conjf(h->Un[j]), Y[j*(nGrid_dirs)+i]));
+            for(i=0; i<len; i++){
+                tmp = crealf(s->d[i])*crealf(s->d[i]) + cimagf(s->d[i])*cimagf(s->d[i]);
+                pmap[i] = job->logScaleFlag ? logf(1.0f/(tmp + 2.23e-9f)) : 1.0f/(tmp + 2.23e-9f);
+            }
+            break;
+    }
+}
+
+/**
+ * Worker thread, which helps with the slices of each new job it is signalled
+ * about, which the calling thread has not started yet
+ */
+static void* saf_pmapEngine_worker
+(
+    void* arg
+)
+{
+    pmapEngine_slice* s = (pmapEngine_slice*)arg;
+    pmapEngine_data* h = (pmapEngine_data*)(s->hEngine);
+    pmapEngine_job job;
+    int t, gen;
+
+    while(1){
+        saf_semaphore_wait(s->hSemStart);
+        if(h->exitFLAG)
+            break;
+
+        /* The copy of the job is only used if one of its slices can still be
+         * claimed; which also means that the calling thread has not moved on
+         * to (and started writing) the next job while it was being copied */
+        gen = saf_atomic_loadInt(&(h->gen));
+        job = h->job;
+        for(t=MIN(job.nSlices, h->nThreads)-1; t>=0; t--){ /* (the calling thread starts from the first) */
+            if(!saf_atomic_compareExchangeInt(&(h->sliceStatus[t]), PMAP_SLICE_TAG(gen, PMAP_SLICE_FREE),
+                                              PMAP_SLICE_TAG(gen, PMAP_SLICE_CLAIMED(s->idx))))
+                continue;
+            saf_pmapEngine_runSlice(h, s, &job, t, s->pmap, NULL);
+
+            /* (fails if the calling thread took the slice back meanwhile, in
+             * which case this result is discarded) */
+            saf_atomic_compareExchangeInt(&(h->sliceStatus[t]), PMAP_SLICE_TAG(gen, PMAP_SLICE_CLAIMED(s->idx)),
+                                          PMAP_SLICE_TAG(gen, PMAP_SLICE_DONE(s->idx)));
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Splits the grid of the current job into slices, and runs it
+ *
+ * The calling thread never waits for the worker threads: it processes all
+ * slices which no worker has started, copies those which a worker has
+ * finished, and takes back (and processes itself) those which a worker is
+ * still busy with.
+ */
+static void saf_pmapEngine_run
+(
+    pmapEngine_data* h,
+    float* pmap,
+    float_complex* w_out
+)
+{
+    int t, d0, len, gen, status, nSlices, sliceLen;
+
+    assert(h->job.nGrid_dirs<=h->maxGridDirs);
+    nSlices = MIN(h->nThreads, MAX(1, h->job.nGrid_dirs/SAF_PMAP_MIN_DIRS_PER_THREAD));
+    sliceLen = (h->job.nGrid_dirs + nSlices - 1)/nSlices;
+    h->job.nSlices = nSlices;
+    h->job.sliceLen = sliceLen;
+
+    /* Open the slices of the new job; the workers only help when no weights
+     * are requested, as they compute into their own buffers */
+    gen = (saf_atomic_loadInt(&(h->gen))+1) & PMAP_ENGINE_GEN_MASK;
+    for(t=0; t<nSlices; t++)
+        saf_atomic_storeInt(&(h->sliceStatus[t]), PMAP_SLICE_TAG(gen, w_out==NULL ? PMAP_SLICE_FREE : PMAP_SLICE_CALLER));
+    saf_atomic_storeInt(&(h->gen), gen);
+    if(w_out==NULL)
+        for(t=1; t<nSlices; t++)
+            saf_semaphore_post(h->slices[t].hSemStart);
+
+    /* Process the slices which no worker has started */
+    for(t=0; t<nSlices; t++)
+        if(w_out!=NULL || saf_atomic_compareExchangeInt(&(h->sliceStatus[t]), PMAP_SLICE_TAG(gen, PMAP_SLICE_FREE),
+                                                         PMAP_SLICE_TAG(gen, PMAP_SLICE_CALLER)))
+            saf_pmapEngine_runSlice(h, &(h->slices[0]), &(h->job), t, pmap, w_out);
+
+    /* Collect the slices of the workers */
+    for(t=0; t<nSlices; t++){
+        status = saf_atomic_loadInt(&(h->sliceStatus[t])) & 0xFF;
+        if(status==PMAP_SLICE_CALLER)
+            continue;
+        if(status%2==0){
+            /* still being processed, so take it back */
+            if(saf_atomic_compareExchangeInt(&(h->sliceStatus[t]), PMAP_SLICE_TAG(gen, status),
+                                             PMAP_SLICE_TAG(gen, PMAP_SLICE_CALLER))){
+                saf_pmapEngine_runSlice(h, &(h->slices[0]), &(h->job), t, pmap, NULL);
+                continue;
+            }
+            status = saf_atomic_loadInt(&(h->sliceStatus[t])) & 0xFF; /* (done in the meantime) */
+        }
+        d0 = t*sliceLen;
+        len = MIN(sliceLen, h->job.nGrid_dirs - d0);
+        if(len>0)
+            memcpy(&(pmap[d0]), &(h->slices[status/2].pmap[d0]), len*sizeof(float));
+    }
+}
+
+/**
+ * Copies Cx (and stores its diagonally loaded version for MVDR and CroPaC, if
+ * regPar is not negative)
+ *
+ * Note that a worker which is still busy with a previous job may read these
+ * while they are overwritten; its result is discarded though.
+ */
+static void saf_pmapEngine_loadCx
+(
+    pmapEngine_data* h,
+    const float_complex* Cx,
+    float regPar
+)
+{
+    int i, nSH;
+    float Cx_trace;
+
+    nSH = h->job.nSH;
+    memcpy(h->Cx, Cx, nSH*nSH*sizeof(float_complex));
+    if(regPar<0.0f)
+        return;
+    Cx_trace = 0.0f;
+    for(i=0; i<nSH; i++)
+        Cx_trace += crealf(Cx[i*nSH+i]);
+    Cx_trace /= (float)nSH;
+    memcpy(h->Cx_d, Cx, nSH*nSH*sizeof(float_complex));
+    for(i=0; i<nSH; i++)
+        h->Cx_d[i*nSH+i] = craddf(h->Cx_d[i*nSH+i], regPar*Cx_trace);
+}
+
+void saf_pmapEngine_create
+(
+    void ** const phPM,
+    int maxOrder,
+    int maxGridDirs,
+    int nThreads
+)
+{
+    *phPM = malloc1d(sizeof(pmapEngine_data));
+    pmapEngine_data *h = (pmapEngine_data*)(*phPM);
+    pmapEngine_slice* s;
+    int t;
+
+    assert(nThreads<=SAF_PMAP_MAX_THREADS);
+    h->maxOrder = maxOrder;
+    h->maxNSH = ORDER2NSH(maxOrder);
+    h->maxGridDirs = maxGridDirs;
+    h->nThreads = MIN(MAX(nThreads, 1), SAF_PMAP_MAX_THREADS);
+    h->maxSliceDirs = MIN(maxGridDirs, MAX((maxGridDirs + h->nThreads - 1)/h->nThreads, 2*SAF_PMAP_MIN_DIRS_PER_THREAD));
+    h->exitFLAG = 0;
+    h->gen = 0;
+    memset(&(h->job), 0, sizeof(pmapEngine_job));
+    h->Cx = malloc1d(h->maxNSH*h->maxNSH*sizeof(float_complex));
+    h->Cx_d = malloc1d(h->maxNSH*h->maxNSH*sizeof(float_complex));
+    h->V = malloc1d(h->maxNSH*h->maxNSH*sizeof(float_complex));
+    h->Un = malloc1d(h->maxNSH*sizeof(float_complex));
+    utility_cseig_create(&(h->hEig), h->maxNSH);
+
+    /* Per-thread scratch, and the worker threads */
+    h->sliceStatus = malloc1d(h->nThreads*sizeof(int));
+    for(t=0; t<h->nThreads; t++)
+        h->sliceStatus[t] = PMAP_SLICE_TAG(0, PMAP_SLICE_CALLER);
+    h->slices = malloc1d(h->nThreads*sizeof(pmapEngine_slice));
+    for(t=0; t<h->nThreads; t++){
+        s = &(h->slices[t]);
+        s->hEngine = *phPM;
+        s->idx = t;
+        utility_cslslv_create(&(s->hSlv), h->maxNSH, MAX(h->maxSliceDirs, 2));
+        s->Ys = malloc1d(h->maxNSH*(h->maxSliceDirs)*sizeof(float_complex));
+        s->X = malloc1d(h->maxNSH*(h->maxSliceDirs)*sizeof(float_complex));
+        s->T = malloc1d(h->maxNSH*(h->maxSliceDirs)*sizeof(float_complex));
+        s->d = malloc1d(h->maxSliceDirs*sizeof(float_complex));
+        s->mvdr = malloc1d(h->maxSliceDirs*sizeof(float));
+        s->A = malloc1d(h->maxNSH*2*sizeof(float_complex));
+        s->invCxd_A = malloc1d(h->maxNSH*2*sizeof(float_complex));
+        s->hThread = s->hSemStart = NULL;
+        s->pmap = NULL;
+        if(t>0){
+            s->pmap = malloc1d(maxGridDirs*sizeof(float));
+            saf_semaphore_create(&(s->hSemStart));
+            saf_thread_create(&(s->hThread), saf_pmapEngine_worker, (void*)s);
+            assert(s->hThread!=NULL);
+        }
+    }
+}
+
+void saf_pmapEngine_destroy
+(
+    void ** const phPM
+)
+{
+    pmapEngine_data *h = (pmapEngine_data*)(*phPM);
+    pmapEngine_slice* s;
+    int t;
+
+    if (h != NULL) {
+        h->exitFLAG = 1;
+        for(t=1; t<h->nThreads; t++){
+            saf_semaphore_post(h->slices[t].hSemStart);
+            saf_thread_join(&(h->slices[t].hThread));
+            saf_semaphore_destroy(&(h->slices[t].hSemStart));
+        }
+        for(t=0; t<h->nThreads; t++){
+            s = &(h->slices[t]);
+            utility_cslslv_destroy(&(s->hSlv));
+            free(s->Ys);
+            free(s->X);
+            free(s->T);
+            free(s->d);
+            free(s->mvdr);
+            free(s->A);
+            free(s->invCxd_A);
+            free(s->pmap);
+        }
+        utility_cseig_destroy(&(h->hEig));
+        free(h->slices);
+        free((void*)h->sliceStatus);
+        free(h->Cx);
+        free(h->Cx_d);
+        free(h->V);
+        free(h->Un);
+        free(h);
+        h = NULL;
+        *phPM = NULL;
+    }
+}
+
+void saf_pmapEngine_generatePWDmap
+(
+    void * const hPM,
+    int order,
+    const float_complex* Cx,
+    const float_complex* Y_grid,
+    int nGrid_dirs,
+    float* pmap
+)
+{
+    pmapEngine_data *h = (pmapEngine_data*)(hPM);
+
+    assert(order<=h->maxOrder);
+    h->job.type = PMAP_ENGINE_PWD;
+    h->job.nSH = ORDER2NSH(order);
+    h->job.Y_grid = Y_grid;
+    h->job.nGrid_dirs = nGrid_dirs;
+    saf_pmapEngine_loadCx(h, Cx, -1.0f);
+    saf_pmapEngine_run(h, pmap, NULL);
+}
+
+void saf_pmapEngine_generateMVDRmap
+(
+    void * const hPM,
+    int order,
+    const float_complex* Cx,
+    const float_complex* Y_grid,
+    int nGrid_dirs,
+    float regPar,
+    float* pmap,
+    float_complex* w_MVDR
+)
+{
+    pmapEngine_data *h = (pmapEngine_data*)(hPM);
+
+    assert(order<=h->maxOrder);
+    h->job.type = PMAP_ENGINE_MVDR;
+    h->job.nSH = ORDER2NSH(order);
+    h->job.Y_grid = Y_grid;
+    h->job.nGrid_dirs = nGrid_dirs;
+    saf_pmapEngine_loadCx(h, Cx, regPar);
+    saf_pmapEngine_run(h, pmap, w_MVDR);
+}
+
+void saf_pmapEngine_generateCroPaCLCMVmap
+(
+    void * const hPM,
+    int order,
+    const float_complex* Cx,
+    const float_complex* Y_grid,
+    int nGrid_dirs,
+    float regPar,
+    float lambda,
+    float* pmap
+)
+{
+    pmapEngine_data *h = (pmapEngine_data*)(hPM);
+
+    assert(order<=h->maxOrder);
+    h->job.type = PMAP_ENGINE_CROPAC;
+    h->job.nSH = ORDER2NSH(order);
+    h->job.Y_grid = Y_grid;
+    h->job.nGrid_dirs = nGrid_dirs;
+    h->job.lambda = lambda;
+    saf_pmapEngine_loadCx(h, Cx, regPar);
+    saf_pmapEngine_run(h, pmap, NULL);
+}
+
+void saf_pmapEngine_generateMUSICmap
+(
+    void * const hPM,
+    int order,
+    const float_complex* Cx,
+    const float_complex* Y_grid,
+    int nSources,
+    int nGrid_dirs,
+    int logScaleFlag,
+    float* pmap
+)
+{
+    pmapEngine_data *h = (pmapEngine_data*)(hPM);
+
+    assert(order<=h->maxOrder);
+    h->job.type = PMAP_ENGINE_MUSIC;
+    h->job.nSH = ORDER2NSH(order);
+    h->job.nNoise = h->job.nSH - MIN(nSources, h->job.nSH/2);
+    h->job.Y_grid = Y_grid;
+    h->job.nGrid_dirs = nGrid_dirs;
+    h->job.logScaleFlag = logScaleFlag;
+
+    /* eigenvectors as contiguous columns, in ascending order (see
+     * generateMUSICmap()) */
+    utility_cseig_cm_ws(h->hEig, Cx, h->job.nSH, 0, h->V, NULL);
+    saf_pmapEngine_run(h, pmap, NULL);
+}
+
+void saf_pmapEngine_generateMinNormMap
+(
+    void * const hPM,
+    int order,
+    const float_complex* Cx,
+    const float_complex* Y_grid,
+    int nSources,
+    int nGrid_dirs,
+    int logScaleFlag,
+    float* pmap
+)
+{
+    pmapEngine_data *h = (pmapEngine_data*)(hPM);
+    int i, j, nSH;
+    float Vn1_Vn1H;
+
+    assert(order<=h->maxOrder);
+    h->job.type = PMAP_ENGINE_MINNORM;
+    h->job.nSH = nSH = ORDER2NSH(order);
+    h->job.nNoise = nSH - MIN(nSources, nSH/2);
+    h->job.Y_grid = Y_grid;
+    h->job.nGrid_dirs = nGrid_dirs;
+    h->job.logScaleFlag = logScaleFlag;
+
+    /* The first nNoise columns of 'V' are the conjugates of the noise
+     * sub-space eigenvectors, Vn (see generateMUSICmap()) */
+    utility_cseig_cm_ws(h->hEig, Cx, nSH, 0, h->V, NULL);
+
+    /* Un = Vn * Vn1^H / (Vn1 * Vn1^H), where Vn1 is the first row of Vn */
+    Vn1_Vn1H = 0.0f;
+    for(j=0; j<h->job.nNoise; j++)
+        Vn1_Vn1H += powf(cabsf(h->V[j*nSH]), 2.0f);
+    for(i=0; i<nSH; i++){
+        h->Un[i] = cmplxf(0.0f, 0.0f);
+        for(j=0; j<h->job.nNoise; j++)
+            h->Un[i] = ccaddf(h->Un[i], ccmulf(conjf(h->V[j*nSH+i]), h->V[j*nSH]));
+        h->Un[i] = crmulf(h->Un[i], 1.0f/(Vn1_Vn1H + 2.23e-9f));
+    }
+    saf_pmapEngine_run(h, pmap, NULL);
+}
+
 
 /* ========================================================================== */
 /*              Microphone/Hydrophone array processing functions              */
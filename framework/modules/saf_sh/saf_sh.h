@@ -49,6 +49,23 @@ extern "C" {
  * Converts number of spherical harmonic components to spherical harmonic order
  * i.e: sqrt(nSH)-1 */
 #define NSH2ORDER(nSH) ( (int)(sqrt((double)nSH)-0.999) )
+/**
+ * Number of elements required to store the diagonal blocks of a spherical
+ * harmonic rotation matrix (see getSHrotMtxRealBlocks())
+ * i.e: sum_{l=0}^{order} (2l+1)^2 */
+#define ORDER2NSHROT(order) ( ((order)+1)*(2*(order)+1)*(2*(order)+3)/3 )
+
+/**
+ * Minimum number of grid directions processed by each thread of the powermap
+ * engine (see saf_pmapEngine_create())
+ */
+#define SAF_PMAP_MIN_DIRS_PER_THREAD ( 128 )
+
+/**
+ * Maximum number of threads of the powermap engine (see
+ * saf_pmapEngine_create())
+ */
+#define SAF_PMAP_MAX_THREADS ( 128 )
 
 /* ========================================================================== */
 /*                                    Enums                                   */
@@ -107,6 +124,67 @@ void yawPitchRoll2Rzyx (/* Input Arguments */
                         /* Output Arguments */
                         float R[3][3]);
 
+/**
+ * Extracts the Euler angles from a 3x3 rotation matrix; i.e. the inverse of
+ * yawPitchRoll2Rzyx()
+ *
+ * @param[in]  R                zyx rotation matrix; 3 x 3
+ * @param[in]  rollPitchYawFLAG '1' if R was constructed as Rxyz, i.e. apply
+ *                              roll, pitch and then yaw, '0' Rzyx / y-p-r
+ * @param[out] yaw              (&) yaw angle in radians
+ * @param[out] pitch            (&) pitch angle in radians, [-pi/2, pi/2]
+ * @param[out] roll             (&) roll angle in radians
+ */
+void rotationMatrix2yawPitchRoll(/* Input Arguments */
+                                 float R[3][3],
+                                 int rollPitchYawFLAG,
+                                 /* Output Arguments */
+                                 float* yaw,
+                                 float* pitch,
+                                 float* roll);
+
+/**
+ * Constructs a 3x3 rotation matrix from a quaternion
+ *
+ * The quaternion need not be of unit length. Note that Q and -Q describe the
+ * same rotation.
+ *
+ * @param[in]  Q Quaternion; [w x y z]
+ * @param[out] R Rotation matrix; 3 x 3
+ */
+void quaternion2rotationMatrix(/* Input Arguments */
+                               float Q[4],
+                               /* Output Arguments */
+                               float R[3][3]);
+
+/**
+ * Converts a 3x3 rotation matrix to a unit quaternion; i.e. the inverse of
+ * quaternion2rotationMatrix()
+ *
+ * @param[in]  R Rotation matrix; 3 x 3
+ * @param[out] Q Unit quaternion; [w x y z]
+ */
+void rotationMatrix2quaternion(/* Input Arguments */
+                               float R[3][3],
+                               /* Output Arguments */
+                               float Q[4]);
+
+/**
+ * Spherical linear interpolation (slerp) between two unit quaternions, along
+ * the shortest path
+ *
+ * @param[in]  Q0 Unit quaternion at t=0; [w x y z]
+ * @param[in]  Q1 Unit quaternion at t=1; [w x y z]
+ * @param[in]  t  Interpolation point, [0 1]
+ * @param[out] Q  Interpolated unit quaternion; [w x y z]
+ */
+void quaternionSlerp(/* Input Arguments */
+                     float Q0[4],
+                     float Q1[4],
+                     float t,
+                     /* Output Arguments */
+                     float Q[4]);
+
 /**
  * Converts spherical coordinates to Cartesian coordinates of unit length
  *
@@ -265,6 +343,161 @@ void getSHreal_recur(/* Input Arguments */
                      /* Output Arguments */
                      float* Y);
 
+/**
+ * Creates an instance of a table-driven evaluator of REAL spherical harmonics,
+ * for orders up to 'maxOrder'
+ *
+ * All of the normalisation and recursion coefficients are precomputed upon
+ * creation, such that the evaluation involves no factorials, square-roots or
+ * memory allocations. Optionally (tableRes_deg>0), the spherical harmonics are
+ * also tabulated on a regular azimuth-inclination grid, with a spacing of
+ * approximately 'tableRes_deg' degrees, for use with
+ * saf_shEvaluator_getSHrealInterp(). (If 'tableRes_deg' does not divide 360
+ * and 180, then the spacings are adjusted, such that the grid spans exactly
+ * 0..360 degrees in azimuth and 0..180 degrees in inclination.)
+ *
+ * @note The evaluator holds its own scratch memory, and so a single instance
+ *       should not be used by multiple threads simultaneously.
+ *
+ * @param[in] phSHE        (&) address of SH evaluator handle
+ * @param[in] maxOrder     Maximum order of spherical harmonic expansion
+ * @param[in] tableRes_deg Resolution of the look-up table, in DEGREES; set to
+ *                         <=0 to not create the table
+ */
+void saf_shEvaluator_create(/* Input Arguments */
+                            void ** const phSHE,
+                            int maxOrder,
+                            float tableRes_deg);
+
+/**
+ * Destroys an instance of the SH evaluator
+ *
+ * @param[in] phSHE (&) address of SH evaluator handle
+ */
+void saf_shEvaluator_destroy(/* Input Arguments */
+                             void ** const phSHE);
+
+/**
+ * Computes REAL spherical harmonics for each given direction on the unit
+ * sphere, using the precomputed coefficients of the SH evaluator
+ *
+ * The output is identical to that of getSHreal_recur() (up to numerical
+ * precision). The associated Legendre functions are evaluated for blocks of
+ * directions at a time, with the recursions running across the directions
+ * (such that they may be vectorised), and the azimuthal terms are obtained
+ * via the angle-addition recursion, rather than with trigonometric functions.
+ *
+ * @warning This function assumes [azi, inclination] convention! Note that one
+ *          may convert from elevation, with: [azi, pi/2-elev].
+ *
+ * @test test__saf_shEvaluator()
+ *
+ * @param[in]  hSHE     SH evaluator handle
+ * @param[in]  order    Order of spherical harmonic expansion (<= maxOrder)
+ * @param[in]  dirs_rad Directions on the sphere [azi, INCLINATION] convention,
+ *                      in RADIANS; FLAT: nDirs x 2
+ * @param[in]  nDirs    Number of directions
+ * @param[out] Y        The SH weights [WITH the 1/sqrt(4*pi)];
+ *                      FLAT: (order+1)^2 x nDirs
+ */
+void saf_shEvaluator_getSHreal(/* Input Arguments */
+                               void * const hSHE,
+                               int order,
+                               float* dirs_rad,
+                               int nDirs,
+                               /* Output Arguments */
+                               float* Y);
+
+/**
+ * Computes (approximate) REAL spherical harmonics for each given direction on
+ * the unit sphere, by bilinear interpolation of the SH evaluator's look-up
+ * table
+ *
+ * This is intended for use cases where many (e.g. moving) directions must be
+ * evaluated at high rates, and where a small interpolation error is tolerable.
+ * If the evaluator was created without a table, then this function reverts to
+ * saf_shEvaluator_getSHreal().
+ *
+ * @warning This function assumes [azi, inclination] convention! Note that one
+ *          may convert from elevation, with: [azi, pi/2-elev].
+ *
+ * @test test__saf_shEvaluator()
+ *
+ * @param[in]  hSHE     SH evaluator handle
+ * @param[in]  order    Order of spherical harmonic expansion (<= maxOrder)
+ * @param[in]  dirs_rad Directions on the sphere [azi, INCLINATION] convention,
+ *                      in RADIANS; FLAT: nDirs x 2
+ * @param[in]  nDirs    Number of directions
+ * @param[out] Y        The SH weights [WITH the 1/sqrt(4*pi)];
+ *                      FLAT: (order+1)^2 x nDirs
+ */
+void saf_shEvaluator_getSHrealInterp(/* Input Arguments */
+                                     void * const hSHE,
+                                     int order,
+                                     float* dirs_rad,
+                                     int nDirs,
+                                     /* Output Arguments */
+                                     float* Y);
+
+/**
+ * Returns a shared, read-only, matrix of REAL spherical harmonics for a grid of
+ * directions, from a process-wide registry of such matrices
+ *
+ * The registry is keyed by the grid directions (compared by value), the order,
+ * and the scaling; i.e. analysis instances which employ the same scanning grid
+ * share one matrix, which is only computed by the first of them. The matrix is
+ * computed as getRSH() (ACN/N3D, WITHOUT the 1/sqrt(4*pi) term) multiplied by
+ * 'scale'. Each acquired matrix must be returned with
+ * saf_shGridCache_release(), and it is freed once it is no longer in use.
+ *
+ * @note This function may be called by several threads at once, but not from
+ *       a real-time thread, since it may compute and allocate the matrix.
+ *
+ * @test test__saf_shGridCache()
+ *
+ * @param[in] order         Order of spherical harmonic expansion
+ * @param[in] grid_dirs_deg Grid directions [azi elev] in DEGREES;
+ *                          FLAT: nDirs x 2
+ * @param[in] nDirs         Number of grid directions
+ * @param[in] scale         Scaling applied to the N3D spherical harmonics
+ * @returns The shared SH matrix; FLAT: (order+1)^2 x nDirs
+ */
+const float* saf_shGridCache_acquireReal(/* Input Arguments */
+                                         int order,
+                                         const float* grid_dirs_deg,
+                                         int nDirs,
+                                         float scale);
+
+/**
+ * Returns a shared, read-only, COMPLEX-valued (zero imaginary part) copy of the
+ * matrix described in saf_shGridCache_acquireReal()
+ *
+ * The real and complex variants are registered separately.
+ *
+ * @test test__saf_shGridCache()
+ *
+ * @param[in] order         Order of spherical harmonic expansion
+ * @param[in] grid_dirs_deg Grid directions [azi elev] in DEGREES;
+ *                          FLAT: nDirs x 2
+ * @param[in] nDirs         Number of grid directions
+ * @param[in] scale         Scaling applied to the N3D spherical harmonics
+ * @returns The shared SH matrix; FLAT: (order+1)^2 x nDirs
+ */
+const float_complex* saf_shGridCache_acquireCmplx(/* Input Arguments */
+                                                  int order,
+                                                  const float* grid_dirs_deg,
+                                                  int nDirs,
+                                                  float scale);
+
+/**
+ * Returns a matrix acquired with saf_shGridCache_acquireReal() or
+ * saf_shGridCache_acquireCmplx() to the registry (NULL is ignored)
+ *
+ * @param[in] Y The shared SH matrix
+ */
+void saf_shGridCache_release(/* Input Arguments */
+                             const void* Y);
+
 /**
  * Computes COMPLEX spherical harmonics [1] for each given direction on the unit
  * sphere
@@ -381,6 +614,131 @@ void getSHrotMtxReal(float R[3][3],
                      float* RotMtx,
                      int L);
 
+/**
+ * Generates only the non-zero (block-diagonal) part of the real-valued
+ * spherical harmonic rotation matrix [1]
+ *
+ * The block of band 'l' is the (2l+1) x (2l+1) matrix which rotates the SH
+ * components of order l (i.e. ACN channels l^2 to (l+1)^2-1), and it starts at
+ * RotBlocks[ORDER2NSHROT(l-1)]. The blocks are identical to the corresponding
+ * blocks of getSHrotMtxReal(), but no other memory is required (or touched),
+ * since the recursion for band 'l' is computed directly from the stored block
+ * of band l-1.
+ *
+ * @test test__getSHrotMtxRealBlocks()
+ *
+ * @param[in]  R         zyx rotation matrix; 3 x 3
+ * @param[in]  L         Order of spherical harmonic expansion
+ * @param[out] RotBlocks The diagonal blocks, stored one after another;
+ *                       FLAT: ORDER2NSHROT(L) x 1
+ *
+ * @see [1] Ivanic, J., Ruedenberg, K. (1998). Rotation Matrices for Real
+ *          Spherical Harmonics. Direct Determination by Recursion Page:
+ *          Additions and Corrections. Journal of Physical Chemistry A, 102(45),
+ *          9099?9100.
+ */
+void getSHrotMtxRealBlocks(float R[3][3],
+                           float* RotBlocks,
+                           int L);
+
+/**
+ * Multiplies real-valued SH signals by a block-diagonal SH matrix, Y = A X,
+ * where A is stored as its diagonal blocks (see getSHrotMtxRealBlocks())
+ *
+ * Only the (2l+1) x (2l+1) blocks are multiplied, i.e. the SH components of
+ * each order are only combined with those of the same order. This is the case
+ * for SH rotations, and for any order-dependent weighting.
+ *
+ * @test test__applySHblockMtx()
+ *
+ * @param[in]  A     The diagonal blocks of A; FLAT: ORDER2NSHROT(order) x 1
+ * @param[in]  order Order of spherical harmonic expansion
+ * @param[in]  X     Input signals (ACN); FLAT: (order+1)^2 x ldX
+ * @param[in]  ldX   Distance between the rows of X, in samples
+ * @param[in]  nCols Number of samples (columns) to process
+ * @param[out] Y     Output signals (ACN), which must not overlap with X;
+ *                   FLAT: (order+1)^2 x ldY
+ * @param[in]  ldY   Distance between the rows of Y, in samples
+ */
+void applySHblockMtx(/* Input Arguments */
+                     const float* A,
+                     int order,
+                     const float* X,
+                     int ldX,
+                     int nCols,
+                     /* Output Arguments */
+                     float* Y,
+                     /* Input Arguments */
+                     int ldY);
+
+/**
+ * Multiplies complex-valued SH signals (e.g. time-frequency domain signals) by
+ * a real-valued block-diagonal SH matrix, Y[b] = A X[b], for b=0..nBatch-1
+ *
+ * The real and imaginary parts are rotated/weighted together, hence, this is
+ * half as costly as applying the complex version of A with
+ * applySHblockMtxCmplx().
+ *
+ * @test test__applySHblockMtx()
+ *
+ * @param[in]  A            The diagonal blocks of A; FLAT: ORDER2NSHROT(order) x 1
+ * @param[in]  order        Order of spherical harmonic expansion
+ * @param[in]  X            Input signals (ACN); FLAT: nBatch x (order+1)^2 x ldX
+ * @param[in]  ldX          Distance between the rows of X
+ * @param[in]  batchStrideX Distance between the matrices X[b]
+ * @param[in]  nCols        Number of columns (e.g. time slots) to process
+ * @param[in]  nBatch       Number of matrices (e.g. frequency bands)
+ * @param[out] Y            Output signals (ACN), which must not overlap with X;
+ *                          FLAT: nBatch x (order+1)^2 x ldY
+ * @param[in]  ldY          Distance between the rows of Y
+ * @param[in]  batchStrideY Distance between the matrices Y[b]
+ */
+void applySHblockMtxToCmplx(/* Input Arguments */
+                            const float* A,
+                            int order,
+                            const float_complex* X,
+                            int ldX,
+                            int batchStrideX,
+                            int nCols,
+                            int nBatch,
+                            /* Output Arguments */
+                            float_complex* Y,
+                            /* Input Arguments */
+                            int ldY,
+                            int batchStrideY);
+
+/**
+ * Multiplies complex-valued SH signals by a complex-valued block-diagonal SH
+ * matrix, Y[b] = A X[b], for b=0..nBatch-1 (see applySHblockMtxToCmplx())
+ *
+ * @test test__applySHblockMtx()
+ *
+ * @param[in]  A            The diagonal blocks of A; FLAT: ORDER2NSHROT(order) x 1
+ * @param[in]  order        Order of spherical harmonic expansion
+ * @param[in]  X            Input signals (ACN); FLAT: nBatch x (order+1)^2 x ldX
+ * @param[in]  ldX          Distance between the rows of X
+ * @param[in]  batchStrideX Distance between the matrices X[b]
+ * @param[in]  nCols        Number of columns (e.g. time slots) to process
+ * @param[in]  nBatch       Number of matrices (e.g. frequency bands)
+ * @param[out] Y            Output signals (ACN), which must not overlap with X;
+ *                          FLAT: nBatch x (order+1)^2 x ldY
+ * @param[in]  ldY          Distance between the rows of Y
+ * @param[in]  batchStrideY Distance between the matrices Y[b]
+ */
+void applySHblockMtxCmplx(/* Input Arguments */
+                          const float_complex* A,
+                          int order,
+                          const float_complex* X,
+                          int ldX,
+                          int batchStrideX,
+                          int nCols,
+                          int nBatch,
+                          /* Output Arguments */
+                          float_complex* Y,
+                          /* Input Arguments */
+                          int ldY,
+                          int batchStrideY);
+
 /**
  * Computes the matrices which generate the coefficients of a beampattern of
  * order (sectorOrder+1) that is essentially the product of a pattern of
@@ -845,6 +1203,194 @@ void generateMinNormMap(/* Input arguments */
                         /* Output arguments */
                         float* pmap);
 
+/**
+ * Creates an instance of the powermap engine, which computes the same maps as
+ * generatePWDmap(), generateMVDRmap(), generateCroPaCLCMVmap(),
+ * generateMUSICmap() and generateMinNormMap(), but without allocating memory
+ *
+ * All of the scratch memory (and the linear algebra workspaces) are allocated
+ * here, for up to 'maxOrder' and 'maxGridDirs'. The grid directions are split
+ * into contiguous slices, which are processed in parallel by 'nThreads'
+ * threads (the calling thread, plus nThreads-1 worker threads owned by the
+ * engine); although, each thread is given at least
+ * SAF_PMAP_MIN_DIRS_PER_THREAD directions, so sparse grids are processed by
+ * fewer threads.
+ *
+ * The calling thread never waits for the worker threads, so the engine may be
+ * used on a real-time thread: the workers only help with the slices which the
+ * calling thread has not started yet, and a slice which a worker has not
+ * finished by the time the calling thread is done with its own is taken back
+ * and processed by the calling thread itself. The accepted trade-offs are:
+ *  - each call posts (but never waits on) one semaphore per worker thread;
+ *  - if the workers are not scheduled in time, then slices may be processed
+ *    twice, so the speed-up depends on the workers getting CPU time;
+ *  - MVDR maps for which the beamforming weights are requested are computed by
+ *    the calling thread alone;
+ *  - a worker which was preempted may still be reading 'Y_grid' after a call
+ *    has returned, so it must remain allocated (and unchanged) for as long as
+ *    the engine exists.
+ *
+ * @param[in] phPM        (&) address of powermap engine handle
+ * @param[in] maxOrder    Maximum analysis order
+ * @param[in] maxGridDirs Maximum number of grid directions
+ * @param[in] nThreads    Number of threads to split the grid over
+ *                        (1..SAF_PMAP_MAX_THREADS)
+ */
+void saf_pmapEngine_create(/* Input Arguments */
+                           void ** const phPM,
+                           int maxOrder,
+                           int maxGridDirs,
+                           int nThreads);
+
+/**
+ * Destroys an instance of the powermap engine (and joins its worker threads)
+ *
+ * @param[in] phPM (&) address of powermap engine handle
+ */
+void saf_pmapEngine_destroy(/* Input Arguments */
+                            void ** const phPM);
+
+/**
+ * Allocation-free equivalent of generatePWDmap()
+ *
+ * @test test__saf_pmapEngine()
+ *
+ * @param[in]  hPM        powermap engine handle
+ * @param[in]  order      Analysis order (<= maxOrder)
+ * @param[in]  Cx         Correlation/covarience matrix;
+ *                        FLAT: (order+1)^2 x (order+1)^2
+ * @param[in]  Y_grid     Steering vectors for each grid direcionts;
+ *                        FLAT: (order+1)^2 x nGrid_dirs
+ * @param[in]  nGrid_dirs Number of grid directions (<= maxGridDirs)
+ * @param[out] pmap       Resulting PWD powermap; nGrid_dirs x 1
+ */
+void saf_pmapEngine_generatePWDmap(/* Input arguments */
+                                   void * const hPM,
+                                   int order,
+                                   const float_complex* Cx,
+                                   const float_complex* Y_grid,
+                                   int nGrid_dirs,
+                                   /* Output arguments */
+                                   float* pmap);
+
+/**
+ * Allocation-free equivalent of generateMVDRmap()
+ *
+ * The MVDR denominators, Y^T Cx^-1 Y, are only required for the diagonal, and
+ * so they are accumulated directly (row-by-row over all directions of a slice)
+ * rather than with a dot-product per direction.
+ *
+ * @test test__saf_pmapEngine()
+ *
+ * @param[in]  hPM        powermap engine handle
+ * @param[in]  order      Analysis order (<= maxOrder)
+ * @param[in]  Cx         Correlation/covarience matrix;
+ *                        FLAT: (order+1)^2 x (order+1)^2
+ * @param[in]  Y_grid     Steering vectors for each grid direcionts;
+ *                        FLAT: (order+1)^2 x nGrid_dirs
+ * @param[in]  nGrid_dirs Number of grid directions (<= maxGridDirs)
+ * @param[in]  regPar     Regularisation parameter, for diagonal loading of Cx
+ * @param[out] pmap       Resulting MVDR powermap; nGrid_dirs x 1
+ * @param[out] w_MVDR     (Optional) weights will be copied to this, unless
+ *                        it's NULL; FLAT: (order+1)^2 x nGrid_dirs || NULL
+ */
+void saf_pmapEngine_generateMVDRmap(/* Input arguments */
+                                    void * const hPM,
+                                    int order,
+                                    const float_complex* Cx,
+                                    const float_complex* Y_grid,
+                                    int nGrid_dirs,
+                                    float regPar,
+                                    /* Output arguments */
+                                    float* pmap,
+                                    float_complex* w_MVDR);
+
+/**
+ * Allocation-free equivalent of generateCroPaCLCMVmap()
+ *
+ * @test test__saf_pmapEngine()
+ *
+ * @param[in]  hPM        powermap engine handle
+ * @param[in]  order      Analysis order (<= maxOrder)
+ * @param[in]  Cx         Correlation/covarience matrix;
+ *                        FLAT: (order+1)^2 x (order+1)^2
+ * @param[in]  Y_grid     Steering vectors for each grid direcionts;
+ *                        FLAT: (order+1)^2 x nGrid_dirs
+ * @param[in]  nGrid_dirs Number of grid directions (<= maxGridDirs)
+ * @param[in]  regPar     Regularisation parameter, for diagonal loading of Cx
+ * @param[in]  lambda     Parameter controlling how harsh CroPaC is applied,
+ *                        0..1; 0: fully CroPaC, 1: fully MVDR
+ * @param[out] pmap       Resulting CroPaC LCMV powermap; nGrid_dirs x 1
+ */
+void saf_pmapEngine_generateCroPaCLCMVmap(/* Input arguments */
+                                          void * const hPM,
+                                          int order,
+                                          const float_complex* Cx,
+                                          const float_complex* Y_grid,
+                                          int nGrid_dirs,
+                                          float regPar,
+                                          float lambda,
+                                          /* Output arguments */
+                                          float* pmap);
+
+/**
+ * Allocation-free equivalent of generateMUSICmap()
+ *
+ * @test test__saf_pmapEngine()
+ *
+ * @param[in]  hPM          powermap engine handle
+ * @param[in]  order        Analysis order (<= maxOrder)
+ * @param[in]  Cx           Correlation/covarience matrix;
+ *                          FLAT: (order+1)^2 x (order+1)^2
+ * @param[in]  Y_grid       Steering vectors for each grid direcionts;
+ *                          FLAT: (order+1)^2 x nGrid_dirs
+ * @param[in]  nSources     Number of sources present in sound scene
+ * @param[in]  nGrid_dirs   Number of grid directions (<= maxGridDirs)
+ * @param[in]  logScaleFlag '1' log(pmap), '0' pmap.
+ * @param[out] pmap         Resulting MUSIC pseudo-spectrum; nGrid_dirs x 1
+ */
+void saf_pmapEngine_generateMUSICmap(/* Input arguments */
+                                     void * const hPM,
+                                     int order,
+                                     const float_complex* Cx,
+                                     const float_complex* Y_grid,
+                                     int nSources,
+                                     int nGrid_dirs,
+                                     int logScaleFlag,
+                                     /* Output arguments */
+                                     float* pmap);
+
+/**
+ * Allocation-free equivalent of generateMinNormMap()
+ *
+ * Since Cx is Hermitian, the noise sub-space is obtained with the Hermitian
+ * eigen-solver (as in generateMUSICmap()), and the normalisation is by the
+ * squared magnitude of the first noise sub-space row.
+ *
+ * @test test__saf_pmapEngine()
+ *
+ * @param[in]  hPM          powermap engine handle
+ * @param[in]  order        Analysis order (<= maxOrder)
+ * @param[in]  Cx           Correlation/covarience matrix;
+ *                          FLAT: (order+1)^2 x (order+1)^2
+ * @param[in]  Y_grid       Steering vectors for each grid direcionts;
+ *                          FLAT: (order+1)^2 x nGrid_dirs
+ * @param[in]  nSources     Number of sources present in sound scene
+ * @param[in]  nGrid_dirs   Number of grid directions (<= maxGridDirs)
+ * @param[in]  logScaleFlag '1' log(pmap), '0' pmap.
+ * @param[out] pmap         Resulting MinNorm pseudo-spectrum; nGrid_dirs x 1
+ */
+void saf_pmapEngine_generateMinNormMap(/* Input arguments */
+                                       void * const hPM,
+                                       int order,
+                                       const float_complex* Cx,
+                                       const float_complex* Y_grid,
+                                       int nSources,
+                                       int nGrid_dirs,
+                                       int logScaleFlag,
+                                       /* Output arguments */
+                                       float* pmap);
+
 
 /* ========================================================================== */
 /*              Microphone/Hydrophone array processing functions              */
@@ -150,23 +150,25 @@ float getP
     int l,
     int a,
     int b,
-    float** R_1,
-    float** R_lm1
+    float R_1[3][3],
+    float* R_lm1
 )
 {
     float ret, ri1, rim1, ri0;
+    float* R_lm1_a;
     
     ri1 = R_1[i + 1][1 + 1];
     rim1 = R_1[i + 1][-1 + 1];
     ri0 = R_1[i + 1][0 + 1];
+    R_lm1_a = &R_lm1[(a + l - 1)*(2 * l - 1)]; /* row 'a' of the previous band */
     
     if (b == -l)
-        ret = ri1 * R_lm1[a + l - 1][0] + rim1 * R_lm1[a + l - 1][2 * l - 2];
+        ret = ri1 * R_lm1_a[0] + rim1 * R_lm1_a[2 * l - 2];
     else {
         if (b == l)
-            ret = ri1*R_lm1[a + l - 1][2 * l - 2] - rim1 * R_lm1[a + l - 1][0];
+            ret = ri1*R_lm1_a[2 * l - 2] - rim1 * R_lm1_a[0];
         else
-            ret = ri0 * R_lm1[a + l - 1][b + l - 1];
+            ret = ri0 * R_lm1_a[b + l - 1];
     }
     
     return ret;
@@ -179,8 +181,8 @@ float getU
     int l,
     int m,
     int n,
-    float** R_1,
-    float** R_lm1
+    float R_1[3][3],
+    float* R_lm1
 )
 {
     return getP(0, l, m, n, R_1, R_lm1);
@@ -193,8 +195,8 @@ float getV
     int l,
     int m,
     int n,
-    float** R_1,
-    float** R_lm1
+    float R_1[3][3],
+    float* R_lm1
 )
 {
     int d;
@@ -230,8 +232,8 @@ float getW
     int l,
     int m,
     int n,
-    float** R_1,
-    float** R_lm1
+    float R_1[3][3],
+    float* R_lm1
 )
 {
     float ret, p0, p1;
@@ -94,33 +94,169 @@ void gaunt_mtx(/* Input arguments */
 
 
 /* ========================================================================== */
-/*             Internal functions for spherical harmonic rotations            */
+/*                        Internal SH evaluator structure                     */
 /* ========================================================================== */
 
-/**
- * Helper function for getSHrotMtxReal()
- */
-float getP(int i, int l, int a, int b, float** R_1, float** R_lm1);
+/** Number of directions evaluated at a time by saf_shEvaluator_getSHreal() */
+#define SH_EVALUATOR_BLOCK_SIZE ( 64 )
+
+/** Main structure for the table-driven SH evaluator */
+typedef struct _shEvaluator_data {
+    int maxOrder;       /**< Maximum order of spherical harmonic expansion */
+    int nSH;            /**< Number of SH components; (maxOrder+1)^2 */
+    float* a_nm;        /**< Legendre recursion coefficients;
+                         *   FLAT: (maxOrder+1) x (maxOrder+1) */
+    float* b_nm;        /**< Legendre recursion coefficients;
+                         *   FLAT: (maxOrder+1) x (maxOrder+1) */
+    float* c_m;         /**< Diagonal recursion coefficients; (maxOrder+1) x 1 */
+    float* K_m;         /**< Normalisation per degree; (maxOrder+1) x 1 */
+
+    /* scratch (one block of directions) */
+    float cosIncl[SH_EVALUATOR_BLOCK_SIZE];  /**< cos(inclination) */
+    float sinIncl[SH_EVALUATOR_BLOCK_SIZE];  /**< sin(inclination) */
+    float cosAzi[SH_EVALUATOR_BLOCK_SIZE];   /**< cos(azimuth) */
+    float sinAzi[SH_EVALUATOR_BLOCK_SIZE];   /**< sin(azimuth) */
+    float cosmAzi[SH_EVALUATOR_BLOCK_SIZE];  /**< cos(m*azimuth) */
+    float sinmAzi[SH_EVALUATOR_BLOCK_SIZE];  /**< sin(m*azimuth) */
+    float P_mm[SH_EVALUATOR_BLOCK_SIZE];     /**< Legendre values, n=m */
+    float P_n1[SH_EVALUATOR_BLOCK_SIZE];     /**< Legendre values, n-1 */
+    float P_n2[SH_EVALUATOR_BLOCK_SIZE];     /**< Legendre values, n-2 */
+
+    /* optional look-up table */
+    float tableAziRes_rad;  /**< Table azimuth spacing, in radians; 0: no table */
+    float tableInclRes_rad; /**< Table inclination spacing, in radians */
+    int nTableAzi;      /**< Number of azimuths in the table (wrapping) */
+    int nTableIncl;     /**< Number of inclinations in the table (0..pi) */
+    float* table;       /**< SH look-up table;
+                         *   FLAT: nTableIncl x nTableAzi x nSH */
+
+}shEvaluator_data;
+
+
+/** An entry of the process-wide registry of grid SH matrices (linked-list) */
+typedef struct _shGridCache_entry {
+    int order;              /**< Order of spherical harmonic expansion */
+    int nDirs;              /**< Number of grid directions */
+    int isComplex;          /**< '1' complex-valued, '0' real-valued */
+    float scale;            /**< Scaling applied to the N3D harmonics */
+    float* grid_dirs_deg;   /**< Copy of the grid directions; FLAT: nDirs x 2 */
+    void* Y;                /**< SH matrix; FLAT: (order+1)^2 x nDirs */
+    int refCount;           /**< Number of users of this entry */
+    struct _shGridCache_entry* next; /**< Next entry */
+
+}shGridCache_entry;
+
+
+/* ========================================================================== */
+/*                       Internal powermap engine structures                  */
+/* ========================================================================== */
+
+/** Powermap types computed by the powermap engine */
+typedef enum _PMAP_ENGINE_TYPES {
+    PMAP_ENGINE_PWD,        /**< Plane-wave decomposition */
+    PMAP_ENGINE_MVDR,       /**< Minimum-variance distortion-less response */
+    PMAP_ENGINE_CROPAC,     /**< Cross-pattern coherence (LCMV) */
+    PMAP_ENGINE_MUSIC,      /**< Multiple signal classification */
+    PMAP_ENGINE_MINNORM     /**< Minimum-norm */
+
+}PMAP_ENGINE_TYPES;
+
+/** Status of a slice of the current job (see PMAP_SLICE_TAG()) */
+#define PMAP_SLICE_FREE       ( 0 )          /**< Not started yet */
+#define PMAP_SLICE_CALLER     ( 1 )          /**< Processed by the calling thread */
+#define PMAP_SLICE_CLAIMED(w) ( 2*(w) )      /**< Being processed by worker w */
+#define PMAP_SLICE_DONE(w)    ( 2*(w)+1 )    /**< Processed by worker w */
+/** Slice status tagged with the generation of its job, such that the stale
+ *  claims of a worker which is still busy with a previous job always fail
+ *  (the status takes the lower 8 bits; see SAF_PMAP_MAX_THREADS) */
+#define PMAP_SLICE_TAG(gen, status) ( ((gen)<<8) | (status) )
+/** Generations wrap around after this many jobs */
+#define PMAP_ENGINE_GEN_MASK ( 0x7FFFFF )
+
+/** A job of the powermap engine */
+typedef struct _pmapEngine_job {
+    PMAP_ENGINE_TYPES type; /**< Powermap type */
+    int nSH;                /**< (order+1)^2 */
+    int nNoise;             /**< Dimension of the noise sub-space */
+    int nGrid_dirs;         /**< Number of grid directions */
+    int nSlices;            /**< Number of slices the grid is split into */
+    int sliceLen;           /**< Number of directions per slice */
+    int logScaleFlag;       /**< '1' log(pmap), '0' pmap */
+    float lambda;           /**< CroPaC spectral floor */
+    const float_complex* Y_grid; /**< Steering vectors */
+
+}pmapEngine_job;
+
+/** Per-thread data of the powermap engine */
+typedef struct _pmapEngine_slice {
+    void* hEngine;          /**< Parent powermap engine */
+    int idx;                /**< Thread index (0 is the calling thread) */
+    void* hThread;          /**< Worker thread (NULL for the calling thread) */
+    void* hSemStart;        /**< Signalled when there is a new job */
+    float* pmap;            /**< Map of the slices processed by this worker,
+                             *   which the calling thread copies once they are
+                             *   done (NULL for the calling thread);
+                             *   maxGridDirs x 1 */
+    void* hSlv;             /**< Linear solver workspace */
+    float_complex* Ys;      /**< Steering vectors of the slice;
+                             *   FLAT: maxNSH x maxSliceDirs */
+    float_complex* X;       /**< Solutions/weights; FLAT: maxNSH x maxSliceDirs */
+    float_complex* T;       /**< Cx times Ys or X; FLAT: maxNSH x maxSliceDirs */
+    float_complex* d;       /**< Per-direction denominators; maxSliceDirs x 1 */
+    float* mvdr;            /**< MVDR map of the slice; maxSliceDirs x 1 */
+    float_complex* A;       /**< CroPaC constraints; FLAT: maxNSH x 2 */
+    float_complex* invCxd_A;/**< CroPaC solution; FLAT: maxNSH x 2 */
+
+}pmapEngine_slice;
+
+/** Main structure for the powermap engine */
+typedef struct _pmapEngine_data {
+    int maxOrder;           /**< Maximum analysis order */
+    int maxNSH;             /**< (maxOrder+1)^2 */
+    int maxGridDirs;        /**< Maximum number of grid directions */
+    int maxSliceDirs;       /**< Maximum number of directions per slice */
+    int nThreads;           /**< Number of threads (including the caller) */
+    pmapEngine_slice* slices; /**< One per thread; nThreads x 1 */
+    volatile int exitFLAG;  /**< '1': worker threads should return */
+    volatile int gen;       /**< Generation of the current job */
+    volatile int* sliceStatus; /**< Tagged status of each slice (see
+                                *   PMAP_SLICE_TAG()); nThreads x 1 */
+    pmapEngine_job job;     /**< Current job (set by the calling thread before
+                             *   its slices are opened) */
+    void* hEig;             /**< Hermitian eigen-solver workspace */
+    float_complex* Cx;      /**< Copy of Cx; FLAT: maxNSH x maxNSH */
+    float_complex* Cx_d;    /**< Diagonally loaded Cx; FLAT: maxNSH x maxNSH */
+    float_complex* V;       /**< Eigenvectors (column-major);
+                             *   FLAT: maxNSH x maxNSH */
+    float_complex* Un;      /**< MinNorm vector; maxNSH x 1 */
+
+}pmapEngine_data;
+
+
+/* ========================================================================== */
+/*             Internal functions for spherical harmonic rotations            */
+/* ========================================================================== */
 
 /**
- * Helper function for getSHrotMtxReal()
+ * Helper function for getSHrotMtxRealBlocks(); 'R_1' is the band l=1 rotation
+ * matrix, and 'R_lm1' is that of band l-1; FLAT: (2l-1) x (2l-1)
  */
-float getU(int l, int m, int n, float** R_1, float** R_lm1);
+float getP(int i, int l, int a, int b, float R_1[3][3], float* R_lm1);
 
 /**
- * Helper function for getSHrotMtxReal()
+ * Helper function for getSHrotMtxRealBlocks()
  */
-float getV(int l, int m, int n, float** R_1, float** R_lm1);
+float getU(int l, int m, int n, float R_1[3][3], float* R_lm1);
 
 /**
- * Helper function for getSHrotMtxReal()
+ * Helper function for getSHrotMtxRealBlocks()
  */
-float getW(int l, int m, int n, float** R_1, float** R_lm1);
+float getV(int l, int m, int n, float R_1[3][3], float* R_lm1);
 
 /**
- * Helper function for getSHrotMtxReal()
+ * Helper function for getSHrotMtxRealBlocks()
  */
-float getW(int l, int m, int n, float** R_1, float** R_lm1);
+float getW(int l, int m, int n, float R_1[3][3], float* R_lm1);
 
 
 #ifdef __cplusplus
@@ -180,8 +180,12 @@
 #include "saf_utility_bessel.h"
 /* Optimised FFT routines */
 #include "saf_utility_fft.h"
+/* Threads, semaphores, atomics and lock-free ring buffers */
+#include "saf_utility_threads.h"
 /* Matrix convolver */
 #include "saf_utility_matrixConv.h"
+/* Adaptor for driving frame-based processing with arbitrary block sizes */
+#include "saf_utility_blockAdaptor.h"
 /* Pitch shifting algorithms */
 #include "saf_utility_pitch.h"
 /* For decorrelators */
@@ -0,0 +1,273 @@
+/*
+ * Copyright 2020 Leo McCormack
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * @file saf_utility_blockAdaptor.c
+ * @ingroup Utilities
+ * @brief A block-size adaptor, which allows frame-based processing functions
+ *        to be driven with arbitrary host block sizes
+ *
+ * @author Leo McCormack
+ * @date 16.10.2020
+ */
+
+#include "saf_utilities.h"
+#include "saf_utility_blockAdaptor.h"
+
+/** Main structure for the block-size adaptor */
+typedef struct _safBlockAdaptor_data {
+    int frameSize;      /**< Frame size expected by the processing function */
+    int maxInputs;      /**< Maximum number of input channels */
+    int maxOutputs;     /**< Maximum number of output channels */
+    int fifoMode;       /**< '0' direct mode, '1' FIFO mode */
+    int FIFO_idx;       /**< Current position in the FIFOs */
+    float** inFIFO;     /**< Input FIFO; maxInputs x frameSize */
+    float** outFIFO;    /**< Output FIFO; maxOutputs x frameSize */
+    float** inPtrs;     /**< Frame pointers into the inputs; maxInputs x 1 */
+    float** outPtrs;    /**< Frame pointers into the outputs; maxOutputs x 1 */
+
+}safBlockAdaptor_data;
+
+/** Copies 'len' samples of 'nCh' strided channels into planar buffers */
+static void saf_blockAdaptor_gather
+(
+    const float* src,
+    int chStride,
+    int smpStride,
+    float** dst,
+    int dstOffset,
+    int nCh,
+    int len
+)
+{
+    int ch, i;
+
+    if(smpStride==1){
+        for(ch=0; ch<nCh; ch++)
+            memcpy(&dst[ch][dstOffset], &src[ch*chStride], len*sizeof(float));
+    }
+    else{
+        /* Sample-major, such that interleaved data is read sequentially */
+        for(i=0; i<len; i++)
+            for(ch=0; ch<nCh; ch++)
+                dst[ch][dstOffset+i] = src[i*smpStride + ch*chStride];
+    }
+}
+
+/** Copies 'len' samples of 'nCh' planar buffers into strided channels */
+static void saf_blockAdaptor_scatter
+(
+    float** src,
+    int srcOffset,
+    float* dst,
+    int chStride,
+    int smpStride,
+    int nCh,
+    int len
+)
+{
+    int ch, i;
+
+    if(smpStride==1){
+        for(ch=0; ch<nCh; ch++)
+            memcpy(&dst[ch*chStride], &src[ch][srcOffset], len*sizeof(float));
+    }
+    else{
+        for(i=0; i<len; i++)
+            for(ch=0; ch<nCh; ch++)
+                dst[i*smpStride + ch*chStride] = src[ch][srcOffset+i];
+    }
+}
+
+void saf_blockAdaptor_create
+(
+    void ** const phBA,
+    int frameSize,
+    int maxInputs,
+    int maxOutputs
+)
+{
+    *phBA = malloc1d(sizeof(safBlockAdaptor_data));
+    safBlockAdaptor_data *h = (safBlockAdaptor_data*)(*phBA);
+
+    h->frameSize = frameSize;
+    h->maxInputs = maxInputs;
+    h->maxOutputs = maxOutputs;
+    h->inFIFO = maxInputs > 0 ? (float**)calloc2d(maxInputs, frameSize, sizeof(float)) : NULL;
+    h->outFIFO = maxOutputs > 0 ? (float**)calloc2d(maxOutputs, frameSize, sizeof(float)) : NULL;
+    h->inPtrs = maxInputs > 0 ? malloc1d(maxInputs*sizeof(float*)) : NULL;
+    h->outPtrs = maxOutputs > 0 ? malloc1d(maxOutputs*sizeof(float*)) : NULL;
+    saf_blockAdaptor_reset(*phBA);
+}
+
+void saf_blockAdaptor_destroy
+(
+    void ** const phBA
+)
+{
+    safBlockAdaptor_data *h = (safBlockAdaptor_data*)(*phBA);
+
+    if (h != NULL) {
+        free(h->inFIFO);
+        free(h->outFIFO);
+        free(h->inPtrs);
+        free(h->outPtrs);
+        free(h);
+        h = NULL;
+        *phBA = NULL;
+    }
+}
+
+void saf_blockAdaptor_reset
+(
+    void * const hBA
+)
+{
+    safBlockAdaptor_data *h = (safBlockAdaptor_data*)(hBA);
+
+    h->fifoMode = 0;
+    h->FIFO_idx = 0;
+    if(h->inFIFO!=NULL)
+        memset(FLATTEN2D(h->inFIFO), 0, h->maxInputs*h->frameSize*sizeof(float));
+    if(h->outFIFO!=NULL)
+        memset(FLATTEN2D(h->outFIFO), 0, h->maxOutputs*h->frameSize*sizeof(float));
+}
+
+void saf_blockAdaptor_apply
+(
+    void * const hBA,
+    float ** const inputs,
+    float ** const outputs,
+    int nInputs,
+    int nOutputs,
+    int nSamples,
+    saf_blockAdaptor_frameFn frameFn,
+    void * const userData
+)
+{
+    safBlockAdaptor_data *h = (safBlockAdaptor_data*)(hBA);
+    int s, ch, nIn, nOut, len;
+
+    nIn = MIN(nInputs, h->maxInputs);
+    nOut = MIN(nOutputs, h->maxOutputs);
+
+    /* The FIFOs are only required once the host block size is not a multiple
+     * of the frame size, after which they are kept (to remain continuous) */
+    if(!h->fifoMode && nSamples % h->frameSize != 0){
+        saf_blockAdaptor_reset(hBA);
+        h->fifoMode = 1;
+    }
+
+    if(!h->fifoMode){
+        /* Direct mode: process the frames in the host buffers */
+        for(s=0; s<nSamples; s+=h->frameSize){
+            for(ch=0; ch<nIn; ch++)
+                h->inPtrs[ch] = &inputs[ch][s];
+            for(ch=0; ch<nOut; ch++)
+                h->outPtrs[ch] = &outputs[ch][s];
+            frameFn(userData, h->inPtrs, h->outPtrs, nIn, nOut);
+        }
+    }
+    else{
+        /* FIFO mode: copy the largest possible chunks in/out of the FIFOs */
+        for(s=0; s<nSamples; s+=len){
+            len = MIN(h->frameSize - h->FIFO_idx, nSamples - s);
+            for(ch=0; ch<nIn; ch++)
+                memcpy(&h->inFIFO[ch][h->FIFO_idx], &inputs[ch][s], len*sizeof(float));
+            for(ch=0; ch<nOut; ch++)
+                memcpy(&outputs[ch][s], &h->outFIFO[ch][h->FIFO_idx], len*sizeof(float));
+            h->FIFO_idx += len;
+
+            /* Process frame once the input FIFO is full */
+            if(h->FIFO_idx == h->frameSize){
+                h->FIFO_idx = 0;
+                frameFn(userData, h->inFIFO, h->outFIFO, nIn, nOut);
+            }
+        }
+    }
+
+    /* Zero any output channels which exceed the maximum */
+    for(ch=nOut; ch<nOutputs; ch++)
+        memset(outputs[ch], 0, nSamples*sizeof(float));
+}
+
+void saf_blockAdaptor_applyStrided
+(
+    void * const hBA,
+    const float * inputs,
+    int inChStride,
+    int inSmpStride,
+    float * outputs,
+    int outChStride,
+    int outSmpStride,
+    int nInputs,
+    int nOutputs,
+    int nSamples,
+    saf_blockAdaptor_frameFn frameFn,
+    void * const userData
+)
+{
+    safBlockAdaptor_data *h = (safBlockAdaptor_data*)(hBA);
+    int s, ch, i, nIn, nOut, len;
+
+    nIn = MIN(nInputs, h->maxInputs);
+    nOut = MIN(nOutputs, h->maxOutputs);
+
+    if(!h->fifoMode && nSamples % h->frameSize != 0){
+        saf_blockAdaptor_reset(hBA);
+        h->fifoMode = 1;
+    }
+
+    if(!h->fifoMode){
+        /* Direct mode: gather each frame, process it, and scatter it back */
+        for(s=0; s<nSamples; s+=h->frameSize){
+            saf_blockAdaptor_gather(&inputs[s*inSmpStride], inChStride, inSmpStride,
+                                    h->inFIFO, 0, nIn, h->frameSize);
+            frameFn(userData, h->inFIFO, h->outFIFO, nIn, nOut);
+            saf_blockAdaptor_scatter(h->outFIFO, 0, &outputs[s*outSmpStride],
+                                     outChStride, outSmpStride, nOut, h->frameSize);
+        }
+    }
+    else{
+        /* FIFO mode: as in saf_blockAdaptor_apply() */
+        for(s=0; s<nSamples; s+=len){
+            len = MIN(h->frameSize - h->FIFO_idx, nSamples - s);
+            saf_blockAdaptor_gather(&inputs[s*inSmpStride], inChStride, inSmpStride,
+                                    h->inFIFO, h->FIFO_idx, nIn, len);
+            saf_blockAdaptor_scatter(h->outFIFO, h->FIFO_idx, &outputs[s*outSmpStride],
+                                     outChStride, outSmpStride, nOut, len);
+            h->FIFO_idx += len;
+            if(h->FIFO_idx == h->frameSize){
+                h->FIFO_idx = 0;
+                frameFn(userData, h->inFIFO, h->outFIFO, nIn, nOut);
+            }
+        }
+    }
+
+    /* Zero any output channels which exceed the maximum */
+    for(ch=nOut; ch<nOutputs; ch++)
+        for(i=0; i<nSamples; i++)
+            outputs[ch*outChStride + i*outSmpStride] = 0.0f;
+}
+
+int saf_blockAdaptor_getDelay
+(
+    void * const hBA
+)
+{
+    safBlockAdaptor_data *h = (safBlockAdaptor_data*)(hBA);
+    return h->fifoMode ? h->frameSize : 0;
+}
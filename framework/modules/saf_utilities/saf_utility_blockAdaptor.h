@@ -0,0 +1,188 @@
+/*
+ * Copyright 2020 Leo McCormack
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ *@addtogroup Utilities
+ *@{
+ * @file saf_utility_blockAdaptor.h
+ * @brief A block-size adaptor, which allows frame-based processing functions
+ *        to be driven with arbitrary host block sizes
+ *
+ * While the host block size is a multiple of the frame size, the frames are
+ * processed directly on the host buffers (without copying and without any
+ * additional delay). Otherwise, the adaptor switches over to an input/output
+ * FIFO scheme (adding a delay of one frame), until it is reset.
+ *
+ * Host buffers which are not arrays of channel pointers (e.g. interleaved
+ * buffers) may be passed to saf_blockAdaptor_applyStrided(), which gathers each
+ * frame into the adaptor's frame buffers and scatters the outputs back; i.e. it
+ * replaces the host-side de-interleaving and re-interleaving copies.
+ *
+ * @author Leo McCormack
+ * @date 16.10.2020
+ */
+
+#ifndef SAF_BLOCKADAPTOR_H_INCLUDED
+#define SAF_BLOCKADAPTOR_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * Frame processing function, invoked by saf_blockAdaptor_apply() for each
+ * complete frame
+ *
+ * The function should write all 'nOutputs' channels of 'outFrame'. Note that
+ * 'inFrame' and 'outFrame' may point to the same memory (if the host processes
+ * in-place), so the inputs should be read before the outputs are written.
+ *
+ * @param[in]  userData User data passed to saf_blockAdaptor_apply()
+ * @param[in]  inFrame  Input frame; nInputs x frameSize
+ * @param[out] outFrame Output frame; nOutputs x frameSize
+ * @param[in]  nInputs  Number of input channels
+ * @param[in]  nOutputs Number of output channels
+ */
+typedef void (*saf_blockAdaptor_frameFn)(void* const userData,
+                                         float** const inFrame,
+                                         float** const outFrame,
+                                         int nInputs,
+                                         int nOutputs);
+
+/**
+ * Creates an instance of the block-size adaptor
+ *
+ * @param[in] phBA       (&) address of block-size adaptor handle
+ * @param[in] frameSize  Frame size expected by the processing function
+ * @param[in] maxInputs  Maximum number of input channels (may be 0)
+ * @param[in] maxOutputs Maximum number of output channels (may be 0)
+ */
+void saf_blockAdaptor_create(/* Input Arguments */
+                             void ** const phBA,
+                             int frameSize,
+                             int maxInputs,
+                             int maxOutputs);
+
+/**
+ * Destroys an instance of the block-size adaptor
+ *
+ * @param[in] phBA (&) address of block-size adaptor handle
+ */
+void saf_blockAdaptor_destroy(/* Input Arguments */
+                              void ** const phBA);
+
+/**
+ * Flushes the FIFOs and returns the adaptor to the direct (zero delay) mode
+ *
+ * @param[in] hBA block-size adaptor handle
+ */
+void saf_blockAdaptor_reset(/* Input Arguments */
+                            void * const hBA);
+
+/**
+ * Processes a block of any length, by invoking 'frameFn' once for every
+ * complete frame
+ *
+ * Channels beyond 'maxInputs' are ignored, and output channels beyond
+ * 'maxOutputs' are zeroed.
+ *
+ * @param[in]  hBA      block-size adaptor handle
+ * @param[in]  inputs   Input signals; nInputs x nSamples
+ * @param[out] outputs  Output signals; nOutputs x nSamples
+ * @param[in]  nInputs  Number of input channels
+ * @param[in]  nOutputs Number of output channels
+ * @param[in]  nSamples Number of samples in the block
+ * @param[in]  frameFn  Frame processing function
+ * @param[in]  userData User data passed on to 'frameFn'
+ */
+void saf_blockAdaptor_apply(/* Input Arguments */
+                            void * const hBA,
+                            float ** const inputs,
+                            /* Output Arguments */
+                            float ** const outputs,
+                            /* Input Arguments */
+                            int nInputs,
+                            int nOutputs,
+                            int nSamples,
+                            saf_blockAdaptor_frameFn frameFn,
+                            void * const userData);
+
+/**
+ * Processes a block of any length, given as strided views of the host buffers,
+ * by invoking 'frameFn' once for every complete frame
+ *
+ * Sample 's' of channel 'ch' is read from inputs[ch*inChStride + s*inSmpStride]
+ * and written to outputs[ch*outChStride + s*outSmpStride]. For example,
+ * interleaved buffers have a channel stride of 1 and a sample stride of the
+ * number of channels, whereas contiguous planar buffers (FLATTEN2D()) have a
+ * channel stride of nSamples and a sample stride of 1. The inputs and outputs
+ * may point to the same memory (with identical strides).
+ *
+ * The frames are gathered into (and scattered from) the adaptor's frame
+ * buffers, hence, the same direct/FIFO modes and delays apply as for
+ * saf_blockAdaptor_apply(). Channels beyond 'maxInputs' are ignored, and output
+ * channels beyond 'maxOutputs' are zeroed.
+ *
+ * @param[in]  hBA          block-size adaptor handle
+ * @param[in]  inputs       Input signals (strided view)
+ * @param[in]  inChStride   Distance between input channels, in samples
+ * @param[in]  inSmpStride  Distance between consecutive input samples
+ * @param[out] outputs      Output signals (strided view)
+ * @param[in]  outChStride  Distance between output channels, in samples
+ * @param[in]  outSmpStride Distance between consecutive output samples
+ * @param[in]  nInputs      Number of input channels
+ * @param[in]  nOutputs     Number of output channels
+ * @param[in]  nSamples     Number of samples in the block
+ * @param[in]  frameFn      Frame processing function
+ * @param[in]  userData     User data passed on to 'frameFn'
+ */
+void saf_blockAdaptor_applyStrided(/* Input Arguments */
+                                   void * const hBA,
+                                   const float * inputs,
+                                   int inChStride,
+                                   int inSmpStride,
+                                   /* Output Arguments */
+                                   float * outputs,
+                                   /* Input Arguments */
+                                   int outChStride,
+                                   int outSmpStride,
+                                   int nInputs,
+                                   int nOutputs,
+                                   int nSamples,
+                                   saf_blockAdaptor_frameFn frameFn,
+                                   void * const userData);
+
+/**
+ * Returns the delay added by the adaptor, in samples (0 in the direct mode,
+ * one frame in the FIFO mode)
+ *
+ * @param[in] hBA block-size adaptor handle
+ */
+int saf_blockAdaptor_getDelay(/* Input Arguments */
+                              void * const hBA);
+
+
+#ifdef __cplusplus
+}/* extern "C" */
+#endif /* __cplusplus */
+
+#endif /* SAF_BLOCKADAPTOR_H_INCLUDED */
+
+/**@} */ /* doxygen addtogroup Utilities */
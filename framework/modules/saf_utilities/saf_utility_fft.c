@@ -42,31 +42,61 @@ typedef struct _saf_stft_data {
     int winsize, hopsize, fftsize, nCHin, nCHout, nBands;
     void* hFFT;
     int numOvrlpAddBlocks, bufferlength, nPrevHops;
-    float* window, *insig_win, *outsig_win;
+    float* window;
+    float* insig_win;      /**< Windowed input; FLAT: nCHin x fftsize */
+    float* outsig_win;     /**< Inverse FFT output; FLAT: nCHout x fftsize */
     float** overlapAddBuffer;
     float*** prev_inhops;
-    float_complex* tmp_fft;
+    float_complex* tmp_fft;/**< Spectra; FLAT: MAX(nCHin, nCHout) x nBands */
     SAF_STFT_FDDATA_FORMAT FDformat;
 
 }saf_stft_data;
 
+/**
+ * Immutable FFT plan data (twiddles, setups and committed descriptors), which
+ * is shared by all saf_rfft/saf_fft instances of the same type and size.
+ * Batch plans (nTransforms>1) are only created for MKL, when a batch is
+ * prepared (see saf_fft_plan_prepareBatch())
+ */
+typedef struct _saf_fft_plan {
+    int N;
+    int realFLAG;
+    int nTransforms, inDist, outDist; /* 1, 0, 0 for single transforms */
+    int refCount;
+    int useKissFFT_flag;
+#if defined(__ACCELERATE__)
+    int log2n;
+    FFTSetup FFT;
+#elif defined(INTEL_MKL_VERSION)
+    DFTI_DESCRIPTOR_HANDLE MKL_FFT_Handle;
+    MKL_LONG Status;
+#endif
+    void* kissFFThandle_fwd; /* kiss_fftr_cfg or kiss_fft_cfg */
+    void* kissFFThandle_bkw;
+    struct _saf_fft_plan* next;
+
+}saf_fft_plan;
+
 /**
  * Data structure for real-(half)complex FFT transforms
  */
 typedef struct _saf_rfft_data {
     int N;
     float  Scale;
+    saf_fft_plan* plan;
 #if defined(__ACCELERATE__)
     int log2n;
     FFTSetup FFT;
     DSPSplitComplex VDSP_split;
 #elif defined(INTEL_MKL_VERSION)
     DFTI_DESCRIPTOR_HANDLE MKL_FFT_Handle;
+    saf_fft_plan* batchPlan[2]; /* most recently prepared batches; NULL if none */
     MKL_LONG input_strides[2], output_strides[2], Status;
 #endif
     int useKissFFT_flag;
     kiss_fftr_cfg kissFFThandle_fwd;
     kiss_fftr_cfg kissFFThandle_bkw;
+    float_complex* tmpFD; /* interleaved scratch for the split transforms */
     
 }saf_rfft_data;
 
@@ -76,12 +106,14 @@ typedef struct _saf_rfft_data {
 typedef struct _saf_fft_data {
     int N;
     float  Scale;
+    saf_fft_plan* plan;
 #if defined(__ACCELERATE__)
     int log2n;
     FFTSetup FFT;
     DSPSplitComplex VDSP_split;
 #elif defined(INTEL_MKL_VERSION)
     DFTI_DESCRIPTOR_HANDLE MKL_FFT_Handle;
+    saf_fft_plan* batchPlan[2]; /* most recently prepared batches; NULL if none */
     MKL_LONG Status;
 #endif
     int useKissFFT_flag;
@@ -108,6 +140,184 @@ static int nextpow2(int numsamp)
     }
 }
 
+/** Process-wide cache of FFT plans (linked-list), guarded by a spin-lock */
+static saf_fft_plan* saf_fft_planCache = NULL;
+static volatile int saf_fft_planCacheLock = 0;
+
+/**
+ * Returns the cached plan for the requested FFT type, size and batch (i.e.
+ * number of transforms, and the distances between the input/output vectors),
+ * creating it if it does not yet exist, and increments its reference count
+ */
+static saf_fft_plan* saf_fft_plan_acquire
+(
+    int N,
+    int realFLAG,
+    int nTransforms,
+    int inDist,
+    int outDist
+)
+{
+    saf_fft_plan* p;
+
+    saf_spinlock_lock(&saf_fft_planCacheLock);
+    for(p=saf_fft_planCache; p!=NULL; p=p->next)
+        if(p->N==N && p->realFLAG==realFLAG && p->nTransforms==nTransforms && p->inDist==inDist && p->outDist==outDist)
+            break;
+    if(p==NULL){
+        p = malloc1d(sizeof(saf_fft_plan));
+        p->N = N;
+        p->realFLAG = realFLAG;
+        p->nTransforms = nTransforms;
+        p->inDist = inDist;
+        p->outDist = outDist;
+        p->refCount = 0;
+#if defined(__ACCELERATE__)
+        if(ceilf(log2f(N)) == floorf(log2f(N))) /* true if N is 2 to the power of some integer number */
+            p->useKissFFT_flag = 0;
+        else
+            p->useKissFFT_flag = 1;
+        /* Apple Accelerate only supports 2^x FFT sizes */
+        if(!p->useKissFFT_flag){
+            p->log2n = (int)(log2f((float)N)+0.1f);
+            p->FFT = (void*)vDSP_create_fftsetup(p->log2n, FFT_RADIX2);
+        }
+#elif defined(INTEL_MKL_VERSION)
+        p->useKissFFT_flag = 0;
+        p->MKL_FFT_Handle = 0;
+        if(realFLAG){
+            p->Status = DftiCreateDescriptor(&(p->MKL_FFT_Handle), DFTI_SINGLE, DFTI_REAL, 1, N); /* 1-D, single precision, real_input->fft->half_complex->ifft->real_output */
+            /* specify output format as complex conjugate-symmetric data. This is the same as MatLab, except only the
+             * first N/2+1 elements are returned. The inverse transform will automatically symmetrically+conjugate
+             * replicate these elements, in order to get the required N elements internally. */
+            p->Status = DftiSetValue(p->MKL_FFT_Handle, DFTI_CONJUGATE_EVEN_STORAGE, DFTI_COMPLEX_COMPLEX);
+        }
+        else
+            p->Status = DftiCreateDescriptor(&(p->MKL_FFT_Handle), DFTI_SINGLE, DFTI_COMPLEX, 1, N); /* 1-D, single precision, complex_input_td->fft->complex_input_fd->ifft->complex_output_td */
+        p->Status = DftiSetValue(p->MKL_FFT_Handle, DFTI_PLACEMENT, DFTI_NOT_INPLACE); /* Not inplace, i.e. output has its own dedicated memory */
+        /* Configuration parameters for backward-FFT */
+        p->Status = DftiSetValue(p->MKL_FFT_Handle, DFTI_BACKWARD_SCALE, 1.0f/(float)N); /* scalar applied after ifft */
+        if(nTransforms>1){
+            p->Status = DftiSetValue(p->MKL_FFT_Handle, DFTI_NUMBER_OF_TRANSFORMS, (MKL_LONG)nTransforms);
+            p->Status = DftiSetValue(p->MKL_FFT_Handle, DFTI_INPUT_DISTANCE, (MKL_LONG)inDist);
+            p->Status = DftiSetValue(p->MKL_FFT_Handle, DFTI_OUTPUT_DISTANCE, (MKL_LONG)outDist);
+        }
+        /* commit these chosen parameters (a committed descriptor may be used by several threads at once) */
+        p->Status = DftiCommitDescriptor(p->MKL_FFT_Handle);
+#else
+        p->useKissFFT_flag = 1;
+#endif
+        if(p->useKissFFT_flag){
+            if(realFLAG){
+                p->kissFFThandle_fwd = kiss_fftr_alloc(N, 0, NULL, NULL);
+                p->kissFFThandle_bkw = kiss_fftr_alloc(N, 1, NULL, NULL);
+            }
+            else{
+                p->kissFFThandle_fwd = kiss_fft_alloc(N, 0, NULL, NULL);
+                p->kissFFThandle_bkw = kiss_fft_alloc(N, 1, NULL, NULL);
+            }
+        }
+        p->next = saf_fft_planCache;
+        saf_fft_planCache = p;
+    }
+    p->refCount++;
+    saf_spinlock_unlock(&saf_fft_planCacheLock);
+    return p;
+}
+
+/**
+ * Decrements the reference count of a plan, and destroys it once it is no
+ * longer used by any instance
+ */
+static void saf_fft_plan_release
+(
+    saf_fft_plan* plan
+)
+{
+    saf_fft_plan** pp;
+
+    saf_spinlock_lock(&saf_fft_planCacheLock);
+    plan->refCount--;
+    if(plan->refCount==0){
+        /* unlink from the cache */
+        for(pp=&saf_fft_planCache; *pp!=plan; pp=&((*pp)->next));
+        *pp = plan->next;
+#if defined(__ACCELERATE__)
+        if(!plan->useKissFFT_flag)
+            vDSP_destroy_fftsetup(plan->FFT);
+#elif defined(INTEL_MKL_VERSION)
+        plan->Status = DftiFreeDescriptor(&(plan->MKL_FFT_Handle));
+#endif
+        if(plan->useKissFFT_flag){
+            /* (kiss_fftr_free and kiss_fft_free are the same) */
+            kiss_fft_free(plan->kissFFThandle_fwd);
+            kiss_fft_free(plan->kissFFThandle_bkw);
+        }
+        free(plan);
+    }
+    saf_spinlock_unlock(&saf_fft_planCacheLock);
+}
+
+#if defined(INTEL_MKL_VERSION)
+/**
+ * Makes the (shared) batch plan for the requested batch the first of the two
+ * 'batchPlans' of an instance, moving the other one to the second place; the
+ * plan which was in the second place is released (unless it is the requested
+ * one)
+ */
+static void saf_fft_plan_prepareBatch
+(
+    saf_fft_plan* batchPlans[2],
+    int N,
+    int realFLAG,
+    int nTransforms,
+    int inDist,
+    int outDist
+)
+{
+    saf_fft_plan* p;
+
+    if(nTransforms<=1) /* (single transforms do not use the batch plans) */
+        return;
+    p = batchPlans[1];
+    if(p!=NULL && p->nTransforms==nTransforms && p->inDist==inDist && p->outDist==outDist){
+        batchPlans[1] = batchPlans[0];
+        batchPlans[0] = p;
+        return;
+    }
+    p = batchPlans[0];
+    if(p!=NULL && p->nTransforms==nTransforms && p->inDist==inDist && p->outDist==outDist)
+        return;
+    if(batchPlans[1]!=NULL)
+        saf_fft_plan_release(batchPlans[1]);
+    batchPlans[1] = batchPlans[0];
+    batchPlans[0] = saf_fft_plan_acquire(N, realFLAG, nTransforms, inDist, outDist);
+}
+
+/**
+ * Returns the prepared batch plan of an instance which matches the requested
+ * batch, or NULL if there is none (see saf_fft_plan_prepareBatch())
+ */
+static saf_fft_plan* saf_fft_plan_findBatch
+(
+    saf_fft_plan* batchPlans[2],
+    int nTransforms,
+    int inDist,
+    int outDist
+)
+{
+    int i;
+    saf_fft_plan* p;
+
+    for(i=0; i<2; i++){
+        p = batchPlans[i];
+        if(p!=NULL && p->nTransforms==nTransforms && p->inDist==inDist && p->outDist==outDist)
+            return p;
+    }
+    return NULL;
+}
+#endif
+
 
 /* ========================================================================== */
 /*                               Misc. Functions                              */
@@ -272,11 +482,13 @@ void saf_stft_create
     /* set-up FFT */
     h->fftsize = 2*winsize;
     saf_rfft_create(&(h->hFFT), h->fftsize);
-    h->insig_win = calloc1d(h->fftsize, sizeof(float));
+    saf_rfft_prepareBatch(h->hFFT, nCHin, h->fftsize, h->nBands);  /* (see saf_stft_forward()) */
+    saf_rfft_prepareBatch(h->hFFT, nCHout, h->nBands, h->fftsize); /* (see saf_stft_backward()) */
+    h->insig_win = calloc1d(nCHin*(h->fftsize), sizeof(float));
 
-    /* Intermediate buffers */
-    h->tmp_fft = malloc1d(h->nBands * sizeof(float_complex));
-    h->outsig_win = malloc1d(h->fftsize*sizeof(float));
+    /* Intermediate buffers (for all channels, which are transformed at once) */
+    h->tmp_fft = malloc1d(MAX(nCHin, nCHout)*(h->nBands)*sizeof(float_complex));
+    h->outsig_win = malloc1d(nCHout*(h->fftsize)*sizeof(float));
     h->nPrevHops = winsize/hopsize-1;
     if (h->nPrevHops>0)
         h->prev_inhops = (float***)calloc3d(h->nPrevHops, nCHin, hopsize, sizeof(float));
@@ -308,6 +520,7 @@ void saf_stft_destroy
         free(h->window);
         free(h->overlapAddBuffer);
         free(h->insig_win);
+        free(h->outsig_win);
         free(h->tmp_fft);
         free(h->prev_inhops);
         free(h);
@@ -327,64 +540,51 @@ void saf_stft_forward
 {
     saf_stft_data *h = (saf_stft_data*)(hSTFT);
     int ch, j, nHops, t, band, idx, hIdx;
+    float* win;
 
     assert(framesize % h->hopsize == 0); /* framesize must be multiple of hopsize */
     nHops = framesize/h->hopsize;
 
-    /* For linear time-invariant (LTI) operation (i.e. no previous hops are
-     * required) */
-    if(h->winsize==h->hopsize){
-        for (t = 0; t<nHops; t++){
-            for(ch=0; ch < h->nCHin; ch++){
-                /* Window input signal (Rectangular) */
-                memcpy(h->insig_win, &dataTD[ch][t*(h->hopsize)], h->winsize*sizeof(float));
-
-                /* Apply FFT and copy data to output dataFD buffer */
-                switch(h->FDformat){
-                    case SAF_STFT_TIME_CH_BANDS:
-                        saf_rfft_forward(h->hFFT, h->insig_win, dataFD[t][ch]);
-                        break;
-
-                    case SAF_STFT_BANDS_CH_TIME:
-                        saf_rfft_forward(h->hFFT, h->insig_win, h->tmp_fft);
-                        for(band=0; band<h->nBands; band++)
-                            dataFD[band][ch][t] = h->tmp_fft[band];
-                        break;
-                }
-            }
-        }
-    }
-    /* For oversampled TF transforms */
-    else{
-        idx = 0;
-        for (t = 0; t<nHops; t++){
-            for(ch=0; ch < h->nCHin; ch++){
+    idx = 0;
+    for (t = 0; t<nHops; t++){
+        for(ch=0; ch < h->nCHin; ch++){
+            win = &(h->insig_win[ch*(h->fftsize)]);
+
+            /* For linear time-invariant (LTI) operation (i.e. no previous hops
+             * are required), the window is rectangular */
+            if(h->winsize==h->hopsize)
+                memcpy(win, &dataTD[ch][t*(h->hopsize)], h->winsize*sizeof(float));
+            /* For oversampled TF transforms */
+            else{
                 hIdx = 0;
                 /* Window input signal */
                 while (hIdx < h->winsize){
-                    memcpy(&(h->insig_win[hIdx]), h->prev_inhops[0][ch], h->hopsize*sizeof(float));
+                    memcpy(&(win[hIdx]), h->prev_inhops[0][ch], h->hopsize*sizeof(float));
                     for(j=0; j< h->nPrevHops-1; j++)
                         memcpy(h->prev_inhops[j][ch], h->prev_inhops[j+1][ch], h->hopsize*sizeof(float));
                     memcpy(h->prev_inhops[h->nPrevHops-1][ch], &dataTD[ch][idx], h->hopsize*sizeof(float));
                     hIdx += h->hopsize;
                 }
-                utility_svvmul(h->insig_win, h->window, h->winsize, h->insig_win);
-
-                /* Apply FFT and copy data to output dataFD buffer */
-                switch(h->FDformat){
-                    case SAF_STFT_TIME_CH_BANDS:
-                        saf_rfft_forward(h->hFFT, h->insig_win, dataFD[t][ch]);
-                        break;
-
-                    case SAF_STFT_BANDS_CH_TIME:
-                        saf_rfft_forward(h->hFFT, h->insig_win, h->tmp_fft);
-                        for(band=0; band<h->nBands; band++)
-                            dataFD[band][ch][t] = h->tmp_fft[band];
-                        break;
-                }
+                utility_svvmul(win, h->window, h->winsize, win);
+            }
+        }
+        idx += h->hopsize;
+
+        /* Apply FFT to all channels in a single call, and copy data to the
+         * output dataFD buffer */
+        saf_rfft_forward_batch(h->hFFT, h->nCHin, h->insig_win, h->fftsize, h->tmp_fft, h->nBands);
+        for(ch=0; ch < h->nCHin; ch++){
+            switch(h->FDformat){
+                case SAF_STFT_TIME_CH_BANDS:
+                    memcpy(dataFD[t][ch], &(h->tmp_fft[ch*(h->nBands)]), h->nBands*sizeof(float_complex));
+                    break;
+
+                case SAF_STFT_BANDS_CH_TIME:
+                    for(band=0; band<h->nBands; band++)
+                        dataFD[band][ch][t] = h->tmp_fft[ch*(h->nBands)+band];
+                    break;
             }
-            idx += h->hopsize;
-        } 
+        }
     }
 }
 
@@ -403,27 +603,30 @@ void saf_stft_backward
     nHops = framesize/h->hopsize;
 
     for (t = 0; t<nHops; t++){
+        /* Gather the spectra of all channels, and apply the inverse FFT to
+         * them in a single call */
         for(ch=0; ch < h->nCHout; ch++){
-            /* Shift data down */
-            memcpy(h->overlapAddBuffer[ch], &h->overlapAddBuffer[ch][h->hopsize], (h->numOvrlpAddBlocks-1)*(h->hopsize)*sizeof(float));
-
-            /* Append with zeros */
-            memset(&h->overlapAddBuffer[ch][(h->numOvrlpAddBlocks-1)*(h->hopsize)], 0, h->hopsize*sizeof(float));
-
-            /* Apply inverse FFT */
             switch(h->FDformat){
                 case SAF_STFT_TIME_CH_BANDS:
-                    saf_rfft_backward(h->hFFT, dataFD[t][ch], h->outsig_win);
+                    memcpy(&(h->tmp_fft[ch*(h->nBands)]), dataFD[t][ch], h->nBands*sizeof(float_complex));
                     break;
                 case SAF_STFT_BANDS_CH_TIME:
                     for(band=0; band<h->nBands; band++)
-                        h->tmp_fft[band] = dataFD[band][ch][t];
-                    saf_rfft_backward(h->hFFT, h->tmp_fft, h->outsig_win);
+                        h->tmp_fft[ch*(h->nBands)+band] = dataFD[band][ch][t];
                     break;
             }
+        }
+        saf_rfft_backward_batch(h->hFFT, h->nCHout, h->tmp_fft, h->nBands, h->outsig_win, h->fftsize);
+
+        for(ch=0; ch < h->nCHout; ch++){
+            /* Shift data down */
+            memcpy(h->overlapAddBuffer[ch], &h->overlapAddBuffer[ch][h->hopsize], (h->numOvrlpAddBlocks-1)*(h->hopsize)*sizeof(float));
+
+            /* Append with zeros */
+            memset(&h->overlapAddBuffer[ch][(h->numOvrlpAddBlocks-1)*(h->hopsize)], 0, h->hopsize*sizeof(float));
 
             /* Overlap-Add and copy 1:hopsize to output buffer */
-            utility_svvadd(h->overlapAddBuffer[ch], h->outsig_win, h->fftsize, h->overlapAddBuffer[ch]);
+            utility_svvadd(h->overlapAddBuffer[ch], &(h->outsig_win[ch*(h->fftsize)]), h->fftsize, h->overlapAddBuffer[ch]);
             memcpy(&dataTD[ch][t*(h->hopsize)], h->overlapAddBuffer[ch], h->hopsize*sizeof(float)); 
         }
     }
@@ -450,6 +653,17 @@ void saf_stft_channelChange
     saf_stft_data *h = (saf_stft_data*)(hSTFT);
     int i, ch;
 
+    /* Scratch buffers (see saf_stft_create()) */
+    if(new_nCHin != h->nCHin || new_nCHout != h->nCHout){
+        free(h->insig_win);
+        free(h->outsig_win);
+        h->insig_win = calloc1d(new_nCHin*(h->fftsize), sizeof(float));
+        h->outsig_win = malloc1d(new_nCHout*(h->fftsize)*sizeof(float));
+        h->tmp_fft = realloc1d(h->tmp_fft, MAX(new_nCHin, new_nCHout)*(h->nBands)*sizeof(float_complex));
+        saf_rfft_prepareBatch(h->hFFT, new_nCHin, h->fftsize, h->nBands);
+        saf_rfft_prepareBatch(h->hFFT, new_nCHout, h->nBands, h->fftsize);
+    }
+
     if(new_nCHin != h->nCHin && h->nPrevHops > 0){
         /* Reallocate memory while retaining previous values (which will be
          * truncated if new_nCHin < nCHin) */
@@ -493,38 +707,27 @@ void saf_rfft_create
     h->N = N;
     h->Scale = 1.0f/(float)N; /* output scaling after ifft */
     assert(N>=2); /* only even (non zero) FFT sizes allowed */
+
+    /* The twiddles/setups/descriptors are shared with all other instances of
+     * the same size; only the scratch buffers are owned by this instance */
+    h->plan = saf_fft_plan_acquire(N, 1, 1, 0, 0);
+    h->useKissFFT_flag = h->plan->useKissFFT_flag;
 #if defined(__ACCELERATE__)
-    if(ceilf(log2f(N)) == floorf(log2f(N))) /* true if N is 2 to the power of some integer number */
-        h->useKissFFT_flag = 0;
-    else
-        h->useKissFFT_flag = 1;
-    /* Apple Accelerate only supports 2^x FFT sizes */
     if(!h->useKissFFT_flag){
-        h->log2n = (int)(log2f((float)N)+0.1f);
-        h->FFT = (void*)vDSP_create_fftsetup(h->log2n, FFT_RADIX2);
+        h->log2n = h->plan->log2n;
+        h->FFT = h->plan->FFT;
         h->VDSP_split.realp = malloc1d((h->N/2)*sizeof(float));
         h->VDSP_split.imagp = malloc1d((h->N/2)*sizeof(float));
     }
 #elif defined(INTEL_MKL_VERSION)
-    h->useKissFFT_flag = 0;
-    h->MKL_FFT_Handle = 0;
-    h->Status = DftiCreateDescriptor(&(h->MKL_FFT_Handle), DFTI_SINGLE, DFTI_REAL, 1, h->N); /* 1-D, single precision, real_input->fft->half_complex->ifft->real_output */
-    h->Status = DftiSetValue(h->MKL_FFT_Handle, DFTI_PLACEMENT, DFTI_NOT_INPLACE); /* Not inplace, i.e. output has its own dedicated memory */
-    /* specify output format as complex conjugate-symmetric data. This is the same as MatLab, except only the
-     * first N/2+1 elements are returned. The inverse transform will automatically symmetrically+conjugate
-     * replicate these elements, in order to get the required N elements internally. */
-    h->Status = DftiSetValue(h->MKL_FFT_Handle, DFTI_CONJUGATE_EVEN_STORAGE, DFTI_COMPLEX_COMPLEX);
-    /* Configuration parameters for backward-FFT */
-    h->Status = DftiSetValue(h->MKL_FFT_Handle, DFTI_BACKWARD_SCALE, h->Scale);      /* scalar applied after ifft */
-    /* commit these chosen parameters */
-    h->Status = DftiCommitDescriptor(h->MKL_FFT_Handle);
-#else
-    h->useKissFFT_flag = 1;
+    h->MKL_FFT_Handle = h->plan->MKL_FFT_Handle;
+    h->batchPlan[0] = h->batchPlan[1] = NULL; /* (see saf_rfft_prepareBatch()) */
 #endif
     if(h->useKissFFT_flag){
-       h->kissFFThandle_fwd = kiss_fftr_alloc(h->N, 0, NULL, NULL);
-       h->kissFFThandle_bkw = kiss_fftr_alloc(h->N, 1, NULL, NULL);
+       h->kissFFThandle_fwd = kiss_fftr_alloc_shared((kiss_fftr_cfg)h->plan->kissFFThandle_fwd, NULL, NULL);
+       h->kissFFThandle_bkw = kiss_fftr_alloc_shared((kiss_fftr_cfg)h->plan->kissFFThandle_bkw, NULL, NULL);
     }
+    h->tmpFD = malloc1d((h->N/2+1)*sizeof(float_complex));
 }
 
 void saf_rfft_destroy
@@ -536,17 +739,21 @@ void saf_rfft_destroy
     if(h!=NULL){
 #if defined(__ACCELERATE__)
         if(!h->useKissFFT_flag){
-            vDSP_destroy_fftsetup(h->FFT);
             free(h->VDSP_split.realp);
             free(h->VDSP_split.imagp);
         }
 #elif defined(INTEL_MKL_VERSION)
-        h->Status = DftiFreeDescriptor(&(h->MKL_FFT_Handle));
+        if(h->batchPlan[0]!=NULL)
+            saf_fft_plan_release(h->batchPlan[0]);
+        if(h->batchPlan[1]!=NULL)
+            saf_fft_plan_release(h->batchPlan[1]);
 #endif
         if(h->useKissFFT_flag){
             kiss_fftr_free(h->kissFFThandle_fwd);
             kiss_fftr_free(h->kissFFThandle_bkw);
         }
+        free(h->tmpFD);
+        saf_fft_plan_release(h->plan);
         free(h);
         h=NULL;
     }
@@ -614,6 +821,143 @@ void saf_rfft_backward
     }
 }
 
+void saf_rfft_forward_split
+(
+    void * const hFFT,
+    float* inputTD,
+    float* outputFD_re,
+    float* outputFD_im
+)
+{
+    saf_rfft_data *h = (saf_rfft_data*)(hFFT);
+    int nBins;
+#if defined(__ACCELERATE__)
+    DSPSplitComplex split;
+    float half;
+    if(!h->useKissFFT_flag){
+        /* vDSP operates on split-complex data natively, so the transform is
+         * performed directly in the output buffers */
+        split.realp = outputFD_re;
+        split.imagp = outputFD_im;
+        vDSP_ctoz((DSPComplex*)inputTD, 2, &split, 1, (h->N)/2);
+        vDSP_fft_zrip((FFTSetup)(h->FFT), &split, 1, h->log2n, FFT_FORWARD);
+        /* remove the 2x scaling (see saf_rfft_forward()), and unpack the
+         * Nyquist value from the imaginary part of DC */
+        half = 0.5f;
+        vDSP_vsmul(outputFD_re, 1, &half, outputFD_re, 1, (h->N)/2);
+        vDSP_vsmul(outputFD_im, 1, &half, outputFD_im, 1, (h->N)/2);
+        outputFD_re[h->N/2] = outputFD_im[0];
+        outputFD_im[0] = outputFD_im[h->N/2] = 0.0f;
+        return;
+    }
+#endif
+    /* MKL/KissFFT only output interleaved (conjugate-symmetric) data */
+    nBins = h->N/2+1;
+    saf_rfft_forward(h, inputTD, h->tmpFD);
+    cblas_scopy(nBins, (float*)h->tmpFD, 2, outputFD_re, 1);
+    cblas_scopy(nBins, ((float*)h->tmpFD)+1, 2, outputFD_im, 1);
+}
+
+void saf_rfft_backward_split
+(
+    void * const hFFT,
+    float* inputFD_re,
+    float* inputFD_im,
+    float* outputTD
+)
+{
+    saf_rfft_data *h = (saf_rfft_data*)(hFFT);
+    int nBins;
+#if defined(__ACCELERATE__)
+    if(!h->useKissFFT_flag){
+        /* pack the Nyquist value into the imaginary part of DC */
+        memcpy(h->VDSP_split.realp, inputFD_re, (h->N/2)*sizeof(float));
+        memcpy(h->VDSP_split.imagp, inputFD_im, (h->N/2)*sizeof(float));
+        h->VDSP_split.imagp[0] = inputFD_re[h->N/2];
+        vDSP_fft_zrip(h->FFT, &(h->VDSP_split), 1, h->log2n, FFT_INVERSE);
+        vDSP_ztoc(&(h->VDSP_split), 1, (DSPComplex*)outputTD, 2, (h->N)/2);
+        vDSP_vsmul(outputTD, 1, &(h->Scale), outputTD, 1, h->N);
+        return;
+    }
+#endif
+    nBins = h->N/2+1;
+    cblas_scopy(nBins, inputFD_re, 1, (float*)h->tmpFD, 2);
+    cblas_scopy(nBins, inputFD_im, 1, ((float*)h->tmpFD)+1, 2);
+    saf_rfft_backward(h, h->tmpFD, outputTD);
+}
+
+void saf_rfft_forward_batch
+(
+    void * const hFFT,
+    int nTransforms,
+    float* inputTD,
+    int inDist,
+    float_complex* outputFD,
+    int outDist
+)
+{
+    saf_rfft_data *h = (saf_rfft_data*)(hFFT);
+    int i;
+#if defined(INTEL_MKL_VERSION)
+    saf_fft_plan* p;
+    if(nTransforms>1){
+        /* (never looked up or created here, see saf_rfft_prepareBatch()) */
+        p = saf_fft_plan_findBatch(h->batchPlan, nTransforms, inDist, outDist);
+        assert(p!=NULL);
+        if(p!=NULL){
+            h->Status = DftiComputeForward(p->MKL_FFT_Handle, inputTD, outputFD);
+            return;
+        }
+    }
+#endif
+    /* Accelerate and KissFFT: one transform at a time, reusing the same
+     * setup/twiddles */
+    for(i=0; i<nTransforms; i++)
+        saf_rfft_forward(h, &inputTD[i*inDist], &outputFD[i*outDist]);
+}
+
+void saf_rfft_backward_batch
+(
+    void * const hFFT,
+    int nTransforms,
+    float_complex* inputFD,
+    int inDist,
+    float* outputTD,
+    int outDist
+)
+{
+    saf_rfft_data *h = (saf_rfft_data*)(hFFT);
+    int i;
+#if defined(INTEL_MKL_VERSION)
+    saf_fft_plan* p;
+    if(nTransforms>1){
+        /* (never looked up or created here, see saf_rfft_prepareBatch()) */
+        p = saf_fft_plan_findBatch(h->batchPlan, nTransforms, inDist, outDist);
+        assert(p!=NULL);
+        if(p!=NULL){
+            h->Status = DftiComputeBackward(p->MKL_FFT_Handle, inputFD, outputTD);
+            return;
+        }
+    }
+#endif
+    for(i=0; i<nTransforms; i++)
+        saf_rfft_backward(h, &inputFD[i*inDist], &outputTD[i*outDist]);
+}
+
+void saf_rfft_prepareBatch
+(
+    void * const hFFT,
+    int nTransforms,
+    int inDist,
+    int outDist
+)
+{
+#if defined(INTEL_MKL_VERSION)
+    saf_rfft_data *h = (saf_rfft_data*)(hFFT);
+    saf_fft_plan_prepareBatch(h->batchPlan, h->N, 1, nTransforms, inDist, outDist);
+#endif
+}
+
 
 /* ========================================================================== */
 /*                            Complex<->Complex FFT                           */
@@ -631,34 +975,26 @@ void saf_fft_create
     h->N = N;
     h->Scale = 1.0f/(float)N; /* output scaling after ifft */
     assert(N>=2); /* only even (non zero) FFT sizes allowed */
+
+    /* The twiddles/setups/descriptors are shared with all other instances of
+     * the same size */
+    h->plan = saf_fft_plan_acquire(N, 0, 1, 0, 0);
+    h->useKissFFT_flag = h->plan->useKissFFT_flag;
 #if defined(__ACCELERATE__)
-    if(ceilf(log2f(N)) == floorf(log2f(N))) /* true if N is 2 to the power of some integer number */
-        h->useKissFFT_flag = 0;
-    else
-        h->useKissFFT_flag = 1;
-    /* Apple Accelerate only supports 2^x FFT sizes */
     if(!h->useKissFFT_flag){
-        h->log2n = (int)(log2f((float)N)+0.1f);
-        h->FFT = (void*)vDSP_create_fftsetup(h->log2n, FFT_RADIX2);
+        h->log2n = h->plan->log2n;
+        h->FFT = h->plan->FFT;
         h->VDSP_split.realp = malloc1d((h->N/2)*sizeof(float));
         h->VDSP_split.imagp = malloc1d((h->N/2)*sizeof(float));
     }
 #elif defined(INTEL_MKL_VERSION)
-    h->useKissFFT_flag = 0;
-    h->MKL_FFT_Handle = 0;
-    h->Status = DftiCreateDescriptor( &(h->MKL_FFT_Handle), DFTI_SINGLE,
-                                  DFTI_COMPLEX, 1, h->N); /* 1-D, single precision, complex_input_td->fft->complex_input_fd->ifft->complex_output_td */
-    h->Status = DftiSetValue(h->MKL_FFT_Handle, DFTI_PLACEMENT, DFTI_NOT_INPLACE); /* Not inplace, i.e. output has its own dedicated memory */
-    /* Configuration parameters for backward-FFT */
-    h->Status = DftiSetValue(h->MKL_FFT_Handle, DFTI_BACKWARD_SCALE, h->Scale);      /* scalar applied after ifft */
-    /* commit these chosen parameters */
-    h->Status = DftiCommitDescriptor(h->MKL_FFT_Handle);
-#else
-    h->useKissFFT_flag = 1;
+    h->MKL_FFT_Handle = h->plan->MKL_FFT_Handle;
+    h->batchPlan[0] = h->batchPlan[1] = NULL; /* (see saf_fft_prepareBatch()) */
 #endif
     if(h->useKissFFT_flag){
-        h->kissFFThandle_fwd = kiss_fft_alloc(h->N, 0, NULL, NULL);
-        h->kissFFThandle_bkw = kiss_fft_alloc(h->N, 1, NULL, NULL);
+        /* (kiss_fft does not write to its state, so it may be used directly) */
+        h->kissFFThandle_fwd = (kiss_fft_cfg)h->plan->kissFFThandle_fwd;
+        h->kissFFThandle_bkw = (kiss_fft_cfg)h->plan->kissFFThandle_bkw;
     }
 }
 
@@ -672,17 +1008,16 @@ void saf_fft_destroy
     if(h!=NULL){
 #if defined(__ACCELERATE__)
         if(!h->useKissFFT_flag){
-            vDSP_destroy_fftsetup(h->FFT);
             free(h->VDSP_split.realp);
             free(h->VDSP_split.imagp);
         }
 #elif defined(INTEL_MKL_VERSION)
-        h->Status = DftiFreeDescriptor(&(h->MKL_FFT_Handle));
+        if(h->batchPlan[0]!=NULL)
+            saf_fft_plan_release(h->batchPlan[0]);
+        if(h->batchPlan[1]!=NULL)
+            saf_fft_plan_release(h->batchPlan[1]);
 #endif
-        if(h->useKissFFT_flag){
-            kiss_fft_free(h->kissFFThandle_fwd);
-            kiss_fft_free(h->kissFFThandle_bkw);
-        }
+        saf_fft_plan_release(h->plan);
         free(h);
         h=NULL;
     }
@@ -752,3 +1087,73 @@ void saf_fft_backward
             outputTD[i] = crmulf(outputTD[i], 1.0f/(float)(h->N));
     }
 }
+
+void saf_fft_forward_batch
+(
+    void * const hFFT,
+    int nTransforms,
+    float_complex* inputTD,
+    int inDist,
+    float_complex* outputFD,
+    int outDist
+)
+{
+    saf_fft_data *h = (saf_fft_data*)(hFFT);
+    int i;
+#if defined(INTEL_MKL_VERSION)
+    saf_fft_plan* p;
+    if(nTransforms>1){
+        /* (never looked up or created here, see saf_fft_prepareBatch()) */
+        p = saf_fft_plan_findBatch(h->batchPlan, nTransforms, inDist, outDist);
+        assert(p!=NULL);
+        if(p!=NULL){
+            h->Status = DftiComputeForward(p->MKL_FFT_Handle, inputTD, outputFD);
+            return;
+        }
+    }
+#endif
+    for(i=0; i<nTransforms; i++)
+        saf_fft_forward(h, &inputTD[i*inDist], &outputFD[i*outDist]);
+}
+
+void saf_fft_backward_batch
+(
+    void * const hFFT,
+    int nTransforms,
+    float_complex* inputFD,
+    int inDist,
+    float_complex* outputTD,
+    int outDist
+)
+{
+    saf_fft_data *h = (saf_fft_data*)(hFFT);
+    int i;
+#if defined(INTEL_MKL_VERSION)
+    saf_fft_plan* p;
+    if(nTransforms>1){
+        /* (never looked up or created here, see saf_fft_prepareBatch()) */
+        p = saf_fft_plan_findBatch(h->batchPlan, nTransforms, inDist, outDist);
+        assert(p!=NULL);
+        if(p!=NULL){
+            h->Status = DftiComputeBackward(p->MKL_FFT_Handle, inputFD, outputTD);
+            return;
+        }
+    }
+#endif
+    for(i=0; i<nTransforms; i++)
+        saf_fft_backward(h, &inputFD[i*inDist], &outputTD[i*outDist]);
+}
+
+void saf_fft_prepareBatch
+(
+    void * const hFFT,
+    int nTransforms,
+    int inDist,
+    int outDist
+)
+{
+#if defined(INTEL_MKL_VERSION)
+    saf_fft_data *h = (saf_fft_data*)(hFFT);
+    saf_fft_plan_prepareBatch(h->batchPlan, h->N, 0, nTransforms, inDist, outDist);
+#endif
+}
@@ -228,6 +228,10 @@ void saf_stft_channelChange(void * const hSTFT,
  * FFT
  *
  * @note Only Even FFT sizes are supported.
+ * @note The twiddle factors/FFT setups are held in a process-wide (thread-safe
+ *       and reference-counted) cache, and shared by all saf_rfft instances of
+ *       the same size. Each instance only allocates its own scratch buffers;
+ *       therefore creating many instances of the same size is cheap.
  *
  * ## Example Usage
  * \code{.c}
@@ -288,6 +292,113 @@ void saf_rfft_backward(void * const hFFT,
                        float_complex* inputFD,
                        float* outputTD);
 
+/**
+ * Performs the forward-FFT operation, with the output in split-complex format
+ * (i.e. the real and imaginary parts are returned in separate vectors)
+ *
+ * This is the native format of Apple Accelerate (vDSP), in which case no
+ * packing/unpacking is required. Other implementations de-interleave their
+ * output internally, so saf_rfft_forward() should be preferred with these.
+ * Split-complex spectra may be processed with e.g. utility_cvvmul_split() and
+ * utility_cvvadd_split().
+ *
+ * @test test__saf_rfft_split()
+ *
+ * @param[in]  hFFT        saf_rfft handle
+ * @param[in]  inputTD     Time-domain input; N x 1
+ * @param[out] outputFD_re Real part of frequency-domain output; (N/2 + 1) x 1
+ * @param[out] outputFD_im Imag part of frequency-domain output; (N/2 + 1) x 1
+ */
+void saf_rfft_forward_split(void * const hFFT,
+                            float* inputTD,
+                            float* outputFD_re,
+                            float* outputFD_im);
+
+/**
+ * Performs the backward-FFT operation, with the input in split-complex format
+ * (see saf_rfft_forward_split())
+ *
+ * @param[in]  hFFT       saf_rfft handle
+ * @param[in]  inputFD_re Real part of frequency-domain input; (N/2 + 1) x 1
+ * @param[in]  inputFD_im Imag part of frequency-domain input; (N/2 + 1) x 1
+ * @param[out] outputTD   Time-domain output;  N x 1
+ */
+void saf_rfft_backward_split(void * const hFFT,
+                             float* inputFD_re,
+                             float* inputFD_im,
+                             float* outputTD);
+
+/**
+ * Performs the forward-FFT operation for a batch of 'nTransforms' real input
+ * vectors (e.g. one per channel) in a single call
+ *
+ * Vector i is read from inputTD[i*inDist] and its spectrum is written to
+ * outputFD[i*outDist]. The result is identical to calling saf_rfft_forward()
+ * for each vector, but the whole batch is handed to MKL (via
+ * DFTI_NUMBER_OF_TRANSFORMS) when it is linked, instead of paying the dispatch
+ * cost per vector.
+ *
+ * @note The batch (i.e. nTransforms, inDist and outDist) must be prepared
+ *       beforehand with saf_rfft_prepareBatch(), as batches are never set up
+ *       by this function; if it was not, then the vectors are transformed one
+ *       at a time (and debug builds assert).
+ *
+ * @test test__saf_rfft_batch()
+ *
+ * @param[in]  hFFT        saf_rfft handle
+ * @param[in]  nTransforms Number of transforms
+ * @param[in]  inputTD     Time-domain input; FLAT: nTransforms x inDist
+ * @param[in]  inDist      Distance (in samples) between input vectors; >=N
+ * @param[out] outputFD    Frequency-domain output; FLAT: nTransforms x outDist
+ * @param[in]  outDist     Distance (in bins) between output vectors; >=N/2+1
+ */
+void saf_rfft_forward_batch(void * const hFFT,
+                            int nTransforms,
+                            float* inputTD,
+                            int inDist,
+                            float_complex* outputFD,
+                            int outDist);
+
+/**
+ * Performs the backward-FFT operation for a batch of 'nTransforms'
+ * half-complex input vectors in a single call (see saf_rfft_forward_batch())
+ *
+ * @param[in]  hFFT        saf_rfft handle
+ * @param[in]  nTransforms Number of transforms
+ * @param[in]  inputFD     Frequency-domain input; FLAT: nTransforms x inDist
+ * @param[in]  inDist      Distance (in bins) between input vectors; >=N/2+1
+ * @param[out] outputTD    Time-domain output; FLAT: nTransforms x outDist
+ * @param[in]  outDist     Distance (in samples) between output vectors; >=N
+ */
+void saf_rfft_backward_batch(void * const hFFT,
+                             int nTransforms,
+                             float_complex* inputFD,
+                             int inDist,
+                             float* outputTD,
+                             int outDist);
+
+/**
+ * Prepares a batch for saf_rfft_forward_batch() and saf_rfft_backward_batch(),
+ * which may then be called with the same nTransforms, inDist and outDist
+ * (note that inDist and outDist refer to the input and output of the call, so
+ * a forward and backward batch of the same vectors are prepared separately)
+ *
+ * The two most recently prepared batches are kept. This is not real-time
+ * safe, as the batch descriptors are created (or looked up) here; so call it
+ * when setting up the processing, and whenever the number of channels changes.
+ *
+ * @test test__saf_rfft_batch()
+ *
+ * @param[in] hFFT        saf_rfft handle
+ * @param[in] nTransforms Number of transforms
+ * @param[in] inDist      Distance between the input vectors
+ * @param[in] outDist     Distance between the output vectors
+ */
+void saf_rfft_prepareBatch(void * const hFFT,
+                           int nTransforms,
+                           int inDist,
+                           int outDist);
+
 
 /* ========================================================================== */
 /*                            Complex<->Complex FFT                           */
@@ -297,6 +408,8 @@ void saf_rfft_backward(void * const hFFT,
  * Creates an instance of saf_fft; complex<->complex FFT
  *
  * @note Only Even FFT sizes are supported.
+ * @note The plans are shared between instances of the same size (see
+ *       saf_rfft_create())
  *
  * @param[in] phFFT (&) address of saf_fft handle
  * @param[in] N     FFT size
@@ -335,6 +448,58 @@ void saf_fft_backward(void * const hFFT,
                       float_complex* inputFD,
                       float_complex* outputTD);
 
+/**
+ * Performs the forward-FFT operation for a batch of 'nTransforms' complex
+ * input vectors in a single call (see saf_rfft_forward_batch())
+ *
+ * @test test__saf_rfft_batch()
+ *
+ * @param[in]  hFFT        saf_fft handle
+ * @param[in]  nTransforms Number of transforms
+ * @param[in]  inputTD     Time-domain input; FLAT: nTransforms x inDist
+ * @param[in]  inDist      Distance (in samples) between input vectors; >=N
+ * @param[out] outputFD    Frequency-domain output; FLAT: nTransforms x outDist
+ * @param[in]  outDist     Distance (in bins) between output vectors; >=N
+ */
+void saf_fft_forward_batch(void * const hFFT,
+                           int nTransforms,
+                           float_complex* inputTD,
+                           int inDist,
+                           float_complex* outputFD,
+                           int outDist);
+
+/**
+ * Performs the backward-FFT operation for a batch of 'nTransforms' complex
+ * input vectors in a single call (see saf_rfft_forward_batch())
+ *
+ * @param[in]  hFFT        saf_fft handle
+ * @param[in]  nTransforms Number of transforms
+ * @param[in]  inputFD     Frequency-domain input; FLAT: nTransforms x inDist
+ * @param[in]  inDist      Distance (in bins) between input vectors; >=N
+ * @param[out] outputTD    Time-domain output; FLAT: nTransforms x outDist
+ * @param[in]  outDist     Distance (in samples) between output vectors; >=N
+ */
+void saf_fft_backward_batch(void * const hFFT,
+                            int nTransforms,
+                            float_complex* inputFD,
+                            int inDist,
+                            float_complex* outputTD,
+                            int outDist);
+
+/**
+ * Prepares a batch for saf_fft_forward_batch() and saf_fft_backward_batch()
+ * (see saf_rfft_prepareBatch())
+ *
+ * @param[in] hFFT        saf_fft handle
+ * @param[in] nTransforms Number of transforms
+ * @param[in] inDist      Distance between the input vectors
+ * @param[in] outDist     Distance between the output vectors
+ */
+void saf_fft_prepareBatch(void * const hFFT,
+                          int nTransforms,
+                          int inDist,
+                          int outDist);
+
 
 #ifdef __cplusplus
 }/* extern "C" */
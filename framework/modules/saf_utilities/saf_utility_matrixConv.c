@@ -27,6 +27,913 @@
 #include "saf_utility_matrixConv.h"
 
 
+/* ========================================================================== */
+/*                          Internal Filter Sets                              */
+/* ========================================================================== */
+
+/** Filter partitions and input blocks with no sample magnitudes above this
+ *  threshold (-180dB) are treated as zero, and their products are skipped */
+#define MATRIXCONV_SILENCE_THRESHOLD ( 1e-9f )
+
+/** Returns '1' if all samples are below #MATRIXCONV_SILENCE_THRESHOLD */
+static int safConv_isSilent
+(
+    float* x,
+    int len
+)
+{
+    int idx;
+
+    utility_simaxv(x, len, &idx);
+    return fabsf(x[idx]) <= MATRIXCONV_SILENCE_THRESHOLD;
+}
+
+/* All spectra (filters, inputs and outputs) occupy 2 x nBins floats. They are
+ * held in split-complex format (real parts followed by imaginary parts) if
+ * this is the native format of the FFT (Apple Accelerate), and as interleaved
+ * float_complex otherwise; such that no (de)interleaving is ever required */
+#if defined(__ACCELERATE__)
+# define MATRIXCONV_SPLIT_SPECTRA
+#endif
+
+/** Forward FFT of 'x' into the spectrum 'X' (2 x nBins) */
+static void safConv_fft
+(
+    void* hFFT,
+    float* x,
+    int nBins,
+    float* X
+)
+{
+#ifdef MATRIXCONV_SPLIT_SPECTRA
+    saf_rfft_forward_split(hFFT, x, X, &X[nBins]);
+#else
+    (void)nBins;
+    saf_rfft_forward(hFFT, x, (float_complex*)X);
+#endif
+}
+
+/** Backward FFT of the spectrum 'Y' (2 x nBins) into 'y' */
+static void safConv_ifft
+(
+    void* hFFT,
+    float* Y,
+    int nBins,
+    float* y
+)
+{
+#ifdef MATRIXCONV_SPLIT_SPECTRA
+    saf_rfft_backward_split(hFFT, Y, &Y[nBins], y);
+#else
+    (void)nBins;
+    saf_rfft_backward(hFFT, (float_complex*)Y, y);
+#endif
+}
+
+/** Counters of the spectral multiply-accumulate operations (per bin) */
+typedef struct _safConvCounters {
+    unsigned long long nComputed;      /**< Number performed */
+    unsigned long long nSkippedFilter; /**< Number skipped due to zero filters */
+    unsigned long long nSkippedInput;  /**< Number skipped due to silent input */
+
+}safConvCounters;
+
+/**
+ * Describes how the filters are partitioned for one block size: numPart
+ * partitions of partLen taps, starting at filter tap 'tapOffset', each zero
+ * padded to fftSize.
+ */
+typedef struct _safConvLayout {
+    int fftSize, partLen, numPart, tapOffset;
+
+}safConvLayout;
+
+/**
+ * A set of filter spectra, which may be prepared off the audio thread and then
+ * swapped in by the convolver that created it (see safConvSwap).
+ */
+typedef struct _safConvFilters {
+    void* owner;          /**< Handle of the convolver these are intended for */
+    int nLayouts;         /**< Number of layouts (block sizes) */
+    int fadeHops;         /**< Crossfade length in hops, once swapped in */
+    float** H_f;          /**< nLayouts x FLAT: nCHout x numPart x nIn x 2 x nBins */
+    int** nzFLAG;         /**< '0' if the partition is zero (or below
+                           *   #MATRIXCONV_SILENCE_THRESHOLD), '1' otherwise;
+                           *   nLayouts x FLAT: nCHout x numPart x nIn */
+    int nJobs;            /**< Number of worker thread jobs in flight which
+                           *   use this set (audio thread only) */
+
+}safConvFilters;
+
+/**
+ * Creates a filter set, by zero padding and transforming the filter partitions
+ * of each layout
+ *
+ * @param[in] pfs      (&) address of the filter set
+ * @param[in] owner    Handle of the convolver these filters are intended for
+ * @param[in] H        Filters; FLAT: nCHout x nIn x length_h
+ * @param[in] length_h Length of the filters
+ * @param[in] nIn      Number of filters per output channel
+ * @param[in] nCHout   Number of output channels
+ * @param[in] nLayouts Number of layouts
+ * @param[in] layout   Layouts; nLayouts x 1
+ */
+static void safConvFilters_create
+(
+    safConvFilters** pfs,
+    void* owner,
+    float* H,
+    int length_h,
+    int nIn,
+    int nCHout,
+    int nLayouts,
+    safConvLayout* layout
+)
+{
+    safConvFilters* fs;
+    int l, i, no, ni, p, nBins, len, tap;
+    void* hFFT;
+    float* h_pad, *H_p;
+
+    *pfs = malloc1d(sizeof(safConvFilters));
+    fs = *pfs;
+    fs->owner = owner;
+    fs->nLayouts = nLayouts;
+    fs->fadeHops = 0;
+    fs->nJobs = 0;
+    fs->H_f = malloc1d(nLayouts*sizeof(float*));
+    fs->nzFLAG = malloc1d(nLayouts*sizeof(int*));
+    for(l=0; l<nLayouts; l++){
+        nBins = layout[l].fftSize/2 + 1;
+        fs->H_f[l] = malloc1d(nCHout*(layout[l].numPart)*nIn*2*nBins*sizeof(float));
+        fs->nzFLAG[l] = malloc1d(nCHout*(layout[l].numPart)*nIn*sizeof(int));
+        saf_rfft_create(&hFFT, layout[l].fftSize);
+        h_pad = calloc1d(layout[l].fftSize, sizeof(float));
+        for(no=0; no<nCHout; no++){
+            for(p=0; p<layout[l].numPart; p++){
+                tap = layout[l].tapOffset + p*(layout[l].partLen);
+                len = MIN(layout[l].partLen, length_h - tap);
+                for(ni=0; ni<nIn; ni++){
+                    /* zero pad each partition to be fftSize */
+                    memset(h_pad, 0, layout[l].fftSize*sizeof(float));
+                    for(i=0; i<len; i++)
+                        h_pad[i] = H[no*nIn*length_h + ni*length_h + tap + i];
+                    fs->nzFLAG[l][(no*(layout[l].numPart) + p)*nIn + ni] = !safConv_isSilent(h_pad, MAX(len, 1));
+                    H_p = &(fs->H_f[l][((no*(layout[l].numPart) + p)*nIn + ni)*2*nBins]);
+                    safConv_fft(hFFT, h_pad, nBins, H_p);
+                }
+            }
+        }
+        saf_rfft_destroy(&hFFT);
+        free(h_pad);
+    }
+}
+
+/**
+ * Destroys a filter set
+ *
+ * @param[in] pfs (&) address of the filter set
+ */
+static void safConvFilters_destroy
+(
+    safConvFilters** pfs
+)
+{
+    safConvFilters* fs = *pfs;
+    int l;
+
+    if(fs!=NULL){
+        for(l=0; l<fs->nLayouts; l++){
+            free(fs->H_f[l]);
+            free(fs->nzFLAG[l]);
+        }
+        free(fs->H_f);
+        free(fs->nzFLAG);
+        free(fs);
+        *pfs = NULL;
+    }
+}
+
+/**
+ * Multiplies the filter partitions of one output channel with their
+ * corresponding input spectra, and sums the products into Y_n (or adds them to
+ * Y_n if accumulateFLAG is '1'). Partition 'p' of filter 'ni' is paired with
+ * input channel (chOffset+ni) of slot (start+p)%numSlots. Products involving
+ * zero filter partitions or silent input blocks are skipped.
+ *
+ * @returns The number of products which were computed. If this is 0 and
+ *          accumulateFLAG is '0', then Y_n is not written (i.e. it is zero)
+ */
+static int safConv_accumulate
+(
+    float* H_f,           /* FLAT: numPart x nIn x 2 x nBins */
+    int* nzFLAG,          /* FLAT: numPart x nIn */
+    float* X_n,           /* FLAT: numSlots x nCHin x 2 x nBins */
+    int* activeFLAG,      /* FLAT: numSlots x nCHin */
+    int numPart,
+    int nIn,
+    int numSlots,
+    int start,
+    int nCHin,
+    int chOffset,
+    int nBins,
+    float* Y_n,           /* 2 x nBins */
+    int accumulateFLAG,
+    safConvCounters* cnt
+)
+{
+    int p, ni, slot, nProd;
+    float* H_p, *X_p;
+
+    nProd = 0;
+    for(p=0; p<numPart; p++){
+        slot = (start+p) % numSlots;
+        for(ni=0; ni<nIn; ni++){
+            if(!nzFLAG[p*nIn+ni])
+                cnt->nSkippedFilter += nBins;
+            else if(!activeFLAG[slot*nCHin+chOffset+ni])
+                cnt->nSkippedInput += nBins;
+            else{
+                H_p = &(H_f[(p*nIn+ni)*2*nBins]);
+                X_p = &(X_n[(slot*nCHin+chOffset+ni)*2*nBins]);
+#ifdef MATRIXCONV_SPLIT_SPECTRA
+                if(nProd==0 && !accumulateFLAG)
+                    utility_cvvmul_split(H_p, &H_p[nBins], X_p, &X_p[nBins], nBins, Y_n, &Y_n[nBins]);
+                else /* This is the bulk of the CPU work */
+                    utility_cvvmuladd_split(H_p, &H_p[nBins], X_p, &X_p[nBins], nBins, NO_CONJ, Y_n, &Y_n[nBins]);
+#else
+                if(nProd==0 && !accumulateFLAG)
+                    utility_cvvmul((float_complex*)H_p, (float_complex*)X_p, nBins, (float_complex*)Y_n);
+                else /* This is the bulk of the CPU work */
+                    utility_cvvmuladd((float_complex*)H_p, (float_complex*)X_p, nBins, NO_CONJ, (float_complex*)Y_n);
+#endif
+                nProd++;
+            }
+        }
+    }
+    cnt->nComputed += (unsigned long long)nProd*nBins;
+    return nProd;
+}
+
+/**
+ * Computes the spectrum of one output channel (as in safConv_accumulate()),
+ * using filter set 'fs', or, if fsOld is not NULL, crossfaded between the two
+ * filter sets: gain*(fs result) + (1-gain)*(fsOld result), where gain>0.
+ * 'l' is the layout index and 'idx' is the index of the output channel's first
+ * partition (i.e. no*numPart*nIn).
+ *
+ * @returns '0' if the spectrum is zero (and Y_n was not written), '1' otherwise
+ */
+static int safConv_filter
+(
+    safConvFilters* fs,
+    safConvFilters* fsOld,
+    float gain,
+    int l,
+    int idx,
+    float* X_n,
+    int* activeFLAG,
+    int numPart,
+    int nIn,
+    int numSlots,
+    int start,
+    int nCHin,
+    int chOffset,
+    int nBins,
+    float* Y_n,
+    safConvCounters* cnt
+)
+{
+    int nOld, nNew;
+    float scale;
+
+    nOld = 0;
+    if(fsOld!=NULL){
+        nOld = safConv_accumulate(&(fsOld->H_f[l][idx*2*nBins]), &(fsOld->nzFLAG[l][idx]), X_n, activeFLAG, numPart, nIn,
+                                  numSlots, start, nCHin, chOffset, nBins, Y_n, 0, cnt);
+        if(nOld>0){
+            scale = (1.0f-gain)/gain;
+            utility_svsmul(Y_n, &scale, 2*nBins, Y_n);
+        }
+    }
+    nNew = safConv_accumulate(&(fs->H_f[l][idx*2*nBins]), &(fs->nzFLAG[l][idx]), X_n, activeFLAG, numPart, nIn,
+                              numSlots, start, nCHin, chOffset, nBins, Y_n, nOld>0, cnt);
+    if(fsOld!=NULL && nOld+nNew>0)
+        utility_svsmul(Y_n, &gain, 2*nBins, Y_n);
+    return nOld+nNew>0;
+}
+
+/**
+ * Filter swapping state, which is shared by all convolver modes.
+ *
+ * A new filter set is queued (off the audio thread) via the 'pending' slot,
+ * and is adopted by the audio thread at the start of the next hop. The
+ * previous set is then faded out over 'fadeHops' hops, by weighting the
+ * spectra of each input block with (1-gain) for the previous set and (gain)
+ * for the new set. Once no longer referenced, the previous set is placed in
+ * the 'retired' slot, from which it is freed off the audio thread.
+ */
+typedef struct _safConvSwap {
+    safConvFilters* cur;    /**< Current filter set (audio thread only) */
+    safConvFilters* old;    /**< Set being faded out (audio thread only) */
+    int fadeIdx;            /**< Hops since the swap (audio thread only) */
+    void* volatile pending; /**< Set queued by the non-RT side */
+    void* volatile retired; /**< Set awaiting release on the non-RT side */
+    volatile int busyFLAG;  /**< '1': a swap is queued or in progress */
+
+}safConvSwap;
+
+/** Initialises the swapping state with the initial filter set */
+static void safConvSwap_init
+(
+    safConvSwap* sw,
+    safConvFilters* fs
+)
+{
+    sw->cur = fs;
+    sw->old = NULL;
+    sw->fadeIdx = 0;
+    sw->pending = sw->retired = NULL;
+    sw->busyFLAG = 0;
+}
+
+/** Frees all filter sets held by the swapping state */
+static void safConvSwap_free
+(
+    safConvSwap* sw
+)
+{
+    safConvFilters* fs;
+
+    safConvFilters_destroy(&(sw->cur));
+    safConvFilters_destroy(&(sw->old));
+    fs = (safConvFilters*)sw->pending;
+    safConvFilters_destroy(&fs);
+    fs = (safConvFilters*)sw->retired;
+    safConvFilters_destroy(&fs);
+    sw->pending = sw->retired = NULL;
+}
+
+/** Frees the retired filter set, if any (non-RT side) */
+static void safConvSwap_release
+(
+    safConvSwap* sw
+)
+{
+    safConvFilters* fs;
+
+    fs = (safConvFilters*)saf_atomic_exchangePtr(&(sw->retired), NULL);
+    safConvFilters_destroy(&fs);
+}
+
+/**
+ * Queues a filter set to be swapped in (non-RT side). Returns '0' if a
+ * previous swap is still in progress, in which case the caller retains
+ * ownership of 'fs'
+ */
+static int safConvSwap_request
+(
+    safConvSwap* sw,
+    safConvFilters* fs,
+    int fadeHops
+)
+{
+    if(saf_atomic_loadInt(&(sw->busyFLAG)))
+        return 0;
+    safConvSwap_release(sw);
+    fs->fadeHops = MAX(fadeHops, 0);
+    saf_atomic_storeInt(&(sw->busyFLAG), 1);
+    saf_atomic_storePtr(&(sw->pending), (void*)fs);
+    return 1;
+}
+
+/**
+ * Adopts any queued filter set (audio thread, start of hop), and returns the
+ * weight to apply to the current set. If a crossfade is in progress, then
+ * the previous set should be weighted by (1-gain)
+ */
+static float safConvSwap_begin
+(
+    safConvSwap* sw
+)
+{
+    safConvFilters* fs;
+
+    if(sw->old==NULL && saf_atomic_loadPtr(&(sw->pending))!=NULL){
+        fs = (safConvFilters*)saf_atomic_exchangePtr(&(sw->pending), NULL);
+        sw->old = sw->cur;
+        sw->cur = fs;
+        sw->fadeIdx = 0;
+    }
+    if(sw->old==NULL || sw->fadeIdx>=sw->cur->fadeHops)
+        return 1.0f;
+    return (float)(sw->fadeIdx+1)/(float)(sw->cur->fadeHops+1);
+}
+
+/**
+ * Advances the crossfade (audio thread, end of hop), and retires the previous
+ * set once the crossfade is complete, and no worker thread jobs which use it
+ * remain in flight (including those dispatched prior to the swap, which apply
+ * it as their current set)
+ */
+static void safConvSwap_end
+(
+    safConvSwap* sw
+)
+{
+    if(sw->old!=NULL){
+        if(sw->fadeIdx<sw->cur->fadeHops)
+            sw->fadeIdx++;
+        if(sw->fadeIdx>=sw->cur->fadeHops && sw->old->nJobs==0){
+            saf_atomic_storePtr(&(sw->retired), (void*)sw->old);
+            sw->old = NULL;
+            saf_atomic_storeInt(&(sw->busyFLAG), 0);
+        }
+    }
+}
+
+
+/* ========================================================================== */
+/*                      Internal Partitioned Convolution Engine               */
+/* ========================================================================== */
+
+/** Maximum block size used for the tail partitions of the non-uniform scheme */
+#define MATRIXCONV_MAX_PART_BLOCKSIZE ( 16384 )
+/** Minimum number of hops between a segment being dispatched to the worker
+ *  thread and its output being required (see safPartConv_create) */
+#define MATRIXCONV_MIN_ASYNC_SLACK ( 2 )
+
+/**
+ * Data structure for one segment of uniformly partitioned filters.
+ *
+ * A segment covers the filter taps [offset, offset+numPart*blockSize), split
+ * into numPart partitions of blockSize length. The input spectra are held in a
+ * circular frequency-domain delay-line (FDL) of numSlots blocks, where the most
+ * recent block resides in slot 'fdlIdx', and the block which is 'j' blocks old
+ * resides in slot (fdlIdx+j)%numSlots. Partition 'p' is paired with the block
+ * which is (p+blockDelay) blocks old, such that all products land at the same
+ * output position, which is 'outOffset' samples after the start of the most
+ * recent input block. The filter spectra of the segment are held by the
+ * filter sets (see safConvFilters).
+ */
+typedef struct _safConvSegment {
+    int blockSize, fftSize, nBins;
+    int numPart, numSlots, blockDelay, outOffset;
+    int fdlIdx;
+    void* hFFT;
+    float* X_n;           /**< FDL; FLAT: numSlots x nCHin x 2 x nBins */
+    int* activeFLAG;      /**< '0' if the FDL block is silent; FLAT: numSlots x nCHin */
+    float* Y_n;           /**< 2 x nBins */
+    float* x_pad, *z_n;   /**< fftSize x 1 */
+
+    /* Only used by segments computed on the worker thread */
+    int asyncFLAG;        /**< '1': segment is computed on the worker thread */
+    int slack;            /**< Number of hops until the output is required */
+    int pending;          /**< '1': a job is in flight (audio thread only) */
+    int hopsLeft;         /**< Hops remaining until the pending job's deadline */
+    int outPos;           /**< Output buffer position of the pending job */
+    float* stage;         /**< Output of the pending job; FLAT: nCHout x fftSize */
+
+}safConvSegment;
+
+/** Job passed between the audio and worker threads */
+typedef struct _safPartConv_job {
+    int segIdx;           /**< Index of the segment to process */
+    int blockEnd;         /**< See safPartConv_processSegment() */
+    safConvFilters* fs;   /**< Filter set to apply */
+    safConvFilters* fsOld;/**< Filter set being faded out (or NULL) */
+    float gain;           /**< Crossfade gain (see safConvSwap_begin()) */
+    safConvCounters cnt;  /**< Counters of the job (added to the engine's) */
+
+}safPartConv_job;
+
+/**
+ * Data structure for the (uniformly or non-uniformly) partitioned convolution
+ * engine, which is shared by the matrix and multi-channel convolvers.
+ *
+ * The input signals are written to circular buffers, from which each segment
+ * takes its input blocks (every blockSize/hopSize hops). The output of each
+ * segment is overlap-added into circular output accumulation buffers, which are
+ * read out one hop at a time.
+ */
+typedef struct _safPartConv_data {
+    int hopSize, nCHin, nCHout;
+    int diagFLAG;         /**< '1': output 'n' only uses input 'n' (multiConv) */
+    int nSeg;             /**< Number of segments */
+    safConvSegment* seg;  /**< Segments; nSeg x 1 */
+    int inLen, outLen;    /**< Lengths of the circular in/output buffers */
+    int inIdx, outIdx;    /**< Current in/output buffer positions */
+    float* inBuffer;      /**< FLAT: nCHin x inLen */
+    float* outBuffer;     /**< FLAT: nCHout x outLen */
+    safConvCounters cnt;  /**< Counters (audio thread only) */
+
+    /* Worker thread (only if there are segments with asyncFLAG=1) */
+    int nAsync;           /**< Number of segments computed on the worker thread */
+    void* hThread;        /**< Worker thread handle */
+    void* hSem;           /**< Signalled whenever a job is pushed (or on exit) */
+    void* hJobRing;       /**< SPSC ring: audio thread -> worker thread */
+    void* hDoneRing;      /**< SPSC ring: worker thread -> audio thread */
+    volatile int exitFLAG;/**< '1': worker thread should return */
+
+}safPartConv_data;
+
+static void* safPartConv_worker(void* arg);
+
+/**
+ * Creates the partitioned convolution engine.
+ *
+ * If nonUniformFLAG is '0', then the filters are uniformly partitioned using
+ * hopSize blocks (i.e. a single segment). Otherwise, a non-uniform (Gardner
+ * style) scheme is employed: two partitions of each block size, starting at
+ * hopSize and doubling for each subsequent segment up to
+ * MATRIXCONV_MAX_PART_BLOCKSIZE, with the last segment covering the remainder
+ * of the filters. The segment offsets are such that every segment may be
+ * computed at its own (lower) rate, without adding any latency.
+ *
+ * If threadedFLAG is '1', then the segments whose output is not required until
+ * at least MATRIXCONV_MIN_ASYNC_SLACK hops after their input block is complete
+ * (i.e. those with block sizes of 4*hopSize or more) are computed on a worker
+ * thread. Since a segment's deadline always precedes its next input block, at
+ * most one job per segment is in flight at any time.
+ *
+ * @param[in]  phPC           (&) address of the engine handle
+ * @param[in]  hopSize        Hop size in samples
+ * @param[in]  length_h       Length of the filters
+ * @param[in]  nCHin          Number of input channels
+ * @param[in]  nCHout         Number of output channels
+ * @param[in]  diagFLAG       '1': output 'n' only uses input 'n'
+ * @param[in]  nonUniformFLAG '0': uniform partitions, '1': non-uniform
+ * @param[in]  threadedFLAG   '1': compute the tail segments on a worker thread
+ * @param[out] pLayout        (&) filter layouts, one per segment (see
+ *                            safConvFilters_create()); nSeg x 1
+ * @returns    The number of segments
+ */
+static int safPartConv_create
+(
+    safPartConv_data** phPC,
+    int hopSize,
+    int length_h,
+    int nCHin,
+    int nCHout,
+    int diagFLAG,
+    int nonUniformFLAG,
+    int threadedFLAG,
+    safConvLayout** pLayout
+)
+{
+    safPartConv_data* h;
+    safConvSegment* sg;
+    int s, offset, blockSize, numPart, remaining, maxBlockSize;
+
+    *phPC = malloc1d(sizeof(safPartConv_data));
+    h = *phPC;
+    h->hopSize = hopSize;
+    h->nCHin = nCHin;
+    h->nCHout = nCHout;
+    h->diagFLAG = diagFLAG;
+
+    /* Determine the partitioning scheme */
+    h->nSeg = 0;
+    h->seg = NULL;
+    offset = 0;
+    blockSize = hopSize;
+    maxBlockSize = MAX(hopSize, MATRIXCONV_MAX_PART_BLOCKSIZE);
+    while(offset < length_h){
+        remaining = length_h - offset;
+        if(!nonUniformFLAG || blockSize>=maxBlockSize || remaining<=2*blockSize)
+            numPart = (remaining + blockSize - 1)/blockSize; /* last segment */
+        else
+            numPart = 2;
+        h->seg = realloc1d(h->seg, (h->nSeg+1)*sizeof(safConvSegment));
+        sg = &(h->seg[h->nSeg]);
+        sg->blockSize = blockSize;
+        sg->numPart = numPart;
+        /* The earliest output position of the segment must not precede the
+         * current hop, i.e. outOffset>=blockSize-hopSize */
+        sg->blockDelay = (offset - (blockSize - hopSize))/blockSize;
+        sg->outOffset = offset - (sg->blockDelay)*blockSize;
+        sg->numSlots = numPart + sg->blockDelay;
+        sg->slack = (sg->outOffset - (blockSize - hopSize))/hopSize;
+        sg->asyncFLAG = threadedFLAG && sg->slack>=MATRIXCONV_MIN_ASYNC_SLACK;
+        h->nSeg++;
+        offset += numPart*blockSize;
+        blockSize *= 2;
+    }
+    assert(h->nSeg>=1);
+
+    /* Initialise the segments, and describe the filter partitions */
+    *pLayout = malloc1d(h->nSeg*sizeof(safConvLayout));
+    h->nAsync = 0;
+    for(s=0; s<h->nSeg; s++){
+        sg = &(h->seg[s]);
+        sg->fftSize = 2*(sg->blockSize);
+        sg->nBins = sg->blockSize+1;
+        sg->fdlIdx = 0;
+        sg->pending = sg->hopsLeft = sg->outPos = 0;
+        sg->stage = sg->asyncFLAG ? malloc1d(nCHout*(sg->fftSize)*sizeof(float)) : NULL;
+        h->nAsync += sg->asyncFLAG;
+        saf_rfft_create(&(sg->hFFT), sg->fftSize);
+        sg->X_n = calloc1d((sg->numSlots)*nCHin*2*(sg->nBins), sizeof(float));
+        sg->activeFLAG = calloc1d((sg->numSlots)*nCHin, sizeof(int));
+        sg->Y_n = malloc1d(2*(sg->nBins)*sizeof(float));
+        sg->x_pad = calloc1d(sg->fftSize, sizeof(float));
+        sg->z_n = malloc1d((sg->fftSize)*sizeof(float));
+        (*pLayout)[s].fftSize = sg->fftSize;
+        (*pLayout)[s].partLen = sg->blockSize;
+        (*pLayout)[s].numPart = sg->numPart;
+        (*pLayout)[s].tapOffset = sg->outOffset + (sg->blockDelay)*(sg->blockSize);
+    }
+
+    /* Circular in/output buffers. Each segment reads its most recent input
+     * block, which ends at a multiple of its block size (all of which are
+     * factors of inLen). Segment outputs may extend up to
+     * (outOffset + blockSize) samples beyond the current hop. If the worker
+     * thread is used, then the input buffers are doubled in length, such that
+     * the input blocks are not overwritten before their jobs are complete */
+    h->inLen = (h->nAsync>0 ? 2 : 1) * h->seg[h->nSeg-1].blockSize;
+    h->outLen = hopSize;
+    for(s=0; s<h->nSeg; s++)
+        h->outLen = MAX(h->outLen, h->seg[s].outOffset + 2*(h->seg[s].blockSize));
+    h->outLen = ((h->outLen + hopSize - 1)/hopSize + 1)*hopSize; /* multiple of hopSize */
+    h->inIdx = h->outIdx = 0;
+    memset(&(h->cnt), 0, sizeof(safConvCounters));
+    h->inBuffer = calloc1d(nCHin*(h->inLen), sizeof(float));
+    h->outBuffer = calloc1d(nCHout*(h->outLen), sizeof(float));
+
+    /* Start the worker thread */
+    h->hThread = h->hSem = h->hJobRing = h->hDoneRing = NULL;
+    h->exitFLAG = 0;
+    if(h->nAsync>0){
+        saf_spscRing_create(&(h->hJobRing), h->nAsync, sizeof(safPartConv_job));
+        saf_spscRing_create(&(h->hDoneRing), h->nAsync, sizeof(safPartConv_job));
+        saf_semaphore_create(&(h->hSem));
+        saf_thread_create(&(h->hThread), safPartConv_worker, (void*)h);
+        assert(h->hThread!=NULL);
+    }
+    return h->nSeg;
+}
+
+/**
+ * Destroys the partitioned convolution engine
+ *
+ * @param[in] phPC (&) address of the engine handle
+ */
+static void safPartConv_destroy
+(
+    safPartConv_data** phPC
+)
+{
+    safPartConv_data* h = *phPC;
+    int s;
+
+    if(h!=NULL){
+        if(h->hThread!=NULL){
+            saf_atomic_storeInt(&(h->exitFLAG), 1);
+            saf_semaphore_post(h->hSem);
+            saf_thread_join(&(h->hThread));
+        }
+        saf_semaphore_destroy(&(h->hSem));
+        saf_spscRing_destroy(&(h->hJobRing));
+        saf_spscRing_destroy(&(h->hDoneRing));
+        for(s=0; s<h->nSeg; s++){
+            saf_rfft_destroy(&(h->seg[s].hFFT));
+            free(h->seg[s].X_n);
+            free(h->seg[s].activeFLAG);
+            free(h->seg[s].Y_n);
+            free(h->seg[s].x_pad);
+            free(h->seg[s].z_n);
+            free(h->seg[s].stage);
+        }
+        free(h->seg);
+        free(h->inBuffer);
+        free(h->outBuffer);
+        free(h);
+        *phPC = NULL;
+    }
+}
+
+/**
+ * Overlap-adds 'len' samples into the circular output buffer of channel 'no',
+ * starting at position 'outPos'
+ */
+static void safPartConv_overlapAdd
+(
+    safPartConv_data* h,
+    int no,
+    float* z,
+    int len,
+    int outPos
+)
+{
+    int len1;
+    float* out;
+
+    len1 = MIN(len, h->outLen - outPos);
+    out = &(h->outBuffer[no*(h->outLen)]);
+    utility_svvadd(&out[outPos], z, len1, &out[outPos]);
+    if(len1<len)
+        utility_svvadd(out, &z[len1], len-len1, out);
+}
+
+/**
+ * Processes the most recent input block of segment 's'. 'blockEnd' is the
+ * position in the circular input buffer immediately after the most recent
+ * input block. The result is overlap-added into the output buffers at 'outPos',
+ * or, if out is not NULL, written to 'out' (FLAT: nCHout x fftSize) instead.
+ * If fsOld is not NULL, then the result is crossfaded between the two filter
+ * sets (see safConv_filter()). The operation counters are added to 'cnt'.
+ */
+static void safPartConv_processSegment
+(
+    safPartConv_data* h,
+    int s,
+    int blockEnd,
+    int outPos,
+    float* out,
+    safConvFilters* fs,
+    safConvFilters* fsOld,
+    float gain,
+    safConvCounters* cnt
+)
+{
+    safConvSegment* sg;
+    int ni, no, nIn, start, slot;
+
+    sg = &(h->seg[s]);
+    nIn = h->diagFLAG ? 1 : h->nCHin;
+
+    /* Write the spectra of the most recent input block into the FDL (unless
+     * the block is silent, in which case its products are skipped) */
+    sg->fdlIdx = sg->fdlIdx==0 ? sg->numSlots-1 : sg->fdlIdx-1;
+    for(ni=0; ni<h->nCHin; ni++){
+        slot = (sg->fdlIdx)*(h->nCHin) + ni;
+        memcpy(sg->x_pad, &(h->inBuffer[ni*(h->inLen) + blockEnd - (sg->blockSize)]), sg->blockSize*sizeof(float));
+        sg->activeFLAG[slot] = !safConv_isSilent(sg->x_pad, sg->blockSize);
+        if(sg->activeFLAG[slot])
+            safConv_fft(sg->hFFT, sg->x_pad, sg->nBins, &(sg->X_n[2*slot*(sg->nBins)]));
+    }
+
+    /* FDL slot of the first partition */
+    start = (sg->fdlIdx + sg->blockDelay) % (sg->numSlots);
+
+    for(no=0; no<h->nCHout; no++){
+        /* Accumulate over all partitions (and input channels) in the frequency
+         * domain, and then apply a single ifft for this output channel */
+        if(!safConv_filter(fs, fsOld, gain, s, no*(sg->numPart)*nIn, sg->X_n, sg->activeFLAG, sg->numPart, nIn, sg->numSlots,
+                           start, h->nCHin, h->diagFLAG ? no : 0, sg->nBins, sg->Y_n, cnt)){
+            /* no contribution from this segment */
+            if(out!=NULL)
+                memset(&out[no*(sg->fftSize)], 0, sg->fftSize*sizeof(float));
+            continue;
+        }
+        if(out!=NULL)
+            safConv_ifft(sg->hFFT, sg->Y_n, sg->nBins, &out[no*(sg->fftSize)]);
+        else{
+            safConv_ifft(sg->hFFT, sg->Y_n, sg->nBins, sg->z_n);
+            safPartConv_overlapAdd(h, no, sg->z_n, sg->fftSize, outPos);
+        }
+    }
+}
+
+/**
+ * Worker thread, which processes the jobs pushed by safPartConv_apply() and
+ * returns them (once complete) via the 'done' ring
+ */
+static void* safPartConv_worker
+(
+    void* arg
+)
+{
+    safPartConv_data* h = (safPartConv_data*)arg;
+    safPartConv_job job;
+
+    while(1){
+        saf_semaphore_wait(h->hSem);
+        if(saf_atomic_loadInt(&(h->exitFLAG)))
+            break;
+        while(saf_spscRing_pop(h->hJobRing, &job)){
+            memset(&(job.cnt), 0, sizeof(safConvCounters));
+            safPartConv_processSegment(h, job.segIdx, job.blockEnd, 0, h->seg[job.segIdx].stage, job.fs, job.fsOld, job.gain, &(job.cnt));
+            saf_spscRing_push(h->hDoneRing, &job); /* (cannot be full) */
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Collects the jobs which have been completed by the worker thread, and
+ * overlap-adds their output into the output buffers
+ */
+static void safPartConv_collect
+(
+    safPartConv_data* h
+)
+{
+    int no;
+    safPartConv_job job;
+    safConvSegment* sg;
+
+    while(saf_spscRing_pop(h->hDoneRing, &job)){
+        sg = &(h->seg[job.segIdx]);
+        for(no=0; no<h->nCHout; no++)
+            safPartConv_overlapAdd(h, no, &(sg->stage[no*(sg->fftSize)]), sg->fftSize, sg->outPos);
+        sg->pending = 0;
+        job.fs->nJobs--;
+        if(job.fsOld!=NULL)
+            job.fsOld->nJobs--;
+        h->cnt.nComputed += job.cnt.nComputed;
+        h->cnt.nSkippedFilter += job.cnt.nSkippedFilter;
+        h->cnt.nSkippedInput += job.cnt.nSkippedInput;
+    }
+}
+
+/**
+ * Applies the partitioned convolution engine to one hop of input signals
+ *
+ * @param[in]  h          Engine handle
+ * @param[in]  fs         Filter set to apply
+ * @param[in]  fsOld      Filter set being faded out (or NULL)
+ * @param[in]  gain       Crossfade gain (see safConvSwap_begin())
+ * @param[in]  inputSig   Input signals;  FLAT: nCHin  x hopSize
+ * @param[out] outputSig  Output signals; FLAT: nCHout x hopSize
+ */
+static void safPartConv_apply
+(
+    safPartConv_data* h,
+    safConvFilters* fs,
+    safConvFilters* fsOld,
+    float gain,
+    float* inputSig,
+    float* outputSig
+)
+{
+    int s, ni, no, blockEnd, outPos;
+    safConvSegment* sg;
+    safPartConv_job job;
+
+    /* Append the current hop to the circular input buffers */
+    for(ni=0; ni<h->nCHin; ni++)
+        memcpy(&(h->inBuffer[ni*(h->inLen) + h->inIdx]), &(inputSig[ni*(h->hopSize)]), h->hopSize*sizeof(float));
+    blockEnd = h->inIdx + h->hopSize;
+
+    /* Collect any completed jobs, and count down the deadlines of the rest */
+    if(h->nAsync>0){
+        safPartConv_collect(h);
+        for(s=0; s<h->nSeg; s++)
+            if(h->seg[s].pending)
+                h->seg[s].hopsLeft--;
+    }
+
+    /* Each segment is processed (or dispatched to the worker thread) once a
+     * full input block is available. The output position is relative to the
+     * start of the current hop, which resides at 'outIdx' */
+    for(s=0; s<h->nSeg; s++){
+        sg = &(h->seg[s]);
+        if(blockEnd % (sg->blockSize) == 0){
+            outPos = (h->outIdx + (h->hopSize) - (sg->blockSize) + (sg->outOffset)) % (h->outLen);
+            if(sg->asyncFLAG){
+                assert(!sg->pending);
+                sg->pending = 1;
+                sg->hopsLeft = sg->slack;
+                sg->outPos = outPos;
+                job.segIdx = s;
+                job.blockEnd = blockEnd;
+                job.fs = fs;
+                job.fsOld = fsOld;
+                job.gain = gain;
+                fs->nJobs++;
+                if(fsOld!=NULL)
+                    fsOld->nJobs++;
+                saf_spscRing_push(h->hJobRing, &job); /* (cannot be full) */
+                saf_semaphore_post(h->hSem);
+            }
+            else
+                safPartConv_processSegment(h, s, blockEnd, outPos, NULL, fs, fsOld, gain, &(h->cnt));
+        }
+    }
+    h->inIdx = blockEnd % (h->inLen);
+
+    /* If the worker thread has not yet completed a job which is due, then
+     * there is no choice but to wait for it. This should only happen if the
+     * worker thread is starved of CPU time */
+    if(h->nAsync>0){
+        for(s=0; s<h->nSeg; s++){
+            while(h->seg[s].pending && h->seg[s].hopsLeft==0){
+                saf_thread_yield();
+                safPartConv_collect(h);
+            }
+        }
+    }
+
+    /* Read out the current hop, and clear it for future use */
+    for(no=0; no<h->nCHout; no++){
+        memcpy(&(outputSig[no*(h->hopSize)]), &(h->outBuffer[no*(h->outLen) + h->outIdx]), h->hopSize*sizeof(float));
+        memset(&(h->outBuffer[no*(h->outLen) + h->outIdx]), 0, h->hopSize*sizeof(float));
+    }
+    h->outIdx = (h->outIdx + h->hopSize) % (h->outLen);
+}
+
+
 /* ========================================================================== */
 /*                              Matrix Convolver                              */
 /* ========================================================================== */
@@ -37,12 +944,18 @@
 typedef struct _safMatConv_data {
     int hopSize, fftSize, nBins;
     int length_h, nCHin, nCHout;
-    int numFilterBlocks, numOvrlpAddBlocks;
+    int numOvrlpAddBlocks;
     int usePartFLAG;
     void* hFFT;
-    float* x_pad, *y_pad, *hx_n, *z_n, *ovrlpAddBuffer, *y_n_overlap;
-    float_complex* H_f, *X_n, *HX_n;
-    float_complex** Hpart_f;
+    float* x_pad, *z_n, *ovrlpAddBuffer;
+    float* X_n;            /**< Input spectra; FLAT: nCHin x 2 x nBins */
+    float* Y_n;            /**< Output spectrum; 2 x nBins */
+    int* activeFLAG;       /**< '0' if the input block is silent; nCHin x 1 */
+    safConvCounters cnt;   /**< Counters (non-partitioned mode) */
+    safPartConv_data* hPC; /**< Partitioned convolution engine */
+    int nLayouts;          /**< Number of filter layouts */
+    safConvLayout* layout; /**< Filter layouts; nLayouts x 1 */
+    safConvSwap swap;      /**< Filter sets and swapping state */
     
 }safMatConv_data;
  
@@ -59,8 +972,7 @@ void  saf_matrixConv_create
 {
     *phMC = malloc1d(sizeof(safMatConv_data));
     safMatConv_data *h = (safMatConv_data*)(*phMC);
-    int no, ni, nb;
-    float* h_pad, *h_pad_2hops;
+    safConvFilters* fs;
     
     h->hopSize = hopSize;
     h->length_h = length_h;
@@ -69,6 +981,9 @@ void  saf_matrixConv_create
     h->usePartFLAG = usePartFLAG;
     if(hopSize>length_h && h->usePartFLAG)
         h->usePartFLAG = 0; /* no benefit in partitioning in this case */
+    h->hFFT = NULL;
+    h->hPC = NULL;
+    memset(&(h->cnt), 0, sizeof(safConvCounters));
     
     if(!h->usePartFLAG){
         /* intialise non-partitioned convolution mode */
@@ -76,57 +991,32 @@ void  saf_matrixConv_create
         h->fftSize = (h->numOvrlpAddBlocks)*hopSize;
         h->nBins = h->fftSize/2 + 1;
         
-        /* Allocate memory for buffers and perform fft on H */
+        /* Allocate memory for buffers */
         h->ovrlpAddBuffer = calloc1d(nCHout*(h->fftSize), sizeof(float));
         h->x_pad = calloc1d((h->nCHin)*(h->fftSize), sizeof(float)); // CALLOC
-        h->y_pad = malloc1d((h->nCHout)*(h->fftSize)*sizeof(float));
-        h->hx_n = malloc1d((h->fftSize) * sizeof(float));
-        h->H_f = malloc1d((h->nCHout)*(h->nCHin)*(h->nBins)*sizeof(float_complex));
-        h->X_n = malloc1d((h->nCHin)*(h->nBins)*sizeof(float_complex));
-        h->HX_n = malloc1d((h->nBins)*sizeof(float_complex));
+        h->X_n = malloc1d((h->nCHin)*2*(h->nBins)*sizeof(float));
+        h->Y_n = malloc1d(2*(h->nBins)*sizeof(float));
+        h->activeFLAG = malloc1d((h->nCHin)*sizeof(int));
         h->z_n = malloc1d((h->fftSize) * sizeof(float));
         saf_rfft_create(&(h->hFFT), h->fftSize);
-        h_pad = calloc1d(h->fftSize, sizeof(float));
-        for(no=0; no<nCHout; no++){
-            for(ni=0; ni<nCHin; ni++){
-                memcpy(h_pad, &(H[no*nCHin*length_h+ni*length_h]), length_h*sizeof(float));
-                saf_rfft_forward(h->hFFT, h_pad, &(h->H_f[no*nCHin*(h->nBins)+ni*(h->nBins)]));
-            }
-        }
-        free(h_pad);
+
+        /* The filters are zero padded to fftSize as a single partition */
+        h->nLayouts = 1;
+        h->layout = malloc1d(sizeof(safConvLayout));
+        h->layout[0].fftSize = h->fftSize;
+        h->layout[0].partLen = length_h;
+        h->layout[0].numPart = 1;
+        h->layout[0].tapOffset = 0;
     }
     else{
-        /* intialise partitioned convolution mode */
-        h->fftSize = 2*(h->hopSize);
-        h->nBins = hopSize+1;
-        h->numFilterBlocks = (int)ceilf((float)length_h/(float)hopSize); /* number of partitions */
-        assert(h->numFilterBlocks>=1);
-        
-        /* Allocate memory for buffers and perform fft on partitioned H */
-        h_pad = calloc1d(h->numFilterBlocks * hopSize, sizeof(float));
-        h_pad_2hops = calloc1d(2 * hopSize, sizeof(float));
-        h->Hpart_f = malloc1d(nCHout*sizeof(float_complex*));
-        h->X_n = calloc1d(h->numFilterBlocks * nCHin * (h->nBins), sizeof(float_complex));
-        h->HX_n = malloc1d(h->numFilterBlocks * nCHin * (h->nBins) * sizeof(float_complex));
-        h->x_pad = calloc1d(2 * hopSize, sizeof(float));
-        h->hx_n = malloc1d(h->numFilterBlocks*nCHin*(h->fftSize)*sizeof(float));
-        h->y_n_overlap = calloc1d(nCHout*hopSize, sizeof(float));
-        h->z_n = malloc1d((h->fftSize) * sizeof(float));
-        saf_rfft_create(&(h->hFFT), h->fftSize);
-        for(no=0; no<nCHout; no++){
-            h->Hpart_f[no] = malloc1d(h->numFilterBlocks*nCHin*(h->nBins)*sizeof(float_complex));
-            for(ni=0; ni<nCHin; ni++){
-                memcpy(h_pad, &H[no*nCHin*length_h+ni*length_h], length_h*sizeof(float)); /* zero pad filter, to be multiple of hopsize */
-                for (nb=0; nb<h->numFilterBlocks; nb++){
-                    memcpy(h_pad_2hops, &(h_pad[nb*hopSize]), hopSize*sizeof(float));
-                    saf_rfft_forward(h->hFFT, h_pad_2hops, &(h->Hpart_f[no][nb*nCHin*(h->nBins)+ni*(h->nBins)]));
-                }
-            }
-        }
-        
-        free(h_pad);
-        free(h_pad_2hops);
+        /* intialise (uniformly or non-uniformly) partitioned convolution mode */
+        h->nLayouts = safPartConv_create(&(h->hPC), hopSize, length_h, nCHin, nCHout, 0,
+                                         h->usePartFLAG>=2, h->usePartFLAG==3, &(h->layout));
     }
+
+    /* Perform fft on H */
+    safConvFilters_create(&fs, (void*)h, H, length_h, nCHin, nCHout, h->nLayouts, h->layout);
+    safConvSwap_init(&(h->swap), fs);
 }
 
 void saf_matrixConv_destroy
@@ -135,26 +1025,21 @@ void saf_matrixConv_destroy
 )
 {
     safMatConv_data *h = (safMatConv_data*)(*phMC);
-    int no;
     
     if(h!=NULL){
-        saf_rfft_destroy(&(h->hFFT));
-        free(h->X_n);
-        free(h->x_pad);
-        free(h->z_n);
-        free(h->hx_n);
-        free(h->HX_n);
         if(!h->usePartFLAG){
+            saf_rfft_destroy(&(h->hFFT));
+            free(h->X_n);
+            free(h->x_pad);
+            free(h->z_n);
+            free(h->Y_n);
+            free(h->activeFLAG);
             free(h->ovrlpAddBuffer);
-            free(h->y_pad);
-            free(h->H_f);
-        }
-        else{
-            free(h->y_n_overlap);
-            for(no=0; no<h->nCHout; no++)
-                free(h->Hpart_f[no]);
-            free(h->Hpart_f);
         }
+        else
+            safPartConv_destroy(&(h->hPC));
+        safConvSwap_free(&(h->swap));
+        free(h->layout);
         free(h);
         h=NULL;
     }
@@ -168,31 +1053,36 @@ void saf_matrixConv_apply
 )
 {
     safMatConv_data *h = (safMatConv_data*)(hMC);
-    int ni, no, nb;
+    safConvFilters* fs, *fsOld;
+    int ni, no;
+    float gain;
+
+    /* Adopt any newly swapped in filters */
+    gain = safConvSwap_begin(&(h->swap));
+    fs = h->swap.cur;
+    fsOld = gain<1.0f ? h->swap.old : NULL;
     
     /* apply non-partitioned convolution */
     if(!h->usePartFLAG){
-        /* zero-pad input signals and perform fft */
+        /* zero-pad input signals and perform fft (unless silent) */
         for(ni=0; ni<h->nCHin; ni++){
             memcpy(&(h->x_pad[ni*(h->fftSize)]), &inputSig[ni*(h->hopSize)], h->hopSize *sizeof(float));
-            saf_rfft_forward(h->hFFT, &(h->x_pad[ni*(h->fftSize)]), &(h->X_n[ni*(h->nBins)]));
+            h->activeFLAG[ni] = !safConv_isSilent(&inputSig[ni*(h->hopSize)], h->hopSize);
+            if(h->activeFLAG[ni])
+                safConv_fft(h->hFFT, &(h->x_pad[ni*(h->fftSize)]), h->nBins, &(h->X_n[2*ni*(h->nBins)]));
         }
         
         for(no=0; no<h->nCHout; no++){
-            /* Apply filter and perform ifft, and sum over input channels */
-            memset(h->z_n, 0, (h->fftSize) * sizeof(float));
-            for(ni=0; ni<h->nCHin; ni++){
-
-
-
-                /* This is the bulk of the CPU work (90.3%): */
-                utility_cvvmul(&(h->H_f[no*(h->nCHin)*(h->nBins)+ni*(h->nBins)]), &(h->X_n[ni*(h->nBins)]), h->nBins, h->HX_n);
-                saf_rfft_backward(h->hFFT, h->HX_n, h->hx_n);
-                utility_svvadd(h->z_n,  h->hx_n, h->fftSize, h->z_n); /* 7.8% */
-            }
+            /* Apply filters and sum over input channels in the frequency domain,
+             * such that only one ifft is required per output channel */
+            if(safConv_filter(fs, fsOld, gain, 0, no*(h->nCHin), h->X_n, h->activeFLAG, 1, h->nCHin, 1, 0,
+                              h->nCHin, 0, h->nBins, h->Y_n, &(h->cnt)))
+                safConv_ifft(h->hFFT, h->Y_n, h->nBins, h->z_n);
+            else
+                memset(h->z_n, 0, (h->fftSize)*sizeof(float));
             
             /* over-lap add buffer */
-            memcpy(&(h->ovrlpAddBuffer[no*(h->fftSize)]), &(h->ovrlpAddBuffer[no*(h->fftSize)+(h->hopSize)]), (h->numOvrlpAddBlocks-1)*(h->hopSize)*sizeof(float));
+            memmove(&(h->ovrlpAddBuffer[no*(h->fftSize)]), &(h->ovrlpAddBuffer[no*(h->fftSize)+(h->hopSize)]), (h->numOvrlpAddBlocks-1)*(h->hopSize)*sizeof(float));
             memset(&(h->ovrlpAddBuffer[no*(h->fftSize)+(h->numOvrlpAddBlocks-1)*(h->hopSize)]), 0, (h->hopSize)*sizeof(float));
 
             /* sum with overlap buffer and copy the result to the output buffer */
@@ -203,33 +1093,76 @@ void saf_matrixConv_apply
         }
     }
     /* apply partitioned convolution */
-    else{
-        /* zero-pad input signals and perform fft. Store in partition slot 1. */
-        memcpy(&(h->X_n[1*(h->nCHin)*(h->nBins)]), h->X_n, (h->numFilterBlocks-1)*(h->nCHin)*(h->nBins)*sizeof(float_complex)); /* shuffle */
-        for(ni=0; ni<h->nCHin; ni++){
-            memcpy(h->x_pad, &(inputSig[ni*(h->hopSize)]), h->hopSize *sizeof(float));
-            saf_rfft_forward(h->hFFT, h->x_pad, &(h->X_n[0*(h->nCHin)*(h->nBins)+ni*(h->nBins)]));
-        }
-        
-        /* apply convolution and inverse fft */
-        for(no=0; no<h->nCHout; no++){
-            utility_cvvmul(h->Hpart_f[no], h->X_n, h->numFilterBlocks * (h->nCHin) * (h->nBins), h->HX_n); /* This is the bulk of the CPU work */
-            for(nb=0; nb<h->numFilterBlocks; nb++)
-                for(ni=0; ni<h->nCHin; ni++)
-                    saf_rfft_backward(h->hFFT, &(h->HX_n[nb*(h->nCHin)*(h->nBins)+ni*(h->nBins)]), &(h->hx_n[nb*(h->nCHin)*(h->fftSize)+ni*(h->fftSize)]));
-            
-            /* output frame for this channel is the sum over all partitions and input channels */
-            memset(h->z_n, 0, (h->fftSize) * sizeof(float));
-            for(nb=0; nb<h->numFilterBlocks*(h->nCHin); nb++)
-                utility_svvadd(h->z_n, (const float*)&(h->hx_n[nb*(h->fftSize)]), h->fftSize, h->z_n);
+    else
+        safPartConv_apply(h->hPC, fs, fsOld, gain, inputSig, outputSig);
 
-            /* sum with overlap buffer and copy the result to the output buffer */
-            utility_svvadd(h->z_n, (const float*)&(h->y_n_overlap[no*(h->hopSize)]), h->hopSize, &(outputSig[no*(h->hopSize)]));
+    /* Advance the crossfade, and retire the previous filters once done */
+    safConvSwap_end(&(h->swap));
+}
 
-            /* for next iteration: */
-            memcpy(&(h->y_n_overlap[no*(h->hopSize)]), &(h->z_n[h->hopSize]), h->hopSize*sizeof(float));
-        }
-    }
+void saf_matrixConv_createFilters
+(
+    void * const hMC,
+    float* H,
+    void ** const phFilters
+)
+{
+    safMatConv_data *h = (safMatConv_data*)(hMC);
+    safConvFilters* fs;
+
+    safConvFilters_create(&fs, hMC, H, h->length_h, h->nCHin, h->nCHout, h->nLayouts, h->layout);
+    *phFilters = (void*)fs;
+}
+
+int saf_matrixConv_swapFilters
+(
+    void * const hMC,
+    void * const hFilters,
+    int fadeLength
+)
+{
+    safMatConv_data *h = (safMatConv_data*)(hMC);
+    safConvFilters* fs = (safConvFilters*)hFilters;
+
+    assert(fs->owner==hMC); /* filters were prepared for another instance */
+    return safConvSwap_request(&(h->swap), fs, (fadeLength + h->hopSize - 1)/h->hopSize);
+}
+
+void saf_matrixConv_releaseFilters
+(
+    void * const hMC
+)
+{
+    safMatConv_data *h = (safMatConv_data*)(hMC);
+    safConvSwap_release(&(h->swap));
+}
+
+void saf_matrixConv_destroyFilters
+(
+    void ** const phFilters
+)
+{
+    safConvFilters_destroy((safConvFilters**)phFilters);
+}
+
+void saf_matrixConv_getCounters
+(
+    void * const hMC,
+    unsigned long long* nComputed,
+    unsigned long long* nSkippedFilter,
+    unsigned long long* nSkippedInput
+)
+{
+    safMatConv_data *h = (safMatConv_data*)(hMC);
+    safConvCounters* cnt;
+
+    cnt = h->usePartFLAG ? &(h->hPC->cnt) : &(h->cnt);
+    if(nComputed!=NULL)
+        *nComputed = cnt->nComputed;
+    if(nSkippedFilter!=NULL)
+        *nSkippedFilter = cnt->nSkippedFilter;
+    if(nSkippedInput!=NULL)
+        *nSkippedInput = cnt->nSkippedInput;
 }
 
 
@@ -243,11 +1176,17 @@ void saf_matrixConv_apply
 typedef struct _safMulConv_data {
     int hopSize, fftSize, nBins;
     int length_h, nCH;
-    int numOvrlpAddBlocks, numFilterBlocks;
+    int numOvrlpAddBlocks;
     int usePartFLAG;
     void* hFFT;
-    float* x_pad, *z_n, *ovrlpAddBuffer, *hx_n, *y_n_overlap;
-    float_complex* X_n, *HX_n, *Z_n, *H_f, *Hpart_f;
+    float* x_pad, *z_n, *ovrlpAddBuffer;
+    float* X_n, *Z_n;      /**< In/output spectra; FLAT: nCH x 2 x nBins */
+    int* activeFLAG;       /**< '0' if the input block is silent; nCH x 1 */
+    safConvCounters cnt;   /**< Counters (non-partitioned mode) */
+    safPartConv_data* hPC; /**< Partitioned convolution engine */
+    int nLayouts;          /**< Number of filter layouts */
+    safConvLayout* layout; /**< Filter layouts; nLayouts x 1 */
+    safConvSwap swap;      /**< Filter sets and swapping state */
     
 }safMulConv_data;
 
@@ -263,8 +1202,7 @@ void saf_multiConv_create
 {
     *phMC = malloc1d(sizeof(safMulConv_data));
     safMulConv_data *h = (safMulConv_data*)(*phMC);
-    int nc, nb;
-    float* h_pad, *h_pad_2hops;
+    safConvFilters* fs;
     
     h->hopSize = hopSize;
     h->length_h = length_h;
@@ -272,6 +1210,9 @@ void saf_multiConv_create
     h->usePartFLAG = usePartFLAG;
     if(hopSize>length_h && h->usePartFLAG)
         h->usePartFLAG = 0; /* no benefit in partitioning in this case */
+    h->hFFT = NULL;
+    h->hPC = NULL;
+    memset(&(h->cnt), 0, sizeof(safConvCounters));
     
     if(!h->usePartFLAG){
         /* intialise non-partitioned convolution mode */
@@ -279,51 +1220,32 @@ void saf_multiConv_create
         h->fftSize = (h->numOvrlpAddBlocks*hopSize);
         h->nBins = h->fftSize/2 + 1;
         
-        /* Allocate memory for buffers and perform fft on partitioned H */
+        /* Allocate memory for buffers */
         h->ovrlpAddBuffer = calloc1d(nCH*h->fftSize, sizeof(float));
-        h_pad = calloc1d(h->fftSize, sizeof(float));
-        h->H_f = malloc1d(nCH*(h->nBins)*sizeof(float_complex));
-        h->X_n = calloc1d(nCH * (h->nBins), sizeof(float_complex));
-        h->Z_n = malloc1d(nCH * (h->nBins) * sizeof(float_complex));
+        h->X_n = calloc1d(nCH * 2 * (h->nBins), sizeof(float));
+        h->Z_n = malloc1d(nCH * 2 * (h->nBins) * sizeof(float));
+        h->activeFLAG = malloc1d(nCH*sizeof(int));
         h->x_pad = calloc1d(h->fftSize, sizeof(float));
         h->z_n = malloc1d(nCH*(h->fftSize)*sizeof(float));
         saf_rfft_create(&(h->hFFT), h->fftSize);
-        for(nc=0; nc<nCH; nc++){
-            memcpy(h_pad, &H[nc*length_h], length_h*sizeof(float)); /* zero pad filter, to be multiple of hopsize */
-            saf_rfft_forward(h->hFFT, h_pad, &(h->H_f[nc*(h->nBins)]));
-        }
-        
-        free(h_pad);
+
+        /* The filters are zero padded to fftSize as a single partition */
+        h->nLayouts = 1;
+        h->layout = malloc1d(sizeof(safConvLayout));
+        h->layout[0].fftSize = h->fftSize;
+        h->layout[0].partLen = length_h;
+        h->layout[0].numPart = 1;
+        h->layout[0].tapOffset = 0;
     }
     else{
-        /* intialise partitioned convolution mode */
-        h->fftSize = 2*(h->hopSize);
-        h->nBins = hopSize+1;
-        h->numFilterBlocks = (int)ceilf((float)length_h/(float)hopSize); /* number of partitions */
-        assert(h->numFilterBlocks>=1);
-        
-        /* Allocate memory for buffers and perform fft on partitioned H */
-        h_pad = calloc1d(h->numFilterBlocks * hopSize, sizeof(float));
-        h_pad_2hops = calloc1d(2 * hopSize, sizeof(float));
-        h->Hpart_f = malloc1d(h->numFilterBlocks*nCH*(h->nBins)*sizeof(float_complex));
-        h->X_n = calloc1d(h->numFilterBlocks * nCH * (h->nBins), sizeof(float_complex));
-        h->HX_n = calloc1d(h->numFilterBlocks * nCH * (h->nBins), sizeof(float_complex));
-        h->x_pad = calloc1d(2 * hopSize, sizeof(float));
-        h->hx_n = malloc1d(h->numFilterBlocks*nCH*(h->fftSize)*sizeof(float));
-        h->z_n = calloc1d(h->fftSize, sizeof(float));
-        h->y_n_overlap = calloc1d(nCH*hopSize, sizeof(float));
-        saf_rfft_create(&(h->hFFT), h->fftSize);
-        for(nc=0; nc<nCH; nc++){
-            memcpy(h_pad, &H[nc*length_h], length_h*sizeof(float)); /* zero pad filter, to be multiple of hopsize */
-            for (nb=0; nb<h->numFilterBlocks; nb++){
-                memcpy(h_pad_2hops, &(h_pad[nb*hopSize]), hopSize*sizeof(float));
-                saf_rfft_forward(h->hFFT, h_pad_2hops, &(h->Hpart_f[nb*nCH*(h->nBins)+nc*(h->nBins)]));
-            }
-        }
-        
-        free(h_pad);
-        free(h_pad_2hops);
+        /* intialise (uniformly or non-uniformly) partitioned convolution mode */
+        h->nLayouts = safPartConv_create(&(h->hPC), hopSize, length_h, nCH, nCH, 1,
+                                         h->usePartFLAG>=2, h->usePartFLAG==3, &(h->layout));
     }
+
+    /* Perform fft on H */
+    safConvFilters_create(&fs, (void*)h, H, length_h, 1, nCH, h->nLayouts, h->layout);
+    safConvSwap_init(&(h->swap), fs);
 }
 
 void saf_multiConv_destroy
@@ -334,20 +1256,19 @@ void saf_multiConv_destroy
     safMulConv_data *h = (safMulConv_data*)(*phMC);
     
     if(h!=NULL){
-        saf_rfft_destroy(&(h->hFFT));
-        free(h->X_n);
-        free(h->x_pad);
-        free(h->z_n);
         if(!h->usePartFLAG){
+            saf_rfft_destroy(&(h->hFFT));
+            free(h->X_n);
+            free(h->x_pad);
+            free(h->z_n);
             free(h->Z_n);
-            free(h->H_f);
-        }
-        else{
-            free(h->HX_n);
-            free(h->hx_n);
-            free(h->y_n_overlap);
-            free(h->Hpart_f);
+            free(h->activeFLAG);
+            free(h->ovrlpAddBuffer);
         }
+        else
+            safPartConv_destroy(&(h->hPC));
+        safConvSwap_free(&(h->swap));
+        free(h->layout);
         free(h);
         h=NULL;
     }
@@ -361,20 +1282,33 @@ void saf_multiConv_apply
 )
 {
     safMulConv_data *h = (safMulConv_data*)(hMC);
-    int nc, nb;
+    safConvFilters* fs, *fsOld;
+    int nc;
+    float gain;
+
+    /* Adopt any newly swapped in filters */
+    gain = safConvSwap_begin(&(h->swap));
+    fs = h->swap.cur;
+    fsOld = gain<1.0f ? h->swap.old : NULL;
     
     /* apply non-partitioned convolution */
     if(!h->usePartFLAG){
-        /* zero-pad input signals and perform fft. */
+        /* zero-pad input signals and perform fft (unless silent) */
         for(nc=0; nc<h->nCH; nc++){
-            memcpy(h->x_pad, &(inputSig[nc*(h->hopSize)]), h->hopSize *sizeof(float));
-            saf_rfft_forward(h->hFFT, h->x_pad, &(h->X_n[nc*(h->nBins)]));
+            h->activeFLAG[nc] = !safConv_isSilent(&(inputSig[nc*(h->hopSize)]), h->hopSize);
+            if(h->activeFLAG[nc]){
+                memcpy(h->x_pad, &(inputSig[nc*(h->hopSize)]), h->hopSize *sizeof(float));
+                safConv_fft(h->hFFT, h->x_pad, h->nBins, &(h->X_n[2*nc*(h->nBins)]));
+            }
         }
         
-        /* apply convolution and inverse fft */
-        utility_cvvmul(h->H_f, h->X_n, (h->nCH) * (h->nBins), h->Z_n); /* This is the bulk of the CPU work */
         for(nc=0; nc<h->nCH; nc++){
-            saf_rfft_backward(h->hFFT, &(h->Z_n[nc*(h->nBins)]), &(h->z_n[nc*(h->fftSize)]));
+            /* apply convolution and inverse fft */
+            if(safConv_filter(fs, fsOld, gain, 0, nc, h->X_n, h->activeFLAG, 1, 1, 1, 0, h->nCH, nc,
+                              h->nBins, &(h->Z_n[2*nc*(h->nBins)]), &(h->cnt)))
+                safConv_ifft(h->hFFT, &(h->Z_n[2*nc*(h->nBins)]), h->nBins, &(h->z_n[nc*(h->fftSize)]));
+            else
+                memset(&(h->z_n[nc*(h->fftSize)]), 0, (h->fftSize)*sizeof(float));
             
             /* sum with overlap buffer and copy the result to the output buffer */
             utility_svvcopy(&(h->ovrlpAddBuffer[nc*(h->fftSize)+(h->hopSize)]), (h->numOvrlpAddBlocks-1)*(h->hopSize), &(h->ovrlpAddBuffer[nc*(h->fftSize)]));
@@ -384,31 +1318,74 @@ void saf_multiConv_apply
         }
     }
     /* apply partitioned convolution */
-    else{
-        /* zero-pad input signals and perform fft. Store in partition slot 1. */
-        memcpy(&(h->X_n[1*(h->nCH)*(h->nBins)]), h->X_n, (h->numFilterBlocks-1)*(h->nCH)*(h->nBins)*sizeof(float_complex));
-        for(nc=0; nc<h->nCH; nc++){
-            memcpy(h->x_pad, &(inputSig[nc*(h->hopSize)]), h->hopSize * sizeof(float));
-            saf_rfft_forward(h->hFFT, h->x_pad, &(h->X_n[0*(h->nCH)*(h->nBins)+nc*(h->nBins)]));
-        }
-        
-        /* apply convolution and inverse fft */
-        utility_cvvmul(h->Hpart_f, h->X_n, h->numFilterBlocks * (h->nCH) * (h->nBins), h->HX_n); /* This is the bulk of the CPU work */
-        for(nc=0; nc<h->nCH; nc++){
-            for(nb=0; nb<h->numFilterBlocks; nb++)
-                saf_rfft_backward(h->hFFT, &(h->HX_n[nb*(h->nCH)*(h->nBins)+nc*(h->nBins)]), &(h->hx_n[nb*(h->nCH)*(h->fftSize)+nc*(h->fftSize)]));
-            
-            /* output frame for this channel is the sum over all partitions */
-            memset(h->z_n, 0, h->fftSize*sizeof(float));
-            for(nb=0; nb<h->numFilterBlocks; nb++)
-                utility_svvadd(h->z_n, (const float*)&(h->hx_n[nb*(h->nCH)*(h->fftSize)+nc*(h->fftSize)]), h->fftSize, h->z_n);
-            
-            /* sum with overlap buffer and copy the result to the output buffer */
-            utility_svvadd(h->z_n, (const float*)&(h->y_n_overlap[nc*(h->hopSize)]), h->hopSize, &(outputSig[nc* (h->hopSize)]));
-            
-            /* for next iteration: */
-            memcpy(&(h->y_n_overlap[nc*(h->hopSize)]), &(h->z_n[h->hopSize]), h->hopSize*sizeof(float));
-        }
-    }
+    else
+        safPartConv_apply(h->hPC, fs, fsOld, gain, inputSig, outputSig);
+
+    /* Advance the crossfade, and retire the previous filters once done */
+    safConvSwap_end(&(h->swap));
+}
+
+void saf_multiConv_createFilters
+(
+    void * const hMC,
+    float* H,
+    void ** const phFilters
+)
+{
+    safMulConv_data *h = (safMulConv_data*)(hMC);
+    safConvFilters* fs;
+
+    safConvFilters_create(&fs, hMC, H, h->length_h, 1, h->nCH, h->nLayouts, h->layout);
+    *phFilters = (void*)fs;
+}
+
+int saf_multiConv_swapFilters
+(
+    void * const hMC,
+    void * const hFilters,
+    int fadeLength
+)
+{
+    safMulConv_data *h = (safMulConv_data*)(hMC);
+    safConvFilters* fs = (safConvFilters*)hFilters;
+
+    assert(fs->owner==hMC); /* filters were prepared for another instance */
+    return safConvSwap_request(&(h->swap), fs, (fadeLength + h->hopSize - 1)/h->hopSize);
+}
+
+void saf_multiConv_releaseFilters
+(
+    void * const hMC
+)
+{
+    safMulConv_data *h = (safMulConv_data*)(hMC);
+    safConvSwap_release(&(h->swap));
 }
 
+void saf_multiConv_destroyFilters
+(
+    void ** const phFilters
+)
+{
+    safConvFilters_destroy((safConvFilters**)phFilters);
+}
+
+void saf_multiConv_getCounters
+(
+    void * const hMC,
+    unsigned long long* nComputed,
+    unsigned long long* nSkippedFilter,
+    unsigned long long* nSkippedInput
+)
+{
+    safMulConv_data *h = (safMulConv_data*)(hMC);
+    safConvCounters* cnt;
+
+    cnt = h->usePartFLAG ? &(h->hPC->cnt) : &(h->cnt);
+    if(nComputed!=NULL)
+        *nComputed = cnt->nComputed;
+    if(nSkippedFilter!=NULL)
+        *nSkippedFilter = cnt->nSkippedFilter;
+    if(nSkippedInput!=NULL)
+        *nSkippedInput = cnt->nSkippedInput;
+}
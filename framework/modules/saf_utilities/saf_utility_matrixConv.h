@@ -61,7 +61,39 @@ extern "C" {
  *
  * This is a matrix convolver intended for block-by-block processing.
  *
+ * @note In partitioned mode, the spectra of past input blocks are kept in a
+ *       frequency-domain delay-line (FDL). The products over all partitions and
+ *       input channels are accumulated in the frequency domain, so that only
+ *       one inverse FFT is required per output channel, per partition size.
+ * @note All spectra (filters, inputs and outputs) are held in the native
+ *       format of the FFT, from the forward FFT through to the inverse FFT:
+ *       split-complex with Apple Accelerate (see saf_rfft_forward_split()),
+ *       and interleaved otherwise. No (de)interleaving is needed in between.
+ * @note Filter partitions which are zero, and input blocks which are silent,
+ *       are detected (at creation and run time, respectively), and their
+ *       products are skipped. If all products for an output channel are
+ *       skipped, then its inverse FFT is also skipped. See
+ *       saf_matrixConv_getCounters().
+ * @note The non-uniformly partitioned mode (usePartFLAG=2) employs two
+ *       partitions of hopSize length, followed by pairs of partitions which
+ *       double in size, and are thus computed at a lower rate. This does not
+ *       add any latency, and is recommended for long filters (e.g. reverb
+ *       tails), for which uniform partitioning would require a very large
+ *       number of partitions. Note, however, that the CPU load then varies
+ *       from hop to hop.
+ * @note The threaded mode (usePartFLAG=3) employs the same non-uniform
+ *       partitions, but the larger partitions (whose output is not required
+ *       until at least two hops later) are computed on a worker thread. The
+ *       calling thread then only computes the head of the filters, and
+ *       collects the finished tail contributions via a wait-free
+ *       single-producer/single-consumer ring buffer. It only waits on the
+ *       worker thread if a contribution is still not ready by the time it is
+ *       due.
+ *
  * @test test__saf_matrixConv()
+ * @test test__saf_matrixConv_partitioned()
+ * @test test__saf_matrixConv_swapFilters()
+ * @test test__saf_matrixConv_sparse()
  *
  * @param[in] phMC        (&) address of matrixConv handle
  * @param[in] hopSize     Hop size in samples.
@@ -70,7 +102,9 @@ extern "C" {
  * @param[in] nCHin       Number of input channels
  * @param[in] nCHout      Number of output channels
  * @param[in] usePartFLAG '0': normal fft-based convolution, '1': fft-based
- *                        partitioned convolution
+ *                        uniformly partitioned convolution, '2': fft-based
+ *                        non-uniformly partitioned convolution, '3': as '2',
+ *                        but with the tail computed on a worker thread
  */
 void saf_matrixConv_create(/* Input Arguments */
                            void ** const phMC,
@@ -92,8 +126,10 @@ void saf_matrixConv_destroy(/* Input Arguments */
 /**
  * Performs the matrix convolution.
  *
- * @note If the number of input+output channels, the filters, or the hopsize
- *       need tochange: simply destroy and re-create the matrixConv instance.
+ * @note If the number of input+output channels, the filter length, or the
+ *       hopsize need to change: simply destroy and re-create the matrixConv
+ *       instance. New filters of the same dimensions may instead be swapped in
+ *       using saf_matrixConv_swapFilters().
  *
  * @param[in]  hMC        matrixConv handle
  * @param[in]  inputSigs  Input signals;  FLAT: nCHin  x hopSize
@@ -105,6 +141,98 @@ void saf_matrixConv_apply(/* Input Arguments */
                           /* Output Arguments */
                           float* outputSigs);
 
+/**
+ * Prepares a new set of filters for a matrixConv instance, which may then be
+ * swapped in using saf_matrixConv_swapFilters()
+ *
+ * The filters are transformed (and partitioned) in the same manner as those
+ * given to saf_matrixConv_create(). Therefore, this should be called from a
+ * non-real-time thread.
+ *
+ * @param[in]  hMC       matrixConv handle
+ * @param[in]  H         Time-domain filters; FLAT: nCHout x nCHin x length_h,
+ *                       where the dimensions are those of the matrixConv
+ *                       instance
+ * @param[out] phFilters (&) address of the filter set handle
+ */
+void saf_matrixConv_createFilters(/* Input Arguments */
+                                  void * const hMC,
+                                  float* H,
+                                  /* Output Arguments */
+                                  void ** const phFilters);
+
+/**
+ * Queues a set of filters (prepared with saf_matrixConv_createFilters()) to be
+ * swapped in at the start of the next saf_matrixConv_apply() call
+ *
+ * The filter spectra of the previous set are then crossfaded to those of the
+ * new set, over fadeLength samples (rounded up to a multiple of hopSize). The
+ * crossfade is applied to each input block, and the history of the input
+ * signals is retained, so the convolver does not need to be re-created.
+ * Once the crossfade is complete, the previous set is retired, and is freed
+ * by the next call to saf_matrixConv_swapFilters() or
+ * saf_matrixConv_releaseFilters() (or by saf_matrixConv_destroy()).
+ *
+ * @note This function does not block, and may be called while another thread
+ *       is calling saf_matrixConv_apply(). Only one swap may be in progress at
+ *       a time.
+ *
+ * @param[in] hMC        matrixConv handle
+ * @param[in] hFilters   Filter set handle; ownership passes to the matrixConv
+ *                       instance if successful
+ * @param[in] fadeLength Crossfade length in samples (0: switch immediately)
+ * @returns   '1' if the filters were queued, or '0' if a previous swap is still
+ *            in progress (in which case the caller retains ownership of the
+ *            filter set, and may try again later)
+ */
+int saf_matrixConv_swapFilters(/* Input Arguments */
+                               void * const hMC,
+                               void * const hFilters,
+                               int fadeLength);
+
+/**
+ * Frees the filter set which was retired by the most recent swap (if any).
+ * Should be called from a non-real-time thread.
+ *
+ * @param[in] hMC matrixConv handle
+ */
+void saf_matrixConv_releaseFilters(/* Input Arguments */
+                                   void * const hMC);
+
+/**
+ * Destroys a filter set which was not handed over to a matrixConv instance
+ *
+ * @param[in] phFilters (&) address of the filter set handle
+ */
+void saf_matrixConv_destroyFilters(/* Input Arguments */
+                                   void ** const phFilters);
+
+/**
+ * Returns the number of (complex, per frequency bin) multiply-accumulate
+ * operations which were performed, and which were skipped, by
+ * saf_matrixConv_apply() since the instance was created
+ *
+ * Products of filter partitions which are zero (or below -180dB) are skipped,
+ * as are products with input blocks which are silent.
+ *
+ * @note The counters of jobs computed on the worker thread (usePartFLAG=3) are
+ *       included once they have been collected. Should be called from the same
+ *       thread as saf_matrixConv_apply(), or while it is not being called.
+ *
+ * @param[in]  hMC            matrixConv handle
+ * @param[out] nComputed      (&) number of operations performed; or NULL
+ * @param[out] nSkippedFilter (&) number skipped due to zero filter partitions;
+ *                            or NULL
+ * @param[out] nSkippedInput  (&) number skipped due to silent input blocks; or
+ *                            NULL
+ */
+void saf_matrixConv_getCounters(/* Input Arguments */
+                                void * const hMC,
+                                /* Output Arguments */
+                                unsigned long long* nComputed,
+                                unsigned long long* nSkippedFilter,
+                                unsigned long long* nSkippedInput);
+
 
 /* ========================================================================== */
 /*                            Multi-Channel Convolver                         */
@@ -124,7 +252,10 @@ void saf_matrixConv_apply(/* Input Arguments */
  * @param[in] length_h    Length of the filters
  * @param[in] nCH         Number of filters & input/output channels
  * @param[in] usePartFLAG '0': normal fft-based convolution, '1': fft-based
- *                        partitioned convolution
+ *                        uniformly partitioned convolution, '2': fft-based
+ *                        non-uniformly partitioned convolution, '3': as '2',
+ *                        but with the tail computed on a worker thread (see
+ *                        saf_matrixConv_create())
  */
 void saf_multiConv_create(/* Input Arguments */
                           void ** const phMC,
@@ -155,6 +286,75 @@ void saf_multiConv_apply(/* Input Arguments */
                          /* Output Arguments */
                          float* outputSigs);
 
+/**
+ * Prepares a new set of filters for a multiConv instance, which may then be
+ * swapped in using saf_multiConv_swapFilters() (see
+ * saf_matrixConv_createFilters())
+ *
+ * @param[in]  hMC       multiConv handle
+ * @param[in]  H         Time-domain filters; FLAT: nCH x length_h
+ * @param[out] phFilters (&) address of the filter set handle
+ */
+void saf_multiConv_createFilters(/* Input Arguments */
+                                 void * const hMC,
+                                 float* H,
+                                 /* Output Arguments */
+                                 void ** const phFilters);
+
+/**
+ * Queues a set of filters (prepared with saf_multiConv_createFilters()) to be
+ * swapped in at the start of the next saf_multiConv_apply() call, with a
+ * crossfade (see saf_matrixConv_swapFilters())
+ *
+ * @param[in] hMC        multiConv handle
+ * @param[in] hFilters   Filter set handle; ownership passes to the multiConv
+ *                       instance if successful
+ * @param[in] fadeLength Crossfade length in samples (0: switch immediately)
+ * @returns   '1' if the filters were queued, or '0' if a previous swap is still
+ *            in progress
+ */
+int saf_multiConv_swapFilters(/* Input Arguments */
+                              void * const hMC,
+                              void * const hFilters,
+                              int fadeLength);
+
+/**
+ * Frees the filter set which was retired by the most recent swap (if any).
+ * Should be called from a non-real-time thread.
+ *
+ * @param[in] hMC multiConv handle
+ */
+void saf_multiConv_releaseFilters(/* Input Arguments */
+                                  void * const hMC);
+
+/**
+ * Destroys a filter set which was not handed over to a multiConv instance
+ *
+ * @param[in] phFilters (&) address of the filter set handle
+ */
+void saf_multiConv_destroyFilters(/* Input Arguments */
+                                  void ** const phFilters);
+
+/**
+ * Returns the number of (complex, per frequency bin) multiply-accumulate
+ * operations which were performed, and which were skipped, by
+ * saf_multiConv_apply() since the instance was created (see
+ * saf_matrixConv_getCounters())
+ *
+ * @param[in]  hMC            multiConv handle
+ * @param[out] nComputed      (&) number of operations performed; or NULL
+ * @param[out] nSkippedFilter (&) number skipped due to zero filter partitions;
+ *                            or NULL
+ * @param[out] nSkippedInput  (&) number skipped due to silent input blocks; or
+ *                            NULL
+ */
+void saf_multiConv_getCounters(/* Input Arguments */
+                               void * const hMC,
+                               /* Output Arguments */
+                               unsigned long long* nComputed,
+                               unsigned long long* nSkippedFilter,
+                               unsigned long long* nSkippedInput);
+
 
 #ifdef __cplusplus
 }/* extern "C" */
@@ -0,0 +1,496 @@
+/*
+ * Copyright 2020 Leo McCormack
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * @file saf_utility_threads.c
+ * @ingroup Utilities
+ * @brief Cross-platform wrappers for threads, semaphores and atomic operations,
+ *        a wait-free single-producer/single-consumer (SPSC) ring buffer, and
+ *        a read-copy-update (RCU) state swap
+ *
+ * ## Dependencies
+ *   pthreads (or the Win32 API on Windows)
+ *
+ * @author Leo McCormack
+ * @date 15.10.2020
+ */
+
+#include "saf_utilities.h"
+#include "saf_utility_threads.h"
+
+#if defined(_WIN32)
+# include <windows.h>
+#else
+# include <pthread.h>
+# include <sched.h>
+# if defined(__APPLE__)
+#  include <dispatch/dispatch.h> /* (unnamed POSIX semaphores are not supported) */
+# else
+#  include <semaphore.h>
+# endif
+#endif
+
+
+/* ========================================================================== */
+/*                              Atomic Operations                             */
+/* ========================================================================== */
+
+int saf_atomic_loadInt
+(
+    volatile int* ptr
+)
+{
+#if defined(_MSC_VER)
+    return (int)InterlockedCompareExchange((volatile LONG*)ptr, 0, 0);
+#else
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+#endif
+}
+
+void saf_atomic_storeInt
+(
+    volatile int* ptr,
+    int value
+)
+{
+#if defined(_MSC_VER)
+    InterlockedExchange((volatile LONG*)ptr, (LONG)value);
+#else
+    __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+#endif
+}
+
+void* saf_atomic_loadPtr
+(
+    void* volatile* ptr
+)
+{
+#if defined(_MSC_VER)
+    return InterlockedCompareExchangePointer(ptr, NULL, NULL);
+#else
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+#endif
+}
+
+void saf_atomic_storePtr
+(
+    void* volatile* ptr,
+    void* value
+)
+{
+#if defined(_MSC_VER)
+    InterlockedExchangePointer(ptr, value);
+#else
+    __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+#endif
+}
+
+void* saf_atomic_exchangePtr
+(
+    void* volatile* ptr,
+    void* value
+)
+{
+#if defined(_MSC_VER)
+    return InterlockedExchangePointer(ptr, value);
+#else
+    return __atomic_exchange_n(ptr, value, __ATOMIC_ACQ_REL);
+#endif
+}
+
+int saf_atomic_compareExchangeInt
+(
+    volatile int* ptr,
+    int expected,
+    int desired
+)
+{
+#if defined(_MSC_VER)
+    return (int)InterlockedCompareExchange((volatile LONG*)ptr, (LONG)desired, (LONG)expected) == expected;
+#else
+    return (int)__atomic_compare_exchange_n(ptr, &expected, desired, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif
+}
+
+void saf_spinlock_lock
+(
+    volatile int* lock
+)
+{
+#if defined(_MSC_VER)
+    while(InterlockedExchange((volatile LONG*)lock, 1)!=0)
+        saf_thread_yield();
+#else
+    while(__atomic_exchange_n(lock, 1, __ATOMIC_ACQUIRE)!=0)
+        saf_thread_yield();
+#endif
+}
+
+void saf_spinlock_unlock
+(
+    volatile int* lock
+)
+{
+    saf_atomic_storeInt(lock, 0);
+}
+
+
+/* ========================================================================== */
+/*                            Threads and Semaphores                          */
+/* ========================================================================== */
+
+#if defined(_WIN32)
+/** Data structure for passing the entry point and argument to a Win32 thread */
+typedef struct _saf_thread_data {
+    HANDLE handle;
+    saf_thread_func func;
+    void* arg;
+}saf_thread_data;
+
+static DWORD WINAPI saf_thread_entry(LPVOID param)
+{
+    saf_thread_data* h = (saf_thread_data*)param;
+    h->func(h->arg);
+    return 0;
+}
+#endif
+
+void saf_thread_create
+(
+    void ** const phThread,
+    saf_thread_func func,
+    void* arg
+)
+{
+#if defined(_WIN32)
+    saf_thread_data* h = (saf_thread_data*)malloc1d(sizeof(saf_thread_data));
+    h->func = func;
+    h->arg = arg;
+    h->handle = CreateThread(NULL, 0, saf_thread_entry, (LPVOID)h, 0, NULL);
+    *phThread = (void*)h;
+#else
+    pthread_t* h = (pthread_t*)malloc1d(sizeof(pthread_t));
+    if(pthread_create(h, NULL, func, arg) != 0){
+        free(h);
+        h = NULL;
+    }
+    *phThread = (void*)h;
+#endif
+}
+
+void saf_thread_join
+(
+    void ** const phThread
+)
+{
+#if defined(_WIN32)
+    saf_thread_data* h = (saf_thread_data*)(*phThread);
+    if(h!=NULL){
+        WaitForSingleObject(h->handle, INFINITE);
+        CloseHandle(h->handle);
+        free(h);
+        *phThread = NULL;
+    }
+#else
+    pthread_t* h = (pthread_t*)(*phThread);
+    if(h!=NULL){
+        pthread_join(*h, NULL);
+        free(h);
+        *phThread = NULL;
+    }
+#endif
+}
+
+void saf_thread_yield(void)
+{
+#if defined(_WIN32)
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+void saf_semaphore_create
+(
+    void ** const phSem
+)
+{
+#if defined(_WIN32)
+    *phSem = (void*)CreateSemaphore(NULL, 0, 0x7FFFFFFF, NULL);
+#elif defined(__APPLE__)
+    *phSem = (void*)dispatch_semaphore_create(0);
+#else
+    sem_t* h = (sem_t*)malloc1d(sizeof(sem_t));
+    sem_init(h, 0, 0);
+    *phSem = (void*)h;
+#endif
+}
+
+void saf_semaphore_destroy
+(
+    void ** const phSem
+)
+{
+    if(*phSem!=NULL){
+#if defined(_WIN32)
+        CloseHandle((HANDLE)(*phSem));
+#elif defined(__APPLE__)
+        dispatch_release((dispatch_semaphore_t)(*phSem));
+#else
+        sem_destroy((sem_t*)(*phSem));
+        free(*phSem);
+#endif
+        *phSem = NULL;
+    }
+}
+
+void saf_semaphore_post
+(
+    void * const hSem
+)
+{
+#if defined(_WIN32)
+    ReleaseSemaphore((HANDLE)hSem, 1, NULL);
+#elif defined(__APPLE__)
+    dispatch_semaphore_signal((dispatch_semaphore_t)hSem);
+#else
+    sem_post((sem_t*)hSem);
+#endif
+}
+
+void saf_semaphore_wait
+(
+    void * const hSem
+)
+{
+#if defined(_WIN32)
+    WaitForSingleObject((HANDLE)hSem, INFINITE);
+#elif defined(__APPLE__)
+    dispatch_semaphore_wait((dispatch_semaphore_t)hSem, DISPATCH_TIME_FOREVER);
+#else
+    while(sem_wait((sem_t*)hSem) != 0) {} /* (retry if interrupted) */
+#endif
+}
+
+
+/* ========================================================================== */
+/*                     Single-Producer/Single-Consumer Ring                   */
+/* ========================================================================== */
+
+/**
+ * Data structure for the SPSC ring buffer. The read and write indices are
+ * free-running counters; the number of held elements is (writeIdx-readIdx).
+ */
+typedef struct _saf_spscRing_data {
+    int capacity;
+    size_t elemSize;
+    char* data;
+    volatile int writeIdx; /**< Only written by the producer */
+    volatile int readIdx;  /**< Only written by the consumer */
+
+}saf_spscRing_data;
+
+void saf_spscRing_create
+(
+    void ** const phRing,
+    int capacity,
+    size_t elemSize
+)
+{
+    *phRing = malloc1d(sizeof(saf_spscRing_data));
+    saf_spscRing_data *h = (saf_spscRing_data*)(*phRing);
+
+    assert(capacity>0);
+    h->capacity = capacity;
+    h->elemSize = elemSize;
+    h->data = malloc1d(capacity*elemSize);
+    h->writeIdx = 0;
+    h->readIdx = 0;
+}
+
+void saf_spscRing_destroy
+(
+    void ** const phRing
+)
+{
+    saf_spscRing_data *h = (saf_spscRing_data*)(*phRing);
+
+    if(h!=NULL){
+        free(h->data);
+        free(h);
+        *phRing = NULL;
+    }
+}
+
+int saf_spscRing_push
+(
+    void * const hRing,
+    const void* elem
+)
+{
+    saf_spscRing_data *h = (saf_spscRing_data*)(hRing);
+    int writeIdx, readIdx;
+
+    writeIdx = h->writeIdx; /* (only modified by this thread) */
+    readIdx = saf_atomic_loadInt(&(h->readIdx));
+    if((unsigned)writeIdx - (unsigned)readIdx >= (unsigned)h->capacity)
+        return 0; /* full */
+    memcpy(&(h->data[((unsigned)writeIdx % (unsigned)h->capacity)*h->elemSize]), elem, h->elemSize);
+    saf_atomic_storeInt(&(h->writeIdx), (int)((unsigned)writeIdx+1u)); /* publish */
+    return 1;
+}
+
+int saf_spscRing_pop
+(
+    void * const hRing,
+    void* elem
+)
+{
+    saf_spscRing_data *h = (saf_spscRing_data*)(hRing);
+    int writeIdx, readIdx;
+
+    readIdx = h->readIdx; /* (only modified by this thread) */
+    writeIdx = saf_atomic_loadInt(&(h->writeIdx));
+    if(writeIdx == readIdx)
+        return 0; /* empty */
+    memcpy(elem, &(h->data[((unsigned)readIdx % (unsigned)h->capacity)*h->elemSize]), h->elemSize);
+    saf_atomic_storeInt(&(h->readIdx), (int)((unsigned)readIdx+1u)); /* release the slot */
+    return 1;
+}
+
+
+/* ========================================================================== */
+/*                              RCU State Swap                                */
+/* ========================================================================== */
+
+/** A published state, and the link for the list of retired states */
+typedef struct _saf_stateSwap_node {
+    void* state;
+    struct _saf_stateSwap_node* next;
+
+}saf_stateSwap_node;
+
+/**
+ * Main structure for the state swap. 'pending' is handed from the writer to
+ * the reader, and 'retired' from the reader to the writer; the writer only
+ * ever replaces 'retired' with NULL, so the reader needs no compare-exchange
+ * loop to append to it.
+ */
+typedef struct _saf_stateSwap_data {
+    saf_stateSwap_destroyFn destroyFn;
+    void* volatile pending;      /**< Latest published node, which the reader has not yet acquired */
+    void* volatile retired;      /**< List of nodes which the reader no longer uses */
+    saf_stateSwap_node* current; /**< Node in use by the reader (only accessed by the reader) */
+
+}saf_stateSwap_data;
+
+/** Destroys a list of nodes, along with their states */
+static void saf_stateSwap_destroyNodes
+(
+    saf_stateSwap_data* h,
+    saf_stateSwap_node* node
+)
+{
+    saf_stateSwap_node* next;
+
+    while(node!=NULL){
+        next = node->next;
+        h->destroyFn(&(node->state));
+        free(node);
+        node = next;
+    }
+}
+
+void saf_stateSwap_create
+(
+    void ** const phSS,
+    saf_stateSwap_destroyFn destroyFn
+)
+{
+    *phSS = malloc1d(sizeof(saf_stateSwap_data));
+    saf_stateSwap_data *h = (saf_stateSwap_data*)(*phSS);
+
+    h->destroyFn = destroyFn;
+    h->pending = NULL;
+    h->retired = NULL;
+    h->current = NULL;
+}
+
+void saf_stateSwap_destroy
+(
+    void ** const phSS
+)
+{
+    saf_stateSwap_data *h = (saf_stateSwap_data*)(*phSS);
+
+    if(h!=NULL){
+        saf_stateSwap_destroyNodes(h, (saf_stateSwap_node*)saf_atomic_exchangePtr(&(h->retired), NULL));
+        saf_stateSwap_destroyNodes(h, (saf_stateSwap_node*)saf_atomic_exchangePtr(&(h->pending), NULL));
+        saf_stateSwap_destroyNodes(h, h->current);
+        free(h);
+        *phSS = NULL;
+    }
+}
+
+void saf_stateSwap_publish
+(
+    void * const hSS,
+    void * state
+)
+{
+    saf_stateSwap_data *h = (saf_stateSwap_data*)(hSS);
+    saf_stateSwap_node* node;
+
+    node = malloc1d(sizeof(saf_stateSwap_node));
+    node->state = state;
+    node->next = NULL;
+
+    /* A previously published state, which was never acquired, is handed back */
+    saf_stateSwap_destroyNodes(h, (saf_stateSwap_node*)saf_atomic_exchangePtr(&(h->pending), node));
+    saf_stateSwap_collect(hSS);
+}
+
+void saf_stateSwap_collect
+(
+    void * const hSS
+)
+{
+    saf_stateSwap_data *h = (saf_stateSwap_data*)(hSS);
+
+    saf_stateSwap_destroyNodes(h, (saf_stateSwap_node*)saf_atomic_exchangePtr(&(h->retired), NULL));
+}
+
+void* saf_stateSwap_acquire
+(
+    void * const hSS
+)
+{
+    saf_stateSwap_data *h = (saf_stateSwap_data*)(hSS);
+    saf_stateSwap_node* node;
+
+    if(saf_atomic_loadPtr(&(h->pending))!=NULL){
+        node = (saf_stateSwap_node*)saf_atomic_exchangePtr(&(h->pending), NULL);
+        if(node!=NULL){
+            /* Retire the previous state (prepended to any not yet collected) */
+            if(h->current!=NULL){
+                h->current->next = (saf_stateSwap_node*)saf_atomic_exchangePtr(&(h->retired), NULL);
+                saf_atomic_storePtr(&(h->retired), h->current);
+            }
+            h->current = node;
+        }
+    }
+    return h->current!=NULL ? h->current->state : NULL;
+}
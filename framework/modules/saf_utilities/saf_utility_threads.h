@@ -0,0 +1,345 @@
+/*
+ * Copyright 2020 Leo McCormack
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ *@addtogroup Utilities
+ *@{
+ * @file saf_utility_threads.h
+ * @brief Cross-platform wrappers for threads, semaphores and atomic operations,
+ *        a wait-free single-producer/single-consumer (SPSC) ring buffer, and
+ *        a read-copy-update (RCU) state swap
+ *
+ * These are intended for offloading work from a real-time (audio) thread to a
+ * worker thread. The atomic operations, the SPSC ring buffer, and the reader
+ * side of the state swap never block or allocate memory, and may therefore be
+ * used on the real-time thread.
+ *
+ * ## Dependencies
+ *   pthreads (or the Win32 API on Windows)
+ *
+ * @author Leo McCormack
+ * @date 15.10.2020
+ */
+
+#ifndef SAF_THREADS_H_INCLUDED
+#define SAF_THREADS_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/* ========================================================================== */
+/*                              Atomic Operations                             */
+/* ========================================================================== */
+
+/**
+ * Atomically loads an integer (with acquire semantics)
+ *
+ * @param[in] ptr Address of the integer
+ * @returns The loaded value
+ */
+int saf_atomic_loadInt(/* Input Arguments */
+                       volatile int* ptr);
+
+/**
+ * Atomically stores an integer (with release semantics)
+ *
+ * @param[in] ptr   Address of the integer
+ * @param[in] value The value to store
+ */
+void saf_atomic_storeInt(/* Input Arguments */
+                         volatile int* ptr,
+                         int value);
+
+/**
+ * Atomically loads a pointer (with acquire semantics)
+ *
+ * @param[in] ptr Address of the pointer
+ * @returns The loaded pointer
+ */
+void* saf_atomic_loadPtr(/* Input Arguments */
+                         void* volatile* ptr);
+
+/**
+ * Atomically stores a pointer (with release semantics)
+ *
+ * @param[in] ptr   Address of the pointer
+ * @param[in] value The pointer to store
+ */
+void saf_atomic_storePtr(/* Input Arguments */
+                         void* volatile* ptr,
+                         void* value);
+
+/**
+ * Atomically replaces a pointer, and returns its previous value (with
+ * acquire-release semantics)
+ *
+ * @param[in] ptr   Address of the pointer
+ * @param[in] value The new pointer
+ * @returns The previous pointer
+ */
+void* saf_atomic_exchangePtr(/* Input Arguments */
+                             void* volatile* ptr,
+                             void* value);
+
+/**
+ * Atomically replaces an integer, if it currently holds the expected value
+ * (with acquire-release semantics)
+ *
+ * @param[in] ptr      Address of the integer
+ * @param[in] expected The value which the integer is expected to hold
+ * @param[in] desired  The new value
+ * @returns 1 if the integer held 'expected' (and was replaced), 0 otherwise
+ */
+int saf_atomic_compareExchangeInt(/* Input Arguments */
+                                  volatile int* ptr,
+                                  int expected,
+                                  int desired);
+
+/**
+ * Acquires a spin-lock, yielding the calling thread until it is available
+ *
+ * Intended for guarding short critical sections outside of the real-time
+ * thread (e.g. process-wide caches accessed during create/destroy). The lock is
+ * a plain integer, which must be initialised to 0 (unlocked); so it may also
+ * be statically allocated.
+ *
+ * @param[in] lock Address of the lock
+ */
+void saf_spinlock_lock(/* Input Arguments */
+                       volatile int* lock);
+
+/**
+ * Releases a spin-lock acquired with saf_spinlock_lock()
+ *
+ * @param[in] lock Address of the lock
+ */
+void saf_spinlock_unlock(/* Input Arguments */
+                         volatile int* lock);
+
+
+/* ========================================================================== */
+/*                            Threads and Semaphores                          */
+/* ========================================================================== */
+
+/** Thread entry point */
+typedef void* (*saf_thread_func)(void* arg);
+
+/**
+ * Creates and starts a thread
+ *
+ * @param[in] phThread (&) address of thread handle
+ * @param[in] func     Thread entry point
+ * @param[in] arg      Argument passed to the entry point
+ */
+void saf_thread_create(/* Input Arguments */
+                       void ** const phThread,
+                       saf_thread_func func,
+                       void* arg);
+
+/**
+ * Waits for a thread to return, and then destroys its handle
+ *
+ * @param[in] phThread (&) address of thread handle
+ */
+void saf_thread_join(/* Input Arguments */
+                     void ** const phThread);
+
+/**
+ * Creates a counting semaphore, with an initial count of 0
+ *
+ * @param[in] phSem (&) address of semaphore handle
+ */
+void saf_semaphore_create(/* Input Arguments */
+                          void ** const phSem);
+
+/**
+ * Destroys a semaphore
+ *
+ * @param[in] phSem (&) address of semaphore handle
+ */
+void saf_semaphore_destroy(/* Input Arguments */
+                           void ** const phSem);
+
+/**
+ * Increments the semaphore count, waking up a waiting thread (if any)
+ *
+ * @param[in] hSem semaphore handle
+ */
+void saf_semaphore_post(/* Input Arguments */
+                        void * const hSem);
+
+/**
+ * Waits until the semaphore count is above zero, and then decrements it
+ *
+ * @param[in] hSem semaphore handle
+ */
+void saf_semaphore_wait(/* Input Arguments */
+                        void * const hSem);
+
+/**
+ * Yields the remainder of the calling thread's time-slice
+ */
+void saf_thread_yield(void);
+
+
+/* ========================================================================== */
+/*                     Single-Producer/Single-Consumer Ring                   */
+/* ========================================================================== */
+
+/**
+ * Creates a wait-free single-producer/single-consumer (SPSC) ring buffer of
+ * fixed-size elements
+ *
+ * One thread may push elements, while another thread pops them, without any
+ * locking.
+ *
+ * @param[in] phRing   (&) address of ring buffer handle
+ * @param[in] capacity Maximum number of elements which may be held at once
+ * @param[in] elemSize Size of each element, in bytes
+ */
+void saf_spscRing_create(/* Input Arguments */
+                         void ** const phRing,
+                         int capacity,
+                         size_t elemSize);
+
+/**
+ * Destroys a SPSC ring buffer
+ *
+ * @param[in] phRing (&) address of ring buffer handle
+ */
+void saf_spscRing_destroy(/* Input Arguments */
+                          void ** const phRing);
+
+/**
+ * Pushes an element (producer thread only)
+ *
+ * @param[in] hRing ring buffer handle
+ * @param[in] elem  The element to copy into the ring buffer
+ * @returns 1 if successful, 0 if the ring buffer is full
+ */
+int saf_spscRing_push(/* Input Arguments */
+                      void * const hRing,
+                      const void* elem);
+
+/**
+ * Pops the oldest element (consumer thread only)
+ *
+ * @param[in]  hRing ring buffer handle
+ * @param[out] elem  The popped element
+ * @returns 1 if successful, 0 if the ring buffer is empty
+ */
+int saf_spscRing_pop(/* Input Arguments */
+                     void * const hRing,
+                     /* Output Arguments */
+                     void* elem);
+
+
+/* ========================================================================== */
+/*                              RCU State Swap                                */
+/* ========================================================================== */
+
+/**
+ * Destroys a state which was published with saf_stateSwap_publish()
+ *
+ * @param[in] phState (&) address of the state
+ */
+typedef void (*saf_stateSwap_destroyFn)(void** const phState);
+
+/**
+ * Creates a read-copy-update (RCU) state swap, for handing immutable processing
+ * states from a (non-real-time) writer thread over to a real-time reader thread
+ *
+ * The writer builds a complete new state (e.g. filters, tables and transforms
+ * for the current configuration) and publishes it with a single atomic pointer
+ * swap. The reader picks up the latest state at the start of each processing
+ * block with saf_stateSwap_acquire(), which never blocks, allocates or frees
+ * memory. States which the reader no longer uses are handed back, and are
+ * destroyed by the writer (during saf_stateSwap_publish() or
+ * saf_stateSwap_collect()). A state which is replaced before the reader ever
+ * acquired it is destroyed immediately.
+ *
+ * @note There may be only one reader thread and one writer thread at a time.
+ *       A published state must not be modified by the writer, although the
+ *       reader may modify any data in it that only the reader accesses (e.g.
+ *       filterbank buffers).
+ *
+ * @param[in] phSS      (&) address of state swap handle
+ * @param[in] destroyFn Function which destroys a state
+ */
+void saf_stateSwap_create(/* Input Arguments */
+                          void ** const phSS,
+                          saf_stateSwap_destroyFn destroyFn);
+
+/**
+ * Destroys the state swap, along with all the states which it holds
+ *
+ * @warning The reader must no longer be using any state (e.g. the processing
+ *          loop must have stopped)!
+ *
+ * @param[in] phSS (&) address of state swap handle
+ */
+void saf_stateSwap_destroy(/* Input Arguments */
+                           void ** const phSS);
+
+/**
+ * Publishes a new state (writer thread only), and destroys any states which
+ * have since been retired by the reader
+ *
+ * The state swap takes ownership of 'state'.
+ *
+ * @param[in] hSS   state swap handle
+ * @param[in] state The new state
+ */
+void saf_stateSwap_publish(/* Input Arguments */
+                           void * const hSS,
+                           void * state);
+
+/**
+ * Destroys the states which have been retired by the reader (writer thread
+ * only)
+ *
+ * @param[in] hSS state swap handle
+ */
+void saf_stateSwap_collect(/* Input Arguments */
+                           void * const hSS);
+
+/**
+ * Returns the most recently published state (reader thread only); NULL if no
+ * state has been published yet
+ *
+ * If a new state has been published since the previous call, then the previous
+ * state is retired. Hence, the returned state remains valid until the next
+ * call to this function.
+ *
+ * @param[in] hSS state swap handle
+ * @returns The current state
+ */
+void* saf_stateSwap_acquire(/* Input Arguments */
+                            void * const hSS);
+
+
+#ifdef __cplusplus
+}/* extern "C" */
+#endif /* __cplusplus */
+
+#endif /* SAF_THREADS_H_INCLUDED */
+
+/**@} */ /* doxygen addtogroup Utilities */
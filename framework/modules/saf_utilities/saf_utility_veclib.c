@@ -74,6 +74,602 @@
 #endif
 
 
+/* ========================================================================== */
+/*                          SIMD Kernel Dispatching                           */
+/* ========================================================================== */
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+# define SAF_VECLIB_X86 /**< x86 kernels (selected at run-time) */
+# if defined(_MSC_VER)
+#  include <intrin.h>
+#  define SAF_TARGET(isa)
+# else
+/** Compiles a function for the specified instruction set(s) */
+#  define SAF_TARGET(isa) __attribute__((target(isa)))
+# endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+# define SAF_VECLIB_NEON /**< NEON kernels (always available) */
+# define SAF_TARGET(isa)
+#else
+# define SAF_TARGET(isa)
+#endif
+#if !defined(__ACCELERATE__) && !defined(INTEL_MKL_VERSION)
+/** The element-wise routines (?vvadd, ?vvmul etc.) use the SIMD kernels */
+# define SAF_VECLIB_DISPATCH
+#endif
+
+/** Function pointer table of the kernels for the selected SAF_SIMD_LEVEL */
+typedef struct _saf_veclib_kernels {
+    SAF_SIMD_LEVEL level;
+    void (*cvvmuladd)(const float*, const float*, int, int, float*);
+    void (*cvvmuladd_split)(const float*, const float*, const float*, const float*, int, int, float*, float*);
+    void (*svvadd)(const float*, const float*, int, float*);
+    void (*svvsub)(const float*, const float*, int, float*);
+    void (*svvmul)(const float*, const float*, int, float*);
+    void (*svsadd)(const float*, float, int, float*);
+    void (*svsmul)(const float*, float, int, float*);
+    void (*cvvmul)(const float*, const float*, int, float*);
+    void (*svvmuladd)(const float*, const float*, int, float*);
+    void (*svvmulfold)(const float*, const float*, int, int, float*);
+
+}saf_veclib_kernels;
+
+static saf_veclib_kernels saf_veclib_k;              /**< Selected kernels */
+static volatile int saf_veclib_kInitFLAG = 0;        /**< '1' once selected */
+static volatile int saf_veclib_kLock = 0;            /**< Guards selection */
+static SAF_SIMD_LEVEL saf_veclib_maxLevel = SAF_SIMD_NEON; /**< User limit */
+
+/* Reference kernels. Interleaved complex vectors are passed as float arrays of
+ * length 2*len, and conjFLAG=1 conjugates 'a' */
+
+static void saf_cvvmuladd_ref(const float* a, const float* b, int len, int conjFLAG, float* c)
+{
+    int i;
+    float ai;
+    for(i=0; i<len; i++){
+        ai = conjFLAG ? -a[2*i+1] : a[2*i+1];
+        c[2*i]   += a[2*i]*b[2*i]   - ai*b[2*i+1];
+        c[2*i+1] += a[2*i]*b[2*i+1] + ai*b[2*i];
+    }
+}
+
+static void saf_cvvmuladd_split_ref(const float* a_re, const float* a_im, const float* b_re, const float* b_im, int len, int conjFLAG, float* c_re, float* c_im)
+{
+    int i;
+    float ai;
+    for(i=0; i<len; i++){
+        ai = conjFLAG ? -a_im[i] : a_im[i];
+        c_re[i] += a_re[i]*b_re[i] - ai*b_im[i];
+        c_im[i] += a_re[i]*b_im[i] + ai*b_re[i];
+    }
+}
+
+#if defined(SAF_VECLIB_X86)
+/* The conjugate of 'a' is taken by flipping the sign bit of its imaginary
+ * parts, and a*b is computed as: re(a)*b -/+ im(a)*swap(b) */
+
+SAF_TARGET("sse3") static void saf_cvvmuladd_sse3(const float* a, const float* b, int len, int conjFLAG, float* c)
+{
+    int i;
+    __m128 sgn, va, vb, t;
+    sgn = conjFLAG ? _mm_castsi128_ps(_mm_set_epi32((int)0x80000000, 0, (int)0x80000000, 0)) : _mm_setzero_ps();
+    for(i=0; i<=len-2; i+=2){
+        va = _mm_xor_ps(_mm_loadu_ps(&a[2*i]), sgn);
+        vb = _mm_loadu_ps(&b[2*i]);
+        t = _mm_mul_ps(_mm_movehdup_ps(va), _mm_shuffle_ps(vb, vb, _MM_SHUFFLE(2,3,0,1)));
+        t = _mm_addsub_ps(_mm_mul_ps(_mm_moveldup_ps(va), vb), t);
+        _mm_storeu_ps(&c[2*i], _mm_add_ps(_mm_loadu_ps(&c[2*i]), t));
+    }
+    saf_cvvmuladd_ref(&a[2*i], &b[2*i], len-i, conjFLAG, &c[2*i]);
+}
+
+SAF_TARGET("avx2,fma") static void saf_cvvmuladd_avx2(const float* a, const float* b, int len, int conjFLAG, float* c)
+{
+    int i;
+    __m256 sgn, va, vb, t;
+    sgn = conjFLAG ? _mm256_castsi256_ps(_mm256_set1_epi64x((long long)0x8000000000000000ULL)) : _mm256_setzero_ps();
+    for(i=0; i<=len-4; i+=4){
+        va = _mm256_xor_ps(_mm256_loadu_ps(&a[2*i]), sgn);
+        vb = _mm256_loadu_ps(&b[2*i]);
+        t = _mm256_mul_ps(_mm256_movehdup_ps(va), _mm256_permute_ps(vb, 0xB1));
+        t = _mm256_fmaddsub_ps(_mm256_moveldup_ps(va), vb, t);
+        _mm256_storeu_ps(&c[2*i], _mm256_add_ps(_mm256_loadu_ps(&c[2*i]), t));
+    }
+    saf_cvvmuladd_sse3(&a[2*i], &b[2*i], len-i, conjFLAG, &c[2*i]);
+}
+
+SAF_TARGET("avx512f") static void saf_cvvmuladd_avx512(const float* a, const float* b, int len, int conjFLAG, float* c)
+{
+    int i;
+    __m512i sgn;
+    __m512 va, vb, t;
+    sgn = conjFLAG ? _mm512_set1_epi64((long long)0x8000000000000000ULL) : _mm512_setzero_si512();
+    for(i=0; i<=len-8; i+=8){
+        va = _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(_mm512_loadu_ps(&a[2*i])), sgn));
+        vb = _mm512_loadu_ps(&b[2*i]);
+        t = _mm512_mul_ps(_mm512_movehdup_ps(va), _mm512_permute_ps(vb, 0xB1));
+        t = _mm512_fmaddsub_ps(_mm512_moveldup_ps(va), vb, t);
+        _mm512_storeu_ps(&c[2*i], _mm512_add_ps(_mm512_loadu_ps(&c[2*i]), t));
+    }
+    saf_cvvmuladd_sse3(&a[2*i], &b[2*i], len-i, conjFLAG, &c[2*i]);
+}
+
+SAF_TARGET("sse3") static void saf_cvvmuladd_split_sse3(const float* a_re, const float* a_im, const float* b_re, const float* b_im, int len, int conjFLAG, float* c_re, float* c_im)
+{
+    int i;
+    __m128 sgn, ar, ai, br, bi;
+    sgn = conjFLAG ? _mm_set1_ps(-0.0f) : _mm_setzero_ps();
+    for(i=0; i<=len-4; i+=4){
+        ar = _mm_loadu_ps(&a_re[i]);
+        ai = _mm_xor_ps(_mm_loadu_ps(&a_im[i]), sgn);
+        br = _mm_loadu_ps(&b_re[i]);
+        bi = _mm_loadu_ps(&b_im[i]);
+        _mm_storeu_ps(&c_re[i], _mm_add_ps(_mm_loadu_ps(&c_re[i]), _mm_sub_ps(_mm_mul_ps(ar, br), _mm_mul_ps(ai, bi))));
+        _mm_storeu_ps(&c_im[i], _mm_add_ps(_mm_loadu_ps(&c_im[i]), _mm_add_ps(_mm_mul_ps(ar, bi), _mm_mul_ps(ai, br))));
+    }
+    saf_cvvmuladd_split_ref(&a_re[i], &a_im[i], &b_re[i], &b_im[i], len-i, conjFLAG, &c_re[i], &c_im[i]);
+}
+
+SAF_TARGET("avx2,fma") static void saf_cvvmuladd_split_avx2(const float* a_re, const float* a_im, const float* b_re, const float* b_im, int len, int conjFLAG, float* c_re, float* c_im)
+{
+    int i;
+    __m256 sgn, ar, ai, br, bi;
+    sgn = conjFLAG ? _mm256_set1_ps(-0.0f) : _mm256_setzero_ps();
+    for(i=0; i<=len-8; i+=8){
+        ar = _mm256_loadu_ps(&a_re[i]);
+        ai = _mm256_xor_ps(_mm256_loadu_ps(&a_im[i]), sgn);
+        br = _mm256_loadu_ps(&b_re[i]);
+        bi = _mm256_loadu_ps(&b_im[i]);
+        _mm256_storeu_ps(&c_re[i], _mm256_fnmadd_ps(ai, bi, _mm256_fmadd_ps(ar, br, _mm256_loadu_ps(&c_re[i]))));
+        _mm256_storeu_ps(&c_im[i], _mm256_fmadd_ps(ai, br, _mm256_fmadd_ps(ar, bi, _mm256_loadu_ps(&c_im[i]))));
+    }
+    saf_cvvmuladd_split_sse3(&a_re[i], &a_im[i], &b_re[i], &b_im[i], len-i, conjFLAG, &c_re[i], &c_im[i]);
+}
+
+SAF_TARGET("avx512f") static void saf_cvvmuladd_split_avx512(const float* a_re, const float* a_im, const float* b_re, const float* b_im, int len, int conjFLAG, float* c_re, float* c_im)
+{
+    int i;
+    __m512 ar, ai, br, bi;
+    for(i=0; i<=len-16; i+=16){
+        ar = _mm512_loadu_ps(&a_re[i]);
+        ai = _mm512_loadu_ps(&a_im[i]);
+        if(conjFLAG)
+            ai = _mm512_sub_ps(_mm512_setzero_ps(), ai);
+        br = _mm512_loadu_ps(&b_re[i]);
+        bi = _mm512_loadu_ps(&b_im[i]);
+        _mm512_storeu_ps(&c_re[i], _mm512_fnmadd_ps(ai, bi, _mm512_fmadd_ps(ar, br, _mm512_loadu_ps(&c_re[i]))));
+        _mm512_storeu_ps(&c_im[i], _mm512_fmadd_ps(ai, br, _mm512_fmadd_ps(ar, bi, _mm512_loadu_ps(&c_im[i]))));
+    }
+    saf_cvvmuladd_split_sse3(&a_re[i], &a_im[i], &b_re[i], &b_im[i], len-i, conjFLAG, &c_re[i], &c_im[i]);
+}
+#endif /* SAF_VECLIB_X86 */
+
+#if defined(SAF_VECLIB_NEON)
+static void saf_cvvmuladd_neon(const float* a, const float* b, int len, int conjFLAG, float* c)
+{
+    int i;
+    float32x4x2_t va, vb, vc;
+    for(i=0; i<=len-4; i+=4){
+        va = vld2q_f32(&a[2*i]); /* de-interleaves into real/imaginary parts */
+        vb = vld2q_f32(&b[2*i]);
+        vc = vld2q_f32(&c[2*i]);
+        if(conjFLAG)
+            va.val[1] = vnegq_f32(va.val[1]);
+        vc.val[0] = vmlsq_f32(vmlaq_f32(vc.val[0], va.val[0], vb.val[0]), va.val[1], vb.val[1]);
+        vc.val[1] = vmlaq_f32(vmlaq_f32(vc.val[1], va.val[0], vb.val[1]), va.val[1], vb.val[0]);
+        vst2q_f32(&c[2*i], vc);
+    }
+    saf_cvvmuladd_ref(&a[2*i], &b[2*i], len-i, conjFLAG, &c[2*i]);
+}
+
+static void saf_cvvmuladd_split_neon(const float* a_re, const float* a_im, const float* b_re, const float* b_im, int len, int conjFLAG, float* c_re, float* c_im)
+{
+    int i;
+    float32x4_t ar, ai, br, bi;
+    for(i=0; i<=len-4; i+=4){
+        ar = vld1q_f32(&a_re[i]);
+        ai = vld1q_f32(&a_im[i]);
+        if(conjFLAG)
+            ai = vnegq_f32(ai);
+        br = vld1q_f32(&b_re[i]);
+        bi = vld1q_f32(&b_im[i]);
+        vst1q_f32(&c_re[i], vmlsq_f32(vmlaq_f32(vld1q_f32(&c_re[i]), ar, br), ai, bi));
+        vst1q_f32(&c_im[i], vmlaq_f32(vmlaq_f32(vld1q_f32(&c_im[i]), ar, bi), ai, br));
+    }
+    saf_cvvmuladd_split_ref(&a_re[i], &a_im[i], &b_re[i], &b_im[i], len-i, conjFLAG, &c_re[i], &c_im[i]);
+}
+#endif /* SAF_VECLIB_NEON */
+
+/* Element-wise kernels. The real-valued kernels are also used for the complex
+ * addition/subtraction, by treating the vectors as float arrays of length
+ * 2*len. Note that addition, subtraction and multiplication are exact in IEEE
+ * arithmetic, so only cvvmul (which may employ FMA) can deviate from the
+ * reference kernels, by a few ULPs */
+
+static void saf_svvadd_ref(const float* a, const float* b, int len, float* c)
+{
+    int i;
+    for(i=0; i<len; i++)
+        c[i] = a[i] + b[i];
+}
+
+static void saf_svvsub_ref(const float* a, const float* b, int len, float* c)
+{
+    int i;
+    for(i=0; i<len; i++)
+        c[i] = a[i] - b[i];
+}
+
+static void saf_svvmul_ref(const float* a, const float* b, int len, float* c)
+{
+    int i;
+    for(i=0; i<len; i++)
+        c[i] = a[i] * b[i];
+}
+
+static void saf_svsadd_ref(const float* a, float s, int len, float* c)
+{
+    int i;
+    for(i=0; i<len; i++)
+        c[i] = a[i] + s;
+}
+
+static void saf_svsmul_ref(const float* a, float s, int len, float* c)
+{
+    int i;
+    for(i=0; i<len; i++)
+        c[i] = a[i] * s;
+}
+
+static void saf_cvvmul_ref(const float* a, const float* b, int len, float* c)
+{
+    int i;
+    float re;
+    for(i=0; i<len; i++){
+        re         = a[2*i]*b[2*i]   - a[2*i+1]*b[2*i+1];
+        c[2*i+1]   = a[2*i]*b[2*i+1] + a[2*i+1]*b[2*i];
+        c[2*i]     = re;
+    }
+}
+
+/** Defines a kernel for c[i] = a[i] OP b[i], which processes W elements per
+ * iteration and passes the remainder on to the TAIL kernel */
+#define SAF_VV_KERNEL(NAME, ISA, W, LOADU, STOREU, OP, TAIL) \
+SAF_TARGET(ISA) static void NAME(const float* a, const float* b, int len, float* c) \
+{ \
+    int i; \
+    for(i=0; i<=len-(W); i+=(W)) \
+        STOREU(&c[i], OP(LOADU(&a[i]), LOADU(&b[i]))); \
+    TAIL(&a[i], &b[i], len-i, &c[i]); \
+}
+
+/** Defines a kernel for c[i] = a[i] OP s, which processes W elements per
+ * iteration and passes the remainder on to the TAIL kernel */
+#define SAF_VS_KERNEL(NAME, ISA, VEC, W, LOADU, STOREU, SET1, OP, TAIL) \
+SAF_TARGET(ISA) static void NAME(const float* a, float s, int len, float* c) \
+{ \
+    int i; \
+    VEC vs = SET1(s); \
+    for(i=0; i<=len-(W); i+=(W)) \
+        STOREU(&c[i], OP(LOADU(&a[i]), vs)); \
+    TAIL(&a[i], s, len-i, &c[i]); \
+}
+
+#if defined(SAF_VECLIB_X86)
+SAF_VV_KERNEL(saf_svvadd_sse,    "sse2",    4,  _mm_loadu_ps,    _mm_storeu_ps,    _mm_add_ps,    saf_svvadd_ref)
+SAF_VV_KERNEL(saf_svvadd_avx2,   "avx2",    8,  _mm256_loadu_ps, _mm256_storeu_ps, _mm256_add_ps, saf_svvadd_sse)
+SAF_VV_KERNEL(saf_svvadd_avx512, "avx512f", 16, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_add_ps, saf_svvadd_sse)
+SAF_VV_KERNEL(saf_svvsub_sse,    "sse2",    4,  _mm_loadu_ps,    _mm_storeu_ps,    _mm_sub_ps,    saf_svvsub_ref)
+SAF_VV_KERNEL(saf_svvsub_avx2,   "avx2",    8,  _mm256_loadu_ps, _mm256_storeu_ps, _mm256_sub_ps, saf_svvsub_sse)
+SAF_VV_KERNEL(saf_svvsub_avx512, "avx512f", 16, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_sub_ps, saf_svvsub_sse)
+SAF_VV_KERNEL(saf_svvmul_sse,    "sse2",    4,  _mm_loadu_ps,    _mm_storeu_ps,    _mm_mul_ps,    saf_svvmul_ref)
+SAF_VV_KERNEL(saf_svvmul_avx2,   "avx2",    8,  _mm256_loadu_ps, _mm256_storeu_ps, _mm256_mul_ps, saf_svvmul_sse)
+SAF_VV_KERNEL(saf_svvmul_avx512, "avx512f", 16, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_mul_ps, saf_svvmul_sse)
+SAF_VS_KERNEL(saf_svsadd_sse,    "sse2",    __m128, 4,  _mm_loadu_ps,    _mm_storeu_ps,    _mm_set1_ps,    _mm_add_ps,    saf_svsadd_ref)
+SAF_VS_KERNEL(saf_svsadd_avx2,   "avx2",    __m256, 8,  _mm256_loadu_ps, _mm256_storeu_ps, _mm256_set1_ps, _mm256_add_ps, saf_svsadd_sse)
+SAF_VS_KERNEL(saf_svsadd_avx512, "avx512f", __m512, 16, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_set1_ps, _mm512_add_ps, saf_svsadd_sse)
+SAF_VS_KERNEL(saf_svsmul_sse,    "sse2",    __m128, 4,  _mm_loadu_ps,    _mm_storeu_ps,    _mm_set1_ps,    _mm_mul_ps,    saf_svsmul_ref)
+SAF_VS_KERNEL(saf_svsmul_avx2,   "avx2",    __m256, 8,  _mm256_loadu_ps, _mm256_storeu_ps, _mm256_set1_ps, _mm256_mul_ps, saf_svsmul_sse)
+SAF_VS_KERNEL(saf_svsmul_avx512, "avx512f", __m512, 16, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_set1_ps, _mm512_mul_ps, saf_svsmul_sse)
+
+SAF_TARGET("sse3") static void saf_cvvmul_sse3(const float* a, const float* b, int len, float* c)
+{
+    int i;
+    __m128 va, vb, t;
+    for(i=0; i<=len-2; i+=2){
+        va = _mm_loadu_ps(&a[2*i]);
+        vb = _mm_loadu_ps(&b[2*i]);
+        t = _mm_mul_ps(_mm_movehdup_ps(va), _mm_shuffle_ps(vb, vb, _MM_SHUFFLE(2,3,0,1)));
+        _mm_storeu_ps(&c[2*i], _mm_addsub_ps(_mm_mul_ps(_mm_moveldup_ps(va), vb), t));
+    }
+    saf_cvvmul_ref(&a[2*i], &b[2*i], len-i, &c[2*i]);
+}
+
+SAF_TARGET("avx2,fma") static void saf_cvvmul_avx2(const float* a, const float* b, int len, float* c)
+{
+    int i;
+    __m256 va, vb, t;
+    for(i=0; i<=len-4; i+=4){
+        va = _mm256_loadu_ps(&a[2*i]);
+        vb = _mm256_loadu_ps(&b[2*i]);
+        t = _mm256_mul_ps(_mm256_movehdup_ps(va), _mm256_permute_ps(vb, 0xB1));
+        _mm256_storeu_ps(&c[2*i], _mm256_fmaddsub_ps(_mm256_moveldup_ps(va), vb, t));
+    }
+    saf_cvvmul_sse3(&a[2*i], &b[2*i], len-i, &c[2*i]);
+}
+
+SAF_TARGET("avx512f") static void saf_cvvmul_avx512(const float* a, const float* b, int len, float* c)
+{
+    int i;
+    __m512 va, vb, t;
+    for(i=0; i<=len-8; i+=8){
+        va = _mm512_loadu_ps(&a[2*i]);
+        vb = _mm512_loadu_ps(&b[2*i]);
+        t = _mm512_mul_ps(_mm512_movehdup_ps(va), _mm512_permute_ps(vb, 0xB1));
+        _mm512_storeu_ps(&c[2*i], _mm512_fmaddsub_ps(_mm512_moveldup_ps(va), vb, t));
+    }
+    saf_cvvmul_sse3(&a[2*i], &b[2*i], len-i, &c[2*i]);
+}
+#endif /* SAF_VECLIB_X86 */
+
+#if defined(SAF_VECLIB_NEON)
+SAF_VV_KERNEL(saf_svvadd_neon, "neon", 4, vld1q_f32, vst1q_f32, vaddq_f32, saf_svvadd_ref)
+SAF_VV_KERNEL(saf_svvsub_neon, "neon", 4, vld1q_f32, vst1q_f32, vsubq_f32, saf_svvsub_ref)
+SAF_VV_KERNEL(saf_svvmul_neon, "neon", 4, vld1q_f32, vst1q_f32, vmulq_f32, saf_svvmul_ref)
+SAF_VS_KERNEL(saf_svsadd_neon, "neon", float32x4_t, 4, vld1q_f32, vst1q_f32, vdupq_n_f32, vaddq_f32, saf_svsadd_ref)
+SAF_VS_KERNEL(saf_svsmul_neon, "neon", float32x4_t, 4, vld1q_f32, vst1q_f32, vdupq_n_f32, vmulq_f32, saf_svsmul_ref)
+
+static void saf_cvvmul_neon(const float* a, const float* b, int len, float* c)
+{
+    int i;
+    float32x4x2_t va, vb, vc;
+    for(i=0; i<=len-4; i+=4){
+        va = vld2q_f32(&a[2*i]);
+        vb = vld2q_f32(&b[2*i]);
+        vc.val[0] = vmlsq_f32(vmulq_f32(va.val[0], vb.val[0]), va.val[1], vb.val[1]);
+        vc.val[1] = vmlaq_f32(vmulq_f32(va.val[0], vb.val[1]), va.val[1], vb.val[0]);
+        vst2q_f32(&c[2*i], vc);
+    }
+    saf_cvvmul_ref(&a[2*i], &b[2*i], len-i, &c[2*i]);
+}
+#endif /* SAF_VECLIB_NEON */
+
+/* Real multiply-accumulate kernels. svvmulfold computes the element-wise
+ * product of two vectors comprising nSeg segments of segLen, and sums the
+ * segments together, i.e. c[i] = sum_m a[m*segLen+i]*b[m*segLen+i]; the
+ * accumulation is kept in registers, and 'c' is written only once */
+
+static void saf_svvmuladd_ref(const float* a, const float* b, int len, float* c)
+{
+    int i;
+    for(i=0; i<len; i++)
+        c[i] += a[i] * b[i];
+}
+
+/** svvmulfold over the first 'len' elements of each segment */
+static void saf_svvmulfold_part(const float* a, const float* b, int segLen, int len, int nSeg, float* c)
+{
+    int i, m;
+    float acc;
+    for(i=0; i<len; i++){
+        acc = 0.0f;
+        for(m=0; m<nSeg; m++)
+            acc += a[m*segLen+i] * b[m*segLen+i];
+        c[i] = acc;
+    }
+}
+
+static void saf_svvmulfold_ref(const float* a, const float* b, int segLen, int nSeg, float* c)
+{
+    saf_svvmulfold_part(a, b, segLen, segLen, nSeg, c);
+}
+
+/** Defines a kernel for c[i] += a[i]*b[i], which processes W elements per
+ * iteration and passes the remainder on to the TAIL kernel */
+#define SAF_VVMULADD_KERNEL(NAME, ISA, W, LOADU, STOREU, MULADD, TAIL) \
+SAF_TARGET(ISA) static void NAME(const float* a, const float* b, int len, float* c) \
+{ \
+    int i; \
+    for(i=0; i<=len-(W); i+=(W)) \
+        STOREU(&c[i], MULADD(LOADU(&a[i]), LOADU(&b[i]), LOADU(&c[i]))); \
+    TAIL(&a[i], &b[i], len-i, &c[i]); \
+}
+
+/** Defines a kernel for c[i] = sum_m a[m*segLen+i]*b[m*segLen+i], which
+ * processes W elements of each segment per iteration (the remainder is passed
+ * on to saf_svvmulfold_part()) */
+#define SAF_VVMULFOLD_KERNEL(NAME, ISA, VEC, W, LOADU, STOREU, ZERO, MULADD) \
+SAF_TARGET(ISA) static void NAME(const float* a, const float* b, int segLen, int nSeg, float* c) \
+{ \
+    int i, m; \
+    VEC acc; \
+    for(i=0; i<=segLen-(W); i+=(W)){ \
+        acc = ZERO; \
+        for(m=0; m<nSeg; m++) \
+            acc = MULADD(LOADU(&a[m*segLen+i]), LOADU(&b[m*segLen+i]), acc); \
+        STOREU(&c[i], acc); \
+    } \
+    saf_svvmulfold_part(&a[i], &b[i], segLen, segLen-i, nSeg, &c[i]); \
+}
+
+#if defined(SAF_VECLIB_X86)
+/** SSE multiply-add, without FMA */
+# define SAF_MM_MULADD(a, b, c) _mm_add_ps(_mm_mul_ps((a), (b)), (c))
+SAF_VVMULADD_KERNEL(saf_svvmuladd_sse,    "sse2",     4,  _mm_loadu_ps,    _mm_storeu_ps,    SAF_MM_MULADD,    saf_svvmuladd_ref)
+SAF_VVMULADD_KERNEL(saf_svvmuladd_avx2,   "avx2,fma", 8,  _mm256_loadu_ps, _mm256_storeu_ps, _mm256_fmadd_ps,  saf_svvmuladd_sse)
+SAF_VVMULADD_KERNEL(saf_svvmuladd_avx512, "avx512f",  16, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_fmadd_ps,  saf_svvmuladd_sse)
+SAF_VVMULFOLD_KERNEL(saf_svvmulfold_sse,    "sse2",     __m128, 4,  _mm_loadu_ps,    _mm_storeu_ps,    _mm_setzero_ps(),    SAF_MM_MULADD)
+SAF_VVMULFOLD_KERNEL(saf_svvmulfold_avx2,   "avx2,fma", __m256, 8,  _mm256_loadu_ps, _mm256_storeu_ps, _mm256_setzero_ps(), _mm256_fmadd_ps)
+SAF_VVMULFOLD_KERNEL(saf_svvmulfold_avx512, "avx512f",  __m512, 16, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_setzero_ps(), _mm512_fmadd_ps)
+#endif /* SAF_VECLIB_X86 */
+
+#if defined(SAF_VECLIB_NEON)
+/** NEON multiply-add (argument order as for the x86 fmadd intrinsics) */
+# define SAF_NEON_MULADD(a, b, c) vmlaq_f32((c), (a), (b))
+SAF_VVMULADD_KERNEL(saf_svvmuladd_neon, "neon", 4, vld1q_f32, vst1q_f32, SAF_NEON_MULADD, saf_svvmuladd_ref)
+SAF_VVMULFOLD_KERNEL(saf_svvmulfold_neon, "neon", float32x4_t, 4, vld1q_f32, vst1q_f32, vdupq_n_f32(0.0f), SAF_NEON_MULADD)
+#endif /* SAF_VECLIB_NEON */
+
+/** Returns the highest SAF_SIMD_LEVEL supported by the CPU (and the OS) */
+static SAF_SIMD_LEVEL saf_veclib_detectSIMD(void)
+{
+#if defined(SAF_VECLIB_X86) && defined(_MSC_VER)
+    int r[4], osAVX, osAVX512;
+    unsigned long long xcr0;
+    __cpuid(r, 0);
+    if(r[0]<1)
+        return SAF_SIMD_NONE;
+    __cpuid(r, 1);
+    xcr0 = (r[2] & (1<<27)) ? _xgetbv(0) : 0; /* OSXSAVE */
+    osAVX = (xcr0 & 0x6) == 0x6;              /* XMM and YMM state */
+    osAVX512 = (xcr0 & 0xE6) == 0xE6;         /* ...and opmask/ZMM state */
+    if(!(r[2] & (1<<0)))                      /* SSE3 */
+        return SAF_SIMD_NONE;
+    if(!osAVX || !(r[2] & (1<<28)) || !(r[2] & (1<<12))) /* AVX, FMA */
+        return SAF_SIMD_SSE;
+    __cpuid(r, 0);
+    if(r[0]<7)
+        return SAF_SIMD_SSE;
+    __cpuidex(r, 7, 0);
+    if(osAVX512 && (r[1] & (1<<16)))          /* AVX-512F */
+        return SAF_SIMD_AVX512;
+    if(r[1] & (1<<5))                         /* AVX2 */
+        return SAF_SIMD_AVX2;
+    return SAF_SIMD_SSE;
+#elif defined(SAF_VECLIB_X86)
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512f"))
+        return SAF_SIMD_AVX512;
+    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return SAF_SIMD_AVX2;
+    if(__builtin_cpu_supports("sse3"))
+        return SAF_SIMD_SSE;
+    return SAF_SIMD_NONE;
+#elif defined(SAF_VECLIB_NEON)
+    return SAF_SIMD_NEON;
+#else
+    return SAF_SIMD_NONE;
+#endif
+}
+
+/** Fills the kernel table for the given SAF_SIMD_LEVEL */
+static void saf_veclib_selectKernels(SAF_SIMD_LEVEL level)
+{
+    saf_veclib_k.level = SAF_SIMD_NONE;
+    saf_veclib_k.cvvmuladd = saf_cvvmuladd_ref;
+    saf_veclib_k.cvvmuladd_split = saf_cvvmuladd_split_ref;
+    saf_veclib_k.svvadd = saf_svvadd_ref;
+    saf_veclib_k.svvsub = saf_svvsub_ref;
+    saf_veclib_k.svvmul = saf_svvmul_ref;
+    saf_veclib_k.svsadd = saf_svsadd_ref;
+    saf_veclib_k.svsmul = saf_svsmul_ref;
+    saf_veclib_k.cvvmul = saf_cvvmul_ref;
+    saf_veclib_k.svvmuladd = saf_svvmuladd_ref;
+    saf_veclib_k.svvmulfold = saf_svvmulfold_ref;
+    switch(level){
+        case SAF_SIMD_NONE:
+            break;
+#if defined(SAF_VECLIB_X86)
+        case SAF_SIMD_AVX512:
+            saf_veclib_k.level = SAF_SIMD_AVX512;
+            saf_veclib_k.cvvmuladd = saf_cvvmuladd_avx512;
+            saf_veclib_k.cvvmuladd_split = saf_cvvmuladd_split_avx512;
+            saf_veclib_k.svvadd = saf_svvadd_avx512;
+            saf_veclib_k.svvsub = saf_svvsub_avx512;
+            saf_veclib_k.svvmul = saf_svvmul_avx512;
+            saf_veclib_k.svsadd = saf_svsadd_avx512;
+            saf_veclib_k.svsmul = saf_svsmul_avx512;
+            saf_veclib_k.cvvmul = saf_cvvmul_avx512;
+            saf_veclib_k.svvmuladd = saf_svvmuladd_avx512;
+            saf_veclib_k.svvmulfold = saf_svvmulfold_avx512;
+            break;
+        case SAF_SIMD_AVX2:
+            saf_veclib_k.level = SAF_SIMD_AVX2;
+            saf_veclib_k.cvvmuladd = saf_cvvmuladd_avx2;
+            saf_veclib_k.cvvmuladd_split = saf_cvvmuladd_split_avx2;
+            saf_veclib_k.svvadd = saf_svvadd_avx2;
+            saf_veclib_k.svvsub = saf_svvsub_avx2;
+            saf_veclib_k.svvmul = saf_svvmul_avx2;
+            saf_veclib_k.svsadd = saf_svsadd_avx2;
+            saf_veclib_k.svsmul = saf_svsmul_avx2;
+            saf_veclib_k.cvvmul = saf_cvvmul_avx2;
+            saf_veclib_k.svvmuladd = saf_svvmuladd_avx2;
+            saf_veclib_k.svvmulfold = saf_svvmulfold_avx2;
+            break;
+        case SAF_SIMD_SSE:
+            saf_veclib_k.level = SAF_SIMD_SSE;
+            saf_veclib_k.cvvmuladd = saf_cvvmuladd_sse3;
+            saf_veclib_k.cvvmuladd_split = saf_cvvmuladd_split_sse3;
+            saf_veclib_k.svvadd = saf_svvadd_sse;
+            saf_veclib_k.svvsub = saf_svvsub_sse;
+            saf_veclib_k.svvmul = saf_svvmul_sse;
+            saf_veclib_k.svsadd = saf_svsadd_sse;
+            saf_veclib_k.svsmul = saf_svsmul_sse;
+            saf_veclib_k.cvvmul = saf_cvvmul_sse3;
+            saf_veclib_k.svvmuladd = saf_svvmuladd_sse;
+            saf_veclib_k.svvmulfold = saf_svvmulfold_sse;
+            break;
+#elif defined(SAF_VECLIB_NEON)
+        case SAF_SIMD_NEON:
+            saf_veclib_k.level = SAF_SIMD_NEON;
+            saf_veclib_k.cvvmuladd = saf_cvvmuladd_neon;
+            saf_veclib_k.cvvmuladd_split = saf_cvvmuladd_split_neon;
+            saf_veclib_k.svvadd = saf_svvadd_neon;
+            saf_veclib_k.svvsub = saf_svvsub_neon;
+            saf_veclib_k.svvmul = saf_svvmul_neon;
+            saf_veclib_k.svsadd = saf_svsadd_neon;
+            saf_veclib_k.svsmul = saf_svsmul_neon;
+            saf_veclib_k.cvvmul = saf_cvvmul_neon;
+            saf_veclib_k.svvmuladd = saf_svvmuladd_neon;
+            saf_veclib_k.svvmulfold = saf_svvmulfold_neon;
+            break;
+#endif
+        default:
+            break;
+    }
+}
+
+/**
+ * Returns the kernel table; the kernels are selected upon first use, according
+ * to the instruction sets supported by the CPU
+ */
+static const saf_veclib_kernels* saf_veclib_getKernels(void)
+{
+    SAF_SIMD_LEVEL level;
+
+    if(!saf_atomic_loadInt(&saf_veclib_kInitFLAG)){
+        saf_spinlock_lock(&saf_veclib_kLock);
+        if(!saf_veclib_kInitFLAG){
+            level = saf_veclib_detectSIMD();
+            saf_veclib_selectKernels(MIN(level, saf_veclib_maxLevel));
+            saf_atomic_storeInt(&saf_veclib_kInitFLAG, 1);
+        }
+        saf_spinlock_unlock(&saf_veclib_kLock);
+    }
+    return &saf_veclib_k;
+}
+
+SAF_SIMD_LEVEL utility_getSIMDlevel(void)
+{
+    return saf_veclib_getKernels()->level;
+}
+
+void utility_setMaxSIMDlevel
+(
+    SAF_SIMD_LEVEL maxLevel
+)
+{
+    SAF_SIMD_LEVEL level;
+
+    saf_spinlock_lock(&saf_veclib_kLock);
+    saf_veclib_maxLevel = maxLevel;
+    level = saf_veclib_detectSIMD();
+    saf_veclib_selectKernels(MIN(level, saf_veclib_maxLevel));
+    saf_atomic_storeInt(&saf_veclib_kInitFLAG, 1);
+    saf_spinlock_unlock(&saf_veclib_kLock);
+}
+
+
 /* ========================================================================== */
 /*                     Find Index of Min-Abs-Value (?iminv)                   */
 /* ========================================================================== */
@@ -238,7 +834,7 @@ void utility_svvadd
     float* c
 )
 {
-#if NDEBUG
+#if NDEBUG && !defined(SAF_VECLIB_DISPATCH)
     int i;
     if (len<10e4 && len > 7){
         for(i=0; i<len-8; i+=8){
@@ -261,9 +857,7 @@ void utility_svvadd
 #elif defined(INTEL_MKL_VERSION)
     vsAdd(len, a, b, c);
 #else
-	int j;
-	for (j = 0; j < len; j++)
-		c[j] = a[j] + b[j];
+    saf_veclib_getKernels()->svvadd(a, b, len, c);
 #endif
 }
 
@@ -275,7 +869,7 @@ void utility_cvvadd
     float_complex* c
 )
 {
-#if __STDC_VERSION__ >= 199901L && NDEBUG
+#if __STDC_VERSION__ >= 199901L && NDEBUG && !defined(SAF_VECLIB_DISPATCH)
     int i;
     if (len<10e4 && len > 7){
         for(i=0; i<len-8; i+=8){
@@ -296,9 +890,30 @@ void utility_cvvadd
 #ifdef INTEL_MKL_VERSION
     vcAdd(len, (MKL_Complex8*)a, (MKL_Complex8*)b, (MKL_Complex8*)c);
 #else
-    int j;
-	for (j = 0; j < len; j++)
-		c[j] = ccaddf(a[j], b[j]);
+    saf_veclib_getKernels()->svvadd((const float*)a, (const float*)b, 2*len, (float*)c);
+#endif
+}
+
+void utility_cvvadd_split
+(
+    float* a_re,
+    float* a_im,
+    const float* b_re,
+    const float* b_im,
+    const int len,
+    float* c_re,
+    float* c_im
+)
+{
+#ifdef __ACCELERATE__
+    DSPSplitComplex A, B, C;
+    A.realp = a_re; A.imagp = a_im;
+    B.realp = (float*)b_re; B.imagp = (float*)b_im;
+    C.realp = c_re; C.imagp = c_im;
+    vDSP_zvadd(&A, 1, &B, 1, &C, 1, len);
+#else
+    utility_svvadd(a_re, b_re, len, c_re);
+    utility_svvadd(a_im, b_im, len, c_im);
 #endif
 }
 
@@ -315,7 +930,7 @@ void utility_svvsub
     float* c
 )
 {
-#if NDEBUG
+#if NDEBUG && !defined(SAF_VECLIB_DISPATCH)
     int i;
     if (len<10e4 && len > 7){
         for(i=0; i<len-8; i+=8){
@@ -338,9 +953,7 @@ void utility_svvsub
 #elif defined(INTEL_MKL_VERSION)
     vsSub(len, a, b, c);
 #else
-	int j;
-	for (j = 0; j < len; j++)
-		c[j] = a[j] - b[j];
+    saf_veclib_getKernels()->svvsub(a, b, len, c);
 #endif
 }
 
@@ -352,7 +965,7 @@ void utility_cvvsub
     float_complex* c
 )
 {
-#if __STDC_VERSION__ >= 199901L && NDEBUG
+#if __STDC_VERSION__ >= 199901L && NDEBUG && !defined(SAF_VECLIB_DISPATCH)
     int i;
     if (len<10e4 && len > 7){
         for(i=0; i<len-8; i+=8){
@@ -373,9 +986,7 @@ void utility_cvvsub
 #ifdef INTEL_MKL_VERSION
     vcSub(len, (MKL_Complex8*)a, (MKL_Complex8*)b, (MKL_Complex8*)c);
 #else
-	int j;
-    for (j = 0; j < len; j++)
-        c[j] = ccsubf(a[j], b[j]);
+    saf_veclib_getKernels()->svvsub((const float*)a, (const float*)b, 2*len, (float*)c);
 #endif
 }
 
@@ -392,7 +1003,7 @@ void utility_svvmul
     float* c
 )
 {
-#if NDEBUG
+#if NDEBUG && !defined(SAF_VECLIB_DISPATCH)
     int i;
     if (len<10e4 && len > 7){
         for(i=0; i<len-8; i+=8){
@@ -415,9 +1026,7 @@ void utility_svvmul
 #elif defined(INTEL_MKL_VERSION)
     vsMul(len, a, b, c);
 #else
-    int j;
-    for (j = 0; j < len; j++)
-        c[j] = a[j] * b[j];
+    saf_veclib_getKernels()->svvmul(a, b, len, c);
 #endif
 }
 
@@ -429,7 +1038,7 @@ void utility_cvvmul
     float_complex* c
 )
 {
-#if __STDC_VERSION__ >= 199901L && NDEBUG
+#if __STDC_VERSION__ >= 199901L && NDEBUG && !defined(SAF_VECLIB_DISPATCH)
     int i;
     if (len<10e4 && len > 7){
         for(i=0; i<len-8; i+=8){
@@ -450,9 +1059,115 @@ void utility_cvvmul
 #ifdef INTEL_MKL_VERSION
     vcMul(len, (MKL_Complex8*)a, (MKL_Complex8*)b, (MKL_Complex8*)c);
 #else
-	int j;
-    for (j = 0; j < len; j++)
-        c[j] = ccmulf(a[j], b[j]);
+    saf_veclib_getKernels()->cvvmul((const float*)a, (const float*)b, len, (float*)c);
+#endif
+}
+
+void utility_cvvmul_split
+(
+    float* a_re,
+    float* a_im,
+    const float* b_re,
+    const float* b_im,
+    const int len,
+    float* c_re,
+    float* c_im
+)
+{
+#ifdef __ACCELERATE__
+    DSPSplitComplex A, B, C;
+    A.realp = a_re; A.imagp = a_im;
+    B.realp = (float*)b_re; B.imagp = (float*)b_im;
+    C.realp = c_re; C.imagp = c_im;
+    vDSP_zvmul(&A, 1, &B, 1, &C, 1, len, 1);
+#else
+    int j;
+    float re, im;
+    /* (no shuffling of real/imaginary parts is needed, so this vectorises
+     * well) */
+    for (j = 0; j < len; j++){
+        re = a_re[j]*b_re[j] - a_im[j]*b_im[j];
+        im = a_re[j]*b_im[j] + a_im[j]*b_re[j];
+        c_re[j] = re;
+        c_im[j] = im;
+    }
+#endif
+}
+
+
+/* ========================================================================== */
+/*                Vector-Vector Multiply-Accumulate (?vvmuladd)               */
+/* ========================================================================== */
+
+void utility_svvmuladd
+(
+    const float* a,
+    const float* b,
+    const int len,
+    float* c
+)
+{
+#ifdef __ACCELERATE__
+    vDSP_vma(a, 1, b, 1, c, 1, c, 1, len);
+#else
+    saf_veclib_getKernels()->svvmuladd(a, b, len, c);
+#endif
+}
+
+void utility_svvmulfold
+(
+    const float* a,
+    const float* b,
+    const int segLen,
+    const int nSeg,
+    float* c
+)
+{
+#ifdef __ACCELERATE__
+    int m;
+    vDSP_vmul(a, 1, b, 1, c, 1, segLen);
+    for(m=1; m<nSeg; m++)
+        vDSP_vma(&a[m*segLen], 1, &b[m*segLen], 1, c, 1, c, 1, segLen);
+#else
+    saf_veclib_getKernels()->svvmulfold(a, b, segLen, nSeg, c);
+#endif
+}
+
+void utility_cvvmuladd
+(
+    const float_complex* a,
+    const float_complex* b,
+    const int len,
+    CONJ_FLAG flag,
+    float_complex* c
+)
+{
+    saf_veclib_getKernels()->cvvmuladd((const float*)a, (const float*)b, len, flag==CONJ, (float*)c);
+}
+
+void utility_cvvmuladd_split
+(
+    const float* a_re,
+    const float* a_im,
+    const float* b_re,
+    const float* b_im,
+    const int len,
+    CONJ_FLAG flag,
+    float* c_re,
+    float* c_im
+)
+{
+#ifdef __ACCELERATE__
+    DSPSplitComplex A, B, C;
+    A.realp = (float*)a_re; A.imagp = (float*)a_im;
+    B.realp = (float*)b_re; B.imagp = (float*)b_im;
+    C.realp = c_re; C.imagp = c_im;
+    if(flag==CONJ)
+        vDSP_zvcma(&A, 1, &B, 1, &C, 1, &C, 1, len);
+    else
+        vDSP_zvma(&A, 1, &B, 1, &C, 1, &C, 1, len);
+#else
+    saf_veclib_getKernels()->cvvmuladd_split(a_re, a_im, b_re, b_im, len, flag==CONJ, c_re, c_im);
 #endif
 }
 
@@ -513,10 +1228,8 @@ void utility_svsmul
 #else
     if (c == NULL)
         cblas_sscal(len, s[0], a, 1);
-    else {
-        utility_svvcopy(a, len, c); 
-        cblas_sscal(len, s[0], c, 1);
-    }
+    else
+        saf_veclib_getKernels()->svsmul(a, s[0], len, c);
 #endif
 }
 
@@ -579,9 +1292,7 @@ void utility_svsadd
 #ifdef __ACCELERATE__
     vDSP_vsadd(a, 1, s, c, 1, len);
 #else
-    int i;
-    for(i=0; i<len; i++)
-        c[i] = a[i] + s[0];
+    saf_veclib_getKernels()->svsadd(a, s[0], len, c);
 #endif
 }
 
@@ -598,9 +1309,7 @@ void utility_svssub
     float* c
 )
 {
-    int i;
-    for(i=0; i<len; i++)
-        c[i] = a[i] - s[0];
+    saf_veclib_getKernels()->svsadd(a, -s[0], len, c);
 }
 
 
@@ -608,8 +1317,66 @@ void utility_svssub
 /*                     Singular-Value Decomposition (?svd)                    */
 /* ========================================================================== */
 
-void utility_ssvd
+/** Data structure for utility_ssvd_ws() */
+typedef struct _utility_ssvd_data {
+    int maxDim1, maxDim2, lwork;
+    float* a, *s, *u, *vt, *work;
+}utility_ssvd_data;
+
+void utility_ssvd_create
 (
+    void ** const phWork,
+    int maxDim1,
+    int maxDim2
+)
+{
+    *phWork = malloc1d(sizeof(utility_ssvd_data));
+    utility_ssvd_data *h = (utility_ssvd_data*)(*phWork);
+    int m, n, lda, ldu, ldvt, info;
+    float wkopt;
+
+    /* (the row-major input is decomposed as its column-major transpose) */
+    h->maxDim1 = n = ldvt = maxDim1;
+    h->maxDim2 = m = lda = ldu = maxDim2;
+    h->a = malloc1d(m*n*sizeof(float));
+    h->s = malloc1d(MIN(n,m)*sizeof(float));
+    h->u = malloc1d(m*m*sizeof(float));
+    h->vt = malloc1d(n*n*sizeof(float));
+
+    /* workspace query for the largest dimensions (which also suffices for
+     * smaller ones) */
+    wkopt = 0.0f;
+    h->lwork = -1;
+#if defined(VECLIB_USE_LAPACK_FORTRAN_INTERFACE)
+    sgesvd_( "A", "A", &m, &n, h->a, &lda, h->s, h->u, &ldu, h->vt, &ldvt, &wkopt, &(h->lwork), &info );
+#elif defined(VECLIB_USE_LAPACKE_INTERFACE)
+    info = LAPACKE_sgesvd_work(CblasColMajor, 'A', 'A', m, n, h->a, lda, h->s, h->u, ldu, h->vt, ldvt, &wkopt, h->lwork);
+#endif
+    h->lwork = MAX((int)wkopt, MAX(3*MIN(m,n)+MAX(m,n), 5*MIN(m,n)));
+    h->work = malloc1d(h->lwork*sizeof(float));
+}
+
+void utility_ssvd_destroy
+(
+    void ** const phWork
+)
+{
+    utility_ssvd_data *h = (utility_ssvd_data*)(*phWork);
+    if(h!=NULL){
+        free(h->a);
+        free(h->s);
+        free(h->u);
+        free(h->vt);
+        free(h->work);
+        free(h);
+        h=NULL;
+        *phWork = NULL;
+    }
+}
+
+void utility_ssvd_ws
+(
+    void* const hWork,
     const float* A,
     const int dim1,
     const int dim2,
@@ -619,42 +1386,35 @@ void utility_ssvd
     float* sing
 )
 {
+    utility_ssvd_data *h = (utility_ssvd_data*)(hWork);
     int i, j, m, n, lda, ldu, ldvt, info;
-    m = dim1; n = dim2; lda = dim1; ldu = dim1; ldvt = dim2;
+    const char* jobu, *jobvt;
     float* a, *s, *u, *vt;
-#ifdef VECLIB_USE_LAPACK_FORTRAN_INTERFACE
-    int lwork;
-    float wkopt;
-    float *work;
-#elif defined(VECLIB_USE_LAPACKE_INTERFACE)
-    float* superb;
-#endif
-    
-    a = malloc1d(lda*n*sizeof(float));
-    s = malloc1d(MIN(n,m)*sizeof(float));
-    u = malloc1d(ldu*m*sizeof(float));
-    vt = malloc1d(ldvt*n*sizeof(float));
+
+    assert(dim1<=h->maxDim1 && dim2<=h->maxDim2);
+    a = h->a;
+    s = h->s;
+    u = h->u;
     
-    /* store in column major order */
-    for(i=0; i<dim1; i++)
-        for(j=0; j<dim2; j++)
-            a[j*dim1+i] = A[i*dim2 +j];
+    /* The row-major 'A' is passed to LAPACK as is, i.e. as its column-major
+     * transpose: A^T = U' S V'^T, and therefore A = V' S U'^T. LAPACK returns
+     * V'^T in column-major order, which is U in row-major order, and so it is
+     * written directly into the output. Only the vectors that are asked for
+     * are computed. */
+    m = dim2; n = dim1; lda = dim2; ldu = dim2; ldvt = dim1;
+    jobu = V!=NULL ? "A" : "N";
+    jobvt = U!=NULL ? "A" : "N";
+    vt = U!=NULL ? U : h->vt;
+    memcpy(a, A, dim1*dim2*sizeof(float));
     
     /* perform the singular value decomposition */
 #ifdef VECLIB_USE_CLAPACK_INTERFACE
     /* no such implementation in altas-clapack */
     assert(0);
 #elif defined(VECLIB_USE_LAPACKE_INTERFACE)
-    superb = malloc((MIN(m,n)-1)*sizeof(float));
-    info = LAPACKE_sgesvd(CblasColMajor, 'A', 'A', m, n, a, lda, s, u, ldu, vt, ldvt, superb);
-    free(superb);
+    info = LAPACKE_sgesvd_work(CblasColMajor, jobu[0], jobvt[0], m, n, a, lda, s, u, ldu, vt, ldvt, h->work, h->lwork);
 #elif defined(VECLIB_USE_LAPACK_FORTRAN_INTERFACE)
-    lwork = -1;
-    sgesvd_( "A", "A", &m, &n, a, &lda, s, u, &ldu, vt, &ldvt, &wkopt, &lwork, &info );
-    lwork = (int)wkopt;
-    work = malloc1d( lwork*sizeof(float) );
-    sgesvd_( "A", "A", &m, &n, a, &lda, s, u, &ldu, vt, &ldvt, work, &lwork, &info );
-    free(work);
+    sgesvd_( jobu, jobvt, &m, &n, a, &lda, s, u, &ldu, vt, &ldvt, h->work, &(h->lwork), &info );
 #endif
     
     /* svd failed to converge */
@@ -680,31 +1440,101 @@ void utility_ssvd
                 S[i*dim2+i] = s[i];
         }
         
-        /*return as row-major*/
-        if (U != NULL)
-            for(i=0; i<dim1; i++)
-                for(j=0; j<dim1; j++)
-                    U[i*dim1+j] = u[j*dim1+i];
-        
-        /* lapack returns VT, i.e. row-major V already */
+        /* (U is already in place) V = U', returned as row-major */
         if (V != NULL)
             for(i=0; i<dim2; i++)
                 for(j=0; j<dim2; j++)
-                    V[i*dim2+j] = vt[i*dim2+j];
+                    V[i*dim2+j] = u[j*dim2+i];
         
         if (sing != NULL)
             for(i=0; i<MIN(dim1, dim2); i++)
                 sing[i] = s[i];
     }
-    
-    free(a);
-    free(s);
-    free(u);
-    free(vt);
 }
 
-void utility_csvd
+void utility_ssvd
+(
+    const float* A,
+    const int dim1,
+    const int dim2,
+    float* U,
+    float* S,
+    float* V,
+    float* sing
+)
+{
+    void* hWork;
+
+    utility_ssvd_create(&hWork, dim1, dim2);
+    utility_ssvd_ws(hWork, A, dim1, dim2, U, S, V, sing);
+    utility_ssvd_destroy(&hWork);
+}
+
+/** Data structure for utility_csvd_ws() */
+typedef struct _utility_csvd_data {
+    int maxDim1, maxDim2, lwork;
+    float_complex* a, *u, *vt, *work;
+    float* s, *rwork;
+}utility_csvd_data;
+
+void utility_csvd_create
+(
+    void ** const phWork,
+    int maxDim1,
+    int maxDim2
+)
+{
+    *phWork = malloc1d(sizeof(utility_csvd_data));
+    utility_csvd_data *h = (utility_csvd_data*)(*phWork);
+    int m, n, lda, ldu, ldvt, info;
+    float_complex wkopt;
+
+    /* (the row-major input is decomposed as its column-major transpose) */
+    h->maxDim1 = n = ldvt = maxDim1;
+    h->maxDim2 = m = lda = ldu = maxDim2;
+    h->a = malloc1d(m*n*sizeof(float_complex));
+    h->s = malloc1d(MIN(n,m)*sizeof(float));
+    h->u = malloc1d(m*m*sizeof(float_complex));
+    h->vt = malloc1d(n*n*sizeof(float_complex));
+    h->rwork = malloc1d(m*MAX(1, 5*MIN(n,m))*sizeof(float));
+
+    /* workspace query for the largest dimensions (which also suffices for
+     * smaller ones) */
+    wkopt = cmplxf(0.0f, 0.0f);
+    h->lwork = -1;
+#if defined(VECLIB_USE_LAPACK_FORTRAN_INTERFACE)
+    cgesvd_( "A", "A", (veclib_int*)&m, (veclib_int*)&n, (veclib_float_complex*)h->a, (veclib_int*)&lda, h->s, (veclib_float_complex*)h->u, (veclib_int*)&ldu,
+            (veclib_float_complex*)h->vt, &ldvt, (veclib_float_complex*)&wkopt, &(h->lwork), h->rwork, (veclib_int*)&info );
+#elif defined(VECLIB_USE_LAPACKE_INTERFACE)
+    info = LAPACKE_cgesvd_work(CblasColMajor, 'A', 'A', m, n, (veclib_float_complex*)h->a, lda, h->s, (veclib_float_complex*)h->u, ldu,
+                               (veclib_float_complex*)h->vt, ldvt, (veclib_float_complex*)&wkopt, h->lwork, h->rwork);
+#endif
+    h->lwork = MAX((int)(crealf(wkopt)+0.01f), 2*MIN(m,n)+MAX(m,n));
+    h->work = malloc1d(h->lwork*sizeof(float_complex));
+}
+
+void utility_csvd_destroy
+(
+    void ** const phWork
+)
+{
+    utility_csvd_data *h = (utility_csvd_data*)(*phWork);
+    if(h!=NULL){
+        free(h->a);
+        free(h->s);
+        free(h->u);
+        free(h->vt);
+        free(h->work);
+        free(h->rwork);
+        free(h);
+        h=NULL;
+        *phWork = NULL;
+    }
+}
+
+void utility_csvd_ws
 (
+    void* const hWork,
     const float_complex* A,
     const int dim1,
     const int dim2,
@@ -714,46 +1544,37 @@ void utility_csvd
     float* sing
 )
 {
+    utility_csvd_data *h = (utility_csvd_data*)(hWork);
     int i, j, m, n, lda, ldu, ldvt, info;
-    m = dim1; n = dim2; lda = dim1; ldu = dim1; ldvt = dim2;
-    float_complex* a, *u, *vt, *work;
+    const char* jobu, *jobvt;
+    float_complex* a, *u, *vt;
     float* s;
-#if defined(VECLIB_USE_LAPACK_FORTRAN_INTERFACE)
-    int lwork;
-    float_complex wkopt;
-    float* rwork;
-#elif defined(VECLIB_USE_LAPACKE_INTERFACE)
-    float* superb;
-#endif
-    
-    a = malloc1d(lda*n*sizeof(float_complex));
-    s = malloc1d(MIN(n,m)*sizeof(float));
-    u = malloc1d(ldu*m*sizeof(float_complex));
-    vt = malloc1d(ldvt*n*sizeof(float_complex));
+
+    assert(dim1<=h->maxDim1 && dim2<=h->maxDim2);
+    a = h->a;
+    s = h->s;
+    u = h->u;
     
-    /* store in column major order */
-    for(i=0; i<dim1; i++)
-        for(j=0; j<dim2; j++)
-            a[j*dim1+i] = A[i*dim2 +j];
+    /* The row-major 'A' is passed to LAPACK as is, i.e. as its column-major
+     * transpose: A^T = U' S V'^H, and therefore A = conj(V') S U'^T. LAPACK
+     * returns V'^H in column-major order, which is U in row-major order, and
+     * so it is written directly into the output. Only the vectors that are
+     * asked for are computed. */
+    m = dim2; n = dim1; lda = dim2; ldu = dim2; ldvt = dim1;
+    jobu = V!=NULL ? "A" : "N";
+    jobvt = U!=NULL ? "A" : "N";
+    vt = U!=NULL ? U : h->vt;
+    memcpy(a, A, dim1*dim2*sizeof(float_complex));
     
     /* perform the singular value decomposition */
 #if defined(VECLIB_USE_LAPACK_FORTRAN_INTERFACE)
-    rwork = malloc1d(m*MAX(1, 5*MIN(n,m))*sizeof(float));
-    lwork = -1;
-    cgesvd_( "A", "A", (veclib_int*)&m, (veclib_int*)&n, (veclib_float_complex*)a, (veclib_int*)&lda, s, (veclib_float_complex*)u, (veclib_int*)&ldu,
-            (veclib_float_complex*)vt, &ldvt, (veclib_float_complex*)&wkopt, &lwork, rwork, (veclib_int*)&info );
-    lwork = (int)(crealf(wkopt)+0.01f);
-    work = malloc1d( lwork*sizeof(float_complex) );
-    cgesvd_( "A", "A", &m, &n, (veclib_float_complex*)a, &lda, s, (veclib_float_complex*)u, &ldu, (veclib_float_complex*)vt, &ldvt,
-            (veclib_float_complex*)work, &lwork, rwork, &info);
-    free(work);
-    free(rwork);
+    cgesvd_( jobu, jobvt, &m, &n, (veclib_float_complex*)a, &lda, s, (veclib_float_complex*)u, &ldu, (veclib_float_complex*)vt, &ldvt,
+            (veclib_float_complex*)h->work, &(h->lwork), h->rwork, &info);
 #elif defined(VECLIB_USE_CLAPACK_INTERFACE)
     assert(0); /* no such implementation in clapack */
 #elif defined(VECLIB_USE_LAPACKE_INTERFACE)
-    superb = malloc((MIN(m,n)-1)*sizeof(float));
-    info = LAPACKE_cgesvd(CblasColMajor, 'A', 'A', m, n, (veclib_float_complex*)a, lda, s, (veclib_float_complex*)u, ldu, vt, ldvt, superb);
-    free(superb);
+    info = LAPACKE_cgesvd_work(CblasColMajor, jobu[0], jobvt[0], m, n, (veclib_float_complex*)a, lda, s, (veclib_float_complex*)u, ldu,
+                               (veclib_float_complex*)vt, ldvt, (veclib_float_complex*)h->work, h->lwork, h->rwork);
 #endif
 
     /* svd failed to converge */
@@ -765,7 +1586,7 @@ void utility_csvd
         if (V != NULL)
             memset(V, 0, dim2*dim2*sizeof(float_complex));
         if (sing != NULL)
-            memset(sing, 0, MIN(dim1, dim2)*sizeof(float_complex));
+            memset(sing, 0, MIN(dim1, dim2)*sizeof(float));
 #ifndef NDEBUG
         saf_error_print(SAF_WARNING__FAILED_TO_COMPUTE_SVD);
 #endif
@@ -778,27 +1599,34 @@ void utility_csvd
             for(i=0; i<MIN(dim1, dim2); i++)
                 S[i*dim2+i] = cmplxf(s[i], 0.0f);
         }
-        /*return as row-major*/
-        if (U != NULL)
-            for(i=0; i<dim1; i++)
-                for(j=0; j<dim1; j++)
-                    U[i*dim1+j] = u[j*dim1+i];
-        
-        /* lapack returns VT, i.e. row-major V already */
+        /* (U is already in place) V = conj(U'), returned as row-major */
         if (V != NULL)
             for(i=0; i<dim2; i++)
                 for(j=0; j<dim2; j++)
-                    V[i*dim2+j] = conjf(vt[i*dim2+j]); /* v^H */
+                    V[i*dim2+j] = conjf(u[j*dim2+i]);
         
         if (sing != NULL)
             for(i=0; i<MIN(dim1, dim2); i++)
                 sing[i] = s[i];
     }
-    
-    free(a);
-    free(s);
-    free(u);
-    free(vt);
+}
+
+void utility_csvd
+(
+    const float_complex* A,
+    const int dim1,
+    const int dim2,
+    float_complex* U,
+    float_complex* S,
+    float_complex* V,
+    float* sing
+)
+{
+    void* hWork;
+
+    utility_csvd_create(&hWork, dim1, dim2);
+    utility_csvd_ws(hWork, A, dim1, dim2, U, S, V, sing);
+    utility_csvd_destroy(&hWork);
 }
 
 
@@ -806,8 +1634,58 @@ void utility_csvd
 /*                 Symmetric Eigenvalue Decomposition (?seig)                 */
 /* ========================================================================== */
 
-void utility_sseig
+/** Data structure for utility_sseig_ws() */
+typedef struct _utility_sseig_data {
+    int maxDim, lwork;
+    float* a, *w, *work;
+}utility_sseig_data;
+
+void utility_sseig_create
+(
+    void ** const phWork,
+    int maxDim
+)
+{
+    *phWork = malloc1d(sizeof(utility_sseig_data));
+    utility_sseig_data *h = (utility_sseig_data*)(*phWork);
+    int n, lda, info;
+    float wkopt;
+
+    h->maxDim = n = lda = maxDim;
+    h->w = malloc1d(n*sizeof(float));
+    h->a = malloc1d(n*n*sizeof(float));
+
+    /* workspace query for the largest dimensions */
+    wkopt = 0.0f;
+    h->lwork = -1;
+#if defined(VECLIB_USE_LAPACK_FORTRAN_INTERFACE)
+    ssyev_( "Vectors", "Upper", &n, h->a, &lda, h->w, &wkopt, &(h->lwork), &info );
+#elif defined(VECLIB_USE_LAPACKE_INTERFACE)
+    info = LAPACKE_ssyev_work(CblasColMajor, 'V', 'U', n, h->a, lda, h->w, &wkopt, h->lwork);
+#endif
+    h->lwork = MAX((int)wkopt, MAX(1, 3*n-1));
+    h->work = malloc1d(h->lwork*sizeof(float));
+}
+
+void utility_sseig_destroy
+(
+    void ** const phWork
+)
+{
+    utility_sseig_data *h = (utility_sseig_data*)(*phWork);
+    if(h!=NULL){
+        free(h->a);
+        free(h->w);
+        free(h->work);
+        free(h);
+        h=NULL;
+        *phWork = NULL;
+    }
+}
+
+void utility_sseig_ws
 (
+    void* const hWork,
     const float* A,
     const int dim,
     int sortDecFLAG,
@@ -816,32 +1694,27 @@ void utility_sseig
     float* eig
 )
 {
-    int i, j, n, lda, info, lwork;
-    float wkopt;
-    float* work, *w, *a;
+    utility_sseig_data *h = (utility_sseig_data*)(hWork);
+    int i, j, n, lda, info;
+    float* w, *a;
 
+    assert(dim<=h->maxDim);
     n = dim;
     lda = dim;
-    w = malloc1d(dim*sizeof(float));
-    a = malloc1d(dim*dim*sizeof(float));
+    w = h->w;
+    a = h->a;
     
-    /* store in column major order (i.e. transpose) */
-    for(i=0; i<dim; i++)
-        for(j=0; j<dim; j++)
-            a[i*dim+j] = A[j*dim+i];
+    /* 'A' is symmetric, so no transpose is required; the lower triangle (in
+     * column-major terms) is the upper triangle of the row-major 'A' */
+    memcpy(a, A, dim*dim*sizeof(float));
     
     /* solve the eigenproblem */
 #if defined(VECLIB_USE_LAPACK_FORTRAN_INTERFACE)
-    lwork = -1;
-    ssyev_( "Vectors", "Upper", &n, a, &lda, w, &wkopt, &lwork, &info );
-    lwork = (int)wkopt;
-    work = (float*)malloc1d( lwork*sizeof(float) );
-    ssyev_( "Vectors", "Upper", &n, a, &lda, w, work, &lwork, &info );
-    free(work);
+    ssyev_( "Vectors", "Lower", &n, a, &lda, w, h->work, &(h->lwork), &info );
 #elif defined(VECLIB_USE_CLAPACK_INTERFACE)
     assert(0); /* no such implementation in clapack */
 #elif defined(VECLIB_USE_LAPACKE_INTERFACE)
-    info = LAPACKE_ssyev(CblasColMajor, 'V', 'U', n, a, lda, w );
+    info = LAPACKE_ssyev_work(CblasColMajor, 'V', 'L', n, a, lda, w, h->work, h->lwork);
 #endif
     
     /* output */
@@ -879,13 +1752,80 @@ void utility_sseig
             }
         }
     }
-    
-    free(w);
-    free(a);
 }
 
-void utility_cseig
+void utility_sseig
+(
+    const float* A,
+    const int dim,
+    int sortDecFLAG,
+    float* V,
+    float* D,
+    float* eig
+)
+{
+    void* hWork;
+
+    utility_sseig_create(&hWork, dim);
+    utility_sseig_ws(hWork, A, dim, sortDecFLAG, V, D, eig);
+    utility_sseig_destroy(&hWork);
+}
+
+/** Data structure for utility_cseig_ws() */
+typedef struct _utility_cseig_data {
+    int maxDim, lwork;
+    float_complex* a, *work;
+    float* w, *rwork;
+}utility_cseig_data;
+
+void utility_cseig_create
+(
+    void ** const phWork,
+    int maxDim
+)
+{
+    *phWork = malloc1d(sizeof(utility_cseig_data));
+    utility_cseig_data *h = (utility_cseig_data*)(*phWork);
+    int n, lda, info;
+    float_complex wkopt;
+
+    h->maxDim = n = lda = maxDim;
+    h->w = malloc1d(n*sizeof(float));
+    h->a = malloc1d(n*n*sizeof(float_complex));
+    h->rwork = malloc1d(MAX(1, 3*n-2)*sizeof(float));
+
+    /* workspace query for the largest dimensions */
+    wkopt = cmplxf(0.0f, 0.0f);
+    h->lwork = -1;
+#if defined(VECLIB_USE_LAPACK_FORTRAN_INTERFACE)
+    cheev_( "Vectors", "Upper", &n, (veclib_float_complex*)h->a, &lda, h->w, (veclib_float_complex*)&wkopt, &(h->lwork), h->rwork, &info );
+#elif defined(VECLIB_USE_LAPACKE_INTERFACE)
+    info = LAPACKE_cheev_work(CblasColMajor, 'V', 'U', n, (veclib_float_complex*)h->a, lda, h->w, (veclib_float_complex*)&wkopt, h->lwork, h->rwork);
+#endif
+    h->lwork = MAX((int)crealf(wkopt), MAX(1, 2*n-1));
+    h->work = malloc1d(h->lwork*sizeof(float_complex));
+}
+
+void utility_cseig_destroy
 (
+    void ** const phWork
+)
+{
+    utility_cseig_data *h = (utility_cseig_data*)(*phWork);
+    if(h!=NULL){
+        free(h->a);
+        free(h->w);
+        free(h->work);
+        free(h->rwork);
+        free(h);
+        h=NULL;
+        *phWork = NULL;
+    }
+}
+
+void utility_cseig_ws
+(
+    void* const hWork,
     const float_complex* A,
     const int dim,
     int sortDecFLAG,
@@ -894,40 +1834,31 @@ void utility_cseig
     float* eig
 )
 {
+    utility_cseig_data *h = (utility_cseig_data*)(hWork);
     int i, j, n, lda, info;
-    float_complex wkopt;
     float *w;
     float_complex* a;
-#if defined(VECLIB_USE_LAPACK_FORTRAN_INTERFACE)
-    int lwork;
-    float *rwork;
-    float_complex *work;
-#endif
 
+    assert(dim<=h->maxDim);
     n = dim;
     lda = dim;
-    w = malloc1d(dim*sizeof(float));
-    a = malloc1d(dim*dim*sizeof(float_complex));
+    w = h->w;
+    a = h->a;
     
-    /* store in column major order (i.e. transpose) */
-    for(i=0; i<dim; i++)
-        for(j=0; j<dim; j++)
-            a[i*dim+j] = A[j*dim+i];
+    /* 'A' is Hermitian, so its row-major storage is conj(A) in column-major
+     * order. This shares the eigenvalues of 'A', while its eigenvectors are
+     * conj(V); therefore, no transpose is required here, and the conjugate is
+     * instead taken when writing the output. (The lower triangle, in
+     * column-major terms, is the upper triangle of the row-major 'A') */
+    memcpy(a, A, dim*dim*sizeof(float_complex));
     
     /* solve the eigenproblem */
 #if defined(VECLIB_USE_LAPACK_FORTRAN_INTERFACE)
-    rwork = malloc1d((3*n-2)*sizeof(float));
-    lwork = -1;
-    cheev_( "Vectors", "Upper", &n, (veclib_float_complex*)a, &lda, w, (veclib_float_complex*)&wkopt, &lwork, rwork, &info );
-    lwork = (int)crealf(wkopt);
-    work = (float_complex*)malloc1d( lwork*sizeof(float_complex) );
-    cheev_( "Vectors", "Upper", &n, (veclib_float_complex*)a, &lda, w, (veclib_float_complex*)work, &lwork, rwork, &info );
-    free(work);
-    free(rwork);
+    cheev_( "Vectors", "Lower", &n, (veclib_float_complex*)a, &lda, w, (veclib_float_complex*)h->work, &(h->lwork), h->rwork, &info );
 #elif defined(VECLIB_USE_CLAPACK_INTERFACE)
     assert(0); /* no such implementation in clapack */
 #elif defined(VECLIB_USE_LAPACKE_INTERFACE)
-    info = LAPACKE_cheev(CblasColMajor, 'V', 'U', n, (veclib_float_complex*)a, lda, w);
+    info = LAPACKE_cheev_work(CblasColMajor, 'V', 'L', n, (veclib_float_complex*)a, lda, w, (veclib_float_complex*)h->work, h->lwork, h->rwork);
 #endif
     
     /* output */
@@ -942,13 +1873,13 @@ void utility_cseig
 #endif
     }
     
-    /* transpose, back to row-major and reverse order */
+    /* conjugate transpose, back to row-major and reverse order */
     else{
         if(sortDecFLAG){
             for(i=0; i<dim; i++) {
                 if(V!=NULL)
                     for(j=0; j<dim; j++)
-                        V[i*dim+j] = a[(dim-j-1)*dim+i];
+                        V[i*dim+j] = conjf(a[(dim-j-1)*dim+i]);
                 if(D!=NULL)
                     D[i*dim+i] = cmplxf(w[dim-i-1], 0.0f); /* store along the diagonal, reversing the order */
                 if(eig!=NULL)
@@ -959,7 +1890,7 @@ void utility_cseig
             for(i=0; i<dim; i++){
                 if(V!=NULL)
                     for(j=0; j<dim; j++)
-                        V[i*dim+j] = a[j*dim+i];
+                        V[i*dim+j] = conjf(a[j*dim+i]);
                 if(D!=NULL)
                     D[i*dim+i] = cmplxf(w[i], 0.0f); /* store along the diagonal */
                 if(eig!=NULL)
@@ -967,70 +1898,195 @@ void utility_cseig
             }
         }
     }
-    
-    free(w);
-    free(a);
 }
 
+void utility_cseig
+(
+    const float_complex* A,
+    const int dim,
+    int sortDecFLAG,
+    float_complex* V,
+    float_complex* D,
+    float* eig
+)
+{
+    void* hWork;
 
-/* ========================================================================== */
-/*                     Eigenvalues of Matrix Pair (?eigmp)                    */
-/* ========================================================================== */
+    utility_cseig_create(&hWork, dim);
+    utility_cseig_ws(hWork, A, dim, sortDecFLAG, V, D, eig);
+    utility_cseig_destroy(&hWork);
+}
 
-void utility_ceigmp
+void utility_sseig_cm_ws
 (
-    const float_complex* A,
-    const float_complex* B,
+    void* const hWork,
+    const float* A,
     const int dim,
-    float_complex* VL,
-    float_complex* VR,
-    float_complex* D
+    int sortDecFLAG,
+    float* V,
+    float* eig
 )
 {
-    int i, j;
-    int n, lda, ldb, ldvl, ldvr, info;
-    float_complex* a, *b, *vl, *vr, *alpha, *beta;
-#if defined(VECLIB_USE_LAPACK_FORTRAN_INTERFACE)
-    int lwork;
-    float* rwork;
-    float_complex* work;
-#endif
-    
-    n = lda = ldb = ldvl = ldvr = dim;
-    a = malloc1d(dim*dim*sizeof(float_complex));
-    b = malloc1d(dim*dim*sizeof(float_complex));
-    vl = malloc1d(dim*dim*sizeof(float_complex));
-    vr = malloc1d(dim*dim*sizeof(float_complex));
-    alpha = malloc1d(dim*sizeof(float_complex));
-    beta = malloc1d(dim*sizeof(float_complex));
-    
-    /* store in column major order */
-    for(i=0; i<dim; i++)
-        for(j=0; j<dim; j++)
-            a[j*dim+i] = A[i*dim+j];
-    for(i=0; i<dim; i++)
-        for(j=0; j<dim; j++)
-            b[j*dim+i] = B[i*dim+j];
-    
-    /* solve eigen problem */
+    utility_sseig_data *h = (utility_sseig_data*)(hWork);
+    int i, n, lda, info;
+    const char* jobz;
+    float* w, *a;
+
+    assert(dim<=h->maxDim);
+    n = dim;
+    lda = dim;
+    w = h->w;
+    jobz = V!=NULL ? "V" : "N";
+
+    /* the eigenvectors (if needed) are computed directly in the output */
+    a = V!=NULL ? V : h->a;
+    if(a!=A)
+        memcpy(a, A, dim*dim*sizeof(float));
 #if defined(VECLIB_USE_LAPACK_FORTRAN_INTERFACE)
-    lwork = 4*n; /* 2x more than required, but is faster */
-    work = malloc1d(lwork*sizeof(float_complex));
-    rwork = malloc1d(4*lwork*sizeof(float)); /* 2x more than required, but is faster */
-    cggev_("V", "V", &n, (veclib_float_complex*)a, &lda, (veclib_float_complex*)b, &ldb, (veclib_float_complex*)alpha, (veclib_float_complex*)beta,
-           (veclib_float_complex*)vl, &ldvl, (veclib_float_complex*)vr, &ldvr, (veclib_float_complex*)work, &lwork, rwork, &info);
-    free(work);
-    free(rwork);
+    ssyev_( jobz, "Upper", &n, a, &lda, w, h->work, &(h->lwork), &info );
 #elif defined(VECLIB_USE_CLAPACK_INTERFACE)
     assert(0); /* no such implementation in clapack */
 #elif defined(VECLIB_USE_LAPACKE_INTERFACE)
-    info = LAPACKE_cggev(CblasColMajor, 'V', 'V', n, (veclib_float_complex*)a, lda, (veclib_float_complex*)b, ldb, (veclib_float_complex*)alpha,
-                         (veclib_float_complex*)beta, (veclib_float_complex*)vl, ldvl, (veclib_float_complex*)vr, ldvr);
+    info = LAPACKE_ssyev_work(CblasColMajor, jobz[0], 'U', n, a, lda, w, h->work, h->lwork);
+#endif
+
+    if( info != 0 ) {
+        /* failed to converge and find the eigenvalues */
+        if(V!=NULL)
+            memset(V, 0, dim*dim*sizeof(float));
+        if(eig!=NULL)
+            memset(eig, 0, dim*sizeof(float));
+#ifndef NDEBUG
+        saf_error_print(SAF_WARNING__FAILED_TO_COMPUTE_EVG);
+#endif
+        return;
+    }
+
+    /* eigenvectors are contiguous columns, so reversing their order only
+     * involves swapping whole columns */
+    if(sortDecFLAG && V!=NULL)
+        for(i=0; i<dim/2; i++)
+            cblas_sswap(dim, &V[i*dim], 1, &V[(dim-i-1)*dim], 1);
+    if(eig!=NULL)
+        for(i=0; i<dim; i++)
+            eig[i] = sortDecFLAG ? w[dim-i-1] : w[i];
+}
+
+void utility_cseig_cm_ws
+(
+    void* const hWork,
+    const float_complex* A,
+    const int dim,
+    int sortDecFLAG,
+    float_complex* V,
+    float* eig
+)
+{
+    utility_cseig_data *h = (utility_cseig_data*)(hWork);
+    int i, n, lda, info;
+    const char* jobz;
+    float *w;
+    float_complex* a;
+
+    assert(dim<=h->maxDim);
+    n = dim;
+    lda = dim;
+    w = h->w;
+    jobz = V!=NULL ? "V" : "N";
+
+    /* the eigenvectors (if needed) are computed directly in the output */
+    a = V!=NULL ? V : h->a;
+    if(a!=A)
+        memcpy(a, A, dim*dim*sizeof(float_complex));
+#if defined(VECLIB_USE_LAPACK_FORTRAN_INTERFACE)
+    cheev_( jobz, "Upper", &n, (veclib_float_complex*)a, &lda, w, (veclib_float_complex*)h->work, &(h->lwork), h->rwork, &info );
+#elif defined(VECLIB_USE_CLAPACK_INTERFACE)
+    assert(0); /* no such implementation in clapack */
+#elif defined(VECLIB_USE_LAPACKE_INTERFACE)
+    info = LAPACKE_cheev_work(CblasColMajor, jobz[0], 'U', n, (veclib_float_complex*)a, lda, w, (veclib_float_complex*)h->work, h->lwork, h->rwork);
+#endif
+
+    if( info != 0 ) {
+        /* failed to converge and find the eigenvalues */
+        if(V!=NULL)
+            memset(V, 0, dim*dim*sizeof(float_complex));
+        if(eig!=NULL)
+            memset(eig, 0, dim*sizeof(float));
+#ifndef NDEBUG
+        saf_error_print(SAF_WARNING__FAILED_TO_COMPUTE_EVG);
+#endif
+        return;
+    }
+
+    /* eigenvectors are contiguous columns, so reversing their order only
+     * involves swapping whole columns */
+    if(sortDecFLAG && V!=NULL)
+        for(i=0; i<dim/2; i++)
+            cblas_cswap(dim, &V[i*dim], 1, &V[(dim-i-1)*dim], 1);
+    if(eig!=NULL)
+        for(i=0; i<dim; i++)
+            eig[i] = sortDecFLAG ? w[dim-i-1] : w[i];
+}
+
+
+/* ========================================================================== */
+/*                     Eigenvalues of Matrix Pair (?eigmp)                    */
+/* ========================================================================== */
+
+void utility_ceigmp
+(
+    const float_complex* A,
+    const float_complex* B,
+    const int dim,
+    float_complex* VL,
+    float_complex* VR,
+    float_complex* D
+)
+{
+    int i, j;
+    int n, lda, ldb, ldvl, ldvr, info;
+    float_complex* a, *b, *vl, *vr, *alpha, *beta;
+#if defined(VECLIB_USE_LAPACK_FORTRAN_INTERFACE)
+    int lwork;
+    float* rwork;
+    float_complex* work;
+#endif
+    
+    n = lda = ldb = ldvl = ldvr = dim;
+    a = malloc1d(dim*dim*sizeof(float_complex));
+    b = malloc1d(dim*dim*sizeof(float_complex));
+    vl = malloc1d(dim*dim*sizeof(float_complex));
+    vr = malloc1d(dim*dim*sizeof(float_complex));
+    alpha = malloc1d(dim*sizeof(float_complex));
+    beta = malloc1d(dim*sizeof(float_complex));
+    
+    /* store in column major order */
+    for(i=0; i<dim; i++)
+        for(j=0; j<dim; j++)
+            a[j*dim+i] = A[i*dim+j];
+    for(i=0; i<dim; i++)
+        for(j=0; j<dim; j++)
+            b[j*dim+i] = B[i*dim+j];
+    
+    /* solve eigen problem */
+#if defined(VECLIB_USE_LAPACK_FORTRAN_INTERFACE)
+    lwork = 4*n; /* 2x more than required, but is faster */
+    work = malloc1d(lwork*sizeof(float_complex));
+    rwork = malloc1d(4*lwork*sizeof(float)); /* 2x more than required, but is faster */
+    cggev_("V", "V", &n, (veclib_float_complex*)a, &lda, (veclib_float_complex*)b, &ldb, (veclib_float_complex*)alpha, (veclib_float_complex*)beta,
+           (veclib_float_complex*)vl, &ldvl, (veclib_float_complex*)vr, &ldvr, (veclib_float_complex*)work, &lwork, rwork, &info);
+    free(work);
+    free(rwork);
+#elif defined(VECLIB_USE_CLAPACK_INTERFACE)
+    assert(0); /* no such implementation in clapack */
+#elif defined(VECLIB_USE_LAPACKE_INTERFACE)
+    info = LAPACKE_cggev(CblasColMajor, 'V', 'V', n, (veclib_float_complex*)a, lda, (veclib_float_complex*)b, ldb, (veclib_float_complex*)alpha,
+                         (veclib_float_complex*)beta, (veclib_float_complex*)vl, ldvl, (veclib_float_complex*)vr, ldvr);
 #endif
     
-    if(D!=NULL)
-        memset(D, 0, dim*dim*sizeof(float_complex));
-    
+    if(D!=NULL)
+        memset(D, 0, dim*dim*sizeof(float_complex));
+    
     /* failed to converge and find the eigenvalues */
     if( info != 0 ) {
         if(VL!=NULL)
@@ -1554,8 +2610,44 @@ void utility_zglslv
 /*                      Symmetric Linear Solver (?slslv)                      */
 /* ========================================================================== */
 
-void utility_sslslv
+/** Data structure for utility_sslslv_ws() */
+typedef struct _utility_sslslv_data {
+    int maxDim, maxNCol;
+    float* a;
+}utility_sslslv_data;
+
+void utility_sslslv_create
+(
+    void ** const phWork,
+    int maxDim,
+    int maxNCol
+)
+{
+    *phWork = malloc1d(sizeof(utility_sslslv_data));
+    utility_sslslv_data *h = (utility_sslslv_data*)(*phWork);
+
+    h->maxDim = maxDim;
+    h->maxNCol = maxNCol;
+    h->a = malloc1d(maxDim*maxDim*sizeof(float));
+}
+
+void utility_sslslv_destroy
+(
+    void ** const phWork
+)
+{
+    utility_sslslv_data *h = (utility_sslslv_data*)(*phWork);
+    if(h!=NULL){
+        free(h->a);
+        free(h);
+        h=NULL;
+        *phWork = NULL;
+    }
+}
+
+void utility_sslslv_ws
 (
+    void* const hWork,
     const float* A,
     const int dim,
     float* B,
@@ -1563,27 +2655,23 @@ void utility_sslslv
     float* X
 )
 {
-    int i, j, n = dim, nrhs = nCol, lda = dim, ldb = dim, info;
-    float* a, *b;
- 
-    a = malloc1d(dim*dim*sizeof(float));
-    b = malloc1d(dim*nrhs*sizeof(float));
-    
-    /* store in column major order */
-    for(i=0; i<dim; i++)
-        for(j=0; j<dim; j++)
-            a[j*dim+i] = A[i*dim+j];
-    for(i=0; i<dim; i++)
-        for(j=0; j<nCol; j++)
-            b[j*dim+i] = B[i*nCol+j];
+    utility_sslslv_data *h = (utility_sslslv_data*)(hWork);
+    int n = dim, lda = dim, info;
+    float* a;
+
+    assert(dim<=h->maxDim && nCol<=h->maxNCol);
+    a = h->a;
     
-    /* solve Ax = b for each column in b (b is replaced by the solution: x) */
+    /* 'A' is symmetric, so no transpose is required: its lower triangle (in
+     * column-major terms) is factorised as L*L^T, where L^T is then the upper
+     * triangular factor U of the row-major 'A' = U^T*U */
+    memcpy(a, A, dim*dim*sizeof(float));
 #ifdef VECLIB_USE_CLAPACK_INTERFACE
-    info = clapack_sposv(CblasColMajor, CblasUpper, n, nrhs, a, lda, b, ldb);
+    info = clapack_spotrf(CblasColMajor, CblasLower, n, a, lda);
 #elif defined(VECLIB_USE_LAPACKE_INTERFACE)
-    info = LAPACKE_sposv(CblasColMajor, CblasUpper, n, nrhs, a, lda, b, ldb);
+    info = LAPACKE_spotrf_work(CblasColMajor, 'L', n, a, lda);
 #elif defined(VECLIB_USE_LAPACK_FORTRAN_INTERFACE)
-    sposv_( "U", &n, &nrhs, a, &lda, b, &ldb, &info );
+    spotrf_( "L", &n, a, &lda, &info );
 #endif
     
     /* A is not symmetric positive definate, solution not possible */
@@ -1593,19 +2681,69 @@ void utility_sslslv
         saf_error_print(SAF_WARNING__FAILED_TO_SOLVE_LINEAR_EQUATION);
 #endif
     }
-    /* store solution in row-major order */
+    /* solve U^T*U*X = B, in row-major order (X is replaced by the solution) */
     else{
-        for(i=0; i<dim; i++)
-            for(j=0; j<nCol; j++)
-                X[i*nCol+j] = b[j*dim+i];
+        if(X!=B)
+            memcpy(X, B, dim*nCol*sizeof(float));
+        cblas_strsm(CblasRowMajor, CblasLeft, CblasUpper, CblasTrans, CblasNonUnit, dim, nCol, 1.0f, a, lda, X, nCol);
+        cblas_strsm(CblasRowMajor, CblasLeft, CblasUpper, CblasNoTrans, CblasNonUnit, dim, nCol, 1.0f, a, lda, X, nCol);
     }
-    
-    free(a);
-    free(b);
 }
 
-void utility_cslslv
+void utility_sslslv
+(
+    const float* A,
+    const int dim,
+    float* B,
+    int nCol,
+    float* X
+)
+{
+    void* hWork;
+
+    utility_sslslv_create(&hWork, dim, nCol);
+    utility_sslslv_ws(hWork, A, dim, B, nCol, X);
+    utility_sslslv_destroy(&hWork);
+}
+
+/** Data structure for utility_cslslv_ws() */
+typedef struct _utility_cslslv_data {
+    int maxDim, maxNCol;
+    float_complex* a;
+}utility_cslslv_data;
+
+void utility_cslslv_create
 (
+    void ** const phWork,
+    int maxDim,
+    int maxNCol
+)
+{
+    *phWork = malloc1d(sizeof(utility_cslslv_data));
+    utility_cslslv_data *h = (utility_cslslv_data*)(*phWork);
+
+    h->maxDim = maxDim;
+    h->maxNCol = maxNCol;
+    h->a = malloc1d(maxDim*maxDim*sizeof(float_complex));
+}
+
+void utility_cslslv_destroy
+(
+    void ** const phWork
+)
+{
+    utility_cslslv_data *h = (utility_cslslv_data*)(*phWork);
+    if(h!=NULL){
+        free(h->a);
+        free(h);
+        h=NULL;
+        *phWork = NULL;
+    }
+}
+
+void utility_cslslv_ws
+(
+    void* const hWork,
     const float_complex* A,
     const int dim,
     float_complex* B,
@@ -1613,27 +2751,25 @@ void utility_cslslv
     float_complex* X
 )
 {
-    int i, j, n = dim, nrhs = nCol, lda = dim, ldb = dim, info;
-    float_complex* a, *b;
- 
-    a = malloc1d(dim*dim*sizeof(float_complex));
-    b = malloc1d(dim*nrhs*sizeof(float_complex));
-    
-    /* store in column major order */
-    for(i=0; i<dim; i++)
-        for(j=0; j<dim; j++)
-            a[j*dim+i] = A[i*dim+j];
-    for(i=0; i<dim; i++)
-        for(j=0; j<nCol; j++)
-            b[j*dim+i] = B[i*nCol+j];
+    utility_cslslv_data *h = (utility_cslslv_data*)(hWork);
+    int n = dim, lda = dim, info;
+    const float_complex calpha = cmplxf(1.0f, 0.0f);
+    float_complex* a;
+
+    assert(dim<=h->maxDim && nCol<=h->maxNCol);
+    a = h->a;
     
-    /* solve Ax = b for each column in b (b is replaced by the solution: x) */
+    /* 'A' is Hermitian, so its row-major storage is conj(A) in column-major
+     * order. Its lower triangle (in column-major terms) is factorised as
+     * conj(A) = L*L^H, where L^T is then the upper triangular factor U of the
+     * row-major 'A' = U^H*U; i.e. no transpose is required */
+    memcpy(a, A, dim*dim*sizeof(float_complex));
 #if defined(VECLIB_USE_LAPACK_FORTRAN_INTERFACE)
-    cposv_( "U", &n, &nrhs, (veclib_float_complex*)a, &lda, (veclib_float_complex*)b, &ldb, &info );
+    cpotrf_( "L", &n, (veclib_float_complex*)a, &lda, &info );
 #elif defined(VECLIB_USE_CLAPACK_INTERFACE)
-    info = clapack_cposv(CblasColMajor, CblasUpper, n, nrhs, (veclib_float_complex*)a, lda, (veclib_float_complex*)b, ldb);
+    info = clapack_cpotrf(CblasColMajor, CblasLower, n, (veclib_float_complex*)a, lda);
 #elif defined(VECLIB_USE_LAPACKE_INTERFACE)
-    info = LAPACKE_cposv(CblasColMajor, CblasUpper, n, nrhs, (veclib_float_complex*)a, lda, (veclib_float_complex*)b, ldb);
+    info = LAPACKE_cpotrf_work(CblasColMajor, 'L', n, (veclib_float_complex*)a, lda);
 #endif
     
     /* A is not symmetric positive definate, solution not possible */
@@ -1643,76 +2779,210 @@ void utility_cslslv
         saf_error_print(SAF_WARNING__FAILED_TO_SOLVE_LINEAR_EQUATION);
 #endif
     }
-    /* store solution in row-major order */
+    /* solve U^H*U*X = B, in row-major order (X is replaced by the solution) */
     else{
-        for(i=0; i<dim; i++)
-            for(j=0; j<nCol; j++)
-                X[i*nCol+j] = b[j*dim+i];
+        if(X!=B)
+            memcpy(X, B, dim*nCol*sizeof(float_complex));
+        cblas_ctrsm(CblasRowMajor, CblasLeft, CblasUpper, CblasConjTrans, CblasNonUnit, dim, nCol, &calpha, a, lda, X, nCol);
+        cblas_ctrsm(CblasRowMajor, CblasLeft, CblasUpper, CblasNoTrans, CblasNonUnit, dim, nCol, &calpha, a, lda, X, nCol);
     }
-    
-    free(a);
-    free(b);
 }
 
+void utility_cslslv
+(
+    const float_complex* A,
+    const int dim,
+    float_complex* B,
+    int nCol,
+    float_complex* X
+)
+{
+    void* hWork;
 
-/* ========================================================================== */
-/*                        Matrix Pseudo-Inverse (?pinv)                       */
-/* ========================================================================== */
+    utility_cslslv_create(&hWork, dim, nCol);
+    utility_cslslv_ws(hWork, A, dim, B, nCol, X);
+    utility_cslslv_destroy(&hWork);
+}
 
-void utility_spinv
+void utility_sslslv_cm_ws
 (
-    const float* inM,
-    const int dim1,
-    const int dim2,
-    float* outM
+    void* const hWork,
+    const float* A,
+    const int dim,
+    float* B,
+    int nCol,
+    float* X
 )
 {
-    
-    int i, j, m, n, k, lda, ldu, ldvt, info;
-    float* a, *s, *u, *vt, *inva;
-    float ss;
-#if defined(VECLIB_USE_LAPACK_FORTRAN_INTERFACE)
-    int lwork;
-    float wkopt;
-    float* work;
-#elif defined(VECLIB_USE_LAPACKE_INTERFACE)
-    float* superb;
-#endif
-    
-    m = lda = ldu = dim1;
-    n = dim2;
-    k = ldvt = m < n ? m : n;
-    a = malloc1d(m*n*sizeof(float) );
-    s = (float*)malloc1d(k*sizeof(float));
-    u = (float*)malloc1d(ldu*k*sizeof(float));
-    vt = (float*)malloc1d(ldvt*n*sizeof(float));
-    
-    /* store in column major order */
-    for(i=0; i<m; i++)
-        for(j=0; j<n; j++)
-            a[j*m+i] = inM[i*n+j];
-    
-    /* singular value decomposition */
-#if defined(VECLIB_USE_LAPACK_FORTRAN_INTERFACE)
-    lwork = -1;
-    sgesvd_("S", "S", &m, &n, a, &lda, s, u, &ldu, vt, &ldvt, &wkopt, &lwork, &info);
-    lwork = (int)wkopt;
-    work = (float*)malloc1d(lwork*sizeof(float));
-    sgesvd_("S", "S", &m, &n, a, &lda, s, u, &ldu, vt, &ldvt, work, &lwork, &info );
-    free(work);
-#elif defined(VECLIB_USE_CLAPACK_INTERFACE)
-    assert(0); /* no such implementation in clapack */
+    utility_sslslv_data *h = (utility_sslslv_data*)(hWork);
+    int n = dim, nrhs = nCol, lda = dim, ldb = dim, info;
+
+    assert(dim<=h->maxDim && nCol<=h->maxNCol);
+    memcpy(h->a, A, dim*dim*sizeof(float));
+    if(X!=B)
+        memcpy(X, B, dim*nCol*sizeof(float));
+
+    /* solve AX = B for each column in X (X is replaced by the solution) */
+#ifdef VECLIB_USE_CLAPACK_INTERFACE
+    info = clapack_sposv(CblasColMajor, CblasUpper, n, nrhs, h->a, lda, X, ldb);
 #elif defined(VECLIB_USE_LAPACKE_INTERFACE)
-    superb = malloc((MIN(m,n)-1)*sizeof(float));
-    info = LAPACKE_sgesvd(CblasColMajor, 'S', 'S', m, n, a, lda, s, u, ldu, vt, ldvt, superb);
-    free(superb);
+    info = LAPACKE_sposv_work(CblasColMajor, 'U', n, nrhs, h->a, lda, X, ldb);
+#elif defined(VECLIB_USE_LAPACK_FORTRAN_INTERFACE)
+    sposv_( "U", &n, &nrhs, h->a, &lda, X, &ldb, &info );
 #endif
-    
-    if( info != 0 ) {
-        memset(outM, 0, dim1*dim2*sizeof(float));
+
+    /* A is not symmetric positive definate, solution not possible */
+    if(info!=0){
+        memset(X, 0, dim*nCol*sizeof(float));
+#ifndef NDEBUG
+        saf_error_print(SAF_WARNING__FAILED_TO_SOLVE_LINEAR_EQUATION);
+#endif
+    }
+}
+
+void utility_cslslv_cm_ws
+(
+    void* const hWork,
+    const float_complex* A,
+    const int dim,
+    float_complex* B,
+    int nCol,
+    float_complex* X
+)
+{
+    utility_cslslv_data *h = (utility_cslslv_data*)(hWork);
+    int n = dim, nrhs = nCol, lda = dim, ldb = dim, info;
+
+    assert(dim<=h->maxDim && nCol<=h->maxNCol);
+    memcpy(h->a, A, dim*dim*sizeof(float_complex));
+    if(X!=B)
+        memcpy(X, B, dim*nCol*sizeof(float_complex));
+
+    /* solve AX = B for each column in X (X is replaced by the solution) */
+#if defined(VECLIB_USE_LAPACK_FORTRAN_INTERFACE)
+    cposv_( "U", &n, &nrhs, (veclib_float_complex*)h->a, &lda, (veclib_float_complex*)X, &ldb, &info );
+#elif defined(VECLIB_USE_CLAPACK_INTERFACE)
+    info = clapack_cposv(CblasColMajor, CblasUpper, n, nrhs, (veclib_float_complex*)h->a, lda, (veclib_float_complex*)X, ldb);
+#elif defined(VECLIB_USE_LAPACKE_INTERFACE)
+    info = LAPACKE_cposv_work(CblasColMajor, 'U', n, nrhs, (veclib_float_complex*)h->a, lda, (veclib_float_complex*)X, ldb);
+#endif
+
+    /* A is not symmetric positive definate, solution not possible */
+    if(info!=0){
+        memset(X, 0, dim*nCol*sizeof(float_complex));
+#ifndef NDEBUG
+        saf_error_print(SAF_WARNING__FAILED_TO_SOLVE_LINEAR_EQUATION);
+#endif
+    }
+}
+
+
+/* ========================================================================== */
+/*                        Matrix Pseudo-Inverse (?pinv)                       */
+/* ========================================================================== */
+
+/** Data structure for utility_spinv_ws() */
+typedef struct _utility_spinv_data {
+    int maxDim1, maxDim2, lwork;
+    float* a, *s, *u, *vt, *inva, *work;
+}utility_spinv_data;
+
+void utility_spinv_create
+(
+    void ** const phWork,
+    int maxDim1,
+    int maxDim2
+)
+{
+    *phWork = malloc1d(sizeof(utility_spinv_data));
+    utility_spinv_data *h = (utility_spinv_data*)(*phWork);
+    int m, n, k, lda, ldu, ldvt, info;
+    float wkopt;
+
+    h->maxDim1 = m = lda = ldu = maxDim1;
+    h->maxDim2 = n = maxDim2;
+    k = ldvt = MIN(m, n);
+    h->a = malloc1d(m*n*sizeof(float));
+    h->s = malloc1d(k*sizeof(float));
+    h->u = malloc1d(m*k*sizeof(float));
+    h->vt = malloc1d(k*n*sizeof(float));
+    h->inva = malloc1d(n*m*sizeof(float));
+
+    /* workspace query for the largest dimensions */
+    wkopt = 0.0f;
+    h->lwork = -1;
+#if defined(VECLIB_USE_LAPACK_FORTRAN_INTERFACE)
+    sgesvd_("S", "S", &m, &n, h->a, &lda, h->s, h->u, &ldu, h->vt, &ldvt, &wkopt, &(h->lwork), &info);
+#elif defined(VECLIB_USE_LAPACKE_INTERFACE)
+    info = LAPACKE_sgesvd_work(CblasColMajor, 'S', 'S', m, n, h->a, lda, h->s, h->u, ldu, h->vt, ldvt, &wkopt, h->lwork);
+#endif
+    h->lwork = MAX((int)wkopt, MAX(3*MIN(m,n)+MAX(m,n), 5*MIN(m,n)));
+    h->work = malloc1d(h->lwork*sizeof(float));
+}
+
+void utility_spinv_destroy
+(
+    void ** const phWork
+)
+{
+    utility_spinv_data *h = (utility_spinv_data*)(*phWork);
+    if(h!=NULL){
+        free(h->a);
+        free(h->s);
+        free(h->u);
+        free(h->vt);
+        free(h->inva);
+        free(h->work);
+        free(h);
+        h=NULL;
+        *phWork = NULL;
+    }
+}
+
+void utility_spinv_ws
+(
+    void* const hWork,
+    const float* inM,
+    const int dim1,
+    const int dim2,
+    float* outM
+)
+{
+    utility_spinv_data *h = (utility_spinv_data*)(hWork);
+    int i, j, m, n, k, lda, ldu, ldvt, info;
+    float* a, *s, *u, *vt, *inva;
+    float ss;
+
+    assert(dim1<=h->maxDim1 && dim2<=h->maxDim2);
+    m = lda = ldu = dim1;
+    n = dim2;
+    k = ldvt = m < n ? m : n;
+    a = h->a;
+    s = h->s;
+    u = h->u;
+    vt = h->vt;
+    inva = h->inva;
+    
+    /* store in column major order */
+    for(i=0; i<m; i++)
+        for(j=0; j<n; j++)
+            a[j*m+i] = inM[i*n+j];
+    
+    /* singular value decomposition */
+#if defined(VECLIB_USE_LAPACK_FORTRAN_INTERFACE)
+    sgesvd_("S", "S", &m, &n, a, &lda, s, u, &ldu, vt, &ldvt, h->work, &(h->lwork), &info );
+#elif defined(VECLIB_USE_CLAPACK_INTERFACE)
+    assert(0); /* no such implementation in clapack */
+#elif defined(VECLIB_USE_LAPACKE_INTERFACE)
+    info = LAPACKE_sgesvd_work(CblasColMajor, 'S', 'S', m, n, a, lda, s, u, ldu, vt, ldvt, h->work, h->lwork);
+#endif
+    
+    if( info != 0 ) {
+        memset(outM, 0, dim1*dim2*sizeof(float));
 #ifndef NDEBUG
         saf_error_print(SAF_WARNING__FAILED_TO_COMPUTE_SVD);
 #endif
+        return;
     }
     int incx=1;
     for(i=0; i<k; i++){
@@ -1722,7 +2992,6 @@ void utility_spinv
             ss=s[i];
         cblas_sscal(m, ss, &u[i*m], incx);
     }
-    inva = (float*)malloc1d(n*m*sizeof(float));
     int ld_inva=n;
     cblas_sgemm(CblasColMajor, CblasTrans, CblasTrans, n, m, k, 1.0f,
                 vt, ldvt,
@@ -1733,45 +3002,112 @@ void utility_spinv
     for(i=0; i<m; i++)
         for(j=0; j<n; j++)
             outM[j*m+i] = inva[i*n+j];
-    
-    /* clean-up */
-    free(a);
-    free(s);
-    free(u);
-    free(vt);
-    free(inva);
 }
 
-void utility_cpinv
+void utility_spinv
+(
+    const float* inM,
+    const int dim1,
+    const int dim2,
+    float* outM
+)
+{
+    void* hWork;
+
+    utility_spinv_create(&hWork, dim1, dim2);
+    utility_spinv_ws(hWork, inM, dim1, dim2, outM);
+    utility_spinv_destroy(&hWork);
+}
+
+/** Data structure for utility_cpinv_ws() */
+typedef struct _utility_cpinv_data {
+    int maxDim1, maxDim2, lwork;
+    float_complex* a, *u, *vt, *inva, *work;
+    float* s, *rwork;
+}utility_cpinv_data;
+
+void utility_cpinv_create
+(
+    void ** const phWork,
+    int maxDim1,
+    int maxDim2
+)
+{
+    *phWork = malloc1d(sizeof(utility_cpinv_data));
+    utility_cpinv_data *h = (utility_cpinv_data*)(*phWork);
+    int m, n, k, lda, ldu, ldvt, info;
+    float_complex wkopt;
+
+    h->maxDim1 = m = lda = ldu = maxDim1;
+    h->maxDim2 = n = maxDim2;
+    k = ldvt = MIN(m, n);
+    h->a = malloc1d(m*n*sizeof(float_complex));
+    h->s = malloc1d(k*sizeof(float));
+    h->u = malloc1d(m*k*sizeof(float_complex));
+    h->vt = malloc1d(k*n*sizeof(float_complex));
+    h->inva = malloc1d(n*m*sizeof(float_complex));
+    h->rwork = malloc1d(MAX(1, 5*k)*sizeof(float));
+
+    /* workspace query for the largest dimensions */
+    wkopt = cmplxf(0.0f, 0.0f);
+    h->lwork = -1;
+#if defined(VECLIB_USE_LAPACK_FORTRAN_INTERFACE)
+    cgesvd_( "S", "S", &m, &n, (veclib_float_complex*)h->a, &lda, h->s, (veclib_float_complex*)h->u, &ldu, (veclib_float_complex*)h->vt, &ldvt,
+            (veclib_float_complex*)&wkopt, &(h->lwork), h->rwork, &info );
+#elif defined(VECLIB_USE_LAPACKE_INTERFACE)
+    info = LAPACKE_cgesvd_work(CblasColMajor, 'S', 'S', m, n, (veclib_float_complex*)h->a, lda, h->s, (veclib_float_complex*)h->u, ldu,
+                               (veclib_float_complex*)h->vt, ldvt, (veclib_float_complex*)&wkopt, h->lwork, h->rwork);
+#endif
+    h->lwork = MAX((int)(crealf(wkopt)+0.01f), 2*MIN(m,n)+MAX(m,n));
+    h->work = malloc1d(h->lwork*sizeof(float_complex));
+}
+
+void utility_cpinv_destroy
+(
+    void ** const phWork
+)
+{
+    utility_cpinv_data *h = (utility_cpinv_data*)(*phWork);
+    if(h!=NULL){
+        free(h->a);
+        free(h->s);
+        free(h->u);
+        free(h->vt);
+        free(h->inva);
+        free(h->work);
+        free(h->rwork);
+        free(h);
+        h=NULL;
+        *phWork = NULL;
+    }
+}
+
+void utility_cpinv_ws
 (
+    void* const hWork,
     const float_complex* inM,
     const int dim1,
     const int dim2,
     float_complex* outM
 )
 {
+    utility_cpinv_data *h = (utility_cpinv_data*)(hWork);
     int i, j, m, n, k, lda, ldu, ldvt, info;
     float_complex* a,  *u, *vt, *inva;
     float_complex  ss_cmplx;
     const float_complex calpha = cmplxf(1.0f, 0.0f); const float_complex cbeta = cmplxf(0.0f, 0.0f); /* blas */
     float *s;
     float ss;
-#if defined(VECLIB_USE_LAPACK_FORTRAN_INTERFACE)
-    int lwork;
-    float* rwork;
-    float_complex wkopt;
-    float_complex* work;
-#elif defined(VECLIB_USE_LAPACKE_INTERFACE)
-    float* superb;
-#endif
-    
+
+    assert(dim1<=h->maxDim1 && dim2<=h->maxDim2);
     m = lda = ldu = dim1;
     n = dim2;
     k = ldvt = m < n ? m : n;
-    a = malloc1d(lda*n*sizeof(float_complex));
-    s = malloc1d(MIN(n,m)*sizeof(float));
-    u = malloc1d(ldu*m*sizeof(float_complex));
-    vt = malloc1d(ldvt*n*sizeof(float_complex));
+    a = h->a;
+    s = h->s;
+    u = h->u;
+    vt = h->vt;
+    inva = h->inva;
     
     /* store in column major order */
     for(i=0; i<dim1; i++)
@@ -1780,23 +3116,13 @@ void utility_cpinv
     
     /* singular value decomposition */
 #if defined(VECLIB_USE_LAPACK_FORTRAN_INTERFACE)
-    rwork = malloc1d(m*MAX(1, 5*MIN(n,m))*sizeof(float));
-    lwork = -1;
-    cgesvd_( "A", "A", &m, &n, (veclib_float_complex*)a, &lda, s, (veclib_float_complex*)u, &ldu, (veclib_float_complex*)vt, &ldvt,
-            (veclib_float_complex*)&wkopt, &lwork, rwork, &info );
-    lwork = (int)(crealf(wkopt)+0.01f);
-    work = malloc1d( lwork*sizeof(float_complex) );
-    cgesvd_( "A", "A", &m, &n, (veclib_float_complex*)a, &lda, s, (veclib_float_complex*)u, &ldu, (veclib_float_complex*)vt, &ldvt,
-            (veclib_float_complex*)work, &lwork, rwork, &info);
-    free(work);
-    free(rwork);
+    cgesvd_( "S", "S", &m, &n, (veclib_float_complex*)a, &lda, s, (veclib_float_complex*)u, &ldu, (veclib_float_complex*)vt, &ldvt,
+            (veclib_float_complex*)h->work, &(h->lwork), h->rwork, &info);
 #elif defined(VECLIB_USE_CLAPACK_INTERFACE)
     assert(0); /* no such implementation in clapack */
 #elif defined(VECLIB_USE_LAPACKE_INTERFACE)
-    superb = malloc((MIN(m,n)-1)*sizeof(float));
-    info = LAPACKE_cgesvd(CblasColMajor, 'S', 'S', m, n, (veclib_float_complex*)a, lda, s, (veclib_float_complex*)u, ldu,
-                          (veclib_float_complex*)vt, ldvt, superb);
-    free(superb);
+    info = LAPACKE_cgesvd_work(CblasColMajor, 'S', 'S', m, n, (veclib_float_complex*)a, lda, s, (veclib_float_complex*)u, ldu,
+                               (veclib_float_complex*)vt, ldvt, (veclib_float_complex*)h->work, h->lwork, h->rwork);
 #endif
     
     if( info != 0 ) {
@@ -1804,6 +3130,7 @@ void utility_cpinv
 #ifndef NDEBUG
         saf_error_print(SAF_WARNING__FAILED_TO_COMPUTE_SVD);
 #endif
+        return;
     }
     int incx=1;
     for(i=0; i<k; i++){
@@ -1814,7 +3141,6 @@ void utility_cpinv
         ss_cmplx = cmplxf(ss, 0.0f);
         cblas_cscal(m, &ss_cmplx, &u[i*m], incx);
     }
-    inva = malloc1d(n*m*sizeof(float_complex));
     int ld_inva=n;
     cblas_cgemm(CblasColMajor, CblasConjTrans, CblasConjTrans, n, m, k, &calpha,
                 vt, ldvt,
@@ -1825,13 +3151,21 @@ void utility_cpinv
     for(i=0; i<m; i++)
         for(j=0; j<n; j++)
             outM[j*m+i] = inva[i*n+j];
+}
 
-    /* clean-up */
-    free(a);
-    free(s);
-    free(u);
-    free(vt);
-    free(inva);
+void utility_cpinv
+(
+    const float_complex* inM,
+    const int dim1,
+    const int dim2,
+    float_complex* outM
+)
+{
+    void* hWork;
+
+    utility_cpinv_create(&hWork, dim1, dim2);
+    utility_cpinv_ws(hWork, inM, dim1, dim2, outM);
+    utility_cpinv_destroy(&hWork);
 }
 
 void utility_dpinv
@@ -2020,24 +3354,21 @@ void utility_schol
     float* X
 )
 {
-    int i, j, info, n, lda;
-    float* a;
+    int i, info, n, lda;
  
     n = lda = dim;
-    a = malloc1d(dim*dim*sizeof(float));
-    
-    /* store in column major order */
-    for(i=0; i<dim; i++)
-        for(j=0; j<dim; j++)
-            a[j*dim+i] = A[i*dim+j];
     
-    /* a is replaced by solution */
+    /* 'A' is symmetric, so no transpose is required: its lower triangle (in
+     * column-major terms) is factorised in place as L*L^T, where L^T is the
+     * wanted upper triangular factor in row-major order */
+    if(X!=A)
+        memcpy(X, A, dim*dim*sizeof(float));
 #ifdef VECLIB_USE_CLAPACK_INTERFACE
-    info = clapack_spotrf(CblasColMajor, CblasUpper, n, a, lda);
+    info = clapack_spotrf(CblasColMajor, CblasLower, n, X, lda);
 #elif defined(VECLIB_USE_LAPACKE_INTERFACE)
-    info = LAPACKE_spotrf(CblasColMajor, CblasUpper, n, a, lda);
+    info = LAPACKE_spotrf_work(CblasColMajor, 'L', n, X, lda);
 #elif defined(VECLIB_USE_LAPACK_FORTRAN_INTERFACE)
-    spotrf_( "U", &n, a, &lda, &info );
+    spotrf_( "L", &n, X, &lda, &info );
 #endif
     
     /* A is not positive definate, solution not possible */
@@ -2048,14 +3379,11 @@ void utility_schol
 #endif
     }
     
-    /* store solution in row-major order */
+    /* zero the (untouched) lower triangle */
     else{
-        for(i=0; i<dim; i++)
-            for(j=0; j<dim; j++)
-                X[i*dim+j] = j>=i ? a[j*dim+i] : 0.0f;
+        for(i=1; i<dim; i++)
+            memset(&X[i*dim], 0, i*sizeof(float));
     }
-    
-    free(a);
 }
 
 void utility_cchol
@@ -2065,24 +3393,22 @@ void utility_cchol
     float_complex* X
 )
 {
-    int i, j, info, n, lda;
-    float_complex* a;
+    int i, info, n, lda;
     
     n = lda = dim;
-    a = malloc1d(dim*dim*sizeof(float_complex));
-    
-    /* store in column major order */
-    for(i=0; i<dim; i++)
-        for(j=0; j<dim; j++)
-            a[j*dim+i] = A[i*dim+j];
     
-    /* a is replaced by solution */
+    /* 'A' is Hermitian, so its row-major storage is conj(A) in column-major
+     * order. Its lower triangle (in column-major terms) is factorised in place
+     * as conj(A) = L*L^H, where L^T is the wanted upper triangular factor of
+     * A = (L^T)^H*L^T in row-major order; i.e. no transpose is required */
+    if(X!=A)
+        memcpy(X, A, dim*dim*sizeof(float_complex));
 #if defined(VECLIB_USE_CLAPACK_INTERFACE)
-    info = clapack_cpotrf(CblasColMajor, CblasUpper, n, (veclib_float_complex*)a, lda);
+    info = clapack_cpotrf(CblasColMajor, CblasLower, n, (veclib_float_complex*)X, lda);
 #elif defined(VECLIB_USE_LAPACKE_INTERFACE)
-    info = LAPACKE_cpotrf(CblasColMajor, CblasUpper, n, (veclib_float_complex*)a, lda);
+    info = LAPACKE_cpotrf_work(CblasColMajor, 'L', n, (veclib_float_complex*)X, lda);
 #elif defined(VECLIB_USE_LAPACK_FORTRAN_INTERFACE)
-    cpotrf_( "U", &n, (veclib_float_complex*)a, &lda, &info );
+    cpotrf_( "L", &n, (veclib_float_complex*)X, &lda, &info );
 #endif
     
     /* A is not positive definate, solution not possible */
@@ -2092,14 +3418,11 @@ void utility_cchol
         saf_error_print(SAF_WARNING__FAILED_TO_COMPUTE_CHOL);
 #endif
     }
-    /* store solution in row-major order */
+    /* zero the (untouched) lower triangle */
     else{
-        for(i=0; i<dim; i++)
-            for(j=0; j<dim; j++)
-                X[i*dim+j] = j>=i ? a[j*dim+i] : cmplxf(0.0f, 0.0f);
+        for(i=1; i<dim; i++)
+            memset(&X[i*dim], 0, i*sizeof(float_complex));
     }
-    
-    free(a);
 }
 
 
@@ -2107,21 +3430,59 @@ void utility_cchol
 /*                           Matrix Inversion (?inv)                          */
 /* ========================================================================== */
 
-void utility_sinv
+/** Data structure for utility_sinv_ws() */
+typedef struct _utility_sinv_data {
+    int maxN, lwork;
+    veclib_int* ipiv;
+    float* work, *tmp;
+}utility_sinv_data;
+
+void utility_sinv_create
+(
+    void ** const phWork,
+    int maxN
+)
+{
+    *phWork = malloc1d(sizeof(utility_sinv_data));
+    utility_sinv_data *h = (utility_sinv_data*)(*phWork);
+
+    h->maxN = maxN;
+    h->lwork = maxN*maxN;
+    h->ipiv = malloc1d(maxN*sizeof(veclib_int));
+    h->work = malloc1d(h->lwork*sizeof(float));
+    h->tmp = malloc1d(maxN*maxN*sizeof(float));
+}
+
+void utility_sinv_destroy
+(
+    void ** const phWork
+)
+{
+    utility_sinv_data *h = (utility_sinv_data*)(*phWork);
+    if(h!=NULL){
+        free(h->ipiv);
+        free(h->work);
+        free(h->tmp);
+        free(h);
+        h=NULL;
+        *phWork = NULL;
+    }
+}
+
+void utility_sinv_ws
 (
+    void* const hWork,
     float* A,
-    float * B,
+    float* B,
     const int N
 )
 {
-    int i,j;
-    int *IPIV;
-    IPIV = malloc1d(N * sizeof(int));
-    int LWORK = N*N;
-    float *WORK, *tmp;
-    WORK = (float*)malloc1d(LWORK * sizeof(float));
-    tmp = malloc1d(N*N*sizeof(float));
-    int INFO;
+    utility_sinv_data *h = (utility_sinv_data*)(hWork);
+    int i, j, INFO;
+    float* tmp;
+
+    assert(N<=h->maxN);
+    tmp = h->tmp;
 
     /* Store in column major order */
     for(i=0; i<N; i++)
@@ -2129,24 +3490,34 @@ void utility_sinv
             tmp[j*N+i] = A[i*N+j];
 
 #if defined(VECLIB_USE_LAPACK_FORTRAN_INTERFACE)
-    sgetrf_((veclib_int*)&N, (veclib_int*)&N, tmp, (veclib_int*)&N, IPIV, &INFO);
-    sgetri_((veclib_int*)&N, tmp, (veclib_int*)&N, IPIV, WORK, &LWORK, &INFO);
+    sgetrf_((veclib_int*)&N, (veclib_int*)&N, tmp, (veclib_int*)&N, h->ipiv, &INFO);
+    sgetri_((veclib_int*)&N, tmp, (veclib_int*)&N, h->ipiv, h->work, &(h->lwork), &INFO);
 #elif defined(VECLIB_USE_CLAPACK_INTERFACE)
-    INFO = clapack_sgetrf(CblasColMajor, N, N, tmp, N, IPIV);
-    INFO = clapack_sgetri(CblasColMajor, N, tmp, N, IPIV);
+    INFO = clapack_sgetrf(CblasColMajor, N, N, tmp, N, h->ipiv);
+    INFO = clapack_sgetri(CblasColMajor, N, tmp, N, h->ipiv);
 #elif defined(VECLIB_USE_LAPACKE_INTERFACE)
-    INFO = LAPACKE_sgetrf(CblasColMajor, N, N, tmp, N, IPIV);
-    INFO = LAPACKE_sgetri(CblasColMajor, N, tmp, N, IPIV);
+    INFO = LAPACKE_sgetrf_work(CblasColMajor, N, N, tmp, N, h->ipiv);
+    INFO = LAPACKE_sgetri_work(CblasColMajor, N, tmp, N, h->ipiv, h->work, h->lwork);
 #endif
 
     /* Output in row major order */
     for(i=0; i<N; i++)
         for(j=0; j<N; j++)
             B[j*N+i] = tmp[i*N+j];
-    
-    free(IPIV);
-    free(WORK);
-    free(tmp);
+}
+
+void utility_sinv
+(
+    float* A,
+    float* B,
+    const int N
+)
+{
+    void* hWork;
+
+    utility_sinv_create(&hWork, N);
+    utility_sinv_ws(hWork, A, B, N);
+    utility_sinv_destroy(&hWork);
 }
 
 void utility_dinv
@@ -2191,44 +3562,541 @@ void utility_dinv
     free(tmp);
 }
 
-void utility_cinv
+/** Data structure for utility_cinv_ws() */
+typedef struct _utility_cinv_data {
+    int maxN, lwork;
+    veclib_int* ipiv;
+    float_complex* work, *tmp;
+}utility_cinv_data;
+
+void utility_cinv_create
+(
+    void ** const phWork,
+    int maxN
+)
+{
+    *phWork = malloc1d(sizeof(utility_cinv_data));
+    utility_cinv_data *h = (utility_cinv_data*)(*phWork);
+
+    h->maxN = maxN;
+    h->lwork = maxN*maxN;
+    h->ipiv = malloc1d(maxN*sizeof(veclib_int));
+    h->work = malloc1d(h->lwork*sizeof(float_complex));
+    h->tmp = malloc1d(maxN*maxN*sizeof(float_complex));
+}
+
+void utility_cinv_destroy
+(
+    void ** const phWork
+)
+{
+    utility_cinv_data *h = (utility_cinv_data*)(*phWork);
+    if(h!=NULL){
+        free(h->ipiv);
+        free(h->work);
+        free(h->tmp);
+        free(h);
+        h=NULL;
+        *phWork = NULL;
+    }
+}
+
+void utility_cinv_ws
 (
+    void* const hWork,
     float_complex* A,
     float_complex* B,
     const int N
 )
 {
-    int i, j;
-    int *IPIV;
-    IPIV = malloc1d(N * sizeof(int));
-    int LWORK = N*N;
-    float_complex *WORK, *tmp;
-    WORK = (float_complex*)malloc1d(LWORK * sizeof(float_complex));
-    tmp = malloc1d(N*N*sizeof(float_complex));
-    int INFO;
+    utility_cinv_data *h = (utility_cinv_data*)(hWork);
+    int i, j, INFO;
+    float_complex* tmp;
+
+    assert(N<=h->maxN);
+    tmp = h->tmp;
 
     /* Store in column major order */
     for(i=0; i<N; i++)
         for(j=0; j<N; j++)
             tmp[j*N+i] = A[i*N+j];
-    
+
 #if defined(VECLIB_USE_LAPACK_FORTRAN_INTERFACE)
-    cgetrf_((veclib_int*)&N, (veclib_int*)&N, (veclib_float_complex*)tmp, (veclib_int*)&N, IPIV, &INFO);
-    cgetri_((veclib_int*)&N, (veclib_float_complex*)tmp, (veclib_int*)&N, IPIV, (veclib_float_complex*)WORK, &LWORK, &INFO);
+    cgetrf_((veclib_int*)&N, (veclib_int*)&N, (veclib_float_complex*)tmp, (veclib_int*)&N, h->ipiv, &INFO);
+    cgetri_((veclib_int*)&N, (veclib_float_complex*)tmp, (veclib_int*)&N, h->ipiv, (veclib_float_complex*)h->work, &(h->lwork), &INFO);
 #elif defined(VECLIB_USE_CLAPACK_INTERFACE)
-    INFO = clapack_cgetrf(CblasColMajor, N, N, (veclib_float_complex*)tmp, N, IPIV);
-    INFO = clapack_cgetri(CblasColMajor, N, (veclib_float_complex*)tmp, N, IPIV);
+    INFO = clapack_cgetrf(CblasColMajor, N, N, (veclib_float_complex*)tmp, N, h->ipiv);
+    INFO = clapack_cgetri(CblasColMajor, N, (veclib_float_complex*)tmp, N, h->ipiv);
 #elif defined(VECLIB_USE_LAPACKE_INTERFACE)
-    INFO = LAPACKE_cgetrf(CblasColMajor, N, N, (veclib_float_complex*)tmp, N, IPIV);
-    INFO = LAPACKE_cgetri(CblasColMajor, N, (veclib_float_complex*)tmp, N, IPIV);
+    INFO = LAPACKE_cgetrf_work(CblasColMajor, N, N, (veclib_float_complex*)tmp, N, h->ipiv);
+    INFO = LAPACKE_cgetri_work(CblasColMajor, N, (veclib_float_complex*)tmp, N, h->ipiv, (veclib_float_complex*)h->work, h->lwork);
 #endif
 
     /* Output in row major order */
     for(i=0; i<N; i++)
         for(j=0; j<N; j++)
             B[j*N+i] = tmp[i*N+j];
+}
 
-    free(IPIV);
-    free(WORK);
-    free(tmp);
+void utility_cinv
+(
+    float_complex* A,
+    float_complex* B,
+    const int N
+)
+{
+    void* hWork;
+
+    utility_cinv_create(&hWork, N);
+    utility_cinv_ws(hWork, A, B, N);
+    utility_cinv_destroy(&hWork);
+}
+
+
+/* ========================================================================== */
+/*                          Batched Solvers (?_batch)                         */
+/* ========================================================================== */
+
+#if defined(INTEL_MKL_VERSION) && INTEL_MKL_VERSION >= 20210001
+/** The batched linear solver employs the strided LU batch API of Intel MKL */
+# define SAF_VECLIB_MKL_BATCH
+#endif
+
+/**
+ * Number of bands which the band-interleaved kernels process together (one
+ * AVX register's worth of floats). Element (i,j) of band b is stored at
+ * [(i*nCols+j)*SAF_BATCH_BLOCK + b], with the real and imaginary parts kept in
+ * separate arrays, so that all of the inner loops run across bands
+ */
+#define SAF_BATCH_BLOCK ( 8 )
+
+/** Data structure for utility_cchol_batch() and utility_cslslv_batch() */
+typedef struct _utility_cbatch_data {
+    int maxDim, maxNCol, maxBatch;
+    float* a_re, *a_im;    /* band-interleaved A (then its factorisation) */
+    float* b_re, *b_im;    /* band-interleaved B (then the solution) */
+    float* invDiag;        /* 1/diag(U), band-interleaved */
+    int failFLAG[SAF_BATCH_BLOCK];
+#ifdef SAF_VECLIB_MKL_BATCH
+    MKL_Complex8* a, *b;   /* column-major copies of all bands */
+    MKL_INT* ipiv, *info;
+#endif
+}utility_cbatch_data;
+
+static void utility_cbatch_create
+(
+    void ** const phWork,
+    int maxDim,
+    int maxNCol,
+    int maxBatch
+)
+{
+    *phWork = malloc1d(sizeof(utility_cbatch_data));
+    utility_cbatch_data *h = (utility_cbatch_data*)(*phWork);
+
+    h->maxDim = maxDim;
+    h->maxNCol = maxNCol;
+    h->maxBatch = maxBatch;
+    h->a_re = malloc1d(maxDim*maxDim*SAF_BATCH_BLOCK*sizeof(float));
+    h->a_im = malloc1d(maxDim*maxDim*SAF_BATCH_BLOCK*sizeof(float));
+    h->b_re = maxNCol>0 ? malloc1d(maxDim*maxNCol*SAF_BATCH_BLOCK*sizeof(float)) : NULL;
+    h->b_im = maxNCol>0 ? malloc1d(maxDim*maxNCol*SAF_BATCH_BLOCK*sizeof(float)) : NULL;
+    h->invDiag = malloc1d(maxDim*SAF_BATCH_BLOCK*sizeof(float));
+#ifdef SAF_VECLIB_MKL_BATCH
+    h->a = malloc1d(maxBatch*maxDim*maxDim*sizeof(MKL_Complex8));
+    h->b = malloc1d(maxBatch*maxDim*MAX(maxNCol,1)*sizeof(MKL_Complex8));
+    h->ipiv = malloc1d(maxBatch*maxDim*sizeof(MKL_INT));
+    h->info = malloc1d(2*maxBatch*sizeof(MKL_INT)); /* getrf, getrs */
+#endif
+}
+
+static void utility_cbatch_destroy
+(
+    void ** const phWork
+)
+{
+    utility_cbatch_data *h = (utility_cbatch_data*)(*phWork);
+    if(h!=NULL){
+        free(h->a_re);
+        free(h->a_im);
+        free(h->b_re);
+        free(h->b_im);
+        free(h->invDiag);
+#ifdef SAF_VECLIB_MKL_BATCH
+        free(h->a);
+        free(h->b);
+        free(h->ipiv);
+        free(h->info);
+#endif
+        free(h);
+        h=NULL;
+        *phWork = NULL;
+    }
+}
+
+/**
+ * Copies 'nBands' (row-major) matrices into band-interleaved storage; unused
+ * lanes are filled with identity (square) or zero (non-square) matrices
+ */
+static void saf_batch_interleave
+(
+    const float_complex* A,
+    int nRows,
+    int nCols,
+    int nBands,
+    float* re,
+    float* im
+)
+{
+    int i, j, b;
+    for(i=0; i<nRows; i++){
+        for(j=0; j<nCols; j++){
+            for(b=0; b<nBands; b++){
+                re[(i*nCols+j)*SAF_BATCH_BLOCK+b] = crealf(A[b*nRows*nCols + i*nCols+j]);
+                im[(i*nCols+j)*SAF_BATCH_BLOCK+b] = cimagf(A[b*nRows*nCols + i*nCols+j]);
+            }
+            for(; b<SAF_BATCH_BLOCK; b++){
+                re[(i*nCols+j)*SAF_BATCH_BLOCK+b] = nRows==nCols && i==j ? 1.0f : 0.0f;
+                im[(i*nCols+j)*SAF_BATCH_BLOCK+b] = 0.0f;
+            }
+        }
+    }
+}
+
+/**
+ * In-place Cholesky factorisation, A = U^H * U, of SAF_BATCH_BLOCK
+ * band-interleaved hermitian matrices (only the upper triangle is referenced
+ * and replaced by U). Bands which are not positive-definite are flagged in
+ * 'failFLAG'
+ */
+static void saf_batch_cchol
+(
+    float* re,
+    float* im,
+    int dim,
+    float* invDiag,
+    int* failFLAG
+)
+{
+    int i, j, k, b;
+    float d[SAF_BATCH_BLOCK];
+    float* ar, *ai;
+    const float* uki_r, *uki_i, *ukj_r, *ukj_i;
+
+    for(b=0; b<SAF_BATCH_BLOCK; b++)
+        failFLAG[b] = 0;
+    for(i=0; i<dim; i++){
+        /* U(i,i) = sqrt(A(i,i) - sum_k |U(k,i)|^2) */
+        for(b=0; b<SAF_BATCH_BLOCK; b++)
+            d[b] = re[(i*dim+i)*SAF_BATCH_BLOCK+b];
+        for(k=0; k<i; k++){
+            uki_r = &re[(k*dim+i)*SAF_BATCH_BLOCK];
+            uki_i = &im[(k*dim+i)*SAF_BATCH_BLOCK];
+            for(b=0; b<SAF_BATCH_BLOCK; b++)
+                d[b] -= uki_r[b]*uki_r[b] + uki_i[b]*uki_i[b];
+        }
+        for(b=0; b<SAF_BATCH_BLOCK; b++){
+            if(!(d[b] > 0.0f)){
+                failFLAG[b] = 1;
+                d[b] = 1.0f; /* (keeps the other lanes free of NaNs) */
+            }
+            d[b] = sqrtf(d[b]);
+            invDiag[i*SAF_BATCH_BLOCK+b] = 1.0f/d[b];
+            re[(i*dim+i)*SAF_BATCH_BLOCK+b] = d[b];
+            im[(i*dim+i)*SAF_BATCH_BLOCK+b] = 0.0f;
+        }
+
+        /* U(i,j) = (A(i,j) - sum_k conj(U(k,i))*U(k,j)) / U(i,i), for j>i */
+        for(k=0; k<i; k++){
+            uki_r = &re[(k*dim+i)*SAF_BATCH_BLOCK];
+            uki_i = &im[(k*dim+i)*SAF_BATCH_BLOCK];
+            for(j=i+1; j<dim; j++){
+                ar = &re[(i*dim+j)*SAF_BATCH_BLOCK];
+                ai = &im[(i*dim+j)*SAF_BATCH_BLOCK];
+                ukj_r = &re[(k*dim+j)*SAF_BATCH_BLOCK];
+                ukj_i = &im[(k*dim+j)*SAF_BATCH_BLOCK];
+                for(b=0; b<SAF_BATCH_BLOCK; b++){
+                    ar[b] -= uki_r[b]*ukj_r[b] + uki_i[b]*ukj_i[b];
+                    ai[b] -= uki_r[b]*ukj_i[b] - uki_i[b]*ukj_r[b];
+                }
+            }
+        }
+        for(j=i+1; j<dim; j++){
+            ar = &re[(i*dim+j)*SAF_BATCH_BLOCK];
+            ai = &im[(i*dim+j)*SAF_BATCH_BLOCK];
+            for(b=0; b<SAF_BATCH_BLOCK; b++){
+                ar[b] *= invDiag[i*SAF_BATCH_BLOCK+b];
+                ai[b] *= invDiag[i*SAF_BATCH_BLOCK+b];
+            }
+        }
+    }
+}
+
+/**
+ * Solves U^H * U * X = B, in-place, for SAF_BATCH_BLOCK band-interleaved
+ * right-hand sides 'B' (dim x nCol), given the factorisations from
+ * saf_batch_cchol()
+ */
+static void saf_batch_ccholSolve
+(
+    const float* u_re,
+    const float* u_im,
+    const float* invDiag,
+    int dim,
+    int nCol,
+    float* re,
+    float* im
+)
+{
+    int i, k, c, b;
+    float* xr, *xi;
+    const float* ur, *ui, *yr, *yi;
+
+    /* forward substitution: U^H * Y = B */
+    for(i=0; i<dim; i++){
+        for(k=0; k<i; k++){
+            ur = &u_re[(k*dim+i)*SAF_BATCH_BLOCK]; /* conj(U(k,i)) = U^H(i,k) */
+            ui = &u_im[(k*dim+i)*SAF_BATCH_BLOCK];
+            for(c=0; c<nCol; c++){
+                xr = &re[(i*nCol+c)*SAF_BATCH_BLOCK];
+                xi = &im[(i*nCol+c)*SAF_BATCH_BLOCK];
+                yr = &re[(k*nCol+c)*SAF_BATCH_BLOCK];
+                yi = &im[(k*nCol+c)*SAF_BATCH_BLOCK];
+                for(b=0; b<SAF_BATCH_BLOCK; b++){
+                    xr[b] -= ur[b]*yr[b] + ui[b]*yi[b];
+                    xi[b] -= ur[b]*yi[b] - ui[b]*yr[b];
+                }
+            }
+        }
+        for(c=0; c<nCol; c++){
+            for(b=0; b<SAF_BATCH_BLOCK; b++){
+                re[(i*nCol+c)*SAF_BATCH_BLOCK+b] *= invDiag[i*SAF_BATCH_BLOCK+b];
+                im[(i*nCol+c)*SAF_BATCH_BLOCK+b] *= invDiag[i*SAF_BATCH_BLOCK+b];
+            }
+        }
+    }
+
+    /* back substitution: U * X = Y */
+    for(i=dim-1; i>=0; i--){
+        for(k=i+1; k<dim; k++){
+            ur = &u_re[(i*dim+k)*SAF_BATCH_BLOCK];
+            ui = &u_im[(i*dim+k)*SAF_BATCH_BLOCK];
+            for(c=0; c<nCol; c++){
+                xr = &re[(i*nCol+c)*SAF_BATCH_BLOCK];
+                xi = &im[(i*nCol+c)*SAF_BATCH_BLOCK];
+                yr = &re[(k*nCol+c)*SAF_BATCH_BLOCK];
+                yi = &im[(k*nCol+c)*SAF_BATCH_BLOCK];
+                for(b=0; b<SAF_BATCH_BLOCK; b++){
+                    xr[b] -= ur[b]*yr[b] - ui[b]*yi[b];
+                    xi[b] -= ur[b]*yi[b] + ui[b]*yr[b];
+                }
+            }
+        }
+        for(c=0; c<nCol; c++){
+            for(b=0; b<SAF_BATCH_BLOCK; b++){
+                re[(i*nCol+c)*SAF_BATCH_BLOCK+b] *= invDiag[i*SAF_BATCH_BLOCK+b];
+                im[(i*nCol+c)*SAF_BATCH_BLOCK+b] *= invDiag[i*SAF_BATCH_BLOCK+b];
+            }
+        }
+    }
+}
+
+void utility_cchol_batch_create
+(
+    void ** const phWork,
+    int maxDim,
+    int maxBatch
+)
+{
+    utility_cbatch_create(phWork, maxDim, 0, maxBatch);
+}
+
+void utility_cchol_batch_destroy
+(
+    void ** const phWork
+)
+{
+    utility_cbatch_destroy(phWork);
+}
+
+void utility_cchol_batch
+(
+    void* const hWork,
+    const float_complex* A,
+    const int dim,
+    const int nBatch,
+    float_complex* X
+)
+{
+    utility_cbatch_data *h = (utility_cbatch_data*)(hWork);
+    int i, j, b, band, nBands;
+
+    assert(dim<=h->maxDim && nBatch<=h->maxBatch);
+    for(band=0; band<nBatch; band+=SAF_BATCH_BLOCK){
+        nBands = MIN(SAF_BATCH_BLOCK, nBatch-band);
+        saf_batch_interleave(&A[band*dim*dim], dim, dim, nBands, h->a_re, h->a_im);
+        saf_batch_cchol(h->a_re, h->a_im, dim, h->invDiag, h->failFLAG);
+
+        /* store the upper triangle in row-major order */
+        for(b=0; b<nBands; b++){
+            if(h->failFLAG[b]){
+                /* A is not positive definate, solution not possible */
+                memset(&X[(band+b)*dim*dim], 0, dim*dim*sizeof(float_complex));
+#ifndef NDEBUG
+                saf_error_print(SAF_WARNING__FAILED_TO_COMPUTE_CHOL);
+#endif
+                continue;
+            }
+            for(i=0; i<dim; i++)
+                for(j=0; j<dim; j++)
+                    X[(band+b)*dim*dim + i*dim+j] = j>=i ? cmplxf(h->a_re[(i*dim+j)*SAF_BATCH_BLOCK+b],
+                                                                  h->a_im[(i*dim+j)*SAF_BATCH_BLOCK+b]) : cmplxf(0.0f, 0.0f);
+        }
+    }
+}
+
+void utility_cslslv_batch_create
+(
+    void ** const phWork,
+    int maxDim,
+    int maxNCol,
+    int maxBatch
+)
+{
+    utility_cbatch_create(phWork, maxDim, maxNCol, maxBatch);
+}
+
+void utility_cslslv_batch_destroy
+(
+    void ** const phWork
+)
+{
+    utility_cbatch_destroy(phWork);
+}
+
+void utility_cslslv_batch
+(
+    void* const hWork,
+    const float_complex* A,
+    const int dim,
+    const int nBatch,
+    const float_complex* B,
+    const int nCol,
+    float_complex* X
+)
+{
+    utility_cbatch_data *h = (utility_cbatch_data*)(hWork);
+    int i, j, b;
+#ifdef SAF_VECLIB_MKL_BATCH
+    MKL_INT n, nrhs, lda, ldb, stride_a, stride_b, stride_ipiv, batch_size;
+#else
+    int band, nBands;
+#endif
+
+    assert(dim<=h->maxDim && nCol<=h->maxNCol && nBatch<=h->maxBatch);
+#ifdef SAF_VECLIB_MKL_BATCH
+    n = lda = ldb = stride_ipiv = dim;
+    nrhs = nCol;
+    stride_a = dim*dim;
+    stride_b = dim*nCol;
+    batch_size = nBatch;
+
+    /* store in column major order */
+    for(b=0; b<nBatch; b++){
+        for(i=0; i<dim; i++){
+            for(j=0; j<dim; j++)
+                ((float_complex*)h->a)[b*dim*dim + j*dim+i] = A[b*dim*dim + i*dim+j];
+            for(j=0; j<nCol; j++)
+                ((float_complex*)h->b)[b*dim*nCol + j*dim+i] = B[b*dim*nCol + i*nCol+j];
+        }
+    }
+
+    /* LU factorise and solve all bands with two calls */
+    cgetrf_batch_strided(&n, &n, h->a, &lda, &stride_a, h->ipiv, &stride_ipiv, &batch_size, h->info);
+    cgetrs_batch_strided("N", &n, &nrhs, h->a, &lda, &stride_a, h->ipiv, &stride_ipiv, h->b, &ldb, &stride_b, &batch_size, &(h->info[nBatch]));
+
+    /* store solution in row-major order */
+    for(b=0; b<nBatch; b++){
+        if(h->info[b]!=0 || h->info[nBatch+b]!=0){
+            /* A is singular, solution not possible */
+            memset(&X[b*dim*nCol], 0, dim*nCol*sizeof(float_complex));
+#ifndef NDEBUG
+            saf_error_print(SAF_WARNING__FAILED_TO_SOLVE_LINEAR_EQUATION);
+#endif
+            continue;
+        }
+        for(i=0; i<dim; i++)
+            for(j=0; j<nCol; j++)
+                X[b*dim*nCol + i*nCol+j] = ((float_complex*)h->b)[b*dim*nCol + j*dim+i];
+    }
+#else
+    for(band=0; band<nBatch; band+=SAF_BATCH_BLOCK){
+        nBands = MIN(SAF_BATCH_BLOCK, nBatch-band);
+        saf_batch_interleave(&A[band*dim*dim], dim, dim, nBands, h->a_re, h->a_im);
+        saf_batch_interleave(&B[band*dim*nCol], dim, nCol, nBands, h->b_re, h->b_im);
+        saf_batch_cchol(h->a_re, h->a_im, dim, h->invDiag, h->failFLAG);
+        saf_batch_ccholSolve(h->a_re, h->a_im, h->invDiag, dim, nCol, h->b_re, h->b_im);
+
+        /* store solution in row-major order */
+        for(b=0; b<nBands; b++){
+            if(h->failFLAG[b]){
+                /* A is not symmetric positive definate, solution not possible */
+                memset(&X[(band+b)*dim*nCol], 0, dim*nCol*sizeof(float_complex));
+#ifndef NDEBUG
+                saf_error_print(SAF_WARNING__FAILED_TO_SOLVE_LINEAR_EQUATION);
+#endif
+                continue;
+            }
+            for(i=0; i<dim; i++)
+                for(j=0; j<nCol; j++)
+                    X[(band+b)*dim*nCol + i*nCol+j] = cmplxf(h->b_re[(i*nCol+j)*SAF_BATCH_BLOCK+b], h->b_im[(i*nCol+j)*SAF_BATCH_BLOCK+b]);
+        }
+    }
+#endif
+}
+
+void utility_cseig_batch
+(
+    void* const hWork,
+    const float_complex* A,
+    const int dim,
+    const int nBatch,
+    int sortDecFLAG,
+    float_complex* V,
+    float_complex* D,
+    float* eig
+)
+{
+    int b;
+
+    /* (no batched eigensolvers available; the per-call overhead is instead
+     * avoided by sharing one workspace) */
+    for(b=0; b<nBatch; b++)
+        utility_cseig_ws(hWork, &A[b*dim*dim], dim, sortDecFLAG,
+                         V==NULL ? NULL : &V[b*dim*dim],
+                         D==NULL ? NULL : &D[b*dim*dim],
+                         eig==NULL ? NULL : &eig[b*dim]);
+}
+
+void utility_csvd_batch
+(
+    void* const hWork,
+    const float_complex* A,
+    const int dim1,
+    const int dim2,
+    const int nBatch,
+    float_complex* U,
+    float_complex* S,
+    float_complex* V,
+    float* sing
+)
+{
+    int b;
+
+    for(b=0; b<nBatch; b++)
+        utility_csvd_ws(hWork, &A[b*dim1*dim2], dim1, dim2,
+                        U==NULL ? NULL : &U[b*dim1*dim1],
+                        S==NULL ? NULL : &S[b*dim1*dim2],
+                        V==NULL ? NULL : &V[b*dim2*dim2],
+                        sing==NULL ? NULL : &sing[b*MIN(dim1, dim2)]);
 }
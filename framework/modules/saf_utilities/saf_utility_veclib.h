@@ -58,7 +58,11 @@ extern "C" {
 #include <string.h>
 #include "saf_utility_complex.h"
 #include "saf_utility_error.h"
-#include <immintrin.h>
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+# include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+# include <arm_neon.h>
+#endif
 #ifdef __SSE__
 # include <xmmintrin.h>
 #endif
@@ -107,6 +111,49 @@ typedef enum _CONJ_FLAG{
  * v -> vector
  * m -> matrix */
 
+/* ========================================================================== */
+/*                          SIMD Kernel Dispatching                           */
+/* ========================================================================== */
+
+/**
+ * Instruction set extensions which may be employed by the hand-written SIMD
+ * kernels (used where Intel MKL/Apple Accelerate offer no equivalent routine).
+ * The highest level supported by the CPU is detected once, at run-time, upon
+ * first use.
+ *
+ * utility_svsmul(), utility_svsadd(), utility_svssub(), utility_svvmuladd()
+ * and utility_svvmulfold() are dispatched to these kernels when not using
+ * Apple Accelerate; as are utility_?vvadd(), utility_?vvsub() and
+ * utility_?vvmul(), when using neither Intel MKL nor Apple Accelerate.
+ *
+ * @test test__utility_simdKernels()
+ */
+typedef enum _SAF_SIMD_LEVEL{
+    SAF_SIMD_NONE = 0,  /**< Reference C implementations */
+    SAF_SIMD_SSE,       /**< x86: SSE3 */
+    SAF_SIMD_AVX2,      /**< x86: AVX2 and FMA3 */
+    SAF_SIMD_AVX512,    /**< x86: AVX-512F */
+    SAF_SIMD_NEON       /**< ARM: NEON */
+}SAF_SIMD_LEVEL;
+
+/**
+ * Returns the instruction set extension currently employed by the SIMD
+ * kernels (see #_SAF_SIMD_LEVEL enum)
+ */
+SAF_SIMD_LEVEL utility_getSIMDlevel(void);
+
+/**
+ * Restricts the SIMD kernels to instruction sets up to (and including)
+ * 'maxLevel', e.g. SAF_SIMD_NONE selects the reference C implementations
+ *
+ * Intended for testing and benchmarking. The kernels must not be in use by
+ * other threads when calling this function.
+ *
+ * @param[in] maxLevel Highest instruction set extension which may be employed
+ *                     (see #_SAF_SIMD_LEVEL enum)
+ */
+void utility_setMaxSIMDlevel(SAF_SIMD_LEVEL maxLevel);
+
 /* ========================================================================== */
 /*                     Find Index of Min-Abs-Value (?iminv)                   */
 /* ========================================================================== */
@@ -295,6 +342,32 @@ void utility_cvvadd(/* Input Arguments */
                     /* Output Arguments */
                     float_complex* c);
 
+/**
+ * Single-precision, split-complex, vector-vector addition, i.e.
+ * \code{.m}
+ *     c = a+b
+ * \endcode
+ * where the real and imaginary parts of each vector are held in separate
+ * arrays
+ *
+ * @param[in]  a_re Real part of input vector a; len x 1
+ * @param[in]  a_im Imaginary part of input vector a; len x 1
+ * @param[in]  b_re Real part of input vector b; len x 1
+ * @param[in]  b_im Imaginary part of input vector b; len x 1
+ * @param[in]  len  Vector length
+ * @param[out] c_re Real part of output vector c; len x 1
+ * @param[out] c_im Imaginary part of output vector c; len x 1
+ */
+void utility_cvvadd_split(/* Input Arguments */
+                          float* a_re,
+                          float* a_im,
+                          const float* b_re,
+                          const float* b_im,
+                          const int len,
+                          /* Output Arguments */
+                          float* c_re,
+                          float* c_im);
+
 
 /* ========================================================================== */
 /*                     Vector-Vector Subtraction (?vvsub)                     */
@@ -377,6 +450,146 @@ void utility_cvvmul(/* Input Arguments */
                     /* Output Arguments */
 	                float_complex* c);
 
+/**
+ * Single-precision, split-complex, element-wise vector-vector multiplication
+ * i.e.
+ * \code{.m}
+ *     c = a.*b
+ * \endcode
+ * where the real and imaginary parts of each vector are held in separate
+ * arrays (c may alias a or b)
+ *
+ * @param[in]  a_re Real part of input vector a; len x 1
+ * @param[in]  a_im Imaginary part of input vector a; len x 1
+ * @param[in]  b_re Real part of input vector b; len x 1
+ * @param[in]  b_im Imaginary part of input vector b; len x 1
+ * @param[in]  len  Vector length
+ * @param[out] c_re Real part of output vector c; len x 1
+ * @param[out] c_im Imaginary part of output vector c; len x 1
+ */
+void utility_cvvmul_split(/* Input Arguments */
+                          float* a_re,
+                          float* a_im,
+                          const float* b_re,
+                          const float* b_im,
+                          const int len,
+                          /* Output Arguments */
+                          float* c_re,
+                          float* c_im);
+
+
+/* ========================================================================== */
+/*                Vector-Vector Multiply-Accumulate (?vvmuladd)               */
+/* ========================================================================== */
+
+/**
+ * Single-precision, element-wise vector-vector multiply-accumulate, i.e.
+ * \code{.m}
+ *     c = c + a.*b
+ * \endcode
+ *
+ * @test test__utility_svvmulfold()
+ *
+ * @param[in]     a   Input vector a; len x 1
+ * @param[in]     b   Input vector b; len x 1
+ * @param[in]     len Vector length
+ * @param[in,out] c   Vector to accumulate into; len x 1
+ */
+void utility_svvmuladd(/* Input Arguments */
+                       const float* a,
+                       const float* b,
+                       const int len,
+                       /* Input/Output Arguments */
+                       float* c);
+
+/**
+ * Single-precision, element-wise vector-vector multiplication, where the
+ * product is folded into segments of length 'segLen', i.e.
+ * \code{.m}
+ *     c = sum(reshape(a.*b, [segLen nSeg]), 2)
+ * \endcode
+ *
+ * This is the windowing and time-aliasing operation of a filterbank analysis
+ * stage (e.g. the prototype filter folding of afSTFT), which is carried out in
+ * a single pass, with the accumulation held in registers.
+ *
+ * @test test__utility_svvmulfold()
+ *
+ * @param[in]  a      Input vector a; FLAT: nSeg x segLen
+ * @param[in]  b      Input vector b; FLAT: nSeg x segLen
+ * @param[in]  segLen Segment length
+ * @param[in]  nSeg   Number of segments
+ * @param[out] c      Output vector c; segLen x 1
+ */
+void utility_svvmulfold(/* Input Arguments */
+                        const float* a,
+                        const float* b,
+                        const int segLen,
+                        const int nSeg,
+                        /* Output Arguments */
+                        float* c);
+
+/**
+ * Single-precision, complex, element-wise vector-vector multiply-accumulate,
+ * i.e.
+ * \code{.m}
+ *     c = c + a.*b         % (flag == NO_CONJ)
+ *     c = c + conj(a).*b   % (flag == CONJ)
+ * \endcode
+ *
+ * This replaces utility_cvvmul() into a temporary vector, followed by
+ * utility_cvvadd(), with a single pass over the data.
+ *
+ * @test test__utility_cvvmuladd()
+ *
+ * @param[in]     a    Input vector a; len x 1
+ * @param[in]     b    Input vector b; len x 1
+ * @param[in]     len  Vector length
+ * @param[in]     flag '0' do not take the conjugate of 'a', '1', take the
+ *                     conjugate of 'a'. (see #_CONJ_FLAG enum)
+ * @param[in,out] c    Vector to accumulate into; len x 1
+ */
+void utility_cvvmuladd(/* Input Arguments */
+                       const float_complex* a,
+                       const float_complex* b,
+                       const int len,
+                       CONJ_FLAG flag,
+                       /* Input/Output Arguments */
+                       float_complex* c);
+
+/**
+ * Single-precision, split-complex, element-wise vector-vector
+ * multiply-accumulate, i.e.
+ * \code{.m}
+ *     c = c + a.*b         % (flag == NO_CONJ)
+ *     c = c + conj(a).*b   % (flag == CONJ)
+ * \endcode
+ * where the real and imaginary parts of each vector are held in separate
+ * arrays
+ *
+ * @test test__utility_cvvmuladd()
+ *
+ * @param[in]     a_re Real part of input vector a; len x 1
+ * @param[in]     a_im Imaginary part of input vector a; len x 1
+ * @param[in]     b_re Real part of input vector b; len x 1
+ * @param[in]     b_im Imaginary part of input vector b; len x 1
+ * @param[in]     len  Vector length
+ * @param[in]     flag '0' do not take the conjugate of 'a', '1', take the
+ *                     conjugate of 'a'. (see #_CONJ_FLAG enum)
+ * @param[in,out] c_re Real part of the vector to accumulate into; len x 1
+ * @param[in,out] c_im Imaginary part of the vector to accumulate into; len x 1
+ */
+void utility_cvvmuladd_split(/* Input Arguments */
+                             const float* a_re,
+                             const float* a_im,
+                             const float* b_re,
+                             const float* b_im,
+                             const int len,
+                             CONJ_FLAG flag,
+                             /* Input/Output Arguments */
+                             float* c_re,
+                             float* c_im);
+
 
 /* ========================================================================== */
 /*                     Vector-Vector Dot Product (?vvdot)                     */
@@ -575,6 +788,45 @@ void utility_ssvd(/* Input Arguments */
                   float* V,
                   float* sing);
 
+/**
+ * Creates a workspace for utility_ssvd_ws(), for matrices of up to maxDim1 x
+ * maxDim2. All memory required by utility_ssvd_ws() is allocated here (and the
+ * LAPACK workspace query is also carried out here)
+ *
+ * @param[in] phWork  (&) address of the workspace handle
+ * @param[in] maxDim1 Largest first dimension of matrix 'A'
+ * @param[in] maxDim2 Largest second dimension of matrix 'A'
+ */
+void utility_ssvd_create(void ** const phWork,
+                         int maxDim1,
+                         int maxDim2);
+
+/**
+ * Destroys a workspace created with utility_ssvd_create()
+ *
+ * @param[in] phWork (&) address of the workspace handle
+ */
+void utility_ssvd_destroy(void ** const phWork);
+
+/**
+ * Same as utility_ssvd(), except that the preallocated workspace 'hWork' is
+ * used; therefore, no memory is allocated (i.e. it is real-time safe)
+ *
+ * @param[in] hWork Workspace handle; 'dim1' and 'dim2' must not exceed the
+ *                  dimensions it was created for
+ * @see utility_ssvd() for the remaining arguments
+ */
+void utility_ssvd_ws(/* Input Arguments */
+                     void* const hWork,
+                     const float* A,
+                     const int dim1,
+                     const int dim2,
+                     /* Output Arguments */
+                     float* U,
+                     float* S,
+                     float* V,
+                     float* sing);
+
 /**
  * Singular value decomposition: single precision complex, i.e.
  * \code{.m}
@@ -606,6 +858,45 @@ void utility_csvd(/* Input Arguments */
                   float_complex* V,
                   float* sing);
 
+/**
+ * Creates a workspace for utility_csvd_ws(), for matrices of up to maxDim1 x
+ * maxDim2. All memory required by utility_csvd_ws() is allocated here (and the
+ * LAPACK workspace query is also carried out here)
+ *
+ * @param[in] phWork  (&) address of the workspace handle
+ * @param[in] maxDim1 Largest first dimension of matrix 'A'
+ * @param[in] maxDim2 Largest second dimension of matrix 'A'
+ */
+void utility_csvd_create(void ** const phWork,
+                         int maxDim1,
+                         int maxDim2);
+
+/**
+ * Destroys a workspace created with utility_csvd_create()
+ *
+ * @param[in] phWork (&) address of the workspace handle
+ */
+void utility_csvd_destroy(void ** const phWork);
+
+/**
+ * Same as utility_csvd(), except that the preallocated workspace 'hWork' is
+ * used; therefore, no memory is allocated (i.e. it is real-time safe)
+ *
+ * @param[in] hWork Workspace handle; 'dim1' and 'dim2' must not exceed the
+ *                  dimensions it was created for
+ * @see utility_csvd() for the remaining arguments
+ */
+void utility_csvd_ws(/* Input Arguments */
+                     void* const hWork,
+                     const float_complex* A,
+                     const int dim1,
+                     const int dim2,
+                     /* Output Arguments */
+                     float_complex* U,
+                     float_complex* S,
+                     float_complex* V,
+                     float* sing);
+
 
 /* ========================================================================== */
 /*                 Symmetric Eigenvalue Decomposition (?seig)                 */
@@ -641,6 +932,42 @@ void utility_sseig(/* Input Arguments */
                    float* D,
                    float* eig);
 
+/**
+ * Creates a workspace for utility_sseig_ws(), for matrices of up to maxDim x
+ * maxDim. All memory required by utility_sseig_ws() is allocated here (and the
+ * LAPACK workspace query is also carried out here)
+ *
+ * @param[in] phWork (&) address of the workspace handle
+ * @param[in] maxDim Largest dimension of matrix 'A'
+ */
+void utility_sseig_create(void ** const phWork,
+                          int maxDim);
+
+/**
+ * Destroys a workspace created with utility_sseig_create()
+ *
+ * @param[in] phWork (&) address of the workspace handle
+ */
+void utility_sseig_destroy(void ** const phWork);
+
+/**
+ * Same as utility_sseig(), except that the preallocated workspace 'hWork' is
+ * used; therefore, no memory is allocated (i.e. it is real-time safe)
+ *
+ * @param[in] hWork Workspace handle; 'dim' must not exceed the dimension it was
+ *                  created for
+ * @see utility_sseig() for the remaining arguments
+ */
+void utility_sseig_ws(/* Input Arguments */
+                      void* const hWork,
+                      const float* A,
+                      const int dim,
+                      int sortDecFLAG,
+                      /* Output Arguments */
+                      float* V,
+                      float* D,
+                      float* eig);
+
 /**
  * Eigenvalue decomposition of a SYMMETRIC/HERMITION matrix: single
  * precision complex, i.e.
@@ -671,6 +998,96 @@ void utility_cseig(/* Input Arguments */
                    float_complex* D,
                    float* eig);
 
+/**
+ * Creates a workspace for utility_cseig_ws(), for matrices of up to maxDim x
+ * maxDim. All memory required by utility_cseig_ws() is allocated here (and the
+ * LAPACK workspace query is also carried out here)
+ *
+ * @param[in] phWork (&) address of the workspace handle
+ * @param[in] maxDim Largest dimension of matrix 'A'
+ */
+void utility_cseig_create(void ** const phWork,
+                          int maxDim);
+
+/**
+ * Destroys a workspace created with utility_cseig_create()
+ *
+ * @param[in] phWork (&) address of the workspace handle
+ */
+void utility_cseig_destroy(void ** const phWork);
+
+/**
+ * Same as utility_cseig(), except that the preallocated workspace 'hWork' is
+ * used; therefore, no memory is allocated (i.e. it is real-time safe)
+ *
+ * @param[in] hWork Workspace handle; 'dim' must not exceed the dimension it was
+ *                  created for
+ * @see utility_cseig() for the remaining arguments
+ */
+void utility_cseig_ws(/* Input Arguments */
+                      void* const hWork,
+                      const float_complex* A,
+                      const int dim,
+                      int sortDecFLAG,
+                      /* Output Arguments */
+                      float_complex* V,
+                      float_complex* D,
+                      float* eig);
+
+/**
+ * Same as utility_sseig_ws(), except that 'A' and 'V' are in column-major
+ * order, which is native to LAPACK; the eigenvectors are therefore contiguous
+ * columns of 'V', and are computed directly in place (no transposes)
+ *
+ * @note Since 'A' is symmetric, a row-major 'A' may also be passed directly.
+ *       Only the upper triangle of 'A' (in column-major terms) is referenced.
+ *
+ * @param[in]  hWork       Workspace (see utility_sseig_create())
+ * @param[in]  A           Input SYMMETRIC square matrix; FLAT: dim x dim
+ * @param[in]  dim         Dimensions for square matrix 'A'
+ * @param[in]  sortDecFLAG '1' sort eigen values and vectors in decending order.
+ *                         '0' ascending
+ * @param[out] V           Eigen vectors, column-major (set to NULL if not
+ *                         needed); FLAT: dim x dim
+ * @param[out] eig         Eigen values (set to NULL if not needed); dim x 1
+ */
+void utility_sseig_cm_ws(/* Input Arguments */
+                         void* const hWork,
+                         const float* A,
+                         const int dim,
+                         int sortDecFLAG,
+                         /* Output Arguments */
+                         float* V,
+                         float* eig);
+
+/**
+ * Same as utility_cseig_ws(), except that 'A' and 'V' are in column-major
+ * order, which is native to LAPACK; the eigenvectors are therefore contiguous
+ * columns of 'V', and are computed directly in place (no transposes)
+ *
+ * @note A row-major HERMITIAN matrix is conj(A) in column-major order. It may
+ *       be passed directly, in which case the same eigenvalues, and the
+ *       conjugated eigenvectors conj(V), are returned. Only the upper triangle
+ *       of 'A' (in column-major terms) is referenced.
+ *
+ * @param[in]  hWork       Workspace (see utility_cseig_create())
+ * @param[in]  A           Input HERMITIAN square matrix; FLAT: dim x dim
+ * @param[in]  dim         Dimensions for square matrix 'A'
+ * @param[in]  sortDecFLAG '1' sort eigen values and vectors in decending order.
+ *                         '0' ascending
+ * @param[out] V           Eigen vectors, column-major (set to NULL if not
+ *                         needed); FLAT: dim x dim
+ * @param[out] eig         Eigen values (set to NULL if not needed); dim x 1
+ */
+void utility_cseig_cm_ws(/* Input Arguments */
+                         void* const hWork,
+                         const float_complex* A,
+                         const int dim,
+                         int sortDecFLAG,
+                         /* Output Arguments */
+                         float_complex* V,
+                         float* eig);
+
 
 /* ========================================================================== */
 /*                     Eigenvalues of Matrix Pair (?eigmp)                    */
@@ -904,6 +1321,43 @@ void utility_sslslv(/* Input Arguments */
                     /* Output Arguments */
                     float* X);
 
+/**
+ * Creates a workspace for utility_sslslv_ws(), for matrices 'A' of up to maxDim
+ * x maxDim, and 'B' with up to maxNCol columns. All memory required by
+ * utility_sslslv_ws() is allocated here
+ *
+ * @param[in] phWork  (&) address of the workspace handle
+ * @param[in] maxDim  Largest dimension of matrix 'A'
+ * @param[in] maxNCol Largest number of columns in 'B'
+ */
+void utility_sslslv_create(void ** const phWork,
+                           int maxDim,
+                           int maxNCol);
+
+/**
+ * Destroys a workspace created with utility_sslslv_create()
+ *
+ * @param[in] phWork (&) address of the workspace handle
+ */
+void utility_sslslv_destroy(void ** const phWork);
+
+/**
+ * Same as utility_sslslv(), except that the preallocated workspace 'hWork' is
+ * used; therefore, no memory is allocated (i.e. it is real-time safe)
+ *
+ * @param[in] hWork Workspace handle; 'dim' and 'nCol' must not exceed the
+ *                  dimensions it was created for
+ * @see utility_sslslv() for the remaining arguments
+ */
+void utility_sslslv_ws(/* Input Arguments */
+                       void* const hWork,
+                       const float* A,
+                       const int dim,
+                       float* B,
+                       int nCol,
+                       /* Output Arguments */
+                       float* X);
+
 /**
  * Linear solver for HERMITIAN positive-definate 'A': single precision complex,
  * i.e.
@@ -926,6 +1380,89 @@ void utility_cslslv(/* Input Arguments */
                     /* Output Arguments */
                     float_complex* X);
 
+/**
+ * Creates a workspace for utility_cslslv_ws(), for matrices 'A' of up to maxDim
+ * x maxDim, and 'B' with up to maxNCol columns. All memory required by
+ * utility_cslslv_ws() is allocated here
+ *
+ * @param[in] phWork  (&) address of the workspace handle
+ * @param[in] maxDim  Largest dimension of matrix 'A'
+ * @param[in] maxNCol Largest number of columns in 'B'
+ */
+void utility_cslslv_create(void ** const phWork,
+                           int maxDim,
+                           int maxNCol);
+
+/**
+ * Destroys a workspace created with utility_cslslv_create()
+ *
+ * @param[in] phWork (&) address of the workspace handle
+ */
+void utility_cslslv_destroy(void ** const phWork);
+
+/**
+ * Same as utility_cslslv(), except that the preallocated workspace 'hWork' is
+ * used; therefore, no memory is allocated (i.e. it is real-time safe)
+ *
+ * @param[in] hWork Workspace handle; 'dim' and 'nCol' must not exceed the
+ *                  dimensions it was created for
+ * @see utility_cslslv() for the remaining arguments
+ */
+void utility_cslslv_ws(/* Input Arguments */
+                       void* const hWork,
+                       const float_complex* A,
+                       const int dim,
+                       float_complex* B,
+                       int nCol,
+                       /* Output Arguments */
+                       float_complex* X);
+
+/**
+ * Same as utility_sslslv_ws(), except that 'A', 'B' and 'X' are in
+ * column-major order, which is native to LAPACK (no transposes)
+ *
+ * @note 'X' may be the same buffer as 'B'
+ *
+ * @param[in]  hWork Workspace (see utility_sslslv_create())
+ * @param[in]  A     Input square SYMMETRIC positive-definate matrix;
+ *                   FLAT: dim x dim
+ * @param[in]  dim   Dimensions for square matrix 'A'
+ * @param[in]  B     Right hand side matrix, column-major; FLAT: dim x nCol
+ * @param[in]  nCol  Number of columns in right hand side matrix
+ * @param[out] X     The solution, column-major; FLAT: dim x nCol
+ */
+void utility_sslslv_cm_ws(/* Input Arguments */
+                          void* const hWork,
+                          const float* A,
+                          const int dim,
+                          float* B,
+                          int nCol,
+                          /* Output Arguments */
+                          float* X);
+
+/**
+ * Same as utility_cslslv_ws(), except that 'A', 'B' and 'X' are in
+ * column-major order, which is native to LAPACK (no transposes)
+ *
+ * @note 'X' may be the same buffer as 'B'
+ *
+ * @param[in]  hWork Workspace (see utility_cslslv_create())
+ * @param[in]  A     Input square HERMITIAN positive-definate matrix;
+ *                   FLAT: dim x dim
+ * @param[in]  dim   Dimensions for square matrix 'A'
+ * @param[in]  B     Right hand side matrix, column-major; FLAT: dim x nCol
+ * @param[in]  nCol  Number of columns in right hand side matrix
+ * @param[out] X     The solution, column-major; FLAT: dim x nCol
+ */
+void utility_cslslv_cm_ws(/* Input Arguments */
+                          void* const hWork,
+                          const float_complex* A,
+                          const int dim,
+                          float_complex* B,
+                          int nCol,
+                          /* Output Arguments */
+                          float_complex* X);
+
 
 /* ========================================================================== */
 /*                        Matrix Pseudo-Inverse (?pinv)                       */
@@ -949,6 +1486,42 @@ void utility_spinv(/* Input Arguments */
                    /* Output Arguments */
                    float* B);
 
+/**
+ * Creates a workspace for utility_spinv_ws(), for matrices of up to maxDim1 x
+ * maxDim2. All memory required by utility_spinv_ws() is allocated here (and the
+ * LAPACK workspace query is also carried out here)
+ *
+ * @param[in] phWork  (&) address of the workspace handle
+ * @param[in] maxDim1 Largest first dimension of matrix 'A'
+ * @param[in] maxDim2 Largest second dimension of matrix 'A'
+ */
+void utility_spinv_create(void ** const phWork,
+                          int maxDim1,
+                          int maxDim2);
+
+/**
+ * Destroys a workspace created with utility_spinv_create()
+ *
+ * @param[in] phWork (&) address of the workspace handle
+ */
+void utility_spinv_destroy(void ** const phWork);
+
+/**
+ * Same as utility_spinv(), except that the preallocated workspace 'hWork' is
+ * used; therefore, no memory is allocated (i.e. it is real-time safe)
+ *
+ * @param[in] hWork Workspace handle; 'dim1' and 'dim2' must not exceed the
+ *                  dimensions it was created for
+ * @see utility_spinv() for the remaining arguments
+ */
+void utility_spinv_ws(/* Input Arguments */
+                      void* const hWork,
+                      const float* A,
+                      const int dim1,
+                      const int dim2,
+                      /* Output Arguments */
+                      float* B);
+
 /**
  * General matrix pseudo-inverse (the svd way): single precision complex, i.e.
  * \code{.m}
@@ -967,6 +1540,42 @@ void utility_cpinv(/* Input Arguments */
                    /* Output Arguments */
                    float_complex* B);
 
+/**
+ * Creates a workspace for utility_cpinv_ws(), for matrices of up to maxDim1 x
+ * maxDim2. All memory required by utility_cpinv_ws() is allocated here (and the
+ * LAPACK workspace query is also carried out here)
+ *
+ * @param[in] phWork  (&) address of the workspace handle
+ * @param[in] maxDim1 Largest first dimension of matrix 'A'
+ * @param[in] maxDim2 Largest second dimension of matrix 'A'
+ */
+void utility_cpinv_create(void ** const phWork,
+                          int maxDim1,
+                          int maxDim2);
+
+/**
+ * Destroys a workspace created with utility_cpinv_create()
+ *
+ * @param[in] phWork (&) address of the workspace handle
+ */
+void utility_cpinv_destroy(void ** const phWork);
+
+/**
+ * Same as utility_cpinv(), except that the preallocated workspace 'hWork' is
+ * used; therefore, no memory is allocated (i.e. it is real-time safe)
+ *
+ * @param[in] hWork Workspace handle; 'dim1' and 'dim2' must not exceed the
+ *                  dimensions it was created for
+ * @see utility_cpinv() for the remaining arguments
+ */
+void utility_cpinv_ws(/* Input Arguments */
+                      void* const hWork,
+                      const float_complex* A,
+                      const int dim1,
+                      const int dim2,
+                      /* Output Arguments */
+                      float_complex* B);
+
 /**
  * General matrix pseudo-inverse (the svd way): double precision, i.e.
  * \code{.m}
@@ -1063,6 +1672,36 @@ void utility_sinv(float* A,
                   float* B,
                   const int dim);
 
+/**
+ * Creates a workspace for utility_sinv_ws(), for matrices of up to maxN x maxN.
+ * All memory required by utility_sinv_ws() is allocated here
+ *
+ * @param[in] phWork (&) address of the workspace handle
+ * @param[in] maxN   Largest dimension of matrix 'A'
+ */
+void utility_sinv_create(void ** const phWork,
+                         int maxN);
+
+/**
+ * Destroys a workspace created with utility_sinv_create()
+ *
+ * @param[in] phWork (&) address of the workspace handle
+ */
+void utility_sinv_destroy(void ** const phWork);
+
+/**
+ * Same as utility_sinv(), except that the preallocated workspace 'hWork' is
+ * used; therefore, no memory is allocated (i.e. it is real-time safe)
+ *
+ * @param[in] hWork Workspace handle; 'dim' must not exceed the dimension it was
+ *                  created for
+ * @see utility_sinv() for the remaining arguments
+ */
+void utility_sinv_ws(void* const hWork,
+                     float* A,
+                     float* B,
+                     const int dim);
+
 /**
  * Matrix inversion: double precision, i.e.
  * \code{.m}
@@ -1091,6 +1730,206 @@ void utility_cinv(float_complex* A,
                   float_complex* B,
                   const int dim);
 
+/**
+ * Creates a workspace for utility_cinv_ws(), for matrices of up to maxN x maxN.
+ * All memory required by utility_cinv_ws() is allocated here
+ *
+ * @param[in] phWork (&) address of the workspace handle
+ * @param[in] maxN   Largest dimension of matrix 'A'
+ */
+void utility_cinv_create(void ** const phWork,
+                         int maxN);
+
+/**
+ * Destroys a workspace created with utility_cinv_create()
+ *
+ * @param[in] phWork (&) address of the workspace handle
+ */
+void utility_cinv_destroy(void ** const phWork);
+
+/**
+ * Same as utility_cinv(), except that the preallocated workspace 'hWork' is
+ * used; therefore, no memory is allocated (i.e. it is real-time safe)
+ *
+ * @param[in] hWork Workspace handle; 'dim' must not exceed the dimension it was
+ *                  created for
+ * @see utility_cinv() for the remaining arguments
+ */
+void utility_cinv_ws(void* const hWork,
+                     float_complex* A,
+                     float_complex* B,
+                     const int dim);
+
+
+/* ========================================================================== */
+/*                          Batched Solvers (?_batch)                         */
+/* ========================================================================== */
+
+/*
+ * These process a stack of small matrices (e.g. one per frequency band) with a
+ * single call. The matrices are stacked along the first dimension, i.e.
+ * FLAT: nBatch x dim1 x dim2. The Cholesky factorisation and linear solver
+ * employ band-interleaved kernels, which operate on eight matrices at a time
+ * (the linear solver instead employs the strided batch API of Intel MKL 2021
+ * or newer, when available).
+ */
+
+/**
+ * Creates a workspace for utility_cchol_batch()
+ *
+ * @param[in] phWork   (&) address of the workspace handle
+ * @param[in] maxDim   Largest dimension of the matrices
+ * @param[in] maxBatch Largest number of matrices per call
+ */
+void utility_cchol_batch_create(void ** const phWork,
+                                int maxDim,
+                                int maxBatch);
+
+/**
+ * Destroys a workspace created with utility_cchol_batch_create()
+ *
+ * @param[in] phWork (&) address of the workspace handle
+ */
+void utility_cchol_batch_destroy(void ** const phWork);
+
+/**
+ * Batched Cholesky factorisation of hermitian positive-definate matrices:
+ * single precision complex, i.e.
+ * \code{.m}
+ *     for b=1:nBatch, X(:,:,b) = chol(A(:,:,b)); end
+ * \endcode
+ *
+ * @note Matrices which are not positive-definate yield zeros in 'X' (the
+ *       other matrices in the batch are unaffected). No memory is allocated.
+ *
+ * @param[in]  hWork  Workspace (see utility_cchol_batch_create())
+ * @param[in]  A      Input hermitian positive-definate matrices;
+ *                    FLAT: nBatch x dim x dim
+ * @param[in]  dim    Number of rows/colums in each matrix
+ * @param[in]  nBatch Number of matrices
+ * @param[out] X      Upper triangular factors; FLAT: nBatch x dim x dim
+ */
+void utility_cchol_batch(/* Input Arguments */
+                         void* const hWork,
+                         const float_complex* A,
+                         const int dim,
+                         const int nBatch,
+                         /* Output Arguments */
+                         float_complex* X);
+
+/**
+ * Creates a workspace for utility_cslslv_batch()
+ *
+ * @param[in] phWork   (&) address of the workspace handle
+ * @param[in] maxDim   Largest dimension of the matrices 'A'
+ * @param[in] maxNCol  Largest number of columns in 'B'
+ * @param[in] maxBatch Largest number of matrices per call
+ */
+void utility_cslslv_batch_create(void ** const phWork,
+                                 int maxDim,
+                                 int maxNCol,
+                                 int maxBatch);
+
+/**
+ * Destroys a workspace created with utility_cslslv_batch_create()
+ *
+ * @param[in] phWork (&) address of the workspace handle
+ */
+void utility_cslslv_batch_destroy(void ** const phWork);
+
+/**
+ * Batched linear solver for hermitian positive-definate matrices: single
+ * precision complex, i.e.
+ * \code{.m}
+ *     for b=1:nBatch, X(:,:,b) = linsolve(A(:,:,b),B(:,:,b)); end
+ * \endcode
+ *
+ * @note Matrices for which no solution is possible yield zeros in 'X' (the
+ *       other matrices in the batch are unaffected). No memory is allocated.
+ *
+ * @param[in]  hWork  Workspace (see utility_cslslv_batch_create())
+ * @param[in]  A      Input hermitian positive-definate matrices;
+ *                    FLAT: nBatch x dim x dim
+ * @param[in]  dim    Number of rows/colums in each 'A'
+ * @param[in]  nBatch Number of matrices
+ * @param[in]  B      Right-hand side matrices; FLAT: nBatch x dim x nCol
+ * @param[in]  nCol   Number of columns in each 'B'
+ * @param[out] X      The solutions; FLAT: nBatch x dim x nCol
+ */
+void utility_cslslv_batch(/* Input Arguments */
+                          void* const hWork,
+                          const float_complex* A,
+                          const int dim,
+                          const int nBatch,
+                          const float_complex* B,
+                          const int nCol,
+                          /* Output Arguments */
+                          float_complex* X);
+
+/**
+ * Batched eigenvalue decomposition of hermitian matrices: single precision
+ * complex; see utility_cseig()
+ *
+ * @note There being no batched LAPACK eigensolver, this loops over
+ *       utility_cseig_ws() with the one workspace; no memory is allocated.
+ *
+ * @param[in]  hWork       Workspace (see utility_cseig_create())
+ * @param[in]  A           Input hermitian matrices; FLAT: nBatch x dim x dim
+ * @param[in]  dim         Number of rows/colums in each matrix
+ * @param[in]  nBatch      Number of matrices
+ * @param[in]  sortDecFLAG '1' sort eigen values and vectors in decending
+ *                         order. '0' ascending
+ * @param[out] V           Eigen vectors (set to NULL if not needed);
+ *                         FLAT: nBatch x dim x dim
+ * @param[out] D           Eigen values along the diagonal (set to NULL if not
+ *                         needed); FLAT: nBatch x dim x dim
+ * @param[out] eig         Eigen values not diagonalised (set to NULL if not
+ *                         needed); FLAT: nBatch x dim
+ */
+void utility_cseig_batch(/* Input Arguments */
+                         void* const hWork,
+                         const float_complex* A,
+                         const int dim,
+                         const int nBatch,
+                         int sortDecFLAG,
+                         /* Output Arguments */
+                         float_complex* V,
+                         float_complex* D,
+                         float* eig);
+
+/**
+ * Batched singular value decomposition: single precision complex; see
+ * utility_csvd()
+ *
+ * @note There being no batched LAPACK SVD, this loops over utility_csvd_ws()
+ *       with the one workspace; no memory is allocated.
+ *
+ * @param[in]  hWork  Workspace (see utility_csvd_create())
+ * @param[in]  A      Input matrices; FLAT: nBatch x dim1 x dim2
+ * @param[in]  dim1   First dimension of each matrix
+ * @param[in]  dim2   Second dimension of each matrix
+ * @param[in]  nBatch Number of matrices
+ * @param[out] U      Left matrices (set to NULL if not needed);
+ *                    FLAT: nBatch x dim1 x dim1
+ * @param[out] S      Singular values along the diagonals (set to NULL if not
+ *                    needed); FLAT: nBatch x dim1 x dim2
+ * @param[out] V      Right matrices (UNTRANSPOSED!) (set to NULL if not
+ *                    needed); FLAT: nBatch x dim2 x dim2
+ * @param[out] sing   Singular values as vectors, (set to NULL if not needed);
+ *                    FLAT: nBatch x min(dim1, dim2)
+ */
+void utility_csvd_batch(/* Input Arguments */
+                        void* const hWork,
+                        const float_complex* A,
+                        const int dim1,
+                        const int dim2,
+                        const int nBatch,
+                        /* Output Arguments */
+                        float_complex* U,
+                        float_complex* S,
+                        float_complex* V,
+                        float* sing);
+
 
 #ifdef __cplusplus
 }/* extern "C" */
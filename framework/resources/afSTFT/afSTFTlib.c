@@ -109,13 +109,17 @@ typedef struct{
     int totalHops;
     float *protoFilter;
     float *protoFilterI;
-    float **inBuffer;
+    float **inBuffer; /**< Double-mapped, i.e. each hop is stored twice, at
+                       *   hop indices 'i' and 'i+totalHops'; FLAT: 2*hLen */
     float *fftProcessFrameTD;
     float **outBuffer;
 #ifdef AFSTFT_USE_SAF_UTILITIES
     void* hSafFFT;
+    int fftChannels;       /**< Channel dimension of fftProcessFrameTD/FD,
+                            *   which hold the frames of all channels, so that
+                            *   they may be transformed in a single call;
+                            *   MAX(inChannels, outChannels) */
     float_complex *fftProcessFrameFD;
-    float* tempHopBuffer;
 #else
     int pr;
     int log2n;
@@ -124,6 +128,14 @@ typedef struct{
 #endif
     void *h_afHybrid;
     int hybridMode;
+#if defined(AFSTFT_USE_SAF_UTILITIES) && !defined(AFSTFT_USE_FLOAT_COMPLEX)
+    int nBands;            /**< hopSize+5 (hybrid-mode) or hopSize+1 */
+    int frameChannels;     /**< MAX(inChannels, outChannels) */
+    complexVector* FDhop;  /**< Single-hop scratch for the frame API;
+                            *   frameChannels x nBands */
+    float** TDptrs;        /**< Per-hop pointers into the caller's time-domain
+                            *   buffers; frameChannels x 1 */
+#endif
 } afSTFT;
 
 /**
@@ -187,12 +199,15 @@ void afSTFTinit(void** handle, int hopSize, int inChannels, int outChannels, int
     h->protoFilterI = (float*)malloc(sizeof(float)*h->hLen);
     h->inBuffer = (float**)malloc(sizeof(float*)*h->inChannels);
     h->outBuffer = (float**)malloc(sizeof(float*)*h->outChannels);
-    h->fftProcessFrameTD = (float*)calloc(sizeof(float),h->hopSize*2);
 #ifdef AFSTFT_USE_SAF_UTILITIES
     saf_rfft_create(&(h->hSafFFT), h->hopSize*2);
-    h->fftProcessFrameFD  = calloc((h->hopSize+1), sizeof(float_complex));
-    h->tempHopBuffer = malloc(h->hopSize*sizeof(float));
+    saf_rfft_prepareBatch(h->hSafFFT, h->inChannels, 2*h->hopSize, h->hopSize+1);  /* (see afSTFTforward()) */
+    saf_rfft_prepareBatch(h->hSafFFT, h->outChannels, h->hopSize+1, 2*h->hopSize); /* (see afSTFTinverse()) */
+    h->fftChannels = MAX(h->inChannels, h->outChannels);
+    h->fftProcessFrameTD = calloc1d(h->fftChannels*(h->hopSize*2), sizeof(float));
+    h->fftProcessFrameFD = calloc1d(h->fftChannels*(h->hopSize+1), sizeof(float_complex));
 #else
+    h->fftProcessFrameTD = (float*)calloc(sizeof(float),h->hopSize*2);
     switch (hopSize) {
         case 32:
             h->log2n=6;
@@ -247,7 +262,7 @@ void afSTFTinit(void** handle, int hopSize, int inChannels, int outChannels, int
         }
     }
     for(ch=0;ch<h->inChannels;ch++)
-        h->inBuffer[ch] = (float*)calloc(h->hLen,sizeof(float));
+        h->inBuffer[ch] = (float*)calloc(2*h->hLen,sizeof(float));
     
     for(ch=0;ch<h->outChannels;ch++)
         h->outBuffer[ch] = (float*)calloc(h->hLen,sizeof(float));
@@ -256,6 +271,18 @@ void afSTFTinit(void** handle, int hopSize, int inChannels, int outChannels, int
     h->hybridMode=hybridMode;
     if (h->hybridMode)
         afHybridInit(&(h->h_afHybrid), h->hopSize, h->inChannels,h->outChannels);
+
+#if defined(AFSTFT_USE_SAF_UTILITIES) && !defined(AFSTFT_USE_FLOAT_COMPLEX)
+    /* Scratch for afSTFTforwardFrame()/afSTFTinverseFrame() */
+    h->nBands = h->hopSize + (h->hybridMode ? 5 : 1);
+    h->frameChannels = MAX(h->inChannels, h->outChannels);
+    h->FDhop = malloc1d(h->frameChannels*sizeof(complexVector));
+    for(ch=0; ch<h->frameChannels; ch++){
+        h->FDhop[ch].re = calloc1d(h->nBands, sizeof(float));
+        h->FDhop[ch].im = calloc1d(h->nBands, sizeof(float));
+    }
+    h->TDptrs = malloc1d(h->frameChannels*sizeof(float*));
+#endif
 }
 
 void afSTFTchannelChange(void* handle, int new_inChannels, int new_outChannels)
@@ -269,7 +296,7 @@ void afSTFTchannelChange(void* handle, int new_inChannels, int new_outChannels)
             free(h->inBuffer[i]);
         h->inBuffer = (float**)realloc(h->inBuffer, sizeof(float*)*new_inChannels);
         for(i=h->inChannels; i<new_inChannels; i++)
-            h->inBuffer[i] = (float*)calloc(h->hLen,sizeof(float));
+            h->inBuffer[i] = (float*)calloc(2*h->hLen,sizeof(float));
     }
     
     if(h->outChannels!=new_outChannels){
@@ -316,6 +343,30 @@ void afSTFTchannelChange(void* handle, int new_inChannels, int new_outChannels)
         }
 #endif
     }
+#ifdef AFSTFT_USE_SAF_UTILITIES
+    saf_rfft_prepareBatch(h->hSafFFT, new_inChannels, 2*h->hopSize, h->hopSize+1);
+    saf_rfft_prepareBatch(h->hSafFFT, new_outChannels, h->hopSize+1, 2*h->hopSize);
+    if(h->fftChannels != MAX(new_inChannels, new_outChannels)){
+        h->fftChannels = MAX(new_inChannels, new_outChannels);
+        h->fftProcessFrameTD = realloc1d(h->fftProcessFrameTD, h->fftChannels*(h->hopSize*2)*sizeof(float));
+        h->fftProcessFrameFD = realloc1d(h->fftProcessFrameFD, h->fftChannels*(h->hopSize+1)*sizeof(float_complex));
+    }
+#endif
+#if defined(AFSTFT_USE_SAF_UTILITIES) && !defined(AFSTFT_USE_FLOAT_COMPLEX)
+    if(h->frameChannels != MAX(new_inChannels, new_outChannels)){
+        for(ch=MAX(new_inChannels, new_outChannels); ch<h->frameChannels; ch++){
+            free(h->FDhop[ch].re);
+            free(h->FDhop[ch].im);
+        }
+        h->FDhop = realloc1d(h->FDhop, MAX(new_inChannels, new_outChannels)*sizeof(complexVector));
+        for(ch=h->frameChannels; ch<MAX(new_inChannels, new_outChannels); ch++){
+            h->FDhop[ch].re = calloc1d(h->nBands, sizeof(float));
+            h->FDhop[ch].im = calloc1d(h->nBands, sizeof(float));
+        }
+        h->frameChannels = MAX(new_inChannels, new_outChannels);
+        h->TDptrs = realloc1d(h->TDptrs, h->frameChannels*sizeof(float*));
+    }
+#endif
     h->inChannels = new_inChannels;
     h->outChannels = new_outChannels;
     if (h->hybridMode){
@@ -331,7 +382,7 @@ void afSTFTclearBuffers(void* handle)
     int i, ch, sample;
     
     for(i=0; i<h->inChannels; i++)
-        memset(h->inBuffer[i], 0, h->hLen*sizeof(float));
+        memset(h->inBuffer[i], 0, 2*h->hLen*sizeof(float));
     for(i=0; i<h->outChannels; i++)
         memset(h->outBuffer[i], 0, h->hLen*sizeof(float));
     if (h->hybridMode){
@@ -360,20 +411,23 @@ void afSTFTforward(void* handle, float** inTD, complexVector* outFD)
 #endif
 {
     afSTFT *h = (afSTFT*)(handle);
-    int ch,k,j,hopIndex_this,hopIndex_this2;
-    float *p1,*p2,*p3;
+    int ch,hopIndex_this2;
+    float *p1,*p2;
 #ifndef AFSTFT_USE_SAF_UTILITIES
-    float *p4;
+    int k;
+    float *p3,*p4;
 #endif
-    int lr;
     
     for (ch=0;ch<h->inChannels;ch++)
     {
-        /* Copy the input frame into the memory buffer */
+        /* Copy the input frame into the memory buffer (into both of its
+         * mappings, so that the hLen samples starting at any hop are
+         * contiguous) */
         hopIndex_this2 = h->hopIndexIn;
         p1=&(h->inBuffer[ch][hopIndex_this2*h->hopSize]);
         p2=inTD[ch];
         memcpy((void*)p1,(void*)p2,sizeof(float)*(h->hopSize));
+        memcpy((void*)(p1+h->hLen),(void*)p2,sizeof(float)*(h->hopSize));
         
         hopIndex_this2++;
         if (hopIndex_this2 >= h->totalHops)
@@ -381,56 +435,19 @@ void afSTFTforward(void* handle, float** inTD, complexVector* outFD)
             hopIndex_this2 = 0;
         }
         
-        /* Apply prototype filter to the collected data in the memory buffer, and fold the result (for the FFT operation). */
-        p1 = h->fftProcessFrameTD;
+        /* Apply prototype filter to the collected data in the memory buffer, and fold the result (for the FFT operation).
+         * The even hops are folded onto the left part of the frame, and the odd hops onto the right part; i.e. the
+         * product is folded in segments of two hops */
+        p1=&(h->inBuffer[ch][h->hopSize*hopIndex_this2]);
 #ifdef AFSTFT_USE_SAF_UTILITIES
-        memset(p1, 0, h->hopSize*2*sizeof(float));
+        /* (each channel has its own frame, see below) */
+        utility_svvmulfold(p1, h->protoFilter, 2*h->hopSize, h->totalHops/2, &(h->fftProcessFrameTD[ch*2*h->hopSize]));
 #else
-        vtClr(p1, h->hopSize*2);
-#endif
-        lr=0; /* Left or right part of the frame */
-        hopIndex_this = hopIndex_this2;
+        vtClr(h->fftProcessFrameTD, h->hopSize*2);
         for (k=0;k<h->totalHops;k++)
-        {
-            p1=&(h->inBuffer[ch][h->hopSize*hopIndex_this]);
-            p2=&(h->protoFilter[k*h->hopSize]);
-            if (lr==1)
-            {
-                p3=&(h->fftProcessFrameTD[h->hopSize]);
-                lr=0;
-            }
-            else
-            {
-                p3=&(h->fftProcessFrameTD[0]);
-                lr=1;
-            }
-#ifdef AFSTFT_USE_SAF_UTILITIES
-//            utility_svvmul(p1, p2, h->hopSize, h->tempHopBuffer);
-//            utility_svvadd(p3, h->tempHopBuffer, h->hopSize, p3);
-            for (j=0;j<h->hopSize;j++)
-                p3[j] += (p1[j])*(p2[j]);
-#else
-            vtVma(p1, p2, p3, h->hopSize);  /* Vector multiply-add */
-#endif
-            hopIndex_this++;
-            if (hopIndex_this >= h->totalHops)
-            {
-                hopIndex_this = 0;
-            }
-        }
+            vtVma(&p1[k*h->hopSize], &(h->protoFilter[k*h->hopSize]), &(h->fftProcessFrameTD[(k%2)*h->hopSize]), h->hopSize);  /* Vector multiply-add */
         
         /* Apply FFT and copy the data to the output vector */
-#ifdef AFSTFT_USE_SAF_UTILITIES
-# ifdef AFSTFT_USE_FLOAT_COMPLEX
-        saf_rfft_forward(h->hSafFFT, h->fftProcessFrameTD, outFD[ch]);
-# else
-        saf_rfft_forward(h->hSafFFT, h->fftProcessFrameTD, h->fftProcessFrameFD);
-        for(k = 0; k<h->hopSize+1; k++){
-            outFD[ch].re[k] = crealf(h->fftProcessFrameFD[k]);
-            outFD[ch].im[k] = cimagf(h->fftProcessFrameFD[k]);
-        }
-# endif // AFSTFT_USE_FLOAT_COMPLEX
-#else
         vtRunFFT(h->vtFFT,1);
         outFD[ch].re[0]=h->fftProcessFrameFD[0];
         outFD[ch].im[0]=0.0f; /* DC im = 0 */
@@ -444,6 +461,19 @@ void afSTFTforward(void* handle, float** inTD, complexVector* outFD)
         memcpy((void*)p2,(void*)p4,sizeof(float)*(h->hopSize - 1));
 #endif
     }
+#ifdef AFSTFT_USE_SAF_UTILITIES
+    /* Apply FFT to the frames of all channels in a single call, and copy the
+     * data to the output vectors */
+    saf_rfft_forward_batch(h->hSafFFT, h->inChannels, h->fftProcessFrameTD, 2*h->hopSize, h->fftProcessFrameFD, h->hopSize+1);
+    for(ch=0; ch<h->inChannels; ch++){
+# ifdef AFSTFT_USE_FLOAT_COMPLEX
+        utility_cvvcopy(&(h->fftProcessFrameFD[ch*(h->hopSize+1)]), h->hopSize+1, outFD[ch]);
+# else
+        cblas_scopy(h->hopSize+1, (float*)&(h->fftProcessFrameFD[ch*(h->hopSize+1)]), 2, outFD[ch].re, 1);
+        cblas_scopy(h->hopSize+1, ((float*)&(h->fftProcessFrameFD[ch*(h->hopSize+1)]))+1, 2, outFD[ch].im, 1);
+# endif
+    }
+#endif
     h->hopIndexIn++;
     if (h->hopIndexIn >= h->totalHops)
     {
@@ -464,12 +494,13 @@ void afSTFTinverse(void* handle, complexVector* inFD, float** outTD)
 #endif
 {
     afSTFT *h = (afSTFT*)(handle);
-    int ch,k,j,hopIndex_this,hopIndex_this2;
+    int ch,k,hopIndex_this,hopIndex_this2,nHopsToWrap;
     float *p1,*p2,*p3;
-#ifndef AFSTFT_USE_SAF_UTILITIES
+#ifdef AFSTFT_USE_SAF_UTILITIES
+    float_complex *pFD;
+#else
     float *p4;
 #endif
-    int lr;
     
     /* Combine subdivided lowest bands if hybrid mode is enabled */
     if (h->hybridMode)
@@ -477,27 +508,34 @@ void afSTFTinverse(void* handle, complexVector* inFD, float** outTD)
         afHybridInverse(h->h_afHybrid, inFD);
     }
     
+#ifdef AFSTFT_USE_SAF_UTILITIES
+    /* Copy data from input to internal memory */
     for (ch=0;ch<h->outChannels;ch++)
     {
-        /* Copy data from input to internal memory */
-        hopIndex_this2 = h->hopIndexOut;
-        
-        /* Inverse FFT */
-#ifdef AFSTFT_USE_SAF_UTILITIES
+        pFD = &(h->fftProcessFrameFD[ch*(h->hopSize+1)]);
 # ifdef AFSTFT_USE_FLOAT_COMPLEX
-        utility_cvvcopy(inFD[ch], h->hopSize + 1, h->fftProcessFrameFD);
+        utility_cvvcopy(inFD[ch], h->hopSize + 1, pFD);
 # else
-        for(k = 0; k<h->hopSize+1; k++)
-            h->fftProcessFrameFD[k] = cmplxf(inFD[ch].re[k], inFD[ch].im[k]);
+        cblas_scopy(h->hopSize+1, inFD[ch].re, 1, (float*)pFD, 2);
+        cblas_scopy(h->hopSize+1, inFD[ch].im, 1, ((float*)pFD)+1, 2);
 # endif
         
         /* The low delay mode requires this procedure corresponding to the circular shift of the data in the time domain */
         if (h->LDmode == 1)
             for (k=1; k<h->hopSize; k+=2)
-                h->fftProcessFrameFD[k] = crmulf(h->fftProcessFrameFD[k], -1.0f);
+                pFD[k] = crmulf(pFD[k], -1.0f);
+    }
+    
+    /* Inverse FFT of all channels in a single call */
+    saf_rfft_backward_batch(h->hSafFFT, h->outChannels, h->fftProcessFrameFD, h->hopSize+1, h->fftProcessFrameTD, 2*h->hopSize);
+#endif
+    
+    for (ch=0;ch<h->outChannels;ch++)
+    {
+        hopIndex_this2 = h->hopIndexOut;
         
-        saf_rfft_backward(h->hSafFFT, h->fftProcessFrameFD, h->fftProcessFrameTD);
-#else
+#ifndef AFSTFT_USE_SAF_UTILITIES
+        /* Copy data from input to internal memory, and inverse FFT */
         h->fftProcessFrameFD[0] = inFD[ch].re[0]; /* DC */
         h->fftProcessFrameFD[h->hopSize] = inFD[ch].re[h->hopSize]; /* Nyquist */
         p1 = inFD[ch].re + 1;
@@ -534,39 +572,27 @@ void afSTFTinverse(void* handle, complexVector* inFD, float** outTD)
         }
         hopIndex_this = hopIndex_this2;
         
-        lr=0; /* Left or right part of the frame */
+        /* The circular buffer is traversed as two contiguous runs (up to, and
+         * after, its wrap-around point), so no per-hop index wrapping is needed */
+        nHopsToWrap = h->totalHops-hopIndex_this;
         for (k=0;k<h->totalHops;k++)
         {
-            /* Apply the prototype filter to the repeated version of the IFFT'd data. */
-            p1=&(h->outBuffer[ch][h->hopSize*hopIndex_this]);
+            /* Apply the prototype filter to the repeated version of the IFFT'd data
+             * (even hops use the left part of the frame, odd hops the right part) */
+            p1=&(h->outBuffer[ch][h->hopSize*(k<nHopsToWrap ? hopIndex_this+k : k-nHopsToWrap)]);
             p2=&(h->protoFilterI[k*h->hopSize]);
-            
-            if (lr==1)
-            {
-                p3=&(h->fftProcessFrameTD[h->hopSize]);
-                lr=0;
-            }
-            else
-            {
-                p3=&(h->fftProcessFrameTD[0]);
-                lr=1;
-            }
+#ifdef AFSTFT_USE_SAF_UTILITIES
+            p3=&(h->fftProcessFrameTD[(2*ch + k%2)*h->hopSize]);
+#else
+            p3=&(h->fftProcessFrameTD[(k%2)*h->hopSize]);
+#endif
  
             /* Overlap-add to the existing data in the memory buffer (from previous frames). */
 #ifdef AFSTFT_USE_SAF_UTILITIES
-//            utility_svvmul(p2, p3, h->hopSize, h->tempHopBuffer);
-//            utility_svvadd(p1, h->tempHopBuffer, h->hopSize, p1);
-            for (j=0;j<h->hopSize;j++)
-                p1[j] += (p2[j])*(p3[j]); 
+            utility_svvmuladd(p2, p3, h->hopSize, p1);
 #else
             vtVma(p2, p3, p1, h->hopSize); /* Vector multiply-add */
 #endif
-            
-            hopIndex_this++;
-            if (hopIndex_this >= h->totalHops)
-            {
-                hopIndex_this = 0;
-            }
         }
         
         /* Copy a frame from work memory to the output */
@@ -583,6 +609,137 @@ void afSTFTinverse(void* handle, complexVector* inFD, float** outTD)
     
 }
 
+#if defined(AFSTFT_USE_SAF_UTILITIES) && !defined(AFSTFT_USE_FLOAT_COMPLEX)
+/**
+ * Returns the distance, in floats, between two consecutive bands of the same
+ * channel and hop, for the given frame storage format
+ */
+static int afSTFTframeBandStride(AFSTFT_FDDATA_FORMAT format, int nChBuffer, int nHops)
+{
+    switch(format){
+        case AFSTFT_BANDS_CH_TIME: return 2*nChBuffer*nHops;
+        case AFSTFT_TIME_CH_BANDS: return 2;
+    }
+    return 2;
+}
+
+/**
+ * Returns the index of the first band of channel 'ch' and hop 'hop', for the
+ * given frame storage format
+ */
+static int afSTFTframeOffset(AFSTFT_FDDATA_FORMAT format, int nChBuffer, int nHops, int nBands, int hop, int ch)
+{
+    switch(format){
+        case AFSTFT_BANDS_CH_TIME: return ch*nHops + hop;
+        case AFSTFT_TIME_CH_BANDS: return (hop*nChBuffer + ch)*nBands;
+    }
+    return 0;
+}
+
+void afSTFTforwardFrame
+(
+    void* handle,
+    float** inTD,
+    int framesize,
+    int nChBuffer,
+    AFSTFT_FDDATA_FORMAT format,
+    float_complex* outFD
+)
+{
+    afSTFT *h = (afSTFT*)(handle);
+    int ch, hop, nHops, stride;
+    float* pOut;
+
+    nHops = framesize/h->hopSize;
+    stride = afSTFTframeBandStride(format, nChBuffer, nHops);
+    for(hop=0; hop<nHops; hop++){
+        /* Transform one hop of the frame (no need to copy the input) */
+        for(ch=0; ch<h->inChannels; ch++)
+            h->TDptrs[ch] = &(inTD[ch][hop*h->hopSize]);
+        afSTFTforward(handle, h->TDptrs, h->FDhop);
+
+        /* Interleave the real/imag parts straight into the caller's layout */
+        for(ch=0; ch<h->inChannels; ch++){
+            pOut = (float*)&outFD[afSTFTframeOffset(format, nChBuffer, nHops, h->nBands, hop, ch)];
+            cblas_scopy(h->nBands, h->FDhop[ch].re, 1, pOut, stride);
+            cblas_scopy(h->nBands, h->FDhop[ch].im, 1, pOut+1, stride);
+        }
+    }
+}
+
+void afSTFTinverseFrame
+(
+    void* handle,
+    float_complex* inFD,
+    int framesize,
+    int nChBuffer,
+    AFSTFT_FDDATA_FORMAT format,
+    float** outTD
+)
+{
+    afSTFT *h = (afSTFT*)(handle);
+    int ch, hop, nHops, stride;
+    float* pIn;
+
+    nHops = framesize/h->hopSize;
+    stride = afSTFTframeBandStride(format, nChBuffer, nHops);
+    for(hop=0; hop<nHops; hop++){
+        /* De-interleave this hop straight from the caller's layout */
+        for(ch=0; ch<h->outChannels; ch++){
+            pIn = (float*)&inFD[afSTFTframeOffset(format, nChBuffer, nHops, h->nBands, hop, ch)];
+            cblas_scopy(h->nBands, pIn, stride, h->FDhop[ch].re, 1);
+            cblas_scopy(h->nBands, pIn+1, stride, h->FDhop[ch].im, 1);
+        }
+
+        /* Transform, writing straight into the caller's output buffers */
+        for(ch=0; ch<h->outChannels; ch++)
+            h->TDptrs[ch] = &(outTD[ch][hop*h->hopSize]);
+        afSTFTinverse(handle, h->FDhop, h->TDptrs);
+    }
+}
+#endif
+
+void afSTFTgetCenterFreqs
+(
+    int hopSize,
+    int hybridMode,
+    float fs,
+    float* freqVector
+)
+{
+    int band;
+    float binWidth;
+
+    if(hybridMode && hopSize==128 && (fs==44100.0f || fs==48e3f)){
+        for(band=0; band<133; band++)
+            freqVector[band] = (float)(fs==44100.0f ? __afCenterFreq44100[band] : __afCenterFreq48e3[band]);
+        return;
+    }
+    binWidth = fs/(2.0f*(float)hopSize);
+    if(hybridMode){
+        /* DC, then the 4 lowest bins split into 2 half-bands each */
+        freqVector[0] = 0.0f;
+        for(band=1; band<9; band++)
+            freqVector[band] = (0.25f + 0.5f*(float)band)*binWidth;
+        for(band=9; band<hopSize+5; band++)
+            freqVector[band] = (float)(band-4)*binWidth;
+    }
+    else{
+        for(band=0; band<hopSize+1; band++)
+            freqVector[band] = (float)band*binWidth;
+    }
+}
+
+int afSTFTgetProcessingDelay
+(
+    int hopSize,
+    int LDmode,
+    int hybridMode
+)
+{
+    return hopSize * ((LDmode ? 4 : 9) + (hybridMode ? 3 : 0));
+}
+
 void afSTFTfree(void* handle)
 {
     afSTFT *h = (afSTFT*)(handle);
@@ -606,9 +763,16 @@ void afSTFTfree(void* handle)
     free(h->outBuffer);
     free(h->fftProcessFrameTD);
     free(h->fftProcessFrameFD);
+#if defined(AFSTFT_USE_SAF_UTILITIES) && !defined(AFSTFT_USE_FLOAT_COMPLEX)
+    for(ch=0; ch<h->frameChannels; ch++){
+        free(h->FDhop[ch].re);
+        free(h->FDhop[ch].im);
+    }
+    free(h->FDhop);
+    free(h->TDptrs);
+#endif
 #ifdef AFSTFT_USE_SAF_UTILITIES
     saf_rfft_destroy(&(h->hSafFFT));
-    free(h->tempHopBuffer);
 #else
     vtFreeFFT(h->vtFFT);
 #endif
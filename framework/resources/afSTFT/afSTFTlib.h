@@ -147,6 +147,118 @@ void afSTFTinverse(void* handle, float_complex** inFD, float** outTD);
 void afSTFTinverse(void* handle, complexVector* inFD, float** outTD);
 #endif
 
+#if defined(AFSTFT_USE_SAF_UTILITIES) && !defined(AFSTFT_USE_FLOAT_COMPLEX)
+/**
+ * Storage formats for the time-frequency data of afSTFTforwardFrame() and
+ * afSTFTinverseFrame()
+ */
+typedef enum _AFSTFT_FDDATA_FORMAT{
+    AFSTFT_BANDS_CH_TIME, /**< nBands x nChBuffer x nHops (band-major) */
+    AFSTFT_TIME_CH_BANDS  /**< nHops x nChBuffer x nBands (channel-major per
+                           *   hop) */
+}AFSTFT_FDDATA_FORMAT;
+
+/**
+ * Applies the forward afSTFT transform to a frame of several hops, writing the
+ * result directly into a float_complex buffer of the requested format
+ *
+ * This removes the need to copy each hop into a temporary buffer, and to then
+ * shuffle the complexVector output into the caller's own storage.
+ *
+ * @note The number of processed channels is "inChannels" (as given to
+ *       afSTFTinit() or afSTFTchannelChange()). Any remaining channels of the
+ *       output buffer (up to nChBuffer) are left untouched.
+ *
+ * Unit test(s): test__afSTFTframe()
+ *
+ * @param[in]  handle    afSTFTlib handle
+ * @param[in]  inTD      Input time-domain signals; inChannels x framesize
+ * @param[in]  framesize Frame size, in samples; must be a multiple of hopSize
+ * @param[in]  nChBuffer Channel dimension of outFD (>= inChannels)
+ * @param[in]  format    Storage format of outFD, see #AFSTFT_FDDATA_FORMAT
+ * @param[out] outFD     Output time-frequency domain signals; FLAT: nBands x
+ *                       nChBuffer x (framesize/hopSize), or the reverse order
+ *                       for #AFSTFT_TIME_CH_BANDS
+ */
+void afSTFTforwardFrame(/* Input Arguments */
+                        void* handle,
+                        float** inTD,
+                        int framesize,
+                        int nChBuffer,
+                        AFSTFT_FDDATA_FORMAT format,
+                        /* Output Arguments */
+                        float_complex* outFD);
+
+/**
+ * Applies the backward afSTFT transform to a frame of several hops, reading
+ * the input directly from a float_complex buffer of the requested format
+ *
+ * @note The number of processed channels is "outChannels" (as given to
+ *       afSTFTinit() or afSTFTchannelChange()).
+ *
+ * Unit test(s): test__afSTFTframe()
+ *
+ * @param[in]  handle    afSTFTlib handle
+ * @param[in]  inFD      Input time-frequency domain signals; FLAT: nBands x
+ *                       nChBuffer x (framesize/hopSize), or the reverse order
+ *                       for #AFSTFT_TIME_CH_BANDS
+ * @param[in]  framesize Frame size, in samples; must be a multiple of hopSize
+ * @param[in]  nChBuffer Channel dimension of inFD (>= outChannels)
+ * @param[in]  format    Storage format of inFD, see #AFSTFT_FDDATA_FORMAT
+ * @param[out] outTD     Output time-domain signals; outChannels x framesize
+ */
+void afSTFTinverseFrame(/* Input Arguments */
+                        void* handle,
+                        float_complex* inFD,
+                        int framesize,
+                        int nChBuffer,
+                        AFSTFT_FDDATA_FORMAT format,
+                        /* Output Arguments */
+                        float** outTD);
+#endif
+
+/**
+ * Computes the afSTFT band centre frequencies, for any hop size and sampling
+ * rate
+ *
+ * For a hop size of 128 (with hybrid-mode enabled) at 44.1kHz or 48kHz, the
+ * tabulated centre frequencies (__afCenterFreq44100/__afCenterFreq48e3) are
+ * returned. Otherwise, the nominal centre frequencies are computed; i.e. bin k
+ * of the STFT is centred at k*fs/(2*hopSize), and (in hybrid-mode) bins 1 to 4
+ * are each split into two half-bands.
+ *
+ * @param[in]  hopSize    Hop size, in samples
+ * @param[in]  hybridMode '0' disabled hybrid-mode, '1' enabled
+ * @param[in]  fs         Sampling rate, in Hz
+ * @param[out] freqVector Centre frequencies, in Hz; (hopSize+5) x 1 if
+ *                        hybridMode=1, or (hopSize+1) x 1 otherwise
+ */
+void afSTFTgetCenterFreqs(/* Input Arguments */
+                          int hopSize,
+                          int hybridMode,
+                          float fs,
+                          /* Output Arguments */
+                          float* freqVector);
+
+/**
+ * Returns the algorithmic delay of the afSTFT (forward followed by inverse), in
+ * samples
+ *
+ * The delay is 9 hops in the default mode, and 4 hops in the low-delay mode
+ * (LDmode), which uses an asymmetric prototype filter (at the cost of a
+ * somewhat larger reconstruction error). The hybrid filtering adds another 3
+ * hops.
+ *
+ * @param[in] hopSize    Hop size, in samples
+ * @param[in] LDmode     '0' disabled low-delay mode, '1' enabled
+ * @param[in] hybridMode '0' disabled hybrid-mode, '1' enabled
+ * @returns the delay, in samples
+ */
+int afSTFTgetProcessingDelay(/* Input Arguments */
+                             int hopSize,
+                             int LDmode,
+                             int hybridMode);
+
 /**
  * Destroys an instance of afSTFTlib
  *
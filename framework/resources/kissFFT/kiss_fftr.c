@@ -65,6 +65,29 @@ kiss_fftr_cfg kiss_fftr_alloc(int nfft,int inverse_fft,void * mem,size_t * lenme
     return st;
 }
 
+kiss_fftr_cfg kiss_fftr_alloc_shared(kiss_fftr_cfg shared,void * mem,size_t * lenmem)
+{
+    kiss_fftr_cfg st = NULL;
+    size_t memneeded;
+
+    memneeded = sizeof(struct kiss_fftr_state) + sizeof(kiss_fft_cpx) * (shared->substate->nfft);
+
+    if (lenmem == NULL) {
+        st = (kiss_fftr_cfg) KISS_FFT_MALLOC (memneeded);
+    } else {
+        if (*lenmem >= memneeded)
+            st = (kiss_fftr_cfg) mem;
+        *lenmem = memneeded;
+    }
+    if (!st)
+        return NULL;
+
+    st->substate = shared->substate;
+    st->tmpbuf = (kiss_fft_cpx *) (st + 1); /*just beyond kiss_fftr_state struct */
+    st->super_twiddles = shared->super_twiddles;
+    return st;
+}
+
 void kiss_fftr(kiss_fftr_cfg st,const kiss_fft_scalar *timedata,kiss_fft_cpx *freqdata)
 {
     /* input buffer timedata is stored row-wise */
@@ -42,6 +42,14 @@ kiss_fftr_cfg kiss_fftr_alloc(int nfft,int inverse_fft,void * mem, size_t * lenm
  If you don't care to allocate space, use mem = lenmem = NULL 
 */
 
+kiss_fftr_cfg kiss_fftr_alloc_shared(kiss_fftr_cfg shared,void * mem, size_t * lenmem);
+/*
+ Allocates a state which references the (read-only) twiddles of 'shared', and
+ only owns its own scratch buffer. Multiple such states may therefore be used
+ concurrently, while the twiddles are computed/stored only once. 'shared' must
+ outlive the returned state. (SAF addition)
+*/
+
 
 void kiss_fftr(kiss_fftr_cfg cfg,const kiss_fft_scalar *timedata,kiss_fft_cpx *freqdata);
 /*
@@ -55,6 +55,14 @@
 # define MAX(a,b) (( (a) > (b) ) ? (a) : (b))
 #endif
 
+/**
+ * Size of the pointer table(s) of the 2-D/3-D arrays, rounded up to a multiple
+ * of MD_MALLOC_DATA_ALIGNMENT bytes; so that the data which follows retains
+ * the alignment of the allocation itself (rather than only that of a pointer)
+ */
+#define MD_HEADER_SIZE(nBytes) \
+    ( ((nBytes) + MD_MALLOC_DATA_ALIGNMENT - 1) & ~((size_t)MD_MALLOC_DATA_ALIGNMENT - 1) )
+
 void* malloc1d(size_t dim1_data_size)
 {
     void *ptr = malloc(dim1_data_size);
@@ -87,17 +95,18 @@ void* realloc1d(void* ptr, size_t dim1_data_size)
 
 void** malloc2d(size_t dim1, size_t dim2, size_t data_size)
 {
-    size_t i, stride;
+    size_t i, hdr, stride;
     void** ptr;
     unsigned char* p2;
     stride = dim2*data_size;
-    ptr = malloc(dim1*sizeof(void*) + dim1*stride);
+    hdr = MD_HEADER_SIZE(dim1*sizeof(void*));
+    ptr = malloc(hdr + dim1*stride);
 #ifndef NDEBUG
     if(ptr==NULL)
-        fprintf(stderr, "Error: 'malloc2d' failed to allocate %zu bytes.\n", dim1*sizeof(void*) + dim1*stride);
+        fprintf(stderr, "Error: 'malloc2d' failed to allocate %zu bytes.\n", hdr + dim1*stride);
 #endif
     assert(ptr!=NULL);
-    p2 = (unsigned char*)(ptr + dim1);
+    p2 = (unsigned char*)ptr + hdr;
     for(i=0; i<dim1; i++)
         ptr[i] = &p2[i*stride];
     return ptr;
@@ -105,17 +114,18 @@ void** malloc2d(size_t dim1, size_t dim2, size_t data_size)
 
 void** calloc2d(size_t dim1, size_t dim2, size_t data_size)
 {
-    size_t i, stride;
+    size_t i, hdr, stride;
     void** ptr;
     unsigned char* p2;
     stride = dim2*data_size;
-    ptr = calloc(dim1, sizeof(void*) + stride);
+    hdr = MD_HEADER_SIZE(dim1*sizeof(void*));
+    ptr = calloc(1, hdr + dim1*stride);
 #ifndef NDEBUG
     if(ptr==NULL)
-        fprintf(stderr, "Error: 'calloc2d' failed to allocate %zu bytes.\n", dim1*sizeof(void*) + dim1*stride);
+        fprintf(stderr, "Error: 'calloc2d' failed to allocate %zu bytes.\n", hdr + dim1*stride);
 #endif
     assert(ptr!=NULL);
-    p2 = (unsigned char*)(ptr + dim1);
+    p2 = (unsigned char*)ptr + hdr;
     for(i=0; i<dim1; i++)
         ptr[i] = &p2[i*stride];
     return ptr;
@@ -123,16 +133,17 @@ void** calloc2d(size_t dim1, size_t dim2, size_t data_size)
 
 void** realloc2d(void** ptr, size_t dim1, size_t dim2, size_t data_size)
 {
-    size_t i, stride;
+    size_t i, hdr, stride;
     unsigned char* p2;
     stride = dim2*data_size;
-    ptr = realloc(ptr, dim1*sizeof(void*) + dim1*stride);
+    hdr = MD_HEADER_SIZE(dim1*sizeof(void*));
+    ptr = realloc(ptr, hdr + dim1*stride);
 #ifndef NDEBUG
     if(ptr==NULL)
-        fprintf(stderr, "Error: 'realloc2d' failed to allocate %zu bytes.\n", dim1*sizeof(void*) + dim1*stride);
+        fprintf(stderr, "Error: 'realloc2d' failed to allocate %zu bytes.\n", hdr + dim1*stride);
 #endif
     assert(ptr!=NULL);
-    p2 = (unsigned char*)(ptr + dim1);
+    p2 = (unsigned char*)ptr + hdr;
     for(i=0;i<dim1;i++)
         ptr[i] = &p2[i*stride];
     return ptr;
@@ -140,7 +151,7 @@ void** realloc2d(void** ptr, size_t dim1, size_t dim2, size_t data_size)
 
 void** realloc2d_r(void** ptr, size_t new_dim1, size_t new_dim2, size_t prev_dim1, size_t prev_dim2, size_t data_size)
 {
-    size_t i, stride;
+    size_t i, hdr, stride;
     void** prev_data;
 
     /* Copy previous data */
@@ -150,13 +161,14 @@ void** realloc2d_r(void** ptr, size_t new_dim1, size_t new_dim2, size_t prev_dim
     /* Resize */
     unsigned char* p2;
     stride = new_dim2*data_size;
-    ptr = realloc(ptr, new_dim1*sizeof(void*) + new_dim1*stride);
+    hdr = MD_HEADER_SIZE(new_dim1*sizeof(void*));
+    ptr = realloc(ptr, hdr + new_dim1*stride);
 #ifndef NDEBUG
     if(ptr==NULL)
-        fprintf(stderr, "Error: 'realloc2d' failed to allocate %zu bytes.\n", new_dim1*sizeof(void*) + new_dim1*stride);
+        fprintf(stderr, "Error: 'realloc2d' failed to allocate %zu bytes.\n", hdr + new_dim1*stride);
 #endif
     assert(ptr!=NULL);
-    p2 = (unsigned char*)(ptr + new_dim1);
+    p2 = (unsigned char*)ptr + hdr;
     for(i=0;i<new_dim1;i++)
         ptr[i] = &p2[i*stride];
 
@@ -169,20 +181,21 @@ void** realloc2d_r(void** ptr, size_t new_dim1, size_t new_dim2, size_t prev_dim
 
 void*** malloc3d(size_t dim1, size_t dim2, size_t dim3, size_t data_size)
 {
-    size_t i, j, stride1, stride2;
+    size_t i, j, hdr, stride1, stride2;
     void*** ptr;
     void** p2;
     unsigned char* p3;
     stride1 = dim2*dim3*data_size;
     stride2 = dim3*data_size;
-    ptr = malloc(dim1*sizeof(void**) + dim1*dim2*sizeof(void*) + dim1*stride1);
+    hdr = MD_HEADER_SIZE(dim1*sizeof(void**) + dim1*dim2*sizeof(void*));
+    ptr = malloc(hdr + dim1*stride1);
 #ifndef NDEBUG
     if(ptr==NULL)
-        fprintf(stderr, "Error: 'malloc3d' failed to allocate %zu bytes.\n", dim1*sizeof(void**) + dim1*dim2*sizeof(void*) + dim1*stride1);
+        fprintf(stderr, "Error: 'malloc3d' failed to allocate %zu bytes.\n", hdr + dim1*stride1);
 #endif
     assert(ptr!=NULL);
     p2 = (void**)(ptr + dim1);
-    p3 = (unsigned char*)(p2 + dim1*dim2);
+    p3 = (unsigned char*)ptr + hdr;
     for(i=0;i<dim1;i++)
         ptr[i] = &p2[i*dim2];
     for(i=0;i<dim1;i++)
@@ -193,20 +206,21 @@ void*** malloc3d(size_t dim1, size_t dim2, size_t dim3, size_t data_size)
 
 void*** calloc3d(size_t dim1, size_t dim2, size_t dim3, size_t data_size)
 {
-    size_t i, j, stride1, stride2;
+    size_t i, j, hdr, stride1, stride2;
     void*** ptr;
     void** p2;
     unsigned char* p3;
     stride1 = dim2*dim3*data_size;
     stride2 = dim3*data_size;
-    ptr = calloc(dim1, sizeof(void**) + dim2*sizeof(void*) + stride1);
+    hdr = MD_HEADER_SIZE(dim1*sizeof(void**) + dim1*dim2*sizeof(void*));
+    ptr = calloc(1, hdr + dim1*stride1);
 #ifndef NDEBUG
     if(ptr==NULL)
-        fprintf(stderr, "Error: 'calloc3d' failed to allocate %zu bytes.\n", dim1*sizeof(void**) + dim1*dim2*sizeof(void*) + dim1*stride1);
+        fprintf(stderr, "Error: 'calloc3d' failed to allocate %zu bytes.\n", hdr + dim1*stride1);
 #endif
     assert(ptr!=NULL);
     p2 = (void**)(ptr + dim1);
-    p3 = (unsigned char*)(p2 + dim1*dim2);
+    p3 = (unsigned char*)ptr + hdr;
     for(i=0;i<dim1;i++)
         ptr[i] = &p2[i*dim2];
     for(i=0;i<dim1;i++)
@@ -217,19 +231,20 @@ void*** calloc3d(size_t dim1, size_t dim2, size_t dim3, size_t data_size)
 
 void*** realloc3d(void*** ptr, size_t new_dim1, size_t new_dim2, size_t new_dim3, size_t data_size)
 {
-    size_t i, j, stride1, stride2;
+    size_t i, j, hdr, stride1, stride2;
     void** p2;
     unsigned char* p3;
     stride1 = new_dim2*new_dim3*data_size;
     stride2 = new_dim3*data_size;
-    ptr = realloc(ptr, new_dim1*sizeof(void**) + new_dim1*new_dim2*sizeof(void*) + new_dim1*stride1);
+    hdr = MD_HEADER_SIZE(new_dim1*sizeof(void**) + new_dim1*new_dim2*sizeof(void*));
+    ptr = realloc(ptr, hdr + new_dim1*stride1);
 #ifndef NDEBUG
     if(ptr==NULL)
-        fprintf(stderr, "Error: 'realloc3d' failed to allocate %zu bytes.\n", new_dim1*sizeof(void**) + new_dim1*new_dim2*sizeof(void*) + new_dim1*stride1);
+        fprintf(stderr, "Error: 'realloc3d' failed to allocate %zu bytes.\n", hdr + new_dim1*stride1);
 #endif
     assert(ptr!=NULL);
     p2 = (void**)(ptr + new_dim1);
-    p3 = (unsigned char*)(p2 + new_dim1*new_dim2);
+    p3 = (unsigned char*)ptr + hdr;
     for(i=0;i<new_dim1;i++)
         ptr[i] = &p2[i*new_dim2];
     for(i=0;i<new_dim1;i++)
@@ -240,7 +255,7 @@ void*** realloc3d(void*** ptr, size_t new_dim1, size_t new_dim2, size_t new_dim3
 
 void*** realloc3d_r(void*** ptr, size_t new_dim1, size_t new_dim2, size_t new_dim3, size_t prev_dim1, size_t prev_dim2, size_t prev_dim3, size_t data_size)
 {
-    size_t i, j, stride1, stride2;
+    size_t i, j, hdr, stride1, stride2;
     void** p2;
     unsigned char* p3;
     void*** prev_data;
@@ -252,14 +267,15 @@ void*** realloc3d_r(void*** ptr, size_t new_dim1, size_t new_dim2, size_t new_di
     /* Resize */
     stride1 = new_dim2*new_dim3*data_size;
     stride2 = new_dim3*data_size;
-    ptr = realloc(ptr, new_dim1*sizeof(void**) + new_dim1*new_dim2*sizeof(void*) + new_dim1*stride1);
+    hdr = MD_HEADER_SIZE(new_dim1*sizeof(void**) + new_dim1*new_dim2*sizeof(void*));
+    ptr = realloc(ptr, hdr + new_dim1*stride1);
 #ifndef NDEBUG
     if(ptr==NULL)
-        fprintf(stderr, "Error: 'realloc3d' failed to allocate %zu bytes.\n", new_dim1*sizeof(void**) + new_dim1*new_dim2*sizeof(void*) + new_dim1*stride1);
+        fprintf(stderr, "Error: 'realloc3d' failed to allocate %zu bytes.\n", hdr + new_dim1*stride1);
 #endif
     assert(ptr!=NULL);
     p2 = (void**)(ptr + new_dim1);
-    p3 = (unsigned char*)(p2 + new_dim1*new_dim2);
+    p3 = (unsigned char*)ptr + hdr;
     for(i=0;i<new_dim1;i++)
         ptr[i] = &p2[i*new_dim2];
     for(i=0;i<new_dim1;i++)
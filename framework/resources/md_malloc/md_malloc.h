@@ -67,6 +67,13 @@ extern "C" {
  * of data
  */
 #define FLATTEN3D(A) (**A) /* || (&A[0][0][0]) */
+
+/**
+ * Alignment (in bytes) of the data of the 2-D/3-D arrays, relative to the start
+ * of the allocation (malloc guarantees at least this alignment on 64-bit
+ * platforms; so the data may be accessed with aligned SSE loads/stores)
+ */
+#define MD_MALLOC_DATA_ALIGNMENT ( 16 )
     
 /**
  * 1-D malloc (same as malloc, but with error checking)
@@ -0,0 +1,251 @@
+/*
+ * Copyright 2020 Leo McCormack
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR
+ * OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * @file saf_bench_afSTFT.c
+ * @brief Benchmarking program for the afSTFT filterbank
+ *
+ * For every combination of hop size, number of channels, hybrid-mode and
+ * low-delay mode (LDmode), the program reports:
+ *  - the cost of afSTFTforward() + afSTFTinverse(), in nanoseconds per sample
+ *    per channel
+ *  - the algorithmic delay of the analysis-synthesis chain (measured with an
+ *    impulse, and also as returned by afSTFTgetProcessingDelay())
+ *  - the reconstruction error, after compensating for this delay
+ *
+ * Usage: saf_bench_afSTFT [nChannels]  (by default, 1, 8 and 64 channels are
+ * benchmarked)
+ *
+ * @author Leo McCormack
+ * @date 16.10.2020
+ */
+
+#include "timer.h"   /* for timing the transforms */
+#include "saf.h"     /* master framework include header */
+
+/* ========================================================================== */
+/*                              Benchmark Config                              */
+/* ========================================================================== */
+
+/** Hop sizes to benchmark */
+static const int hopSizes[] = { 64, 128, 256, 512, 1024 };
+/** Default numbers of channels to benchmark */
+static const int numChannels[] = { 1, 8, 64 };
+/** Number of channel-samples to process for each timing measurement */
+#define BENCH_NUM_CH_SAMPLES ( 1<<20 )
+/** Sampling rate, which is only used to express the delay in ms */
+#define BENCH_FS ( 48000.0f )
+
+/* ========================================================================== */
+/*                                  Helpers                                   */
+/* ========================================================================== */
+
+/** afSTFT time-frequency buffers */
+typedef struct _benchTF {
+#ifdef AFSTFT_USE_FLOAT_COMPLEX
+    float_complex** data;   /**< nChannels x nBands */
+#else
+    complexVector* data;    /**< nChannels x 1 */
+#endif
+    int nChannels;          /**< Number of channels */
+}benchTF;
+
+/** Allocates the time-frequency buffers */
+static void benchTF_create(benchTF* tf, int nChannels, int nBands)
+{
+#ifdef AFSTFT_USE_FLOAT_COMPLEX
+    tf->data = (float_complex**)calloc2d(nChannels, nBands, sizeof(float_complex));
+#else
+    int ch;
+    tf->data = malloc1d(nChannels*sizeof(complexVector));
+    for(ch=0; ch<nChannels; ch++){
+        tf->data[ch].re = calloc1d(nBands, sizeof(float));
+        tf->data[ch].im = calloc1d(nBands, sizeof(float));
+    }
+#endif
+    tf->nChannels = nChannels;
+}
+
+/** Frees the time-frequency buffers */
+static void benchTF_destroy(benchTF* tf)
+{
+#ifndef AFSTFT_USE_FLOAT_COMPLEX
+    int ch;
+    for(ch=0; ch<tf->nChannels; ch++){
+        free(tf->data[ch].re);
+        free(tf->data[ch].im);
+    }
+#endif
+    free(tf->data);
+}
+
+/**
+ * Passes a single-channel signal through the afSTFT (forward then inverse),
+ * hop-by-hop; the signal length must be a multiple of the hop size
+ */
+static void bench_analysisSynthesis(int hopSize, int LDmode, int hybridMode,
+                                    float* in, float* out, int lSig)
+{
+    int hop;
+    void* hSTFT;
+    float* inHop, *outHop;
+    benchTF tf;
+
+    afSTFTinit(&hSTFT, hopSize, 1, 1, LDmode, hybridMode);
+    benchTF_create(&tf, 1, hopSize + (hybridMode ? 5 : 1));
+    for(hop=0; hop<lSig/hopSize; hop++){
+        inHop = &in[hop*hopSize];
+        outHop = &out[hop*hopSize];
+        afSTFTforward(hSTFT, &inHop, tf.data);
+        afSTFTinverse(hSTFT, tf.data, &outHop);
+    }
+    afSTFTfree(hSTFT);
+    benchTF_destroy(&tf);
+}
+
+/** Returns the delay (in samples) of the afSTFT, measured with an impulse */
+static int bench_measureDelay(int hopSize, int LDmode, int hybridMode)
+{
+    int i, delay, lSig;
+    float* in, *out, peak;
+
+    lSig = 24*hopSize;
+    in = calloc1d(lSig, sizeof(float));
+    out = calloc1d(lSig, sizeof(float));
+    in[0] = 1.0f;
+    bench_analysisSynthesis(hopSize, LDmode, hybridMode, in, out, lSig);
+    delay = 0;
+    peak = 0.0f;
+    for(i=0; i<lSig; i++){
+        if(fabsf(out[i])>peak){
+            peak = fabsf(out[i]);
+            delay = i;
+        }
+    }
+    free(in);
+    free(out);
+    return delay;
+}
+
+/**
+ * Returns the reconstruction error (in dB, relative to the input energy) for a
+ * white noise input, after compensating for the given delay
+ */
+static float bench_reconstructionError(int hopSize, int LDmode, int hybridMode, int delay)
+{
+    int i, lSig, lCompare;
+    float* in, *out;
+    double errEnergy, sigEnergy;
+
+    lCompare = 256*hopSize;
+    lSig = lCompare + (delay/hopSize + 1)*hopSize;
+    in = calloc1d(lSig, sizeof(float));
+    out = calloc1d(lSig, sizeof(float));
+    rand_m1_1(in, lCompare);
+    bench_analysisSynthesis(hopSize, LDmode, hybridMode, in, out, lSig);
+    errEnergy = sigEnergy = 0.0;
+    for(i=0; i<lCompare; i++){
+        errEnergy += pow((double)(out[i+delay] - in[i]), 2.0);
+        sigEnergy += pow((double)in[i], 2.0);
+    }
+    free(in);
+    free(out);
+    return (float)(10.0*log10(errEnergy/sigEnergy + 2.23e-20));
+}
+
+/**
+ * Returns the cost of afSTFTforward() + afSTFTinverse(), in nanoseconds per
+ * sample per channel
+ */
+static double bench_timeTransforms(int hopSize, int nChannels, int LDmode, int hybridMode)
+{
+    int hop, nHops, nWarmUp;
+    void* hSTFT;
+    float** inHop, **outHop;
+    benchTF tf;
+    tick_t start;
+    double elapsed;
+
+    nHops = MAX(BENCH_NUM_CH_SAMPLES/(hopSize*nChannels), 16);
+    nWarmUp = 8;
+    afSTFTinit(&hSTFT, hopSize, nChannels, nChannels, LDmode, hybridMode);
+    benchTF_create(&tf, nChannels, hopSize + (hybridMode ? 5 : 1));
+    inHop = (float**)malloc2d(nChannels, hopSize, sizeof(float));
+    outHop = (float**)malloc2d(nChannels, hopSize, sizeof(float));
+    rand_m1_1(FLATTEN2D(inHop), nChannels*hopSize);
+
+    for(hop=0; hop<nWarmUp; hop++){
+        afSTFTforward(hSTFT, inHop, tf.data);
+        afSTFTinverse(hSTFT, tf.data, outHop);
+    }
+    start = timer_current();
+    for(hop=0; hop<nHops; hop++){
+        afSTFTforward(hSTFT, inHop, tf.data);
+        afSTFTinverse(hSTFT, tf.data, outHop);
+    }
+    elapsed = (double)timer_elapsed(start);
+
+    afSTFTfree(hSTFT);
+    benchTF_destroy(&tf);
+    free(inHop);
+    free(outHop);
+    return elapsed*1e9/((double)nHops*(double)hopSize*(double)nChannels);
+}
+
+/* ========================================================================== */
+/*                               Main Program                                 */
+/* ========================================================================== */
+
+int main(int argc, char* argv[])
+{
+    int h, c, hybridMode, LDmode, delay, nChannelsToTest, nCh;
+    float err_dB;
+    double ns;
+
+    nChannelsToTest = (int)(sizeof(numChannels)/sizeof(int));
+    nCh = argc > 1 ? atoi(argv[1]) : 0;
+    if(nCh>0)
+        nChannelsToTest = 1;
+
+    printf("%s", SAF_VERSION_BANNER);
+    printf("Benchmarking the afSTFT filterbank (forward + inverse):\n\n");
+    printf("  hop | hybrid | LD | delay (meas/nominal) | delay ms @48k | recon. err dB |");
+    for(c=0; c<nChannelsToTest; c++)
+        printf(" ns/smp/ch (%2d ch) |", nCh>0 ? nCh : numChannels[c]);
+    printf("\n");
+
+    timer_lib_initialize();
+    for(h=0; h<(int)(sizeof(hopSizes)/sizeof(int)); h++){
+        for(hybridMode=0; hybridMode<2; hybridMode++){
+            for(LDmode=0; LDmode<2; LDmode++){
+                delay = bench_measureDelay(hopSizes[h], LDmode, hybridMode);
+                err_dB = bench_reconstructionError(hopSizes[h], LDmode, hybridMode, delay);
+                printf(" %4d |   %s  | %s | %8d / %-8d  | %13.2f | %13.1f |",
+                       hopSizes[h], hybridMode ? "on " : "off", LDmode ? "on " : "off",
+                       delay, afSTFTgetProcessingDelay(hopSizes[h], LDmode, hybridMode),
+                       1e3f*(float)delay/BENCH_FS, err_dB);
+                for(c=0; c<nChannelsToTest; c++){
+                    ns = bench_timeTransforms(hopSizes[h], nCh>0 ? nCh : numChannels[c], LDmode, hybridMode);
+                    printf(" %17.2f |", ns);
+                }
+                printf("\n");
+            }
+        }
+    }
+    timer_lib_shutdown();
+
+    return 0;
+}
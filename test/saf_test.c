@@ -90,11 +90,23 @@ int main_test(void) {
     RUN_TEST(test__ims_shoebox_RIR);
     RUN_TEST(test__ims_shoebox_TD);
     RUN_TEST(test__saf_rfft);
+    RUN_TEST(test__saf_rfft_batch);
+    RUN_TEST(test__saf_fft_planCache);
+    RUN_TEST(test__saf_rfft_split);
     RUN_TEST(test__saf_matrixConv);
+    RUN_TEST(test__saf_matrixConv_partitioned);
+    RUN_TEST(test__saf_matrixConv_swapFilters);
+    RUN_TEST(test__saf_matrixConv_swapFiltersThreaded);
+    RUN_TEST(test__saf_matrixConv_sparse);
+    RUN_TEST(test__saf_blockAdaptor);
+    RUN_TEST(test__saf_blockAdaptor_strided);
+    RUN_TEST(test__saf_stateSwap);
 #ifdef AFSTFT_USE_FLOAT_COMPLEX
     RUN_TEST(test__afSTFTMatrix);
 #endif
     RUN_TEST(test__afSTFT);
+    RUN_TEST(test__afSTFT_LDmode);
+    RUN_TEST(test__afSTFTframe);
     RUN_TEST(test__smb_pitchShifter);
     RUN_TEST(test__sortf);
     RUN_TEST(test__sortz);
@@ -102,13 +114,25 @@ int main_test(void) {
     RUN_TEST(test__getVoronoiWeights);
     RUN_TEST(test__unique_i);
     RUN_TEST(test__realloc2d_r);
+    RUN_TEST(test__utility_cvvmuladd);
+    RUN_TEST(test__utility_simdKernels);
+    RUN_TEST(test__utility_svvmulfold);
+    RUN_TEST(test__utility_lapackWorkspaces);
+    RUN_TEST(test__utility_batchSolvers);
+    RUN_TEST(test__utility_transposeFreeSolvers);
     RUN_TEST(test__formulate_M_and_Cr);
     RUN_TEST(test__formulate_M_and_Cr_cmplx);
     RUN_TEST(test__getLoudspeakerDecoderMtx);
     RUN_TEST(test__getSHreal);
     RUN_TEST(test__getSHreal_recur);
+    RUN_TEST(test__saf_shEvaluator);
+    RUN_TEST(test__saf_shGridCache);
+    RUN_TEST(test__saf_pmapEngine);
     RUN_TEST(test__getSHcomplex);
     RUN_TEST(test__getSHrotMtxReal);
+    RUN_TEST(test__getSHrotMtxRealBlocks);
+    RUN_TEST(test__applySHblockMtx);
+    RUN_TEST(test__quaternion);
     RUN_TEST(test__real2complexSHMtx);
     RUN_TEST(test__complex2realSHMtx);
     RUN_TEST(test__computeSectorCoeffsEP);
@@ -118,6 +142,9 @@ int main_test(void) {
 #ifdef SAF_ENABLE_EXAMPLES_TESTS
     RUN_TEST(test__saf_example_ambi_bin);
     RUN_TEST(test__saf_example_ambi_dec);
+    RUN_TEST(test__saf_example_frameSizes);
+    RUN_TEST(test__saf_example_beamformer);
+    RUN_TEST(test__saf_example_powermap);
     RUN_TEST(test__saf_example_ambi_enc);
     RUN_TEST(test__saf_example_array2sh);
     RUN_TEST(test__saf_example_rotator);
@@ -427,6 +454,615 @@ void test__saf_matrixConv(void){
     saf_matrixConv_destroy(&hMatrixConv);
 }
 
+void test__saf_matrixConv_partitioned(void){
+    int i, j, k, no, ni, frame, usePart;
+    float** inputTD, **outputTD, **refTD, **inputFrameTD, **outputFrameTD;
+    float*** filters;
+    void* hMatrixConv, *hMultiConv;
+
+    /* config */
+    const float acceptedTolerance = 0.0001f;
+    const int signalLength = 8192;
+    const int hostBlockSize = 128;
+    const int filterLength = 3000;
+    const int nInputs = 4;
+    const int nOutputs = 3;
+
+    /* prep */
+    inputTD = (float**)malloc2d(nInputs, signalLength, sizeof(float));
+    outputTD = (float**)malloc2d(nOutputs, signalLength, sizeof(float));
+    refTD = (float**)calloc2d(nOutputs, signalLength, sizeof(float));
+    inputFrameTD = (float**)malloc2d(nInputs, hostBlockSize, sizeof(float));
+    outputFrameTD = (float**)calloc2d(nOutputs, hostBlockSize, sizeof(float));
+    filters = (float***)malloc3d(nOutputs, nInputs, filterLength, sizeof(float));
+    rand_m1_1(FLATTEN3D(filters), nOutputs*nInputs*filterLength);
+    rand_m1_1(FLATTEN2D(inputTD), nInputs*signalLength);
+    utility_svsmul(FLATTEN3D(filters), &(float){0.02f}, nOutputs*nInputs*filterLength, NULL);
+
+    /* Reference: time-domain convolution, truncated to the signal length */
+    for(no=0; no<nOutputs; no++)
+        for(ni=0; ni<nInputs; ni++)
+            for(i=0; i<signalLength; i++)
+                for(k=0; k<filterLength && k<=i; k++)
+                    refTD[no][i] += filters[no][ni][k] * inputTD[ni][i-k];
+
+    /* Matrix convolver; non-partitioned, uniformly and non-uniformly partitioned */
+    for(usePart=0; usePart<4; usePart++){
+        saf_matrixConv_create(&hMatrixConv, hostBlockSize, FLATTEN3D(filters), filterLength,
+                              nInputs, nOutputs, usePart);
+        for(frame = 0; frame<(int)signalLength/hostBlockSize; frame++){
+            for(i = 0; i<nInputs; i++)
+                memcpy(inputFrameTD[i], &inputTD[i][frame*hostBlockSize], hostBlockSize*sizeof(float));
+            saf_matrixConv_apply(hMatrixConv, FLATTEN2D(inputFrameTD), FLATTEN2D(outputFrameTD));
+            for(i = 0; i<nOutputs; i++)
+                memcpy(&outputTD[i][frame*hostBlockSize], outputFrameTD[i], hostBlockSize*sizeof(float));
+        }
+        for(i=0; i<nOutputs; i++)
+            for(j=0; j<signalLength; j++)
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, refTD[i][j], outputTD[i][j]);
+        saf_matrixConv_destroy(&hMatrixConv);
+    }
+
+    /* Multi-channel convolver (using the filters of the first output) */
+    for(usePart=0; usePart<4; usePart++){
+        saf_multiConv_create(&hMultiConv, hostBlockSize, FLATTEN2D(filters[0]), filterLength,
+                             MIN(nInputs, nOutputs), usePart);
+        for(frame = 0; frame<(int)signalLength/hostBlockSize; frame++){
+            for(i = 0; i<MIN(nInputs, nOutputs); i++)
+                memcpy(inputFrameTD[i], &inputTD[i][frame*hostBlockSize], hostBlockSize*sizeof(float));
+            saf_multiConv_apply(hMultiConv, FLATTEN2D(inputFrameTD), FLATTEN2D(outputFrameTD));
+            for(i = 0; i<MIN(nInputs, nOutputs); i++)
+                memcpy(&outputTD[i][frame*hostBlockSize], outputFrameTD[i], hostBlockSize*sizeof(float));
+        }
+        for(i=0; i<MIN(nInputs, nOutputs); i++){
+            memset(refTD[i], 0, signalLength*sizeof(float));
+            for(j=0; j<signalLength; j++)
+                for(k=0; k<filterLength && k<=j; k++)
+                    refTD[i][j] += filters[0][i][k] * inputTD[i][j-k];
+            for(j=0; j<signalLength; j++)
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, refTD[i][j], outputTD[i][j]);
+        }
+        saf_multiConv_destroy(&hMultiConv);
+    }
+
+    /* Clean-up */
+    free(inputTD);
+    free(outputTD);
+    free(refTD);
+    free(inputFrameTD);
+    free(outputFrameTD);
+    free(filters);
+}
+
+void test__saf_matrixConv_swapFilters(void){
+    int i, j, k, no, ni, frame, usePart, multiFLAG, nIn, nOut, nCH;
+    float** inputTD, **outputTD, **inputFrameTD, **outputFrameTD;
+    float*** refTD, **filters, *H0, *H1;
+    void* hConv, *hFilters, *hFilters2;
+
+    /* config */
+    const float acceptedTolerance = 0.0001f;
+    const int signalLength = 16384;
+    const int hostBlockSize = 128;
+    const int filterLength = 1000;
+    const int nInputs = 2;
+    const int nOutputs = 2;
+    const int swapFrame = 32;
+    const int fadeLength = 512;
+    const int settledFrom = swapFrame*hostBlockSize + fadeLength + 4*filterLength;
+
+    /* prep */
+    inputTD = (float**)malloc2d(nInputs, signalLength, sizeof(float));
+    outputTD = (float**)malloc2d(nOutputs, signalLength, sizeof(float));
+    refTD = (float***)malloc3d(2, nOutputs, signalLength, sizeof(float));
+    inputFrameTD = (float**)malloc2d(nInputs, hostBlockSize, sizeof(float));
+    outputFrameTD = (float**)calloc2d(nOutputs, hostBlockSize, sizeof(float));
+    filters = (float**)malloc2d(2, nOutputs*nInputs*filterLength, sizeof(float)); /* old/new; FLAT: nOutputs x nInputs x filterLength */
+    H0 = malloc1d(nOutputs*filterLength*sizeof(float));
+    H1 = malloc1d(nOutputs*filterLength*sizeof(float));
+    rand_m1_1(FLATTEN2D(filters), 2*nOutputs*nInputs*filterLength);
+    rand_m1_1(FLATTEN2D(inputTD), nInputs*signalLength);
+    utility_svsmul(FLATTEN2D(filters), &(float){0.02f}, 2*nOutputs*nInputs*filterLength, NULL);
+
+    for(multiFLAG=0; multiFLAG<2; multiFLAG++){
+        nIn = multiFLAG ? 1 : nInputs;
+        nOut = nOutputs;
+        nCH = multiFLAG ? MIN(nInputs, nOutputs) : nInputs;
+
+        /* Reference: time-domain convolution with the old (0) and new (1) filters */
+        memset(FLATTEN3D(refTD), 0, 2*nOutputs*signalLength*sizeof(float));
+        for(k=0; k<2; k++)
+            for(no=0; no<nOut; no++)
+                for(ni=0; ni<nIn; ni++)
+                    for(i=0; i<signalLength; i++)
+                        for(j=0; j<filterLength && j<=i; j++)
+                            refTD[k][no][i] += filters[k][(no*nInputs+ni)*filterLength + j] * inputTD[multiFLAG ? no : ni][i-j];
+
+        /* Swap the filters part way through, for all convolution modes */
+        for(usePart=0; usePart<4; usePart++){
+            if(multiFLAG){
+                /* (using the filters of the first input) */
+                for(i=0; i<nCH; i++){
+                    memcpy(&H0[i*filterLength], &filters[0][i*nInputs*filterLength], filterLength*sizeof(float));
+                    memcpy(&H1[i*filterLength], &filters[1][i*nInputs*filterLength], filterLength*sizeof(float));
+                }
+                saf_multiConv_create(&hConv, hostBlockSize, H0, filterLength, nCH, usePart);
+                saf_multiConv_createFilters(hConv, H1, &hFilters);
+                saf_multiConv_createFilters(hConv, H1, &hFilters2);
+            }
+            else{
+                saf_matrixConv_create(&hConv, hostBlockSize, filters[0], filterLength,
+                                      nInputs, nOutputs, usePart);
+                saf_matrixConv_createFilters(hConv, filters[1], &hFilters);
+                saf_matrixConv_createFilters(hConv, filters[1], &hFilters2);
+            }
+            for(frame = 0; frame<(int)signalLength/hostBlockSize; frame++){
+                if(frame==swapFrame){
+                    /* Only one swap may be in progress at a time */
+                    TEST_ASSERT_TRUE(multiFLAG ? saf_multiConv_swapFilters(hConv, hFilters, fadeLength) :
+                                                 saf_matrixConv_swapFilters(hConv, hFilters, fadeLength));
+                    TEST_ASSERT_FALSE(multiFLAG ? saf_multiConv_swapFilters(hConv, hFilters2, fadeLength) :
+                                                  saf_matrixConv_swapFilters(hConv, hFilters2, fadeLength));
+                }
+                for(i = 0; i<nCH; i++)
+                    memcpy(inputFrameTD[i], &inputTD[i][frame*hostBlockSize], hostBlockSize*sizeof(float));
+                if(multiFLAG)
+                    saf_multiConv_apply(hConv, FLATTEN2D(inputFrameTD), FLATTEN2D(outputFrameTD));
+                else
+                    saf_matrixConv_apply(hConv, FLATTEN2D(inputFrameTD), FLATTEN2D(outputFrameTD));
+                for(i = 0; i<nOut; i++)
+                    memcpy(&outputTD[i][frame*hostBlockSize], outputFrameTD[i], hostBlockSize*sizeof(float));
+            }
+
+            /* The output should be that of the old filters prior to the swap,
+             * and that of the new filters once the crossfade has settled */
+            for(i=0; i<nOut; i++){
+                for(j=0; j<swapFrame*hostBlockSize; j++)
+                    TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, refTD[0][i][j], outputTD[i][j]);
+                for(j=settledFrom; j<signalLength; j++)
+                    TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, refTD[1][i][j], outputTD[i][j]);
+            }
+            if(multiFLAG){
+                saf_multiConv_releaseFilters(hConv);
+                saf_multiConv_destroyFilters(&hFilters2);
+                saf_multiConv_destroy(&hConv);
+            }
+            else{
+                saf_matrixConv_releaseFilters(hConv);
+                saf_matrixConv_destroyFilters(&hFilters2);
+                saf_matrixConv_destroy(&hConv);
+            }
+            TEST_ASSERT_TRUE(hFilters2==NULL);
+        }
+    }
+
+    /* Clean-up */
+    free(inputTD);
+    free(outputTD);
+    free(refTD);
+    free(inputFrameTD);
+    free(outputFrameTD);
+    free(filters);
+    free(H0);
+    free(H1);
+}
+
+void test__saf_matrixConv_swapFiltersThreaded(void){
+    int i, j, k, frame, lastSet, lastSwapFrame, settledFrom;
+    float** inputTD, **outputTD, **inputFrameTD, **outputFrameTD;
+    float*** refTD, **filters;
+    void* hConv, *hRef;
+    void** hFilters;
+
+    /* config */
+    const float acceptedTolerance = 0.0001f;
+    const int signalLength = 65536;
+    const int hostBlockSize = 64;
+    const int filterLength = 16384;
+    const int nInputs = 2;
+    const int nOutputs = 2;
+    const int nSwaps = 32;
+    const int swapEvery = 7;   /* hops */
+    const int fadeLength = 64;
+
+    /* prep */
+    inputTD = (float**)malloc2d(nInputs, signalLength, sizeof(float));
+    outputTD = (float**)malloc2d(nOutputs, signalLength, sizeof(float));
+    refTD = (float***)malloc3d(2, nOutputs, signalLength, sizeof(float));
+    inputFrameTD = (float**)malloc2d(nInputs, hostBlockSize, sizeof(float));
+    outputFrameTD = (float**)calloc2d(nOutputs, hostBlockSize, sizeof(float));
+    filters = (float**)malloc2d(2, nOutputs*nInputs*filterLength, sizeof(float)); /* FLAT: nOutputs x nInputs x filterLength */
+    hFilters = malloc1d(nSwaps*sizeof(void*));
+    rand_m1_1(FLATTEN2D(filters), 2*nOutputs*nInputs*filterLength);
+    rand_m1_1(FLATTEN2D(inputTD), nInputs*signalLength);
+    utility_svsmul(FLATTEN2D(filters), &(float){0.01f}, 2*nOutputs*nInputs*filterLength, NULL);
+
+    /* Reference: unthreaded non-uniformly partitioned convolution with each
+     * set of filters (see test__saf_matrixConv_partitioned()) */
+    for(k=0; k<2; k++){
+        saf_matrixConv_create(&hRef, hostBlockSize, filters[k], filterLength, nInputs, nOutputs, 2);
+        for(frame = 0; frame<(int)signalLength/hostBlockSize; frame++){
+            for(i = 0; i<nInputs; i++)
+                memcpy(inputFrameTD[i], &inputTD[i][frame*hostBlockSize], hostBlockSize*sizeof(float));
+            saf_matrixConv_apply(hRef, FLATTEN2D(inputFrameTD), FLATTEN2D(outputFrameTD));
+            for(i = 0; i<nOutputs; i++)
+                memcpy(&refTD[k][i][frame*hostBlockSize], outputFrameTD[i], hostBlockSize*sizeof(float));
+        }
+        saf_matrixConv_destroy(&hRef);
+    }
+
+    /* Threaded non-uniformly partitioned convolver. The filter sets are
+     * prepared in advance, and then swapped in (alternating between the two
+     * sets of filters, with and without a crossfade) and released every few
+     * hops, such that swaps occur while the jobs of the worker thread are
+     * still in flight */
+    saf_matrixConv_create(&hConv, hostBlockSize, filters[0], filterLength, nInputs, nOutputs, 3);
+    for(k=0; k<nSwaps; k++)
+        saf_matrixConv_createFilters(hConv, filters[(k+1)%2], &hFilters[k]);
+    k = 0;
+    lastSet = 0;
+    lastSwapFrame = -1;
+    for(frame = 0; frame<(int)signalLength/hostBlockSize; frame++){
+        saf_matrixConv_releaseFilters(hConv);
+        if(k<nSwaps && frame%swapEvery==0){
+            if(saf_matrixConv_swapFilters(hConv, hFilters[k], k%2==0 ? 0 : fadeLength)){
+                hFilters[k] = NULL; /* (now owned by the convolver) */
+                lastSet = (k+1)%2;
+                lastSwapFrame = frame;
+                k++;
+            }
+        }
+        for(i = 0; i<nInputs; i++)
+            memcpy(inputFrameTD[i], &inputTD[i][frame*hostBlockSize], hostBlockSize*sizeof(float));
+        saf_matrixConv_apply(hConv, FLATTEN2D(inputFrameTD), FLATTEN2D(outputFrameTD));
+        for(i = 0; i<nOutputs; i++)
+            memcpy(&outputTD[i][frame*hostBlockSize], outputFrameTD[i], hostBlockSize*sizeof(float));
+    }
+    TEST_ASSERT_TRUE(k==nSwaps);
+
+    /* The output should be that of the last filters swapped in, once settled */
+    settledFrom = (lastSwapFrame+1)*hostBlockSize + fadeLength + 2*filterLength;
+    TEST_ASSERT_TRUE(settledFrom<signalLength);
+    for(i=0; i<nOutputs; i++)
+        for(j=settledFrom; j<signalLength; j++)
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, refTD[lastSet][i][j], outputTD[i][j]);
+    saf_matrixConv_releaseFilters(hConv);
+    saf_matrixConv_destroy(&hConv);
+
+    /* Clean-up */
+    free(inputTD);
+    free(outputTD);
+    free(refTD);
+    free(inputFrameTD);
+    free(outputFrameTD);
+    free(filters);
+    free(hFilters);
+}
+
+void test__saf_matrixConv_sparse(void){
+    int i, j, k, no, ni, frame, usePart;
+    unsigned long long nComputed, nSkippedFilter, nSkippedInput;
+    float** inputTD, **outputTD, **refTD, **inputFrameTD, **outputFrameTD;
+    float*** filters;
+    void* hMatrixConv, *hMultiConv;
+
+    /* config */
+    const float acceptedTolerance = 0.0001f;
+    const int signalLength = 8192;
+    const int hostBlockSize = 128;
+    const int filterLength = 2000;
+    const int nInputs = 3;
+    const int nOutputs = 2;
+
+    /* prep */
+    inputTD = (float**)malloc2d(nInputs, signalLength, sizeof(float));
+    outputTD = (float**)malloc2d(nOutputs, signalLength, sizeof(float));
+    refTD = (float**)malloc2d(nOutputs, signalLength, sizeof(float));
+    inputFrameTD = (float**)malloc2d(nInputs, hostBlockSize, sizeof(float));
+    outputFrameTD = (float**)calloc2d(nOutputs, hostBlockSize, sizeof(float));
+    filters = (float***)malloc3d(nOutputs, nInputs, filterLength, sizeof(float));
+    rand_m1_1(FLATTEN3D(filters), nOutputs*nInputs*filterLength);
+    rand_m1_1(FLATTEN2D(inputTD), nInputs*signalLength);
+    utility_svsmul(FLATTEN3D(filters), &(float){0.02f}, nOutputs*nInputs*filterLength, NULL);
+
+    /* Sparse filters: output 0 does not use input 1, and the filters from
+     * input 0 are zero beyond 500 taps */
+    memset(filters[0][1], 0, filterLength*sizeof(float));
+    for(no=0; no<nOutputs; no++)
+        memset(&filters[no][0][500], 0, (filterLength-500)*sizeof(float));
+
+    /* Silent inputs: input 2 is silent throughout, and all inputs are silent
+     * for the first and fifth 1024 samples */
+    memset(inputTD[2], 0, signalLength*sizeof(float));
+    for(ni=0; ni<nInputs; ni++){
+        memset(inputTD[ni], 0, 1024*sizeof(float));
+        memset(&inputTD[ni][4096], 0, 1024*sizeof(float));
+    }
+
+    /* Matrix convolver */
+    memset(FLATTEN2D(refTD), 0, nOutputs*signalLength*sizeof(float));
+    for(no=0; no<nOutputs; no++)
+        for(ni=0; ni<nInputs; ni++)
+            for(i=0; i<signalLength; i++)
+                for(k=0; k<filterLength && k<=i; k++)
+                    refTD[no][i] += filters[no][ni][k] * inputTD[ni][i-k];
+    for(usePart=0; usePart<4; usePart++){
+        saf_matrixConv_create(&hMatrixConv, hostBlockSize, FLATTEN3D(filters), filterLength,
+                              nInputs, nOutputs, usePart);
+        for(frame = 0; frame<(int)signalLength/hostBlockSize; frame++){
+            for(i = 0; i<nInputs; i++)
+                memcpy(inputFrameTD[i], &inputTD[i][frame*hostBlockSize], hostBlockSize*sizeof(float));
+            saf_matrixConv_apply(hMatrixConv, FLATTEN2D(inputFrameTD), FLATTEN2D(outputFrameTD));
+            for(i = 0; i<nOutputs; i++)
+                memcpy(&outputTD[i][frame*hostBlockSize], outputFrameTD[i], hostBlockSize*sizeof(float));
+        }
+        for(i=0; i<nOutputs; i++)
+            for(j=0; j<signalLength; j++)
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, refTD[i][j], outputTD[i][j]);
+
+        /* Check that work was actually skipped */
+        saf_matrixConv_getCounters(hMatrixConv, &nComputed, &nSkippedFilter, &nSkippedInput);
+        TEST_ASSERT_TRUE(nComputed>0 && nSkippedFilter>0 && nSkippedInput>0);
+        saf_matrixConv_destroy(&hMatrixConv);
+    }
+
+    /* Multi-channel convolver (using the filters of the first output) */
+    for(no=0; no<nOutputs; no++){
+        memset(refTD[no], 0, signalLength*sizeof(float));
+        for(i=0; i<signalLength; i++)
+            for(k=0; k<filterLength && k<=i; k++)
+                refTD[no][i] += filters[0][no][k] * inputTD[no][i-k];
+    }
+    for(usePart=0; usePart<4; usePart++){
+        saf_multiConv_create(&hMultiConv, hostBlockSize, FLATTEN2D(filters[0]), filterLength, nOutputs, usePart);
+        for(frame = 0; frame<(int)signalLength/hostBlockSize; frame++){
+            for(i = 0; i<nOutputs; i++)
+                memcpy(inputFrameTD[i], &inputTD[i][frame*hostBlockSize], hostBlockSize*sizeof(float));
+            saf_multiConv_apply(hMultiConv, FLATTEN2D(inputFrameTD), FLATTEN2D(outputFrameTD));
+            for(i = 0; i<nOutputs; i++)
+                memcpy(&outputTD[i][frame*hostBlockSize], outputFrameTD[i], hostBlockSize*sizeof(float));
+        }
+        for(i=0; i<nOutputs; i++)
+            for(j=0; j<signalLength; j++)
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, refTD[i][j], outputTD[i][j]);
+        saf_multiConv_getCounters(hMultiConv, &nComputed, NULL, &nSkippedInput);
+        TEST_ASSERT_TRUE(nComputed>0 && nSkippedInput>0);
+        saf_multiConv_destroy(&hMultiConv);
+    }
+
+    /* Clean-up */
+    free(inputTD);
+    free(outputTD);
+    free(refTD);
+    free(inputFrameTD);
+    free(outputFrameTD);
+    free(filters);
+}
+
+/** Frame function for test__saf_blockAdaptor(); scales channel 'ch' by ch+1 */
+static void test__saf_blockAdaptor_frameFn(void* const userData, float** const inFrame,
+                                           float** const outFrame, int nInputs, int nOutputs){
+    int ch, i, frameSize;
+
+    frameSize = *(int*)userData;
+    for(ch=0; ch<nOutputs; ch++)
+        for(i=0; i<frameSize; i++)
+            outFrame[ch][i] = ch<nInputs ? (float)(ch+1)*inFrame[ch][i] : 0.0f;
+}
+
+void test__saf_blockAdaptor(void){
+    int i, ch, s, blockSize, mode, delay;
+    float** insig, **outsig, **inBlock, **outBlock;
+    void* hBA;
+
+    /* Config */
+    const float acceptedTolerance = 1e-7f;
+    int frameSize = 128;
+    const int maxInputs = 3;
+    const int maxOutputs = 2;
+    const int nInputs = 4;   /* one more than maxInputs */
+    const int nOutputs = 3;  /* one more than maxOutputs */
+    const int signalLength = 64*frameSize;
+    const int blockSizesToTest[6] = {1, 37, 128, 300, 512, 1000};
+
+    /* prep */
+    insig = (float**)malloc2d(nInputs, signalLength, sizeof(float));
+    outsig = (float**)malloc2d(nOutputs, signalLength, sizeof(float));
+    inBlock = malloc1d(nInputs*sizeof(float*));
+    outBlock = malloc1d(nOutputs*sizeof(float*));
+    rand_m1_1(FLATTEN2D(insig), nInputs*signalLength);
+    saf_blockAdaptor_create(&hBA, frameSize, maxInputs, maxOutputs);
+
+    /* mode 0: host block sizes which are multiples of the frame size (direct
+     * processing, no delay); mode 1: variable block sizes (FIFO, one frame of
+     * delay) */
+    for(mode=0; mode<2; mode++){
+        saf_blockAdaptor_reset(hBA);
+        memset(FLATTEN2D(outsig), 0, nOutputs*signalLength*sizeof(float));
+        for(s=0, i=0; s<signalLength; s+=blockSize, i++){
+            blockSize = mode==0 ? frameSize*(1+i%3) : blockSizesToTest[i%6];
+            blockSize = MIN(blockSize, signalLength-s);
+            for(ch=0; ch<nInputs; ch++)
+                inBlock[ch] = &insig[ch][s];
+            for(ch=0; ch<nOutputs; ch++)
+                outBlock[ch] = &outsig[ch][s];
+            saf_blockAdaptor_apply(hBA, inBlock, outBlock, nInputs, nOutputs, blockSize,
+                                   test__saf_blockAdaptor_frameFn, &frameSize);
+        }
+        delay = saf_blockAdaptor_getDelay(hBA);
+        TEST_ASSERT_TRUE(delay == (mode==0 ? 0 : frameSize));
+
+        /* Outputs should be the scaled and delayed inputs */
+        for(ch=0; ch<maxOutputs; ch++){
+            for(i=0; i<delay; i++)
+                TEST_ASSERT_EQUAL_FLOAT(0.0f, outsig[ch][i]);
+            for(i=delay; i<signalLength; i++)
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, (float)(ch+1)*insig[ch][i-delay], outsig[ch][i]);
+        }
+        /* Channels beyond maxOutputs should be zeroed */
+        for(i=0; i<signalLength; i++)
+            TEST_ASSERT_EQUAL_FLOAT(0.0f, outsig[maxOutputs][i]);
+    }
+
+    /* tidy-up */
+    saf_blockAdaptor_destroy(&hBA);
+    TEST_ASSERT_TRUE(hBA==NULL);
+    free(insig);
+    free(outsig);
+    free(inBlock);
+    free(outBlock);
+}
+
+void test__saf_blockAdaptor_strided(void){
+    int i, ch, s, blockSize, mode, delay, inPlace, nIn, nOut;
+    float* insig, *outsig;
+    void* hBA;
+
+    /* Config */
+    const float acceptedTolerance = 1e-7f;
+    int frameSize = 128;
+    const int maxInputs = 3;
+    const int maxOutputs = 2;
+    const int nInputs = 4;   /* one more than maxInputs */
+    const int nOutputs = 3;  /* one more than maxOutputs */
+    const int signalLength = 64*frameSize;
+    const int blockSizesToTest[6] = {1, 37, 128, 300, 512, 1000};
+
+    /* prep */
+    insig = malloc1d(nInputs*signalLength*sizeof(float));   /* interleaved */
+    outsig = malloc1d(nInputs*signalLength*sizeof(float));  /* interleaved */
+    saf_blockAdaptor_create(&hBA, frameSize, maxInputs, maxOutputs);
+
+    /* mode 0: block sizes which are multiples of the frame size (no delay);
+     * mode 1: variable block sizes (one frame of delay). The interleaved buffers
+     * are either separate, or processed in-place (with nInputs==nOutputs) */
+    for(inPlace=0; inPlace<2; inPlace++){
+        for(mode=0; mode<2; mode++){
+            nIn = nInputs;
+            nOut = inPlace ? nInputs : nOutputs;
+            rand_m1_1(insig, nIn*signalLength);
+            if(inPlace)
+                memcpy(outsig, insig, nIn*signalLength*sizeof(float));
+            else
+                memset(outsig, 0, nOut*signalLength*sizeof(float));
+            saf_blockAdaptor_reset(hBA);
+            for(s=0, i=0; s<signalLength; s+=blockSize, i++){
+                blockSize = mode==0 ? frameSize*(1+i%3) : blockSizesToTest[i%6];
+                blockSize = MIN(blockSize, signalLength-s);
+                saf_blockAdaptor_applyStrided(hBA, inPlace ? &outsig[s*nIn] : &insig[s*nIn], 1, nIn,
+                                              &outsig[s*nOut], 1, nOut, nIn, nOut, blockSize,
+                                              test__saf_blockAdaptor_frameFn, &frameSize);
+            }
+            delay = saf_blockAdaptor_getDelay(hBA);
+            TEST_ASSERT_TRUE(delay == (mode==0 ? 0 : frameSize));
+
+            /* Outputs should be the scaled and delayed inputs, and channels
+             * beyond maxOutputs should be zeroed */
+            for(ch=0; ch<nOut; ch++){
+                for(i=0; i<delay; i++)
+                    TEST_ASSERT_EQUAL_FLOAT(0.0f, outsig[i*nOut+ch]);
+                for(i=delay; i<signalLength; i++)
+                    TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, ch<maxOutputs ?
+                                             (float)(ch+1)*insig[(i-delay)*nIn+ch] : 0.0f,
+                                             outsig[i*nOut+ch]);
+            }
+        }
+    }
+
+    /* tidy-up */
+    saf_blockAdaptor_destroy(&hBA);
+    free(insig);
+    free(outsig);
+}
+
+/** State used by test__saf_stateSwap() */
+typedef struct _test__saf_stateSwap_state {
+    int id;          /**< Publication index */
+    int data[64];    /**< All entries equal to 'id' */
+}test__saf_stateSwap_state;
+/** Number of states destroyed by test__saf_stateSwap_destroyFn() */
+static volatile int test__saf_stateSwap_nDestroyed;
+/** Set once the writer has published its final state */
+static volatile int test__saf_stateSwap_done;
+
+/** Destroy function for test__saf_stateSwap(); poisons the state first */
+static void test__saf_stateSwap_destroyFn(void** const phState){
+    test__saf_stateSwap_state* s = (test__saf_stateSwap_state*)(*phState);
+    memset(s->data, 0xff, 64*sizeof(int));
+    free(s);
+    *phState = NULL;
+    test__saf_stateSwap_nDestroyed++; /* (only ever called by the writer) */
+}
+
+/** Arguments for test__saf_stateSwap_reader() */
+typedef struct _test__saf_stateSwap_readerArgs {
+    void* hSS;       /**< State swap handle */
+    int nErrors;     /**< Number of invalid states acquired by the reader */
+}test__saf_stateSwap_readerArgs;
+
+/** Reader for test__saf_stateSwap(); counts the invalid states acquired */
+static void* test__saf_stateSwap_reader(void* arg){
+    int i, lastId, nErrors, done;
+    test__saf_stateSwap_state* s;
+    test__saf_stateSwap_readerArgs* args = (test__saf_stateSwap_readerArgs*)arg;
+
+    lastId = -1;
+    nErrors = 0;
+    do{
+        done = saf_atomic_loadInt(&test__saf_stateSwap_done);
+        s = (test__saf_stateSwap_state*)saf_stateSwap_acquire(args->hSS);
+        if(s!=NULL){
+            /* States should be intact, and never go back in time */
+            for(i=0; i<64; i++)
+                nErrors += s->data[i]!=s->id;
+            nErrors += s->id<lastId;
+            lastId = s->id;
+        }
+    } while(!done);
+    args->nErrors = nErrors;
+    return NULL;
+}
+
+void test__saf_stateSwap(void){
+    int i, n;
+    void* hSS, *hThread;
+    test__saf_stateSwap_readerArgs args;
+    test__saf_stateSwap_state* s;
+
+    /* Config */
+    const int nStates = 20000;
+
+    /* Publish states from this thread, while another thread acquires them */
+    test__saf_stateSwap_nDestroyed = 0;
+    saf_atomic_storeInt(&test__saf_stateSwap_done, 0);
+    saf_stateSwap_create(&hSS, test__saf_stateSwap_destroyFn);
+    TEST_ASSERT_TRUE(saf_stateSwap_acquire(hSS)==NULL);
+    args.hSS = hSS;
+    saf_thread_create(&hThread, test__saf_stateSwap_reader, &args);
+    for(n=0; n<nStates; n++){
+        s = malloc1d(sizeof(test__saf_stateSwap_state));
+        s->id = n;
+        for(i=0; i<64; i++)
+            s->data[i] = n;
+        saf_stateSwap_publish(hSS, (void*)s);
+        if(n%7==0)
+            saf_stateSwap_collect(hSS);
+    }
+    saf_atomic_storeInt(&test__saf_stateSwap_done, 1);
+    saf_thread_join(&hThread);
+    TEST_ASSERT_EQUAL_INT(0, args.nErrors);
+
+    /* Having finished, the reader should hold the final state */
+    s = (test__saf_stateSwap_state*)saf_stateSwap_acquire(hSS);
+    TEST_ASSERT_TRUE(s!=NULL);
+    TEST_ASSERT_EQUAL_INT(nStates-1, s->id);
+
+    /* All states should be destroyed exactly once */
+    saf_stateSwap_destroy(&hSS);
+    TEST_ASSERT_TRUE(hSS==NULL);
+    TEST_ASSERT_EQUAL_INT(nStates, test__saf_stateSwap_nDestroyed);
+}
+
 void test__saf_rfft(void){
     int i, j, N;
     float* x_td, *test;
@@ -465,6 +1101,242 @@ void test__saf_rfft(void){
     }
 }
 
+void test__saf_rfft_batch(void){
+    int i, j, k, b, N, nBins, inDist, outDist, nTransforms;
+    float* x_td, *test, *ref_td;
+    float_complex* x_fd, *ref_fd, *c_td, *c_fd, *c_test, *c_ref;
+    void *hFFT, *hCFFT;
+
+    /* Config */
+    const float acceptedTolerance = 0.00001f;
+    const int maxNTransforms = 7;
+    const int nTransformsToTest[2] = {7,3}; /* (i.e. a channel change) */
+    const int fftSizesToTest[4] = {16,96,512,4096};
+
+    /* Loop over the different FFT sizes */
+    for (i=0; i<4; i++){
+        N = fftSizesToTest[i];
+        nBins = N/2+1;
+        inDist = N+3;     /* padded, to also test non-contiguous vectors */
+        outDist = N+5;
+
+        /* prep */
+        x_td = calloc1d(maxNTransforms*inDist, sizeof(float));
+        test = calloc1d(maxNTransforms*inDist, sizeof(float));
+        ref_td = malloc1d(N*sizeof(float));
+        x_fd = calloc1d(maxNTransforms*outDist, sizeof(float_complex));
+        ref_fd = malloc1d(N*sizeof(float_complex));
+        c_td = calloc1d(maxNTransforms*inDist, sizeof(float_complex));
+        c_fd = calloc1d(maxNTransforms*outDist, sizeof(float_complex));
+        c_test = calloc1d(maxNTransforms*inDist, sizeof(float_complex));
+        c_ref = malloc1d(N*sizeof(float_complex));
+        for(k=0; k<maxNTransforms; k++){
+            rand_m1_1(&x_td[k*inDist], N);
+            rand_m1_1((float*)&c_td[k*inDist], 2*N);
+        }
+        saf_rfft_create(&hFFT, N);
+        saf_fft_create(&hCFFT, N);
+
+        /* Loop over the batch sizes, which are prepared before being used */
+        for(b=0; b<2; b++){
+            nTransforms = nTransformsToTest[b];
+            saf_rfft_prepareBatch(hFFT, nTransforms, inDist, outDist);
+            saf_rfft_prepareBatch(hFFT, nTransforms, outDist, inDist);
+            saf_fft_prepareBatch(hCFFT, nTransforms, inDist, outDist);
+            saf_fft_prepareBatch(hCFFT, nTransforms, outDist, inDist);
+            memset(test, 0, maxNTransforms*inDist*sizeof(float));
+
+            /* real: batch transforms should match the single-vector transforms */
+            saf_rfft_forward_batch(hFFT, nTransforms, x_td, inDist, x_fd, outDist);
+            saf_rfft_backward_batch(hFFT, nTransforms, x_fd, outDist, test, inDist);
+            for(k=0; k<nTransforms; k++){
+                saf_rfft_forward(hFFT, &x_td[k*inDist], ref_fd);
+                for(j=0; j<nBins; j++){
+                    TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, crealf(ref_fd[j]), crealf(x_fd[k*outDist+j]));
+                    TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, cimagf(ref_fd[j]), cimagf(x_fd[k*outDist+j]));
+                }
+                saf_rfft_backward(hFFT, ref_fd, ref_td);
+                for(j=0; j<N; j++){
+                    TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, ref_td[j], test[k*inDist+j]);
+                    TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, x_td[k*inDist+j], test[k*inDist+j]);
+                }
+                /* padding must be left untouched */
+                for(j=N; j<inDist; j++)
+                    TEST_ASSERT_EQUAL_FLOAT(0.0f, test[k*inDist+j]);
+            }
+            /* as must the vectors beyond the batch */
+            for(j=nTransforms*inDist; j<maxNTransforms*inDist; j++)
+                TEST_ASSERT_EQUAL_FLOAT(0.0f, test[j]);
+
+            /* complex: same again */
+            saf_fft_forward_batch(hCFFT, nTransforms, c_td, inDist, c_fd, outDist);
+            saf_fft_backward_batch(hCFFT, nTransforms, c_fd, outDist, c_test, inDist);
+            for(k=0; k<nTransforms; k++){
+                saf_fft_forward(hCFFT, &c_td[k*inDist], c_ref);
+                for(j=0; j<N; j++){
+                    TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, crealf(c_ref[j]), crealf(c_fd[k*outDist+j]));
+                    TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, cimagf(c_ref[j]), cimagf(c_fd[k*outDist+j]));
+                }
+                for(j=0; j<N; j++){
+                    TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, crealf(c_td[k*inDist+j]), crealf(c_test[k*inDist+j]));
+                    TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, cimagf(c_td[k*inDist+j]), cimagf(c_test[k*inDist+j]));
+                }
+            }
+        }
+
+        /* clean-up */
+        saf_rfft_destroy(&hFFT);
+        saf_fft_destroy(&hCFFT);
+        free(x_td);
+        free(test);
+        free(ref_td);
+        free(x_fd);
+        free(ref_fd);
+        free(c_td);
+        free(c_fd);
+        free(c_test);
+        free(c_ref);
+    }
+}
+
+void test__saf_rfft_split(void){
+    int i, j, N, nBins;
+    float* x_td, *test, *X_re, *X_im, *Y_re, *Y_im;
+    float_complex* x_fd, *y_fd;
+    void *hFFT;
+
+    /* Config */
+    const float acceptedTolerance = 0.00001f;
+    const int fftSizesToTest[4] = {16,96,512,4096};
+
+    /* Loop over the different FFT sizes */
+    for (i=0; i<4; i++){
+        N = fftSizesToTest[i];
+        nBins = N/2+1;
+
+        /* prep */
+        x_td = malloc1d(N*sizeof(float));
+        test = malloc1d(N*sizeof(float));
+        x_fd = malloc1d(nBins*sizeof(float_complex));
+        y_fd = malloc1d(nBins*sizeof(float_complex));
+        X_re = malloc1d(nBins*sizeof(float));
+        X_im = malloc1d(nBins*sizeof(float));
+        Y_re = malloc1d(nBins*sizeof(float));
+        Y_im = malloc1d(nBins*sizeof(float));
+        rand_m1_1(x_td, N);
+        saf_rfft_create(&hFFT, N);
+
+        /* split output should match the interleaved output */
+        saf_rfft_forward(hFFT, x_td, x_fd);
+        saf_rfft_forward_split(hFFT, x_td, X_re, X_im);
+        for(j=0; j<nBins; j++){
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, crealf(x_fd[j]), X_re[j]);
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, cimagf(x_fd[j]), X_im[j]);
+        }
+
+        /* split complex multiplication should match the interleaved version */
+        utility_cvvmul(x_fd, x_fd, nBins, y_fd);
+        utility_cvvmul_split(X_re, X_im, X_re, X_im, nBins, Y_re, Y_im);
+        for(j=0; j<nBins; j++){
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance*N, crealf(y_fd[j]), Y_re[j]);
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance*N, cimagf(y_fd[j]), Y_im[j]);
+        }
+        utility_cvvadd_split(X_re, X_im, Y_re, Y_im, nBins, Y_re, Y_im);
+        for(j=0; j<nBins; j++){
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance*N, crealf(x_fd[j])+crealf(y_fd[j]), Y_re[j]);
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance*N, cimagf(x_fd[j])+cimagf(y_fd[j]), Y_im[j]);
+        }
+
+        /* round-trip, x_td==test */
+        saf_rfft_backward_split(hFFT, X_re, X_im, test);
+        for(j=0; j<N; j++)
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, x_td[j], test[j]);
+
+        /* clean-up */
+        saf_rfft_destroy(&hFFT);
+        free(x_td);
+        free(test);
+        free(x_fd);
+        free(y_fd);
+        free(X_re);
+        free(X_im);
+        free(Y_re);
+        free(Y_im);
+    }
+}
+
+/** Worker for test__saf_fft_planCache(); returns the max round-trip error */
+static void* test__saf_fft_planCache_worker(void* arg){
+    int i, j, k, N;
+    float* x_td, *test, *maxErr;
+    float_complex* x_fd, *c_td, *c_fd, *c_test;
+    void* hFFT[2], *hCFFT;
+    const int fftSizesToTest[3] = {16,96,1024};
+
+    maxErr = (float*)arg;
+    *maxErr = 0.0f;
+    for(i=0; i<20; i++){
+        N = fftSizesToTest[i%3];
+        x_td = malloc1d(N*sizeof(float));
+        test = malloc1d(N*sizeof(float));
+        x_fd = malloc1d((N/2+1)*sizeof(float_complex));
+        c_td = malloc1d(N*sizeof(float_complex));
+        c_fd = malloc1d(N*sizeof(float_complex));
+        c_test = malloc1d(N*sizeof(float_complex));
+        rand_m1_1(x_td, N);
+        rand_m1_1((float*)c_td, 2*N);
+
+        /* two instances of the same size (sharing one plan), used in turn */
+        saf_rfft_create(&hFFT[0], N);
+        saf_rfft_create(&hFFT[1], N);
+        saf_fft_create(&hCFFT, N);
+        for(k=0; k<2; k++){
+            saf_rfft_forward(hFFT[k], x_td, x_fd);
+            saf_rfft_backward(hFFT[(k+1)%2], x_fd, test);
+            for(j=0; j<N; j++)
+                *maxErr = MAX(*maxErr, fabsf(x_td[j]-test[j]));
+        }
+        saf_fft_forward(hCFFT, c_td, c_fd);
+        saf_fft_backward(hCFFT, c_fd, c_test);
+        for(j=0; j<N; j++)
+            *maxErr = MAX(*maxErr, cabsf(ccsubf(c_td[j], c_test[j])));
+        saf_rfft_destroy(&hFFT[1]);
+        saf_rfft_destroy(&hFFT[0]);
+        saf_fft_destroy(&hCFFT);
+
+        free(x_td);
+        free(test);
+        free(x_fd);
+        free(c_td);
+        free(c_fd);
+        free(c_test);
+    }
+    return NULL;
+}
+
+void test__saf_fft_planCache(void){
+    int t;
+    float maxErr[4];
+    void* hThread[4];
+    void* hFFT_persist;
+
+    /* Config */
+    const float acceptedTolerance = 0.00001f;
+
+    /* Keep one plan alive throughout, while the others are repeatedly created
+     * and destroyed by several threads at once */
+    saf_rfft_create(&hFFT_persist, 96);
+    for(t=0; t<4; t++)
+        saf_thread_create(&hThread[t], test__saf_fft_planCache_worker, &maxErr[t]);
+    for(t=0; t<4; t++)
+        saf_thread_join(&hThread[t]);
+    saf_rfft_destroy(&hFFT_persist);
+
+    /* All instances should have produced the same results as separate plans */
+    for(t=0; t<4; t++)
+        TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, 0.0f, maxErr[t]);
+}
+
 #ifdef AFSTFT_USE_FLOAT_COMPLEX
 void test__afSTFTMatrix(void){
     int idx,frameIdx,c,t;
@@ -605,6 +1477,151 @@ void test__afSTFT(void){
 #endif
 }
 
+void test__afSTFT_LDmode(void){
+    int i, hybridMode, LDmode, delay, hop, nHops;
+    float* inSig, *outSig, *inHop, *outHop;
+    double errEnergy, sigEnergy;
+    void* hSTFT;
+    complexVector frequencyDomainData;
+
+    /* Config */
+    const float acceptedTolerance_dB = -40.0f;
+    const int hopSize = 128;
+    const int lCompare = 500*hopSize;
+
+    for(hybridMode=0; hybridMode<2; hybridMode++){
+        for(LDmode=0; LDmode<2; LDmode++){
+            /* prep */
+            delay = afSTFTgetProcessingDelay(hopSize, LDmode, hybridMode);
+            nHops = (lCompare + delay)/hopSize + 1;
+            inSig = calloc1d(nHops*hopSize, sizeof(float));
+            outSig = calloc1d(nHops*hopSize, sizeof(float));
+            frequencyDomainData.re = malloc1d((hopSize+5)*sizeof(float));
+            frequencyDomainData.im = malloc1d((hopSize+5)*sizeof(float));
+            rand_m1_1(inSig, lCompare);
+
+            /* Pass the signal through the afSTFT */
+            afSTFTinit(&hSTFT, hopSize, 1, 1, LDmode, hybridMode);
+            for(hop=0; hop<nHops; hop++){
+                inHop = &inSig[hop*hopSize];
+                outHop = &outSig[hop*hopSize];
+                afSTFTforward(hSTFT, &inHop, &frequencyDomainData);
+                afSTFTinverse(hSTFT, &frequencyDomainData, &outHop);
+            }
+
+            /* After compensating for the reported delay, the output should
+             * match the input (given some numerical precision) */
+            errEnergy = sigEnergy = 0.0;
+            for(i=0; i<lCompare; i++){
+                errEnergy += pow((double)(outSig[i+delay]-inSig[i]), 2.0);
+                sigEnergy += pow((double)inSig[i], 2.0);
+            }
+            TEST_ASSERT_TRUE(10.0*log10(errEnergy/sigEnergy) <= acceptedTolerance_dB);
+
+            /* tidy-up */
+            afSTFTfree(hSTFT);
+            free(inSig);
+            free(outSig);
+            free(frequencyDomainData.re);
+            free(frequencyDomainData.im);
+        }
+    }
+}
+
+void test__afSTFTframe(void){
+    int i, frame, hop, c, band, f;
+    float maxErrFD, maxErrTD;
+    float** inFrame, **outFrameRef, **outFrame, **tempHop;
+    float_complex* FD[2];
+    complexVector* FDhop;
+    void* hSTFTref, *hSTFT[2];
+    AFSTFT_FDDATA_FORMAT format[2] = {AFSTFT_BANDS_CH_TIME, AFSTFT_TIME_CH_BANDS};
+
+    /* Config */
+    const float acceptedTolerance = 1e-6f;
+    const int nTestFrames = 40;
+    const int hopSize = 128;
+    const int frameSize = 4*hopSize;
+    const int numChannels = 5;
+    const int nChBuffer = 8; /* larger than numChannels, to test the strides */
+    const int hybridMode = 1;
+
+    /* prep */
+    const int nHops = frameSize/hopSize;
+    const int nBands = hopSize + (hybridMode ? 5 : 1);
+    afSTFTinit(&hSTFTref, hopSize, numChannels, numChannels, 0, hybridMode);
+    for(f=0; f<2; f++){
+        afSTFTinit(&hSTFT[f], hopSize, numChannels, numChannels, 0, hybridMode);
+        FD[f] = malloc1d(nBands*nChBuffer*nHops*sizeof(float_complex));
+    }
+    inFrame = (float**)malloc2d(numChannels, frameSize, sizeof(float));
+    outFrameRef = (float**)malloc2d(numChannels, frameSize, sizeof(float));
+    outFrame = (float**)malloc2d(numChannels, frameSize, sizeof(float));
+    tempHop = (float**)malloc2d(numChannels, hopSize, sizeof(float));
+    FDhop = malloc1d(nHops*numChannels*sizeof(complexVector));
+    for(i=0; i<nHops*numChannels; i++){
+        FDhop[i].re = malloc1d(nBands*sizeof(float));
+        FDhop[i].im = malloc1d(nBands*sizeof(float));
+    }
+
+    maxErrFD = maxErrTD = 0.0f;
+    for(frame=0; frame<nTestFrames; frame++){
+        rand_m1_1(FLATTEN2D(inFrame), numChannels*frameSize);
+
+        /* Reference: hop-by-hop */
+        for(hop=0; hop<nHops; hop++){
+            for(c=0; c<numChannels; c++)
+                memcpy(tempHop[c], &inFrame[c][hop*hopSize], hopSize*sizeof(float));
+            afSTFTforward(hSTFTref, tempHop, &FDhop[hop*numChannels]);
+        }
+
+        /* Frame-based, in both storage formats */
+        for(f=0; f<2; f++)
+            afSTFTforwardFrame(hSTFT[f], inFrame, frameSize, nChBuffer, format[f], FD[f]);
+        for(hop=0; hop<nHops; hop++){
+            for(c=0; c<numChannels; c++){
+                for(band=0; band<nBands; band++){
+                    maxErrFD = MAX(maxErrFD, cabsf(ccsubf(FD[0][(band*nChBuffer+c)*nHops+hop],
+                                                          cmplxf(FDhop[hop*numChannels+c].re[band], FDhop[hop*numChannels+c].im[band]))));
+                    maxErrFD = MAX(maxErrFD, cabsf(ccsubf(FD[1][(hop*nChBuffer+c)*nBands+band],
+                                                          cmplxf(FDhop[hop*numChannels+c].re[band], FDhop[hop*numChannels+c].im[band]))));
+                }
+            }
+        }
+
+        /* Inverse */
+        for(hop=0; hop<nHops; hop++){
+            afSTFTinverse(hSTFTref, &FDhop[hop*numChannels], tempHop);
+            for(c=0; c<numChannels; c++)
+                memcpy(&outFrameRef[c][hop*hopSize], tempHop[c], hopSize*sizeof(float));
+        }
+        for(f=0; f<2; f++){
+            afSTFTinverseFrame(hSTFT[f], FD[f], frameSize, nChBuffer, format[f], outFrame);
+            for(c=0; c<numChannels; c++)
+                for(i=0; i<frameSize; i++)
+                    maxErrTD = MAX(maxErrTD, fabsf(outFrame[c][i]-outFrameRef[c][i]));
+        }
+    }
+    TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, 0.0f, maxErrFD);
+    TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, 0.0f, maxErrTD);
+
+    /* tidy-up */
+    afSTFTfree(hSTFTref);
+    for(f=0; f<2; f++){
+        afSTFTfree(hSTFT[f]);
+        free(FD[f]);
+    }
+    for(i=0; i<nHops*numChannels; i++){
+        free(FDhop[i].re);
+        free(FDhop[i].im);
+    }
+    free(FDhop);
+    free(inFrame);
+    free(outFrameRef);
+    free(outFrame);
+    free(tempHop);
+}
+
 void test__smb_pitchShifter(void){
     float* inputData, *outputData;
     void* hPS, *hFFT;
@@ -826,91 +1843,698 @@ void test__unique_i(void){
     int* uniqueVals;
     int* uniqueInds;
 
-    /* test1 */
-    int input[6] = {1, 2, 2, 10, 11, 12};
-    int uniqueVals_ref[5] = {1, 2, 10, 11, 12};
-    int uniqueInds_ref[5] = {0, 2, 3, 4, 5};
-    unique_i(input, 6, &uniqueVals, &uniqueInds, &nUnique);
-    TEST_ASSERT_EQUAL(5, nUnique);
-    for(i=0; i<nUnique; i++){
-        TEST_ASSERT_EQUAL(uniqueVals_ref[i], uniqueVals[i]);
-        TEST_ASSERT_EQUAL(uniqueInds_ref[i], uniqueInds[i]);
-    }
-    free(uniqueVals);
-    free(uniqueInds);
+    /* test1 */
+    int input[6] = {1, 2, 2, 10, 11, 12};
+    int uniqueVals_ref[5] = {1, 2, 10, 11, 12};
+    int uniqueInds_ref[5] = {0, 2, 3, 4, 5};
+    unique_i(input, 6, &uniqueVals, &uniqueInds, &nUnique);
+    TEST_ASSERT_EQUAL(5, nUnique);
+    for(i=0; i<nUnique; i++){
+        TEST_ASSERT_EQUAL(uniqueVals_ref[i], uniqueVals[i]);
+        TEST_ASSERT_EQUAL(uniqueInds_ref[i], uniqueInds[i]);
+    }
+    free(uniqueVals);
+    free(uniqueInds);
+
+    /* test2 */
+    int input2[12] = {1, 10, 1, 3, 1, 3, 4, 7, 8, 10, 10, 2};
+    int uniqueVals_ref2[7] = {1, 3, 4, 7, 8, 10, 2};
+    int uniqueInds_ref2[7] = {4, 5, 6, 7, 8, 10, 11};
+    unique_i(input2, 12, &uniqueVals, &uniqueInds, &nUnique);
+    TEST_ASSERT_EQUAL(7, nUnique);
+    for(i=0; i<nUnique; i++){
+        TEST_ASSERT_EQUAL(uniqueVals_ref2[i], uniqueVals[i]);
+        TEST_ASSERT_EQUAL(uniqueInds_ref2[i], uniqueInds[i]);
+    }
+    free(uniqueVals);
+    free(uniqueInds);
+}
+
+void test__realloc2d_r(void){
+    int s, r, i, j, k;
+    typedef struct _test_data{
+        int ID;
+        float val1, val2;
+    }test_data;
+    test_data** test;
+
+    /* Configure reference data structures */
+    test_data reference[6][6];
+    for(i=0, k=0; i<6; i++){
+        for(j=0; j<6; j++, k++){
+            reference[i][j].ID = k;
+            rand_m1_1(&reference[i][j].val1,1);
+            rand_m1_1(&reference[i][j].val2,1);
+        }
+    }
+
+    /* Starting size */
+    test = (test_data**)malloc2d(1,3,sizeof(test_data));
+    for(s=0; s<1; s++)
+        for(r=0; r<3; r++)
+            memcpy(&test[s][r], &reference[s][r], sizeof(test_data));
+
+    /* Check that increasing the size of the array, still retains the previous data */
+    test = (test_data**)realloc2d_r((void**)test, 4, 3, 1, 3, sizeof(test_data));
+    for(i=0; i<1; i++){
+        for(j=0; j<3; j++){
+            TEST_ASSERT_TRUE(test[i][j].ID==reference[i][j].ID);
+            TEST_ASSERT_TRUE(test[i][j].val1==reference[i][j].val1);
+            TEST_ASSERT_TRUE(test[i][j].val2==reference[i][j].val2);
+        }
+    }
+
+    /* Check that new data can then be added and indexed correctly */
+    for(s=1; s<4; s++)
+        for(r=0; r<3; r++)
+             memcpy(&test[s][r], &reference[s][r], sizeof(test_data));
+    for(i=0; i<4; i++){
+        for(j=0; j<3; j++){
+            TEST_ASSERT_TRUE(test[i][j].ID==reference[i][j].ID);
+            TEST_ASSERT_TRUE(test[i][j].val1==reference[i][j].val1);
+            TEST_ASSERT_TRUE(test[i][j].val2==reference[i][j].val2);
+        }
+    }
+
+    /* Check that the array can be shrunk, but still retain the original data (except truncated) */
+    test = (test_data**)realloc2d_r((void**)test, 4, 2, 4, 3, sizeof(test_data));
+    for(i=0; i<4; i++){
+        for(j=0; j<2; j++){
+            TEST_ASSERT_TRUE(test[i][j].ID==reference[i][j].ID);
+            TEST_ASSERT_TRUE(test[i][j].val1==reference[i][j].val1);
+            TEST_ASSERT_TRUE(test[i][j].val2==reference[i][j].val2);
+        }
+    }
+
+    /* clean-up */
+    free(test);
+}
+
+void test__utility_cvvmuladd(void){
+    int i, j, k, lvl, len, maxLevel;
+    float* a_re, *a_im, *b_re, *b_im, *c_re, *c_im;
+    float_complex* a, *b, *c;
+    double_complex ref;
+
+    /* Config */
+    const float acceptedTolerance = 0.00001f;
+    const int lengthsToTest[5] = {1, 7, 16, 37, 1001};
+
+    /* Test the reference implementation and all SIMD kernels supported by the
+     * CPU */
+    utility_setMaxSIMDlevel(SAF_SIMD_NEON);
+    maxLevel = (int)utility_getSIMDlevel();
+    for(lvl=0; lvl<=maxLevel; lvl++){
+        utility_setMaxSIMDlevel((SAF_SIMD_LEVEL)lvl);
+        if((int)utility_getSIMDlevel()!=lvl)
+            continue; /* (level not applicable to this architecture) */
+        for(i=0; i<5; i++){
+            len = lengthsToTest[i];
+            a = malloc1d(len*sizeof(float_complex));
+            b = malloc1d(len*sizeof(float_complex));
+            c = malloc1d(len*sizeof(float_complex));
+            a_re = malloc1d(len*sizeof(float));
+            a_im = malloc1d(len*sizeof(float));
+            b_re = malloc1d(len*sizeof(float));
+            b_im = malloc1d(len*sizeof(float));
+            c_re = malloc1d(len*sizeof(float));
+            c_im = malloc1d(len*sizeof(float));
+            for(k=0; k<2; k++){ /* NO_CONJ, CONJ */
+                rand_m1_1((float*)a, 2*len);
+                rand_m1_1((float*)b, 2*len);
+                rand_m1_1((float*)c, 2*len);
+                for(j=0; j<len; j++){
+                    a_re[j] = crealf(a[j]); a_im[j] = cimagf(a[j]);
+                    b_re[j] = crealf(b[j]); b_im[j] = cimagf(b[j]);
+                    c_re[j] = crealf(c[j]); c_im[j] = cimagf(c[j]);
+                }
+                utility_cvvmuladd_split(a_re, a_im, b_re, b_im, len, k ? CONJ : NO_CONJ, c_re, c_im);
+                for(j=0; j<len; j++){
+                    /* double precision reference */
+                    ref = cmplx((double)crealf(c[j]), (double)cimagf(c[j]));
+                    ref = ccadd(ref, ccmul(cmplx((double)crealf(a[j]), k ? -(double)cimagf(a[j]) : (double)cimagf(a[j])),
+                                           cmplx((double)crealf(b[j]), (double)cimagf(b[j]))));
+                    TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, (float)creal(ref), c_re[j]);
+                    TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, (float)cimag(ref), c_im[j]);
+                }
+                utility_cvvmuladd(a, b, len, k ? CONJ : NO_CONJ, c);
+                for(j=0; j<len; j++){
+                    TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, c_re[j], crealf(c[j]));
+                    TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, c_im[j], cimagf(c[j]));
+                }
+            }
+            free(a);
+            free(b);
+            free(c);
+            free(a_re);
+            free(a_im);
+            free(b_re);
+            free(b_im);
+            free(c_re);
+            free(c_im);
+        }
+    }
+    utility_setMaxSIMDlevel(SAF_SIMD_NEON); /* restore */
+}
+
+void test__utility_simdKernels(void){
+    int i, j, k, lvl, len, maxLevel;
+    float s;
+    float* a, *b, **ref, **test;
+    float_complex* a_c, *b_c, *c_c, *ref_c;
+
+    /* Config */
+    const float acceptedTolerance = 0.00001f;
+    const int lengthsToTest[5] = {1, 7, 16, 37, 1001};
+    const int nRoutines = 8;
+
+    utility_setMaxSIMDlevel(SAF_SIMD_NEON);
+    maxLevel = (int)utility_getSIMDlevel();
+    for(i=0; i<5; i++){
+        len = lengthsToTest[i];
+        a = malloc1d(len*sizeof(float));
+        b = malloc1d(len*sizeof(float));
+        ref = (float**)malloc2d(nRoutines, 2*len, sizeof(float));
+        test = (float**)malloc2d(nRoutines, 2*len, sizeof(float));
+        a_c = malloc1d(len*sizeof(float_complex));
+        b_c = malloc1d(len*sizeof(float_complex));
+        c_c = malloc1d(len*sizeof(float_complex));
+        ref_c = malloc1d(len*sizeof(float_complex));
+        rand_m1_1(a, len);
+        rand_m1_1(b, len);
+        rand_m1_1((float*)a_c, 2*len);
+        rand_m1_1((float*)b_c, 2*len);
+        s = 0.37f;
+
+        /* Reference implementations */
+        utility_setMaxSIMDlevel(SAF_SIMD_NONE);
+        utility_svvadd(a, b, len, ref[0]);
+        utility_svvsub(a, b, len, ref[1]);
+        utility_svvmul(a, b, len, ref[2]);
+        utility_svsmul(a, &s, len, ref[3]);
+        utility_svsadd(a, &s, len, ref[4]);
+        utility_svssub(a, &s, len, ref[5]);
+        utility_cvvadd(a_c, b_c, len, (float_complex*)ref[6]);
+        utility_cvvsub(a_c, b_c, len, (float_complex*)ref[7]);
+        utility_cvvmul(a_c, b_c, len, ref_c);
+
+        /* Real-valued results must be identical for all SIMD levels, complex
+         * multiplication may differ slightly if FMA is employed */
+        for(lvl=1; lvl<=maxLevel; lvl++){
+            utility_setMaxSIMDlevel((SAF_SIMD_LEVEL)lvl);
+            if((int)utility_getSIMDlevel()!=lvl)
+                continue; /* (level not applicable to this architecture) */
+            utility_svvadd(a, b, len, test[0]);
+            utility_svvsub(a, b, len, test[1]);
+            utility_svvmul(a, b, len, test[2]);
+            utility_svsmul(a, &s, len, test[3]);
+            utility_svsadd(a, &s, len, test[4]);
+            utility_svssub(a, &s, len, test[5]);
+            utility_cvvadd(a_c, b_c, len, (float_complex*)test[6]);
+            utility_cvvsub(a_c, b_c, len, (float_complex*)test[7]);
+            for(k=0; k<nRoutines; k++)
+                for(j=0; j<(k<6 ? len : 2*len); j++)
+                    TEST_ASSERT_TRUE(test[k][j]==ref[k][j]);
+            utility_cvvmul(a_c, b_c, len, c_c);
+            for(j=0; j<len; j++){
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, crealf(ref_c[j]), crealf(c_c[j]));
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, cimagf(ref_c[j]), cimagf(c_c[j]));
+            }
+
+            /* In-place operation */
+            cblas_scopy(len, a, 1, test[0], 1);
+            utility_svvadd(test[0], b, len, test[0]);
+            for(j=0; j<len; j++)
+                TEST_ASSERT_TRUE(test[0][j]==ref[0][j]);
+        }
+        free(a);
+        free(b);
+        free(ref);
+        free(test);
+        free(a_c);
+        free(b_c);
+        free(c_c);
+        free(ref_c);
+    }
+    utility_setMaxSIMDlevel(SAF_SIMD_NEON); /* restore */
+}
+
+void test__utility_svvmulfold(void){
+    int i, m, t, lvl, segLen, nSeg, maxLevel;
+    float* a, *b, *c, *c_ref;
+    double acc;
+
+    /* Config */
+    const float acceptedTolerance = 0.00001f;
+    const int segLensToTest[5] = {1, 7, 16, 37, 256};
+    const int nSegToTest[5] = {1, 5, 3, 2, 5};
+
+    utility_setMaxSIMDlevel(SAF_SIMD_NEON);
+    maxLevel = (int)utility_getSIMDlevel();
+    for(t=0; t<5; t++){
+        segLen = segLensToTest[t];
+        nSeg = nSegToTest[t];
+        a = malloc1d(nSeg*segLen*sizeof(float));
+        b = malloc1d(nSeg*segLen*sizeof(float));
+        c = malloc1d(segLen*sizeof(float));
+        c_ref = malloc1d(segLen*sizeof(float));
+        rand_m1_1(a, nSeg*segLen);
+        rand_m1_1(b, nSeg*segLen);
+        for(i=0; i<segLen; i++){
+            acc = 0.0;
+            for(m=0; m<nSeg; m++)
+                acc += (double)a[m*segLen+i] * (double)b[m*segLen+i];
+            c_ref[i] = (float)acc;
+        }
+
+        /* Reference and SIMD kernels */
+        for(lvl=0; lvl<=maxLevel; lvl++){
+            utility_setMaxSIMDlevel((SAF_SIMD_LEVEL)lvl);
+            if((int)utility_getSIMDlevel()!=lvl)
+                continue; /* (level not applicable to this architecture) */
+
+            /* folded product */
+            utility_svvmulfold(a, b, segLen, nSeg, c);
+            for(i=0; i<segLen; i++)
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, c_ref[i], c[i]);
+
+            /* ...which should also be obtained via multiply-accumulation */
+            memset(c, 0, segLen*sizeof(float));
+            for(m=0; m<nSeg; m++)
+                utility_svvmuladd(&a[m*segLen], &b[m*segLen], segLen, c);
+            for(i=0; i<segLen; i++)
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, c_ref[i], c[i]);
+        }
+        utility_setMaxSIMDlevel(SAF_SIMD_NEON);
+
+        /* clean-up */
+        free(a);
+        free(b);
+        free(c);
+        free(c_ref);
+    }
+    TEST_ASSERT_TRUE((int)utility_getSIMDlevel()==maxLevel);
+}
+
+void test__utility_lapackWorkspaces(void){
+    int i, j, t, dim1, dim2;
+    void* hWork;
+    float* A, *Asym, *B, *X, *X_ref, *sing, *sing_ref;
+    float_complex* A_c, *Asym_c, *B_c, *X_c, *X_c_ref;
+
+    /* Config */
+    const float acceptedTolerance = 0.0001f;
+    const int maxDim = 8;
+    const int nCol = 3;
+    const int dims[4][2] = {{8, 8}, {5, 8}, {8, 3}, {1, 1}};
+    const float_complex calpha = cmplxf(1.0f, 0.0f), cbeta = cmplxf(0.0f, 0.0f);
+
+    A = malloc1d(maxDim*maxDim*sizeof(float));
+    Asym = malloc1d(maxDim*maxDim*sizeof(float));
+    B = malloc1d(maxDim*nCol*sizeof(float));
+    X = malloc1d(maxDim*maxDim*sizeof(float));
+    X_ref = malloc1d(maxDim*maxDim*sizeof(float));
+    sing = malloc1d(maxDim*sizeof(float));
+    sing_ref = malloc1d(maxDim*sizeof(float));
+    A_c = malloc1d(maxDim*maxDim*sizeof(float_complex));
+    Asym_c = malloc1d(maxDim*maxDim*sizeof(float_complex));
+    B_c = malloc1d(maxDim*nCol*sizeof(float_complex));
+    X_c = malloc1d(maxDim*maxDim*sizeof(float_complex));
+    X_c_ref = malloc1d(maxDim*maxDim*sizeof(float_complex));
+
+    /* Workspaces are created once, for the largest dimensions, and then used
+     * for smaller matrices too. The results should match the allocating
+     * versions of these functions */
+    for(t=0; t<4; t++){
+        dim1 = dims[t][0];
+        dim2 = dims[t][1];
+        rand_m1_1(A, dim1*dim2);
+        rand_m1_1((float*)A_c, 2*dim1*dim2);
+        rand_m1_1(B, dim1*nCol);
+        rand_m1_1((float*)B_c, 2*dim1*nCol);
+
+        /* Symmetric positive-definite matrices: A*A^H + I */
+        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasTrans, dim1, dim1, dim2, 1.0f,
+                    A, dim2, A, dim2, 0.0f, Asym, dim1);
+        cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasConjTrans, dim1, dim1, dim2, &calpha,
+                    A_c, dim2, A_c, dim2, &cbeta, Asym_c, dim1);
+        for(i=0; i<dim1; i++){
+            Asym[i*dim1+i] += 1.0f;
+            Asym_c[i*dim1+i] = ccaddf(Asym_c[i*dim1+i], cmplxf(1.0f, 0.0f));
+        }
+
+        /* singular values */
+        utility_ssvd_create(&hWork, maxDim, maxDim);
+        utility_ssvd_ws(hWork, A, dim1, dim2, NULL, NULL, NULL, sing);
+        utility_ssvd_destroy(&hWork);
+        TEST_ASSERT_TRUE(hWork==NULL);
+        utility_ssvd(A, dim1, dim2, NULL, NULL, NULL, sing_ref);
+        for(i=0; i<MIN(dim1, dim2); i++)
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, sing_ref[i], sing[i]);
+        utility_csvd_create(&hWork, maxDim, maxDim);
+        utility_csvd_ws(hWork, A_c, dim1, dim2, NULL, NULL, NULL, sing);
+        utility_csvd_destroy(&hWork);
+        utility_csvd(A_c, dim1, dim2, NULL, NULL, NULL, sing_ref);
+        for(i=0; i<MIN(dim1, dim2); i++)
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, sing_ref[i], sing[i]);
+
+        /* eigenvalues */
+        utility_sseig_create(&hWork, maxDim);
+        utility_sseig_ws(hWork, Asym, dim1, 1, NULL, NULL, sing);
+        utility_sseig_destroy(&hWork);
+        utility_sseig(Asym, dim1, 1, NULL, NULL, sing_ref);
+        for(i=0; i<dim1; i++)
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, sing_ref[i], sing[i]);
+        utility_cseig_create(&hWork, maxDim);
+        utility_cseig_ws(hWork, Asym_c, dim1, 1, NULL, NULL, sing);
+        utility_cseig_destroy(&hWork);
+        utility_cseig(Asym_c, dim1, 1, NULL, NULL, sing_ref);
+        for(i=0; i<dim1; i++)
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, sing_ref[i], sing[i]);
+
+        /* symmetric linear solver */
+        utility_sslslv_create(&hWork, maxDim, nCol);
+        utility_sslslv_ws(hWork, Asym, dim1, B, nCol, X);
+        utility_sslslv_destroy(&hWork);
+        utility_sslslv(Asym, dim1, B, nCol, X_ref);
+        for(i=0; i<dim1*nCol; i++)
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, X_ref[i], X[i]);
+        utility_cslslv_create(&hWork, maxDim, nCol);
+        utility_cslslv_ws(hWork, Asym_c, dim1, B_c, nCol, X_c);
+        utility_cslslv_destroy(&hWork);
+        utility_cslslv(Asym_c, dim1, B_c, nCol, X_c_ref);
+        for(i=0; i<dim1*nCol; i++){
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, crealf(X_c_ref[i]), crealf(X_c[i]));
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, cimagf(X_c_ref[i]), cimagf(X_c[i]));
+        }
+
+        /* pseudo-inverse */
+        utility_spinv_create(&hWork, maxDim, maxDim);
+        utility_spinv_ws(hWork, A, dim1, dim2, X);
+        utility_spinv_destroy(&hWork);
+        utility_spinv(A, dim1, dim2, X_ref);
+        for(i=0; i<dim1*dim2; i++)
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, X_ref[i], X[i]);
+        utility_cpinv_create(&hWork, maxDim, maxDim);
+        utility_cpinv_ws(hWork, A_c, dim1, dim2, X_c);
+        utility_cpinv_destroy(&hWork);
+        utility_cpinv(A_c, dim1, dim2, X_c_ref);
+        for(i=0; i<dim1*dim2; i++){
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, crealf(X_c_ref[i]), crealf(X_c[i]));
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, cimagf(X_c_ref[i]), cimagf(X_c[i]));
+        }
+
+        /* inverse (which, for the symmetric positive-definite matrices, must
+         * also be the pseudo-inverse) */
+        utility_sinv_create(&hWork, maxDim);
+        utility_sinv_ws(hWork, Asym, X, dim1);
+        utility_sinv_destroy(&hWork);
+        utility_spinv(Asym, dim1, dim1, X_ref);
+        for(i=0; i<dim1; i++)
+            for(j=0; j<dim1; j++)
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, X_ref[i*dim1+j], X[i*dim1+j]);
+        utility_cinv_create(&hWork, maxDim);
+        utility_cinv_ws(hWork, Asym_c, X_c, dim1);
+        utility_cinv_destroy(&hWork);
+        utility_cpinv(Asym_c, dim1, dim1, X_c_ref);
+        for(i=0; i<dim1*dim1; i++){
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, crealf(X_c_ref[i]), crealf(X_c[i]));
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, cimagf(X_c_ref[i]), cimagf(X_c[i]));
+        }
+    }
+
+    /* clean-up */
+    free(A);
+    free(Asym);
+    free(B);
+    free(X);
+    free(X_ref);
+    free(sing);
+    free(sing_ref);
+    free(A_c);
+    free(Asym_c);
+    free(B_c);
+    free(X_c);
+    free(X_c_ref);
+}
+
+void test__utility_batchSolvers(void){
+    int i, t, b, dim, nBatch;
+    void* hBatch, *hWork;
+    float_complex* A, *Asym, *B, *X, *X_ref;
+    float* sing, *sing_ref;
+
+    /* Config */
+    const float acceptedTolerance = 0.001f;
+    const int nCol = 3;
+    const int dimsToTest[3] = {1, 4, 11};
+    const int nBatchToTest[3] = {13, 8, 3};
+    const float_complex calpha = cmplxf(1.0f, 0.0f), cbeta = cmplxf(0.0f, 0.0f);
+
+    for(t=0; t<3; t++){
+        dim = dimsToTest[t];
+        nBatch = nBatchToTest[t];
+        A = malloc1d(nBatch*dim*dim*sizeof(float_complex));
+        Asym = malloc1d(nBatch*dim*dim*sizeof(float_complex));
+        B = malloc1d(nBatch*dim*nCol*sizeof(float_complex));
+        X = malloc1d(nBatch*dim*MAX(dim,nCol)*sizeof(float_complex));
+        X_ref = malloc1d(dim*MAX(dim,nCol)*sizeof(float_complex));
+        sing = malloc1d(nBatch*dim*sizeof(float));
+        sing_ref = malloc1d(dim*sizeof(float));
+        rand_m1_1((float*)A, 2*nBatch*dim*dim);
+        rand_m1_1((float*)B, 2*nBatch*dim*nCol);
+
+        /* Hermitian positive-definite matrices: A*A^H + I (except for the
+         * second, which is negative-definite and should therefore fail) */
+        for(b=0; b<nBatch; b++){
+            cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasConjTrans, dim, dim, dim, &calpha,
+                        &A[b*dim*dim], dim, &A[b*dim*dim], dim, &cbeta, &Asym[b*dim*dim], dim);
+            for(i=0; i<dim; i++)
+                Asym[b*dim*dim + i*dim+i] = ccaddf(Asym[b*dim*dim + i*dim+i], cmplxf(1.0f, 0.0f));
+        }
+        cblas_csscal(dim*dim, -1.0f, &Asym[dim*dim], 1);
+
+        /* Cholesky factorisations */
+        utility_cchol_batch_create(&hBatch, dim, nBatch);
+        utility_cchol_batch(hBatch, Asym, dim, nBatch, X);
+        utility_cchol_batch_destroy(&hBatch);
+        TEST_ASSERT_TRUE(hBatch==NULL);
+        for(b=0; b<nBatch; b++){
+            if(b==1){
+                for(i=0; i<dim*dim; i++)
+                    TEST_ASSERT_TRUE(crealf(X[b*dim*dim+i])==0.0f && cimagf(X[b*dim*dim+i])==0.0f);
+                continue;
+            }
+            utility_cchol(&Asym[b*dim*dim], dim, X_ref);
+            for(i=0; i<dim*dim; i++){
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, crealf(X_ref[i]), crealf(X[b*dim*dim+i]));
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, cimagf(X_ref[i]), cimagf(X[b*dim*dim+i]));
+            }
+        }
+
+        /* Linear solver (the negative-definite matrix is skipped, since the
+         * MKL batch solver is LU based and would therefore succeed) */
+        utility_cslslv_batch_create(&hBatch, dim, nCol, nBatch);
+        utility_cslslv_batch(hBatch, Asym, dim, nBatch, B, nCol, X);
+        utility_cslslv_batch_destroy(&hBatch);
+        for(b=0; b<nBatch; b++){
+            if(b==1)
+                continue;
+            utility_cslslv(&Asym[b*dim*dim], dim, &B[b*dim*nCol], nCol, X_ref);
+            for(i=0; i<dim*nCol; i++){
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, crealf(X_ref[i]), crealf(X[b*dim*nCol+i]));
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, cimagf(X_ref[i]), cimagf(X[b*dim*nCol+i]));
+            }
+        }
+
+        /* Eigenvalues and singular values */
+        utility_cseig_create(&hWork, dim);
+        utility_cseig_batch(hWork, Asym, dim, nBatch, 1, NULL, NULL, sing);
+        utility_cseig_destroy(&hWork);
+        for(b=0; b<nBatch; b++){
+            utility_cseig(&Asym[b*dim*dim], dim, 1, NULL, NULL, sing_ref);
+            for(i=0; i<dim; i++)
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, sing_ref[i], sing[b*dim+i]);
+        }
+        utility_csvd_create(&hWork, dim, dim);
+        utility_csvd_batch(hWork, A, dim, dim, nBatch, NULL, NULL, NULL, sing);
+        utility_csvd_destroy(&hWork);
+        for(b=0; b<nBatch; b++){
+            utility_csvd(&A[b*dim*dim], dim, dim, NULL, NULL, NULL, sing_ref);
+            for(i=0; i<dim; i++)
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, sing_ref[i], sing[b*dim+i]);
+        }
 
-    /* test2 */
-    int input2[12] = {1, 10, 1, 3, 1, 3, 4, 7, 8, 10, 10, 2};
-    int uniqueVals_ref2[7] = {1, 3, 4, 7, 8, 10, 2};
-    int uniqueInds_ref2[7] = {4, 5, 6, 7, 8, 10, 11};
-    unique_i(input2, 12, &uniqueVals, &uniqueInds, &nUnique);
-    TEST_ASSERT_EQUAL(7, nUnique);
-    for(i=0; i<nUnique; i++){
-        TEST_ASSERT_EQUAL(uniqueVals_ref2[i], uniqueVals[i]);
-        TEST_ASSERT_EQUAL(uniqueInds_ref2[i], uniqueInds[i]);
+        /* clean-up */
+        free(A);
+        free(Asym);
+        free(B);
+        free(X);
+        free(X_ref);
+        free(sing);
+        free(sing_ref);
     }
-    free(uniqueVals);
-    free(uniqueInds);
 }
 
-void test__realloc2d_r(void){
-    int s, r, i, j, k;
-    typedef struct _test_data{
-        int ID;
-        float val1, val2;
-    }test_data;
-    test_data** test;
+void test__utility_transposeFreeSolvers(void){
+    int i, j, t, dim1, dim2;
+    void* hWork;
+    float* As, *Ss, *Bs, *Xs, *Us, *Vs, *sing, *sing_ref, *US;
+    float_complex* A, *Asym, *Asym_cm, *B, *B_cm, *X, *U, *S, *V, *US_c, *R;
 
-    /* Configure reference data structures */
-    test_data reference[6][6];
-    for(i=0, k=0; i<6; i++){
-        for(j=0; j<6; j++, k++){
-            reference[i][j].ID = k;
-            rand_m1_1(&reference[i][j].val1,1);
-            rand_m1_1(&reference[i][j].val2,1);
+    /* Config */
+    const float acceptedTolerance = 0.001f;
+    const int nCol = 3;
+    const int dim1ToTest[3] = {1, 6, 3};
+    const int dim2ToTest[3] = {1, 3, 6};
+    const float_complex calpha = cmplxf(1.0f, 0.0f), cbeta = cmplxf(0.0f, 0.0f);
+
+    for(t=0; t<3; t++){
+        dim1 = dim1ToTest[t];
+        dim2 = dim2ToTest[t];
+        As = malloc1d(dim1*dim2*sizeof(float));
+        Ss = malloc1d(dim1*MAX(dim2,nCol)*sizeof(float));
+        Bs = malloc1d(dim1*nCol*sizeof(float));
+        Xs = malloc1d(dim1*nCol*sizeof(float));
+        Us = malloc1d(dim1*dim1*sizeof(float));
+        Vs = malloc1d(dim2*dim2*sizeof(float));
+        US = malloc1d(dim1*dim2*sizeof(float));
+        sing = malloc1d(dim1*sizeof(float));
+        sing_ref = malloc1d(dim1*sizeof(float));
+        A = malloc1d(dim1*dim2*sizeof(float_complex));
+        Asym = malloc1d(dim1*dim1*sizeof(float_complex));
+        Asym_cm = malloc1d(dim1*dim1*sizeof(float_complex));
+        B = malloc1d(dim1*nCol*sizeof(float_complex));
+        B_cm = malloc1d(dim1*nCol*sizeof(float_complex));
+        X = malloc1d(dim1*MAX(dim1,nCol)*sizeof(float_complex));
+        U = malloc1d(dim1*dim1*sizeof(float_complex));
+        S = malloc1d(dim1*dim2*sizeof(float_complex));
+        V = malloc1d(dim2*dim2*sizeof(float_complex));
+        US_c = malloc1d(dim1*dim2*sizeof(float_complex));
+        R = malloc1d(dim1*MAX(dim1,MAX(dim2,nCol))*sizeof(float_complex));
+        rand_m1_1(As, dim1*dim2);
+        rand_m1_1(Bs, dim1*nCol);
+        rand_m1_1((float*)A, 2*dim1*dim2);
+        rand_m1_1((float*)B, 2*dim1*nCol);
+
+        /* Real SVD: A = U*S*V^T */
+        utility_ssvd(As, dim1, dim2, Us, Ss, Vs, sing_ref);
+        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, dim1, dim2, dim1, 1.0f,
+                    Us, dim1, Ss, dim2, 0.0f, US, dim2);
+        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasTrans, dim1, dim2, dim2, 1.0f,
+                    US, dim2, Vs, dim2, 0.0f, Ss, dim2);
+        for(i=0; i<dim1*dim2; i++)
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, As[i], Ss[i]);
+        utility_ssvd(As, dim1, dim2, NULL, NULL, NULL, sing);
+        for(i=0; i<MIN(dim1,dim2); i++)
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, sing_ref[i], sing[i]);
+
+        /* Complex SVD: A = U*S*V^H */
+        utility_csvd(A, dim1, dim2, U, S, V, sing_ref);
+        cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, dim1, dim2, dim1, &calpha,
+                    U, dim1, S, dim2, &cbeta, US_c, dim2);
+        cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasConjTrans, dim1, dim2, dim2, &calpha,
+                    US_c, dim2, V, dim2, &cbeta, R, dim2);
+        for(i=0; i<dim1*dim2; i++){
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, crealf(A[i]), crealf(R[i]));
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, cimagf(A[i]), cimagf(R[i]));
         }
-    }
 
-    /* Starting size */
-    test = (test_data**)malloc2d(1,3,sizeof(test_data));
-    for(s=0; s<1; s++)
-        for(r=0; r<3; r++)
-            memcpy(&test[s][r], &reference[s][r], sizeof(test_data));
+        /* Symmetric/Hermitian positive-definite matrices: A*A^T + I */
+        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasTrans, dim1, dim1, dim2, 1.0f,
+                    As, dim2, As, dim2, 0.0f, Us, dim1);
+        cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasConjTrans, dim1, dim1, dim2, &calpha,
+                    A, dim2, A, dim2, &cbeta, Asym, dim1);
+        for(i=0; i<dim1; i++){
+            Us[i*dim1+i] += 1.0f;
+            Asym[i*dim1+i] = ccaddf(Asym[i*dim1+i], cmplxf(1.0f, 0.0f));
+        }
+        for(i=0; i<dim1; i++)
+            for(j=0; j<dim1; j++)
+                Asym_cm[j*dim1+i] = Asym[i*dim1+j];
+        for(i=0; i<dim1; i++)
+            for(j=0; j<nCol; j++)
+                B_cm[j*dim1+i] = B[i*nCol+j];
+
+        /* Linear solvers: A*X = B */
+        utility_sslslv(Us, dim1, Bs, nCol, Xs);
+        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, dim1, nCol, dim1, 1.0f,
+                    Us, dim1, Xs, nCol, 0.0f, Ss, nCol);
+        for(i=0; i<dim1*nCol; i++)
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, Bs[i], Ss[i]);
+        utility_cslslv(Asym, dim1, B, nCol, X);
+        cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, dim1, nCol, dim1, &calpha,
+                    Asym, dim1, X, nCol, &cbeta, R, nCol);
+        for(i=0; i<dim1*nCol; i++){
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, crealf(B[i]), crealf(R[i]));
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, cimagf(B[i]), cimagf(R[i]));
+        }
+        utility_cslslv_create(&hWork, dim1, nCol);
+        utility_cslslv_cm_ws(hWork, Asym_cm, dim1, B_cm, nCol, X);
+        utility_cslslv_destroy(&hWork);
+        cblas_cgemm(CblasColMajor, CblasNoTrans, CblasNoTrans, dim1, nCol, dim1, &calpha,
+                    Asym_cm, dim1, X, dim1, &cbeta, R, dim1);
+        for(i=0; i<dim1*nCol; i++){
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, crealf(B_cm[i]), crealf(R[i]));
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, cimagf(B_cm[i]), cimagf(R[i]));
+        }
 
-    /* Check that increasing the size of the array, still retains the previous data */
-    test = (test_data**)realloc2d_r((void**)test, 4, 3, 1, 3, sizeof(test_data));
-    for(i=0; i<1; i++){
-        for(j=0; j<3; j++){
-            TEST_ASSERT_TRUE(test[i][j].ID==reference[i][j].ID);
-            TEST_ASSERT_TRUE(test[i][j].val1==reference[i][j].val1);
-            TEST_ASSERT_TRUE(test[i][j].val2==reference[i][j].val2);
+        /* Cholesky: A = X^H*X */
+        utility_cchol(Asym, dim1, X);
+        cblas_cgemm(CblasRowMajor, CblasConjTrans, CblasNoTrans, dim1, dim1, dim1, &calpha,
+                    X, dim1, X, dim1, &cbeta, R, dim1);
+        for(i=0; i<dim1*dim1; i++){
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, crealf(Asym[i]), crealf(R[i]));
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, cimagf(Asym[i]), cimagf(R[i]));
         }
-    }
 
-    /* Check that new data can then be added and indexed correctly */
-    for(s=1; s<4; s++)
-        for(r=0; r<3; r++)
-             memcpy(&test[s][r], &reference[s][r], sizeof(test_data));
-    for(i=0; i<4; i++){
-        for(j=0; j<3; j++){
-            TEST_ASSERT_TRUE(test[i][j].ID==reference[i][j].ID);
-            TEST_ASSERT_TRUE(test[i][j].val1==reference[i][j].val1);
-            TEST_ASSERT_TRUE(test[i][j].val2==reference[i][j].val2);
+        /* Hermitian eigenvalue decomposition: A*V = V*D (row-major) */
+        utility_cseig(Asym, dim1, 1, U, NULL, sing_ref);
+        cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, dim1, dim1, dim1, &calpha,
+                    Asym, dim1, U, dim1, &cbeta, R, dim1);
+        for(i=0; i<dim1; i++){
+            for(j=0; j<dim1; j++){
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, sing_ref[j]*crealf(U[i*dim1+j]), crealf(R[i*dim1+j]));
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, sing_ref[j]*cimagf(U[i*dim1+j]), cimagf(R[i*dim1+j]));
+            }
         }
-    }
 
-    /* Check that the array can be shrunk, but still retain the original data (except truncated) */
-    test = (test_data**)realloc2d_r((void**)test, 4, 2, 4, 3, sizeof(test_data));
-    for(i=0; i<4; i++){
-        for(j=0; j<2; j++){
-            TEST_ASSERT_TRUE(test[i][j].ID==reference[i][j].ID);
-            TEST_ASSERT_TRUE(test[i][j].val1==reference[i][j].val1);
-            TEST_ASSERT_TRUE(test[i][j].val2==reference[i][j].val2);
+        /* ... and column-major, with eigenvectors as contiguous columns */
+        utility_cseig_create(&hWork, dim1);
+        utility_cseig_cm_ws(hWork, Asym_cm, dim1, 1, U, sing);
+        utility_cseig_destroy(&hWork);
+        cblas_cgemm(CblasColMajor, CblasNoTrans, CblasNoTrans, dim1, dim1, dim1, &calpha,
+                    Asym_cm, dim1, U, dim1, &cbeta, R, dim1);
+        for(j=0; j<dim1; j++){
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, sing_ref[j], sing[j]);
+            for(i=0; i<dim1; i++){
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, sing[j]*crealf(U[j*dim1+i]), crealf(R[j*dim1+i]));
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, sing[j]*cimagf(U[j*dim1+i]), cimagf(R[j*dim1+i]));
+            }
         }
-    }
 
-    /* clean-up */
-    free(test);
+        /* clean-up */
+        free(As);
+        free(Ss);
+        free(Bs);
+        free(Xs);
+        free(Us);
+        free(Vs);
+        free(US);
+        free(sing);
+        free(sing_ref);
+        free(A);
+        free(Asym);
+        free(Asym_cm);
+        free(B);
+        free(B_cm);
+        free(X);
+        free(U);
+        free(S);
+        free(V);
+        free(US_c);
+        free(R);
+    }
 }
 
 void test__formulate_M_and_Cr(void){
@@ -1361,6 +2985,223 @@ void test__getSHreal_recur(void){
     }
 }
 
+void test__saf_shEvaluator(void){
+    int i, j, o;
+    void* hSHE;
+
+    /* Config */
+    const float acceptedTolerance = 0.0001f;
+    const float acceptedTolerance_interp = 0.005f;
+    const int maxOrder = 15;
+    const int nDirs = 300; /* (not a multiple of the block size) */
+    const int testOrders[3] = {15, 4, 0};
+    float dirs[300][2], Y[ORDER2NSH(15)*300], Y_ref[ORDER2NSH(15)*300];
+
+    /* Random directions, with the azimuths also outside of [-pi pi] */
+    for(i=0; i<nDirs; i++){
+        rand_m1_1(&dirs[i][0], 1);
+        rand_0_1(&dirs[i][1], 1);
+        dirs[i][0] *= 3.0f*M_PI;
+        dirs[i][1] *= M_PI;
+    }
+    dirs[0][1] = 0.0f;  /* poles */
+    dirs[1][1] = M_PI;
+
+    /* Exact evaluation, for several orders with the same evaluator */
+    saf_shEvaluator_create(&hSHE, maxOrder, 0.0f);
+    for(o=0; o<3; o++){
+        getSHreal(testOrders[o], (float*)dirs, nDirs, Y_ref);
+        saf_shEvaluator_getSHreal(hSHE, testOrders[o], (float*)dirs, nDirs, Y);
+        for(i=0; i<ORDER2NSH(testOrders[o]); i++)
+            for(j=0; j<nDirs; j++)
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, Y_ref[i*nDirs+j], Y[i*nDirs+j]);
+    }
+
+    /* Without a table, the interpolated variant should revert to the above */
+    saf_shEvaluator_getSHrealInterp(hSHE, 4, (float*)dirs, nDirs, Y);
+    getSHreal(4, (float*)dirs, nDirs, Y_ref);
+    for(i=0; i<ORDER2NSH(4)*nDirs; i++)
+        TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, Y_ref[i], Y[i]);
+    saf_shEvaluator_destroy(&hSHE);
+
+    /* Table look-up with bilinear interpolation (1 degree resolution) */
+    saf_shEvaluator_create(&hSHE, 4, 1.0f);
+    saf_shEvaluator_getSHrealInterp(hSHE, 4, (float*)dirs, nDirs, Y);
+    for(i=0; i<ORDER2NSH(4)*nDirs; i++)
+        TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance_interp, Y_ref[i], Y[i]);
+    saf_shEvaluator_destroy(&hSHE);
+
+    /* Resolution which divides neither 360 nor 180 (7 degrees), evaluated
+     * also near the azimuth wrap-around and the lower pole */
+    for(i=0; i<nDirs; i++){
+        dirs[i][0] = (float)i*2.0f*M_PI/(float)nDirs - 0.02f;
+        dirs[i][1] = (float)(i%31)*M_PI/30.0f;
+    }
+    getSHreal(4, (float*)dirs, nDirs, Y_ref);
+    saf_shEvaluator_create(&hSHE, 4, 7.0f);
+    saf_shEvaluator_getSHrealInterp(hSHE, 4, (float*)dirs, nDirs, Y);
+    for(i=0; i<ORDER2NSH(4)*nDirs; i++)
+        TEST_ASSERT_FLOAT_WITHIN(0.05f, Y_ref[i], Y[i]);
+    saf_shEvaluator_destroy(&hSHE);
+}
+
+void test__saf_shGridCache(void){
+    int i, nDirs, nSH;
+    float* grid_dirs_deg, *Y_ref;
+    const float* Y1, *Y2, *Y3, *Y4;
+    const float_complex* Yc;
+
+    /* Config */
+    const float acceptedTolerance = 0.00001f;
+    const int order = 4;
+    const float scale = 0.5f;
+
+    /* Use a copy of a built-in grid, such that the matching is by value */
+    nDirs = __geosphere_ico_nPoints[3];
+    nSH = ORDER2NSH(order);
+    grid_dirs_deg = malloc1d(nDirs*2*sizeof(float));
+    memcpy(grid_dirs_deg, __HANDLES_geosphere_ico_dirs_deg[3], nDirs*2*sizeof(float));
+    Y_ref = malloc1d(nSH*nDirs*sizeof(float));
+    getRSH(order, grid_dirs_deg, nDirs, Y_ref);
+
+    /* Identical requests should share the same matrix */
+    Y1 = saf_shGridCache_acquireReal(order, (float*)__HANDLES_geosphere_ico_dirs_deg[3], nDirs, scale);
+    Y2 = saf_shGridCache_acquireReal(order, grid_dirs_deg, nDirs, scale);
+    TEST_ASSERT_TRUE(Y1==Y2);
+    for(i=0; i<nSH*nDirs; i++)
+        TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, scale*Y_ref[i], Y1[i]);
+
+    /* Whereas a different scaling, order or type should not */
+    Y3 = saf_shGridCache_acquireReal(order, grid_dirs_deg, nDirs, 1.0f);
+    Y4 = saf_shGridCache_acquireReal(order-1, grid_dirs_deg, nDirs, scale);
+    Yc = saf_shGridCache_acquireCmplx(order, grid_dirs_deg, nDirs, scale);
+    TEST_ASSERT_TRUE(Y3!=Y1 && Y4!=Y1 && (const void*)Yc!=(const void*)Y1);
+    for(i=0; i<nSH*nDirs; i++){
+        TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, Y_ref[i], Y3[i]);
+        TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, scale*Y_ref[i], crealf(Yc[i]));
+        TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, 0.0f, cimagf(Yc[i]));
+    }
+
+    /* The matrix should remain valid until its last user releases it */
+    saf_shGridCache_release(Y1);
+    for(i=0; i<nSH*nDirs; i++)
+        TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, scale*Y_ref[i], Y2[i]);
+    saf_shGridCache_release(Y2);
+    saf_shGridCache_release(Y3);
+    saf_shGridCache_release(Y4);
+    saf_shGridCache_release(Yc);
+    saf_shGridCache_release(NULL);
+
+    /* clean-up */
+    free(grid_dirs_deg);
+    free(Y_ref);
+}
+
+void test__saf_pmapEngine(void){
+    int i, j, nDirs, nSH, ind, rep;
+    void* hPM;
+    float* grid_dirs_deg, *Y, *pmap_ref, *pmap_ref2, *pmap;
+    float_complex* Y_grid, *Y_grid_sparse, *Cx, *w_ref, *w;
+
+    /* Config */
+    const float acceptedTolerance = 0.001f; /* (relative) */
+    const int order = 3;
+    const int srcIdx = 100;  /* source is placed at this grid direction */
+
+    /* Dense grid, such that it is split over all threads */
+    nDirs = __geosphere_ico_nPoints[9];
+    grid_dirs_deg = (float*)__HANDLES_geosphere_ico_dirs_deg[9];
+    nSH = ORDER2NSH(order);
+    Y = malloc1d(nSH*nDirs*sizeof(float));
+    getRSH(order, grid_dirs_deg, nDirs, Y);
+    Y_grid = malloc1d(nSH*nDirs*sizeof(float_complex));
+    for(i=0; i<nSH*nDirs; i++)
+        Y_grid[i] = cmplxf(Y[i]/(float)nSH, 0.0f);
+
+    /* One source plus some diffuse noise */
+    Cx = malloc1d(nSH*nSH*sizeof(float_complex));
+    for(i=0; i<nSH; i++)
+        for(j=0; j<nSH; j++)
+            Cx[i*nSH+j] = cmplxf(Y[i*nDirs+srcIdx]*Y[j*nDirs+srcIdx] + (i==j ? 0.05f : 0.0f), 0.0f);
+    pmap_ref = malloc1d(nDirs*sizeof(float));
+    pmap_ref2 = malloc1d(nDirs*sizeof(float));
+    pmap = malloc1d(nDirs*sizeof(float));
+    w_ref = malloc1d(nSH*nDirs*sizeof(float_complex));
+    w = malloc1d(nSH*nDirs*sizeof(float_complex));
+    saf_pmapEngine_create(&hPM, order, nDirs, 3);
+
+    /* PWD */
+    generatePWDmap(order, Cx, Y_grid, nDirs, pmap_ref);
+    saf_pmapEngine_generatePWDmap(hPM, order, Cx, Y_grid, nDirs, pmap);
+    for(i=0; i<nDirs; i++)
+        TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance*fabsf(pmap_ref[i])+1e-9f, pmap_ref[i], pmap[i]);
+
+    /* MVDR (and weights) */
+    generateMVDRmap(order, Cx, Y_grid, nDirs, 8.0f, pmap_ref, w_ref);
+    saf_pmapEngine_generateMVDRmap(hPM, order, Cx, Y_grid, nDirs, 8.0f, pmap, w);
+    for(i=0; i<nDirs; i++)
+        TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance*fabsf(pmap_ref[i])+1e-9f, pmap_ref[i], pmap[i]);
+    for(i=0; i<nSH*nDirs; i++){
+        TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance*cabsf(w_ref[i])+1e-6f, crealf(w_ref[i]), crealf(w[i]));
+        TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance*cabsf(w_ref[i])+1e-6f, cimagf(w_ref[i]), cimagf(w[i]));
+    }
+
+    /* CroPaC LCMV */
+    generateCroPaCLCMVmap(order, Cx, Y_grid, nDirs, 8.0f, 0.0f, pmap_ref);
+    saf_pmapEngine_generateCroPaCLCMVmap(hPM, order, Cx, Y_grid, nDirs, 8.0f, 0.0f, pmap);
+    for(i=0; i<nDirs; i++)
+        TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance*fabsf(pmap_ref[i])+1e-9f, pmap_ref[i], pmap[i]);
+
+    /* MUSIC */
+    generateMUSICmap(order, Cx, Y_grid, 1, nDirs, 1, pmap_ref);
+    saf_pmapEngine_generateMUSICmap(hPM, order, Cx, Y_grid, 1, nDirs, 1, pmap);
+    for(i=0; i<nDirs; i++)
+        TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance*fabsf(pmap_ref[i])+1e-6f, pmap_ref[i], pmap[i]);
+    utility_simaxv(pmap, nDirs, &ind);
+    TEST_ASSERT_TRUE(ind==srcIdx);
+
+    /* MinNorm */
+    saf_pmapEngine_generateMinNormMap(hPM, order, Cx, Y_grid, 1, nDirs, 0, pmap);
+    utility_simaxv(pmap, nDirs, &ind);
+    TEST_ASSERT_TRUE(ind==srcIdx);
+
+    /* Back-to-back calls of different types (the calling thread never waits
+     * for the workers, so they may still be busy with the previous call) */
+    generatePWDmap(order, Cx, Y_grid, nDirs, pmap_ref);
+    generateCroPaCLCMVmap(order, Cx, Y_grid, nDirs, 8.0f, 0.0f, pmap_ref2);
+    for(rep=0; rep<50; rep++){
+        saf_pmapEngine_generatePWDmap(hPM, order, Cx, Y_grid, nDirs, pmap);
+        for(i=0; i<nDirs; i++)
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance*fabsf(pmap_ref[i])+1e-9f, pmap_ref[i], pmap[i]);
+        saf_pmapEngine_generateCroPaCLCMVmap(hPM, order, Cx, Y_grid, nDirs, 8.0f, 0.0f, pmap);
+        for(i=0; i<nDirs; i++)
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance*fabsf(pmap_ref2[i])+1e-9f, pmap_ref2[i], pmap[i]);
+    }
+
+    /* Sparse grid (processed by the calling thread only); note that the
+     * steering vectors of previous calls must not be modified while the engine
+     * exists */
+    Y_grid_sparse = malloc1d(nSH*50*sizeof(float_complex));
+    for(i=0; i<nSH; i++)
+        memcpy(&Y_grid_sparse[i*50], &Y_grid[i*nDirs], 50*sizeof(float_complex));
+    generatePWDmap(order, Cx, Y_grid_sparse, 50, pmap_ref);
+    saf_pmapEngine_generatePWDmap(hPM, order, Cx, Y_grid_sparse, 50, pmap);
+    for(i=0; i<50; i++)
+        TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance*fabsf(pmap_ref[i])+1e-9f, pmap_ref[i], pmap[i]);
+
+    /* clean-up */
+    saf_pmapEngine_destroy(&hPM);
+    free(Y);
+    free(Y_grid);
+    free(Y_grid_sparse);
+    free(Cx);
+    free(pmap_ref);
+    free(pmap_ref2);
+    free(pmap);
+    free(w_ref);
+    free(w);
+}
+
 void test__getSHcomplex(void){
     int i, j, k, order, nDirs, nSH;
     float_complex scale;
@@ -1481,6 +3322,190 @@ void test__getSHrotMtxReal(void){
     free(Mrot);
 }
 
+void test__getSHrotMtxRealBlocks(void){
+    int i, j, k, l, order, nSH, bandIdx, blockIdx;
+    float Rzyx[3][3];
+    float* RotBlocks, **Mrot;
+    float sum;
+
+    /* Config */
+    const float acceptedTolerance = 0.0001f;
+    order = 10;
+
+    /* The blocks should be the diagonal blocks of getSHrotMtxReal() */
+    nSH = ORDER2NSH(order);
+    Mrot = (float**)malloc2d(nSH, nSH, sizeof(float));
+    RotBlocks = malloc1d(ORDER2NSHROT(order)*sizeof(float));
+    yawPitchRoll2Rzyx(0.7f, -0.3f, 1.9f, 1, Rzyx);
+    getSHrotMtxReal(Rzyx, FLATTEN2D(Mrot), order);
+    getSHrotMtxRealBlocks(Rzyx, RotBlocks, order);
+    bandIdx = blockIdx = 0;
+    for(l=0; l<=order; l++){
+        for(i=0; i<2*l+1; i++){
+            for(j=0; j<2*l+1; j++){
+                TEST_ASSERT_EQUAL_FLOAT(Mrot[bandIdx+i][bandIdx+j], RotBlocks[blockIdx + i*(2*l+1) + j]);
+
+                /* and each block should be orthonormal */
+                sum = 0.0f;
+                for(k=0; k<2*l+1; k++)
+                    sum += RotBlocks[blockIdx + i*(2*l+1) + k] * RotBlocks[blockIdx + j*(2*l+1) + k];
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, i==j ? 1.0f : 0.0f, sum);
+            }
+        }
+        bandIdx += 2*l+1;
+        blockIdx += (2*l+1)*(2*l+1);
+    }
+    TEST_ASSERT_EQUAL_INT(ORDER2NSHROT(order), blockIdx);
+    free(Mrot);
+    free(RotBlocks);
+}
+
+void test__applySHblockMtx(void){
+    int i, j, b, order, nSH, nRot;
+    float Rzyx[3][3];
+    float* A, *A_full, *X, *Y, *Y_ref;
+    float_complex* A_c, *A_full_c, *X_c, *Y_c, *Y_ref_c;
+    const float_complex calpha = cmplxf(1.0f, 0.0f), cbeta = cmplxf(0.0f, 0.0f);
+    const float_complex scale = cmplxf(0.3f, -0.7f);
+
+    /* Config */
+    const float acceptedTolerance = 0.0001f;
+    const int nCols = 37;
+    const int ld = 40;     /* padded rows */
+    const int nBatch = 5;
+    order = 7;
+
+    /* prep (dense versions as the reference) */
+    nSH = ORDER2NSH(order);
+    nRot = ORDER2NSHROT(order);
+    A = malloc1d(nRot*sizeof(float));
+    A_full = malloc1d(nSH*nSH*sizeof(float));
+    A_c = malloc1d(nRot*sizeof(float_complex));
+    A_full_c = malloc1d(nSH*nSH*sizeof(float_complex));
+    yawPitchRoll2Rzyx(-0.2f, 1.1f, 2.5f, 0, Rzyx);
+    getSHrotMtxRealBlocks(Rzyx, A, order);
+    getSHrotMtxReal(Rzyx, A_full, order);
+    for(i=0; i<nRot; i++)
+        A_c[i] = crmulf(scale, A[i]);
+    for(i=0; i<nSH*nSH; i++)
+        A_full_c[i] = crmulf(scale, A_full[i]);
+    X = malloc1d(nSH*ld*sizeof(float));
+    Y = calloc1d(nSH*ld, sizeof(float));
+    Y_ref = malloc1d(nSH*ld*sizeof(float));
+    X_c = malloc1d(nBatch*nSH*ld*sizeof(float_complex));
+    Y_c = calloc1d(nBatch*nSH*ld, sizeof(float_complex));
+    Y_ref_c = malloc1d(nBatch*nSH*ld*sizeof(float_complex));
+    rand_m1_1(X, nSH*ld);
+    rand_m1_1((float*)X_c, 2*nBatch*nSH*ld);
+
+    /* Real-valued signals */
+    applySHblockMtx(A, order, X, ld, nCols, Y, ld);
+    cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nSH, nCols, nSH, 1.0f,
+                A_full, nSH,
+                X, ld, 0.0f,
+                Y_ref, ld);
+    for(i=0; i<nSH; i++){
+        for(j=0; j<nCols; j++)
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, Y_ref[i*ld+j], Y[i*ld+j]);
+        for(; j<ld; j++)
+            TEST_ASSERT_EQUAL_FLOAT(0.0f, Y[i*ld+j]); /* padding is not written */
+    }
+
+    /* Complex-valued signals, with real and complex-valued matrices */
+    applySHblockMtxToCmplx(A, order, X_c, ld, nSH*ld, nCols, nBatch, Y_c, ld, nSH*ld);
+    for(b=0; b<nBatch; b++){
+        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nSH, 2*nCols, nSH, 1.0f,
+                    A_full, nSH,
+                    (float*)&X_c[b*nSH*ld], 2*ld, 0.0f,
+                    (float*)&Y_ref_c[b*nSH*ld], 2*ld);
+        for(i=0; i<nSH; i++){
+            for(j=0; j<nCols; j++){
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, crealf(Y_ref_c[b*nSH*ld+i*ld+j]), crealf(Y_c[b*nSH*ld+i*ld+j]));
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, cimagf(Y_ref_c[b*nSH*ld+i*ld+j]), cimagf(Y_c[b*nSH*ld+i*ld+j]));
+            }
+        }
+    }
+    applySHblockMtxCmplx(A_c, order, X_c, ld, nSH*ld, nCols, nBatch, Y_c, ld, nSH*ld);
+    for(b=0; b<nBatch; b++){
+        cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nSH, nCols, nSH, &calpha,
+                    A_full_c, nSH,
+                    &X_c[b*nSH*ld], ld, &cbeta,
+                    &Y_ref_c[b*nSH*ld], ld);
+        for(i=0; i<nSH; i++){
+            for(j=0; j<nCols; j++){
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, crealf(Y_ref_c[b*nSH*ld+i*ld+j]), crealf(Y_c[b*nSH*ld+i*ld+j]));
+                TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, cimagf(Y_ref_c[b*nSH*ld+i*ld+j]), cimagf(Y_c[b*nSH*ld+i*ld+j]));
+            }
+        }
+    }
+
+    /* tidy-up */
+    free(A);
+    free(A_full);
+    free(A_c);
+    free(A_full_c);
+    free(X);
+    free(Y);
+    free(Y_ref);
+    free(X_c);
+    free(Y_c);
+    free(Y_ref_c);
+}
+
+void test__quaternion(void){
+    int i, j, t, rpy;
+    float ypr[3], ypr_test[3], R[3][3], R_test[3][3], Q[4], Q0[4], Q1[4], Qm[4];
+    float d0, d1;
+
+    /* Config */
+    const float acceptedTolerance = 0.0001f;
+    const float ypr_test_rad[4][3] = { {0.0f, 0.0f, 0.0f}, {0.4f, -1.2f, 2.9f},
+                                       {-3.0f, 0.1f, -0.6f}, {1.5f, 1.4f, 0.05f} };
+
+    for(rpy=0; rpy<2; rpy++){
+        for(t=0; t<4; t++){
+            memcpy(ypr, ypr_test_rad[t], 3*sizeof(float));
+            yawPitchRoll2Rzyx(ypr[0], ypr[1], ypr[2], rpy, R);
+
+            /* rotation matrix -> unit quaternion -> rotation matrix */
+            rotationMatrix2quaternion(R, Q);
+            TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, 1.0f, Q[0]*Q[0]+Q[1]*Q[1]+Q[2]*Q[2]+Q[3]*Q[3]);
+            quaternion2rotationMatrix(Q, R_test);
+            for(i=0; i<3; i++)
+                for(j=0; j<3; j++)
+                    TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, R[i][j], R_test[i][j]);
+
+            /* rotation matrix -> angles -> rotation matrix */
+            rotationMatrix2yawPitchRoll(R, rpy, &ypr_test[0], &ypr_test[1], &ypr_test[2]);
+            yawPitchRoll2Rzyx(ypr_test[0], ypr_test[1], ypr_test[2], rpy, R_test);
+            for(i=0; i<3; i++)
+                for(j=0; j<3; j++)
+                    TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, R[i][j], R_test[i][j]);
+        }
+    }
+
+    /* Slerp should start/end at the two rotations, and the mid-point should be
+     * equidistant from both (given as Q1 on the far hemisphere, to check that
+     * the shortest path is taken) */
+    yawPitchRoll2Rzyx(0.3f, -0.2f, 0.1f, 0, R);
+    rotationMatrix2quaternion(R, Q0);
+    yawPitchRoll2Rzyx(-1.1f, 0.6f, 0.9f, 0, R);
+    rotationMatrix2quaternion(R, Q1);
+    for(i=0; i<4; i++)
+        Q1[i] = -Q1[i];
+    quaternionSlerp(Q0, Q1, 0.0f, Q);
+    for(i=0; i<4; i++)
+        TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, Q0[i], Q[i]);
+    quaternionSlerp(Q0, Q1, 1.0f, Q);
+    for(i=0; i<4; i++)
+        TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, -Q1[i], Q[i]);
+    quaternionSlerp(Q0, Q1, 0.5f, Qm);
+    d0 = fabsf(Qm[0]*Q0[0] + Qm[1]*Q0[1] + Qm[2]*Q0[2] + Qm[3]*Q0[3]);
+    d1 = fabsf(Qm[0]*Q1[0] + Qm[1]*Q1[1] + Qm[2]*Q1[2] + Qm[3]*Q1[3]);
+    TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, d0, d1);
+    TEST_ASSERT_TRUE(Qm[0]*Q0[0] + Qm[1]*Q0[1] + Qm[2]*Q0[2] + Qm[3]*Q0[3] > 0.0f);
+}
+
 void test__real2complexSHMtx(void){
     int o, it, j, nSH, order;
     float* Y_real_ref;
@@ -1909,7 +3934,7 @@ void test__saf_example_ambi_bin(void){
                 FLATTEN2D(shSig), signalLength);
 
     /* Decode to binaural */
-    framesize = ambi_bin_getFrameSize();
+    framesize = ambi_bin_getFrameSizeEx(hAmbi);
     binSig = (float**)calloc2d(NUM_EARS,signalLength,sizeof(float));
     shSig_frame = (float**)malloc1d(nSH*sizeof(float*));
     binSig_frame = (float**)malloc1d(NUM_EARS*sizeof(float*));
@@ -1988,7 +4013,7 @@ void test__saf_example_ambi_dec(void){
                 FLATTEN2D(shSig), signalLength);
 
     /* Decode to loudspeakers */
-    framesize = ambi_dec_getFrameSize();
+    framesize = ambi_dec_getFrameSizeEx(hAmbi);
     lsSig = (float**)calloc2d(22,signalLength,sizeof(float));
     shSig_frame = (float**)malloc1d(nSH*sizeof(float*));
     lsSig_frame = (float**)malloc1d(22*sizeof(float*));
@@ -2021,6 +4046,251 @@ void test__saf_example_ambi_dec(void){
     free(lsSig_frame);
 }
 
+void test__saf_example_frameSizes(void){
+    int nSH, i, j, ch, max_ind, framesize, test, k;
+    void* hAmbi, *hAmbi_il, *hDec;
+    float loudspeakerEnergy[22], direction_deg[2];
+    float* inSig, *y, *shSig_il, *lsSig_il;
+    float** shSig, **lsSig, **shSig_frame, **lsSig_frame;
+
+    /* Config */
+    const int order = 2;
+    const int fs = 48000;
+    const int signalLength = fs;
+    const int frameSizes[3] = {64, 512, 100 /* invalid; reverts to the default */};
+    const int expectedFrameSizes[3] = {64, 512, DEFAULT_TF_FRAME_SIZE};
+
+    /* Encode a plane-wave towards loudspeaker 8 of the 22.x layout */
+    nSH = ORDER2NSH(order);
+    inSig = malloc1d(signalLength*sizeof(float));
+    shSig = (float**)malloc2d(nSH,signalLength,sizeof(float));
+    rand_m1_1(inSig, signalLength);
+    direction_deg[0] = 90.0f;
+    direction_deg[1] = 0.0f;
+    y = malloc1d(nSH*sizeof(float));
+    getRSH(order, (float*)direction_deg, 1, y);
+    cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nSH, signalLength, 1, 1.0f,
+                y, 1,
+                inSig, signalLength, 0.0f,
+                FLATTEN2D(shSig), signalLength);
+    lsSig = (float**)calloc2d(22,signalLength,sizeof(float));
+    shSig_frame = (float**)malloc1d(nSH*sizeof(float*));
+    lsSig_frame = (float**)malloc1d(22*sizeof(float*));
+    shSig_il = malloc1d(nSH*signalLength*sizeof(float));
+    lsSig_il = malloc1d(22*signalLength*sizeof(float));
+    for(i=0; i<signalLength; i++)
+        for(ch=0; ch<nSH; ch++)
+            shSig_il[i*nSH+ch] = shSig[ch][i];
+
+    for(test=0; test<3; test++){
+        /* Create two instances of ambi_dec with the frame size of this test
+         * (the second is driven with interleaved buffers) */
+        for(k=0; k<2; k++){
+            ambi_dec_createWithFrameSize(k==0 ? &hAmbi : &hAmbi_il, frameSizes[test]);
+            hDec = k==0 ? hAmbi : hAmbi_il;
+            ambi_dec_init(hDec, fs);
+            ambi_dec_setNormType(hDec, NORM_N3D);
+            ambi_dec_setMasterDecOrder(hDec, (SH_ORDERS)order);
+            ambi_dec_setOutputConfigPreset(hDec, LOUDSPEAKER_ARRAY_PRESET_22PX);
+            ambi_dec_setDecMethod(hDec, DECODING_METHOD_SAD, 0);
+            ambi_dec_setDecMethod(hDec, DECODING_METHOD_SAD, 1);
+            ambi_dec_setLowDelayMode(hDec, test==1); /* also try the low-delay afSTFT */
+            srand(test); /* the triangulation (convhull_3d) adds random noise */
+            ambi_dec_initCodec(hDec);
+        }
+
+        /* The frame size, number of bands, and delay should all follow */
+        framesize = ambi_dec_getFrameSizeEx(hAmbi);
+        TEST_ASSERT_EQUAL_INT(expectedFrameSizes[test], framesize);
+        TEST_ASSERT_EQUAL_INT(framesize+5, ambi_dec_getNumberOfBandsEx(hAmbi));
+        TEST_ASSERT_EQUAL_INT((test==1 ? 7 : 12)*framesize, ambi_dec_getProcessingDelayEx(hAmbi));
+        if(test==2){
+            /* (the getters without a handle describe a default instance) */
+            TEST_ASSERT_EQUAL_INT(ambi_dec_getFrameSize(), framesize);
+            TEST_ASSERT_EQUAL_INT(ambi_dec_getNumberOfBands(), ambi_dec_getNumberOfBandsEx(hAmbi));
+            TEST_ASSERT_EQUAL_INT(ambi_dec_getProcessingDelay(), ambi_dec_getProcessingDelayEx(hAmbi));
+        }
+
+        /* Decode to loudspeakers */
+        memset(FLATTEN2D(lsSig), 0, 22*signalLength*sizeof(float));
+        for(i=0; i<signalLength/framesize; i++){
+            for(ch=0; ch<nSH; ch++)
+                shSig_frame[ch] = &shSig[ch][i*framesize];
+            for(ch=0; ch<22; ch++)
+                lsSig_frame[ch] = &lsSig[ch][i*framesize];
+            ambi_dec_process(hAmbi, shSig_frame, lsSig_frame, nSH, 22, framesize);
+        }
+
+        /* Assert that loudspeaker 8 has the most energy */
+        memset(loudspeakerEnergy, 0, 22*sizeof(float));
+        for(i=0; i<signalLength; i++)
+            for(j=0; j<22; j++)
+                loudspeakerEnergy[j] += powf(fabsf(lsSig[j][i]), 2.0f);
+        utility_simaxv(loudspeakerEnergy, 22, &max_ind);
+        TEST_ASSERT_TRUE(max_ind==7);
+
+        /* Decoding the interleaved signals (in blocks of 3 frames) should give
+         * the same output */
+        for(i=0; i+3*framesize<=signalLength; i+=3*framesize)
+            ambi_dec_processInterleaved(hAmbi_il, &shSig_il[i*nSH], &lsSig_il[i*22], nSH, 22, 3*framesize);
+        for(i=0; i<(signalLength/(3*framesize))*3*framesize; i++)
+            for(j=0; j<22; j++)
+                TEST_ASSERT_FLOAT_WITHIN(1e-5f, lsSig[j][i], lsSig_il[i*22+j]);
+
+        ambi_dec_destroy(&hAmbi);
+        ambi_dec_destroy(&hAmbi_il);
+    }
+
+    /* Clean-up */
+    free(inSig);
+    free(shSig);
+    free(y);
+    free(lsSig);
+    free(shSig_frame);
+    free(lsSig_frame);
+    free(shSig_il);
+    free(lsSig_il);
+}
+
+void test__saf_example_beamformer(void){
+    int nSH, i, ch, test, framesize, delay;
+    void* hBeam;
+    float direction_deg[2];
+    float* inSig, *y;
+    float** shSig, **beamSig, **shSig_frame, **beamSig_frame;
+
+    /* Config */
+    const int order = 3;
+    const int fs = 48000;
+    const int signalLength = fs/4;
+    const int frameSizes[2] = {DEFAULT_TF_FRAME_SIZE, 64};
+
+    /* Create a plane-wave, and encode it into spherical harmonic signals */
+    nSH = ORDER2NSH(order);
+    inSig = malloc1d(signalLength*sizeof(float));
+    rand_m1_1(inSig, signalLength);
+    direction_deg[0] = 45.0f; direction_deg[1] = 10.0f;
+    y = malloc1d(nSH*sizeof(float));
+    getRSH(order, direction_deg, 1, y); /* N3D */
+    shSig = (float**)malloc2d(nSH, signalLength, sizeof(float));
+    cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nSH, signalLength, 1, 1.0f,
+                y, 1,
+                inSig, signalLength, 0.0f,
+                FLATTEN2D(shSig), signalLength);
+    beamSig = (float**)calloc2d(2, signalLength, sizeof(float));
+    shSig_frame = (float**)malloc1d(nSH*sizeof(float*));
+    beamSig_frame = (float**)malloc1d(1*sizeof(float*));
+
+    /* Steer a beam towards the plane-wave, with each frame size */
+    for(test=0; test<2; test++){
+        beamformer_createWithFrameSize(&hBeam, frameSizes[test]);
+        beamformer_init(hBeam, fs);
+        beamformer_setBeamOrder(hBeam, order);
+        beamformer_setNormType(hBeam, NORM_N3D);
+        beamformer_setNumBeams(hBeam, 1);
+        beamformer_setBeamAzi_deg(hBeam, 0, direction_deg[0]);
+        beamformer_setBeamElev_deg(hBeam, 0, direction_deg[1]);
+        framesize = beamformer_getFrameSizeEx(hBeam);
+        TEST_ASSERT_EQUAL_INT(frameSizes[test], framesize);
+        TEST_ASSERT_EQUAL_INT(framesize, beamformer_getProcessingDelayEx(hBeam));
+        if(test==0){
+            TEST_ASSERT_EQUAL_INT(beamformer_getFrameSize(), framesize);
+            TEST_ASSERT_EQUAL_INT(beamformer_getProcessingDelay(), beamformer_getProcessingDelayEx(hBeam));
+        }
+        for(i=0; i<signalLength/framesize; i++){
+            for(ch=0; ch<nSH; ch++)
+                shSig_frame[ch] = &shSig[ch][i*framesize];
+            beamSig_frame[0] = &beamSig[test][i*framesize];
+            beamformer_process(hBeam, shSig_frame, beamSig_frame, nSH, 1, framesize);
+        }
+        beamformer_destroy(&hBeam);
+    }
+
+    /* Once the beam weights have faded in, the outputs should be the same, but
+     * delayed by the respective frame size */
+    delay = frameSizes[0] - frameSizes[1];
+    for(i=2*frameSizes[0]; i<(signalLength/frameSizes[0])*frameSizes[0]; i++)
+        TEST_ASSERT_FLOAT_WITHIN(1e-4f, beamSig[1][i-delay], beamSig[0][i]);
+
+    /* Clean-up */
+    free(inSig);
+    free(y);
+    free(shSig);
+    free(beamSig);
+    free(shSig_frame);
+    free(beamSig_frame);
+}
+
+void test__saf_example_powermap(void){
+    int nSH, i, ch, test, framesize, hopsize, nDirs, pmapWidth, hfov, aspectRatio, max_ind;
+    void* hPm;
+    float direction_deg[2];
+    float* inSig, *y, *grid_dirs, *pmap;
+    float** shSig, **shSig_frame;
+
+    /* Config */
+    const int order = 3;
+    const int fs = 48000;
+    const int signalLength = fs/2;
+    const int hopSizes[3] = {DEFAULT_TF_FRAME_SIZE, 64, 100 /* invalid; reverts to the default */};
+    const int expectedHopSizes[3] = {DEFAULT_TF_FRAME_SIZE, 64, DEFAULT_TF_FRAME_SIZE};
+
+    /* Create a plane-wave, and encode it into spherical harmonic signals */
+    nSH = ORDER2NSH(order);
+    inSig = malloc1d(signalLength*sizeof(float));
+    rand_m1_1(inSig, signalLength);
+    direction_deg[0] = -60.0f; direction_deg[1] = 20.0f;
+    y = malloc1d(nSH*sizeof(float));
+    getRSH(order, direction_deg, 1, y); /* N3D */
+    shSig = (float**)malloc2d(nSH, signalLength, sizeof(float));
+    cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, nSH, signalLength, 1, 1.0f,
+                y, 1,
+                inSig, signalLength, 0.0f,
+                FLATTEN2D(shSig), signalLength);
+    shSig_frame = (float**)malloc1d(nSH*sizeof(float*));
+
+    /* Analyse the plane-wave with each hop size */
+    for(test=0; test<3; test++){
+        powermap_createWithHopSize(&hPm, hopSizes[test]);
+        powermap_init(hPm, (float)fs);
+        powermap_setMasterOrder(hPm, order);
+        powermap_setAnaOrderAllBands(hPm, order);
+        powermap_setNormType(hPm, NORM_N3D);
+        powermap_setPowermapMode(hPm, PM_MODE_PWD);
+        powermap_initCodec(hPm);
+
+        /* The number of bands and delay should follow the hop size, whereas
+         * the frame size does not change */
+        framesize = powermap_getFrameSize();
+        hopsize = powermap_getNumberOfBandsEx(hPm) - 5;
+        TEST_ASSERT_EQUAL_INT(expectedHopSizes[test], hopsize);
+        TEST_ASSERT_EQUAL_INT(framesize + 12*hopsize, powermap_getProcessingDelayEx(hPm));
+        if(test==0){
+            TEST_ASSERT_EQUAL_INT(powermap_getNumberOfBands(), powermap_getNumberOfBandsEx(hPm));
+            TEST_ASSERT_EQUAL_INT(powermap_getProcessingDelay(), powermap_getProcessingDelayEx(hPm));
+        }
+        for(i=0; i<signalLength/framesize; i++){
+            for(ch=0; ch<nSH; ch++)
+                shSig_frame[ch] = &shSig[ch][i*framesize];
+            powermap_requestPmapUpdate(hPm);
+            powermap_analysis(hPm, shSig_frame, nSH, framesize, 1);
+        }
+
+        /* The activity-map should peak towards the plane-wave */
+        TEST_ASSERT_TRUE(powermap_getPmap(hPm, &grid_dirs, &pmap, &nDirs, &pmapWidth, &hfov, &aspectRatio));
+        utility_simaxv(pmap, nDirs, &max_ind);
+        TEST_ASSERT_FLOAT_WITHIN(5.0f, direction_deg[0], grid_dirs[max_ind*2]);
+        TEST_ASSERT_FLOAT_WITHIN(5.0f, direction_deg[1], grid_dirs[max_ind*2+1]);
+        powermap_destroy(&hPm);
+    }
+
+    /* Clean-up */
+    free(inSig);
+    free(y);
+    free(shSig);
+    free(shSig_frame);
+}
+
 void test__saf_example_ambi_enc(void){
     int nSH, i, ch, framesize, j, delay;
     void* hAmbi;
@@ -2158,7 +4428,7 @@ void test__saf_example_array2sh(void){
         saf_multiConv_apply(hMC, FLATTEN2D(inSig_32), FLATTEN2D(micSig));
 
     /* Encode simulated Eigenmike signals into spherical harmonic signals */
-    framesize = array2sh_getFrameSize();
+    framesize = array2sh_getFrameSizeEx(hA2sh);
     shSig = (float**)malloc2d(nSH,signalLength,sizeof(float)); 
     micSig_frame = (float**)malloc1d(32*sizeof(float*));
     shSig_frame = (float**)malloc1d(nSH*sizeof(float*));
@@ -2188,9 +4458,9 @@ void test__saf_example_array2sh(void){
 }
 
 void test__saf_example_rotator(void){
-    int ch, nSH, i, j, delay, framesize;
+    int ch, nSH, i, j, delay, framesize, nFrames;
     void* hRot;
-    float direction_deg[2], ypr[3], Rzyx[3][3];
+    float direction_deg[2], ypr[3], Rzyx[3][3], Q[4];
     float** inSig, *y, **shSig_frame, **shSig_rot_frame;
     float** shSig, **shSig_rot, **shSig_rot_ref, **Mrot;
 
@@ -2261,6 +4531,31 @@ void test__saf_example_rotator(void){
         for(j=0; j<signalLength-delay; j++)
             TEST_ASSERT_FLOAT_WITHIN(acceptedTolerance, shSig_rot_ref[i][j], shSig_rot[i][j+delay]);
 
+    /* Now start from another orientation, and switch to the same rotation
+     * (given as a quaternion) half-way through */
+    rotator_init(hRot, fs);
+    rotator_setYaw(hRot, 30.0f);
+    rotationMatrix2quaternion(Rzyx, Q);
+    nFrames = (int)((float)signalLength/(float)framesize);
+    for(i=0; i<nFrames; i++){
+        if(i==nFrames/2)
+            rotator_setQuaternion(hRot, Q);
+        for(ch=0; ch<nSH; ch++)
+            shSig_frame[ch] = &shSig[ch][i*framesize];
+        for(ch=0; ch<nSH; ch++)
+            shSig_rot_frame[ch] = &shSig_rot[ch][i*framesize];
+        rotator_process(hRot, shSig_frame, shSig_rot_frame, nSH, nSH, framesize);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, ypr[0]*180.0f/M_PI, rotator_getYaw(hRot));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, ypr[1]*180.0f/M_PI, rotator_getPitch(hRot));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, ypr[2]*180.0f/M_PI, rotator_getRoll(hRot));
+
+    /* Once the new orientation is reached (after one frame of interpolation),
+     * the output should again match the reference */
+    for(i=0; i<nSH; i++)
+        for(j=(nFrames/2+1)*framesize; j<signalLength-delay; j++)
+            TEST_ASSERT_FLOAT_WITHIN(0.00001f, shSig_rot_ref[i][j-delay], shSig_rot[i][j]);
+
     /* Clean-up */
     rotator_destroy(&hRot);
     free(inSig);
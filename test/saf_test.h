@@ -39,9 +39,54 @@ void test__ims_shoebox_RIR(void);
 /**
  * Testing the forward and backward real-(half)complex FFT (saf_rfft) */
 void test__saf_rfft(void);
+/**
+ * Testing that the batched FFTs (saf_rfft_forward_batch() etc.) match the
+ * single-vector transforms, for padded (non-contiguous) batch layouts, and
+ * for batches of different sizes (see saf_rfft_prepareBatch()) */
+void test__saf_rfft_batch(void);
+/**
+ * Testing that saf_rfft/saf_fft instances, which share plans via the
+ * process-wide plan cache, may be created/used/destroyed by several threads at
+ * once */
+void test__saf_fft_planCache(void);
+/**
+ * Testing the split-complex forward/backward FFTs (saf_rfft_forward_split())
+ * and the split-complex vector operations, against their interleaved
+ * equivalents */
+void test__saf_rfft_split(void);
 /**
  * Testing the saf_matrixConv */
 void test__saf_matrixConv(void);
+/**
+ * Testing that the uniformly, non-uniformly, and threaded partitioned
+ * saf_matrixConv and saf_multiConv are equivalent to time-domain convolution */
+void test__saf_matrixConv_partitioned(void);
+/**
+ * Testing that new filters may be swapped into saf_matrixConv and
+ * saf_multiConv (with a crossfade), without re-creating them */
+void test__saf_matrixConv_swapFilters(void);
+/**
+ * Testing that the filters of the threaded saf_matrixConv may be swapped and
+ * released repeatedly, while the jobs of its worker thread are in flight */
+void test__saf_matrixConv_swapFiltersThreaded(void);
+/**
+ * Testing that saf_matrixConv and saf_multiConv skip the products of zero
+ * filter partitions and silent input blocks, without affecting the output */
+void test__saf_matrixConv_sparse(void);
+/**
+ * Testing that the saf_blockAdaptor produces the same output as direct frame
+ * processing (delayed by one frame, if the host block sizes are not multiples
+ * of the frame size) */
+void test__saf_blockAdaptor(void);
+/**
+ * Testing that saf_blockAdaptor_applyStrided() produces the same output as
+ * saf_blockAdaptor_apply(), for separate and in-place interleaved buffers */
+void test__saf_blockAdaptor_strided(void);
+/**
+ * Testing that states published with saf_stateSwap_publish() are acquired
+ * intact and in order by a concurrent reader, and are all destroyed exactly
+ * once */
+void test__saf_stateSwap(void);
 #ifdef AFSTFT_USE_FLOAT_COMPLEX
 /**
  * Testing the alias-free STFT filterbank reconstruction */
@@ -50,6 +95,15 @@ void test__afSTFTMatrix(void);
 /**
  * Testing the alias-free STFT filterbank reconstruction */
 void test__afSTFT(void);
+/**
+ * Testing the reconstruction of the afSTFT filterbank, with and without the
+ * low-delay mode and hybrid-mode, using the delays returned by
+ * afSTFTgetProcessingDelay() */
+void test__afSTFT_LDmode(void);
+/**
+ * Testing that afSTFTforwardFrame() and afSTFTinverseFrame() (in both storage
+ * formats) match the hop-by-hop afSTFTforward() and afSTFTinverse() */
+void test__afSTFTframe(void);
 /**
  * Testing the smb_pitchShifter */
 void test__smb_pitchShifter(void);
@@ -77,6 +131,36 @@ void test__unique_i(void);
  * Testing the realloc2d_r() function (reallocating 2-D array, while retaining
  * the previous data order; except truncated or extended) */
 void test__realloc2d_r(void);
+/**
+ * Testing the fused complex multiply-accumulate kernels (utility_cvvmuladd()
+ * and utility_cvvmuladd_split()), for all SIMD levels supported by the CPU */
+void test__utility_cvvmuladd(void);
+/**
+ * Testing that the SIMD kernels employed by the element-wise vector routines
+ * (utility_svvadd(), utility_cvvmul() etc.) agree with the reference
+ * implementations, for all SIMD levels supported by the CPU */
+void test__utility_simdKernels(void);
+/**
+ * Testing utility_svvmulfold() and utility_svvmuladd() (used for the afSTFT
+ * prototype filter folding/overlap-add) for all SIMD levels supported by the
+ * CPU, including lengths which are not a multiple of the SIMD width */
+void test__utility_svvmulfold(void);
+/**
+ * Testing that the workspace variants of the linear algebra routines (e.g.
+ * utility_ssvd_ws(), utility_cslslv_ws()), with workspaces created for larger
+ * dimensions, agree with the allocating versions (e.g. utility_ssvd()) */
+void test__utility_lapackWorkspaces(void);
+/**
+ * Testing the batched solvers (e.g. utility_cchol_batch(),
+ * utility_cslslv_batch()) against their per-matrix counterparts, including
+ * batches which are not a multiple of the band-interleaving block size */
+void test__utility_batchSolvers(void);
+/**
+ * Testing that the linear algebra routines which avoid transposing their
+ * inputs/outputs (e.g. utility_csvd(), utility_cslslv(), utility_cchol()),
+ * and their column-major variants (e.g. utility_cseig_cm_ws()), satisfy their
+ * defining equations */
+void test__utility_transposeFreeSolvers(void);
 /**
  * Testing the formulate_M_and_Cr() function, and verifying that the output
  * mixing matrices yield signals which have the target covariance
@@ -98,12 +182,43 @@ void test__getSHreal(void);
  * Testing that the getSHreal_recur() function is somewhat numerically similar
  * to the getSHreal function */
 void test__getSHreal_recur(void);
+
+/**
+ * Testing that the saf_shEvaluator_getSHreal() function is numerically
+ * identical to getSHreal(), and that the table look-up variant is close
+ */
+void test__saf_shEvaluator(void);
+
+/**
+ * Testing that saf_shGridCache_acquireReal()/saf_shGridCache_acquireCmplx()
+ * share matrices between identical requests, and that they match getRSH()
+ */
+void test__saf_shGridCache(void);
+
+/**
+ * Testing that the powermap engine (split over several threads) produces the
+ * same maps as generatePWDmap(), generateMVDRmap(), generateCroPaCLCMVmap() and
+ * generateMUSICmap(), and that the MinNorm map peaks in the source direction
+ */
+void test__saf_pmapEngine(void);
 /**
  * Testing the orthogonality of the getSHcomplex() function */
 void test__getSHcomplex(void);
 /**
  * Testing the spherical harmonic rotation matrix function getSHrotMtxReal() */
 void test__getSHrotMtxReal(void);
+/**
+ * Testing that getSHrotMtxRealBlocks() returns the (orthonormal) diagonal
+ * blocks of getSHrotMtxReal() */
+void test__getSHrotMtxRealBlocks(void);
+/**
+ * Testing that applySHblockMtx() and its complex variants are equivalent to
+ * multiplying by the full (dense) SH matrix */
+void test__applySHblockMtx(void);
+/**
+ * Testing the conversions between rotation matrices, quaternions and Euler
+ * angles, and the quaternion slerp */
+void test__quaternion(void);
 /**
  * Testing the real to complex spherical harmonic conversion, using
  * getSHcomplex() as the reference */
@@ -135,6 +250,21 @@ void test__saf_example_ambi_bin(void);
  * Testing the SAF ambi_dec example (this may also serve as a tutorial on how
  * to use it) */
 void test__saf_example_ambi_dec(void);
+/**
+ * Testing that the SAF ambi_dec example may be created with different frame
+ * sizes (ambi_dec_createWithFrameSize()), and that it still decodes correctly
+ * (also via ambi_dec_processInterleaved()) and reports the corresponding frame
+ * size, number of bands and delay */
+void test__saf_example_frameSizes(void);
+/**
+ * Testing that the SAF beamformer example may be created with different frame
+ * sizes (beamformer_createWithFrameSize()), which only change its delay */
+void test__saf_example_beamformer(void);
+/**
+ * Testing that the SAF powermap example may be created with different hop
+ * sizes (powermap_createWithHopSize()), and that its activity-map still peaks
+ * towards a plane-wave */
+void test__saf_example_powermap(void);
 /**
  * Testing the SAF ambi_enc example (this may also serve as a tutorial on how
  * to use it) */